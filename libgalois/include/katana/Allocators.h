@@ -36,14 +36,13 @@
 #include "katana/PerThreadStorage.h"
 #include "katana/PtrLock.h"
 #include "katana/SimpleLock.h"
+#include "katana/Threads.h"
 #include "katana/config.h"
 
 // TODO(ddn): Merge with Mem.h. Users should not include this file directly.
 
 namespace katana {
 
-extern unsigned activeThreads;
-
 //! Forces the given block to be paged into physical memory
 KATANA_EXPORT void pageIn(void* buf, size_t len, size_t stride);
 
@@ -641,7 +640,7 @@ public:
   enum { AllocSize = 0 };
 
   void* allocate(size_t size) {
-    auto ptr = largeMallocInterleaved(size + offset, activeThreads);
+    auto ptr = largeMallocInterleaved(size + offset, getActiveThreads());
     LAptr* header = new ((char*)ptr.get()) LAptr{std::move(ptr)};
     return (char*)(header->get()) + offset;
   }
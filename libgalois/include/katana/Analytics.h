@@ -8,6 +8,7 @@
 #include "katana/analytics/k_core/k_core.h"
 #include "katana/analytics/k_truss/k_truss.h"
 #include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/plan_advisor/plan_advisor.h"
 #include "katana/analytics/sssp/sssp.h"
 #include "katana/analytics/triangle_count/triangle_count.h"
 
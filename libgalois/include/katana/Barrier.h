@@ -58,6 +58,8 @@ public:
  * be in the barrier while the main thread reinitializes this
  * barrier to the new number of active threads. If that may
  * happen, use {@link CreateSimpleBarrier()} instead.
+ *
+ * Called from a thread group, returns the barrier of the group.
  */
 KATANA_EXPORT Barrier& GetBarrier(unsigned active_threads);
 
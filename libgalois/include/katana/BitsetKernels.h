@@ -0,0 +1,45 @@
+#ifndef KATANA_LIBGALOIS_KATANA_BITSETKERNELS_H_
+#define KATANA_LIBGALOIS_KATANA_BITSETKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// The vector instruction sets the bitset kernels can use. Each kernel is
+/// compiled for every level with target attributes and the level is picked
+/// at run time, so the kernels do not depend on the architecture flags of
+/// the build (sandybridge by default).
+enum class SimdLevel {
+  kScalar,
+  /// AVX2, on Haswell and later
+  kAVX2,
+  /// AVX-512 F and VPOPCNTDQ, on Ice Lake, Zen 4 and later
+  kAVX512,
+};
+
+/// \returns the highest level this CPU supports, or the level named by the
+/// environment variable KATANA_SIMD_LEVEL (scalar, avx2 or avx512) if that
+/// is lower
+KATANA_EXPORT SimdLevel GetSimdLevel();
+
+KATANA_EXPORT const char* SimdLevelName(SimdLevel level);
+
+/// \returns the number of set bits in words[0, num_words)
+KATANA_EXPORT uint64_t CountSetBits(
+    const uint64_t* words, size_t num_words, SimdLevel level = GetSimdLevel());
+
+/// Write first_index + i to out for every set bit i of words[0, num_words),
+/// in increasing order. out must have room for CountSetBits(words,
+/// num_words) values; nothing is written past them.
+///
+/// \returns the number of values written
+KATANA_EXPORT size_t ExpandSetBits(
+    const uint64_t* words, size_t num_words, uint32_t first_index,
+    uint32_t* out, SimdLevel level = GetSimdLevel());
+
+}  // namespace katana
+
+#endif
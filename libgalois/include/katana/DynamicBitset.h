@@ -26,6 +26,7 @@
 #ifndef KATANA_LIBGALOIS_KATANA_DYNAMICBITSET_H_
 #define KATANA_LIBGALOIS_KATANA_DYNAMICBITSET_H_
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <vector>
@@ -34,6 +35,7 @@
 #include <boost/mpl/has_xxx.hpp>
 
 #include "katana/AtomicWrapper.h"
+#include "katana/BitsetKernels.h"
 #include "katana/Galois.h"
 #include "katana/PODVector.h"
 #include "katana/config.h"
@@ -83,6 +85,20 @@ public:
    */
   auto& get_vec() { return bitvec_; }
 
+  /**
+   * Returns the words of the bitset as plain integers, for the kernels in
+   * katana/BitsetKernels.h. Bits past size() in the last word are not
+   * guaranteed to be unset.
+   *
+   * @returns pointer to the first of get_vec().size() words
+   */
+  const uint64_t* words() const {
+    static_assert(
+        sizeof(katana::CopyableAtomic<uint64_t>) == sizeof(uint64_t),
+        "words are read as plain integers");
+    return reinterpret_cast<const uint64_t*>(bitvec_.data());
+  }
+
   /**
    * Resizes the bitset.
    *
@@ -333,6 +349,38 @@ public:
   template <typename integer>
   void AppendOffsets(std::vector<integer>* vec) const;
 
+  /**
+   * Calls fn(index) for each set bit, in parallel and in no particular order.
+   * The set bits of each block of words are found with ExpandSetBits. The
+   * bitset must have fewer than 2^32 bits.
+   * Do NOT call in a parallel region as it uses katana::do_all.
+   *
+   * @param fn function taking the uint32_t index of a set bit
+   */
+  template <typename F>
+  void ForEachSetBit(const F& fn) const {
+    constexpr size_t kWordsPerBlock = 64;
+    const uint64_t* bits = words();
+    size_t num_words = bitvec_.size();
+    size_t num_blocks = (num_words + kWordsPerBlock - 1) / kWordsPerBlock;
+    SimdLevel level = GetSimdLevel();
+    katana::do_all(
+        katana::iterate(size_t{0}, num_blocks),
+        [&](size_t block) {
+          uint32_t indexes[kWordsPerBlock * kNumBitsInUint64];
+          size_t begin = block * kWordsPerBlock;
+          size_t end = std::min(begin + kWordsPerBlock, num_words);
+          size_t num_indexes = ExpandSetBits(
+              bits + begin, end - begin, begin * kNumBitsInUint64, indexes,
+              level);
+          // indexes are sorted, so only the last block stops early
+          for (size_t i = 0; i < num_indexes && indexes[i] < num_bits_; ++i) {
+            fn(indexes[i]);
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
   //TODO(emcginnis): DynamicBitset is not actually memory copyable, remove this
   //! this is defined to
   using tt_is_copyable = int;
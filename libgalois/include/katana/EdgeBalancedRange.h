@@ -0,0 +1,221 @@
+#ifndef KATANA_LIBGALOIS_KATANA_EDGEBALANCEDRANGE_H_
+#define KATANA_LIBGALOIS_KATANA_EDGEBALANCEDRANGE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/Range.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Thread ranges over the nodes of a graph that give each thread about the
+/// same number of edges.
+///
+/// do_all over katana::iterate(graph) gives each thread the same number of
+/// nodes and relies on stealing to even out the work, which on power-law
+/// graphs leaves the few threads that got the hubs working long after the
+/// others are done. These ranges split the prefix sum of the degrees
+/// instead, counting each node as one edge so that long runs of nodes
+/// without edges are split as well.
+///
+/// A node with more edges than the share of one thread still ends up with a
+/// single thread in the node ranges. Loops that combine the work on the
+/// edges of a node, like the reductions of triangle counting, can use
+/// ForEachEdgeRange, which splits the edges themselves.
+///
+/// Building the ranges takes a binary search over the nodes per thread,
+/// O(num_threads * log(num_nodes)) lookups of adjacency indices and no pass
+/// over the nodes or edges, which is far below the cost of any loop they
+/// balance. They are therefore not cached with the graph: callers
+/// build them on entry, and loops that run many times over the same graph,
+/// like the iterations of PageRank, build them once and reuse them. The
+/// ranges are only valid for the number of threads they were built for.
+class KATANA_EXPORT EdgeBalancedRanges : public GraphTopologyTypes {
+public:
+  /// @param graph any graph with num_nodes(), num_edges() and edges(n)
+  /// @param num_threads the number of threads of the loops using the ranges
+  template <typename Graph>
+  static EdgeBalancedRanges Make(
+      const Graph& graph, uint32_t num_threads = getActiveThreads()) {
+    KATANA_LOG_ASSERT(num_threads > 0);
+
+    uint64_t num_nodes = graph.num_nodes();
+    uint64_t num_edges = graph.num_edges();
+    auto edges_before = [&](uint64_t n) -> uint64_t {
+      return n == 0 ? 0 : *graph.edges(n - 1).end();
+    };
+
+    // the weight of nodes [0, n) is n + edges_before(n)
+    uint64_t total_weight = num_nodes + num_edges;
+    std::vector<uint32_t> node_begins(num_threads + 1);
+    std::vector<Edge> edge_begins(num_threads + 1);
+    for (uint32_t i = 0; i <= num_threads; ++i) {
+      uint64_t target = total_weight * i / num_threads;
+      // the first node n with weight of [0, n) at least target
+      node_begins[i] = *std::partition_point(
+          node_iterator(0), node_iterator(num_nodes),
+          [&](Node n) { return n + edges_before(n) < target; });
+      edge_begins[i] = num_edges * i / num_threads;
+    }
+
+    // the largest number of edges given to a thread over the average
+    auto imbalance = [&](auto&& thread_range) {
+      if (num_edges == 0) {
+        return 1.0;
+      }
+      uint64_t max_edges = 0;
+      for (uint32_t i = 0; i < num_threads; ++i) {
+        auto [begin, end] = thread_range(i);
+        max_edges =
+            std::max(max_edges, edges_before(end) - edges_before(begin));
+      }
+      return static_cast<double>(max_edges) * num_threads / num_edges;
+    };
+
+    double balanced_imbalance = imbalance([&](uint32_t i) {
+      return std::make_pair(node_begins[i], node_begins[i + 1]);
+    });
+    double even_imbalance = imbalance([&](uint32_t i) {
+      return block_range(uint64_t{0}, num_nodes, i, num_threads);
+    });
+
+    return EdgeBalancedRanges(
+        num_nodes, std::move(node_begins), std::move(edge_begins),
+        balanced_imbalance, even_imbalance);
+  }
+
+  uint32_t num_threads() const noexcept { return node_begins_.size() - 1; }
+
+  /// The range to pass to do_all, in place of katana::iterate(graph). The
+  /// loop must run on num_threads() threads.
+  SpecificRange<node_iterator> iterate() const {
+    KATANA_LOG_VASSERT(
+        getActiveThreads() == num_threads(),
+        "ranges for {} threads used with {} active threads", num_threads(),
+        getActiveThreads());
+    return MakeSpecificRange(
+        node_iterator(0), node_iterator(num_nodes_), node_begins_);
+  }
+
+  /// The nodes of thread tid
+  std::pair<Node, Node> node_range(uint32_t tid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(tid < num_threads());
+    return std::make_pair(node_begins_[tid], node_begins_[tid + 1]);
+  }
+
+  /// The edges of thread tid in ForEachEdgeRange
+  std::pair<Edge, Edge> edge_range(uint32_t tid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(tid < num_threads());
+    return std::make_pair(edge_begins_[tid], edge_begins_[tid + 1]);
+  }
+
+  /// The most edges any thread gets in the node ranges over the average
+  /// number of edges per thread; 1 is a perfect balance.
+  double imbalance() const noexcept { return imbalance_; }
+
+  /// imbalance() of the ranges of katana::iterate(graph), which give each
+  /// thread the same number of nodes, before any stealing
+  double even_split_imbalance() const noexcept {
+    return even_split_imbalance_;
+  }
+
+  /// Report imbalance() and even_split_imbalance() as statistics of region
+  void ReportImbalance(const std::string& region) const {
+    ReportStatSingle(region, "EdgeBalancedImbalance", imbalance_);
+    ReportStatSingle(region, "EvenSplitImbalance", even_split_imbalance_);
+  }
+
+  /// Call fn(n, edges) in parallel for disjoint ranges of the edges of node
+  /// n that together cover all edges of graph. Each thread gets the same
+  /// number of edges, so the edges of a node with a very large degree may
+  /// be split among several threads, and fn must combine the results for
+  /// the pieces of a node, e.g., with a GAccumulator or atomics. Nodes
+  /// without edges are skipped.
+  ///
+  /// The split is static: unlike do_all with katana::steal(), a thread that
+  /// finishes early does not take work from the others. The edges are
+  /// balanced, but not the work per edge, so loops whose cost per edge
+  /// varies, like intersections whose length depends on the degree of the
+  /// destination, can still end up waiting on the slowest thread.
+  ///
+  /// The number of active threads must be num_threads().
+  ///
+  /// @param graph the graph the ranges were built for
+  /// @param fn called as fn(Node, edges_range)
+  /// @param args options for on_each, e.g., katana::loopname
+  template <typename Graph, typename Func, typename... Args>
+  void ForEachEdgeRange(const Graph& graph, Func&& fn, Args&&... args) const {
+    KATANA_LOG_DEBUG_ASSERT(graph.num_nodes() == num_nodes_);
+    KATANA_LOG_DEBUG_ASSERT(graph.num_edges() == edge_begins_.back());
+    // edge_begins_ has an entry per thread it was built for
+    KATANA_LOG_VASSERT(
+        getActiveThreads() == num_threads(),
+        "ranges for {} threads used with {} active threads", num_threads(),
+        getActiveThreads());
+
+    katana::on_each(
+        [&](unsigned tid, unsigned) {
+          Edge begin = edge_begins_[tid];
+          Edge end = edge_begins_[tid + 1];
+          if (begin == end) {
+            return;
+          }
+          // the node of edge begin
+          Node n = *std::partition_point(
+              node_iterator(0), node_iterator(num_nodes_),
+              [&](Node m) { return *graph.edges(m).end() <= begin; });
+          while (begin < end) {
+            Edge node_end = std::min<Edge>(*graph.edges(n).end(), end);
+            if (begin < node_end) {
+              fn(n, MakeStandardRange(
+                        edge_iterator(begin), edge_iterator(node_end)));
+            }
+            begin = node_end;
+            ++n;
+          }
+        },
+        std::forward<Args>(args)...);
+  }
+
+private:
+  EdgeBalancedRanges(
+      uint64_t num_nodes, std::vector<uint32_t>&& node_begins,
+      std::vector<Edge>&& edge_begins, double imbalance,
+      double even_split_imbalance) noexcept
+      : num_nodes_(num_nodes),
+        node_begins_(std::move(node_begins)),
+        edge_begins_(std::move(edge_begins)),
+        imbalance_(imbalance),
+        even_split_imbalance_(even_split_imbalance) {}
+
+  uint64_t num_nodes_;
+  /// Thread i gets nodes [node_begins_[i], node_begins_[i + 1])
+  std::vector<uint32_t> node_begins_;
+  /// Thread i gets edges [edge_begins_[i], edge_begins_[i + 1]) in
+  /// ForEachEdgeRange
+  std::vector<Edge> edge_begins_;
+  double imbalance_;
+  double even_split_imbalance_;
+};
+
+/// An iteration policy for do_all over the nodes of a graph that gives each
+/// thread about the same number of edges. See EdgeBalancedRanges; loops that
+/// run more than once should build those once instead.
+template <typename Graph>
+SpecificRange<GraphTopologyTypes::node_iterator>
+iterate_edge_balanced(const Graph& graph) {
+  return EdgeBalancedRanges::Make(graph).iterate();
+}
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef KATANA_LIBGALOIS_KATANA_EDGESHUFFLE_H_
+#define KATANA_LIBGALOIS_KATANA_EDGESHUFFLE_H_
+
+#include "katana/GraphTopology.h"
+#include "katana/config.h"
+
+namespace katana {
+
+struct EdgeShuffleOptions {
+  /// Drop edges (n, n)
+  bool remove_self_loops{false};
+  /// Keep only one of the edges with the same source and destination, the
+  /// one from the input edge with the smallest ID. The edges of each node
+  /// are then sorted by destination.
+  bool remove_duplicates{false};
+};
+
+/// The topology made by TransposeEdges or SymmetrizeEdges. Edge e of the new
+/// topology came from edge edge_prop_indices[e] of the input, so edge
+/// properties and edge types follow the edges by looking them up through
+/// edge_prop_indices, as EdgeShuffleTopology does.
+struct KATANA_EXPORT ShuffledEdges : public GraphTopologyTypes {
+  AdjIndexVec adj_indices;
+  EdgeDestVec dests;
+  PropIndexVec edge_prop_indices;
+};
+
+/// Reverse every edge of topology.
+///
+/// Writing every edge to the adjacency of its destination directly writes to
+/// random places of the output, which on large graphs misses the cache and
+/// the TLB on nearly every edge. Instead, the edges are first partitioned by
+/// their new source into at most 1024 buckets of consecutive nodes, each
+/// thread writing sequentially into its own part of every bucket, and then
+/// each bucket, which covers a small part of the output, is sorted by new
+/// source on its own.
+///
+/// Unless duplicates are removed, the edges of a node are in the order of
+/// their IDs in topology, and the result does not depend on the number of
+/// threads.
+KATANA_EXPORT ShuffledEdges TransposeEdges(
+    const GraphTopology& topology, const EdgeShuffleOptions& opts = {});
+
+/// Add the reverse (b, a) of every edge (a, b) of topology, except for
+/// self loops, which appear once. Edges (a, b) and (b, a) of the result both
+/// have the ID of the input edge they came from in edge_prop_indices. See
+/// TransposeEdges for how the edges are moved.
+KATANA_EXPORT ShuffledEdges SymmetrizeEdges(
+    const GraphTopology& topology, const EdgeShuffleOptions& opts = {});
+
+}  // namespace katana
+
+#endif
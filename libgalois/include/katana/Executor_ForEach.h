@@ -358,8 +358,8 @@ protected:
 
   template <typename... WArgsTy>
   ForEachExecutor(T2, FunctionTy f, const ArgsTy& args, WArgsTy... wargs)
-      : term(GetTerminationDetection(activeThreads)),
-        barrier(GetBarrier(activeThreads)),
+      : term(GetTerminationDetection(getActiveThreads())),
+        barrier(GetBarrier(getActiveThreads())),
         wl(std::forward<WArgsTy>(wargs)...),
         origFunction(f),
         loopname(katana::internal::getLoopName(args)),
@@ -401,7 +401,7 @@ public:
 
   void operator()() {
     bool isLeader = ThreadPool::isLeader();
-    bool couldAbort = needsAborts && activeThreads > 1;
+    bool couldAbort = needsAborts && getActiveThreads() > 1;
     if (couldAbort && isLeader)
       go<true, true>();
     else if (couldAbort && !isLeader)
@@ -450,12 +450,12 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
       OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))>;
   typedef ForEachExecutor<WorkListTy, FuncRefType, ArgsTy> WorkTy;
 
-  auto& barrier = GetBarrier(activeThreads);
+  auto& barrier = GetBarrier(getActiveThreads());
   FuncRefType fn_ref = fn;
   WorkTy W(fn_ref, args);
   W.init(range);
   GetThreadPool().run(
-      activeThreads, [&W, &range]() { W.initThread(range); },
+      getActiveThreads(), [&W, &range]() { W.initThread(range); },
       [&barrier] { barrier.Wait(); }, std::ref(W));
 }
 
@@ -0,0 +1,135 @@
+#ifndef KATANA_LIBGALOIS_KATANA_FRONTIER_H_
+#define KATANA_LIBGALOIS_KATANA_FRONTIER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/Reduction.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * A set of active nodes for frontier-based algorithms such as BFS, k-core
+ * and label propagation, kept either sparse or dense.
+ *
+ * The sparse representation is an InsertBag, i.e., per-thread chunked
+ * arrays, which is cheap to push to and to iterate when few nodes are
+ * active, but keeps duplicates. The dense representation is a DynamicBitset
+ * over all nodes, which deduplicates, answers Contains and is iterated with
+ * the SIMD kernels of katana/BitsetKernels.h. Adapt picks the representation
+ * by size: dense once more than num_nodes / dense_divisor nodes are active.
+ *
+ * Push may be called in parallel; everything else may not.
+ *
+ * \code
+ * katana::Frontier frontier(num_nodes);
+ * katana::Frontier next(num_nodes);
+ * frontier.Push(source);
+ * while (!frontier.empty()) {
+ *   frontier.ForEach([&](uint32_t n) { ... next.Push(dst); ... });
+ *   next.Adapt();
+ *   frontier.Clear();
+ *   frontier.swap(next);
+ * }
+ * \endcode
+ */
+class KATANA_EXPORT Frontier {
+public:
+  using Node = uint32_t;
+
+  /// The default fraction of nodes, as a divisor, above which a frontier is
+  /// dense; the same as the default beta of direction optimizing BFS
+  static constexpr uint32_t kDefaultDenseDivisor = 18;
+
+  /**
+   * @param num_nodes nodes are in [0, num_nodes)
+   * @param dense_divisor the frontier is dense when more than
+   * num_nodes / dense_divisor nodes are active
+   */
+  explicit Frontier(
+      size_t num_nodes, uint32_t dense_divisor = kDefaultDenseDivisor);
+
+  /// Add n to the frontier. In the sparse representation, n is added again
+  /// if it is already there.
+  void Push(Node n) {
+    if (dense_) {
+      if (!bitset_.set(n)) {
+        size_ += 1;
+      }
+    } else {
+      sparse_.push(n);
+      size_ += 1;
+    }
+  }
+
+  /// \returns true if n is in the frontier; only valid when it is dense
+  bool Contains(Node n) const {
+    KATANA_LOG_DEBUG_ASSERT(dense_);
+    return bitset_.test(n);
+  }
+
+  /// \returns the number of nodes pushed, counting duplicates when sparse
+  size_t size() const { return size_.reduce(); }
+
+  bool empty() const { return size() == 0; }
+
+  bool is_dense() const { return dense_; }
+
+  size_t num_nodes() const { return num_nodes_; }
+
+  /// Remove every node, keeping the representation
+  void Clear();
+
+  /// Make every node active; the frontier becomes dense
+  void Fill();
+
+  /// Switch to the bitset, dropping duplicates
+  void ToDense();
+
+  /// Switch to the bag
+  void ToSparse();
+
+  /// Switch to the representation that suits the current size
+  void Adapt();
+
+  /**
+   * Call fn(n) for each node n of the frontier, in parallel and in no
+   * particular order. fn may push to other frontiers.
+   */
+  template <typename F>
+  void ForEach(const F& fn, const char* loopname = "Frontier") {
+    if (dense_) {
+      bitset_.ForEachSetBit(fn);
+    } else {
+      katana::do_all(
+          katana::iterate(sparse_), fn, katana::steal(),
+          katana::chunk_size<kChunkSize>(), katana::loopname(loopname));
+    }
+  }
+
+  /**
+   * @returns the nodes of the frontier in a vector, in increasing order when
+   * dense and in no particular order when sparse
+   */
+  std::vector<Node> Compact();
+
+  void swap(Frontier& other);
+
+private:
+  static constexpr size_t kChunkSize = 256;
+
+  size_t num_nodes_;
+  uint32_t dense_divisor_;
+  bool dense_{false};
+  katana::InsertBag<Node> sparse_;
+  katana::DynamicBitset bitset_;
+  mutable katana::GAccumulator<size_t> size_;
+};
+
+}  // namespace katana
+
+#endif
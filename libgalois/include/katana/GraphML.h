@@ -7,6 +7,9 @@
 
 namespace katana {
 
+/// The default size of the pieces a GraphML file is parsed in
+constexpr size_t kGraphMLParseChunkBytes = 1 << 20;
+
 /// ConvertGraphML converts a GraphML file into katana form
 ///
 /// \param infilename Path to source graphml file
@@ -15,11 +18,16 @@ namespace katana {
 ///     memory usage when converting large inputs
 /// \param verbose If true, print graph data to the standard out while
 ///     converting.
+/// \param parse_chunk_bytes The graph is read in pieces of about this many
+///     bytes, which are parsed in parallel and added to the tables in file
+///     order. Files that cannot be split, e.g., compressed or not UTF-8, are
+///     parsed serially. Adding the parsed values to the Arrow tables stays
+///     serial, which limits the speedup from more threads.
 /// \returns A collection of Arrow tables of node properties/labels, edge
 ///     properties/types, and CSR topology
 KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphML(
     const std::string& infilename, size_t chunk_size = 25000,
-    bool verbose = false);
+    bool verbose = false, size_t parse_chunk_bytes = kGraphMLParseChunkBytes);
 
 /// ConvertGraphML converts a GraphML file into katana form
 ///
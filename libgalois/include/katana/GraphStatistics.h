@@ -0,0 +1,194 @@
+#ifndef KATANA_LIBGALOIS_KATANA_GRAPHSTATISTICS_H_
+#define KATANA_LIBGALOIS_KATANA_GRAPHSTATISTICS_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "katana/EntityTypeManager.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A distribution of degrees, or of any other counts. Bucket 0 of the
+/// histogram counts zeros and bucket k > 0 counts values in
+/// [2^(k-1), 2^k).
+struct KATANA_EXPORT DegreeDistribution {
+  uint64_t num_nodes{0};
+  uint64_t sum{0};
+  uint64_t max{0};
+  std::vector<uint64_t> log2_histogram;
+
+  void Add(uint64_t degree);
+  void Merge(const DegreeDistribution& other);
+
+  double mean() const {
+    return num_nodes == 0 ? 0.0 : static_cast<double>(sum) / num_nodes;
+  }
+};
+
+/// The entities of one entity type. Degrees are only filled in for node
+/// types.
+struct KATANA_EXPORT EntityTypeStatistics {
+  EntityTypeID type_id{kUnknownEntityType};
+  /// The name of an atomic type, empty for other types
+  std::string name;
+  uint64_t count{0};
+  DegreeDistribution out_degrees;
+  DegreeDistribution in_degrees;
+};
+
+struct KATANA_EXPORT PropertyStatistics {
+  std::string name;
+  std::string type;
+  uint64_t length{0};
+  uint64_t null_count{0};
+  /// The number of distinct non-null values, if they were counted
+  std::optional<uint64_t> distinct_count;
+
+  double null_ratio() const {
+    return length == 0 ? 0.0 : static_cast<double>(null_count) / length;
+  }
+};
+
+/// Sizes of the weakly connected components
+struct KATANA_EXPORT ComponentStatistics {
+  uint64_t num_components{0};
+  /// The sizes of the largest components, largest first
+  std::vector<uint64_t> largest;
+  /// Bucket k counts components with sizes in [2^(k-1), 2^k)
+  std::vector<uint64_t> log2_histogram;
+};
+
+struct KATANA_EXPORT GraphStatistics {
+  /// Bumped when the meaning of a field changes
+  static constexpr uint32_t kVersion = 1;
+
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  uint64_t num_self_loops{0};
+
+  DegreeDistribution out_degrees;
+  DegreeDistribution in_degrees;
+  std::vector<EntityTypeStatistics> node_types;
+  std::vector<EntityTypeStatistics> edge_types;
+  std::vector<PropertyStatistics> node_properties;
+  std::vector<PropertyStatistics> edge_properties;
+
+  /// A lower bound on the diameter of the graph with edges taken as
+  /// undirected: the largest eccentricity seen by the BFS sweeps
+  uint64_t estimated_diameter{0};
+  /// The average local clustering coefficient of the undirected graph over
+  /// the sampled nodes
+  double clustering_coefficient{0.0};
+  uint64_t clustering_samples{0};
+
+  ComponentStatistics components;
+};
+
+/// Identifies the state of a graph that saved statistics describe
+struct KATANA_EXPORT GraphFingerprint {
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  /// A checksum of the adjacency indices, edge destinations and entity
+  /// types of nodes and edges
+  uint64_t checksum{0};
+  /// The names of all node and edge properties, loaded or not, sorted
+  std::vector<std::string> node_properties;
+  std::vector<std::string> edge_properties;
+
+  bool operator==(const GraphFingerprint& other) const {
+    return num_nodes == other.num_nodes && num_edges == other.num_edges &&
+           checksum == other.checksum &&
+           node_properties == other.node_properties &&
+           edge_properties == other.edge_properties;
+  }
+  bool operator!=(const GraphFingerprint& other) const {
+    return !(*this == other);
+  }
+};
+
+struct KATANA_EXPORT GraphStatisticsOptions {
+  /// Number of BFS sweeps for the diameter. The first starts at a node of
+  /// the highest degree and each of the others at the farthest node found by
+  /// the one before, so two sweeps are the classic double sweep.
+  uint32_t num_diameter_sweeps{4};
+  /// Number of nodes sampled for the clustering coefficient; all nodes are
+  /// used if there are fewer
+  uint64_t num_clustering_samples{1 << 14};
+  /// Nodes with more neighbors than this estimate their clustering
+  /// coefficient from pairs of neighbors instead of counting all triangles
+  uint64_t max_exact_clustering_degree{1024};
+  /// Number of the largest components to report
+  uint32_t num_largest_components{16};
+  /// Count the distinct values of each property exactly. This needs memory
+  /// proportional to the number of distinct values.
+  bool count_distinct_values{true};
+  uint64_t seed{0};
+};
+
+/// Profile a graph.
+///
+/// Degree distributions, type counts and components are computed with
+/// parallel loops over all nodes and edges. The diameter and clustering
+/// estimates use an undirected copy of the topology without duplicate edges
+/// and self loops, which needs about 16 bytes per edge while it is built and
+/// 8 bytes per edge after that.
+KATANA_EXPORT Result<GraphStatistics> ComputeGraphStatistics(
+    const PropertyGraph* pg, const GraphStatisticsOptions& opts = {});
+
+/// \returns graph with its edges taken as undirected: both directions of
+/// every edge, without duplicate edges and self loops, with the edges of
+/// each node sorted by destination. This is the topology the diameter and
+/// clustering estimates of ComputeGraphStatistics run on.
+KATANA_EXPORT GraphTopology MakeUndirectedTopology(const GraphTopology& graph);
+
+/// \returns a lower bound on the diameter of graph: the largest eccentricity
+/// seen by num_sweeps BFS sweeps along its edges, chosen as for
+/// GraphStatisticsOptions::num_diameter_sweeps
+KATANA_EXPORT uint64_t EstimateDiameter(
+    const GraphTopology& graph, uint32_t num_sweeps);
+
+/// Compute the fingerprint of pg as it is now, with a parallel pass over
+/// its nodes and edges
+KATANA_EXPORT GraphFingerprint ComputeGraphFingerprint(const PropertyGraph* pg);
+
+/// Save statistics in the part metadata of pg, so that they are written
+/// with it and available when it is loaded without computing them again.
+/// The fingerprint of pg is saved with them.
+KATANA_EXPORT void StoreGraphStatistics(
+    PropertyGraph* pg, const GraphStatistics& stats);
+
+/// \returns the statistics saved with pg, or ErrorCode::NotFound if there
+/// are none or pg no longer has the fingerprint saved with them: nodes,
+/// edges or properties were added or removed, or the topology or entity
+/// types were rewritten since they were stored. This computes the
+/// fingerprint of pg, a parallel pass over its nodes and edges.
+KATANA_EXPORT Result<GraphStatistics> LoadGraphStatistics(
+    const PropertyGraph* pg);
+
+KATANA_EXPORT void to_json(nlohmann::json& j, const DegreeDistribution& dist);
+KATANA_EXPORT void from_json(const nlohmann::json& j, DegreeDistribution& dist);
+KATANA_EXPORT void to_json(
+    nlohmann::json& j, const EntityTypeStatistics& stats);
+KATANA_EXPORT void from_json(
+    const nlohmann::json& j, EntityTypeStatistics& stats);
+KATANA_EXPORT void to_json(nlohmann::json& j, const PropertyStatistics& stats);
+KATANA_EXPORT void from_json(
+    const nlohmann::json& j, PropertyStatistics& stats);
+KATANA_EXPORT void to_json(nlohmann::json& j, const ComponentStatistics& stats);
+KATANA_EXPORT void to_json(nlohmann::json& j, const GraphFingerprint& fp);
+KATANA_EXPORT void from_json(const nlohmann::json& j, GraphFingerprint& fp);
+KATANA_EXPORT void from_json(
+    const nlohmann::json& j, ComponentStatistics& stats);
+KATANA_EXPORT void to_json(nlohmann::json& j, const GraphStatistics& stats);
+KATANA_EXPORT void from_json(const nlohmann::json& j, GraphStatistics& stats);
+
+}  // namespace katana
+
+#endif
@@ -1,11 +1,15 @@
 #ifndef KATANA_LIBGALOIS_KATANA_GRAPHTOPOLOGY_H_
 #define KATANA_LIBGALOIS_KATANA_GRAPHTOPOLOGY_H_
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
 
 #include "arrow/util/bitmap.h"
 #include "katana/DynamicBitset.h"
@@ -47,6 +51,7 @@ struct KATANA_EXPORT GraphTopologyTypes {
 class KATANA_EXPORT EdgeShuffleTopology;
 class KATANA_EXPORT EdgeTypeAwareTopology;
 class KATANA_EXPORT ProjectedTopology;
+class KATANA_EXPORT LazyProjectedTopology;
 
 /// A graph topology represents the adjacency information for a graph in CSR
 /// format.
@@ -599,6 +604,11 @@ public:
 
   auto num_edges() const noexcept { return topo().num_edges(); }
 
+  /// The CSR arrays of the wrapped topology, e.g., for EdgeSourceIndex::Make
+  auto adj_data() const noexcept { return topo().adj_data(); }
+
+  auto dest_data() const noexcept { return topo().dest_data(); }
+
   /// Gets the edge range of some node.
   ///
   /// \param node node to get the edge range of
@@ -674,6 +684,10 @@ public:
 
   uint64_t num_edges() const noexcept { return dests_.size(); }
 
+  uint64_t num_projected_nodes() const noexcept { return num_nodes(); }
+
+  uint64_t num_projected_edges() const noexcept { return num_edges(); }
+
   const Edge* adj_data() const noexcept { return adj_indices_.data(); }
 
   const Node* dest_data() const noexcept { return dests_.data(); }
@@ -863,18 +877,347 @@ private:
   arrow::internal::Bitmap edge_bitmask_;
 };
 
-class KATANA_EXPORT ProjectedPropGraphViewWrapper : public GraphTopologyTypes {
+/// A projection of a GraphTopology that filters nodes and edges on the fly
+/// instead of building a CSR of its own like ProjectedTopology does. It only
+/// keeps a bit per node and per edge of the original topology, and
+/// optionally the projected degree of each node.
+///
+/// Node and edge IDs are those of the original topology, so num_nodes() and
+/// num_edges() are the sizes of the original ID spaces and per node arrays
+/// can be indexed by node ID directly. Nodes outside the projection have no
+/// edges. Edges of a node are found by scanning its original edges, so
+/// traversals cost about as much as on the original topology; this beats
+/// building a ProjectedTopology when the projection keeps most of the graph.
+/// Edge ranges are forward ranges only.
+///
+/// The original topology must outlive the projection and must not change.
+class KATANA_EXPORT LazyProjectedTopology : public GraphTopologyTypes {
+  struct EdgeInProjection {
+    const DynamicBitset* edges{nullptr};
+    bool operator()(const Edge& e) const noexcept { return edges->test(e); }
+  };
+
 public:
-  explicit ProjectedPropGraphViewWrapper(
-      const PropertyGraph* pg, const ProjectedTopology* projected_topo) noexcept
+  using edge_iterator =
+      boost::filter_iterator<EdgeInProjection, GraphTopology::edge_iterator>;
+  using edges_range = StandardRange<edge_iterator>;
+
+  /// Projections that keep at least this fraction of the nodes and of the
+  /// edges are cheaper to use lazily than to materialize
+  static constexpr double kMinSelectivity = 0.5;
+
+  LazyProjectedTopology(LazyProjectedTopology&&) = default;
+  LazyProjectedTopology& operator=(LazyProjectedTopology&&) = default;
+
+  LazyProjectedTopology(const LazyProjectedTopology&) = delete;
+  LazyProjectedTopology& operator=(const LazyProjectedTopology&) = delete;
+
+  /// Project onto the nodes for which node_pred holds and the edges between
+  /// them for which edge_pred holds. Both predicates are evaluated once, in
+  /// parallel.
+  /// @param cache_degrees store the projected degree of every node, which
+  /// makes degree() constant time at 4 bytes per node
+  template <typename NodePred, typename EdgePred>
+  static std::unique_ptr<LazyProjectedTopology> Make(
+      const GraphTopology* topo, const NodePred& node_pred,
+      const EdgePred& edge_pred, bool cache_degrees = true) {
+    DynamicBitset nodes;
+    nodes.resize(topo->num_nodes());
+    katana::do_all(
+        katana::iterate(topo->all_nodes()),
+        [&](const Node& n) {
+          if (node_pred(n)) {
+            nodes.set(n);
+          }
+        },
+        katana::no_stats());
+
+    DynamicBitset edges;
+    edges.resize(topo->num_edges());
+    NUMAArray<uint32_t> degrees;
+    if (cache_degrees) {
+      degrees.allocateInterleaved(topo->num_nodes());
+    }
+    katana::do_all(
+        katana::iterate(topo->all_nodes()),
+        [&](const Node& n) {
+          uint32_t degree = 0;
+          if (nodes.test(n)) {
+            for (Edge e : topo->edges(n)) {
+              if (nodes.test(topo->edge_dest(e)) && edge_pred(e)) {
+                edges.set(e);
+                ++degree;
+              }
+            }
+          }
+          if (cache_degrees) {
+            degrees[n] = degree;
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    return std::unique_ptr<LazyProjectedTopology>(new LazyProjectedTopology(
+        topo, std::move(nodes), std::move(edges), std::move(degrees)));
+  }
+
+  /// Project onto the nodes with one of node_types and the edges between
+  /// them with one of edge_types. An empty list of types selects all nodes or
+  /// edges, as in ProjectedTopology::MakeTypeProjectedTopology.
+  static std::unique_ptr<LazyProjectedTopology> MakeTypeProjectedTopology(
+      const PropertyGraph* pg, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types, bool cache_degrees = true);
+
+  uint64_t num_nodes() const noexcept { return topo_->num_nodes(); }
+
+  uint64_t num_edges() const noexcept { return topo_->num_edges(); }
+
+  uint64_t num_projected_nodes() const noexcept { return num_projected_nodes_; }
+
+  uint64_t num_projected_edges() const noexcept { return num_projected_edges_; }
+
+  bool is_node_in_projection(const Node& n) const noexcept {
+    return nodes_.test(n);
+  }
+
+  bool is_edge_in_projection(const Edge& e) const noexcept {
+    return edges_.test(e);
+  }
+
+  edges_range edges(Node node) const noexcept {
+    auto range = topo_->edges(node);
+    EdgeInProjection pred{&edges_};
+    return MakeStandardRange(
+        edge_iterator(pred, range.begin(), range.end()),
+        edge_iterator(pred, range.end(), range.end()));
+  }
+
+  Node edge_source(const Edge& eid) const noexcept {
+    return topo_->edge_source(eid);
+  }
+
+  Node edge_dest(const Edge& eid) const noexcept {
+    return topo_->edge_dest(eid);
+  }
+
+  nodes_range nodes(Node begin, Node end) const noexcept {
+    return MakeStandardRange<node_iterator>(begin, end);
+  }
+
+  nodes_range all_nodes() const noexcept { return topo_->all_nodes(); }
+
+  /// All edge IDs of the original topology, including the ones outside the
+  /// projection
+  GraphTopology::edges_range all_edges() const noexcept {
+    return topo_->all_edges();
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const noexcept { return node_iterator(0); }
+
+  node_iterator end() const noexcept { return node_iterator(num_nodes()); }
+
+  size_t size() const noexcept { return num_nodes(); }
+
+  bool empty() const noexcept { return num_nodes() == 0; }
+
+  /// @param node node to get the projected degree of
+  /// @returns the number of edges of node in the projection; linear in the
+  /// original degree unless degrees are cached
+  size_t degree(Node node) const noexcept {
+    if (!degrees_.empty()) {
+      return degrees_[node];
+    }
+    auto range = edges(node);
+    return std::distance(range.begin(), range.end());
+  }
+
+  PropertyIndex edge_property_index(const Edge& eid) const noexcept {
+    return eid;
+  }
+
+  PropertyIndex node_property_index(const Node& nid) const noexcept {
+    return nid;
+  }
+
+  Node projected_to_original_node_id(const Node& nid) const noexcept {
+    return nid;
+  }
+
+  /// @returns nid, or num_nodes() if nid is not in the projection
+  Node original_to_projected_node_id(const Node& nid) const noexcept {
+    return is_node_in_projection(nid) ? nid : static_cast<Node>(num_nodes());
+  }
+
+  Edge projected_to_original_edge_id(const Edge& eid) const noexcept {
+    return eid;
+  }
+
+  /// @returns eid, or num_edges() if eid is not in the projection
+  Edge original_to_projected_edge_id(const Edge& eid) const noexcept {
+    return is_edge_in_projection(eid) ? eid : num_edges();
+  }
+
+  const std::shared_ptr<arrow::Buffer>& node_bitmask() const noexcept {
+    return node_bitmask_.buffer();
+  }
+
+  const std::shared_ptr<arrow::Buffer>& edge_bitmask() const noexcept {
+    return edge_bitmask_.buffer();
+  }
+
+  /// The number of bytes used on top of the original topology
+  size_t num_bytes() const noexcept;
+
+private:
+  LazyProjectedTopology(
+      const GraphTopology* topo, DynamicBitset&& nodes, DynamicBitset&& edges,
+      NUMAArray<uint32_t>&& degrees) noexcept;
+
+  const GraphTopology* topo_;
+  DynamicBitset nodes_;
+  DynamicBitset edges_;
+  NUMAArray<uint32_t> degrees_;
+  uint64_t num_projected_nodes_{0};
+  uint64_t num_projected_edges_{0};
+  NUMAArray<uint8_t> node_bitmask_data_;
+  NUMAArray<uint8_t> edge_bitmask_data_;
+  arrow::internal::Bitmap node_bitmask_;
+  arrow::internal::Bitmap edge_bitmask_;
+};
+
+/// The source node of the edges of a CSR topology, so that finding the
+/// source of an edge does not need a binary search over the adjacency
+/// indices of all nodes.
+///
+/// With a stride of 1 the source of every edge is stored, at 4 bytes per
+/// edge. With a larger stride only the source of every stride-th edge is
+/// stored, at 4 / stride bytes per edge, and a lookup binary searches the
+/// adjacency indices between the two nearest samples, which usually span a
+/// handful of nodes.
+///
+/// The topology must outlive the index and must not change.
+class KATANA_EXPORT EdgeSourceIndex : public GraphTopologyTypes {
+public:
+  EdgeSourceIndex(EdgeSourceIndex&&) = default;
+  EdgeSourceIndex& operator=(EdgeSourceIndex&&) = default;
+
+  EdgeSourceIndex(const EdgeSourceIndex&) = delete;
+  EdgeSourceIndex& operator=(const EdgeSourceIndex&) = delete;
+
+  /// Build the index in parallel over the CSR arrays of a topology
+  static std::unique_ptr<EdgeSourceIndex> Make(
+      const Edge* adj_indices, uint64_t num_nodes, const Node* dests,
+      uint64_t num_edges, uint32_t stride = 1);
+
+  /// @param topo a GraphTopology or ProjectedTopology
+  template <typename Topo>
+  static std::unique_ptr<EdgeSourceIndex> Make(
+      const Topo& topo, uint32_t stride = 1) {
+    return Make(
+        topo.adj_data(), topo.num_nodes(), topo.dest_data(), topo.num_edges(),
+        stride);
+  }
+
+  uint64_t num_nodes() const noexcept { return num_nodes_; }
+
+  uint64_t num_edges() const noexcept { return num_edges_; }
+
+  uint32_t stride() const noexcept { return stride_; }
+
+  Node edge_source(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < num_edges_);
+    if (stride_ == 1) {
+      return sources_[eid];
+    }
+    // the source of eid is the first node whose adjacency index is greater
+    // than eid, and lies between the sources of the samples around eid
+    size_t sample = eid / stride_;
+    Node lo = sources_[sample];
+    Node hi = sample + 1 < sources_.size() ? sources_[sample + 1]
+                                           : static_cast<Node>(num_nodes_ - 1);
+    return static_cast<Node>(
+        std::upper_bound(adj_indices_ + lo, adj_indices_ + hi, eid) -
+        adj_indices_);
+  }
+
+  Node edge_dest(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < num_edges_);
+    return dests_[eid];
+  }
+
+  /// All edges, for edge parallel loops that need both endpoints:
+  ///
+  ///     katana::do_all(katana::iterate(index->all_edges()), [&](Edge e) {
+  ///       Node src = index->edge_source(e);
+  ///       Node dest = index->edge_dest(e);
+  ///       ...
+  ///     });
+  edges_range all_edges() const noexcept {
+    return MakeStandardRange<edge_iterator>(Edge{0}, Edge{num_edges_});
+  }
+
+  size_t num_bytes() const noexcept { return sources_.size() * sizeof(Node); }
+
+private:
+  EdgeSourceIndex(
+      const Edge* adj_indices, uint64_t num_nodes, const Node* dests,
+      uint64_t num_edges, uint32_t stride, NUMAArray<Node>&& sources) noexcept
+      : adj_indices_(adj_indices),
+        dests_(dests),
+        num_nodes_(num_nodes),
+        num_edges_(num_edges),
+        stride_(stride),
+        sources_(std::move(sources)) {}
+
+  const Edge* adj_indices_;
+  const Node* dests_;
+  uint64_t num_nodes_;
+  uint64_t num_edges_;
+  uint32_t stride_;
+  /// The source of edges 0, stride, 2 * stride, ...
+  NUMAArray<Node> sources_;
+};
+
+/// Wraps a ProjectedTopology or a LazyProjectedTopology
+template <typename Topo>
+class KATANA_EXPORT BasicProjectedPropGraphViewWrapper
+    : public GraphTopologyTypes {
+public:
+  using edge_iterator = typename Topo::edge_iterator;
+  using edges_range = typename Topo::edges_range;
+
+  explicit BasicProjectedPropGraphViewWrapper(
+      const PropertyGraph* pg, const Topo* projected_topo) noexcept
       : prop_graph_(pg), projected_topo_ptr_(projected_topo) {
     KATANA_LOG_DEBUG_ASSERT(projected_topo_ptr_);
   }
 
+  /// The view shares ownership of projected_topo, so that it stays valid
+  /// after the topology is evicted from the PGViewCache
+  explicit BasicProjectedPropGraphViewWrapper(
+      const PropertyGraph* pg,
+      std::shared_ptr<const Topo> projected_topo) noexcept
+      : prop_graph_(pg),
+        projected_topo_ptr_(projected_topo.get()),
+        projected_topo_owner_(std::move(projected_topo)) {
+    KATANA_LOG_DEBUG_ASSERT(projected_topo_ptr_);
+  }
+
   auto num_nodes() const noexcept { return topo().num_nodes(); }
 
   auto num_edges() const noexcept { return topo().num_edges(); }
 
+  /// The number of nodes in the projection, which is less than num_nodes()
+  /// for lazy projections
+  auto num_projected_nodes() const noexcept {
+    return topo().num_projected_nodes();
+  }
+
+  auto num_projected_edges() const noexcept {
+    return topo().num_projected_edges();
+  }
+
   /// Gets the edge range of some node.
   ///
   /// \param node node to get the edge range of
@@ -945,15 +1288,19 @@ public:
   }
 
 protected:
-  const ProjectedTopology& topo() const noexcept {
-    return *projected_topo_ptr_;
-  }
+  const Topo& topo() const noexcept { return *projected_topo_ptr_; }
 
 private:
   const PropertyGraph* prop_graph_;
-  const ProjectedTopology* projected_topo_ptr_;
+  const Topo* projected_topo_ptr_;
+  std::shared_ptr<const Topo> projected_topo_owner_;
 };
 
+using ProjectedPropGraphViewWrapper =
+    BasicProjectedPropGraphViewWrapper<ProjectedTopology>;
+using LazyProjectedPropGraphViewWrapper =
+    BasicProjectedPropGraphViewWrapper<LazyProjectedTopology>;
+
 namespace internal {
 // TODO(amber): make private
 template <typename Topo>
@@ -1473,14 +1820,19 @@ class BasicPropGraphViewWrapper : public Topo {
   using Base = Topo;
 
 public:
+  /// @param topos the cached topologies that topo points into; the view
+  /// shares their ownership so that it stays valid after they are evicted
+  /// from the PGViewCache
   explicit BasicPropGraphViewWrapper(
-      PropertyGraph* pg, const Topo& topo) noexcept
-      : Base(topo), prop_graph_(pg) {}
+      PropertyGraph* pg, const Topo& topo,
+      std::vector<std::shared_ptr<const void>> topos = {}) noexcept
+      : Base(topo), prop_graph_(pg), topos_(std::move(topos)) {}
 
   const PropertyGraph& property_graph() const noexcept { return *prop_graph_; }
 
 private:
   PropertyGraph* prop_graph_;
+  std::vector<std::shared_ptr<const void>> topos_;
 };
 
 namespace internal {
@@ -1492,6 +1844,7 @@ using PGViewBiDirectional = BasicPropGraphViewWrapper<SimpleBiDirTopology>;
 using PGViewEdgeTypeAwareBiDir =
     BasicPropGraphViewWrapper<EdgeTypeAwareBiDirTopology>;
 using PGViewProjectedGraph = ProjectedPropGraphViewWrapper;
+using PGViewLazyProjectedGraph = LazyProjectedPropGraphViewWrapper;
 
 template <typename PGView>
 struct PGViewBuilder {};
@@ -1504,10 +1857,10 @@ struct PGViewBuilder<PGViewBiDirectional> {
     auto tpose_topo = viewCache.BuildOrGetEdgeShuffTopo(
         pg, tsuba::RDGTopology::TransposeKind::kYes,
         tsuba::RDGTopology::EdgeSortKind::kAny);
-    auto bidir_topo =
-        SimpleBiDirTopology{viewCache.GetOriginalTopology(pg), tpose_topo};
+    auto bidir_topo = SimpleBiDirTopology{
+        viewCache.GetOriginalTopology(pg), tpose_topo.get()};
 
-    return PGViewBiDirectional{pg, bidir_topo};
+    return PGViewBiDirectional{pg, bidir_topo, {tpose_topo}};
   }
 };
 
@@ -1521,7 +1874,7 @@ struct PGViewBuilder<PGViewEdgesSortedByDestID> {
         tsuba::RDGTopology::EdgeSortKind::kSortedByDestID);
 
     return PGViewEdgesSortedByDestID{
-        pg, EdgesSortedByDestTopology{sorted_topo}};
+        pg, EdgesSortedByDestTopology{sorted_topo.get()}, {sorted_topo}};
   }
 };
 
@@ -1536,7 +1889,8 @@ struct PGViewBuilder<PGViewNodesSortedByDegreeEdgesSortedByDestID> {
         tsuba::RDGTopology::EdgeSortKind::kSortedByDestID);
 
     return PGViewNodesSortedByDegreeEdgesSortedByDestID{
-        pg, NodesSortedByDegreeEdgesSortedByDestIDTopology{sorted_topo}};
+        pg, NodesSortedByDegreeEdgesSortedByDestIDTopology{sorted_topo.get()},
+        {sorted_topo}};
   }
 };
 
@@ -1551,7 +1905,8 @@ struct PGViewBuilder<PGViewEdgeTypeAwareBiDir> {
         pg, tsuba::RDGTopology::TransposeKind::kYes);
 
     return PGViewEdgeTypeAwareBiDir{
-        pg, EdgeTypeAwareBiDirTopology{out_topo, in_topo}};
+        pg, EdgeTypeAwareBiDirTopology{out_topo.get(), in_topo.get()},
+        {out_topo, in_topo}};
   }
 };
 
@@ -1565,7 +1920,21 @@ struct PGViewBuilder<PGViewProjectedGraph> {
     auto topo =
         viewCache.BuildOrGetProjectedGraphTopo(pg, node_types, edge_types);
 
-    return PGViewProjectedGraph{pg, topo};
+    return PGViewProjectedGraph{pg, std::move(topo)};
+  }
+};
+
+template <>
+struct PGViewBuilder<PGViewLazyProjectedGraph> {
+  template <typename ViewCache>
+  static PGViewLazyProjectedGraph BuildView(
+      const PropertyGraph* pg, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types,
+      ViewCache& viewCache) noexcept {
+    auto topo =
+        viewCache.BuildOrGetLazyProjectedGraphTopo(pg, node_types, edge_types);
+
+    return PGViewLazyProjectedGraph{pg, std::move(topo)};
   }
 };
 
@@ -1578,19 +1947,36 @@ struct PropertyGraphViews {
   using NodesSortedByDegreeEdgesSortedByDestID =
       internal::PGViewNodesSortedByDegreeEdgesSortedByDestID;
   using ProjectedGraph = internal::PGViewProjectedGraph;
+  using LazyProjectedGraph = internal::PGViewLazyProjectedGraph;
 };
 
-class KATANA_EXPORT PGViewCache {
-  std::vector<std::unique_ptr<EdgeShuffleTopology>> edge_shuff_topos_;
-  std::vector<std::unique_ptr<ShuffleTopology>> fully_shuff_topos_;
-  std::vector<std::unique_ptr<EdgeTypeAwareTopology>> edge_type_aware_topos_;
-  std::unique_ptr<CondensedTypeIDMap> edge_type_id_map_;
-  // TODO(amber): define a node_type_id_map_;
-  std::unique_ptr<ProjectedTopology> projected_topos_;
-
-  template <typename>
-  friend struct internal::PGViewBuilder;
+/// Counters describing how well a PGViewCache serves view requests
+struct KATANA_EXPORT PGViewCacheStats {
+  /// Requests served by a topology that was already in the cache
+  uint64_t hits{0};
+  /// Requests that loaded a topology from storage or built it
+  uint64_t misses{0};
+  /// Misses served by loading a topology from storage
+  uint64_t loads{0};
+  uint64_t evictions{0};
+  /// Total time spent loading and building topologies
+  uint64_t build_usec{0};
+};
 
+/// PGViewCache keeps the topologies that back the views of a PropertyGraph,
+/// keyed by view kind, transpose and sort state and, for projected views, by
+/// the set of node and edge types.
+///
+/// The memory held by the cache is bounded by a byte budget. When a new
+/// topology pushes the cache over budget, the least recently used topologies
+/// are evicted; the most recently used one always stays. Views share
+/// ownership of their topologies, so evicting a topology never invalidates a
+/// view, but its memory is only released once all views using it are gone.
+///
+/// When the PropertyGraph is written, cached topologies that took at least
+/// persist_threshold_usec() to build, or that were loaded from storage, are
+/// persisted so that later loads can skip building them.
+class KATANA_EXPORT PGViewCache {
 public:
   PGViewCache() = default;
   PGViewCache(PGViewCache&&) = default;
@@ -1614,28 +2000,114 @@ public:
         pg, node_types, edge_types, *this);
   }
 
+  /// Get the EdgeSourceIndex of the topology of pg with the given stride,
+  /// building it if it is not cached
+  std::shared_ptr<const EdgeSourceIndex> BuildEdgeSourceIndex(
+      const PropertyGraph* pg, uint32_t stride) noexcept;
+
+  /// Drop all cached topologies. Settings and stats are kept.
+  void Clear() noexcept;
+
+  /// Set the maximum number of bytes held by cached topologies and evict
+  /// topologies until the cache fits. The default is unbounded.
+  void set_memory_budget(size_t num_bytes) noexcept;
+  size_t memory_budget() const noexcept { return memory_budget_; }
+
+  /// Topologies that took less than this to build are not persisted. The
+  /// default, 0, persists all of them.
+  void set_persist_threshold_usec(uint64_t usec) noexcept {
+    persist_threshold_usec_ = usec;
+  }
+  uint64_t persist_threshold_usec() const noexcept {
+    return persist_threshold_usec_;
+  }
+
+  /// The number of bytes held by cached topologies
+  size_t num_bytes() const noexcept { return num_bytes_; }
+  /// The number of cached topologies
+  size_t size() const noexcept { return entries_.size(); }
+
+  const PGViewCacheStats& stats() const noexcept { return stats_; }
+  /// Report stats() through the statistics manager
+  void ReportStats() const;
+
 private:
+  enum class EntryKind {
+    kEdgeShuffleTopology,
+    kShuffleTopology,
+    kEdgeTypeAwareTopology,
+    kProjectedTopology,
+    kLazyProjectedTopology,
+    kEdgeSourceIndex,
+  };
+
+  struct Entry {
+    EntryKind kind;
+    std::shared_ptr<void> topo;
+    /// For projected topologies, the sorted and deduplicated type names
+    std::vector<std::string> node_types;
+    std::vector<std::string> edge_types;
+    size_t num_bytes{0};
+    uint64_t last_used{0};
+    uint64_t build_usec{0};
+    bool loaded{false};
+  };
+
+  template <typename>
+  friend struct internal::PGViewBuilder;
+
+  /// Find a cached topology of kind for which pred holds and mark it as
+  /// used. Updates the hit and miss counters.
+  template <typename Topo, typename Pred>
+  std::shared_ptr<Topo> Find(EntryKind kind, const Pred& pred) noexcept;
+
+  /// Add entry to the cache and evict other topologies if over budget
+  void Insert(Entry&& entry) noexcept;
+
+  void EvictToBudget() noexcept;
+
   const GraphTopology* GetOriginalTopology(
       const PropertyGraph* pg) const noexcept;
 
-  CondensedTypeIDMap* BuildOrGetEdgeTypeIndex(const PropertyGraph* pg) noexcept;
+  std::shared_ptr<CondensedTypeIDMap> BuildOrGetEdgeTypeIndex(
+      const PropertyGraph* pg) noexcept;
 
-  EdgeShuffleTopology* BuildOrGetEdgeShuffTopo(
+  std::shared_ptr<EdgeShuffleTopology> BuildOrGetEdgeShuffTopo(
       PropertyGraph* pg, const tsuba::RDGTopology::TransposeKind& tpose_kind,
       const tsuba::RDGTopology::EdgeSortKind& sort_kind) noexcept;
 
-  ShuffleTopology* BuildOrGetShuffTopo(
+  std::shared_ptr<ShuffleTopology> BuildOrGetShuffTopo(
       PropertyGraph* pg, const tsuba::RDGTopology::TransposeKind& tpose_kind,
       const tsuba::RDGTopology::NodeSortKind& node_sort_todo,
       const tsuba::RDGTopology::EdgeSortKind& edge_sort_todo) noexcept;
 
-  EdgeTypeAwareTopology* BuildOrGetEdgeTypeAwareTopo(
+  std::shared_ptr<EdgeTypeAwareTopology> BuildOrGetEdgeTypeAwareTopo(
       PropertyGraph* pg,
       const tsuba::RDGTopology::TransposeKind& tpose_kind) noexcept;
 
-  ProjectedTopology* BuildOrGetProjectedGraphTopo(
-      const PropertyGraph* pg, const std::vector<std::string>& node_properties,
-      const std::vector<std::string>& edge_properties) noexcept;
+  std::shared_ptr<ProjectedTopology> BuildOrGetProjectedGraphTopo(
+      const PropertyGraph* pg, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types) noexcept;
+
+  std::shared_ptr<LazyProjectedTopology> BuildOrGetLazyProjectedGraphTopo(
+      const PropertyGraph* pg, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types) noexcept;
+
+  /// Find a cached projection of kind onto the given sorted type lists
+  std::shared_ptr<void> FindProjection(
+      EntryKind kind, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types) noexcept;
+
+  std::vector<Entry> entries_;
+  std::shared_ptr<CondensedTypeIDMap> edge_type_id_map_;
+  // TODO(amber): define a node_type_id_map_;
+
+  size_t memory_budget_{std::numeric_limits<size_t>::max()};
+  uint64_t persist_threshold_usec_{0};
+  size_t num_bytes_{0};
+  /// Incremented on every lookup to order entries by last use
+  uint64_t clock_{0};
+  PGViewCacheStats stats_;
 };
 
 /// Creates a uniform-random CSR GraphTopology instance, where each node as
@@ -0,0 +1,60 @@
+#ifndef KATANA_LIBGALOIS_KATANA_HUGEPAGEMEMORYPOOL_H_
+#define KATANA_LIBGALOIS_KATANA_HUGEPAGEMEMORYPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <arrow/memory_pool.h>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// An arrow memory pool that takes buffers of at least allocSize() bytes,
+/// e.g., loaded property columns, from the page allocator so that they are
+/// backed by huge pages, and smaller buffers from the arrow default pool.
+///
+/// Pages are not faulted in at allocation. Buffers can be allocated from any
+/// thread, including I/O threads outside the thread pool, so the pool cannot
+/// page them in interleaved like NUMAArray does; instead each page goes to the
+/// NUMA node of the thread that first writes it, which spreads columns that
+/// are filled by parallel loops over the nodes.
+///
+/// SharedMemSys makes this the backing pool of GetArrowMemoryPool unless the
+/// environment variable KATANA_USE_ARROW_DEFAULT_POOL is true.
+class KATANA_EXPORT HugePageMemoryPool final : public arrow::MemoryPool {
+public:
+  /// The process wide instance, which is never destroyed
+  static HugePageMemoryPool* Get();
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  /// Bytes in large buffers plus bytes in the arrow default pool
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  std::string backend_name() const override;
+
+  /// Bytes in buffers that are backed by pages from the page allocator
+  int64_t large_bytes_allocated() const {
+    return large_bytes_.load(std::memory_order_relaxed);
+  }
+
+private:
+  HugePageMemoryPool() = default;
+
+  static bool IsLarge(int64_t size);
+  //! updates the byte counts after a change of large_delta bytes in large
+  //! buffers
+  void Account(int64_t large_delta);
+
+  std::atomic<int64_t> large_bytes_{0};
+  std::atomic<int64_t> max_memory_{0};
+};
+
+}  // namespace katana
+
+#endif
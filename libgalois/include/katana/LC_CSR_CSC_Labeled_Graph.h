@@ -482,7 +482,7 @@ private:
 
     // ordered map
     std::map<EdgeTy, uint32_t> sortedMap;
-    for (uint32_t i = 0; i < katana::activeThreads; ++i) {
+    for (uint32_t i = 0; i < katana::getActiveThreads(); ++i) {
       auto& edgeLabelsSet = *edgeLabels.getRemote(i);
       for (auto edgeLabel : edgeLabelsSet) {
         sortedMap[edgeLabel] = 1;
@@ -21,6 +21,7 @@
 #define KATANA_LIBGALOIS_KATANA_MEM_H_
 
 #include "katana/Allocators.h"
+#include "katana/Result.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -54,6 +55,21 @@ void EnsurePreallocated(size_t pagesPerThread, size_t bytes);
 KATANA_EXPORT
 void EnsurePreallocated(size_t pages);
 
+/**
+ * Like EnsurePreallocated, but fails with ErrorCode::OutOfMemory, allocating
+ * nothing, if the pages it has to allocate would exceed the limit of
+ * MemoryCategory::kWorklists or the total limit. Pages the page pool takes
+ * later, while loops run, are counted but cannot fail, so algorithms call
+ * this on entry with an estimate of what they need. The check and the
+ * allocation are not atomic: concurrent allocations may still go over the
+ * limits by what they allocate in between.
+ */
+KATANA_EXPORT
+Result<void> TryEnsurePreallocated(size_t pagesPerThread, size_t bytes);
+
+KATANA_EXPORT
+Result<void> TryEnsurePreallocated(size_t pages);
+
 //! [PerIterAllocTy example]
 //! Base allocator for per-iteration allocator
 typedef katana::BumpWithMallocHeap<katana::FreeListHeap<katana::SystemHeap>>
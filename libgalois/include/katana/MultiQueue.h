@@ -0,0 +1,244 @@
+#ifndef KATANA_LIBGALOIS_KATANA_MULTIQUEUE_H_
+#define KATANA_LIBGALOIS_KATANA_MULTIQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "katana/CompilerSpecific.h"
+#include "katana/PaddedLock.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+#include "katana/WorkListHelpers.h"
+
+namespace katana {
+
+/**
+ * Relaxed priority scheduling over any totally ordered priority, including
+ * floating point distances, without the delta that \ref
+ * OrderedByIntegerMetric needs to map priorities to buckets.
+ *
+ * Items live in QueuesPerThread * activeThreads binary heaps, each behind
+ * its own lock. A push goes to a random heap. A pop samples two random heaps,
+ * takes the top of the one whose top has the better priority and retries
+ * elsewhere when the heap is locked, so that threads rarely wait on each
+ * other. Pops are not in priority order, but the items popped are close to
+ * the best ones in the worklist, which suits algorithms that tolerate
+ * out-of-order processing, such as SSSP or preflow-push.
+ *
+ * Indexer is a default-constructable class whose instances conform to
+ * <code>Index i = indexer(item)</code>, where smaller indices are popped
+ * first (larger with UseDescending).
+ *
+ * \code
+ * struct Indexer {
+ *   double operator()(const Request& r) const { return r.dist; }
+ * };
+ *
+ * katana::for_each(
+ *     katana::iterate(init), fn, katana::wl<katana::MultiQueue<Indexer>>());
+ * \endcode
+ *
+ * @tparam Indexer          Indexer class
+ * @tparam QueuesPerThread  Heaps per active thread; more heaps mean less
+ *                          contention but pops further from the best item
+ * @tparam UseDescending    Pop larger indices first
+ */
+template <
+    class Indexer = DummyIndexer<int>, typename T = int, typename Index = int,
+    unsigned QueuesPerThread = 2, bool UseDescending = false,
+    bool Concurrent = true>
+class MultiQueue {
+public:
+  template <typename _T>
+  using retype = MultiQueue<
+      Indexer, _T, typename std::result_of<Indexer(_T)>::type,
+      QueuesPerThread, UseDescending, Concurrent>;
+
+  template <bool _b>
+  using rethread =
+      MultiQueue<Indexer, T, Index, QueuesPerThread, UseDescending, _b>;
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef MultiQueue<
+        _indexer, T, Index, QueuesPerThread, UseDescending, Concurrent>
+        type;
+  };
+
+  template <unsigned _queues_per_thread>
+  struct with_queues_per_thread {
+    typedef MultiQueue<
+        Indexer, T, Index, _queues_per_thread, UseDescending, Concurrent>
+        type;
+  };
+
+  template <bool _use_descending>
+  struct with_descending {
+    typedef MultiQueue<
+        Indexer, T, Index, QueuesPerThread, _use_descending, Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+private:
+  static_assert(QueuesPerThread > 0, "need at least one queue per thread");
+  static_assert(std::is_arithmetic<Index>::value, "index must be a number");
+
+  typedef std::pair<Index, T> Item;
+
+  struct alignas(KATANA_CACHE_LINE_SIZE) Queue
+      : public PaddedLock<Concurrent> {
+    //! index of the top item, or Worst() when empty; read without the lock
+    std::atomic<Index> top{Worst()};
+    //! number of items; read without the lock
+    std::atomic<size_t> size{0};
+    std::vector<Item> heap;
+  };
+
+  struct ThreadData {
+    uint64_t rng{0};
+  };
+
+  //! orders the heaps so that their front has the best index
+  struct HeapCompare {
+    bool operator()(const Item& a, const Item& b) const {
+      return Better(b.first, a.first);
+    }
+  };
+
+  //! number of sampled pairs of heaps before scanning all heaps
+  static constexpr unsigned kPopAttempts = 8;
+
+  PerThreadStorage<ThreadData> data;
+  unsigned numQueues;
+  std::unique_ptr<Queue[]> queues;
+  Indexer indexer;
+
+  static bool Better(const Index& a, const Index& b) {
+    return UseDescending ? b < a : a < b;
+  }
+
+  static constexpr Index Worst() {
+    return UseDescending ? std::numeric_limits<Index>::lowest()
+                         : std::numeric_limits<Index>::max();
+  }
+
+  //! xorshift64*, seeded per thread
+  Queue& randomQueue(ThreadData& p) {
+    if (!p.rng) {
+      p.rng = 0x9E3779B97F4A7C15ULL * (ThreadPool::getTID() + 1);
+    }
+    p.rng ^= p.rng >> 12;
+    p.rng ^= p.rng << 25;
+    p.rng ^= p.rng >> 27;
+    uint64_t r = (p.rng * 0x2545F4914F6CDD1DULL) >> 32;
+    return queues[(r * numQueues) >> 32];
+  }
+
+  //! updates the fields read without the lock; called with the lock held
+  static void publish(Queue& q) {
+    q.top.store(
+        q.heap.empty() ? Worst() : q.heap.front().first,
+        std::memory_order_relaxed);
+    q.size.store(q.heap.size(), std::memory_order_release);
+  }
+
+  //! called with the lock held
+  static std::optional<value_type> popLocked(Queue& q) {
+    if (q.heap.empty()) {
+      return std::nullopt;
+    }
+    std::pop_heap(q.heap.begin(), q.heap.end(), HeapCompare());
+    std::optional<value_type> item(std::move(q.heap.back().second));
+    q.heap.pop_back();
+    publish(q);
+    return item;
+  }
+
+public:
+  MultiQueue(const Indexer& x = Indexer())
+      : numQueues(Concurrent ? QueuesPerThread * getActiveThreads() : 1),
+        queues(new Queue[numQueues]),
+        indexer(x) {}
+
+  MultiQueue(const MultiQueue&) = delete;
+  MultiQueue& operator=(const MultiQueue&) = delete;
+
+  void push(const value_type& val) {
+    Index index = indexer(val);
+    ThreadData& p = *data.getLocal();
+    Queue* q = &randomQueue(p);
+    while (!q->try_lock()) {
+      q = &randomQueue(p);
+    }
+    q->heap.emplace_back(index, val);
+    std::push_heap(q->heap.begin(), q->heap.end(), HeapCompare());
+    publish(*q);
+    q->unlock();
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  std::optional<value_type> pop() {
+    ThreadData& p = *data.getLocal();
+
+    for (unsigned i = 0; i < kPopAttempts; ++i) {
+      Queue& a = randomQueue(p);
+      Queue& b = randomQueue(p);
+      Queue& q = Better(
+                     b.top.load(std::memory_order_relaxed),
+                     a.top.load(std::memory_order_relaxed))
+                     ? b
+                     : a;
+      if (!q.size.load(std::memory_order_acquire) || !q.try_lock()) {
+        continue;
+      }
+      std::optional<value_type> item = popLocked(q);
+      q.unlock();
+      if (item) {
+        return item;
+      }
+    }
+
+    // Only fail once every heap was seen empty, so that no item is left
+    // behind when the executor checks for termination
+    unsigned start = &randomQueue(p) - queues.get();
+    for (unsigned i = 0; i < numQueues; ++i) {
+      Queue& q = queues[(start + i) % numQueues];
+      if (!q.size.load(std::memory_order_acquire)) {
+        continue;
+      }
+      q.lock();
+      std::optional<value_type> item = popLocked(q);
+      q.unlock();
+      if (item) {
+        return item;
+      }
+    }
+    return std::nullopt;
+  }
+};
+KATANA_WLCOMPILECHECK(MultiQueue)
+
+}  // end namespace katana
+
+#endif
@@ -25,6 +25,7 @@
 #include "katana/Galois.h"
 #include "katana/NumaMem.h"
 #include "katana/ParallelSTL.h"
+#include "katana/Result.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -58,10 +59,10 @@ class NUMAArray {
     size_ = n;
     switch (t) {
     case AllocType::Blocked:
-      real_data_ = largeMallocBlocked(n * sizeof(T), activeThreads);
+      real_data_ = largeMallocBlocked(n * sizeof(T), getActiveThreads());
       break;
     case AllocType::Interleaved:
-      real_data_ = largeMallocInterleaved(n * sizeof(T), activeThreads);
+      real_data_ = largeMallocInterleaved(n * sizeof(T), getActiveThreads());
       break;
     case AllocType::Local:
       real_data_ = largeMallocLocal(n * sizeof(T));
@@ -76,6 +77,21 @@ class NUMAArray {
     data_ = reinterpret_cast<T*>(real_data_.get());
   }
 
+  Result<void> TryAllocate(size_t n, AllocType t) {
+    KATANA_LOG_DEBUG_ASSERT(!data_);
+    if (t == AllocType::Blocked) {
+      real_data_ = KATANA_CHECKED(
+          tryLargeMallocBlocked(n * sizeof(T), getActiveThreads()));
+    } else {
+      KATANA_LOG_DEBUG_ASSERT(t == AllocType::Interleaved);
+      real_data_ = KATANA_CHECKED(
+          tryLargeMallocInterleaved(n * sizeof(T), getActiveThreads()));
+    }
+    size_ = n;
+    data_ = reinterpret_cast<T*>(real_data_.get());
+    return ResultSuccess();
+  }
+
 public:
   typedef T raw_value_type;
   typedef T value_type;
@@ -146,6 +162,21 @@ public:
    */
   void allocateBlocked(size_type n) { Allocate(n, AllocType::Blocked); }
 
+  /**
+   * Like allocateInterleaved and allocateBlocked, but the memory is reserved
+   * against the limits of the current MemoryCategory first: fails with
+   * ErrorCode::OutOfMemory, allocating nothing, if that would exceed them.
+   * The other allocate functions count their memory but never fail.
+   *
+   * @param  n         number of elements to allocate
+   */
+  Result<void> tryAllocateInterleaved(size_type n) {
+    return TryAllocate(n, AllocType::Interleaved);
+  }
+  Result<void> tryAllocateBlocked(size_type n) {
+    return TryAllocate(n, AllocType::Blocked);
+  }
+
   /**
    * Allocates using Thread Local memory policy
    *
@@ -174,8 +205,8 @@ public:
   void allocateSpecified(size_type num, RangeArray& ranges) {
     KATANA_LOG_DEBUG_ASSERT(!data_);
 
-    real_data_ =
-        largeMallocSpecified(num * sizeof(T), activeThreads, ranges, sizeof(T));
+    real_data_ = largeMallocSpecified(
+        num * sizeof(T), getActiveThreads(), ranges, sizeof(T));
 
     size_ = num;
     data_ = reinterpret_cast<T*>(real_data_.get());
@@ -289,6 +320,8 @@ public:
 
   void allocateInterleaved(size_type) {}
   void allocateBlocked(size_type) {}
+  Result<void> tryAllocateInterleaved(size_type) { return ResultSuccess(); }
+  Result<void> tryAllocateBlocked(size_type) { return ResultSuccess(); }
   void allocateLocal(size_type) {}
   void allocateFloating(size_type) {}
   template <typename RangeArray>
@@ -24,6 +24,8 @@
 #include <memory>
 #include <vector>
 
+#include "katana/MemoryAccounting.h"
+#include "katana/Result.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -31,12 +33,17 @@ namespace katana {
 namespace internal {
 struct KATANA_EXPORT largeFreer {
   size_t bytes;
+  //! the category that bytes were charged to at allocation
+  MemoryCategory category{MemoryCategory::kOther};
   void operator()(void* ptr) const;
 };
 }  // namespace internal
 
 typedef std::unique_ptr<void, internal::largeFreer> LAptr;
 
+// The large allocations below are charged to CurrentMemoryCategory()
+// regardless of its limit, except for the try variants
+
 KATANA_EXPORT LAptr largeMallocLocal(size_t bytes);  // fault in locally
 KATANA_EXPORT LAptr
 largeMallocFloating(size_t bytes);  // leave numa mapping undefined
@@ -45,6 +52,14 @@ KATANA_EXPORT LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads);
 // fault in block interleaved mapping
 KATANA_EXPORT LAptr largeMallocBlocked(size_t bytes, unsigned numThreads);
 
+// Like largeMallocInterleaved and largeMallocBlocked, but the bytes are
+// reserved against the limits of CurrentMemoryCategory() before allocating,
+// failing with ErrorCode::OutOfMemory rather than going over them
+KATANA_EXPORT Result<LAptr> tryLargeMallocInterleaved(
+    size_t bytes, unsigned numThreads);
+KATANA_EXPORT Result<LAptr> tryLargeMallocBlocked(
+    size_t bytes, unsigned numThreads);
+
 // fault in specified regions for each thread (threadRanges)
 template <typename RangeArrayTy>
 KATANA_EXPORT LAptr largeMallocSpecified(
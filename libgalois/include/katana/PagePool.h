@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "katana/CacheLineStorage.h"
+#include "katana/MemoryAccounting.h"
 #include "katana/PageAlloc.h"
 #include "katana/PtrLock.h"
 #include "katana/SimpleLock.h"
@@ -42,6 +43,9 @@ KATANA_EXPORT void* pagePoolAlloc();
 KATANA_EXPORT void pagePoolFree(void*);
 KATANA_EXPORT void pagePoolPreAlloc(unsigned);
 KATANA_EXPORT void pagePoolEnsurePreallocated(unsigned num);
+//! The number of pages pagePoolEnsurePreallocated(num) would allocate when
+//! called by threads [0, num_threads)
+KATANA_EXPORT size_t pagePoolNumMissing(unsigned num_threads, unsigned num);
 
 //! Returns total large pages allocated by Galois memory management subsystem
 KATANA_EXPORT int numPagePoolAllocTotal();
@@ -70,7 +74,11 @@ class PageAllocState {
   void* allocFromOS() {
     void* ptr = katana::allocPages(1, true);
     KATANA_LOG_DEBUG_ASSERT(ptr);
-    auto tid = katana::ThreadPool::getTID();
+    // Pages stay in the pool once allocated, and the pool mostly feeds
+    // worklists. A page is needed here and now, so it cannot fail on the
+    // limit; TryEnsurePreallocated checks the limit for pages taken ahead.
+    katana::ChargeMemory(katana::MemoryCategory::kWorklists, allocSize());
+    auto tid = katana::ThreadPool::getPoolTID();
     counts[tid] += 1;
     std::lock_guard<katana::SimpleLock> lg(mapLock);
     ownerMap[ptr] = tid;
@@ -101,7 +109,7 @@ public:
   }
 
   void* pageAlloc() {
-    auto tid = katana::ThreadPool::getTID();
+    auto tid = katana::ThreadPool::getPoolTID();
     HeadPtr& hp = pool[tid].data;
     if (hp.getValue()) {
       hp.lock();
@@ -119,6 +127,7 @@ public:
   void pageFree(void* ptr) {
 #ifdef KATANA_USE_JEMALLOC
     freePages(ptr, 1);
+    katana::ReleaseMemory(katana::MemoryCategory::kWorklists, allocSize());
 #else
     KATANA_LOG_DEBUG_ASSERT(ptr);
     mapLock.lock();
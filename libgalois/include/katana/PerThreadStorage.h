@@ -85,6 +85,10 @@ KATANA_EXPORT PerBackend& getPPSBackend();
 
 KATANA_EXPORT void initPTS(unsigned maxT);
 
+/// An instance of T for each thread of the pool. Thread ids passed to
+/// getLocal(unsigned) and getRemote and the range of the iterators are
+/// relative to the group of the calling thread if it is in a
+/// ThreadPool::Group.
 template <typename T>
 class PerThreadStorage {
   PerBackend* b;
@@ -95,7 +99,7 @@ class PerThreadStorage {
       return;
     }
 
-    for (unsigned n = 0; n < GetThreadPool().getMaxThreads(); ++n) {
+    for (unsigned n = 0; n < GetThreadPool().getPoolMaxThreads(); ++n) {
       reinterpret_cast<T*>(b->getRemote(n, offset))->~T();
     }
     b->deallocOffset(offset, sizeof(T));
@@ -141,7 +145,7 @@ public:
     auto& tp = GetThreadPool();
 
     offset = b->allocOffset(sizeof(T));
-    for (unsigned n = 0; n < tp.getMaxThreads(); ++n) {
+    for (unsigned n = 0; n < tp.getPoolMaxThreads(); ++n) {
       new (b->getRemote(n, offset)) T(std::forward<Args>(args)...);
     }
   }
@@ -175,22 +179,22 @@ public:
 
   //! Like getLocal() but optimized for when you already know the thread id
   T* getLocal(unsigned int thread) {
-    void* ditem = b->getLocal(offset, thread);
+    void* ditem = b->getLocal(offset, ThreadPool::getPoolTID(thread));
     return reinterpret_cast<T*>(ditem);
   }
 
   const T* getLocal(unsigned int thread) const {
-    void* ditem = b->getLocal(offset, thread);
+    void* ditem = b->getLocal(offset, ThreadPool::getPoolTID(thread));
     return reinterpret_cast<T*>(ditem);
   }
 
   T* getRemote(unsigned int thread) {
-    void* ditem = b->getRemote(thread, offset);
+    void* ditem = b->getRemote(ThreadPool::getPoolTID(thread), offset);
     return reinterpret_cast<T*>(ditem);
   }
 
   const T* getRemote(unsigned int thread) const {
-    void* ditem = b->getRemote(thread, offset);
+    void* ditem = b->getRemote(ThreadPool::getPoolTID(thread), offset);
     return reinterpret_cast<T*>(ditem);
   }
 
@@ -212,8 +216,8 @@ class PerSocketStorage {
 
   void destruct() {
     auto& tp = GetThreadPool();
-    for (unsigned n = 0; n < tp.getMaxSockets(); ++n) {
-      reinterpret_cast<T*>(b->getRemote(tp.getLeaderForSocket(n), offset))
+    for (unsigned n = 0; n < tp.getPoolMaxSockets(); ++n) {
+      reinterpret_cast<T*>(b->getRemote(tp.getPoolLeaderForSocket(n), offset))
           ->~T();
     }
     b->deallocOffset(offset, sizeof(T));
@@ -228,8 +232,8 @@ public:
 
     offset = b->allocOffset(sizeof(T));
     auto& tp = GetThreadPool();
-    for (unsigned n = 0; n < tp.getMaxSockets(); ++n) {
-      new (b->getRemote(tp.getLeaderForSocket(n), offset))
+    for (unsigned n = 0; n < tp.getPoolMaxSockets(); ++n) {
+      new (b->getRemote(tp.getPoolLeaderForSocket(n), offset))
           T(std::forward<Args>(args)...);
     }
   }
@@ -261,33 +265,31 @@ public:
 
   //! Like getLocal() but optimized for when you already know the thread id
   T* getLocal(unsigned int thread) {
-    void* ditem = b->getLocal(offset, thread);
+    void* ditem = b->getLocal(offset, ThreadPool::getPoolTID(thread));
     return reinterpret_cast<T*>(ditem);
   }
 
   const T* getLocal(unsigned int thread) const {
-    void* ditem = b->getLocal(offset, thread);
+    void* ditem = b->getLocal(offset, ThreadPool::getPoolTID(thread));
     return reinterpret_cast<T*>(ditem);
   }
 
   T* getRemote(unsigned int thread) {
-    void* ditem = b->getRemote(thread, offset);
+    void* ditem = b->getRemote(ThreadPool::getPoolTID(thread), offset);
     return reinterpret_cast<T*>(ditem);
   }
 
   const T* getRemote(unsigned int thread) const {
-    void* ditem = b->getRemote(thread, offset);
+    void* ditem = b->getRemote(ThreadPool::getPoolTID(thread), offset);
     return reinterpret_cast<T*>(ditem);
   }
 
   T* getRemoteByPkg(unsigned int pkg) {
-    void* ditem = b->getRemote(GetThreadPool().getLeaderForSocket(pkg), offset);
-    return reinterpret_cast<T*>(ditem);
+    return getRemote(GetThreadPool().getLeaderForSocket(pkg));
   }
 
   const T* getRemoteByPkg(unsigned int pkg) const {
-    void* ditem = b->getRemote(GetThreadPool().getLeaderForSocket(pkg), offset);
-    return reinterpret_cast<T*>(ditem);
+    return getRemote(GetThreadPool().getLeaderForSocket(pkg));
   }
 
   unsigned size() const { return GetThreadPool().getMaxThreads(); }
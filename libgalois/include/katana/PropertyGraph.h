@@ -10,6 +10,7 @@
 
 #include "katana/ArrowInterchange.h"
 #include "katana/Details.h"
+#include "katana/EdgeShuffle.h"
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/GraphTopology.h"
@@ -118,6 +119,8 @@ private:
 
   friend class PropertyGraphRetractor;
 
+  friend class PropertyGraphDelta;
+
 public:
   /// PropertyView provides a uniform interface when you don't need to
   /// distinguish operating on edge or node properties
@@ -255,6 +258,39 @@ public:
     return pg_view_cache_.BuildView<PGView>(this, node_types, edge_types);
   }
 
+  /// Get an index of the source node of every edge, or of every stride-th
+  /// edge, for kernels that look up edge sources or iterate over edges
+  /// rather than nodes. The index is cached like the topologies of views.
+  std::shared_ptr<const EdgeSourceIndex> BuildEdgeSourceIndex(
+      uint32_t stride = 1) noexcept {
+    return pg_view_cache_.BuildEdgeSourceIndex(this, stride);
+  }
+
+  /// Call func with a view of the nodes with one of node_types and the edges
+  /// between them with one of edge_types, and return its result. If the
+  /// projection keeps at least LazyProjectedTopology::kMinSelectivity of the
+  /// graph, func gets a PropertyGraphViews::LazyProjectedGraph that filters
+  /// the topology on the fly; otherwise it gets a
+  /// PropertyGraphViews::ProjectedGraph with a CSR of its own. func must
+  /// accept both and return the same type for both.
+  template <typename Func>
+  auto WithProjectedView(
+      const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types, Func&& func) {
+    auto lazy_view = BuildView<PropertyGraphViews::LazyProjectedGraph>(
+        node_types, edge_types);
+    uint64_t min_nodes = static_cast<uint64_t>(
+        LazyProjectedTopology::kMinSelectivity * num_nodes());
+    uint64_t min_edges = static_cast<uint64_t>(
+        LazyProjectedTopology::kMinSelectivity * num_edges());
+    if (lazy_view.num_projected_nodes() >= min_nodes &&
+        lazy_view.num_projected_edges() >= min_edges) {
+      return func(lazy_view);
+    }
+    return func(
+        BuildView<PropertyGraphViews::ProjectedGraph>(node_types, edge_types));
+  }
+
   /// Make a property graph from a constructed RDG. Take ownership of the RDG
   /// and its underlying resources.
   static Result<std::unique_ptr<PropertyGraph>> Make(
@@ -333,6 +369,25 @@ public:
 
   uint32_t partition_id() const { return rdg_.partition_id(); }
 
+  /// Statistics saved with the graph, null if there are none; see
+  /// GraphStatistics.h
+  const nlohmann::json& graph_statistics() const {
+    return rdg_.graph_statistics();
+  }
+  /// Replace the saved statistics; they are written by the next Write or
+  /// Commit
+  void set_graph_statistics(nlohmann::json graph_statistics) {
+    rdg_.set_graph_statistics(std::move(graph_statistics));
+  }
+
+  /// Whether Write and Commit name the files they write by their contents,
+  /// so that versions and views share unchanged files; see
+  /// tsuba::RDG::set_content_addressed
+  bool content_addressed() const { return rdg_.content_addressed(); }
+  void set_content_addressed(bool content_addressed) {
+    rdg_.set_content_addressed(content_addressed);
+  }
+
   /// Create a new storage location for a graph and write everything into it.
   ///
   /// \returns io_error if, for instance, a file already exists
@@ -651,6 +706,11 @@ public:
 
   const GraphTopology& topology() const noexcept { return topology_; }
 
+  /// The cache of the topologies that back the views returned by BuildView.
+  /// Use it to set a memory budget or to inspect cache stats.
+  PGViewCache& view_cache() noexcept { return pg_view_cache_; }
+  const PGViewCache& view_cache() const noexcept { return pg_view_cache_; }
+
   const EntityTypeManager& node_entity_type_manager() const noexcept {
     return node_entity_type_manager_;
   }
@@ -875,12 +935,15 @@ KATANA_EXPORT Result<void> SortNodesByDegree(PropertyGraph* pg);
 /// For each edge (a, b) in the graph, this function will
 /// add an additional edge (b, a) except when a == b, in which
 /// case, no additional edge is added.
-/// The generated symmetric graph may have duplicate edges.
+/// The generated symmetric graph may have duplicate edges unless
+/// opts.remove_duplicates is set. Both edges made from an edge have its
+/// edge type and edge properties; node types and properties are copied.
 /// \param pg The original property graph
+/// \param opts Which edges to drop, see EdgeShuffleOptions
 /// \return The new symmetric property graph by adding reverse edges
 // TODO(amber): this function should return a new topology
 KATANA_EXPORT Result<std::unique_ptr<katana::PropertyGraph>>
-CreateSymmetricGraph(PropertyGraph* pg);
+CreateSymmetricGraph(PropertyGraph* pg, const EdgeShuffleOptions& opts = {});
 
 /// Creates in-memory transpose graph.
 ///
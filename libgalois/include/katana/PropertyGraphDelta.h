@@ -0,0 +1,268 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHDELTA_H_
+#define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHDELTA_H_
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/DynamicBitset.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Range.h"
+#include "katana/Result.h"
+
+namespace katana {
+
+/// A PropertyGraphDelta is a mutable layer over a PropertyGraph. It accepts
+/// batches of node and edge insertions and deletions without touching the
+/// CSR of the underlying graph, and exposes the updated graph through the
+/// same edges(n)/edge_dest(e) interface as GraphTopology so that traversal
+/// code can run on it directly.
+///
+/// Inserted edges live in per-node blocks next to the CSR and deletions are
+/// bitmaps over edge and node IDs. Node IDs are stable: inserted nodes are
+/// numbered after the nodes of the underlying graph and removed nodes stay in
+/// [0, num_nodes()) without any edges. Edge IDs of inserted edges are
+/// numbered after the edges of the underlying graph in insertion order.
+///
+/// Compact() builds a fresh PropertyGraph with a CSR that reflects all
+/// updates, and Commit() replaces the contents of the underlying graph with
+/// it and writes a new RDG version. Properties of inserted entities are only
+/// visible after compaction.
+///
+/// Updates are not thread safe with respect to each other or to traversals;
+/// each batch is applied in parallel internally.
+class KATANA_EXPORT PropertyGraphDelta : public GraphTopologyTypes {
+public:
+  /// Iterates over the live out-edges of a node: first the edges of the CSR,
+  /// then the inserted edges, skipping the removed ones.
+  class edge_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Edge;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Edge*;
+    using reference = Edge;
+
+    edge_iterator() = default;
+
+    edge_iterator(
+        const DynamicBitset* removed_edges, Edge base_cur, Edge base_end,
+        const Edge* added_cur, const Edge* added_end)
+        : removed_edges_(removed_edges),
+          base_cur_(base_cur),
+          base_end_(base_end),
+          added_cur_(added_cur),
+          added_end_(added_end) {
+      SkipRemoved();
+    }
+
+    Edge operator*() const {
+      return base_cur_ != base_end_ ? base_cur_ : *added_cur_;
+    }
+
+    edge_iterator& operator++() {
+      if (base_cur_ != base_end_) {
+        ++base_cur_;
+      } else {
+        ++added_cur_;
+      }
+      SkipRemoved();
+      return *this;
+    }
+
+    edge_iterator operator++(int) {
+      edge_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const edge_iterator& other) const {
+      return base_cur_ == other.base_cur_ && added_cur_ == other.added_cur_;
+    }
+    bool operator!=(const edge_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    void SkipRemoved() {
+      while (base_cur_ != base_end_ && removed_edges_->test(base_cur_)) {
+        ++base_cur_;
+      }
+      if (base_cur_ != base_end_) {
+        return;
+      }
+      while (added_cur_ != added_end_ && removed_edges_->test(*added_cur_)) {
+        ++added_cur_;
+      }
+    }
+
+    const DynamicBitset* removed_edges_{nullptr};
+    Edge base_cur_{0};
+    Edge base_end_{0};
+    const Edge* added_cur_{nullptr};
+    const Edge* added_end_{nullptr};
+  };
+
+  using edges_range = StandardRange<edge_iterator>;
+
+  /// Create an empty delta over base, which must outlive it. The CSR of base
+  /// must not change while the delta is in use, except through Commit().
+  explicit PropertyGraphDelta(PropertyGraph* base);
+
+  /// Insert count nodes and return the ID of the first one. The optional
+  /// properties table has one row per node and a subset of the node
+  /// properties of the underlying graph; missing properties are null. The
+  /// optional types have one entry per node; the default is
+  /// kUnknownEntityType.
+  Result<Node> AddNodes(
+      uint64_t count, const std::shared_ptr<arrow::Table>& properties = nullptr,
+      const std::vector<EntityTypeID>& types = {});
+
+  /// Insert the edges srcs[i] -> dests[i] and return the ID of the first
+  /// one; the others follow consecutively. Properties and types are as in
+  /// AddNodes. Inserted edges are grouped by source in parallel.
+  Result<Edge> AddEdges(
+      const std::vector<Node>& srcs, const std::vector<Node>& dests,
+      const std::shared_ptr<arrow::Table>& properties = nullptr,
+      const std::vector<EntityTypeID>& types = {});
+
+  /// Remove the given edges. Edges that are already removed are ignored.
+  Result<void> RemoveEdges(const std::vector<Edge>& edges);
+
+  /// Remove the given nodes together with all of their incident edges. Nodes
+  /// that are already removed are ignored.
+  /// Finding the incoming edges takes a parallel pass over all edges, so
+  /// node deletions should be batched.
+  Result<void> RemoveNodes(const std::vector<Node>& nodes);
+
+  /// Build a new PropertyGraph whose CSR and properties reflect all updates.
+  /// Surviving nodes keep their relative order and are renumbered densely;
+  /// the out-edges of each node are the edges of the underlying graph
+  /// followed by inserted edges in insertion order.
+  Result<std::unique_ptr<PropertyGraph>> Compact() const;
+
+  /// Compact, replace the topology, types and properties of the underlying
+  /// graph with the result and commit it as a new RDG version. Existing
+  /// property indexes are rebuilt. The delta is empty afterwards.
+  Result<void> Commit(const std::string& command_line);
+
+  /// Drop all updates.
+  void Reset();
+
+  PropertyGraph* base() const { return base_; }
+
+  /// Whether there are updates that are not compacted yet.
+  bool empty() const {
+    return num_added_nodes_ == 0 && added_edge_dests_.empty() &&
+           num_removed_nodes_ == 0 && num_removed_edges_ == 0;
+  }
+
+  /// The number of node IDs, including removed nodes.
+  uint64_t num_nodes() const { return num_base_nodes_ + num_added_nodes_; }
+
+  /// The number of live edges.
+  uint64_t num_edges() const {
+    return num_base_edges_ + added_edge_dests_.size() - num_removed_edges_;
+  }
+
+  uint64_t num_live_nodes() const { return num_nodes() - num_removed_nodes_; }
+
+  nodes_range all_nodes() const {
+    return MakeStandardRange<node_iterator>(
+        Node{0}, static_cast<Node>(num_nodes()));
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const { return node_iterator(0); }
+  node_iterator end() const { return node_iterator(num_nodes()); }
+  size_t size() const { return num_nodes(); }
+
+  edges_range edges(Node node) const {
+    KATANA_LOG_DEBUG_ASSERT(node < num_nodes());
+    Edge base_begin = 0;
+    Edge base_end = 0;
+    if (node < num_base_nodes_) {
+      auto base_edges = base_->topology().edges(node);
+      base_begin = *base_edges.begin();
+      base_end = *base_edges.end();
+    }
+    const std::vector<Edge>& added = added_out_edges_[node];
+    const Edge* added_begin = added.data();
+    const Edge* added_end = added.data() + added.size();
+    return MakeStandardRange(
+        edge_iterator(
+            &removed_edges_, base_begin, base_end, added_begin, added_end),
+        edge_iterator(
+            &removed_edges_, base_end, base_end, added_end, added_end));
+  }
+
+  Node edge_dest(Edge edge) const {
+    if (edge < num_base_edges_) {
+      return base_->topology().edge_dest(edge);
+    }
+    return added_edge_dests_[edge - num_base_edges_];
+  }
+
+  /// The number of live out-edges of node; linear in its degree.
+  uint64_t degree(Node node) const {
+    auto range = edges(node);
+    return std::distance(range.begin(), range.end());
+  }
+
+  bool IsNodeRemoved(Node node) const { return removed_nodes_.test(node); }
+  bool IsEdgeRemoved(Edge edge) const { return removed_edges_.test(edge); }
+
+  EntityTypeID GetTypeOfNode(Node node) const {
+    if (node < num_base_nodes_) {
+      return base_->GetTypeOfNode(node);
+    }
+    return added_node_types_[node - num_base_nodes_];
+  }
+
+  EntityTypeID GetTypeOfEdge(Edge edge) const {
+    if (edge < num_base_edges_) {
+      return base_->GetTypeOfEdge(edge);
+    }
+    return added_edge_types_[edge - num_base_edges_];
+  }
+
+private:
+  /// Properties of inserted entities, one table per batch. Batches without
+  /// properties have a table without columns.
+  using PropertyBatches = std::vector<std::shared_ptr<arrow::Table>>;
+
+  /// Check properties against the full schema of the underlying graph and
+  /// append them, or an empty table if null, to batches.
+  static Result<void> AppendProperties(
+      const std::shared_ptr<arrow::Table>& properties,
+      const std::shared_ptr<arrow::Schema>& schema, uint64_t num_rows,
+      PropertyBatches* batches);
+
+  PropertyGraph* base_;
+  uint64_t num_base_nodes_{0};
+  uint64_t num_base_edges_{0};
+
+  uint64_t num_added_nodes_{0};
+  std::vector<EntityTypeID> added_node_types_;
+  PropertyBatches added_node_properties_;
+
+  /// Inserted edge i has ID num_base_edges_ + i.
+  std::vector<Node> added_edge_dests_;
+  std::vector<EntityTypeID> added_edge_types_;
+  PropertyBatches added_edge_properties_;
+  /// The IDs of the inserted out-edges of each node, in insertion order.
+  std::vector<std::vector<Edge>> added_out_edges_;
+
+  DynamicBitset removed_nodes_;
+  DynamicBitset removed_edges_;
+  uint64_t num_removed_nodes_{0};
+  uint64_t num_removed_edges_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef KATANA_LIBGALOIS_KATANA_SHAREDPROPERTYGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_SHAREDPROPERTYGRAPH_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+#include "tsuba/SharedMemory.h"
+
+namespace katana {
+
+/// A PropertyGraph in named shared memory, so that several processes on one
+/// machine can use one copy of a graph.
+///
+/// One process loads the graph as usual and calls Publish, which copies the
+/// topology, the entity type IDs and the loaded properties into a
+/// tsuba::SharedMemory segment. Other processes call Attach with the same
+/// name and get a PropertyGraph whose topology, type IDs and property
+/// arrays point directly into the segment. The publisher should drop its
+/// original graph and use graph() too, so that the machine keeps a single
+/// copy.
+///
+/// The shared parts of graph() are read only, and writing to them, e.g.,
+/// sorting the edges in place, crashes the process. Properties added after
+/// attaching live in the memory of the process that added them. Property
+/// arrays taken from graph() keep the segment mapped after this object is
+/// destroyed.
+///
+/// Destroying the publisher unlinks the name, so no new process can attach,
+/// but attached processes keep their mappings until they detach.
+class KATANA_EXPORT SharedPropertyGraph {
+public:
+  SharedPropertyGraph(const SharedPropertyGraph&) = delete;
+  SharedPropertyGraph& operator=(const SharedPropertyGraph&) = delete;
+  SharedPropertyGraph(SharedPropertyGraph&&) = delete;
+  SharedPropertyGraph& operator=(SharedPropertyGraph&&) = delete;
+
+  ~SharedPropertyGraph();
+
+  /// Copy pg into a new shared memory segment called name
+  ///
+  /// \param name a tsuba::SharedMemory name, e.g., "/my-graph"
+  static Result<std::unique_ptr<SharedPropertyGraph>> Publish(
+      const PropertyGraph& pg, const std::string& name);
+
+  /// Attach to a graph published by another process
+  static Result<std::unique_ptr<SharedPropertyGraph>> Attach(
+      const std::string& name);
+
+  PropertyGraph* graph() { return graph_.get(); }
+  const PropertyGraph* graph() const { return graph_.get(); }
+
+  const std::string& name() const { return segment_->name(); }
+
+  bool is_publisher() const { return is_publisher_; }
+
+  /// The number of processes attached to the graph, including the
+  /// publisher
+  uint64_t num_attached() const { return segment_->num_attached(); }
+
+  /// The size of the shared segment in bytes
+  uint64_t num_bytes() const { return segment_->size(); }
+
+private:
+  SharedPropertyGraph(
+      std::shared_ptr<tsuba::SharedMemory> segment,
+      std::unique_ptr<PropertyGraph> graph, bool is_publisher)
+      : segment_(std::move(segment)),
+        graph_(std::move(graph)),
+        is_publisher_(is_publisher) {}
+
+  static Result<std::unique_ptr<PropertyGraph>> MakeGraph(
+      const std::shared_ptr<tsuba::SharedMemory>& segment);
+
+  std::shared_ptr<tsuba::SharedMemory> segment_;
+  /// Declared after segment_ so that it is destroyed first
+  std::unique_ptr<PropertyGraph> graph_;
+  bool is_publisher_;
+};
+
+}  // namespace katana
+
+#endif
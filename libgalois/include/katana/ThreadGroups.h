@@ -0,0 +1,150 @@
+#ifndef KATANA_LIBGALOIS_KATANA_THREADGROUPS_H_
+#define KATANA_LIBGALOIS_KATANA_THREADGROUPS_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "katana/Barrier.h"
+#include "katana/Result.h"
+#include "katana/TerminationDetection.h"
+#include "katana/ThreadPool.h"
+#include "katana/config.h"
+
+namespace katana {
+
+class ThreadGroupScheduler;
+
+/// A named set of threads of the thread pool on one socket that runs one
+/// request at a time; see ThreadGroupScheduler.
+///
+/// A request is called on thread 0 of the group only, and from there it can
+/// use the parallel code of the library as usual: katana::do_all,
+/// katana::for_each, katana::on_each, the katana::analytics algorithms and
+/// everything else built on them run on the threads of the group, which see
+/// a thread pool of size() threads on a single socket. Inside a request,
+/// katana::getActiveThreads() starts at size(), PerThreadStorage and the
+/// reducers built on it are indexed by the ids of the threads in the group,
+/// and GetBarrier() and GetTerminationDetection() return objects of the
+/// group; see ThreadPool::Group. Statistics reported in a request are
+/// recorded by the threads of the group and merged with those of the other
+/// groups under the same names.
+///
+/// Thread i of a group uses element threads()[i] of a PerThreadStorage, so
+/// requests may update the same reducer at the same time, but reduce()
+/// called in a request only combines the elements of its group. Give each
+/// request its own reducer, or reduce after ThreadGroupScheduler::Run.
+class KATANA_EXPORT ThreadGroup {
+public:
+  ThreadGroup(const ThreadGroup&) = delete;
+  ThreadGroup& operator=(const ThreadGroup&) = delete;
+
+  const std::string& name() const { return name_; }
+
+  /// The number of threads in the group
+  unsigned size() const { return pool_group_.size(); }
+
+  /// The thread pool ids of the threads in the group
+  const std::vector<unsigned>& threads() const {
+    return pool_group_.pool_tids;
+  }
+
+  /// The socket of the threads in the group
+  unsigned socket() const { return socket_; }
+
+  /// The number of requests the group ran
+  uint64_t num_requests() const { return num_requests_; }
+
+private:
+  friend class ThreadGroupScheduler;
+
+  ThreadGroup(std::string name, unsigned socket, std::vector<unsigned> threads);
+
+  std::string name_;
+  unsigned socket_;
+  ThreadPool::Group pool_group_;
+  std::unique_ptr<Barrier> barrier_;
+  std::unique_ptr<TerminationDetection> term_;
+  uint64_t num_requests_{0};
+};
+
+/// Runs independent requests, for instance the queries of a service that
+/// each use a few cores, concurrently on disjoint groups of the threads of
+/// the thread pool.
+///
+/// The active threads are partitioned once into groups that do not span
+/// sockets. Run occupies the whole thread pool: thread 0 of every group
+/// takes the next submitted request and runs it, its parallel loops running
+/// on the threads of the group, and the group goes back for more until no
+/// requests are left. The other threads of a group wait on a condition
+/// variable between loops. Many small requests then run side by side
+/// instead of one after the other on all threads, where each would wait at
+/// barriers that most threads reach with nothing to do.
+///
+///     auto scheduler = ThreadGroupScheduler::Make(4).value();
+///     for (auto& query : queries) {
+///       // query.Run() may call katana::do_all or katana::analytics::Bfs
+///       scheduler->Submit([&](ThreadGroup&) { query.Run(); });
+///     }
+///     scheduler->Run();
+class KATANA_EXPORT ThreadGroupScheduler {
+public:
+  using Request = std::function<void(ThreadGroup&)>;
+
+  ThreadGroupScheduler(const ThreadGroupScheduler&) = delete;
+  ThreadGroupScheduler& operator=(const ThreadGroupScheduler&) = delete;
+
+  /// Partition the active threads into groups of group_size threads. The
+  /// threads of a socket are split separately, so the last group of a
+  /// socket may be smaller, and a group_size larger than a socket gives one
+  /// group per socket.
+  static Result<std::unique_ptr<ThreadGroupScheduler>> Make(
+      unsigned group_size);
+
+  /// One group with all the active threads of each socket
+  static Result<std::unique_ptr<ThreadGroupScheduler>> MakePerSocket();
+
+  const std::vector<std::unique_ptr<ThreadGroup>>& groups() const {
+    return groups_;
+  }
+
+  /// Queue a request for the next group that becomes free; may be called
+  /// from requests, which Run then also runs before returning
+  void Submit(Request request);
+
+  /// Run the submitted requests until none are left; must not be called
+  /// from a parallel section
+  void Run();
+
+private:
+  ThreadGroupScheduler() = default;
+
+  /// The loop of every thread of group during Run
+  void RunGroup(ThreadGroup* group);
+
+  /// Called by thread 0 of a group once it finished its previous request,
+  /// if any; pops the next request into current and returns true, or
+  /// returns false once no requests are queued and no group is running one
+  /// that may submit more
+  bool NextRequest(bool finished, Request* current);
+
+  std::vector<std::unique_ptr<ThreadGroup>> groups_;
+  /// For each thread pool id, the group of the thread
+  std::vector<ThreadGroup*> group_of_thread_;
+  unsigned num_threads_{0};
+
+  std::mutex mutex_;
+  /// Signaled when a request is queued or the last running one finished
+  std::condition_variable cv_;
+  std::deque<Request> requests_;
+  unsigned num_running_{0};
+};
+
+}  // namespace katana
+
+#endif
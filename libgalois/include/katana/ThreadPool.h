@@ -23,8 +23,10 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -51,7 +53,64 @@ struct ExecuteTupleImpl<tpl, s, 0> {
 
 namespace katana {
 
+class Barrier;
+class TerminationDetection;
+
 class KATANA_EXPORT ThreadPool {
+public:
+  /// Threads of the pool that run parallel sections of their own, side by
+  /// side with other groups; the mechanism behind ThreadGroup.
+  ///
+  /// While a thread is in a group, the pool looks to it like a machine with
+  /// just the threads of the group on a single socket: getTID(), the
+  /// topology queries and getMaxThreads() are relative to the group, and
+  /// thread 0 of the group leads its socket. run() called by thread 0 of the
+  /// group runs on the threads of the group only, and
+  /// katana::getActiveThreads(), GetBarrier() and GetTerminationDetection()
+  /// return the state of the group, so the parallel loops of the library run
+  /// on the group unchanged. PerThreadStorage is indexed by thread ids of
+  /// the group too, which map to the threads of the pool in the group.
+  class KATANA_EXPORT Group {
+  public:
+    /// A group of the threads pool_tids of the pool, which must be on one
+    /// socket
+    explicit Group(std::vector<unsigned> pool_tids);
+
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    unsigned size() const { return pool_tids.size(); }
+
+    /// Thread i of the group is thread pool_tids[i] of the pool
+    const std::vector<unsigned> pool_tids;
+    /// What katana::getActiveThreads() returns in the group
+    unsigned active_threads;
+    /// What GetBarrier() returns in the group, and the number of threads it
+    /// was last initialized for
+    Barrier* barrier{nullptr};
+    unsigned barrier_threads{0};
+    /// What GetTerminationDetection() returns in the group
+    TerminationDetection* term{nullptr};
+
+  private:
+    friend class ThreadPool;
+
+    MachineTopoInfo mi_;
+    std::vector<ThreadTopoInfo> topo_;
+
+    /// Parallel sections are handed from thread 0 to the other threads of
+    /// the group by bumping generation_; they wait on cv_ in between
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<uint64_t> generation_{0};
+    bool closed_{false};
+    std::function<void(void)>* work_{nullptr};
+    unsigned num_{0};
+    std::atomic<unsigned> pending_{0};
+    bool running_{false};
+    std::atomic<unsigned> num_left_{0};
+  };
+
 private:
   friend class SharedMem;
 
@@ -70,7 +129,12 @@ private:
     unsigned wbegin, wend;
     std::atomic<int> done;
     std::atomic<int> fastRelease;
+    //! the place of the thread in the pool
     ThreadTopoInfo topo;
+    //! what the static topology queries return: topo, or the place of the
+    //! thread in its group
+    ThreadTopoInfo view;
+    Group* group{nullptr};
 
     void wakeup(bool fastmode) {
       if (fastmode) {
@@ -126,6 +190,19 @@ private:
   //! execute work on num threads
   void runInternal(unsigned num);
 
+  //! execute work on num threads of the group of the calling thread
+  void runGroup(unsigned num, std::function<void(void)>& work);
+
+  //! the topology of thread tid as seen by the calling thread
+  const ThreadTopoInfo& threadTopo(unsigned tid) const {
+    return my_box.group ? my_box.group->topo_[tid] : signals[tid]->topo;
+  }
+
+  //! the machine as seen by the calling thread
+  const MachineTopoInfo& machineTopo() const {
+    return my_box.group ? my_box.group->mi_ : mi;
+  }
+
   ThreadPool();
 
 public:
@@ -155,6 +232,11 @@ public:
     // paying for an indirection in work allows small-object optimization in
     // std::function to kick in and avoid a heap allocation
     ExecuteTuple lwork(std::forward<Args>(args)...);
+    if (my_box.group) {
+      std::function<void(void)> group_work = std::ref(lwork);
+      runGroup(num, group_work);
+      return;
+    }
     work = std::ref(lwork);
     // work =
     // std::function<void(void)>(ExecuteTuple(std::forward<Args>(args)...));
@@ -171,13 +253,15 @@ public:
   void beKind();
 
   //! return the number of non-reserved threads in the pool
-  unsigned getMaxUsableThreads() const { return mi.maxThreads - reserved; }
+  unsigned getMaxUsableThreads() const {
+    return my_box.group ? my_box.group->size() : mi.maxThreads - reserved;
+  }
   //! return the number of threads supported by the thread pool on the current
   //! machine
-  unsigned getMaxThreads() const { return mi.maxThreads; }
-  unsigned getMaxCores() const { return mi.maxCores; }
-  unsigned getMaxSockets() const { return mi.maxSockets; }
-  unsigned getMaxNumaNodes() const { return mi.maxNumaNodes; }
+  unsigned getMaxThreads() const { return machineTopo().maxThreads; }
+  unsigned getMaxCores() const { return machineTopo().maxCores; }
+  unsigned getMaxSockets() const { return machineTopo().maxSockets; }
+  unsigned getMaxNumaNodes() const { return machineTopo().maxNumaNodes; }
 
   unsigned getLeaderForSocket(unsigned pid) const {
     for (unsigned i = 0; i < getMaxThreads(); ++i)
@@ -187,27 +271,56 @@ public:
   }
 
   bool isLeader(unsigned tid) const {
-    return signals[tid]->topo.socketLeader == tid;
+    return threadTopo(tid).socketLeader == tid;
   }
-  unsigned getSocket(unsigned tid) const { return signals[tid]->topo.socket; }
+  unsigned getSocket(unsigned tid) const { return threadTopo(tid).socket; }
   unsigned getLeader(unsigned tid) const {
-    return signals[tid]->topo.socketLeader;
+    return threadTopo(tid).socketLeader;
   }
   unsigned getCumulativeMaxSocket(unsigned tid) const {
-    return signals[tid]->topo.cumulativeMaxSocket;
-  }
-  unsigned getNumaNode(unsigned tid) const {
-    return signals[tid]->topo.numaNode;
+    return threadTopo(tid).cumulativeMaxSocket;
   }
+  unsigned getNumaNode(unsigned tid) const { return threadTopo(tid).numaNode; }
 
-  static unsigned getTID() { return my_box.topo.tid; }
-  static bool isLeader() { return my_box.topo.tid == my_box.topo.socketLeader; }
-  static unsigned getLeader() { return my_box.topo.socketLeader; }
-  static unsigned getSocket() { return my_box.topo.socket; }
+  static unsigned getTID() { return my_box.view.tid; }
+  static bool isLeader() { return my_box.view.tid == my_box.view.socketLeader; }
+  static unsigned getLeader() { return my_box.view.socketLeader; }
+  static unsigned getSocket() { return my_box.view.socket; }
   static unsigned getCumulativeMaxSocket() {
-    return my_box.topo.cumulativeMaxSocket;
+    return my_box.view.cumulativeMaxSocket;
+  }
+  static unsigned getNumaNode() { return my_box.view.numaNode; }
+
+  //! Like getMaxThreads(), getMaxSockets() and getLeaderForSocket() but for
+  //! the whole pool, also when called from a group; for storage that any
+  //! thread of the pool may use
+  unsigned getPoolMaxThreads() const { return mi.maxThreads; }
+  unsigned getPoolMaxSockets() const { return mi.maxSockets; }
+  unsigned getPoolLeaderForSocket(unsigned pid) const;
+
+  //! the id in the whole pool of the calling thread
+  static unsigned getPoolTID() { return my_box.topo.tid; }
+  //! the id in the whole pool of thread tid of the calling thread's group,
+  //! or tid if the calling thread is not in a group
+  static unsigned getPoolTID(unsigned tid) {
+    return my_box.group ? my_box.group->pool_tids[tid] : tid;
   }
-  static unsigned getNumaNode() { return my_box.topo.numaNode; }
+
+  //! the group of the calling thread, or null
+  static Group* getGroup() { return my_box.group; }
+
+  //! Make the calling thread, which must be one of group->pool_tids, a
+  //! thread of group until leaveGroup(). Called by all threads of the group
+  //! from the same parallel section, once each.
+  void enterGroup(Group* group);
+  void leaveGroup();
+
+  //! Run the parallel sections that thread 0 of the group of the calling
+  //! thread starts until thread 0 calls closeGroup(); called by the other
+  //! threads of the group. They wait on a condition variable between
+  //! sections, so idle groups do not keep their cores busy.
+  void serveGroup();
+  void closeGroup();
 };
 
 /**
@@ -29,11 +29,15 @@ namespace katana {
  * the actual value of threads used, which could be less than the requested
  * value. System behavior is undefined if this function is called during
  * parallel execution or after the first parallel execution.
+ *
+ * Called from a thread group, sets the number of threads of the group that
+ * the iterators of the group use; see ThreadPool::Group.
  */
 KATANA_EXPORT unsigned int setActiveThreads(unsigned int num) noexcept;
 
 /**
- * Returns the number of threads in use.
+ * Returns the number of threads in use, or in use by the group of the calling
+ * thread.
  */
 KATANA_EXPORT unsigned int getActiveThreads() noexcept;
 
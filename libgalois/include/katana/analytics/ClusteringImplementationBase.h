@@ -20,17 +20,107 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/Galois.h"
 #include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
 #include "katana/analytics/Utils.h"
 
 namespace katana::analytics {
 
+/**
+ * Sparse accumulator of edge weight per neighboring cluster.
+ *
+ * Clusters get local indices in the order in which they are first added, so
+ * the first cluster added is index 0. Lookups go through an open-addressing
+ * hash table sized to the number of clusters the caller expects, and clearing
+ * only touches the slots that were used. One instance per thread is reused
+ * for every node it visits, so accumulating does not allocate once the
+ * buffers have grown to the largest degree seen.
+ */
+template <typename EdgeTy>
+class ClusterWeightAccumulator {
+  constexpr static const uint64_t kEmpty = std::numeric_limits<uint64_t>::max();
+
+  struct Slot {
+    uint64_t cluster;
+    uint64_t index;
+  };
+
+public:
+  /**
+   * Forget all clusters and prepare for at most max_clusters distinct ones.
+   */
+  void Reset(uint64_t max_clusters) {
+    for (uint64_t slot : used_slots_) {
+      table_[slot].cluster = kEmpty;
+    }
+    used_slots_.clear();
+    clusters_.clear();
+    weights_.clear();
+
+    // Keep the load factor at most 1/2. Only a prefix of a larger table left
+    // over from a high degree node is used, which keeps probes in cache.
+    shift_ = 64 - 4;
+    uint64_t capacity = 16;
+    while (capacity < 2 * max_clusters) {
+      capacity *= 2;
+      --shift_;
+    }
+    if (table_.size() < capacity) {
+      table_.resize(capacity, Slot{kEmpty, 0});
+    }
+  }
+
+  /**
+   * Add weight to the total for cluster and return its local index.
+   */
+  uint64_t Add(uint64_t cluster, EdgeTy weight) {
+    const uint64_t mask = (uint64_t{1} << (64 - shift_)) - 1;
+    // Fibonacci hashing spreads consecutive cluster IDs over the table.
+    uint64_t slot = (cluster * 0x9E3779B97F4A7C15ULL) >> shift_;
+    while (true) {
+      Slot& s = table_[slot];
+      if (s.cluster == cluster) {
+        weights_[s.index] += weight;
+        return s.index;
+      }
+      if (s.cluster == kEmpty) {
+        s = Slot{cluster, clusters_.size()};
+        used_slots_.push_back(slot);
+        clusters_.push_back(cluster);
+        weights_.push_back(weight);
+        return s.index;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  /// Number of distinct clusters added since the last Reset.
+  uint64_t size() const { return clusters_.size(); }
+
+  /// Cluster ID of local index i.
+  uint64_t cluster(uint64_t i) const { return clusters_[i]; }
+
+  /// Total weight added for local index i.
+  EdgeTy weight(uint64_t i) const { return weights_[i]; }
+
+private:
+  std::vector<Slot> table_;
+  std::vector<uint64_t> used_slots_;
+  std::vector<uint64_t> clusters_;
+  std::vector<EdgeTy> weights_;
+  uint32_t shift_{64 - 4};
+};
+
 // Maintain community information
 template <typename EdgeWeightType>
 struct CommunityType {
@@ -79,24 +169,21 @@ struct ClusteringImplementationBase {
    * Algorithm to find the best cluster for the node
    * to move to among its neighbors in the graph and moves.
    *
-   * It updates the mapping of neighboring nodes clusters
-   * in cluster_local_map, total unique cluster edge weights
-   * in counter as well as total weight of self edges in self_loop_wt.
+   * It accumulates the total edge weight from n to each neighboring
+   * cluster in cluster_weights, with n's current cluster at local index 0,
+   * as well as total weight of self edges in self_loop_wt.
    */
   template <typename EdgeWeightType>
   static void FindNeighboringClusters(
       const Graph& graph, GNode& n,
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
-    uint64_t num_unique_clusters = 0;
+      ClusterWeightAccumulator<EdgeTy>& cluster_weights,
+      EdgeTy& self_loop_wt) {
+    cluster_weights.Reset(
+        std::distance(graph.edge_begin(n), graph.edge_end(n)) + 1);
 
     // Add the node's current cluster to be considered
     // for movement as well
-    cluster_local_map[graph.template GetData<CurrentCommunityID>(n)] =
-        0;                 // Add n's current cluster
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    num_unique_clusters++;
+    cluster_weights.Add(graph.template GetData<CurrentCommunityID>(n), 0);
 
     // Assuming we have grabbed lock on all the neighbors
     for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
@@ -106,21 +193,72 @@ struct ClusteringImplementationBase {
       if (*dst == n) {
         self_loop_wt += edge_wt;  // Self loop weights is recorded
       }
-      auto stored_already =
-          cluster_local_map.find(graph.template GetData<CurrentCommunityID>(
-              dst));  // Check if it already exists
-      if (stored_already != cluster_local_map.end()) {
-        counter[stored_already->second] += edge_wt;
-      } else {
-        cluster_local_map[graph.template GetData<CurrentCommunityID>(dst)] =
-            num_unique_clusters;
-        counter.push_back(edge_wt);
-        num_unique_clusters++;
-      }
+      cluster_weights.Add(
+          graph.template GetData<CurrentCommunityID>(dst), edge_wt);
     }  // End edge loop
     return;
   }
 
+  /**
+   * Groups the nodes by the cluster in their CommunityIDType property.
+   * The nodes of cluster c end up in
+   * nodes[offsets[c]] ... nodes[offsets[c + 1] - 1], in ascending order, and
+   * nodes without a cluster are left out.
+   */
+  template <typename CommunityIDType>
+  static void GroupNodesByCluster(
+      const Graph& graph, uint64_t num_clusters,
+      katana::NUMAArray<uint64_t>* offsets, katana::NUMAArray<GNode>* nodes) {
+    katana::NUMAArray<std::atomic<uint64_t>> cursor;
+    cursor.allocateInterleaved(num_clusters);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) { cursor[c] = 0; }, katana::no_stats());
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) {
+          uint64_t c = graph.template GetData<CommunityIDType>(n);
+          if (c != UNASSIGNED) {
+            cursor[c].fetch_add(1, std::memory_order_relaxed);
+          }
+        },
+        katana::no_stats());
+
+    offsets->allocateInterleaved(num_clusters + 1);
+    (*offsets)[0] = 0;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) { (*offsets)[c + 1] = cursor[c]; }, katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        offsets->begin(), offsets->end(), offsets->begin());
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) { cursor[c] = (*offsets)[c]; }, katana::no_stats());
+
+    nodes->allocateInterleaved((*offsets)[num_clusters]);
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) {
+          uint64_t c = graph.template GetData<CommunityIDType>(n);
+          if (c != UNASSIGNED) {
+            (*nodes)[cursor[c].fetch_add(1, std::memory_order_relaxed)] = n;
+          }
+        },
+        katana::no_stats());
+
+    // Sort each group so that the result does not depend on the schedule.
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) {
+          std::sort(
+              nodes->begin() + (*offsets)[c],
+              nodes->begin() + (*offsets)[c + 1]);
+        },
+        katana::steal(), katana::no_stats());
+  }
+
   /**
    * Enables the filtering optimization to remove the
    * node with out-degree 0 (isolated) and 1 before the clustering
@@ -222,44 +360,43 @@ struct ClusteringImplementationBase {
    * without swapping the cluster assignment.
    */
   static uint64_t MaxModularityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
-      CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
+      const ClusterWeightAccumulator<EdgeTy>& cluster_weights,
+      uint64_t self_loop_wt, CommunityArray& c_info, EdgeTy degree_wt,
+      uint64_t sc, double constant) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = cluster_weights.weight(0) - self_loop_wt;
     double ax = c_info[sc].degree_wt - degree_wt;
     double eiy = 0;
     double ay = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        ay = c_info[stored_already->first].degree_wt;  // Degree wt of cluster y
-
-        if (ay < (ax + degree_wt)) {
-          stored_already++;
-          continue;
-        } else if (ay == (ax + degree_wt) && stored_already->first > sc) {
-          stored_already++;
-          continue;
-        }
+    // Ties are broken by cluster ID, so the order of the clusters does not
+    // matter.
+    for (uint64_t i = 0; i < cluster_weights.size(); ++i) {
+      uint64_t cluster = cluster_weights.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      ay = c_info[cluster].degree_wt;  // Degree wt of cluster y
 
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+      if (ay < (ax + degree_wt)) {
+        continue;
+      } else if (ay == (ax + degree_wt) && cluster > sc) {
+        continue;
+      }
 
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+      eiy = cluster_weights.weight(i);  // Total edges incident on cluster y
+      cur_gain = 2 * constant * (eiy - eix) +
+                 2 * degree_wt * ((ax - ay) * constant * constant);
+
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -415,24 +552,39 @@ struct ClusteringImplementationBase {
  */
   template <typename CommunityIDType>
   static uint64_t RenumberClustersContiguously(Graph* graph) {
-    std::map<uint64_t, uint64_t> cluster_local_map;
-    uint64_t num_unique_clusters = 0;
-
-    for (GNode n = 0; n < graph->num_nodes(); ++n) {
-      auto& n_data_curr_comm_id = graph->template GetData<CommunityIDType>(n);
-      if (n_data_curr_comm_id != UNASSIGNED) {
-        KATANA_LOG_DEBUG_ASSERT(n_data_curr_comm_id < graph->num_nodes());
-        auto stored_already = cluster_local_map.find(n_data_curr_comm_id);
-        if (stored_already != cluster_local_map.end()) {
-          n_data_curr_comm_id = stored_already->second;
-        } else {
-          cluster_local_map[n_data_curr_comm_id] = num_unique_clusters;
-          n_data_curr_comm_id = num_unique_clusters;
-          num_unique_clusters++;
-        }
-      }
-    }
-    return num_unique_clusters;
+    const uint64_t num_nodes = graph->num_nodes();
+
+    // new_id[c] is 1 if cluster c is used, then its new ID plus one after
+    // the prefix sum. Surviving clusters keep their relative order.
+    katana::NUMAArray<uint64_t> new_id;
+    new_id.allocateInterleaved(num_nodes);
+    katana::ParallelSTL::fill(new_id.begin(), new_id.end(), uint64_t{0});
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          uint64_t c = graph->template GetData<CommunityIDType>(n);
+          if (c != UNASSIGNED) {
+            KATANA_LOG_DEBUG_ASSERT(c < num_nodes);
+            new_id[c] = 1;
+          }
+        },
+        katana::no_stats());
+
+    katana::ParallelSTL::partial_sum(
+        new_id.begin(), new_id.end(), new_id.begin());
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto& c = graph->template GetData<CommunityIDType>(n);
+          if (c != UNASSIGNED) {
+            c = new_id[c] - 1;
+          }
+        },
+        katana::no_stats());
+
+    return num_nodes == 0 ? 0 : new_id[num_nodes - 1];
   }
 
   template <typename EdgeWeightType>
@@ -527,73 +679,64 @@ struct ClusteringImplementationBase {
 
     const uint64_t num_nodes_next = num_unique_clusters;
 
-    std::vector<std::vector<GNode>> cluster_bags(num_unique_clusters);
-    // TODO(amber): This loop can be parallelized when using a concurrent container
-    // for cluster_bags, but something like katana::InsertBag exhausts the
-    // per-thread-storage memory
-    for (GNode n = 0; n < graph.num_nodes(); ++n) {
-      auto n_data_curr_comm_id = graph.template GetData<CommunityIDType>(n);
-      if (n_data_curr_comm_id != UNASSIGNED) {
-        cluster_bags[n_data_curr_comm_id].push_back(n);
+    katana::NUMAArray<uint64_t> cluster_offsets;
+    katana::NUMAArray<GNode> cluster_nodes;
+    GroupNodesByCluster<CommunityIDType>(
+        graph, num_unique_clusters, &cluster_offsets, &cluster_nodes);
+
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeTy>>
+        cluster_weights_storage;
+
+    // Sums the weights of the edges leaving cluster c per destination cluster.
+    auto accumulate_cluster_edges = [&](uint64_t c) {
+      ClusterWeightAccumulator<EdgeTy>& cluster_weights =
+          *cluster_weights_storage.getLocal();
+      uint64_t max_clusters = 0;
+      for (uint64_t i = cluster_offsets[c]; i < cluster_offsets[c + 1]; ++i) {
+        GNode node = cluster_nodes[i];
+        max_clusters +=
+            std::distance(graph.edge_begin(node), graph.edge_end(node));
       }
-    }
-
-    std::vector<katana::gstl::Vector<uint32_t>> edges_id(num_unique_clusters);
-    std::vector<katana::gstl::Vector<EdgeTy>> edges_data(num_unique_clusters);
+      cluster_weights.Reset(std::min(max_clusters, num_unique_clusters));
+
+      for (uint64_t i = cluster_offsets[c]; i < cluster_offsets[c + 1]; ++i) {
+        GNode node = cluster_nodes[i];
+        KATANA_LOG_DEBUG_ASSERT(
+            graph.template GetData<CommunityIDType>(node) ==
+            c);  // All nodes in this group must have same cluster id
+
+        for (auto ii = graph.edge_begin(node); ii != graph.edge_end(node);
+             ++ii) {
+          auto dst = graph.GetEdgeDest(ii);
+          auto dst_data_curr_comm_id =
+              graph.template GetData<CommunityIDType>(dst);
+          KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
+          cluster_weights.Add(
+              dst_data_curr_comm_id,
+              graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
+        }  // End edge loop
+      }
+      return &cluster_weights;
+    };
 
     /* First pass to find the number of edges */
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters),
-        [&](uint64_t c) {
-          katana::gstl::Map<uint64_t, uint64_t> cluster_local_map;
-          uint64_t num_unique_clusters = 0;
-          for (auto node : cluster_bags[c]) {
-            KATANA_LOG_DEBUG_ASSERT(
-                graph.template GetData<CommunityIDType>(node) ==
-                c);  // All nodes in this bag must have same cluster id
-
-            for (auto ii = graph.edge_begin(node); ii != graph.edge_end(node);
-                 ++ii) {
-              auto dst = graph.GetEdgeDest(ii);
-              auto dst_data_curr_comm_id =
-                  graph.template GetData<CommunityIDType>(dst);
-              KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
-              } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
-                edges_id[c].push_back(dst_data_curr_comm_id);
-                edges_data[c].push_back(
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
-                num_unique_clusters++;
-              }
-            }  // End edge loop
-          }
-        },
-        katana::steal(), katana::loopname("BuildGraph: Find edges"));
-
-    /* Serial loop to reduce all the edge counts */
     katana::NUMAArray<uint64_t> prefix_edges_count;
     prefix_edges_count.allocateInterleaved(num_unique_clusters);
 
-    katana::GAccumulator<uint64_t> num_edges_acc;
     katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t c) {
-          prefix_edges_count[c] = edges_id[c].size();
-          num_edges_acc += prefix_edges_count[c];
-        });
-
-    const uint64_t num_edges_next = num_edges_acc.reduce();
+        katana::iterate(uint64_t{0}, num_nodes_next),
+        [&](uint64_t c) {
+          prefix_edges_count[c] = accumulate_cluster_edges(c)->size();
+        },
+        katana::steal(), katana::loopname("BuildGraph: Find edges"));
 
     katana::ParallelSTL::partial_sum(
         prefix_edges_count.begin(), prefix_edges_count.end(),
         prefix_edges_count.begin());
 
-    KATANA_LOG_DEBUG_ASSERT(
-        prefix_edges_count[num_unique_clusters - 1] == num_edges_next);
+    const uint64_t num_edges_next =
+        num_nodes_next == 0 ? 0 : prefix_edges_count[num_nodes_next - 1];
+
     katana::StatTimer TimerConstructFrom("Timer_Construct_From");
     TimerConstructFrom.start();
 
@@ -622,30 +765,24 @@ struct ClusteringImplementationBase {
     katana::NUMAArray<EdgeWeightType> edge_data_next;
     edge_data_next.allocateInterleaved(num_edges_next);
 
+    /* Second pass to write the edges in place */
     katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t n) {
-          uint64_t number_of_edges =
-              (n == 0) ? prefix_edges_count[0]
-                       : (prefix_edges_count[n] - prefix_edges_count[n - 1]);
-          uint64_t start_index = (n == 0) ? 0 : prefix_edges_count[n - 1];
-          for (uint64_t k = 0; k < number_of_edges; ++k) {
-            out_dests_next[start_index + k] = edges_id[n][k];
-            edge_data_next[start_index + k] = edges_data[n][k];
+        katana::iterate(uint64_t{0}, num_nodes_next),
+        [&](uint64_t c) {
+          const ClusterWeightAccumulator<EdgeTy>& cluster_weights =
+              *accumulate_cluster_edges(c);
+          uint64_t start_index = (c == 0) ? 0 : prefix_edges_count[c - 1];
+          KATANA_LOG_DEBUG_ASSERT(
+              start_index + cluster_weights.size() == prefix_edges_count[c]);
+          for (uint64_t k = 0; k < cluster_weights.size(); ++k) {
+            out_dests_next[start_index + k] = cluster_weights.cluster(k);
+            edge_data_next[start_index + k] = cluster_weights.weight(k);
           }
-        });
+        },
+        katana::steal(), katana::loopname("BuildGraph: Write edges"));
 
     TimerConstructFrom.stop();
 
-    // TODO(amber): This is a lame attempt at freeing the memory back to each
-    // thread's pool of free pages and blocks. Due to stealing, the execution of
-    // do_all above that populates these containers may be different from the
-    // do_all below that frees them.
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters), [&](uint64_t c) {
-          edges_id[c] = gstl::Vector<uint32_t>();
-          edges_data[c] = gstl::Vector<EdgeTy>();
-        });
-
     GraphTopology topo_next{
         std::move(prefix_edges_count), std::move(out_dests_next)};
     auto pfg_next_res = katana::PropertyGraph::Make(std::move(topo_next));
@@ -726,7 +863,8 @@ struct ClusteringImplementationBase {
   static uint64_t GetRandomSubcommunity(
       const Graph& graph, GNode n, CommunityArray& subcomm_info,
       uint64_t total_degree_wt, uint64_t comm_id,
-      double constant_for_second_term, double resolution, double randomness) {
+      double constant_for_second_term, double resolution, double randomness,
+      ClusterWeightAccumulator<EdgeTy>& cluster_weights) {
     auto& n_current_subcomm_id =
         graph.template GetData<CurrentSubCommunityID>(n);
     /*
@@ -736,17 +874,6 @@ struct ClusteringImplementationBase {
     subcomm_info[n_current_subcomm_id].node_wt = 0;
     subcomm_info[n_current_subcomm_id].internal_edge_wt = 0;
 
-    /*
-   * Map each neighbor's subcommunity to local number: Subcommunity --> Index
-   */
-    std::map<uint64_t, uint64_t> cluster_local_map;
-
-    /*
-   * Edges weight to each unique subcommunity
-   */
-    std::vector<EdgeTy> counter;
-    std::vector<uint64_t> neighboring_cluster_ids;
-
     /*
    * Identify the neighboring clusters of the currently selected
    * node, that is, the clusters with which the currently
@@ -756,12 +883,10 @@ struct ClusteringImplementationBase {
    * currently selected node will be moved back to its old
    * cluster.
    */
-    cluster_local_map[n_current_subcomm_id] = 0;  // Add n's current
-                                                  // subcommunity
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    neighboring_cluster_ids.push_back(n_current_subcomm_id);
-    uint64_t num_unique_clusters = 1;
+    cluster_weights.Reset(
+        std::distance(graph.edge_begin(n), graph.edge_end(n)) + 1);
+    cluster_weights.Add(n_current_subcomm_id, 0);  // Add n's current
+                                                   // subcommunity
 
     EdgeTy self_loop_wt = 0;
 
@@ -778,19 +903,12 @@ struct ClusteringImplementationBase {
         if (*dst == n) {
           self_loop_wt += edge_wt;  // Self loop weights is recorded
         }
-        auto stored_already = cluster_local_map.find(
-            n_current_subcomm);  // Check if it already exists
-        if (stored_already != cluster_local_map.end()) {
-          counter[stored_already->second] += edge_wt;
-        } else {
-          cluster_local_map[n_current_subcomm] = num_unique_clusters;
-          counter.push_back(edge_wt);
-          neighboring_cluster_ids.push_back(n_current_subcomm);
-          num_unique_clusters++;
-        }
+        cluster_weights.Add(n_current_subcomm, edge_wt);
       }
     }  // End edge loop
 
+    const uint64_t num_unique_clusters = cluster_weights.size();
+
     uint64_t best_cluster = n_current_subcomm_id;
     double max_quality_value_increment = 0;
     double total_transformed_quality_value_increment = 0;
@@ -798,8 +916,10 @@ struct ClusteringImplementationBase {
     std::vector<double> cum_transformed_quality_value_increment_per_cluster(
         num_unique_clusters);
     auto& n_node_wt = graph.template GetData<NodeWeight>(n);
-    for (auto pair : cluster_local_map) {
-      auto subcomm = pair.first;
+    // Visit the subcommunities in local index order so that the cumulative
+    // increments are non-decreasing for the binary search below.
+    for (uint64_t i = 0; i < num_unique_clusters; ++i) {
+      auto subcomm = cluster_weights.cluster(i);
       if (n_current_subcomm_id == subcomm)
         continue;
 
@@ -811,7 +931,8 @@ struct ClusteringImplementationBase {
           constant_for_second_term * (double)subcomm_degree_wt *
               ((double)total_degree_wt - (double)subcomm_degree_wt)) {
         quality_value_increment =
-            counter[pair.second] - n_node_wt * subcomm_node_wt * resolution;
+            cluster_weights.weight(i) -
+            n_node_wt * subcomm_node_wt * resolution;
 
         if (quality_value_increment > max_quality_value_increment) {
           best_cluster = subcomm;
@@ -822,9 +943,8 @@ struct ClusteringImplementationBase {
           total_transformed_quality_value_increment +=
               std::exp(quality_value_increment / randomness);
       }
-      cum_transformed_quality_value_increment_per_cluster[pair.second] =
+      cum_transformed_quality_value_increment_per_cluster[i] =
           total_transformed_quality_value_increment;
-      counter[pair.second] = 0;
     }
 
     /*
@@ -838,7 +958,7 @@ struct ClusteringImplementationBase {
       r = total_transformed_quality_value_increment *
           GenerateRandonNumber(0.0, 1.0);
       min_idx = -1;
-      max_idx = num_unique_clusters + 1;
+      max_idx = num_unique_clusters;
       while (min_idx < max_idx - 1) {
         mid_idx = (min_idx + max_idx) / 2;
         if (cum_transformed_quality_value_increment_per_cluster[mid_idx] >= r)
@@ -846,7 +966,8 @@ struct ClusteringImplementationBase {
         else
           min_idx = mid_idx;
       }
-      chosen_cluster = neighboring_cluster_ids[max_idx];
+      chosen_cluster = cluster_weights.cluster(
+          std::min<uint64_t>(max_idx, num_unique_clusters - 1));
     } else {
       chosen_cluster = best_cluster;
     }
@@ -881,12 +1002,13 @@ struct ClusteringImplementationBase {
  */
   template <typename EdgeWeightType>
   static void MergeNodesSubset(
-      Graph* graph, std::vector<GNode>& cluster_nodes, uint64_t comm_id,
-      uint64_t total_degree_wt, CommunityArray& subcomm_info,
-      double constant_for_second_term, double resolution, double randomness) {
+      Graph* graph, const GNode* cluster_nodes, uint64_t num_cluster_nodes,
+      uint64_t comm_id, uint64_t total_degree_wt, CommunityArray& subcomm_info,
+      double constant_for_second_term, double resolution, double randomness,
+      ClusterWeightAccumulator<EdgeTy>& cluster_weights) {
     // select set R
     std::vector<GNode> cluster_nodes_to_move;
-    for (uint64_t i = 0; i < cluster_nodes.size(); ++i) {
+    for (uint64_t i = 0; i < num_cluster_nodes; ++i) {
       GNode n = cluster_nodes[i];
       auto& n_degree_wt =
           graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
@@ -940,7 +1062,7 @@ struct ClusteringImplementationBase {
       if (subcomm_info[n_current_subcomm_id].size == 1) {
         uint64_t new_subcomm_ass = GetRandomSubcommunity<EdgeWeightType>(
             *graph, n, subcomm_info, total_degree_wt, comm_id,
-            constant_for_second_term, resolution, randomness);
+            constant_for_second_term, resolution, randomness, cluster_weights);
 
         if ((int64_t)new_subcomm_ass != -1 &&
             new_subcomm_ass !=
@@ -991,7 +1113,10 @@ struct ClusteringImplementationBase {
         katana::steal());
 
     // populate nodes into communities
-    std::vector<std::vector<GNode>> cluster_bags(2 * graph->size() + 1);
+    katana::NUMAArray<uint64_t> cluster_offsets;
+    katana::NUMAArray<GNode> cluster_nodes;
+    GroupNodesByCluster<CurrentCommunityID>(
+        *graph, graph->size(), &cluster_offsets, &cluster_nodes);
     CommunityArray comm_info;
 
     comm_info.allocateBlocked(2 * graph->size() + 1);
@@ -1004,23 +1129,28 @@ struct ClusteringImplementationBase {
         },
         katana::steal());
 
-    for (GNode n : *graph) {
-      auto& n_current_comm = graph->template GetData<CurrentCommunityID>(n);
-      auto& n_node_wt = graph->template GetData<NodeWeight>(n);
-      auto& n_degree_wt =
-          graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
-      if (n_current_comm != UNASSIGNED) {
-        cluster_bags[n_current_comm].push_back(n);
-
-        katana::atomicAdd(comm_info[n_current_comm].node_wt, n_node_wt);
-        katana::atomicAdd(comm_info[n_current_comm].degree_wt, n_degree_wt);
-      }
-    }
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto& n_current_comm = graph->template GetData<CurrentCommunityID>(n);
+          auto& n_node_wt = graph->template GetData<NodeWeight>(n);
+          auto& n_degree_wt =
+              graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
+          if (n_current_comm != UNASSIGNED) {
+            katana::atomicAdd(comm_info[n_current_comm].node_wt, n_node_wt);
+            katana::atomicAdd(
+                comm_info[n_current_comm].degree_wt, n_degree_wt);
+          }
+        },
+        katana::no_stats());
 
     CommunityArray subcomm_info;
 
     subcomm_info.allocateBlocked(graph->size() + 1);
 
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeTy>>
+        cluster_weights_storage;
+
     // call MergeNodesSubset for each community in parallel
     katana::do_all(
         katana::iterate((uint64_t)0, (uint64_t)graph->size()), [&](uint64_t c) {
@@ -1030,48 +1160,50 @@ struct ClusteringImplementationBase {
                     * never be split up.
                     */
           comm_info[c].num_sub_communities = 0;
-          if (cluster_bags[c].size() > 1) {
+          uint64_t num_cluster_nodes =
+              cluster_offsets[c + 1] - cluster_offsets[c];
+          if (num_cluster_nodes > 1) {
             MergeNodesSubset<EdgeWeightType>(
-                graph, cluster_bags[c], c, comm_info[c].degree_wt, subcomm_info,
-                constant_for_second_term, resolution, randomness);
-          } else {
-            comm_info[c].num_sub_communities = 0;
+                graph, &cluster_nodes[cluster_offsets[c]], num_cluster_nodes, c,
+                comm_info[c].degree_wt, subcomm_info, constant_for_second_term,
+                resolution, randomness, *cluster_weights_storage.getLocal());
           }
-        });
+        },
+        katana::steal());
   }
 
   template <typename EdgeWeightType>
   uint64_t MaxCPMQualityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeWeightType>& counter, EdgeWeightType self_loop_wt,
-      CommunityArray& c_info, uint64_t node_wt, uint64_t sc,
-      double resolution) {
+      const ClusterWeightAccumulator<EdgeTy>& cluster_weights,
+      EdgeWeightType self_loop_wt, CommunityArray& c_info, uint64_t node_wt,
+      uint64_t sc, double resolution) {
     uint64_t max_index = sc;  // Assign the initial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = cluster_weights.weight(0) - self_loop_wt;
     double eiy = 0;
     double size_x = (double)(c_info[sc].node_wt - node_wt);
     double size_y = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        size_y = c_info[stored_already->first].node_wt;
-
-        cur_gain = 2.0f * (double)(eiy - eix) -
-                   resolution * node_wt * (double)(size_y - size_x);
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+    // Ties are broken by cluster ID, so the order of the clusters does not
+    // matter.
+    for (uint64_t i = 0; i < cluster_weights.size(); ++i) {
+      uint64_t cluster = cluster_weights.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      eiy = cluster_weights.weight(i);  // Total edges incident on cluster y
+      size_y = c_info[cluster].node_wt;
+
+      cur_gain = 2.0f * (double)(eiy - eix) -
+                 resolution * node_wt * (double)(size_y - size_x);
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -18,16 +18,37 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kBatched,
+    kApproximate,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
   };
 
+  static const uint32_t kDefaultBatchSize = 32;
+  static const uint32_t kMaxBatchSize = 64;
+  static constexpr double kDefaultEpsilon = 0.01;
+  static constexpr double kDefaultDelta = 0.1;
+
 private:
   Algorithm algorithm_;
+  uint32_t batch_size_;
+  double epsilon_;
+  double delta_;
+
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t batch_size,
+      double epsilon, double delta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        batch_size_(batch_size),
+        epsilon_(epsilon),
+        delta_(delta) {}
 
   BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+      : BetweennessCentralityPlan(
+            architecture, algorithm, kDefaultBatchSize, kDefaultEpsilon,
+            kDefaultDelta) {}
 
 public:
   BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
@@ -51,10 +72,43 @@ public:
 
   Algorithm algorithm() const { return algorithm_; }
 
+  /// The number of sources traversed together by kBatched.
+  uint32_t batch_size() const { return batch_size_; }
+
+  /// The maximum absolute error of kApproximate on the normalized
+  /// centrality, that is the centrality divided by n * (n - 1).
+  double epsilon() const { return epsilon_; }
+
+  /// The probability with which kApproximate may exceed epsilon.
+  double delta() const { return delta_; }
+
   static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
 
   static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
 
+  /// Brandes' algorithm on batch_size sources at once: one level-synchronous
+  /// traversal carries a bit mask of sources per node, so each level costs
+  /// one parallel loop for the whole batch instead of one per source. Memory
+  /// use grows by about 16 * batch_size bytes per node.
+  /// The centralities are those of kLevel up to float rounding, since the
+  /// dependencies of the sources are summed in a different order.
+  /// batch_size may be at most kMaxBatchSize.
+  static BetweennessCentralityPlan Batched(
+      uint32_t batch_size = kDefaultBatchSize) {
+    return {kCPU, kBatched, batch_size, kDefaultEpsilon, kDefaultDelta};
+  }
+
+  /// Approximate betweenness centrality by sampling uniformly random shortest
+  /// paths between random pairs of nodes, in the style of KADABRA. Sampling
+  /// stops as soon as an empirical Bernstein bound shows every node's
+  /// normalized centrality to be within epsilon with probability 1 - delta,
+  /// and never takes more samples than the Riondato-Kornaropoulos bound for
+  /// the same guarantee. The sources argument is ignored.
+  static BetweennessCentralityPlan Approximate(
+      double epsilon = kDefaultEpsilon, double delta = kDefaultDelta) {
+    return {kCPU, kApproximate, kDefaultBatchSize, epsilon, delta};
+  }
+
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
     return BetweennessCentralityPlan(kCPU, algo);
   }
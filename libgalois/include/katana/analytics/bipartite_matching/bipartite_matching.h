@@ -0,0 +1,97 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_BIPARTITEMATCHING_BIPARTITEMATCHING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_BIPARTITEMATCHING_BIPARTITEMATCHING_H_
+
+#include <iostream>
+#include <limits>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for bipartite matching, specifying the algorithm
+/// and any parameters associated with it.
+class BipartiteMatchingPlan : public Plan {
+public:
+  /// Algorithm selectors for BipartiteMatching
+  enum Algorithm { kPothenFan };
+
+  /// The partner of a node that is not matched.
+  static const uint32_t kUnmatched = std::numeric_limits<uint32_t>::max();
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  BipartiteMatchingPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  BipartiteMatchingPlan() : BipartiteMatchingPlan{kCPU, kPothenFan} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Parallel Pothen-Fan with lookahead and fairness (PF+): after a greedy
+  /// initial matching, each phase starts a depth-first search for an
+  /// augmenting path from every unmatched left node in parallel. Searches
+  /// claim right nodes with an atomic visited flag, so the paths found in a
+  /// phase are disjoint and are augmented without locks. Phases repeat until
+  /// one finds no augmenting path.
+  ///
+  /// Azad, Halappanavar, Rajamanickam, Boman, Khan and Pothen. Multithreaded
+  /// algorithms for maximum matching in bipartite graphs. IPDPS 2012.
+  static BipartiteMatchingPlan PothenFan() { return {kCPU, kPothenFan}; }
+};
+
+/// Compute a maximum cardinality matching between the two sides of pg. Nodes
+/// for which the node property left_side_property_name is true (or nonzero)
+/// are on the left side, nodes for which it is false (or zero) are on the
+/// right side, and nodes for which it is null are not matched. Edges are
+/// followed in both directions and edges between nodes on the same side are
+/// ignored.
+/// The uint32 node property named output_property_name holds the partner of
+/// each matched node and BipartiteMatchingPlan::kUnmatched for other nodes;
+/// it is created by this function and may not exist before the call.
+KATANA_EXPORT Result<void> BipartiteMatching(
+    PropertyGraph* pg, const std::string& left_side_property_name,
+    const std::string& output_property_name, BipartiteMatchingPlan plan = {});
+
+/// Like BipartiteMatching above, but the left side is the nodes of type
+/// left_node_type and the right side is the nodes of type right_node_type.
+/// Nodes of neither type are not matched.
+KATANA_EXPORT Result<void> BipartiteMatchingByNodeTypes(
+    PropertyGraph* pg, const std::string& left_node_type,
+    const std::string& right_node_type, const std::string& output_property_name,
+    BipartiteMatchingPlan plan = {});
+
+/// Check that property_name holds a matching between the sides given by
+/// left_side_property_name and that no augmenting path exists, i.e., that
+/// the matching is maximum.
+KATANA_EXPORT Result<void> BipartiteMatchingAssertValid(
+    PropertyGraph* pg, const std::string& left_side_property_name,
+    const std::string& property_name);
+
+/// Like BipartiteMatchingAssertValid, with the sides given by node types.
+KATANA_EXPORT Result<void> BipartiteMatchingByNodeTypesAssertValid(
+    PropertyGraph* pg, const std::string& left_node_type,
+    const std::string& right_node_type, const std::string& property_name);
+
+struct KATANA_EXPORT BipartiteMatchingStatistics {
+  /// The number of matched pairs, i.e., the size of the matching.
+  uint64_t num_matched_pairs;
+  /// The number of nodes without a partner.
+  uint64_t num_unmatched_nodes;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<BipartiteMatchingStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
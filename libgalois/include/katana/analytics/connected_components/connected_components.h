@@ -145,7 +145,7 @@ public:
       uint32_t neighbor_sample_size = kDefaultNeighborSampleSize,
       uint32_t component_sample_frequency = kDefaultComponentSampleFrequency) {
     return {
-        kCPU, kEdgeAfforest, edge_tile_size, neighbor_sample_size,
+        kCPU, kEdgeTiledAfforest, edge_tile_size, neighbor_sample_size,
         component_sample_frequency};
   }
 };
@@ -161,6 +161,22 @@ KATANA_EXPORT Result<void> ConnectedComponents(
     PropertyGraph* pg, const std::string& output_property_name,
     ConnectedComponentsPlan plan = ConnectedComponentsPlan());
 
+/// Update the Connected-components in the property named property_name after
+/// the edges new_edge_srcs[i] -- new_edge_dests[i] were added. The property
+/// holds the result of ConnectedComponents, or of a previous call of this
+/// function, and is updated in place. Nodes added since then may have a null
+/// component; they are given the component max(uint64_t) - node.
+/// The components joined by the new edges are found by a union-find over
+/// their labels. Then, for each set of joined components, all but one are
+/// relabeled: they are traversed in lockstep until only one is left, so the
+/// work is bounded by the sizes of the smaller components rather than of the
+/// graph. The pg is expected to be symmetric; the new edges may or may not be
+/// in pg already.
+KATANA_EXPORT Result<void> ConnectedComponentsIncremental(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests);
+
 KATANA_EXPORT Result<void> ConnectedComponentsAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
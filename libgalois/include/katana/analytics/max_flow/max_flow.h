@@ -0,0 +1,99 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+
+#include <iostream>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for maximum flow, specifying the algorithm and any
+/// parameters associated with it.
+class MaxFlowPlan : public Plan {
+public:
+  /// Algorithm selectors for MaxFlow
+  enum Algorithm { kPushRelabel };
+
+  static constexpr double kDefaultGlobalRelabelFrequency = 1.0;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double global_relabel_frequency_;
+
+  MaxFlowPlan(
+      Architecture architecture, Algorithm algorithm,
+      double global_relabel_frequency)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        global_relabel_frequency_(global_relabel_frequency) {}
+
+public:
+  MaxFlowPlan()
+      : MaxFlowPlan{kCPU, kPushRelabel, kDefaultGlobalRelabelFrequency} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// How often distance labels are recomputed from scratch. A global
+  /// relabeling runs once the relabeling work since the last one exceeds
+  /// (6 * num_nodes + num_edges) / global_relabel_frequency.
+  double global_relabel_frequency() const { return global_relabel_frequency_; }
+
+  /// Synchronous parallel push-relabel. Each round pushes excess from all
+  /// active nodes along admissible arcs and then relabels them, both in
+  /// parallel. The residual graph is traversed through the out-edges and the
+  /// in-edges (from the cached transpose) of the property graph, so no
+  /// reverse edges are materialized. Global relabeling is a parallel
+  /// breadth-first search from the sink, and the gap heuristic lifts nodes
+  /// above an empty distance label out of the computation.
+  static MaxFlowPlan PushRelabel(
+      double global_relabel_frequency = kDefaultGlobalRelabelFrequency) {
+    return {kCPU, kPushRelabel, global_relabel_frequency};
+  }
+};
+
+/// Compute the maximum flow from source_node to sink_node, where each edge
+/// of pg can carry at most the flow in its edge_capacity_property_name
+/// property. The capacity property may be of any numeric type; fractional
+/// capacities are truncated, null capacities count as 0, and negative
+/// capacities are an error.
+/// The uint8 node property named output_property_name is 1 for the nodes on
+/// the source side of a minimum cut and 0 for the rest; it is created by this
+/// function and may not exist before the call.
+/// @return the value of the maximum flow
+KATANA_EXPORT Result<uint64_t> MaxFlow(
+    PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+    const std::string& edge_capacity_property_name,
+    const std::string& output_property_name, MaxFlowPlan plan = {});
+
+/// Check that the cut in property_name separates source_node from sink_node
+/// and that its capacity equals the maximum flow, computed serially.
+KATANA_EXPORT Result<void> MaxFlowAssertValid(
+    PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+    const std::string& edge_capacity_property_name,
+    const std::string& property_name);
+
+struct KATANA_EXPORT MaxFlowStatistics {
+  /// The total capacity of the edges from the source side to the sink side
+  /// of the cut, which is the value of the maximum flow.
+  uint64_t cut_capacity;
+  /// The number of edges from the source side to the sink side of the cut.
+  uint64_t num_cut_edges;
+  /// The number of nodes on the source side of the cut.
+  uint64_t num_source_side_nodes;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MaxFlowStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_capacity_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
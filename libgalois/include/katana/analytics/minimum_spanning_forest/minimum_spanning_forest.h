@@ -0,0 +1,105 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+
+#include <iostream>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for minimum spanning forest, specifying the
+/// algorithm and any parameters associated with it.
+class MinimumSpanningForestPlan : public Plan {
+public:
+  /// Algorithm selectors for MinimumSpanningForest
+  enum Algorithm { kBoruvka, kFilterKruskal };
+
+  static const uint64_t kDefaultKruskalThreshold = 1 << 14;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint64_t kruskal_threshold_;
+
+  MinimumSpanningForestPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint64_t kruskal_threshold)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        kruskal_threshold_(kruskal_threshold) {}
+
+public:
+  MinimumSpanningForestPlan()
+      : MinimumSpanningForestPlan{kCPU, kBoruvka, kDefaultKruskalThreshold} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of edges below which filter-Kruskal stops partitioning and
+  /// runs the serial Kruskal algorithm on the sorted edges.
+  uint64_t kruskal_threshold() const { return kruskal_threshold_; }
+
+  /// Bulk-synchronous Boruvka. In each round, every component selects its
+  /// lightest outgoing edge in parallel, and then the selected edges are
+  /// merged with a union-find. Edges internal to a component are dropped
+  /// from the work list after every round.
+  static MinimumSpanningForestPlan Boruvka() {
+    return {kCPU, kBoruvka, kDefaultKruskalThreshold};
+  }
+
+  /// Filter-Kruskal.
+  /// [1] V. Osipov, P. Sanders and J. Singler, "The Filter-Kruskal Minimum
+  /// Spanning Tree Algorithm," 2009 Proceedings of the Eleventh Workshop on
+  /// Algorithm Engineering and Experiments (ALENEX), pp. 52-61.
+  /// Edges are recursively partitioned around a sampled pivot weight; the
+  /// light half is solved first, and the heavy half is then filtered in
+  /// parallel to drop edges whose endpoints are already connected. Partitions
+  /// smaller than kruskal_threshold are sorted and processed serially.
+  static MinimumSpanningForestPlan FilterKruskal(
+      uint64_t kruskal_threshold = kDefaultKruskalThreshold) {
+    return {kCPU, kFilterKruskal, kruskal_threshold};
+  }
+};
+
+/// Compute a minimum spanning forest of pg using the edge weights in
+/// edge_weight_property_name, which may be of any numeric type. The graph is
+/// treated as undirected: an edge connects its endpoints irrespective of its
+/// direction, so both copies of an edge in a symmetric graph are candidates
+/// and at most one of them is selected. Self loops are never selected.
+/// The edge property named output_property_name is created by this function
+/// and may not exist before the call. It is 1 for edges in the forest and 0
+/// for all other edges.
+KATANA_EXPORT Result<void> MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan = {});
+
+/// Check that the edges marked in property_name form a spanning forest of pg
+/// (they are acyclic and connect every connected component) and that its
+/// total weight matches a reference serial Kruskal computation.
+KATANA_EXPORT Result<void> MinimumSpanningForestAssertValid(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name);
+
+struct KATANA_EXPORT MinimumSpanningForestStatistics {
+  /// Total number of edges in the forest.
+  uint64_t num_forest_edges;
+  /// Total number of trees in the forest, including isolated nodes.
+  uint64_t num_trees;
+  /// The sum of the weights of the forest edges.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MinimumSpanningForestStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
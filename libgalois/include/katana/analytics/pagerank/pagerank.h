@@ -112,6 +112,22 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// Update the Page Rank in the property named property_name after the edges
+/// new_edge_srcs[i] -> new_edge_dests[i] were added to pg. The property holds
+/// the result of Pagerank with the kPushAsynchronous algorithm, or of a
+/// previous call of this function, and is updated in place. Nodes added since
+/// then may have a null rank.
+/// The change of out-degree of the sources of the new edges is turned into
+/// (possibly negative) residuals on their out-neighbors, and only nodes whose
+/// residual exceeds the tolerance are pushed, so the work scales with the
+/// part of the graph affected by the batch. Residuals left by the previous
+/// computation are assumed to be zero. Only kPushAsynchronous plans are
+/// supported.
+KATANA_EXPORT Result<void> PagerankIncremental(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests, PagerankPlan plan = {});
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
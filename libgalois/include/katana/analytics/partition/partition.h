@@ -0,0 +1,129 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+
+#include <iostream>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for graph partitioning, specifying the algorithm
+/// and any parameters associated with it.
+class PartitionPlan : public Plan {
+public:
+  /// Algorithm selectors for Partition
+  enum Algorithm { kMultilevel };
+
+  static const uint32_t kDefaultRefinementIterations = 8;
+  static const uint32_t kDefaultCoarseningThreshold = 20;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t refinement_iterations_;
+  uint32_t coarsening_threshold_;
+
+  PartitionPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t refinement_iterations, uint32_t coarsening_threshold)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        refinement_iterations_(refinement_iterations),
+        coarsening_threshold_(coarsening_threshold) {}
+
+public:
+  PartitionPlan()
+      : PartitionPlan{
+            kCPU, kMultilevel, kDefaultRefinementIterations,
+            kDefaultCoarseningThreshold} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The maximum number of refinement sweeps at each level.
+  uint32_t refinement_iterations() const { return refinement_iterations_; }
+
+  /// Coarsening stops once the graph has fewer than coarsening_threshold
+  /// nodes per partition.
+  uint32_t coarsening_threshold() const { return coarsening_threshold_; }
+
+  /// Multilevel k-way partitioning in the style of METIS, with every phase
+  /// parallel:
+  ///   - coarsening contracts a heavy-edge matching computed by handshaking
+  ///     (each node proposes to its heaviest unmatched neighbor and mutual
+  ///     proposals are matched);
+  ///   - the coarsest graph is partitioned by greedy graph growing;
+  ///   - on the way back up, each level is refined by synchronous
+  ///     size-constrained label propagation that alternates the direction of
+  ///     moves between partition IDs so that neighbors cannot swap, followed
+  ///     by a rebalancing pass if any partition is overweight.
+  static PartitionPlan Multilevel(
+      uint32_t refinement_iterations = kDefaultRefinementIterations,
+      uint32_t coarsening_threshold = kDefaultCoarseningThreshold) {
+    return {kCPU, kMultilevel, refinement_iterations, coarsening_threshold};
+  }
+};
+
+/// Partition the nodes of pg into num_partitions parts of roughly equal size
+/// while minimizing the number of edges between parts. The pg is expected to
+/// be symmetric.
+/// No part weighs more than (1 + imbalance) times the average part weight,
+/// or the average plus the heaviest node if that is more. Nodes that the
+/// refinement cannot place within that bound are moved to the lightest part,
+/// which may increase the cut.
+/// The uint32 node property named output_property_name holds the partition ID
+/// of each node; it is created by this function and may not exist before the
+/// call.
+KATANA_EXPORT Result<void> Partition(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& output_property_name, PartitionPlan plan = {});
+
+/// Like Partition above, but weighted: the size of a part is the sum of
+/// the weights of its nodes and the cost of a cut edge is its weight. Weight
+/// properties may be of any numeric type; fractional weights are truncated
+/// and null weights count as 1. An empty property name means unit weights.
+KATANA_EXPORT Result<void> Partition(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& node_weight_property_name,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name, PartitionPlan plan = {});
+
+/// Check that every node of pg has a partition ID below num_partitions.
+KATANA_EXPORT Result<void> PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name);
+
+/// Like PartitionAssertValid above, and also check that no part weighs more
+/// than the bound that Partition guarantees for imbalance. An empty node
+/// weight property name means unit weights.
+KATANA_EXPORT Result<void> PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& node_weight_property_name,
+    const std::string& property_name);
+
+struct KATANA_EXPORT PartitionStatistics {
+  /// The number of non-empty partitions.
+  uint32_t num_non_empty_partitions;
+  /// The number of edges whose endpoints are in different partitions.
+  uint64_t edge_cut;
+  /// The number of nodes in the largest partition.
+  uint64_t max_partition_size;
+  /// The number of nodes in the smallest non-empty partition.
+  uint64_t min_partition_size;
+  /// The size of the largest partition divided by the average size.
+  double imbalance;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<PartitionStatistics> Compute(
+      katana::PropertyGraph* pg, uint32_t num_partitions,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PLANADVISOR_PLANADVISOR_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PLANADVISOR_PLANADVISOR_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/sssp/sssp.h"
+#include "katana/analytics/triangle_count/triangle_count.h"
+
+// API
+
+namespace katana::analytics {
+
+/// The shape of a graph, as far as choosing plans is concerned
+struct KATANA_EXPORT GraphFeatures {
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  double average_degree{0.0};
+  uint64_t max_degree{0};
+  /// The highest out-degree over the average out-degree
+  double degree_skew{0.0};
+  /// The fraction of all possible edges that exist
+  double density{0.0};
+  /// A lower bound on the diameter with edges taken as undirected. It is
+  /// taken from saved statistics if there are any, and from BFS sweeps over
+  /// a symmetrized copy of the topology otherwise, which needs about 16
+  /// bytes per edge while it is built.
+  uint64_t estimated_diameter{0};
+  /// Is the sampled degree distribution heavy tailed, as decided by
+  /// IsApproximateDegreeDistributionPowerLaw?
+  bool power_law{false};
+  /// Were the degrees and diameter read from statistics saved with the graph?
+  bool from_saved_statistics{false};
+
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the features of pg, reading degrees and the diameter from the
+  /// statistics saved with it (see katana::StoreGraphStatistics) if allowed
+  /// and there are any.
+  static katana::Result<GraphFeatures> Compute(
+      const PropertyGraph* pg, bool use_saved_statistics = true,
+      uint32_t num_diameter_sweeps = 2);
+};
+
+struct KATANA_EXPORT PlanAdvisorOptions {
+  /// Read degrees and the diameter from statistics saved with the graph
+  bool use_saved_statistics{true};
+  /// Number of BFS sweeps for the diameter when it is not saved
+  uint32_t num_diameter_sweeps{2};
+  /// The edge weights SSSP will run with, used to pick its delta. If empty,
+  /// the default delta is kept.
+  std::string edge_weight_property_name;
+  /// Time the candidate plans on a sampled subgraph and take the fastest,
+  /// instead of only following the features
+  bool run_trials{false};
+  /// Number of nodes of the sampled subgraph
+  uint64_t trial_nodes{1 << 16};
+};
+
+/// Plans for the main analytics, each tuned to one graph
+struct KATANA_EXPORT PlanAdvice {
+  GraphFeatures features;
+  BfsPlan bfs;
+  SsspPlan sssp;
+  ConnectedComponentsPlan connected_components;
+  PagerankPlan pagerank;
+  TriangleCountPlan triangle_count;
+  /// Why each plan was chosen, one line per analytic
+  std::vector<std::string> rationale;
+
+  void Print(std::ostream& os = std::cout) const;
+};
+
+/// Choose plans for BFS, SSSP, connected components, PageRank and triangle
+/// counting on pg.
+///
+/// The choice follows the features of pg: direction optimization and the
+/// pull variants of PageRank pay off on graphs with hubs and a small
+/// diameter, asynchronous traversals on graphs with a large diameter, and
+/// the SSSP delta is scaled to the average edge weight over the average
+/// degree. With opts.run_trials, the candidates for each analytic are also
+/// run on a subgraph of about opts.trial_nodes nodes, grown by BFS from a
+/// node of the highest degree, and the fastest one is taken. Trials never
+/// modify pg. The rationale for each decision is logged and returned.
+KATANA_EXPORT katana::Result<PlanAdvice> AdvisePlans(
+    PropertyGraph* pg, const PlanAdvisorOptions& opts = {});
+
+}  // namespace katana::analytics
+
+#endif
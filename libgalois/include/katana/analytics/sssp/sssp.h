@@ -26,6 +26,7 @@ public:
     kDijkstra,
     kTopological,
     kTopologicalTile,
+    kMultiQueue,
     kAutomatic,
   };
 
@@ -111,6 +112,10 @@ public:
       ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
     return {kCPU, kTopologicalTile, 0, edge_tile_size};
   }
+
+  /// Asynchronous relaxation in approximate distance order using
+  /// katana::MultiQueue, which needs no delta
+  static SsspPlan MultiQueue() { return {kCPU, kMultiQueue, 0, 0}; }
 };
 
 /// Compute the Single-Source Shortest Path for pg starting from start_node.
@@ -1,6 +1,8 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_SUBGRAPHEXTRACTION_SUBGRAPHEXTRACTION_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_SUBGRAPHEXTRACTION_SUBGRAPHEXTRACTION_H_
 
+#include <functional>
+
 #include "katana/PropertyGraph.h"
 #include "katana/analytics/Plan.h"
 
@@ -57,7 +59,94 @@ SubGraphExtraction(
     katana::PropertyGraph* pg,
     const std::vector<katana::PropertyGraph::Node>& node_vec,
     SubGraphExtractionPlan plan = {});
-// const std::vector<std::string>& node_properties_to_copy, const std::vector<std::string>& edge_properties_to_copy);
+
+/**
+ * Construct a new sub-graph from the original graph, carrying over the
+ * requested properties.
+ *
+ * Node i of the sub-graph corresponds to the i-th distinct node of node_vec.
+ * The entity types of the selected nodes and edges are always copied, along
+ * with the node and edge properties named in node_properties_to_copy and
+ * edge_properties_to_copy. Properties are gathered column by column in
+ * parallel with the arrow take kernel.
+ *
+ * @param pg The graph to process.
+ * @param node_vec Set of node IDs
+ * @param node_properties_to_copy Names of the node properties to copy
+ * @param edge_properties_to_copy Names of the edge properties to copy
+ * @param plan
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+SubGraphExtraction(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::PropertyGraph::Node>& node_vec,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    SubGraphExtractionPlan plan = {});
+
+/**
+ * Construct the edge-induced sub-graph of the edges selected by
+ * edge_predicate.
+ *
+ * The sub-graph contains every edge for which edge_predicate returns true
+ * along with its endpoints. Nodes keep their relative order from the original
+ * graph. edge_predicate is called concurrently and receives original edge IDs.
+ *
+ * @param pg The graph to process.
+ * @param edge_predicate Selects the edges to keep
+ * @param node_properties_to_copy Names of the node properties to copy
+ * @param edge_properties_to_copy Names of the edge properties to copy
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+SubGraphExtractionByEdgePredicate(
+    katana::PropertyGraph* pg,
+    const std::function<bool(katana::PropertyGraph::Edge)>& edge_predicate,
+    const std::vector<std::string>& node_properties_to_copy = {},
+    const std::vector<std::string>& edge_properties_to_copy = {});
+
+/**
+ * Construct the sub-graph of the nodes and edges with the given entity types.
+ *
+ * A node is kept if it has any of node_types, and an edge is kept if it has
+ * any of edge_types and both of its endpoints are kept. An empty type list
+ * selects all nodes (resp. edges). Unlike PropertyGraph::BuildView with a
+ * projection, the result is an independent graph that can be written out.
+ *
+ * @param pg The graph to process.
+ * @param node_types Names of the atomic node types to keep
+ * @param edge_types Names of the atomic edge types to keep
+ * @param node_properties_to_copy Names of the node properties to copy
+ * @param edge_properties_to_copy Names of the edge properties to copy
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+SubGraphExtractionByEntityTypes(
+    katana::PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types,
+    const std::vector<std::string>& node_properties_to_copy = {},
+    const std::vector<std::string>& edge_properties_to_copy = {});
+
+/**
+ * Construct the k-hop ego network around a set of seed nodes.
+ *
+ * The sub-graph is induced by all nodes that are at most num_hops edges away
+ * from some seed. Outgoing edges are followed; if follow_in_edges is set,
+ * incoming edges are followed as well (using the transposed topology cached
+ * by the graph). Nodes keep their relative order from the original graph.
+ *
+ * @param pg The graph to process.
+ * @param seed_nodes Nodes around which to extract the neighborhood
+ * @param num_hops Radius of the neighborhood
+ * @param follow_in_edges Whether to also traverse incoming edges
+ * @param node_properties_to_copy Names of the node properties to copy
+ * @param edge_properties_to_copy Names of the edge properties to copy
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+EgoNetworkExtraction(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::PropertyGraph::Node>& seed_nodes,
+    uint32_t num_hops, bool follow_in_edges = false,
+    const std::vector<std::string>& node_properties_to_copy = {},
+    const std::vector<std::string>& edge_properties_to_copy = {});
 
 }  // namespace katana::analytics
 
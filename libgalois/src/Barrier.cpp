@@ -43,15 +43,19 @@ katana::internal::SetBarrier(katana::Barrier* barrier) {
 
 katana::Barrier&
 katana::GetBarrier(unsigned active_threads) {
-  KATANA_LOG_VASSERT(kBarrier, "Barrier not initialized");
+  ThreadPool::Group* group = ThreadPool::getGroup();
+  Barrier* barrier = group ? group->barrier : kBarrier;
+  unsigned& barrier_threads = group ? group->barrier_threads : kBarrierThreads;
+
+  KATANA_LOG_VASSERT(barrier, "Barrier not initialized");
   active_threads =
       std::min(active_threads, GetThreadPool().getMaxUsableThreads());
   active_threads = std::max(active_threads, 1U);
 
-  if (active_threads != kBarrierThreads) {
-    kBarrierThreads = active_threads;
-    kBarrier->Reinit(kBarrierThreads);
+  if (active_threads != barrier_threads) {
+    barrier_threads = active_threads;
+    barrier->Reinit(barrier_threads);
   }
 
-  return *kBarrier;
+  return *barrier;
 }
@@ -0,0 +1,261 @@
+#include "katana/BitsetKernels.h"
+
+#include <array>
+#include <string>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KATANA_BITSET_KERNELS_X86
+#endif
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+
+namespace {
+
+using katana::SimdLevel;
+
+constexpr uint32_t kBitsPerWord = 64;
+
+uint64_t
+CountScalar(const uint64_t* words, size_t num_words) {
+  uint64_t count = 0;
+  for (size_t i = 0; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+size_t
+ExpandScalar(
+    const uint64_t* words, size_t num_words, uint32_t first_index,
+    uint32_t* out) {
+  uint32_t* begin = out;
+  for (size_t i = 0; i < num_words; ++i) {
+    uint64_t word = words[i];
+    uint32_t base = first_index + i * kBitsPerWord;
+    while (word != 0) {
+      *out++ = base + __builtin_ctzll(word);
+      word &= word - 1;
+    }
+  }
+  return out - begin;
+}
+
+#ifdef KATANA_BITSET_KERNELS_X86
+
+/// For each byte value, the positions of its set bits, padded with zeros
+struct ByteOffsets {
+  std::array<std::array<uint8_t, 8>, 256> offsets{};
+
+  constexpr ByteOffsets() {
+    for (uint32_t b = 0; b < 256; ++b) {
+      uint32_t n = 0;
+      for (uint8_t bit = 0; bit < 8; ++bit) {
+        if (b & (1U << bit)) {
+          offsets[b][n++] = bit;
+        }
+      }
+    }
+  }
+};
+
+constexpr ByteOffsets kByteOffsets;
+
+/// Count with the nibble lookup of Mula, Kurz and Lemire, "Faster Population
+/// Counts Using AVX2 Instructions"
+__attribute__((target("avx2"))) uint64_t
+CountAVX2(const uint64_t* words, size_t num_words) {
+  const __m256i lookup = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3,
+      1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i sums = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 <= num_words; i += 4) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    __m256i low = _mm256_and_si256(v, low_mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    sums = _mm256_add_epi64(
+        sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         CountScalar(words + i, num_words - i);
+}
+
+/// Expand a byte at a time: the offsets of its bits come from a table and
+/// are stored as eight lanes, of which only the first popcount are kept.
+/// The extra lanes are overwritten by the next byte; the words whose stores
+/// could run past the end of out are expanded by the scalar loop instead.
+__attribute__((target("avx2,popcnt"))) size_t
+ExpandAVX2(
+    const uint64_t* words, size_t num_words, uint32_t first_index,
+    uint32_t* out) {
+  uint32_t* begin = out;
+  uint32_t* end = out + CountAVX2(words, num_words);
+  for (size_t i = 0; i < num_words; ++i) {
+    uint64_t word = words[i];
+    if (word == 0) {
+      continue;
+    }
+    uint32_t base = first_index + i * kBitsPerWord;
+    if (out + _mm_popcnt_u64(word) + 8 > end) {
+      out += ExpandScalar(&word, 1, base, out);
+      continue;
+    }
+    for (uint32_t byte = 0; byte < 8; ++byte, word >>= 8, base += 8) {
+      uint8_t b = word & 0xff;
+      __m128i offsets = _mm_loadl_epi64(
+          reinterpret_cast<const __m128i*>(kByteOffsets.offsets[b].data()));
+      __m256i indexes = _mm256_add_epi32(
+          _mm256_cvtepu8_epi32(offsets), _mm256_set1_epi32(base));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), indexes);
+      out += _mm_popcnt_u32(b);
+    }
+  }
+  return out - begin;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) uint64_t
+CountAVX512(const uint64_t* words, size_t num_words) {
+  __m512i sums = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 8 <= num_words; i += 8) {
+    sums = _mm512_add_epi64(
+        sums, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+  }
+  if (i < num_words) {
+    __mmask8 tail = (1U << (num_words - i)) - 1;
+    sums = _mm512_add_epi64(
+        sums, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(tail, words + i)));
+  }
+  alignas(64) uint64_t lanes[8];
+  _mm512_store_si512(lanes, sums);
+  uint64_t count = 0;
+  for (uint64_t lane : lanes) {
+    count += lane;
+  }
+  return count;
+}
+
+/// Expand 16 bits at a time by compressing a vector of their indexes with
+/// the bits as the mask and storing only the kept lanes
+__attribute__((target("avx512f,popcnt"))) size_t
+ExpandAVX512(
+    const uint64_t* words, size_t num_words, uint32_t first_index,
+    uint32_t* out) {
+  uint32_t* begin = out;
+  const __m512i iota = _mm512_setr_epi32(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  for (size_t i = 0; i < num_words; ++i) {
+    uint64_t word = words[i];
+    if (word == 0) {
+      continue;
+    }
+    uint32_t base = first_index + i * kBitsPerWord;
+    for (uint32_t part = 0; part < 4; ++part, word >>= 16, base += 16) {
+      uint32_t bits = word & 0xffff;
+      if (bits == 0) {
+        continue;
+      }
+      __m512i candidates = _mm512_add_epi32(iota, _mm512_set1_epi32(base));
+      __m512i indexes =
+          _mm512_maskz_compress_epi32(_cvtu32_mask16(bits), candidates);
+      uint32_t count = _mm_popcnt_u32(bits);
+      _mm512_mask_storeu_epi32(
+          out, _cvtu32_mask16((1U << count) - 1), indexes);
+      out += count;
+    }
+  }
+  return out - begin;
+}
+
+#endif
+
+SimdLevel
+DetectSimdLevel() {
+#ifdef KATANA_BITSET_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512vpopcntdq")) {
+    return SimdLevel::kAVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::kAVX2;
+  }
+#endif
+  return SimdLevel::kScalar;
+}
+
+}  // namespace
+
+katana::SimdLevel
+katana::GetSimdLevel() {
+  static SimdLevel level = [] {
+    SimdLevel detected = DetectSimdLevel();
+    std::string name;
+    if (!GetEnv("KATANA_SIMD_LEVEL", &name)) {
+      return detected;
+    }
+    for (SimdLevel requested :
+         {SimdLevel::kScalar, SimdLevel::kAVX2, SimdLevel::kAVX512}) {
+      if (name == SimdLevelName(requested)) {
+        return std::min(requested, detected);
+      }
+    }
+    KATANA_LOG_WARN("unknown KATANA_SIMD_LEVEL {}", name);
+    return detected;
+  }();
+  return level;
+}
+
+const char*
+katana::SimdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::kScalar:
+    return "scalar";
+  case SimdLevel::kAVX2:
+    return "avx2";
+  case SimdLevel::kAVX512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+uint64_t
+katana::CountSetBits(
+    const uint64_t* words, size_t num_words, SimdLevel level) {
+  KATANA_LOG_DEBUG_ASSERT(level <= DetectSimdLevel());
+  switch (level) {
+#ifdef KATANA_BITSET_KERNELS_X86
+  case SimdLevel::kAVX512:
+    return CountAVX512(words, num_words);
+  case SimdLevel::kAVX2:
+    return CountAVX2(words, num_words);
+#endif
+  default:
+    return CountScalar(words, num_words);
+  }
+}
+
+size_t
+katana::ExpandSetBits(
+    const uint64_t* words, size_t num_words, uint32_t first_index,
+    uint32_t* out, SimdLevel level) {
+  KATANA_LOG_DEBUG_ASSERT(level <= DetectSimdLevel());
+  switch (level) {
+#ifdef KATANA_BITSET_KERNELS_X86
+  case SimdLevel::kAVX512:
+    return ExpandAVX512(words, num_words, first_index, out);
+  case SimdLevel::kAVX2:
+    return ExpandAVX2(words, num_words, first_index, out);
+#endif
+  default:
+    return ExpandScalar(words, num_words, first_index, out);
+  }
+}
@@ -23,6 +23,8 @@
 
 #include "katana/DynamicBitset.h"
 
+#include <type_traits>
+
 #include "katana/Galois.h"
 
 KATANA_EXPORT katana::DynamicBitset katana::EmptyBitset;
@@ -89,23 +91,68 @@ katana::DynamicBitset::bitwise_xor(
       katana::no_stats());
 }
 
+namespace {
+
+constexpr size_t kNumBitsInUint64 = katana::DynamicBitset::kNumBitsInUint64;
+
+/// The last word of the bitset without the bits past its size, which
+/// bitwise_not may have set; 0 if the bitset ends on a word boundary
+uint64_t
+TailWord(const katana::DynamicBitset& bitset) {
+  size_t num_tail_bits = bitset.size() % kNumBitsInUint64;
+  if (num_tail_bits == 0) {
+    return 0;
+  }
+  uint64_t word = bitset.words()[bitset.size() / kNumBitsInUint64];
+  return word & ((uint64_t{1} << num_tail_bits) - 1);
+}
+
+/// Write the index of each set bit of words[0, num_words) plus first_index
+/// to out
+///
+/// \returns the number of indexes written
+template <typename Integer>
+size_t
+ExpandWords(
+    const uint64_t* words, size_t num_words, Integer first_index,
+    Integer* out) {
+  if constexpr (std::is_same_v<Integer, uint32_t>) {
+    return katana::ExpandSetBits(words, num_words, first_index, out);
+  } else {
+    // The kernels write 32-bit indexes, so expand a block at a time relative
+    // to its first word and widen
+    constexpr size_t kWordsPerBlock = 64;
+    uint32_t indexes[kWordsPerBlock * kNumBitsInUint64];
+    size_t num_written = 0;
+    for (size_t begin = 0; begin < num_words; begin += kWordsPerBlock) {
+      size_t end = std::min(begin + kWordsPerBlock, num_words);
+      size_t n = katana::ExpandSetBits(words + begin, end - begin, 0, indexes);
+      Integer base = first_index + begin * kNumBitsInUint64;
+      for (size_t i = 0; i < n; ++i) {
+        out[num_written++] = base + indexes[i];
+      }
+    }
+    return num_written;
+  }
+}
+
+}  // namespace
+
 size_t
 katana::DynamicBitset::count() const {
+  constexpr size_t kWordsPerBlock = 1024;
+  size_t num_full_words = size() / kNumBitsInUint64;
+  size_t num_blocks = (num_full_words + kWordsPerBlock - 1) / kWordsPerBlock;
   katana::GAccumulator<size_t> ret;
   katana::do_all(
-      katana::iterate(bitvec_.begin(), bitvec_.end()),
-      [&](uint64_t n) {
-#ifdef __GNUC__
-        ret += __builtin_popcountll(n);
-#else
-        n = n - ((n >> 1) & 0x5555555555555555UL);
-        n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
-        ret += (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >>
-               56;
-#endif
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        size_t begin = block * kWordsPerBlock;
+        size_t end = std::min(begin + kWordsPerBlock, num_full_words);
+        ret += katana::CountSetBits(words() + begin, end - begin);
       },
       katana::no_stats());
-  return ret.reduce();
+  return ret.reduce() + __builtin_popcountll(TailWord(*this));
 }
 
 namespace {
@@ -113,22 +160,22 @@ template <typename Integer>
 void
 ComputeOffsets(
     const katana::DynamicBitset& bitset, std::vector<Integer>* offsets) {
-  // TODO uint32_t is somewhat dangerous; change in the future
+  // Threads take whole words; the partial last word goes to the last thread
+  const uint64_t* words = bitset.words();
+  size_t num_full_words = bitset.size() / kNumBitsInUint64;
+  uint64_t tail = TailWord(bitset);
+
   uint32_t activeThreads = katana::getActiveThreads();
-  std::vector<Integer> tPrefixBitCounts(activeThreads);
+  std::vector<size_t> tPrefixBitCounts(activeThreads);
 
   // count how many bits are set on each thread
   katana::on_each([&](unsigned tid, unsigned nthreads) {
     auto [start, end] =
-        katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
-
-    Integer count = 0;
-    for (Integer i = start; i < end; ++i) {
-      if (bitset.test(i)) {
-        ++count;
-      }
+        katana::block_range(size_t{0}, num_full_words, tid, nthreads);
+    size_t count = katana::CountSetBits(words + start, end - start);
+    if (tid == nthreads - 1) {
+      count += __builtin_popcountll(tail);
     }
-
     tPrefixBitCounts[tid] = count;
   });
 
@@ -138,7 +185,7 @@ ComputeOffsets(
   }
 
   // total num of set bits
-  Integer bitsetCount = tPrefixBitCounts[activeThreads - 1];
+  size_t bitsetCount = tPrefixBitCounts[activeThreads - 1];
 
   // calculate the indices of the set bits and save them to the offset
   // vector
@@ -147,17 +194,17 @@ ComputeOffsets(
     offsets->resize(cur_size + bitsetCount);
     katana::on_each([&](unsigned tid, unsigned nthreads) {
       auto [start, end] =
-          katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
-      Integer index = cur_size;
+          katana::block_range(size_t{0}, num_full_words, tid, nthreads);
+      Integer* out = offsets->data() + cur_size;
       if (tid != 0) {
-        index += tPrefixBitCounts[tid - 1];
+        out += tPrefixBitCounts[tid - 1];
       }
 
-      for (Integer i = start; i < end; ++i) {
-        if (bitset.test(i)) {
-          offsets->at(index) = i;
-          ++index;
-        }
+      out += ExpandWords<Integer>(
+          words + start, end - start, start * kNumBitsInUint64, out);
+      if (tid == nthreads - 1) {
+        ExpandWords<Integer>(
+            &tail, 1, num_full_words * kNumBitsInUint64, out);
       }
     });
   }
@@ -0,0 +1,226 @@
+#include "katana/EdgeShuffle.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "katana/EdgeBalancedRange.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Threads.h"
+
+namespace {
+
+using Node = katana::GraphTopologyTypes::Node;
+using Edge = katana::GraphTopologyTypes::Edge;
+
+/// Buckets of the first pass; every thread writes to this many places of
+/// the partitioned edges at once
+constexpr uint64_t kMaxBuckets = 1024;
+
+/// Call fn(new_src, new_dest, e) for each edge of the result that comes from
+/// edge e = (src, dest) of the input
+template <typename Func>
+void
+ForEachNewEdge(
+    bool symmetric, const katana::EdgeShuffleOptions& opts, Node src,
+    Node dest, Edge e, Func&& fn) {
+  if (src == dest) {
+    if (!opts.remove_self_loops) {
+      fn(src, dest, e);
+    }
+    return;
+  }
+  if (symmetric) {
+    fn(src, dest, e);
+  }
+  fn(dest, src, e);
+}
+
+/// Sort the edges [begin, end) of a node by destination and keep the first
+/// of each destination at the front; returns the number kept
+Edge
+RemoveDuplicates(
+    katana::ShuffledEdges* ret, Edge begin, Edge end,
+    std::vector<std::pair<Node, Edge>>* buf) {
+  buf->clear();
+  for (Edge e = begin; e < end; ++e) {
+    buf->emplace_back(ret->dests[e], ret->edge_prop_indices[e]);
+  }
+  std::sort(buf->begin(), buf->end());
+  auto last = std::unique(
+      buf->begin(), buf->end(),
+      [](const auto& a, const auto& b) { return a.first == b.first; });
+  Edge pos = begin;
+  for (auto it = buf->begin(); it != last; ++it, ++pos) {
+    ret->dests[pos] = it->first;
+    ret->edge_prop_indices[pos] = it->second;
+  }
+  return pos - begin;
+}
+
+/// Move the first degrees[n] edges of each node to the front of the edges
+void
+Compact(
+    katana::ShuffledEdges* ret, const katana::NUMAArray<Edge>& degrees) {
+  uint64_t num_nodes = ret->adj_indices.size();
+
+  katana::ShuffledEdges compact;
+  compact.adj_indices.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), compact.adj_indices.begin());
+  uint64_t num_edges = compact.adj_indices[num_nodes - 1];
+  compact.dests.allocateInterleaved(num_edges);
+  compact.edge_prop_indices.allocateInterleaved(num_edges);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Edge from = n == 0 ? 0 : ret->adj_indices[n - 1];
+        Edge to = n == 0 ? 0 : compact.adj_indices[n - 1];
+        for (Edge i = 0; i < degrees[n]; ++i) {
+          compact.dests[to + i] = ret->dests[from + i];
+          compact.edge_prop_indices[to + i] = ret->edge_prop_indices[from + i];
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  *ret = std::move(compact);
+}
+
+katana::ShuffledEdges
+ShuffleEdges(
+    const katana::GraphTopology& topology, bool symmetric,
+    const katana::EdgeShuffleOptions& opts) {
+  katana::ShuffledEdges ret;
+  uint64_t num_nodes = topology.num_nodes();
+  ret.adj_indices.allocateInterleaved(num_nodes);
+  if (num_nodes == 0) {
+    return ret;
+  }
+
+  // Bucket b holds the edges with new sources [b << shift, (b + 1) << shift)
+  uint32_t shift = 0;
+  while (((num_nodes - 1) >> shift) + 1 > kMaxBuckets) {
+    ++shift;
+  }
+  uint64_t num_buckets = ((num_nodes - 1) >> shift) + 1;
+
+  uint32_t num_threads = katana::getActiveThreads();
+  auto ranges = katana::EdgeBalancedRanges::Make(topology, num_threads);
+  auto for_each_new_edge = [&](uint32_t tid, auto&& fn) {
+    auto [begin, end] = ranges.node_range(tid);
+    for (Node src = begin; src < end; ++src) {
+      for (Edge e : topology.edges(src)) {
+        ForEachNewEdge(symmetric, opts, src, topology.edge_dest(e), e, fn);
+      }
+    }
+  };
+
+  // First pass: count the edges of each thread in each bucket and give each
+  // thread its own consecutive part of every bucket. Thread parts are in
+  // thread order, and threads have consecutive ranges of nodes, so a bucket
+  // keeps the edges in the order of their IDs.
+  std::vector<Edge> cursors(num_threads * num_buckets);
+  katana::on_each([&](unsigned tid, unsigned) {
+    Edge* counts = &cursors[tid * num_buckets];
+    for_each_new_edge(tid, [&](Node new_src, Node, Edge) {
+      ++counts[new_src >> shift];
+    });
+  });
+
+  std::vector<Edge> bucket_begins(num_buckets + 1);
+  Edge offset = 0;
+  for (uint64_t b = 0; b < num_buckets; ++b) {
+    bucket_begins[b] = offset;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      Edge count = cursors[t * num_buckets + b];
+      cursors[t * num_buckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucket_begins[num_buckets] = offset;
+  uint64_t num_edges = offset;
+
+  katana::NUMAArray<Node> srcs;
+  katana::NUMAArray<Node> dests;
+  katana::NUMAArray<Edge> edge_ids;
+  srcs.allocateInterleaved(num_edges);
+  dests.allocateInterleaved(num_edges);
+  edge_ids.allocateInterleaved(num_edges);
+
+  katana::on_each([&](unsigned tid, unsigned) {
+    Edge* cursor = &cursors[tid * num_buckets];
+    for_each_new_edge(tid, [&](Node new_src, Node new_dest, Edge e) {
+      Edge pos = cursor[new_src >> shift]++;
+      srcs[pos] = new_src;
+      dests[pos] = new_dest;
+      edge_ids[pos] = e;
+    });
+  });
+
+  // Second pass: counting sort each bucket by new source into its part of
+  // the output, which is small enough to stay in cache for a while
+  ret.dests.allocateInterleaved(num_edges);
+  ret.edge_prop_indices.allocateInterleaved(num_edges);
+  katana::NUMAArray<Edge> degrees;
+  if (opts.remove_duplicates) {
+    degrees.allocateInterleaved(num_nodes);
+  }
+  katana::PerThreadStorage<std::vector<Edge>> node_offsets;
+  katana::PerThreadStorage<std::vector<std::pair<Node, Edge>>> buffers;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_buckets),
+      [&](uint64_t b) {
+        uint64_t first = b << shift;
+        uint64_t last = std::min(num_nodes, (b + 1) << shift);
+        Edge begin = bucket_begins[b];
+        Edge end = bucket_begins[b + 1];
+
+        std::vector<Edge>& node_offset = *node_offsets.getLocal();
+        node_offset.assign(last - first + 1, 0);
+        for (Edge i = begin; i < end; ++i) {
+          ++node_offset[srcs[i] - first + 1];
+        }
+        for (uint64_t k = 0; k < last - first; ++k) {
+          node_offset[k + 1] += node_offset[k];
+          ret.adj_indices[first + k] = begin + node_offset[k + 1];
+        }
+        for (Edge i = begin; i < end; ++i) {
+          Edge pos = begin + node_offset[srcs[i] - first]++;
+          ret.dests[pos] = dests[i];
+          ret.edge_prop_indices[pos] = edge_ids[i];
+        }
+
+        if (opts.remove_duplicates) {
+          for (uint64_t n = first; n < last; ++n) {
+            Edge node_begin = n == first ? begin : ret.adj_indices[n - 1];
+            degrees[n] = RemoveDuplicates(
+                &ret, node_begin, ret.adj_indices[n], buffers.getLocal());
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (opts.remove_duplicates) {
+    Compact(&ret, degrees);
+  }
+  return ret;
+}
+
+}  // namespace
+
+katana::ShuffledEdges
+katana::TransposeEdges(
+    const GraphTopology& topology, const EdgeShuffleOptions& opts) {
+  return ShuffleEdges(topology, false, opts);
+}
+
+katana::ShuffledEdges
+katana::SymmetrizeEdges(
+    const GraphTopology& topology, const EdgeShuffleOptions& opts) {
+  return ShuffleEdges(topology, true, opts);
+}
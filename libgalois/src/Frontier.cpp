@@ -0,0 +1,111 @@
+#include "katana/Frontier.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "katana/ParallelSTL.h"
+
+katana::Frontier::Frontier(size_t num_nodes, uint32_t dense_divisor)
+    : num_nodes_(num_nodes), dense_divisor_(dense_divisor) {
+  KATANA_LOG_DEBUG_ASSERT(dense_divisor > 0);
+  bitset_.resize(num_nodes);
+}
+
+void
+katana::Frontier::Clear() {
+  if (dense_) {
+    auto& words = bitset_.get_vec();
+    katana::ParallelSTL::fill(words.begin(), words.end(), uint64_t{0});
+  } else {
+    sparse_.clear();
+  }
+  size_.reset();
+}
+
+void
+katana::Frontier::Fill() {
+  sparse_.clear();
+  auto& words = bitset_.get_vec();
+  katana::ParallelSTL::fill(words.begin(), words.end(), ~uint64_t{0});
+  // Keep the bits past num_nodes unset
+  size_t num_tail_bits = num_nodes_ % DynamicBitset::kNumBitsInUint64;
+  if (num_tail_bits != 0) {
+    words.back() = (uint64_t{1} << num_tail_bits) - 1;
+  }
+  dense_ = true;
+  size_.reset();
+  size_ += num_nodes_;
+}
+
+void
+katana::Frontier::ToDense() {
+  if (dense_) {
+    return;
+  }
+  // The bitset is kept empty while the frontier is sparse
+  katana::do_all(
+      katana::iterate(sparse_), [&](Node n) { bitset_.set(n); },
+      katana::steal(), katana::chunk_size<kChunkSize>(), katana::no_stats());
+  sparse_.clear();
+  dense_ = true;
+  size_.reset();
+  size_ += bitset_.count();
+}
+
+void
+katana::Frontier::ToSparse() {
+  if (!dense_) {
+    return;
+  }
+  bitset_.ForEachSetBit([&](Node n) { sparse_.push(n); });
+  auto& words = bitset_.get_vec();
+  katana::ParallelSTL::fill(words.begin(), words.end(), uint64_t{0});
+  dense_ = false;
+}
+
+void
+katana::Frontier::Adapt() {
+  bool should_be_dense = size() > num_nodes_ / dense_divisor_;
+  if (should_be_dense) {
+    ToDense();
+  } else {
+    ToSparse();
+  }
+}
+
+std::vector<katana::Frontier::Node>
+katana::Frontier::Compact() {
+  if (dense_) {
+    return bitset_.GetOffsets<Node>();
+  }
+
+  // Each thread copies its own chunks of the bag after those of the threads
+  // before it
+  uint32_t active_threads = katana::getActiveThreads();
+  std::vector<size_t> thread_prefix(active_threads);
+  katana::on_each([&](unsigned tid, unsigned) {
+    thread_prefix[tid] =
+        std::distance(sparse_.local_begin(), sparse_.local_end());
+  });
+  for (uint32_t i = 1; i < active_threads; ++i) {
+    thread_prefix[i] += thread_prefix[i - 1];
+  }
+
+  std::vector<Node> nodes(thread_prefix[active_threads - 1]);
+  katana::on_each([&](unsigned tid, unsigned) {
+    size_t begin = tid == 0 ? 0 : thread_prefix[tid - 1];
+    std::copy(
+        sparse_.local_begin(), sparse_.local_end(), nodes.begin() + begin);
+  });
+  return nodes;
+}
+
+void
+katana::Frontier::swap(Frontier& other) {
+  std::swap(num_nodes_, other.num_nodes_);
+  std::swap(dense_divisor_, other.dense_divisor_);
+  std::swap(dense_, other.dense_);
+  sparse_.swap(other.sparse_);
+  std::swap(bitset_, other.bitset_);
+  std::swap(size_, other.size_);
+}
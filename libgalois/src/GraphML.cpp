@@ -2,10 +2,15 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
@@ -18,6 +23,7 @@
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
 #include "katana/Threads.h"
+#include "katana/Timer.h"
 
 using katana::ImportData;
 using katana::ImportDataType;
@@ -266,6 +272,165 @@ ResolveValue(const std::string& val, ImportDataType type, bool is_list) {
   }
 }
 
+/*******************************************/
+/* Destinations of parsed nodes and edges */
+/*******************************************/
+
+/// The type a property key is expected to have
+using KeyType = std::pair<ImportDataType, bool>;
+
+/// The types of the keys declared in the header of a file, as the builder
+/// will resolve their values. Keys that are not declared become strings.
+struct KeyTypes {
+  std::unordered_map<std::string, KeyType> node;
+  std::unordered_map<std::string, KeyType> edge;
+
+  /// Mirror PropertyGraphBuilder::AddBuilder, which adds a key for both
+  /// nodes and edges only to the nodes and keeps the first key with an id
+  void Add(const PropertyKey& key) {
+    KeyType type{key.type, key.is_list};
+    if (key.for_node) {
+      node.emplace(key.id, type);
+    } else if (key.for_edge) {
+      edge.emplace(key.id, type);
+    }
+  }
+
+  KeyType Get(bool for_node, const std::string& id) const {
+    const auto& types = for_node ? node : edge;
+    auto it = types.find(id);
+    if (it == types.end()) {
+      return KeyType{ImportDataType::kString, false};
+    }
+    return it->second;
+  }
+};
+
+/// Adds nodes and edges to the builder as they are parsed
+class BuilderSink {
+public:
+  explicit BuilderSink(katana::PropertyGraphBuilder* builder)
+      : builder_(builder) {}
+
+  bool StartNode(const std::string& id) { return builder_->StartNode(id); }
+
+  bool StartEdge(const std::string& source, const std::string& target) {
+    return builder_->StartEdge(source, target);
+  }
+
+  void AddValue(const std::string& key, const std::string& value) {
+    builder_->AddValue(
+        key,
+        [&]() { return PropertyKey{key, ImportDataType::kString, false}; },
+        [&value](ImportDataType type, bool is_list) {
+          return ResolveValue(value, type, is_list);
+        });
+  }
+
+  void AddLabel(const std::string& label) { builder_->AddLabel(label); }
+
+  void FinishNode() { builder_->FinishNode(); }
+
+  void FinishEdge() { builder_->FinishEdge(); }
+
+private:
+  katana::PropertyGraphBuilder* builder_;
+};
+
+/// A property value parsed on a worker thread and resolved to the type its
+/// key is expected to have; raw is kept in case the builder disagrees
+struct ParsedValue {
+  std::string key;
+  std::string raw;
+  KeyType type;
+  ImportData data;
+};
+
+/// A node or edge parsed on a worker thread, waiting to be added to the
+/// builder in file order
+struct ParsedElement {
+  bool is_node{false};
+  std::string id;
+  std::string source;
+  std::string target;
+  std::vector<ParsedValue> values;
+  std::vector<std::string> labels;
+};
+
+/// Keeps nodes and edges, with their values resolved, so that they can be
+/// parsed in parallel and added to the builder later by AddParsedElement
+class ParsedSink {
+public:
+  ParsedSink(const KeyTypes& key_types, std::vector<ParsedElement>* elements)
+      : key_types_(key_types), elements_(elements) {}
+
+  bool StartNode(const std::string& id) {
+    ParsedElement& element = elements_->emplace_back();
+    element.is_node = true;
+    element.id = id;
+    return true;
+  }
+
+  bool StartEdge(const std::string& source, const std::string& target) {
+    ParsedElement& element = elements_->emplace_back();
+    element.source = source;
+    element.target = target;
+    return true;
+  }
+
+  void AddValue(const std::string& key, const std::string& value) {
+    ParsedElement& element = elements_->back();
+    KeyType type = key_types_.Get(element.is_node, key);
+    element.values.emplace_back(ParsedValue{
+        key, value, type, ResolveValue(value, type.first, type.second)});
+  }
+
+  void AddLabel(const std::string& label) {
+    elements_->back().labels.emplace_back(label);
+  }
+
+  void FinishNode() {}
+
+  void FinishEdge() {}
+
+private:
+  const KeyTypes& key_types_;
+  std::vector<ParsedElement>* elements_;
+};
+
+/// Replay element into builder as BuilderSink would have added it
+void
+AddParsedElement(
+    ParsedElement* element, katana::PropertyGraphBuilder* builder) {
+  bool valid = element->is_node
+                   ? builder->StartNode(element->id)
+                   : builder->StartEdge(element->source, element->target);
+  if (!valid) {
+    return;
+  }
+  for (ParsedValue& value : element->values) {
+    builder->AddValue(
+        value.key,
+        [&]() {
+          return PropertyKey{value.key, ImportDataType::kString, false};
+        },
+        [&value](ImportDataType type, bool is_list) {
+          if (value.type == KeyType{type, is_list}) {
+            return std::move(value.data);
+          }
+          return ResolveValue(value.raw, type, is_list);
+        });
+  }
+  for (const std::string& label : element->labels) {
+    builder->AddLabel(label);
+  }
+  if (element->is_node) {
+    builder->FinishNode();
+  } else {
+    builder->FinishEdge();
+  }
+}
+
 /***************************************/
 /* Functions for parsing GraphML files */
 /***************************************/
@@ -327,8 +492,9 @@ ProcessData(xmlTextReaderPtr reader) {
  *
  * parses the node from a GraphML file into readable form
  */
+template <typename Sink>
 void
-ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
+ProcessNode(xmlTextReaderPtr reader, Sink* sink) {
   auto minimum_depth = xmlTextReaderDepth(reader);
 
   int ret = xmlTextReaderMoveToNextAttribute(reader);
@@ -371,7 +537,7 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
 
   bool validNode = !id.empty();
   if (validNode) {
-    builder->StartNode(id);
+    sink->StartNode(id);
   }
 
   // parse "data" xml nodes for properties
@@ -402,16 +568,7 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
             }
           } else if (property.first != std::string("IGNORE")) {
             if (validNode) {
-              const std::string& value = property.second;
-              builder->AddValue(
-                  property.first,
-                  [&]() {
-                    return PropertyKey{
-                        property.first, ImportDataType::kString, false};
-                  },
-                  [&value](ImportDataType type, bool is_list) {
-                    return ResolveValue(value, type, is_list);
-                  });
+              sink->AddValue(property.first, property.second);
             }
           }
         }
@@ -430,10 +587,10 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
   if (validNode) {
     if (!labels.empty()) {
       for (std::string label : labels) {
-        builder->AddLabel(label);
+        sink->AddLabel(label);
       }
     }
-    builder->FinishNode();
+    sink->FinishNode();
   }
 }
 
@@ -442,8 +599,9 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
  *
  * parses the edge from a GraphML file into readable form
  */
+template <typename Sink>
 void
-ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
+ProcessEdge(xmlTextReaderPtr reader, Sink* sink) {
   auto minimum_depth = xmlTextReaderDepth(reader);
 
   int ret = xmlTextReaderMoveToNextAttribute(reader);
@@ -484,7 +642,7 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
 
   bool valid_edge = !source.empty() && !target.empty();
   if (valid_edge) {
-    valid_edge = builder->StartEdge(source, target);
+    valid_edge = sink->StartEdge(source, target);
   }
 
   // parse "data" xml edges for properties
@@ -510,16 +668,7 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
             }
           } else if (property.first != std::string("IGNORE")) {
             if (valid_edge) {
-              const std::string& value = property.second;
-              builder->AddValue(
-                  property.first,
-                  [&]() {
-                    return PropertyKey{
-                        property.first, ImportDataType::kString, false};
-                  },
-                  [&value](ImportDataType type, bool is_list) {
-                    return ResolveValue(value, type, is_list);
-                  });
+              sink->AddValue(property.first, property.second);
             }
           }
         }
@@ -536,9 +685,9 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
   // add type if it exists
   if (valid_edge) {
     if (type.length() > 0) {
-      builder->AddLabel(type);
+      sink->AddLabel(type);
     }
-    builder->FinishEdge();
+    sink->FinishEdge();
   }
 }
 
@@ -546,11 +695,12 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
  * reader should be pointing at the graph element before calling
  *
  * parses the graph structure from a GraphML file into Galois format
+ *
+ * returns the status of the last read of reader
  */
-void
-ProcessGraph(
-    xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder,
-    bool verbose) {
+template <typename Sink>
+int
+ProcessGraph(xmlTextReaderPtr reader, Sink* sink, bool verbose) {
   auto minimum_depth = xmlTextReaderDepth(reader);
   int ret = xmlTextReaderRead(reader);
 
@@ -567,7 +717,7 @@ ProcessGraph(
     if (xmlTextReaderNodeType(reader) == 1) {
       // if elt is a "node" xml node read it in
       if (xmlStrEqual(name, BAD_CAST "node")) {
-        ProcessNode(reader, builder);
+        ProcessNode(reader, sink);
       } else if (xmlStrEqual(name, BAD_CAST "edge")) {
         if (!finished_nodes) {
           finished_nodes = true;
@@ -576,7 +726,7 @@ ProcessGraph(
           }
         }
         // if elt is an "egde" xml node read it in
-        ProcessEdge(reader, builder);
+        ProcessEdge(reader, sink);
       } else {
         KATANA_LOG_ERROR(
             "Found element: {}, which was ignored",
@@ -590,32 +740,22 @@ ProcessGraph(
   if (verbose) {
     std::cout << "Finished processing edges\n";
   }
+  return ret;
 }
 
-}  // end of unnamed namespace
-
-katana::Result<katana::GraphComponents>
-katana::ConvertGraphML(
-    const std::string& infilename, size_t chunk_size, bool verbose) {
-  xmlTextReaderPtr reader;
-
-  reader = xmlNewTextReaderFilename(infilename.c_str());
-  if (reader == NULL) {
-    return KATANA_ERROR(ErrorCode::NotFound, "Unable to open {}", infilename);
-  }
-  auto res = ConvertGraphML(reader, chunk_size, verbose);
-  xmlFreeTextReader(reader);
-  return res;
-}
-
-katana::Result<katana::GraphComponents>
-katana::ConvertGraphML(
-    xmlTextReaderPtr reader, size_t chunk_size, bool verbose) {
+/*
+ * reads the "key" xml nodes of the header into builder and key_types and,
+ * with process_graph, the first "graph" xml node
+ *
+ * returns the status of the last read of reader
+ */
+int
+ProcessDocument(
+    xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder,
+    KeyTypes* key_types, bool process_graph, bool verbose) {
   int ret = 0;
   bool finishedGraph = false;
 
-  katana::PropertyGraphBuilder builder{chunk_size};
-
   // procedure:
   // read in "key" xml nodes and add them to nodeKeys and edgeKeys
   // once we reach the first "graph" xml node we parse it using the above keys
@@ -632,29 +772,458 @@ katana::ConvertGraphML(
         PropertyKey key = katana::graphml::ProcessKey(reader);
         if (!key.id.empty() && key.id != std::string("label") &&
             key.id != std::string("IGNORE")) {
+          key_types->Add(key);
           if (key.for_node) {
-            builder.AddBuilder(std::move(key));
+            builder->AddBuilder(std::move(key));
           } else if (key.for_edge) {
-            builder.AddBuilder(std::move(key));
+            builder->AddBuilder(std::move(key));
           }
         }
       } else if (xmlStrEqual(name, BAD_CAST "graph")) {
         if (verbose) {
           std::cout << "Finished processing property headers\n";
         }
-        ProcessGraph(reader, &builder, false);
+        if (process_graph) {
+          BuilderSink sink{builder};
+          ProcessGraph(reader, &sink, false);
+        }
         finishedGraph = true;
       }
     }
     xmlFree(name);
   }
+  return ret;
+}
+
+katana::Result<void>
+ParseError() {
+  return KATANA_ERROR(
+      katana::ErrorCode::InvalidArgument,
+      "failed to parse: incorrect xml format\n"
+      "Please verify there are no illegal characters in the GraphML file\n"
+      "To remove invalid characters use: \"sed -i $'s/[^[:print:]\t]//g' "
+      "<file>\", warning this will alter the original file");
+}
+
+/**********************************************/
+/* Functions for parsing GraphML in parallel */
+/**********************************************/
+
+/// A piece of markup: a tag, comment, CDATA section, processing instruction
+/// or declaration
+struct Token {
+  enum Kind { kStartTag, kEmptyTag, kEndTag, kOther };
+  Kind kind;
+  size_t begin;
+  /// One past the closing '>'
+  size_t end;
+};
+
+/// Scan the token that starts at buf[begin], which is a '<'
+///
+/// \returns the token, or nothing if it does not end within buf
+std::optional<Token>
+ScanToken(std::string_view buf, size_t begin) {
+  std::string_view rest = buf.substr(begin);
+  auto find_end = [&](std::string_view end) -> std::optional<Token> {
+    size_t pos = rest.find(end, 2);
+    if (pos == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return Token{Token::kOther, begin, begin + pos + end.size()};
+  };
+
+  if (rest.size() < 2) {
+    return std::nullopt;
+  }
+  if (rest[1] == '!') {
+    // Enough of the token to tell comments and CDATA sections apart
+    constexpr std::string_view kCData = "<![CDATA[";
+    if (rest.size() < kCData.size()) {
+      return std::nullopt;
+    }
+    if (rest.substr(0, 4) == "<!--") {
+      return find_end("-->");
+    }
+    if (rest.substr(0, kCData.size()) == kCData) {
+      return find_end("]]>");
+    }
+    return find_end(">");
+  }
+  if (rest[1] == '?') {
+    return find_end("?>");
+  }
+
+  // A tag ends at the first '>' outside of an attribute value
+  char quote = 0;
+  for (size_t i = 1; i < rest.size(); ++i) {
+    char c = rest[i];
+    if (quote != 0) {
+      if (c == quote) {
+        quote = 0;
+      }
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+    } else if (c == '>') {
+      Token::Kind kind = Token::kStartTag;
+      if (rest[1] == '/') {
+        kind = Token::kEndTag;
+      } else if (rest[i - 1] == '/') {
+        kind = Token::kEmptyTag;
+      }
+      return Token{kind, begin, begin + i + 1};
+    }
+  }
+  return std::nullopt;
+}
+
+/// The name of the element of a tag token
+std::string_view
+TagName(std::string_view buf, const Token& token) {
+  size_t begin = token.begin + (token.kind == Token::kEndTag ? 2 : 1);
+  size_t end = buf.find_first_of(" \t\r\n/>", begin);
+  return buf.substr(begin, end - begin);
+}
+
+/// Reads the body of the first graph of a GraphML file in pieces that end on
+/// the boundaries of its top level elements, so that each piece can be
+/// parsed on its own. Only the current piece and one read of the file are
+/// held in memory.
+class GraphMLChunkReader {
+public:
+  static katana::Result<std::unique_ptr<GraphMLChunkReader>> Make(
+      const std::string& filename) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotFound, "Unable to open {}", filename);
+    }
+    std::unique_ptr<GraphMLChunkReader> reader(new GraphMLChunkReader(file));
+    KATANA_CHECKED(reader->ReadHeader());
+    return katana::MakeResult(std::move(reader));
+  }
+
+  GraphMLChunkReader(const GraphMLChunkReader&) = delete;
+  GraphMLChunkReader& operator=(const GraphMLChunkReader&) = delete;
+
+  ~GraphMLChunkReader() { std::fclose(file_); }
+
+  /// Whether the file can be read in pieces; if not, for instance because
+  /// it is compressed, not UTF-8 or has a DOCTYPE, it should be parsed as a
+  /// whole
+  bool can_split() const { return can_split_; }
+
+  /// The file up to and including the start tag of the graph, closed so
+  /// that it is a document of its own
+  const std::string& header() const { return header_; }
+
+  /// Set chunk to the next piece of at least target_bytes, or less at the
+  /// end of the graph, wrapped in a graph element. chunk is empty once the
+  /// whole graph has been read.
+  katana::Result<void> NextChunk(size_t target_bytes, std::string* chunk) {
+    chunk->clear();
+    if (graph_ended_) {
+      return katana::ResultSuccess();
+    }
+
+    size_t chunk_end = 0;
+    while (true) {
+      std::optional<Token> token = KATANA_CHECKED(NextToken());
+      if (!token) {
+        return ParseError();
+      }
+      pos_ = token->end;
+      if (token->kind == Token::kStartTag) {
+        ++depth_;
+      } else if (token->kind == Token::kEndTag) {
+        if (depth_ == 0) {
+          // The end tag of the graph
+          graph_ended_ = true;
+          chunk_end = token->begin;
+          break;
+        }
+        --depth_;
+      }
+      if (depth_ == 0 && pos_ >= target_bytes) {
+        chunk_end = pos_;
+        break;
+      }
+    }
+
+    chunk->reserve(chunk_end + 2 * kWrapper.size() + 1);
+    chunk->append("<").append(kWrapper).append(">");
+    chunk->append(buffer_, 0, chunk_end);
+    chunk->append("</").append(kWrapper).append(">");
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+    return katana::ResultSuccess();
+  }
+
+private:
+  static constexpr size_t kReadBytes = 1 << 20;
+  static constexpr std::string_view kWrapper = "graph";
+
+  explicit GraphMLChunkReader(std::FILE* file) : file_(file) {}
+
+  /// Append the next read of the file to buffer_
+  ///
+  /// \returns false at the end of the file
+  katana::Result<bool> ReadMore() {
+    size_t old_size = buffer_.size();
+    buffer_.resize(old_size + kReadBytes);
+    size_t num_read =
+        std::fread(buffer_.data() + old_size, 1, kReadBytes, file_);
+    buffer_.resize(old_size + num_read);
+    if (num_read == 0 && std::ferror(file_)) {
+      return KATANA_ERROR(katana::ResultErrno(), "reading GraphML file");
+    }
+    return num_read > 0;
+  }
+
+  /// \returns the next token at or after pos_, or nothing at the end of the
+  /// file
+  katana::Result<std::optional<Token>> NextToken() {
+    while (true) {
+      size_t begin = buffer_.find('<', pos_);
+      if (begin != std::string::npos) {
+        if (std::optional<Token> token = ScanToken(buffer_, begin)) {
+          return token;
+        }
+      }
+      if (!KATANA_CHECKED(ReadMore())) {
+        return std::optional<Token>();
+      }
+    }
+  }
+
+  /// Read up to the start tag of the first graph into header_ and decide
+  /// whether the rest can be split
+  katana::Result<void> ReadHeader() {
+    KATANA_CHECKED(ReadMore());
+    // gzip, which libxml2 decompresses, and UTF-16 byte order marks
+    for (std::string_view magic : {"\x1f\x8b", "\xff\xfe", "\xfe\xff"}) {
+      if (std::string_view(buffer_).substr(0, magic.size()) == magic) {
+        can_split_ = false;
+        return katana::ResultSuccess();
+      }
+    }
+
+    std::vector<std::string> open_elements;
+    while (true) {
+      std::optional<Token> token = KATANA_CHECKED(NextToken());
+      if (!token) {
+        // No graph; leave any errors to the whole document parser
+        can_split_ = false;
+        return katana::ResultSuccess();
+      }
+      pos_ = token->end;
+      std::string_view text =
+          std::string_view(buffer_).substr(token->begin, pos_ - token->begin);
+      if (token->kind == Token::kOther) {
+        if (text.substr(0, 9) == "<!DOCTYPE" || !IsUTF8Declaration(text)) {
+          can_split_ = false;
+          return katana::ResultSuccess();
+        }
+      } else if (token->kind == Token::kEndTag) {
+        if (!open_elements.empty()) {
+          open_elements.pop_back();
+        }
+      } else if (token->kind == Token::kStartTag) {
+        std::string_view name = TagName(buffer_, *token);
+        if (name == "graph") {
+          break;
+        }
+        open_elements.emplace_back(name);
+      }
+    }
+
+    header_ = buffer_.substr(0, pos_);
+    header_.append("</graph>");
+    for (auto it = open_elements.rbegin(); it != open_elements.rend(); ++it) {
+      header_.append("</").append(*it).append(">");
+    }
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+    return katana::ResultSuccess();
+  }
+
+  /// \returns false if text is an XML declaration of an encoding other than
+  /// UTF-8 or its subset ASCII
+  static bool IsUTF8Declaration(std::string_view text) {
+    if (text.substr(0, 5) != "<?xml") {
+      return true;
+    }
+    size_t pos = text.find("encoding");
+    if (pos == std::string_view::npos) {
+      return true;
+    }
+    size_t begin = text.find_first_of("\"'", pos);
+    if (begin == std::string_view::npos) {
+      return false;
+    }
+    size_t end = text.find(text[begin], begin + 1);
+    std::string encoding(text.substr(begin + 1, end - begin - 1));
+    boost::algorithm::to_lower(encoding);
+    return encoding == "utf-8" || encoding == "utf8" ||
+           encoding == "us-ascii" || encoding == "ascii";
+  }
+
+  std::FILE* file_;
+  /// The unread part of the file; buffer_[0, pos_) has been scanned
+  std::string buffer_;
+  size_t pos_{0};
+  /// The depth of the element at pos_ below the graph
+  int depth_{0};
+  bool graph_ended_{false};
+  bool can_split_{true};
+  std::string header_;
+};
+
+/// Parse a piece of the graph from GraphMLChunkReader into elements
+katana::Result<void>
+ParseChunk(
+    const std::string& chunk, const KeyTypes& key_types,
+    std::vector<ParsedElement>* elements) {
+  xmlTextReaderPtr reader =
+      xmlReaderForMemory(chunk.data(), chunk.size(), nullptr, "UTF-8", 0);
+  if (reader == NULL) {
+    return KATANA_ERROR(
+        katana::ErrorCode::OutOfMemory, "creating an xml reader failed");
+  }
+  ParsedSink sink{key_types, elements};
+  // Read the start tag of the graph and then its content
+  int ret = xmlTextReaderRead(reader);
+  if (ret == 1) {
+    ret = ProcessGraph(reader, &sink, false);
+  }
+  xmlFreeTextReader(reader);
   if (ret < 0) {
+    return ParseError();
+  }
+  return katana::ResultSuccess();
+}
+
+/// Parse the graph a window of pieces at a time: the pieces of a window are
+/// parsed in parallel and then added to the builder in file order, so
+/// memory use is bounded by the window rather than the file.
+///
+/// Reading the pieces, adding them to the builder and building the tables
+/// are serial, and bound the speedup of the whole conversion; they are
+/// timed as ReadGraphML and MergeGraphML.
+katana::Result<katana::GraphComponents>
+ConvertInParallel(
+    GraphMLChunkReader* chunk_reader, size_t chunk_size,
+    size_t parse_chunk_bytes, bool verbose) {
+  katana::PropertyGraphBuilder builder{chunk_size};
+  KeyTypes key_types;
+
+  const std::string& header = chunk_reader->header();
+  xmlTextReaderPtr reader =
+      xmlReaderForMemory(header.data(), header.size(), nullptr, nullptr, 0);
+  if (reader == NULL) {
     return KATANA_ERROR(
-        ErrorCode::InvalidArgument,
-        "failed to parse: incorrect xml format\n"
-        "Please verify there are no illegal characters in the GraphML file\n"
-        "To remove invalid characters use: \"sed -i $'s/[^[:print:]\t]//g' "
-        "<file>\", warning this will alter the original file");
+        katana::ErrorCode::OutOfMemory, "creating an xml reader failed");
+  }
+  int ret = ProcessDocument(reader, &builder, &key_types, false, verbose);
+  xmlFreeTextReader(reader);
+  if (ret < 0) {
+    KATANA_CHECKED(ParseError());
+  }
+
+  // libxml2 must be initialized before it is used from several threads
+  xmlInitParser();
+
+  size_t window = 2 * katana::getActiveThreads();
+  std::vector<std::string> chunks(window);
+  std::vector<std::vector<ParsedElement>> parsed(window);
+  std::vector<katana::Result<void>> results(window, katana::ResultSuccess());
+  size_t num_bytes = 0;
+
+  katana::StatTimer read_timer("ReadGraphML");
+  katana::StatTimer merge_timer("MergeGraphML");
+
+  bool more = true;
+  while (more) {
+    read_timer.start();
+    size_t num_chunks = 0;
+    for (; num_chunks < window; ++num_chunks) {
+      KATANA_CHECKED(
+          chunk_reader->NextChunk(parse_chunk_bytes, &chunks[num_chunks]));
+      if (chunks[num_chunks].empty()) {
+        more = false;
+        break;
+      }
+      num_bytes += chunks[num_chunks].size();
+    }
+    read_timer.stop();
+
+    katana::do_all(
+        katana::iterate(size_t{0}, num_chunks),
+        [&](size_t i) {
+          results[i] = ParseChunk(chunks[i], key_types, &parsed[i]);
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("ParseGraphML"));
+
+    merge_timer.start();
+    for (size_t i = 0; i < num_chunks; ++i) {
+      KATANA_CHECKED(results[i]);
+      for (ParsedElement& element : parsed[i]) {
+        AddParsedElement(&element, &builder);
+      }
+      parsed[i].clear();
+    }
+    merge_timer.stop();
+  }
+
+  merge_timer.start();
+  auto components = builder.Finish(verbose);
+  merge_timer.stop();
+
+  if (verbose) {
+    std::cout << "Parsed " << num_bytes << " bytes of nodes and edges\n"
+              << "Read the pieces in " << read_timer.get_usec() / 1000
+              << " ms and merged them in " << merge_timer.get_usec() / 1000
+              << " ms serially\n";
+  }
+
+  return components;
+}
+
+}  // end of unnamed namespace
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphML(
+    const std::string& infilename, size_t chunk_size, bool verbose,
+    size_t parse_chunk_bytes) {
+  std::unique_ptr<GraphMLChunkReader> chunk_reader =
+      KATANA_CHECKED(GraphMLChunkReader::Make(infilename));
+  if (chunk_reader->can_split()) {
+    return ConvertInParallel(
+        chunk_reader.get(), chunk_size, parse_chunk_bytes, verbose);
+  }
+  chunk_reader.reset();
+
+  xmlTextReaderPtr reader;
+
+  reader = xmlNewTextReaderFilename(infilename.c_str());
+  if (reader == NULL) {
+    return KATANA_ERROR(ErrorCode::NotFound, "Unable to open {}", infilename);
+  }
+  auto res = ConvertGraphML(reader, chunk_size, verbose);
+  xmlFreeTextReader(reader);
+  return res;
+}
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphML(
+    xmlTextReaderPtr reader, size_t chunk_size, bool verbose) {
+  katana::PropertyGraphBuilder builder{chunk_size};
+  KeyTypes key_types;
+
+  int ret = ProcessDocument(reader, &builder, &key_types, true, verbose);
+  if (ret < 0) {
+    KATANA_CHECKED(ParseError());
   }
   return builder.Finish(verbose);
 }
@@ -0,0 +1,717 @@
+#include "katana/GraphStatistics.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <utility>
+
+#include <arrow/compute/api.h>
+
+#include "katana/Bag.h"
+#include "katana/EdgeShuffle.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+/// Pairs of neighbors sampled for the clustering coefficient of a node with
+/// too many neighbors to count its triangles
+constexpr uint64_t kClusteringPairSamples = 4096;
+
+/// The key of the fingerprint in the saved statistics
+const char* kFingerprintKey = "fingerprint";
+
+/// The splitmix64 finalizer, which spreads every input bit over the output
+uint64_t
+Mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ULL;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  return x;
+}
+
+uint32_t
+Log2Bucket(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+void
+AddToHistogram(std::vector<uint64_t>* histogram, uint64_t value) {
+  uint32_t bucket = Log2Bucket(value);
+  if (histogram->size() <= bucket) {
+    histogram->resize(bucket + 1);
+  }
+  ++(*histogram)[bucket];
+}
+
+void
+MergeHistogram(
+    std::vector<uint64_t>* histogram, const std::vector<uint64_t>& other) {
+  if (histogram->size() < other.size()) {
+    histogram->resize(other.size());
+  }
+  for (size_t i = 0; i < other.size(); ++i) {
+    (*histogram)[i] += other[i];
+  }
+}
+
+struct NodeCounts {
+  katana::DegreeDistribution out_degrees;
+  katana::DegreeDistribution in_degrees;
+  std::vector<katana::EntityTypeStatistics> node_types;
+  std::vector<uint64_t> edge_type_counts;
+  uint64_t num_self_loops{0};
+};
+
+void
+ProfileDegreesAndTypes(
+    const katana::PropertyGraph* pg, katana::GraphStatistics* stats) {
+  const katana::GraphTopology& topology = pg->topology();
+  size_t num_node_types = pg->GetNodeTypeManager().GetNumEntityTypes();
+  size_t num_edge_types = pg->GetEdgeTypeManager().GetNumEntityTypes();
+
+  katana::NUMAArray<Edge> in_degrees;
+  in_degrees.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::fill(in_degrees.begin(), in_degrees.end(), Edge{0});
+  katana::do_all(
+      katana::iterate(topology.all_edges()),
+      [&](Edge e) {
+        __atomic_fetch_add(
+            &in_degrees[topology.edge_dest(e)], 1, __ATOMIC_RELAXED);
+      },
+      katana::no_stats());
+
+  katana::PerThreadStorage<NodeCounts> per_thread;
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        NodeCounts& counts = *per_thread.getLocal();
+        if (counts.node_types.empty()) {
+          counts.node_types.resize(num_node_types);
+          counts.edge_type_counts.resize(num_edge_types);
+        }
+        katana::EntityTypeStatistics& type =
+            counts.node_types[pg->GetTypeOfNode(n)];
+        ++type.count;
+        type.out_degrees.Add(topology.degree(n));
+        type.in_degrees.Add(in_degrees[n]);
+        counts.out_degrees.Add(topology.degree(n));
+        counts.in_degrees.Add(in_degrees[n]);
+        for (Edge e : topology.edges(n)) {
+          ++counts.edge_type_counts[pg->GetTypeOfEdge(e)];
+          if (topology.edge_dest(e) == n) {
+            ++counts.num_self_loops;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  std::vector<katana::EntityTypeStatistics> node_types(num_node_types);
+  std::vector<uint64_t> edge_type_counts(num_edge_types);
+  for (NodeCounts& counts : per_thread) {
+    stats->out_degrees.Merge(counts.out_degrees);
+    stats->in_degrees.Merge(counts.in_degrees);
+    stats->num_self_loops += counts.num_self_loops;
+    for (size_t t = 0; t < counts.node_types.size(); ++t) {
+      node_types[t].count += counts.node_types[t].count;
+      node_types[t].out_degrees.Merge(counts.node_types[t].out_degrees);
+      node_types[t].in_degrees.Merge(counts.node_types[t].in_degrees);
+    }
+    for (size_t t = 0; t < counts.edge_type_counts.size(); ++t) {
+      edge_type_counts[t] += counts.edge_type_counts[t];
+    }
+  }
+
+  for (size_t t = 0; t < num_node_types; ++t) {
+    if (node_types[t].count == 0) {
+      continue;
+    }
+    node_types[t].type_id = t;
+    node_types[t].name =
+        pg->GetNodeTypeManager().GetAtomicTypeName(t).value_or("");
+    stats->node_types.emplace_back(std::move(node_types[t]));
+  }
+  for (size_t t = 0; t < num_edge_types; ++t) {
+    if (edge_type_counts[t] == 0) {
+      continue;
+    }
+    katana::EntityTypeStatistics type;
+    type.type_id = t;
+    type.name = pg->GetEdgeTypeManager().GetAtomicTypeName(t).value_or("");
+    type.count = edge_type_counts[t];
+    stats->edge_types.emplace_back(std::move(type));
+  }
+}
+
+katana::PropertyStatistics
+ProfileProperty(
+    const std::string& name, const std::shared_ptr<arrow::ChunkedArray>& array,
+    bool count_distinct_values) {
+  katana::PropertyStatistics stats;
+  stats.name = name;
+  stats.type = array->type()->ToString();
+  stats.length = array->length();
+  stats.null_count = array->null_count();
+  if (count_distinct_values) {
+    auto unique = arrow::compute::Unique(array);
+    if (unique.ok()) {
+      // null is one of the unique values if there are any
+      std::shared_ptr<arrow::Array> values = unique.ValueOrDie();
+      stats.distinct_count = values->length() - values->null_count();
+    } else {
+      KATANA_LOG_DEBUG(
+          "not counting values of {}: {}", name, unique.status().ToString());
+    }
+  }
+  return stats;
+}
+
+Node
+Find(katana::NUMAArray<Node>* parent, Node n) {
+  while (true) {
+    Node p = __atomic_load_n(&(*parent)[n], __ATOMIC_RELAXED);
+    if (p == n) {
+      return n;
+    }
+    Node grandparent = __atomic_load_n(&(*parent)[p], __ATOMIC_RELAXED);
+    if (grandparent != p) {
+      // Parents only ever get smaller, so losing this race is harmless
+      __atomic_compare_exchange_n(
+          &(*parent)[n], &p, grandparent, false, __ATOMIC_RELAXED,
+          __ATOMIC_RELAXED);
+    }
+    n = grandparent;
+  }
+}
+
+void
+Union(katana::NUMAArray<Node>* parent, Node a, Node b) {
+  while (true) {
+    a = Find(parent, a);
+    b = Find(parent, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      std::swap(a, b);
+    }
+    // Hook the larger root under the smaller one
+    Node expected = a;
+    if (__atomic_compare_exchange_n(
+            &(*parent)[a], &expected, b, false, __ATOMIC_RELAXED,
+            __ATOMIC_RELAXED)) {
+      return;
+    }
+  }
+}
+
+katana::ComponentStatistics
+ProfileComponents(const katana::GraphTopology& topology, uint32_t num_largest) {
+  katana::NUMAArray<Node> parent;
+  parent.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::iota(parent.begin(), parent.end(), Node{0});
+
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        for (Edge e : topology.edges(n)) {
+          Union(&parent, n, topology.edge_dest(e));
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::NUMAArray<uint64_t> sizes;
+  sizes.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::fill(sizes.begin(), sizes.end(), uint64_t{0});
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        __atomic_fetch_add(&sizes[Find(&parent, n)], 1, __ATOMIC_RELAXED);
+      },
+      katana::no_stats());
+
+  using MinHeap = std::priority_queue<
+      uint64_t, std::vector<uint64_t>, std::greater<uint64_t>>;
+  struct Local {
+    std::vector<uint64_t> histogram;
+    MinHeap largest;
+  };
+  katana::PerThreadStorage<Local> per_thread;
+  katana::GAccumulator<uint64_t> num_components;
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        if (sizes[n] == 0) {
+          return;
+        }
+        Local& local = *per_thread.getLocal();
+        num_components += 1;
+        AddToHistogram(&local.histogram, sizes[n]);
+        local.largest.push(sizes[n]);
+        if (local.largest.size() > num_largest) {
+          local.largest.pop();
+        }
+      },
+      katana::no_stats());
+
+  katana::ComponentStatistics stats;
+  stats.num_components = num_components.reduce();
+  for (Local& local : per_thread) {
+    MergeHistogram(&stats.log2_histogram, local.histogram);
+    for (; !local.largest.empty(); local.largest.pop()) {
+      stats.largest.emplace_back(local.largest.top());
+    }
+  }
+  std::sort(stats.largest.begin(), stats.largest.end(), std::greater<>());
+  if (stats.largest.size() > num_largest) {
+    stats.largest.resize(num_largest);
+  }
+  return stats;
+}
+
+struct Sweep {
+  Node farthest;
+  uint32_t eccentricity;
+};
+
+/// Level synchronous BFS from source; the farthest node is the smallest of
+/// the last level
+Sweep
+BfsSweep(
+    const katana::GraphTopology& graph, Node source,
+    katana::NUMAArray<uint32_t>* dist) {
+  katana::ParallelSTL::fill(dist->begin(), dist->end(), kUnvisited);
+  (*dist)[source] = 0;
+
+  katana::InsertBag<Node> frontiers[2];
+  frontiers[0].push(source);
+  Sweep ret{source, 0};
+  for (uint32_t level = 0;; ++level) {
+    katana::InsertBag<Node>& current = frontiers[level % 2];
+    katana::InsertBag<Node>& next = frontiers[(level + 1) % 2];
+    next.clear();
+
+    katana::GReduceMin<Node> farthest;
+    katana::do_all(
+        katana::iterate(current),
+        [&](Node n) {
+          for (Edge e : graph.edges(n)) {
+            Node dest = graph.edge_dest(e);
+            uint32_t expected = kUnvisited;
+            if (__atomic_load_n(&(*dist)[dest], __ATOMIC_RELAXED) ==
+                    kUnvisited &&
+                __atomic_compare_exchange_n(
+                    &(*dist)[dest], &expected, level + 1, false,
+                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+              next.push(dest);
+              farthest.update(dest);
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    if (next.empty()) {
+      return ret;
+    }
+    ret = Sweep{farthest.reduce(), level + 1};
+  }
+}
+
+bool
+HasEdge(const katana::GraphTopology& graph, Node src, Node dest) {
+  auto edges = graph.edges(src);
+  Edge begin = *edges.begin();
+  Edge end = *edges.end();
+  while (begin < end) {
+    Edge mid = begin + (end - begin) / 2;
+    if (graph.edge_dest(mid) < dest) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin < *edges.end() && graph.edge_dest(begin) == dest;
+}
+
+/// The number of common neighbors of a and b
+uint64_t
+CountCommonNeighbors(const katana::GraphTopology& graph, Node a, Node b) {
+  Edge i = *graph.edges(a).begin();
+  Edge i_end = *graph.edges(a).end();
+  Edge j = *graph.edges(b).begin();
+  Edge j_end = *graph.edges(b).end();
+  uint64_t count = 0;
+  while (i < i_end && j < j_end) {
+    Node x = graph.edge_dest(i);
+    Node y = graph.edge_dest(j);
+    count += x == y;
+    i += x <= y;
+    j += y <= x;
+  }
+  return count;
+}
+
+double
+LocalClusteringCoefficient(
+    const katana::GraphTopology& graph, Node n,
+    const katana::GraphStatisticsOptions& opts) {
+  uint64_t degree = graph.degree(n);
+  if (degree < 2) {
+    return 0.0;
+  }
+  Edge first = *graph.edges(n).begin();
+
+  if (degree <= opts.max_exact_clustering_degree) {
+    // Every triangle is counted from both of its other nodes
+    uint64_t count = 0;
+    for (Edge e : graph.edges(n)) {
+      count += CountCommonNeighbors(graph, n, graph.edge_dest(e));
+    }
+    return static_cast<double>(count) / (degree * (degree - 1));
+  }
+
+  std::mt19937_64 gen(opts.seed ^ (n * 0x9E3779B97F4A7C15ULL));
+  std::uniform_int_distribution<uint64_t> neighbor(0, degree - 1);
+  uint64_t hits = 0;
+  for (uint64_t i = 0; i < kClusteringPairSamples; ++i) {
+    uint64_t a = neighbor(gen);
+    uint64_t b = neighbor(gen);
+    while (b == a) {
+      b = neighbor(gen);
+    }
+    hits += HasEdge(
+        graph, graph.edge_dest(first + a), graph.edge_dest(first + b));
+  }
+  return static_cast<double>(hits) / kClusteringPairSamples;
+}
+
+double
+EstimateClusteringCoefficient(
+    const katana::GraphTopology& graph,
+    const katana::GraphStatisticsOptions& opts, uint64_t* num_samples) {
+  *num_samples = std::min<uint64_t>(
+      opts.num_clustering_samples, graph.num_nodes());
+  std::vector<Node> samples(*num_samples);
+  if (*num_samples == graph.num_nodes()) {
+    std::iota(samples.begin(), samples.end(), Node{0});
+  } else {
+    std::mt19937_64 gen(opts.seed);
+    std::uniform_int_distribution<Node> node(0, graph.num_nodes() - 1);
+    std::generate(samples.begin(), samples.end(), [&]() { return node(gen); });
+  }
+
+  katana::GAccumulator<double> sum;
+  katana::do_all(
+      katana::iterate(samples),
+      [&](Node n) { sum += LocalClusteringCoefficient(graph, n, opts); },
+      katana::steal(), katana::no_stats());
+  return *num_samples == 0 ? 0.0 : sum.reduce() / *num_samples;
+}
+
+}  // namespace
+
+void
+katana::DegreeDistribution::Add(uint64_t degree) {
+  ++num_nodes;
+  sum += degree;
+  max = std::max(max, degree);
+  AddToHistogram(&log2_histogram, degree);
+}
+
+void
+katana::DegreeDistribution::Merge(const DegreeDistribution& other) {
+  num_nodes += other.num_nodes;
+  sum += other.sum;
+  max = std::max(max, other.max);
+  MergeHistogram(&log2_histogram, other.log2_histogram);
+}
+
+katana::GraphTopology
+katana::MakeUndirectedTopology(const GraphTopology& graph) {
+  EdgeShuffleOptions opts;
+  opts.remove_self_loops = true;
+  opts.remove_duplicates = true;
+  ShuffledEdges edges = SymmetrizeEdges(graph, opts);
+  return GraphTopology(std::move(edges.adj_indices), std::move(edges.dests));
+}
+
+uint64_t
+katana::EstimateDiameter(const GraphTopology& graph, uint32_t num_sweeps) {
+  if (graph.num_nodes() == 0) {
+    return 0;
+  }
+  katana::GReduceMax<uint64_t> max_degree;
+  katana::do_all(
+      katana::iterate(graph.all_nodes()),
+      [&](Node n) { max_degree.update(graph.degree(n)); }, katana::no_stats());
+  uint64_t hub_degree = max_degree.reduce();
+  katana::GReduceMin<Node> hub;
+  katana::do_all(
+      katana::iterate(graph.all_nodes()),
+      [&](Node n) {
+        if (graph.degree(n) == hub_degree) {
+          hub.update(n);
+        }
+      },
+      katana::no_stats());
+
+  katana::NUMAArray<uint32_t> dist;
+  dist.allocateInterleaved(graph.num_nodes());
+  uint64_t diameter = 0;
+  Node source = hub.reduce();
+  for (uint32_t i = 0; i < num_sweeps; ++i) {
+    Sweep sweep = BfsSweep(graph, source, &dist);
+    diameter = std::max<uint64_t>(diameter, sweep.eccentricity);
+    source = sweep.farthest;
+  }
+  return diameter;
+}
+
+katana::Result<katana::GraphStatistics>
+katana::ComputeGraphStatistics(
+    const PropertyGraph* pg, const GraphStatisticsOptions& opts) {
+  GraphStatistics stats;
+  const GraphTopology& topology = pg->topology();
+  stats.num_nodes = topology.num_nodes();
+  stats.num_edges = topology.num_edges();
+  if (topology.num_nodes() == 0) {
+    return MakeResult(std::move(stats));
+  }
+
+  ProfileDegreesAndTypes(pg, &stats);
+
+  for (int32_t i = 0; i < pg->GetNumNodeProperties(); ++i) {
+    stats.node_properties.emplace_back(ProfileProperty(
+        pg->GetNodePropertyName(i), pg->GetNodeProperty(i),
+        opts.count_distinct_values));
+  }
+  for (int32_t i = 0; i < pg->GetNumEdgeProperties(); ++i) {
+    stats.edge_properties.emplace_back(ProfileProperty(
+        pg->GetEdgePropertyName(i), pg->GetEdgeProperty(i),
+        opts.count_distinct_values));
+  }
+
+  stats.components = ProfileComponents(topology, opts.num_largest_components);
+
+  GraphTopology undirected = MakeUndirectedTopology(topology);
+  stats.estimated_diameter =
+      EstimateDiameter(undirected, opts.num_diameter_sweeps);
+  stats.clustering_coefficient = EstimateClusteringCoefficient(
+      undirected, opts, &stats.clustering_samples);
+
+  return MakeResult(std::move(stats));
+}
+
+katana::GraphFingerprint
+katana::ComputeGraphFingerprint(const PropertyGraph* pg) {
+  const GraphTopology& topology = pg->topology();
+  GraphFingerprint fp;
+  fp.num_nodes = topology.num_nodes();
+  fp.num_edges = topology.num_edges();
+
+  // A sum of hashes can be reduced in any order, and each hash includes the
+  // ID of its node or edge, so moving edges between nodes changes the sum
+  katana::GAccumulator<uint64_t> checksum;
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        uint64_t sum = Mix(Mix(n) + *topology.edges(n).end()) +
+                       Mix(Mix(~uint64_t{n}) + pg->GetTypeOfNode(n));
+        for (Edge e : topology.edges(n)) {
+          sum += Mix(Mix(e) + topology.edge_dest(e)) +
+                 Mix(Mix(~e) + pg->GetTypeOfEdge(e));
+        }
+        checksum += sum;
+      },
+      katana::steal(), katana::no_stats());
+  fp.checksum = checksum.reduce();
+
+  fp.node_properties = pg->ListNodeProperties();
+  fp.edge_properties = pg->ListEdgeProperties();
+  std::sort(fp.node_properties.begin(), fp.node_properties.end());
+  std::sort(fp.edge_properties.begin(), fp.edge_properties.end());
+  return fp;
+}
+
+void
+katana::StoreGraphStatistics(PropertyGraph* pg, const GraphStatistics& stats) {
+  nlohmann::json j = stats;
+  j[kFingerprintKey] = ComputeGraphFingerprint(pg);
+  pg->set_graph_statistics(std::move(j));
+}
+
+katana::Result<katana::GraphStatistics>
+katana::LoadGraphStatistics(const PropertyGraph* pg) {
+  const nlohmann::json& j = pg->graph_statistics();
+  if (j.is_null()) {
+    return KATANA_ERROR(ErrorCode::NotFound, "graph has no statistics");
+  }
+  try {
+    auto it = j.find(kFingerprintKey);
+    if (it == j.end() ||
+        it->get<GraphFingerprint>() != ComputeGraphFingerprint(pg)) {
+      return KATANA_ERROR(
+          ErrorCode::NotFound, "graph changed since its statistics were saved");
+    }
+    return j.get<GraphStatistics>();
+  } catch (const std::exception& exp) {
+    return KATANA_ERROR(
+        ErrorCode::JSONParseFailed, "reading graph statistics: {}",
+        exp.what());
+  }
+}
+
+void
+katana::to_json(nlohmann::json& j, const DegreeDistribution& dist) {
+  j = nlohmann::json{
+      {"num_nodes", dist.num_nodes},
+      {"sum", dist.sum},
+      {"max", dist.max},
+      {"mean", dist.mean()},
+      {"log2_histogram", dist.log2_histogram}};
+}
+
+void
+katana::from_json(const nlohmann::json& j, DegreeDistribution& dist) {
+  j.at("num_nodes").get_to(dist.num_nodes);
+  j.at("sum").get_to(dist.sum);
+  j.at("max").get_to(dist.max);
+  j.at("log2_histogram").get_to(dist.log2_histogram);
+}
+
+void
+katana::to_json(nlohmann::json& j, const EntityTypeStatistics& stats) {
+  j = nlohmann::json{
+      {"type_id", stats.type_id},
+      {"name", stats.name},
+      {"count", stats.count}};
+  if (stats.out_degrees.num_nodes != 0) {
+    j["out_degrees"] = stats.out_degrees;
+    j["in_degrees"] = stats.in_degrees;
+  }
+}
+
+void
+katana::from_json(const nlohmann::json& j, EntityTypeStatistics& stats) {
+  j.at("type_id").get_to(stats.type_id);
+  j.at("name").get_to(stats.name);
+  j.at("count").get_to(stats.count);
+  if (auto it = j.find("out_degrees"); it != j.end()) {
+    it->get_to(stats.out_degrees);
+    j.at("in_degrees").get_to(stats.in_degrees);
+  }
+}
+
+void
+katana::to_json(nlohmann::json& j, const PropertyStatistics& stats) {
+  j = nlohmann::json{
+      {"name", stats.name},
+      {"type", stats.type},
+      {"length", stats.length},
+      {"null_count", stats.null_count},
+      {"null_ratio", stats.null_ratio()}};
+  if (stats.distinct_count) {
+    j["distinct_count"] = stats.distinct_count.value();
+  }
+}
+
+void
+katana::from_json(const nlohmann::json& j, PropertyStatistics& stats) {
+  j.at("name").get_to(stats.name);
+  j.at("type").get_to(stats.type);
+  j.at("length").get_to(stats.length);
+  j.at("null_count").get_to(stats.null_count);
+  if (auto it = j.find("distinct_count"); it != j.end()) {
+    stats.distinct_count = it->get<uint64_t>();
+  }
+}
+
+void
+katana::to_json(nlohmann::json& j, const ComponentStatistics& stats) {
+  j = nlohmann::json{
+      {"num_components", stats.num_components},
+      {"largest", stats.largest},
+      {"log2_histogram", stats.log2_histogram}};
+}
+
+void
+katana::from_json(const nlohmann::json& j, ComponentStatistics& stats) {
+  j.at("num_components").get_to(stats.num_components);
+  j.at("largest").get_to(stats.largest);
+  j.at("log2_histogram").get_to(stats.log2_histogram);
+}
+
+void
+katana::to_json(nlohmann::json& j, const GraphFingerprint& fp) {
+  j = nlohmann::json{
+      {"num_nodes", fp.num_nodes},
+      {"num_edges", fp.num_edges},
+      {"checksum", fp.checksum},
+      {"node_properties", fp.node_properties},
+      {"edge_properties", fp.edge_properties}};
+}
+
+void
+katana::from_json(const nlohmann::json& j, GraphFingerprint& fp) {
+  j.at("num_nodes").get_to(fp.num_nodes);
+  j.at("num_edges").get_to(fp.num_edges);
+  j.at("checksum").get_to(fp.checksum);
+  j.at("node_properties").get_to(fp.node_properties);
+  j.at("edge_properties").get_to(fp.edge_properties);
+}
+
+void
+katana::to_json(nlohmann::json& j, const GraphStatistics& stats) {
+  j = nlohmann::json{
+      {"version", GraphStatistics::kVersion},
+      {"num_nodes", stats.num_nodes},
+      {"num_edges", stats.num_edges},
+      {"num_self_loops", stats.num_self_loops},
+      {"out_degrees", stats.out_degrees},
+      {"in_degrees", stats.in_degrees},
+      {"node_types", stats.node_types},
+      {"edge_types", stats.edge_types},
+      {"node_properties", stats.node_properties},
+      {"edge_properties", stats.edge_properties},
+      {"estimated_diameter", stats.estimated_diameter},
+      {"clustering_coefficient", stats.clustering_coefficient},
+      {"clustering_samples", stats.clustering_samples},
+      {"components", stats.components}};
+}
+
+void
+katana::from_json(const nlohmann::json& j, GraphStatistics& stats) {
+  uint32_t version = 0;
+  j.at("version").get_to(version);
+  if (version > GraphStatistics::kVersion) {
+    // nlohmann::json reports errors using exceptions
+    throw std::runtime_error("graph statistics are from a newer version");
+  }
+  j.at("num_nodes").get_to(stats.num_nodes);
+  j.at("num_edges").get_to(stats.num_edges);
+  j.at("num_self_loops").get_to(stats.num_self_loops);
+  j.at("out_degrees").get_to(stats.out_degrees);
+  j.at("in_degrees").get_to(stats.in_degrees);
+  j.at("node_types").get_to(stats.node_types);
+  j.at("edge_types").get_to(stats.edge_types);
+  j.at("node_properties").get_to(stats.node_properties);
+  j.at("edge_properties").get_to(stats.edge_properties);
+  j.at("estimated_diameter").get_to(stats.estimated_diameter);
+  j.at("clustering_coefficient").get_to(stats.clustering_coefficient);
+  j.at("clustering_samples").get_to(stats.clustering_samples);
+  j.at("components").get_to(stats.components);
+}
@@ -2,11 +2,17 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
 
+#include "katana/EdgeShuffle.h"
 #include "katana/Logging.h"
+#include "katana/MemoryAccounting.h"
 #include "katana/PropertyGraph.h"
 #include "katana/Random.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+#include "katana/Timer.h"
 #include "tsuba/RDGTopology.h"
 
 void
@@ -61,67 +67,13 @@ katana::EdgeShuffleTopology::MakeTransposeCopy(
     return std::make_unique<EdgeShuffleTopology>(std::move(et));
   }
 
-  GraphTopologyTypes::AdjIndexVec out_indices;
-  GraphTopologyTypes::EdgeDestVec out_dests;
-  GraphTopologyTypes::PropIndexVec edge_prop_indices;
-  GraphTopologyTypes::AdjIndexVec out_dests_offset;
-
-  out_indices.allocateInterleaved(topology.num_nodes());
-  out_dests.allocateInterleaved(topology.num_edges());
-  edge_prop_indices.allocateInterleaved(topology.num_edges());
-  out_dests_offset.allocateInterleaved(topology.num_nodes());
-
-  katana::ParallelSTL::fill(out_indices.begin(), out_indices.end(), Edge{0});
-
-  // Keep a copy of old destinaton ids and compute number of
-  // in-coming edges for the new prefix sum of out_indices.
-  katana::do_all(
-      katana::iterate(topology.all_edges()),
-      [&](Edge e) {
-        // Counting outgoing edges in the tranpose graph by
-        // counting incoming edges in the original graph
-        auto dest = topology.edge_dest(e);
-        __sync_add_and_fetch(&(out_indices[dest]), 1);
-      },
-      katana::no_stats());
-
-  // Prefix sum calculation of the edge index array
-  katana::ParallelSTL::partial_sum(
-      out_indices.begin(), out_indices.end(), out_indices.begin());
-
-  // temporary buffer for storing the starting point of each node's transpose
-  // adjacency
-  out_dests_offset[0] = 0;
-  katana::do_all(
-      katana::iterate(Edge{1}, Edge{topology.num_nodes()}),
-      [&](Edge n) { out_dests_offset[n] = out_indices[n - 1]; },
-      katana::no_stats());
-
-  // Update out_dests with the new destination ids
-  // of the transposed graphs
-  katana::do_all(
-      katana::iterate(topology.all_nodes()),
-      [&](auto src) {
-        // get all outgoing edges of a particular
-        // node and reverse the edges.
-        for (GraphTopology::Edge e : topology.edges(src)) {
-          // e = start index into edge array for a particular node
-          // Destination node
-          auto dest = topology.edge_dest(e);
-          // Location to save edge
-          auto e_new = __sync_fetch_and_add(&(out_dests_offset[dest]), 1);
-          // Save src as destination
-          out_dests[e_new] = src;
-          // remember the original edge ID to look up properties
-          edge_prop_indices[e_new] = e;
-        }
-      },
-      katana::steal(), katana::no_stats());
+  ShuffledEdges transpose = TransposeEdges(topology);
 
   return std::make_unique<EdgeShuffleTopology>(EdgeShuffleTopology{
       tsuba::RDGTopology::TransposeKind::kYes,
-      tsuba::RDGTopology::EdgeSortKind::kAny, std::move(out_indices),
-      std::move(out_dests), std::move(edge_prop_indices)});
+      tsuba::RDGTopology::EdgeSortKind::kAny,
+      std::move(transpose.adj_indices), std::move(transpose.dests),
+      std::move(transpose.edge_prop_indices)});
 }
 
 std::unique_ptr<katana::EdgeShuffleTopology>
@@ -449,7 +401,7 @@ katana::CondensedTypeIDMap::MakeFromEdgeTypes(
 
   // ordered map
   std::set<katana::EntityTypeID> mergedSet;
-  for (uint32_t i = 0; i < katana::activeThreads; ++i) {
+  for (uint32_t i = 0; i < katana::getActiveThreads(); ++i) {
     auto& edgeTypesSet = *edgeTypes.getRemote(i);
     for (auto edgeType : edgeTypesSet) {
       mergedSet.insert(edgeType);
@@ -883,22 +835,248 @@ katana::ProjectedTopology::MakeTypeProjectedTopology(
       std::move(projected_to_original_edges_mapping), std::move(node_bitmask),
       std::move(edge_bitmask)});
 }
+namespace {
+
+using Edge = katana::GraphTopologyTypes::Edge;
+using Node = katana::GraphTopologyTypes::Node;
+using PropertyIndex = katana::GraphTopologyTypes::PropertyIndex;
+
+size_t
+NumBytes(const katana::EdgeShuffleTopology& topo) noexcept {
+  return topo.num_nodes() * sizeof(Edge) +
+         topo.num_edges() * (sizeof(Node) + sizeof(PropertyIndex));
+}
+
+size_t
+NumBytes(const katana::ShuffleTopology& topo) noexcept {
+  return NumBytes(static_cast<const katana::EdgeShuffleTopology&>(topo)) +
+         topo.num_nodes() * sizeof(PropertyIndex);
+}
+
+/// Only counts the per type adjacency indices; the underlying
+/// EdgeShuffleTopology is a cache entry of its own
+size_t
+NumBytes(
+    const katana::EdgeTypeAwareTopology& topo,
+    const katana::CondensedTypeIDMap& edge_type_index) noexcept {
+  return topo.num_nodes() * edge_type_index.num_unique_types() * sizeof(Edge);
+}
+
+size_t
+NumBytes(
+    const katana::ProjectedTopology& topo,
+    const katana::PropertyGraph& pg) noexcept {
+  return topo.num_nodes() * (sizeof(Edge) + sizeof(Node)) +
+         topo.num_edges() * (sizeof(Node) + sizeof(Edge)) +
+         pg.num_nodes() * sizeof(Node) + pg.num_edges() * sizeof(Edge) +
+         (pg.num_nodes() + pg.num_edges()) / 8;
+}
+
+size_t
+NumBytes(const katana::LazyProjectedTopology& topo) noexcept {
+  return topo.num_bytes();
+}
+
+std::vector<std::string>
+SortedUnique(std::vector<std::string> types) {
+  std::sort(types.begin(), types.end());
+  types.erase(std::unique(types.begin(), types.end()), types.end());
+  return types;
+}
+
+katana::NUMAArray<uint8_t>
+MakeBitmask(const katana::DynamicBitset& bitset) {
+  katana::NUMAArray<uint8_t> bitmask;
+  bitmask.allocateInterleaved((bitset.size() + 7) / 8);
+  katana::ProjectedTopology::FillBitMask(bitset.size(), bitset, &bitmask);
+  return bitmask;
+}
+
+}  // namespace
+
+katana::LazyProjectedTopology::LazyProjectedTopology(
+    const GraphTopology* topo, DynamicBitset&& nodes, DynamicBitset&& edges,
+    NUMAArray<uint32_t>&& degrees) noexcept
+    : topo_(topo),
+      nodes_(std::move(nodes)),
+      edges_(std::move(edges)),
+      degrees_(std::move(degrees)),
+      num_projected_nodes_(nodes_.count()),
+      num_projected_edges_(edges_.count()),
+      node_bitmask_data_(MakeBitmask(nodes_)),
+      edge_bitmask_data_(MakeBitmask(edges_)),
+      node_bitmask_(
+          static_cast<void*>(node_bitmask_data_.data()), 0,
+          static_cast<int64_t>(nodes_.size())),
+      edge_bitmask_(
+          static_cast<void*>(edge_bitmask_data_.data()), 0,
+          static_cast<int64_t>(edges_.size())) {
+  KATANA_LOG_DEBUG_ASSERT(nodes_.size() == topo_->num_nodes());
+  KATANA_LOG_DEBUG_ASSERT(edges_.size() == topo_->num_edges());
+}
+
+std::unique_ptr<katana::LazyProjectedTopology>
+katana::LazyProjectedTopology::MakeTypeProjectedTopology(
+    const katana::PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types, bool cache_degrees) {
+  KATANA_LOG_DEBUG_ASSERT(pg);
+
+  std::set<katana::EntityTypeID> node_entity_type_ids;
+  for (const auto& node_type : node_types) {
+    node_entity_type_ids.insert(pg->GetNodeEntityTypeID(node_type));
+  }
+  std::set<katana::EntityTypeID> edge_entity_type_ids;
+  for (const auto& edge_type : edge_types) {
+    edge_entity_type_ids.insert(pg->GetEdgeEntityTypeID(edge_type));
+  }
+
+  auto node_pred = [&](const Node& n) {
+    if (node_entity_type_ids.empty()) {
+      return true;
+    }
+    for (auto type : node_entity_type_ids) {
+      if (pg->DoesNodeHaveType(n, type)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  auto edge_pred = [&](const Edge& e) {
+    if (edge_entity_type_ids.empty()) {
+      return true;
+    }
+    for (auto type : edge_entity_type_ids) {
+      if (pg->DoesEdgeHaveType(e, type)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  return Make(&pg->topology(), node_pred, edge_pred, cache_degrees);
+}
+
+size_t
+katana::LazyProjectedTopology::num_bytes() const noexcept {
+  return (nodes_.get_vec().size() + edges_.get_vec().size()) *
+             sizeof(uint64_t) +
+         node_bitmask_data_.size() + edge_bitmask_data_.size() +
+         degrees_.size() * sizeof(uint32_t);
+}
+
+std::unique_ptr<katana::EdgeSourceIndex>
+katana::EdgeSourceIndex::Make(
+    const Edge* adj_indices, uint64_t num_nodes, const Node* dests,
+    uint64_t num_edges, uint32_t stride) {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kIndexes);
+  KATANA_LOG_ASSERT(stride > 0);
+
+  NUMAArray<Node> sources;
+  sources.allocateInterleaved((num_edges + stride - 1) / stride);
+
+  katana::do_all(
+      katana::iterate(Node{0}, static_cast<Node>(num_nodes)),
+      [&](const Node& n) {
+        Edge begin = n == 0 ? 0 : adj_indices[n - 1];
+        Edge end = adj_indices[n];
+        // the first sampled edge of n
+        Edge e = (begin + stride - 1) / stride * stride;
+        for (; e < end; e += stride) {
+          sources[e / stride] = n;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::unique_ptr<EdgeSourceIndex>(new EdgeSourceIndex(
+      adj_indices, num_nodes, dests, num_edges, stride, std::move(sources)));
+}
+
 const katana::GraphTopology*
 katana::PGViewCache::GetOriginalTopology(
     const PropertyGraph* pg) const noexcept {
   return &pg->topology();
 }
 
-katana::CondensedTypeIDMap*
+template <typename Topo, typename Pred>
+std::shared_ptr<Topo>
+katana::PGViewCache::Find(EntryKind kind, const Pred& pred) noexcept {
+  for (auto& entry : entries_) {
+    if (entry.kind != kind) {
+      continue;
+    }
+    auto topo = std::static_pointer_cast<Topo>(entry.topo);
+    if (pred(*topo)) {
+      entry.last_used = ++clock_;
+      ++stats_.hits;
+      return topo;
+    }
+  }
+  ++stats_.misses;
+  return nullptr;
+}
+
+void
+katana::PGViewCache::Insert(Entry&& entry) noexcept {
+  entry.last_used = ++clock_;
+  num_bytes_ += entry.num_bytes;
+  stats_.build_usec += entry.build_usec;
+  if (entry.loaded) {
+    ++stats_.loads;
+  }
+  entries_.emplace_back(std::move(entry));
+  EvictToBudget();
+}
+
+void
+katana::PGViewCache::EvictToBudget() noexcept {
+  // the most recently used entry has the largest last_used and is never
+  // picked while there are others
+  while (num_bytes_ > memory_budget_ && entries_.size() > 1) {
+    auto lru = std::min_element(
+        entries_.begin(), entries_.end(),
+        [](const Entry& a, const Entry& b) {
+          return a.last_used < b.last_used;
+        });
+    num_bytes_ -= lru->num_bytes;
+    entries_.erase(lru);
+    ++stats_.evictions;
+  }
+}
+
+void
+katana::PGViewCache::Clear() noexcept {
+  entries_.clear();
+  edge_type_id_map_.reset();
+  num_bytes_ = 0;
+}
+
+void
+katana::PGViewCache::set_memory_budget(size_t num_bytes) noexcept {
+  memory_budget_ = num_bytes;
+  EvictToBudget();
+}
+
+void
+katana::PGViewCache::ReportStats() const {
+  katana::ReportStatSingle("PGViewCache", "Hits", stats_.hits);
+  katana::ReportStatSingle("PGViewCache", "Misses", stats_.misses);
+  katana::ReportStatSingle("PGViewCache", "Loads", stats_.loads);
+  katana::ReportStatSingle("PGViewCache", "Evictions", stats_.evictions);
+  katana::ReportStatSingle("PGViewCache", "BuildTimeUsec", stats_.build_usec);
+  katana::ReportStatSingle("PGViewCache", "Bytes", num_bytes_);
+}
+
+std::shared_ptr<katana::CondensedTypeIDMap>
 katana::PGViewCache::BuildOrGetEdgeTypeIndex(
     const katana::PropertyGraph* pg) noexcept {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kIndexes);
   if (edge_type_id_map_ && edge_type_id_map_->is_valid()) {
-    return edge_type_id_map_.get();
+    return edge_type_id_map_;
   }
 
   edge_type_id_map_ = CondensedTypeIDMap::MakeFromEdgeTypes(pg);
   KATANA_LOG_DEBUG_ASSERT(edge_type_id_map_);
-  return edge_type_id_map_.get();
+  return edge_type_id_map_;
 };
 
 template <typename Topo>
@@ -908,184 +1086,299 @@ CheckTopology(const katana::PropertyGraph* pg, const Topo* t) noexcept {
          (pg->num_edges() == t->num_edges());
 }
 
-katana::EdgeShuffleTopology*
+std::shared_ptr<katana::EdgeShuffleTopology>
 katana::PGViewCache::BuildOrGetEdgeShuffTopo(
     katana::PropertyGraph* pg,
     const tsuba::RDGTopology::TransposeKind& tpose_kind,
     const tsuba::RDGTopology::EdgeSortKind& sort_kind) noexcept {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kViews);
   // try to find a matching topology in the cache
-  auto pred = [&](const auto& topo_ptr) {
-    return topo_ptr->is_valid() && topo_ptr->has_transpose_state(tpose_kind) &&
-           topo_ptr->has_edges_sorted_by(sort_kind);
+  auto pred = [&](const EdgeShuffleTopology& topo) {
+    return topo.is_valid() && topo.has_transpose_state(tpose_kind) &&
+           topo.has_edges_sorted_by(sort_kind);
   };
-  auto it =
-      std::find_if(edge_shuff_topos_.begin(), edge_shuff_topos_.end(), pred);
+  auto found =
+      Find<EdgeShuffleTopology>(EntryKind::kEdgeShuffleTopology, pred);
+  if (found) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, found.get()));
+    return found;
+  }
 
-  if (it != edge_shuff_topos_.end()) {
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-    return it->get();
-  } else {
-    // no matching topology in cache, see if we have it in storage
-    tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
-        tsuba::RDGTopology::TopologyKind::kEdgeShuffleTopology, tpose_kind,
-        sort_kind, tsuba::RDGTopology::NodeSortKind::kAny);
-
-    auto res = pg->LoadTopology(std::move(shadow));
-    if (!res) {
-      // no matching topology in cache or storage, generate it
-      edge_shuff_topos_.emplace_back(
-          EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind));
-    } else {
-      // found matching topology in storage
-      tsuba::RDGTopology* topo = res.value();
-      edge_shuff_topos_.emplace_back(katana::EdgeShuffleTopology::Make(topo));
-    }
+  // no matching topology in cache, see if we have it in storage
+  tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
+      tsuba::RDGTopology::TopologyKind::kEdgeShuffleTopology, tpose_kind,
+      sort_kind, tsuba::RDGTopology::NodeSortKind::kAny);
 
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, edge_shuff_topos_.back().get()));
-    return edge_shuff_topos_.back().get();
+  auto res = pg->LoadTopology(std::move(shadow));
+
+  katana::Timer timer;
+  timer.start();
+  std::shared_ptr<EdgeShuffleTopology> topo;
+  if (!res) {
+    // no matching topology in cache or storage, generate it
+    topo = EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind);
+  } else {
+    // found matching topology in storage
+    topo = katana::EdgeShuffleTopology::Make(res.value());
   }
+  timer.stop();
+
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, topo.get()));
+  Insert(Entry{
+      EntryKind::kEdgeShuffleTopology, topo, {}, {}, NumBytes(*topo), 0,
+      timer.get_usec(), bool(res)});
+  return topo;
 }
 
-katana::ShuffleTopology*
+std::shared_ptr<katana::ShuffleTopology>
 katana::PGViewCache::BuildOrGetShuffTopo(
     katana::PropertyGraph* pg,
     const tsuba::RDGTopology::TransposeKind& tpose_kind,
     const tsuba::RDGTopology::NodeSortKind& node_sort_todo,
     const tsuba::RDGTopology::EdgeSortKind& edge_sort_todo) noexcept {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kViews);
   // try to find a matching topology in the cache
-  auto pred = [&](const auto& topo_ptr) {
-    return topo_ptr->is_valid() && topo_ptr->has_transpose_state(tpose_kind) &&
-           topo_ptr->has_edges_sorted_by(edge_sort_todo) &&
-           topo_ptr->has_nodes_sorted_by(node_sort_todo);
+  auto pred = [&](const ShuffleTopology& topo) {
+    return topo.is_valid() && topo.has_transpose_state(tpose_kind) &&
+           topo.has_edges_sorted_by(edge_sort_todo) &&
+           topo.has_nodes_sorted_by(node_sort_todo);
   };
+  auto found = Find<ShuffleTopology>(EntryKind::kShuffleTopology, pred);
+  if (found) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, found.get()));
+    return found;
+  }
 
-  auto it =
-      std::find_if(fully_shuff_topos_.begin(), fully_shuff_topos_.end(), pred);
-
-  if (it != fully_shuff_topos_.end()) {
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-    return it->get();
+  // no matching topology in cache, see if we have it in storage
+  tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
+      tsuba::RDGTopology::TopologyKind::kShuffleTopology, tpose_kind,
+      edge_sort_todo, node_sort_todo);
+  auto res = pg->LoadTopology(std::move(shadow));
+
+  katana::Timer timer;
+  std::shared_ptr<ShuffleTopology> topo;
+  if (!res) {
+    // no matching topology in cache or storage, generate it
+
+    // EdgeShuffleTopology e_topo below is going to serve as a seed for
+    // ShuffleTopology, so we only care about transpose state, and not the sort
+    // state. Because, when creating ShuffleTopology, once we shuffle the nodes, we
+    // will need to re-sort the edges even if they were already sorted
+    auto e_topo = BuildOrGetEdgeShuffTopo(
+        pg, tpose_kind, tsuba::RDGTopology::EdgeSortKind::kAny);
+    KATANA_LOG_DEBUG_ASSERT(e_topo->has_transpose_state(tpose_kind));
+
+    timer.start();
+    topo = ShuffleTopology::MakeFromTopo(
+        pg, *e_topo, node_sort_todo, edge_sort_todo);
+    timer.stop();
   } else {
-    // no matching topology in cache, see if we have it in storage
-
-    tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
-        tsuba::RDGTopology::TopologyKind::kShuffleTopology, tpose_kind,
-        edge_sort_todo, node_sort_todo);
-    auto res = pg->LoadTopology(std::move(shadow));
-
-    if (!res) {
-      // no matching topology in cache or storage, generate it
-
-      // EdgeShuffleTopology e_topo below is going to serve as a seed for
-      // ShuffleTopology, so we only care about transpose state, and not the sort
-      // state. Because, when creating ShuffleTopology, once we shuffle the nodes, we
-      // will need to re-sort the edges even if they were already sorted
-      auto e_topo = BuildOrGetEdgeShuffTopo(
-          pg, tpose_kind, tsuba::RDGTopology::EdgeSortKind::kAny);
-      KATANA_LOG_DEBUG_ASSERT(e_topo->has_transpose_state(tpose_kind));
-
-      fully_shuff_topos_.emplace_back(ShuffleTopology::MakeFromTopo(
-          pg, *e_topo, node_sort_todo, edge_sort_todo));
-
-    } else {
-      // found matching topology in storage
-      tsuba::RDGTopology* topo = res.value();
-      fully_shuff_topos_.emplace_back(katana::ShuffleTopology::Make(topo));
-    }
-
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, fully_shuff_topos_.back().get()));
-    return fully_shuff_topos_.back().get();
+    // found matching topology in storage
+    timer.start();
+    topo = katana::ShuffleTopology::Make(res.value());
+    timer.stop();
   }
+
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, topo.get()));
+  Insert(Entry{
+      EntryKind::kShuffleTopology, topo, {}, {}, NumBytes(*topo), 0,
+      timer.get_usec(), bool(res)});
+  return topo;
 }
 
-katana::EdgeTypeAwareTopology*
+std::shared_ptr<katana::EdgeTypeAwareTopology>
 katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
     katana::PropertyGraph* pg,
     const tsuba::RDGTopology::TransposeKind& tpose_kind) noexcept {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kViews);
   // try to find a matching topology in the cache
-  auto pred = [&](const auto& topo_ptr) {
-    return topo_ptr->is_valid() && topo_ptr->has_transpose_state(tpose_kind);
+  auto pred = [&](const EdgeTypeAwareTopology& topo) {
+    return topo.is_valid() && topo.has_transpose_state(tpose_kind);
   };
-  auto it = std::find_if(
-      edge_type_aware_topos_.begin(), edge_type_aware_topos_.end(), pred);
+  auto found =
+      Find<EdgeTypeAwareTopology>(EntryKind::kEdgeTypeAwareTopology, pred);
+  if (found) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, found.get()));
+    return found;
+  }
 
-  if (it != edge_type_aware_topos_.end()) {
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-    return it->get();
+  // no matching topology in cache, see if we have it in storage
+
+  tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
+      tsuba::RDGTopology::TopologyKind::kEdgeTypeAwareTopology, tpose_kind,
+      tsuba::RDGTopology::EdgeSortKind::kSortedByEdgeType,
+      tsuba::RDGTopology::NodeSortKind::kAny);
+  auto res = pg->LoadTopology(std::move(shadow));
+
+  // In either generation, or loading, the EdgeTypeAwareTopology depends on an EdgeShuffleTopology
+  auto sorted_topo = BuildOrGetEdgeShuffTopo(
+      pg, tpose_kind, tsuba::RDGTopology::EdgeSortKind::kSortedByEdgeType);
+
+  // There are two use cases for the EdgeTypeIndex, either we:
+  // Are generating an EdgeTypeAwareTopology, and need the EdgeTypeIndex
+  // Are loading an EdgeTypeAwareTopology from storage, and need to confirm
+  // the EdgeTypeIndex in storage matches the one we have.
+  // If it doesn't match, then the EdgeTypeAwareTopology on storage is out of date and cannot be used
+  auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
+
+  katana::Timer timer;
+  timer.start();
+  std::unique_ptr<EdgeTypeAwareTopology> made;
+  if (res) {
+    // found matching topology in storage
+    made = katana::EdgeTypeAwareTopology::Make(
+        res.value(), edge_type_index.get(), sorted_topo.get());
   } else {
-    // no matching topology in cache, see if we have it in storage
-
-    tsuba::RDGTopology shadow = tsuba::RDGTopology::MakeShadow(
-        tsuba::RDGTopology::TopologyKind::kEdgeTypeAwareTopology, tpose_kind,
-        tsuba::RDGTopology::EdgeSortKind::kSortedByEdgeType,
-        tsuba::RDGTopology::NodeSortKind::kAny);
-    auto res = pg->LoadTopology(std::move(shadow));
-
-    // In either generation, or loading, the EdgeTypeAwareTopology depends on an EdgeShuffleTopology
-    auto sorted_topo = BuildOrGetEdgeShuffTopo(
-        pg, tpose_kind, tsuba::RDGTopology::EdgeSortKind::kSortedByEdgeType);
-
-    // There are two use cases for the EdgeTypeIndex, either we:
-    // Are generating an EdgeTypeAwareTopology, and need the EdgeTypeIndex
-    // Are loading an EdgeTypeAwareTopology from storage, and need to confirm
-    // the EdgeTypeIndex in storage matches the one we have.
-    // If it doesn't match, then the EdgeTypeAwareTopology on storage is out of date and cannot be used
-    auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
-
-    if (res) {
-      // found matching topology in storage
-      tsuba::RDGTopology* rdg_topo = res.value();
-
-      edge_type_aware_topos_.emplace_back(katana::EdgeTypeAwareTopology::Make(
-          rdg_topo, edge_type_index, sorted_topo));
-    }
+    // no matching topology in cache or storage, generate it
+    made = EdgeTypeAwareTopology::MakeFrom(
+        pg, edge_type_index.get(), sorted_topo.get());
+  }
+  timer.stop();
+
+  // The topology points into sorted_topo and edge_type_index, which may be
+  // evicted or replaced first, so it shares their ownership
+  std::shared_ptr<EdgeTypeAwareTopology> topo(
+      made.release(),
+      [sorted_topo, edge_type_index](EdgeTypeAwareTopology* t) { delete t; });
+
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, topo.get()));
+  Insert(Entry{
+      EntryKind::kEdgeTypeAwareTopology, topo, {}, {},
+      NumBytes(*topo, *edge_type_index), 0, timer.get_usec(), bool(res)});
+  return topo;
+}
 
-    else {
-      // no matching topology in cache or storage, generate it
-      edge_type_aware_topos_.emplace_back(
-          EdgeTypeAwareTopology::MakeFrom(pg, edge_type_index, sorted_topo));
+std::shared_ptr<void>
+katana::PGViewCache::FindProjection(
+    EntryKind kind, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types) noexcept {
+  for (auto& entry : entries_) {
+    if (entry.kind == kind && entry.node_types == node_types &&
+        entry.edge_types == edge_types) {
+      entry.last_used = ++clock_;
+      ++stats_.hits;
+      return entry.topo;
     }
-
-    KATANA_LOG_DEBUG_ASSERT(
-        CheckTopology(pg, edge_type_aware_topos_.back().get()));
-    return edge_type_aware_topos_.back().get();
   }
+  ++stats_.misses;
+  return nullptr;
 }
 
-katana::ProjectedTopology*
+std::shared_ptr<katana::ProjectedTopology>
 katana::PGViewCache::BuildOrGetProjectedGraphTopo(
     const PropertyGraph* pg, const std::vector<std::string>& node_types,
     const std::vector<std::string>& edge_types) noexcept {
-  if (projected_topos_) {
-    return projected_topos_.get();
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kViews);
+  // the order and multiplicity of the requested types do not change the
+  // projection
+  std::vector<std::string> node_key = SortedUnique(node_types);
+  std::vector<std::string> edge_key = SortedUnique(edge_types);
+
+  auto found =
+      FindProjection(EntryKind::kProjectedTopology, node_key, edge_key);
+  if (found) {
+    return std::static_pointer_cast<ProjectedTopology>(found);
   }
 
-  projected_topos_ =
+  katana::Timer timer;
+  timer.start();
+  std::shared_ptr<ProjectedTopology> topo =
       ProjectedTopology::MakeTypeProjectedTopology(pg, node_types, edge_types);
-  KATANA_LOG_DEBUG_ASSERT(projected_topos_);
-  return projected_topos_.get();
+  timer.stop();
+  KATANA_LOG_DEBUG_ASSERT(topo);
+
+  Insert(Entry{
+      EntryKind::kProjectedTopology, topo, std::move(node_key),
+      std::move(edge_key), NumBytes(*topo, *pg), 0, timer.get_usec(), false});
+  return topo;
+}
+
+std::shared_ptr<katana::LazyProjectedTopology>
+katana::PGViewCache::BuildOrGetLazyProjectedGraphTopo(
+    const PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types) noexcept {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kViews);
+  std::vector<std::string> node_key = SortedUnique(node_types);
+  std::vector<std::string> edge_key = SortedUnique(edge_types);
+
+  auto found =
+      FindProjection(EntryKind::kLazyProjectedTopology, node_key, edge_key);
+  if (found) {
+    return std::static_pointer_cast<LazyProjectedTopology>(found);
+  }
+
+  katana::Timer timer;
+  timer.start();
+  std::shared_ptr<LazyProjectedTopology> topo =
+      LazyProjectedTopology::MakeTypeProjectedTopology(
+          pg, node_types, edge_types);
+  timer.stop();
+  KATANA_LOG_DEBUG_ASSERT(topo);
+
+  Insert(Entry{
+      EntryKind::kLazyProjectedTopology, topo, std::move(node_key),
+      std::move(edge_key), NumBytes(*topo), 0, timer.get_usec(), false});
+  return topo;
+}
+
+std::shared_ptr<const katana::EdgeSourceIndex>
+katana::PGViewCache::BuildEdgeSourceIndex(
+    const PropertyGraph* pg, uint32_t stride) noexcept {
+  auto pred = [&](const EdgeSourceIndex& index) {
+    return index.stride() == stride;
+  };
+  auto found = Find<EdgeSourceIndex>(EntryKind::kEdgeSourceIndex, pred);
+  if (found) {
+    return found;
+  }
+
+  katana::Timer timer;
+  timer.start();
+  std::shared_ptr<EdgeSourceIndex> index =
+      EdgeSourceIndex::Make(pg->topology(), stride);
+  timer.stop();
+  KATANA_LOG_DEBUG_ASSERT(index);
+
+  Insert(Entry{
+      EntryKind::kEdgeSourceIndex, index, {}, {}, index->num_bytes(), 0,
+      timer.get_usec(), false});
+  return index;
 }
 
 katana::Result<std::vector<tsuba::RDGTopology>>
 katana::PGViewCache::ToRDGTopology() {
   std::vector<tsuba::RDGTopology> rdg_topos;
 
-  for (size_t i = 0; i < edge_shuff_topos_.size(); i++) {
-    tsuba::RDGTopology topo =
-        KATANA_CHECKED(edge_shuff_topos_[i]->ToRDGTopology());
-    rdg_topos.emplace_back(std::move(topo));
-  }
-
-  for (size_t i = 0; i < fully_shuff_topos_.size(); i++) {
-    tsuba::RDGTopology topo =
-        KATANA_CHECKED(fully_shuff_topos_[i]->ToRDGTopology());
-    rdg_topos.emplace_back(std::move(topo));
-  }
+  for (const auto& entry : entries_) {
+    // topologies that are cheap to build are not worth the storage
+    if (!entry.loaded && entry.build_usec < persist_threshold_usec_) {
+      continue;
+    }
 
-  for (size_t i = 0; i < edge_type_aware_topos_.size(); i++) {
-    tsuba::RDGTopology topo =
-        KATANA_CHECKED(edge_type_aware_topos_[i]->ToRDGTopology());
-    rdg_topos.emplace_back(std::move(topo));
+    switch (entry.kind) {
+    case EntryKind::kEdgeShuffleTopology:
+      rdg_topos.emplace_back(KATANA_CHECKED(
+          static_cast<const EdgeShuffleTopology*>(entry.topo.get())
+              ->ToRDGTopology()));
+      break;
+    case EntryKind::kShuffleTopology:
+      rdg_topos.emplace_back(KATANA_CHECKED(
+          static_cast<const ShuffleTopology*>(entry.topo.get())
+              ->ToRDGTopology()));
+      break;
+    case EntryKind::kEdgeTypeAwareTopology:
+      rdg_topos.emplace_back(KATANA_CHECKED(
+          static_cast<const EdgeTypeAwareTopology*>(entry.topo.get())
+              ->ToRDGTopology()));
+      break;
+    case EntryKind::kProjectedTopology:
+    case EntryKind::kLazyProjectedTopology:
+      // projected topologies have no storage format
+      break;
+    case EntryKind::kEdgeSourceIndex:
+      // cheaper to rebuild than to load
+      break;
+    }
   }
 
   return std::vector<tsuba::RDGTopology>(std::move(rdg_topos));
@@ -0,0 +1,104 @@
+#include "katana/HugePageMemoryPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "katana/PageAlloc.h"
+
+namespace {
+
+int64_t
+NumPages(int64_t size) {
+  auto page_size = static_cast<int64_t>(katana::allocSize());
+  return (size + page_size - 1) / page_size;
+}
+
+}  // namespace
+
+katana::HugePageMemoryPool*
+katana::HugePageMemoryPool::Get() {
+  static auto* pool = new HugePageMemoryPool();
+  return pool;
+}
+
+bool
+katana::HugePageMemoryPool::IsLarge(int64_t size) {
+  return size >= static_cast<int64_t>(allocSize());
+}
+
+void
+katana::HugePageMemoryPool::Account(int64_t large_delta) {
+  int64_t now = large_bytes_.fetch_add(large_delta) + large_delta;
+  now += arrow::default_memory_pool()->bytes_allocated();
+  int64_t prev = max_memory_.load(std::memory_order_relaxed);
+  while (prev < now && !max_memory_.compare_exchange_weak(
+                           prev, now, std::memory_order_relaxed)) {
+  }
+}
+
+arrow::Status
+katana::HugePageMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (!IsLarge(size)) {
+    ARROW_RETURN_NOT_OK(arrow::default_memory_pool()->Allocate(size, out));
+    Account(0);
+    return arrow::Status::OK();
+  }
+
+  int64_t num_pages = NumPages(size);
+  auto* ptr = static_cast<uint8_t*>(allocPages(num_pages, false));
+  if (!ptr) {
+    return arrow::Status::OutOfMemory("allocating ", size, " bytes");
+  }
+  Account(size);
+  *out = ptr;
+  return arrow::Status::OK();
+}
+
+arrow::Status
+katana::HugePageMemoryPool::Reallocate(
+    int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  if (!IsLarge(old_size) && !IsLarge(new_size)) {
+    ARROW_RETURN_NOT_OK(
+        arrow::default_memory_pool()->Reallocate(old_size, new_size, ptr));
+    Account(0);
+    return arrow::Status::OK();
+  }
+  if (IsLarge(old_size) && IsLarge(new_size) &&
+      NumPages(old_size) == NumPages(new_size)) {
+    Account(new_size - old_size);
+    return arrow::Status::OK();
+  }
+
+  uint8_t* moved = nullptr;
+  ARROW_RETURN_NOT_OK(Allocate(new_size, &moved));
+  std::memcpy(moved, *ptr, std::min(old_size, new_size));
+  Free(*ptr, old_size);
+  *ptr = moved;
+  return arrow::Status::OK();
+}
+
+void
+katana::HugePageMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  if (!IsLarge(size)) {
+    arrow::default_memory_pool()->Free(buffer, size);
+    return;
+  }
+  freePages(buffer, NumPages(size));
+  Account(-size);
+}
+
+int64_t
+katana::HugePageMemoryPool::bytes_allocated() const {
+  return large_bytes_allocated() +
+         arrow::default_memory_pool()->bytes_allocated();
+}
+
+int64_t
+katana::HugePageMemoryPool::max_memory() const {
+  return max_memory_.load(std::memory_order_relaxed);
+}
+
+std::string
+katana::HugePageMemoryPool::backend_name() const {
+  return "katana-hugepage";
+}
@@ -24,11 +24,13 @@
 
 #include "katana/Executor_OnEach.h"
 #include "katana/Mem.h"
+#include "katana/MemoryAccounting.h"
+#include "katana/PagePool.h"
 
 void
 katana::Prealloc(size_t pagesPerThread, size_t bytes) {
   size_t size =
-      (pagesPerThread * katana::activeThreads) + (bytes / allocSize());
+      (pagesPerThread * katana::getActiveThreads()) + (bytes / allocSize());
   // If the user requested a non-zero allocation, at the very least
   // allocate a page.
   if (size == 0 && bytes > 0) {
@@ -40,35 +42,60 @@ katana::Prealloc(size_t pagesPerThread, size_t bytes) {
 
 void
 katana::Prealloc(size_t pages) {
-  unsigned pagesPerThread =
-      (pages + katana::activeThreads - 1) / katana::activeThreads;
-  katana::GetThreadPool().run(katana::activeThreads, [=]() {
+  unsigned num_threads = katana::getActiveThreads();
+  unsigned pagesPerThread = (pages + num_threads - 1) / num_threads;
+  katana::GetThreadPool().run(num_threads, [=]() {
     katana::pagePoolPreAlloc(pagesPerThread);
   });
 }
 
-void
-katana::EnsurePreallocated(size_t pagesPerThread, size_t bytes) {
+static size_t
+NumPreallocPages(size_t pagesPerThread, size_t bytes) {
   size_t size =
-      (pagesPerThread * katana::activeThreads) + (bytes / allocSize());
+      (pagesPerThread * katana::getActiveThreads()) + (bytes / allocSize());
   // If the user requested a non-zero allocation, at the very least
   // allocate a page.
   if (size == 0 && bytes > 0) {
     size = 1;
   }
+  return size;
+}
 
-  katana::EnsurePreallocated(size);
+void
+katana::EnsurePreallocated(size_t pagesPerThread, size_t bytes) {
+  katana::EnsurePreallocated(NumPreallocPages(pagesPerThread, bytes));
 }
 
 void
 katana::EnsurePreallocated(size_t pages) {
-  unsigned pagesPerThread =
-      (pages + katana::activeThreads - 1) / katana::activeThreads;
-  katana::GetThreadPool().run(katana::activeThreads, [=]() {
+  unsigned num_threads = katana::getActiveThreads();
+  unsigned pagesPerThread = (pages + num_threads - 1) / num_threads;
+  katana::GetThreadPool().run(num_threads, [=]() {
     katana::pagePoolEnsurePreallocated(pagesPerThread);
   });
 }
 
+katana::Result<void>
+katana::TryEnsurePreallocated(size_t pagesPerThread, size_t bytes) {
+  return katana::TryEnsurePreallocated(
+      NumPreallocPages(pagesPerThread, bytes));
+}
+
+katana::Result<void>
+katana::TryEnsurePreallocated(size_t pages) {
+  unsigned num_threads = katana::getActiveThreads();
+  unsigned pagesPerThread = (pages + num_threads - 1) / num_threads;
+  uint64_t bytes =
+      katana::pagePoolNumMissing(num_threads, pagesPerThread) * allocSize();
+
+  // The page pool charges the pages as it allocates them
+  KATANA_CHECKED(katana::ReserveMemory(MemoryCategory::kWorklists, bytes));
+  katana::ReleaseMemory(MemoryCategory::kWorklists, bytes);
+
+  katana::EnsurePreallocated(pages);
+  return katana::ResultSuccess();
+}
+
 // Anchor the class
 katana::SystemHeap::SystemHeap() {
   KATANA_LOG_DEBUG_ASSERT(AllocSize == katana::allocSize());
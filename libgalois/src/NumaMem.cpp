@@ -22,6 +22,7 @@
 #include <cassert>
 
 #include "katana/PageAlloc.h"
+#include "katana/Result.h"
 #include "katana/ThreadPool.h"
 #include "katana/gIO.h"
 
@@ -142,9 +143,33 @@ largeFree(void* ptr, size_t bytes) {
 
 void
 katana::internal::largeFreer::operator()(void* ptr) const {
+  ReleaseMemory(category, bytes);
   largeFree(ptr, bytes);
 }
 
+static LAptr
+makeLAptr(void* data, size_t bytes) {
+  MemoryCategory category = CurrentMemoryCategory();
+  if (data)
+    ChargeMemory(category, bytes);
+  return LAptr{data, internal::largeFreer{bytes, category}};
+}
+
+// Reserve bytes, a multiple of allocSize(), against the current category and
+// only then allocate them with alloc
+template <typename Alloc>
+static katana::Result<LAptr>
+tryMakeLAptr(size_t bytes, const Alloc& alloc) {
+  MemoryCategory category = CurrentMemoryCategory();
+  KATANA_CHECKED(ReserveMemory(category, bytes));
+  void* data = alloc();
+  if (!data) {
+    ReleaseMemory(category, bytes);
+    bytes = 0;
+  }
+  return LAptr{data, internal::largeFreer{bytes, category}};
+}
+
 // round data to a multiple of mult
 static size_t
 roundup(size_t data, size_t mult) {
@@ -155,11 +180,8 @@ roundup(size_t data, size_t mult) {
   return data + (mult - rem);
 }
 
-LAptr
-katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
-
+static void*
+allocInterleaved(size_t bytes, unsigned numThreads) {
 #ifdef KATANA_USE_NUMA
   // We don't use numa_alloc_interleaved_subset because we really want huge
   // pages
@@ -174,7 +196,31 @@ katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
     // true = round robin paging
     pageIn(data, bytes, allocSize(), numThreads, true);
 
-  return LAptr{data, internal::largeFreer{bytes}};
+  return data;
+}
+
+static void*
+allocBlocked(size_t bytes, unsigned numThreads) {
+  // Get a non-prefaulted allocation
+  void* data = allocPages(bytes / allocSize(), false);
+  if (data)
+    // false = blocked paging
+    pageIn(data, bytes, allocSize(), numThreads, false);
+  return data;
+}
+
+LAptr
+katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
+  // round up to hugePageSize
+  bytes = roundup(bytes, allocSize());
+  return makeLAptr(allocInterleaved(bytes, numThreads), bytes);
+}
+
+katana::Result<LAptr>
+katana::tryLargeMallocInterleaved(size_t bytes, unsigned numThreads) {
+  bytes = roundup(bytes, allocSize());
+  return tryMakeLAptr(
+      bytes, [&]() { return allocInterleaved(bytes, numThreads); });
 }
 
 LAptr
@@ -182,8 +228,7 @@ katana::largeMallocLocal(size_t bytes) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
   // Get a prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), true), internal::largeFreer{bytes}};
+  return makeLAptr(allocPages(bytes / allocSize(), true), bytes);
 }
 
 LAptr
@@ -191,20 +236,21 @@ katana::largeMallocFloating(size_t bytes) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
   // Get a non-prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), false), internal::largeFreer{bytes}};
+  return makeLAptr(allocPages(bytes / allocSize(), false), bytes);
 }
 
 LAptr
 katana::largeMallocBlocked(size_t bytes, unsigned numThreads) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
-  // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
-  if (data)
-    // false = blocked paging
-    pageIn(data, bytes, allocSize(), numThreads, false);
-  return LAptr{data, internal::largeFreer{bytes}};
+  return makeLAptr(allocBlocked(bytes, numThreads), bytes);
+}
+
+katana::Result<LAptr>
+katana::tryLargeMallocBlocked(size_t bytes, unsigned numThreads) {
+  bytes = roundup(bytes, allocSize());
+  return tryMakeLAptr(
+      bytes, [&]() { return allocBlocked(bytes, numThreads); });
 }
 
 /**
@@ -235,7 +281,7 @@ katana::largeMallocSpecified(
     pageInSpecified(
         data, bytes, allocSize(), numThreads, threadRanges, elementSize);
 
-  return LAptr{data, internal::largeFreer{bytes}};
+  return makeLAptr(data, bytes);
 }
 // Explicit template declarations since the template is defined in the .h
 // file
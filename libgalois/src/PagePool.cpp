@@ -53,12 +53,24 @@ katana::pagePoolPreAlloc(unsigned num) {
 
 void
 katana::pagePoolEnsurePreallocated(unsigned num) {
-  auto tid = katana::ThreadPool::getTID();
+  auto tid = katana::ThreadPool::getPoolTID();
   while (PA->freeCount(tid) < num) {
     PA->pagePreAlloc();
   }
 }
 
+size_t
+katana::pagePoolNumMissing(unsigned num_threads, unsigned num) {
+  size_t missing = 0;
+  for (unsigned i = 0; i < num_threads; ++i) {
+    unsigned free = PA->freeCount(katana::ThreadPool::getPoolTID(i));
+    if (free < num) {
+      missing += num - free;
+    }
+  }
+  return missing;
+}
+
 void
 katana::pagePoolFree(void* ptr) {
   PA->pageFree(ptr);
@@ -8,12 +8,15 @@
 #include <vector>
 
 #include <arrow/array.h>
+#include <arrow/compute/api.h>
 
 #include "katana/ArrowInterchange.h"
+#include "katana/EdgeShuffle.h"
 #include "katana/GraphTopology.h"
 #include "katana/Iterators.h"
 #include "katana/Logging.h"
 #include "katana/Loops.h"
+#include "katana/MemoryAccounting.h"
 #include "katana/NUMAArray.h"
 #include "katana/PerThreadStorage.h"
 #include "katana/Platform.h"
@@ -141,6 +144,7 @@ MakeDefaultEntityTypeIDArray(size_t vec_sz) {
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 katana::PropertyGraph::Make(
     std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg) {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kTopology);
   // find & map the default csr topology
   tsuba::RDGTopology shadow_csr = tsuba::RDGTopology::MakeShadowCSR();
   tsuba::RDGTopology* csr = KATANA_CHECKED_CONTEXT(
@@ -878,6 +882,7 @@ katana::PropertyGraph::EnsureEdgePropertyLoaded(const std::string& name) {
 // Build an index over nodes.
 katana::Result<void>
 katana::PropertyGraph::MakeNodeIndex(const std::string& column_name) {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kIndexes);
   for (const auto& existing_index : node_indexes_) {
     if (existing_index->column_name() == column_name) {
       return KATANA_ERROR(
@@ -918,6 +923,7 @@ katana::PropertyGraph::DeleteNodeIndex(const std::string& column_name) {
 // Build an index over edges.
 katana::Result<void>
 katana::PropertyGraph::MakeEdgeIndex(const std::string& column_name) {
+  katana::MemoryCategoryScope memory_scope(katana::MemoryCategory::kIndexes);
   for (const auto& existing_index : edge_indexes_) {
     if (existing_index->column_name() == column_name) {
       return KATANA_ERROR(
@@ -1105,82 +1111,62 @@ katana::SortNodesByDegree(katana::PropertyGraph* pg) {
 }
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
-katana::CreateSymmetricGraph(katana::PropertyGraph* pg) {
+katana::CreateSymmetricGraph(
+    katana::PropertyGraph* pg, const EdgeShuffleOptions& opts) {
   const GraphTopology& topology = pg->topology();
   if (topology.num_nodes() == 0) {
     return std::make_unique<PropertyGraph>();
   }
 
-  // New symmetric graph topology
-  katana::NUMAArray<uint64_t> out_indices;
-  katana::NUMAArray<uint32_t> out_dests;
+  ShuffledEdges sym = SymmetrizeEdges(topology, opts);
+  uint64_t num_edges = sym.dests.size();
 
-  out_indices.allocateInterleaved(topology.num_nodes());
-  // Store the out-degree of nodes from original graph
-  katana::do_all(katana::iterate(topology.all_nodes()), [&](auto n) {
-    auto edges = topology.edges(n);
-    out_indices[n] = (*edges.end() - *edges.begin());
-  });
+  PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::copy(
+      pg->node_type_data(), pg->node_type_data() + topology.num_nodes(),
+      node_type_ids.begin());
 
+  PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(num_edges);
   katana::do_all(
-      katana::iterate(topology.all_nodes()),
-      [&](auto n) {
-        // update the out_indices for the symmetric topology
-        for (auto e : topology.edges(n)) {
-          auto dest = topology.edge_dest(e);
-          // Do not add reverse edge for self-loops
-          if (n != dest) {
-            __sync_fetch_and_add(&(out_indices[dest]), 1);
-          }
-        }
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        edge_type_ids[e] = pg->GetTypeOfEdge(sym.edge_prop_indices[e]);
       },
-      katana::steal());
-
-  // Compute prefix sum
-  katana::ParallelSTL::partial_sum(
-      out_indices.begin(), out_indices.end(), out_indices.begin());
+      katana::no_stats());
 
-  uint64_t num_nodes_symmetric = topology.num_nodes();
-  uint64_t num_edges_symmetric = out_indices[num_nodes_symmetric - 1];
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> node_columns;
+  for (int32_t i = 0; i < pg->GetNumNodeProperties(); ++i) {
+    node_columns.emplace_back(pg->GetNodeProperty(i));
+  }
 
-  katana::NUMAArray<uint64_t> out_dests_offset;
-  out_dests_offset.allocateInterleaved(topology.num_nodes());
-  // Temp NUMAArray for computing new destination positions
-  out_dests_offset[0] = 0;
-  katana::do_all(
-      katana::iterate(uint64_t{1}, topology.num_nodes()),
-      [&](uint64_t n) { out_dests_offset[n] = out_indices[n - 1]; },
-      katana::no_stats());
+  // Both edges made from an input edge get its properties
+  std::shared_ptr<arrow::Array> index_array =
+      ProjectAsArrowArray(sym.edge_prop_indices.data(), num_edges);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> edge_columns;
+  for (int32_t i = 0; i < pg->GetNumEdgeProperties(); ++i) {
+    arrow::Datum taken = KATANA_CHECKED_CONTEXT(
+        arrow::compute::Take(pg->GetEdgeProperty(i), index_array),
+        "gathering edge property {}", pg->GetEdgePropertyName(i));
+    edge_columns.emplace_back(taken.chunked_array());
+  }
 
-  out_dests.allocateInterleaved(num_edges_symmetric);
-  // Update graph topology with the original edges + reverse edges
-  katana::do_all(
-      katana::iterate(topology.all_nodes()),
-      [&](auto src) {
-        // get all outgoing edges (excluding self edges) of a particular
-        // node and add reverse edges.
-        for (GraphTopology::Edge e : topology.edges(src)) {
-          // e = start index into edge array for a particular node
-          // destination node
-          auto dest = topology.edge_dest(e);
-
-          // Add original edge
-          auto e_new_src = __sync_fetch_and_add(&(out_dests_offset[src]), 1);
-          out_dests[e_new_src] = dest;
-
-          // Do not add reverse edge for self-loops
-          if (dest != src) {
-            // Add reverse edge
-            auto e_new_dst = __sync_fetch_and_add(&(out_dests_offset[dest]), 1);
-            out_dests[e_new_dst] = src;
-            // TODO(gill) copy edge data to "new" array
-          }
-        }
-      },
-      katana::no_stats());
+  GraphTopology sym_topo(std::move(sym.adj_indices), std::move(sym.dests));
+  auto sym_graph = KATANA_CHECKED(katana::PropertyGraph::Make(
+      std::move(sym_topo), std::move(node_type_ids), std::move(edge_type_ids),
+      EntityTypeManager{pg->GetNodeTypeManager()},
+      EntityTypeManager{pg->GetEdgeTypeManager()}));
 
-  GraphTopology sym_topo(std::move(out_indices), std::move(out_dests));
-  return katana::PropertyGraph::Make(std::move(sym_topo));
+  if (!node_columns.empty()) {
+    KATANA_CHECKED(sym_graph->AddNodeProperties(
+        arrow::Table::Make(pg->loaded_node_schema(), node_columns)));
+  }
+  if (!edge_columns.empty()) {
+    KATANA_CHECKED(sym_graph->AddEdgeProperties(
+        arrow::Table::Make(pg->loaded_edge_schema(), edge_columns)));
+  }
+  return MakeResult(std::move(sym_graph));
 }
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
@@ -1189,64 +1175,9 @@ katana::CreateTransposeGraphTopology(const GraphTopology& topology) {
     return std::make_unique<PropertyGraph>();
   }
 
-  katana::NUMAArray<GraphTopology::Edge> out_indices;
-  katana::NUMAArray<GraphTopology::Node> out_dests;
-
-  out_indices.allocateInterleaved(topology.num_nodes());
-  out_dests.allocateInterleaved(topology.num_edges());
-
-  // Initialize the new topology indices
-  katana::do_all(
-      katana::iterate(uint64_t{0}, topology.num_nodes()),
-      [&](uint64_t n) { out_indices[n] = uint64_t{0}; }, katana::no_stats());
-
-  // Keep a copy of old destinaton ids and compute number of
-  // in-coming edges for the new prefix sum of out_indices.
-  katana::do_all(
-      katana::iterate(topology.all_edges()),
-      [&](auto e) {
-        // Counting outgoing edges in the tranpose graph by
-        // counting incoming edges in the original graph
-        auto dest = topology.edge_dest(e);
-        __sync_add_and_fetch(&(out_indices[dest]), 1);
-      },
-      katana::no_stats());
-
-  // Prefix sum calculation of the edge index array
-  katana::ParallelSTL::partial_sum(
-      out_indices.begin(), out_indices.end(), out_indices.begin());
-
-  katana::NUMAArray<uint64_t> out_dests_offset;
-  out_dests_offset.allocateInterleaved(topology.num_nodes());
-
-  // temporary buffer for storing the starting point of each node's transpose
-  // adjacency
-  out_dests_offset[0] = 0;
-  katana::do_all(
-      katana::iterate(uint64_t{1}, topology.num_nodes()),
-      [&](uint64_t n) { out_dests_offset[n] = out_indices[n - 1]; },
-      katana::no_stats());
-
-  // Update out_dests with the new destination ids
-  // of the transposed graphs
-  katana::do_all(
-      katana::iterate(topology.all_nodes()),
-      [&](auto src) {
-        // get all outgoing edges of a particular
-        // node and reverse the edges.
-        for (GraphTopology::Edge e : topology.edges(src)) {
-          // e = start index into edge array for a particular node
-          // Destination node
-          auto dest = topology.edge_dest(e);
-          // Location to save edge
-          auto e_new = __sync_fetch_and_add(&(out_dests_offset[dest]), 1);
-          // Save src as destination
-          out_dests[e_new] = src;
-        }
-      },
-      katana::no_stats());
-
-  GraphTopology transpose_topo{std::move(out_indices), std::move(out_dests)};
+  ShuffledEdges transpose = TransposeEdges(topology);
+  GraphTopology transpose_topo{
+      std::move(transpose.adj_indices), std::move(transpose.dests)};
   return katana::PropertyGraph::Make(std::move(transpose_topo));
 }
 
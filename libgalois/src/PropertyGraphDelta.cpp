@@ -0,0 +1,488 @@
+#include "katana/PropertyGraphDelta.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <arrow/compute/api.h>
+
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+using Node = katana::PropertyGraphDelta::Node;
+using Edge = katana::PropertyGraphDelta::Edge;
+
+/// Gather the rows named by indices from every column of schema, where the
+/// rows of a column are those of base_columns followed by the rows of each
+/// batch in order. Columns missing from a batch are null for its rows.
+/// Columns are independent, so they are gathered in parallel, and each result
+/// is a single chunk.
+template <typename IndexType>
+katana::Result<std::shared_ptr<arrow::Table>>
+GatherProperties(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& base_columns,
+    const std::vector<std::shared_ptr<arrow::Table>>& batches,
+    const std::vector<IndexType>& indices) {
+  std::shared_ptr<arrow::Array> index_array =
+      katana::ProjectAsArrowArray(indices.data(), indices.size());
+
+  int num_columns = schema->num_fields();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(num_columns);
+  std::vector<arrow::Status> statuses(num_columns);
+
+  katana::do_all(
+      katana::iterate(0, num_columns),
+      [&](int i) {
+        const std::shared_ptr<arrow::Field>& field = schema->field(i);
+        arrow::ArrayVector chunks = base_columns[i]->chunks();
+        for (const auto& batch : batches) {
+          auto column = batch->GetColumnByName(field->name());
+          if (column) {
+            chunks.insert(
+                chunks.end(), column->chunks().begin(), column->chunks().end());
+            continue;
+          }
+          auto nulls = arrow::MakeArrayOfNull(field->type(), batch->num_rows());
+          if (!nulls.ok()) {
+            statuses[i] = nulls.status();
+            return;
+          }
+          chunks.emplace_back(nulls.ValueOrDie());
+        }
+
+        auto concatenated = arrow::Concatenate(chunks);
+        if (!concatenated.ok()) {
+          statuses[i] = concatenated.status();
+          return;
+        }
+        auto taken =
+            arrow::compute::Take(concatenated.ValueOrDie(), index_array);
+        if (!taken.ok()) {
+          statuses[i] = taken.status();
+          return;
+        }
+        columns[i] = std::make_shared<arrow::ChunkedArray>(
+            taken.ValueOrDie().make_array());
+      },
+      katana::no_stats(), katana::loopname("GatherProperties"));
+
+  for (int i = 0; i < num_columns; ++i) {
+    if (!statuses[i].ok()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "gathering property {}: {}",
+          schema->field(i)->name(), statuses[i]);
+    }
+  }
+
+  return arrow::Table::Make(schema, columns);
+}
+
+/// \returns a table with the columns of schema and no rows
+katana::Result<std::shared_ptr<arrow::Table>>
+EmptyTable(const std::shared_ptr<arrow::Schema>& schema) {
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (const auto& field : schema->fields()) {
+    auto empty = arrow::MakeArrayOfNull(field->type(), 0);
+    if (!empty.ok()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "making empty property {}: {}",
+          field->name(), empty.status());
+    }
+    columns.emplace_back(empty.ValueOrDie());
+  }
+  return arrow::Table::Make(schema, columns, 0);
+}
+
+}  // namespace
+
+katana::PropertyGraphDelta::PropertyGraphDelta(PropertyGraph* base)
+    : base_(base) {
+  Reset();
+}
+
+void
+katana::PropertyGraphDelta::Reset() {
+  num_base_nodes_ = base_->num_nodes();
+  num_base_edges_ = base_->num_edges();
+
+  num_added_nodes_ = 0;
+  added_node_types_.clear();
+  added_node_properties_.clear();
+
+  added_edge_dests_.clear();
+  added_edge_types_.clear();
+  added_edge_properties_.clear();
+  added_out_edges_.clear();
+  added_out_edges_.resize(num_base_nodes_);
+
+  removed_nodes_.resize(num_base_nodes_);
+  removed_nodes_.reset();
+  removed_edges_.resize(num_base_edges_);
+  removed_edges_.reset();
+  num_removed_nodes_ = 0;
+  num_removed_edges_ = 0;
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::AppendProperties(
+    const std::shared_ptr<arrow::Table>& properties,
+    const std::shared_ptr<arrow::Schema>& schema, uint64_t num_rows,
+    PropertyBatches* batches) {
+  if (!properties) {
+    batches->emplace_back(arrow::Table::Make(
+        arrow::schema({}), std::vector<std::shared_ptr<arrow::ChunkedArray>>{},
+        num_rows));
+    return ResultSuccess();
+  }
+
+  if (static_cast<uint64_t>(properties->num_rows()) != num_rows) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected {} property rows, got {}",
+        num_rows, properties->num_rows());
+  }
+  for (const auto& field : properties->schema()->fields()) {
+    auto expected = schema->GetFieldByName(field->name());
+    if (!expected) {
+      return KATANA_ERROR(
+          ErrorCode::PropertyNotFound, "property does not exist: {}",
+          field->name());
+    }
+    if (!expected->type()->Equals(field->type())) {
+      return KATANA_ERROR(
+          ErrorCode::TypeError, "property {} has type {}, expected {}",
+          field->name(), field->type()->ToString(),
+          expected->type()->ToString());
+    }
+  }
+  batches->emplace_back(properties);
+  return ResultSuccess();
+}
+
+katana::Result<katana::PropertyGraphDelta::Node>
+katana::PropertyGraphDelta::AddNodes(
+    uint64_t count, const std::shared_ptr<arrow::Table>& properties,
+    const std::vector<EntityTypeID>& types) {
+  if (!types.empty() && types.size() != count) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected {} node types, got {}", count,
+        types.size());
+  }
+  if (num_nodes() + count > std::numeric_limits<Node>::max()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "too many nodes: {} + {}", num_nodes(),
+        count);
+  }
+  KATANA_CHECKED(AppendProperties(
+      properties, base_->full_node_schema(), count, &added_node_properties_));
+
+  Node first = num_nodes();
+  num_added_nodes_ += count;
+  if (types.empty()) {
+    added_node_types_.resize(num_added_nodes_, kUnknownEntityType);
+  } else {
+    added_node_types_.insert(
+        added_node_types_.end(), types.begin(), types.end());
+  }
+  added_out_edges_.resize(num_nodes());
+  removed_nodes_.resize(num_nodes());
+  return first;
+}
+
+katana::Result<katana::PropertyGraphDelta::Edge>
+katana::PropertyGraphDelta::AddEdges(
+    const std::vector<Node>& srcs, const std::vector<Node>& dests,
+    const std::shared_ptr<arrow::Table>& properties,
+    const std::vector<EntityTypeID>& types) {
+  uint64_t count = srcs.size();
+  if (dests.size() != count) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "got {} sources but {} destinations",
+        count, dests.size());
+  }
+  if (!types.empty() && types.size() != count) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected {} edge types, got {}", count,
+        types.size());
+  }
+
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, count),
+      [&](uint64_t i) {
+        if (srcs[i] >= num_nodes() || dests[i] >= num_nodes() ||
+            removed_nodes_.test(srcs[i]) || removed_nodes_.test(dests[i])) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "edge endpoints must be existing nodes below {}", num_nodes());
+  }
+  KATANA_CHECKED(AppendProperties(
+      properties, base_->full_edge_schema(), count, &added_edge_properties_));
+
+  Edge first = num_base_edges_ + added_edge_dests_.size();
+  added_edge_dests_.insert(added_edge_dests_.end(), dests.begin(), dests.end());
+  if (types.empty()) {
+    added_edge_types_.resize(added_edge_dests_.size(), kUnknownEntityType);
+  } else {
+    added_edge_types_.insert(
+        added_edge_types_.end(), types.begin(), types.end());
+  }
+  removed_edges_.resize(num_base_edges_ + added_edge_dests_.size());
+
+  // Sort the batch by source so that each source's block is appended to by
+  // exactly one iteration; ties keep insertion order.
+  std::vector<uint64_t> order(count);
+  std::iota(order.begin(), order.end(), uint64_t{0});
+  katana::ParallelSTL::sort(
+      order.begin(), order.end(), [&](uint64_t a, uint64_t b) {
+        return srcs[a] < srcs[b] || (srcs[a] == srcs[b] && a < b);
+      });
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, count),
+      [&](uint64_t i) {
+        Node src = srcs[order[i]];
+        if (i > 0 && srcs[order[i - 1]] == src) {
+          return;
+        }
+        std::vector<Edge>& block = added_out_edges_[src];
+        for (uint64_t j = i; j < count && srcs[order[j]] == src; ++j) {
+          block.push_back(first + order[j]);
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("AppendEdgeBlocks"));
+
+  return first;
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::RemoveEdges(const std::vector<Edge>& edges) {
+  uint64_t edge_id_end = num_base_edges_ + added_edge_dests_.size();
+  for (Edge e : edges) {
+    if (e >= edge_id_end) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "edge {} out of range; graph has {} edges", e, edge_id_end);
+    }
+  }
+
+  katana::GAccumulator<uint64_t> num_removed;
+  katana::do_all(
+      katana::iterate(edges),
+      [&](Edge e) {
+        if (!removed_edges_.set(e)) {
+          num_removed += 1;
+        }
+      },
+      katana::no_stats());
+  num_removed_edges_ += num_removed.reduce();
+  return ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::RemoveNodes(const std::vector<Node>& nodes) {
+  for (Node n : nodes) {
+    if (n >= num_nodes()) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "node {} out of range; graph has {} nodes", n, num_nodes());
+    }
+  }
+
+  katana::GAccumulator<uint64_t> num_removed_nodes;
+  katana::do_all(
+      katana::iterate(nodes),
+      [&](Node n) {
+        if (!removed_nodes_.set(n)) {
+          num_removed_nodes += 1;
+        }
+      },
+      katana::no_stats());
+  num_removed_nodes_ += num_removed_nodes.reduce();
+
+  // There is no index of incoming edges, so look at every live edge. Each
+  // iteration only marks out-edges of its own node.
+  katana::GAccumulator<uint64_t> num_removed_edges;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes()),
+      [&](uint64_t n) {
+        bool source_removed = removed_nodes_.test(n);
+        for (Edge e : edges(n)) {
+          if ((source_removed || removed_nodes_.test(edge_dest(e))) &&
+              !removed_edges_.set(e)) {
+            num_removed_edges += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("RemoveIncidentEdges"));
+  num_removed_edges_ += num_removed_edges.reduce();
+  return ResultSuccess();
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::PropertyGraphDelta::Compact() const {
+  uint64_t num_new_nodes = num_live_nodes();
+  if (num_new_nodes == 0) {
+    // Nothing to renumber, but the types and property columns remain.
+    std::unique_ptr<PropertyGraph> empty = KATANA_CHECKED(PropertyGraph::Make(
+        GraphTopology{}, PropertyGraph::EntityTypeIDArray{},
+        PropertyGraph::EntityTypeIDArray{},
+        EntityTypeManager{base_->GetNodeTypeManager()},
+        EntityTypeManager{base_->GetEdgeTypeManager()}));
+    KATANA_CHECKED(empty->AddNodeProperties(
+        KATANA_CHECKED(EmptyTable(base_->full_node_schema()))));
+    KATANA_CHECKED(empty->AddEdgeProperties(
+        KATANA_CHECKED(EmptyTable(base_->full_edge_schema()))));
+    return std::unique_ptr<PropertyGraph>(std::move(empty));
+  }
+
+  // Renumber the surviving nodes densely; old_to_new holds one past the new
+  // ID of each surviving node.
+  katana::NUMAArray<Node> old_to_new;
+  old_to_new.allocateInterleaved(num_nodes());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes()),
+      [&](uint64_t n) { old_to_new[n] = removed_nodes_.test(n) ? 0 : 1; },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      old_to_new.begin(), old_to_new.end(), old_to_new.begin());
+
+  std::vector<Node> new_to_old(num_new_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes()),
+      [&](uint64_t n) {
+        if (!removed_nodes_.test(n)) {
+          new_to_old[old_to_new[n] - 1] = n;
+        }
+      },
+      katana::no_stats());
+
+  katana::NUMAArray<Edge> out_indices;
+  out_indices.allocateInterleaved(num_new_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_new_nodes),
+      [&](uint64_t n) { out_indices[n] = degree(new_to_old[n]); },
+      katana::steal(), katana::no_stats(), katana::loopname("CountEdges"));
+  katana::ParallelSTL::partial_sum(
+      out_indices.begin(), out_indices.end(), out_indices.begin());
+  uint64_t num_new_edges = out_indices[num_new_nodes - 1];
+  KATANA_LOG_DEBUG_ASSERT(num_new_edges == num_edges());
+
+  // Destinations, plus the old ID of every edge so that types and properties
+  // can be gathered afterwards.
+  katana::NUMAArray<Node> out_dests;
+  out_dests.allocateInterleaved(num_new_edges);
+  std::vector<Edge> new_to_old_edges(num_new_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_new_nodes),
+      [&](uint64_t n) {
+        uint64_t offset = n == 0 ? 0 : out_indices[n - 1];
+        for (Edge e : edges(new_to_old[n])) {
+          out_dests[offset] = old_to_new[edge_dest(e)] - 1;
+          new_to_old_edges[offset] = e;
+          offset++;
+        }
+        KATANA_LOG_DEBUG_ASSERT(offset == out_indices[n]);
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("FillEdges"));
+
+  PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(num_new_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_new_nodes),
+      [&](uint64_t n) { node_type_ids[n] = GetTypeOfNode(new_to_old[n]); },
+      katana::no_stats());
+
+  PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(num_new_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_new_edges),
+      [&](uint64_t e) {
+        edge_type_ids[e] = GetTypeOfEdge(new_to_old_edges[e]);
+      },
+      katana::no_stats());
+
+  GraphTopology topology{std::move(out_indices), std::move(out_dests)};
+  std::unique_ptr<PropertyGraph> compacted =
+      KATANA_CHECKED(PropertyGraph::Make(
+          std::move(topology), std::move(node_type_ids),
+          std::move(edge_type_ids),
+          EntityTypeManager{base_->GetNodeTypeManager()},
+          EntityTypeManager{base_->GetEdgeTypeManager()}));
+
+  // Properties that are not loaded would be lost, so load them all.
+  for (const auto& name : base_->full_node_schema()->field_names()) {
+    KATANA_CHECKED_CONTEXT(
+        base_->EnsureNodePropertyLoaded(name), "loading property {}", name);
+  }
+  for (const auto& name : base_->full_edge_schema()->field_names()) {
+    KATANA_CHECKED_CONTEXT(
+        base_->EnsureEdgePropertyLoaded(name), "loading property {}", name);
+  }
+
+  if (base_->GetNumNodeProperties() > 0) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> base_columns;
+    for (int i = 0; i < base_->GetNumNodeProperties(); ++i) {
+      base_columns.emplace_back(base_->GetNodeProperty(i));
+    }
+    auto node_props = KATANA_CHECKED(GatherProperties(
+        base_->loaded_node_schema(), base_columns, added_node_properties_,
+        new_to_old));
+    KATANA_CHECKED(compacted->AddNodeProperties(node_props));
+  }
+  if (base_->GetNumEdgeProperties() > 0) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> base_columns;
+    for (int i = 0; i < base_->GetNumEdgeProperties(); ++i) {
+      base_columns.emplace_back(base_->GetEdgeProperty(i));
+    }
+    auto edge_props = KATANA_CHECKED(GatherProperties(
+        base_->loaded_edge_schema(), base_columns, added_edge_properties_,
+        new_to_old_edges));
+    KATANA_CHECKED(compacted->AddEdgeProperties(edge_props));
+  }
+
+  return std::unique_ptr<PropertyGraph>(std::move(compacted));
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::Commit(const std::string& command_line) {
+  std::unique_ptr<PropertyGraph> compacted = KATANA_CHECKED(Compact());
+
+  // Build everything on the compacted graph first so that base_ is left as
+  // it was if any of it fails.
+  for (const auto& index : base_->node_indexes_) {
+    KATANA_CHECKED(compacted->MakeNodeIndex(index->column_name()));
+  }
+  for (const auto& index : base_->edge_indexes_) {
+    KATANA_CHECKED(compacted->MakeEdgeIndex(index->column_name()));
+  }
+
+  // The storage of the old topologies and type arrays is stale. Releasing it
+  // does not touch the graph in memory, which stays whole if this fails.
+  KATANA_CHECKED(base_->rdg_.DropAllTopologies());
+  KATANA_CHECKED(base_->rdg_.UnbindNodeEntityTypeIDArrayFileStorage());
+  KATANA_CHECKED(base_->rdg_.UnbindEdgeEntityTypeIDArrayFileStorage());
+
+  // Nothing below can fail.
+  base_->pg_view_cache_.Clear();
+  base_->topology_ = std::move(compacted->topology_);
+  base_->node_entity_type_ids_ = std::move(compacted->node_entity_type_ids_);
+  base_->edge_entity_type_ids_ = std::move(compacted->edge_entity_type_ids_);
+  base_->rdg_.TakeProperties(&compacted->rdg_);
+  base_->node_indexes_ = std::move(compacted->node_indexes_);
+  base_->edge_indexes_ = std::move(compacted->edge_indexes_);
+
+  Reset();
+  return base_->Commit(command_line);
+}
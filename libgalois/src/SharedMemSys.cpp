@@ -20,7 +20,10 @@
 #include "katana/SharedMemSys.h"
 
 #include "katana/CommBackend.h"
+#include "katana/Env.h"
+#include "katana/HugePageMemoryPool.h"
 #include "katana/Logging.h"
+#include "katana/MemoryAccounting.h"
 #include "katana/Plugin.h"
 #include "katana/SharedMem.h"
 #include "katana/Statistics.h"
@@ -32,6 +35,22 @@ namespace {
 
 katana::NullCommBackend comm_backend;
 
+void
+ReportMemoryStats() {
+  for (size_t i = 0; i < katana::kNumMemoryCategories; ++i) {
+    auto category = static_cast<katana::MemoryCategory>(i);
+    std::string name = katana::MemoryCategoryName(category);
+    katana::ReportStatSingle(
+        "MemoryAccounting", name + "Bytes", katana::GetMemoryUsed(category));
+    katana::ReportStatSingle(
+        "MemoryAccounting", name + "PeakBytes",
+        katana::GetPeakMemoryUsed(category));
+  }
+  katana::ReportStatSingle(
+      "MemoryAccounting", "HugePageBytes",
+      katana::HugePageMemoryPool::Get()->large_bytes_allocated());
+}
+
 }  // namespace
 
 struct katana::SharedMemSys::Impl {
@@ -48,10 +67,18 @@ katana::SharedMemSys::SharedMemSys(std::unique_ptr<ProgressTracer> tracer)
   katana::ProgressTracer::Set(std::move(tracer));
 
   katana::internal::setSysStatManager(&impl_->stat_manager);
+
+  bool use_default_pool = false;
+  katana::GetEnv("KATANA_USE_ARROW_DEFAULT_POOL", &use_default_pool);
+  if (!use_default_pool) {
+    katana::SetArrowBackingMemoryPool(katana::HugePageMemoryPool::Get());
+  }
 }
 
 katana::SharedMemSys::~SharedMemSys() {
+  ReportMemoryStats();
   katana::PrintStats();
+  katana::SetArrowBackingMemoryPool(nullptr);
   katana::internal::setSysStatManager(nullptr);
 
   if (auto fini_good = tsuba::Fini(); !fini_good) {
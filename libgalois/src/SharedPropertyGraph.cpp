@@ -0,0 +1,291 @@
+#include "katana/SharedPropertyGraph.h"
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <nlohmann/json.hpp>
+
+#include "katana/EntityTypeManager.h"
+#include "katana/ErrorCode.h"
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/NUMAArray.h"
+
+namespace {
+
+constexpr uint64_t kSharedGraphVersion = 1;
+constexpr uint64_t kSectionAlignment = 64;
+
+enum Section {
+  kAdjIndices,
+  kDests,
+  kNodeTypeIDs,
+  kEdgeTypeIDs,
+  kNodeTypeManager,
+  kEdgeTypeManager,
+  kNodeProperties,
+  kEdgeProperties,
+  kNumSections,
+};
+
+/// The start of the segment; sections follow at offsets aligned to
+/// kSectionAlignment
+struct SharedGraphHeader {
+  uint64_t version;
+  uint64_t num_nodes;
+  uint64_t num_edges;
+  uint64_t offsets[kNumSections];
+  uint64_t sizes[kNumSections];
+};
+
+/// The parts of an EntityTypeManager needed to rebuild it
+struct SharedTypeManager {
+  katana::EntityTypeIDToAtomicTypeNameMap names;
+  std::vector<std::vector<katana::EntityTypeID>> atomic_ids;
+};
+
+void
+to_json(nlohmann::json& j, const SharedTypeManager& manager) {
+  j = nlohmann::json{
+      {"names", manager.names},
+      {"atomic_ids", manager.atomic_ids},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, SharedTypeManager& manager) {
+  j.at("names").get_to(manager.names);
+  j.at("atomic_ids").get_to(manager.atomic_ids);
+}
+
+katana::Result<std::string>
+SerializeTypeManager(const katana::EntityTypeManager& manager) {
+  SharedTypeManager shared{manager.GetEntityTypeIDToAtomicTypeNameMap(), {}};
+  for (const auto& set : manager.GetEntityTypeIDToAtomicEntityTypeIDs()) {
+    auto& ids = shared.atomic_ids.emplace_back();
+    for (size_t i = 0; i < set.size(); ++i) {
+      if (set.test(i)) {
+        ids.emplace_back(katana::EntityTypeID(i));
+      }
+    }
+  }
+  return katana::JsonDump(shared);
+}
+
+katana::Result<katana::EntityTypeManager>
+DeserializeTypeManager(std::string_view json) {
+  SharedTypeManager shared =
+      KATANA_CHECKED(katana::JsonParse<SharedTypeManager>(json));
+
+  size_t num_types = shared.atomic_ids.size();
+  katana::EntityTypeIDToSetOfEntityTypeIDsMap sets(num_types);
+  for (size_t i = 0; i < num_types; ++i) {
+    sets[i].resize(num_types);
+    for (katana::EntityTypeID id : shared.atomic_ids[i]) {
+      if (id >= num_types) {
+        return KATANA_ERROR(
+            katana::ErrorCode::InvalidArgument,
+            "atomic type {} of type {} out of range", id, i);
+      }
+      sets[i].set(id);
+    }
+  }
+  return katana::EntityTypeManager(std::move(shared.names), std::move(sets));
+}
+
+/// Write the loaded properties as an Arrow IPC stream
+katana::Result<std::shared_ptr<arrow::Buffer>>
+SerializeProperties(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& columns) {
+  if (columns.empty()) {
+    return std::make_shared<arrow::Buffer>(nullptr, 0);
+  }
+  std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema, columns);
+  auto sink = KATANA_CHECKED(arrow::io::BufferOutputStream::Create());
+  auto writer =
+      KATANA_CHECKED(arrow::ipc::MakeStreamWriter(sink.get(), schema));
+  KATANA_CHECKED(writer->WriteTable(*table));
+  KATANA_CHECKED(writer->Close());
+  return KATANA_CHECKED(sink->Finish());
+}
+
+/// A slice of a segment that keeps the segment mapped, so that property
+/// arrays read from it stay valid after the SharedPropertyGraph is gone
+class SharedMemoryBuffer : public arrow::Buffer {
+public:
+  SharedMemoryBuffer(
+      std::shared_ptr<tsuba::SharedMemory> segment, uint64_t offset,
+      uint64_t size)
+      : arrow::Buffer(segment->data() + offset, size),
+        segment_(std::move(segment)) {}
+
+private:
+  std::shared_ptr<tsuba::SharedMemory> segment_;
+};
+
+/// Read the properties in an Arrow IPC stream without copying them
+katana::Result<std::shared_ptr<arrow::Table>>
+DeserializeProperties(
+    const std::shared_ptr<tsuba::SharedMemory>& segment, uint64_t offset,
+    uint64_t size) {
+  auto buffer = std::make_shared<SharedMemoryBuffer>(segment, offset, size);
+  auto reader = KATANA_CHECKED(arrow::ipc::RecordBatchStreamReader::Open(
+      std::make_shared<arrow::io::BufferReader>(buffer)));
+  return KATANA_CHECKED(arrow::Table::FromRecordBatchReader(reader.get()));
+}
+
+uint64_t
+AlignUp(uint64_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+}  // namespace
+
+katana::SharedPropertyGraph::~SharedPropertyGraph() {
+  graph_.reset();
+  if (is_publisher_) {
+    if (auto res = tsuba::SharedMemory::Unlink(segment_->name()); !res) {
+      KATANA_LOG_ERROR("Unlink: {}", res.error());
+    }
+  }
+}
+
+katana::Result<std::unique_ptr<katana::SharedPropertyGraph>>
+katana::SharedPropertyGraph::Publish(
+    const PropertyGraph& pg, const std::string& name) {
+  std::string node_types =
+      KATANA_CHECKED(SerializeTypeManager(pg.GetNodeTypeManager()));
+  std::string edge_types =
+      KATANA_CHECKED(SerializeTypeManager(pg.GetEdgeTypeManager()));
+
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> node_columns;
+  for (int i = 0, n = pg.loaded_node_schema()->num_fields(); i < n; ++i) {
+    node_columns.emplace_back(pg.GetNodeProperty(i));
+  }
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> edge_columns;
+  for (int i = 0, n = pg.loaded_edge_schema()->num_fields(); i < n; ++i) {
+    edge_columns.emplace_back(pg.GetEdgeProperty(i));
+  }
+  std::shared_ptr<arrow::Buffer> node_props = KATANA_CHECKED(
+      SerializeProperties(pg.loaded_node_schema(), node_columns));
+  std::shared_ptr<arrow::Buffer> edge_props = KATANA_CHECKED(
+      SerializeProperties(pg.loaded_edge_schema(), edge_columns));
+
+  const void* sources[kNumSections] = {
+      pg.topology().adj_data(), pg.topology().dest_data(),
+      pg.node_type_data(),      pg.edge_type_data(),
+      node_types.data(),        edge_types.data(),
+      node_props->data(),       edge_props->data(),
+  };
+
+  SharedGraphHeader header{};
+  header.version = kSharedGraphVersion;
+  header.num_nodes = pg.num_nodes();
+  header.num_edges = pg.num_edges();
+  header.sizes[kAdjIndices] = pg.num_nodes() * sizeof(GraphTopology::Edge);
+  header.sizes[kDests] = pg.num_edges() * sizeof(GraphTopology::Node);
+  header.sizes[kNodeTypeIDs] =
+      pg.node_entity_type_ids_size() * sizeof(EntityTypeID);
+  header.sizes[kEdgeTypeIDs] =
+      pg.edge_entity_type_ids_size() * sizeof(EntityTypeID);
+  header.sizes[kNodeTypeManager] = node_types.size();
+  header.sizes[kEdgeTypeManager] = edge_types.size();
+  header.sizes[kNodeProperties] = node_props->size();
+  header.sizes[kEdgeProperties] = edge_props->size();
+
+  uint64_t offset = AlignUp(sizeof(SharedGraphHeader));
+  for (int i = 0; i < kNumSections; ++i) {
+    header.offsets[i] = offset;
+    offset = AlignUp(offset + header.sizes[i]);
+  }
+
+  // From here on, the destructor of shared unlinks the name on errors
+  std::unique_ptr<SharedPropertyGraph> shared(new SharedPropertyGraph(
+      KATANA_CHECKED(tsuba::SharedMemory::Create(name, offset)), nullptr,
+      true));
+  uint8_t* data = shared->segment_->data();
+  std::memcpy(data, &header, sizeof(header));
+  for (int i = 0; i < kNumSections; ++i) {
+    if (header.sizes[i] > 0) {
+      std::memcpy(data + header.offsets[i], sources[i], header.sizes[i]);
+    }
+  }
+  KATANA_CHECKED(shared->segment_->Seal());
+
+  shared->graph_ = KATANA_CHECKED(MakeGraph(shared->segment_));
+  return shared;
+}
+
+katana::Result<std::unique_ptr<katana::SharedPropertyGraph>>
+katana::SharedPropertyGraph::Attach(const std::string& name) {
+  std::shared_ptr<tsuba::SharedMemory> segment =
+      KATANA_CHECKED(tsuba::SharedMemory::Open(name));
+  std::unique_ptr<PropertyGraph> graph = KATANA_CHECKED(MakeGraph(segment));
+  return std::unique_ptr<SharedPropertyGraph>(
+      new SharedPropertyGraph(std::move(segment), std::move(graph), false));
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::SharedPropertyGraph::MakeGraph(
+    const std::shared_ptr<tsuba::SharedMemory>& segment) {
+  SharedGraphHeader header;
+  if (segment->size() < sizeof(header)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "shared memory {} is not a graph",
+        segment->name());
+  }
+  std::memcpy(&header, segment->data(), sizeof(header));
+  if (header.version != kSharedGraphVersion) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "shared memory {} is not a graph of version {}", segment->name(),
+        kSharedGraphVersion);
+  }
+
+  // The arrays below wrap the segment without owning it
+  auto section = [&](Section s) {
+    return segment->data() + header.offsets[s];
+  };
+
+  GraphTopology topology(
+      NUMAArray<GraphTopology::Edge>(section(kAdjIndices), header.num_nodes),
+      NUMAArray<GraphTopology::Node>(section(kDests), header.num_edges));
+  PropertyGraph::EntityTypeIDArray node_type_ids(
+      section(kNodeTypeIDs),
+      header.sizes[kNodeTypeIDs] / sizeof(EntityTypeID));
+  PropertyGraph::EntityTypeIDArray edge_type_ids(
+      section(kEdgeTypeIDs),
+      header.sizes[kEdgeTypeIDs] / sizeof(EntityTypeID));
+
+  auto as_string = [&](Section s) {
+    return std::string_view(
+        reinterpret_cast<const char*>(section(s)), header.sizes[s]);
+  };
+  EntityTypeManager node_types =
+      KATANA_CHECKED(DeserializeTypeManager(as_string(kNodeTypeManager)));
+  EntityTypeManager edge_types =
+      KATANA_CHECKED(DeserializeTypeManager(as_string(kEdgeTypeManager)));
+
+  std::unique_ptr<PropertyGraph> pg = KATANA_CHECKED(PropertyGraph::Make(
+      std::move(topology), std::move(node_type_ids), std::move(edge_type_ids),
+      std::move(node_types), std::move(edge_types)));
+
+  if (header.sizes[kNodeProperties] > 0) {
+    KATANA_CHECKED(pg->AddNodeProperties(KATANA_CHECKED(DeserializeProperties(
+        segment, header.offsets[kNodeProperties],
+        header.sizes[kNodeProperties]))));
+  }
+  if (header.sizes[kEdgeProperties] > 0) {
+    KATANA_CHECKED(pg->AddEdgeProperties(KATANA_CHECKED(DeserializeProperties(
+        segment, header.offsets[kEdgeProperties],
+        header.sizes[kEdgeProperties]))));
+  }
+
+  return pg;
+}
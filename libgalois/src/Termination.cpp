@@ -19,6 +19,7 @@
 
 #include "katana/Logging.h"
 #include "katana/TerminationDetection.h"
+#include "katana/ThreadPool.h"
 
 // vtable anchoring
 katana::TerminationDetection::~TerminationDetection() = default;
@@ -35,6 +36,8 @@ katana::internal::SetTerminationDetection(katana::TerminationDetection* t) {
 
 katana::TerminationDetection&
 katana::GetTerminationDetection(unsigned active_threads) {
-  kTerminationDetection->Init(active_threads);
-  return *kTerminationDetection;
+  ThreadPool::Group* group = ThreadPool::getGroup();
+  TerminationDetection* term = group ? group->term : kTerminationDetection;
+  term->Init(active_threads);
+  return *term;
 }
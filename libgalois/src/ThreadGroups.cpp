@@ -0,0 +1,125 @@
+#include "katana/ThreadGroups.h"
+
+#include <map>
+
+#include "katana/ErrorCode.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+
+katana::ThreadGroup::ThreadGroup(
+    std::string name, unsigned socket, std::vector<unsigned> threads)
+    : name_(std::move(name)),
+      socket_(socket),
+      pool_group_(std::move(threads)),
+      barrier_(CreateTopoBarrier(pool_group_.size())),
+      term_(CreateTerminationDetection()) {
+  pool_group_.barrier = barrier_.get();
+  pool_group_.term = term_.get();
+}
+
+katana::Result<std::unique_ptr<katana::ThreadGroupScheduler>>
+katana::ThreadGroupScheduler::Make(unsigned group_size) {
+  if (group_size == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "thread groups must not be empty");
+  }
+
+  ThreadPool& pool = GetThreadPool();
+  std::unique_ptr<ThreadGroupScheduler> scheduler(new ThreadGroupScheduler());
+  scheduler->num_threads_ = getActiveThreads();
+  scheduler->group_of_thread_.resize(scheduler->num_threads_);
+
+  std::map<unsigned, std::vector<unsigned>> threads_of_socket;
+  for (unsigned tid = 0; tid < scheduler->num_threads_; ++tid) {
+    threads_of_socket[pool.getSocket(tid)].emplace_back(tid);
+  }
+
+  for (const auto& [socket, threads] : threads_of_socket) {
+    for (size_t begin = 0; begin < threads.size(); begin += group_size) {
+      size_t end = std::min<size_t>(begin + group_size, threads.size());
+      std::vector<unsigned> members(
+          threads.begin() + begin, threads.begin() + end);
+
+      auto& group = scheduler->groups_.emplace_back(new ThreadGroup(
+          fmt::format("socket{}-group{}", socket, begin / group_size), socket,
+          std::move(members)));
+      for (unsigned tid : group->threads()) {
+        scheduler->group_of_thread_[tid] = group.get();
+      }
+    }
+  }
+
+  return scheduler;
+}
+
+katana::Result<std::unique_ptr<katana::ThreadGroupScheduler>>
+katana::ThreadGroupScheduler::MakePerSocket() {
+  return Make(getActiveThreads());
+}
+
+void
+katana::ThreadGroupScheduler::Submit(Request request) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_.emplace_back(std::move(request));
+  cv_.notify_one();
+}
+
+void
+katana::ThreadGroupScheduler::Run() {
+  std::vector<uint64_t> num_requests;
+  for (const auto& group : groups_) {
+    num_requests.emplace_back(group->num_requests());
+  }
+
+  GetThreadPool().run(num_threads_, [this]() {
+    RunGroup(group_of_thread_[ThreadPool::getTID()]);
+  });
+
+  for (size_t i = 0; i < groups_.size(); ++i) {
+    ReportStatSum(
+        "ThreadGroupScheduler", groups_[i]->name() + "Requests",
+        groups_[i]->num_requests() - num_requests[i]);
+  }
+}
+
+void
+katana::ThreadGroupScheduler::RunGroup(ThreadGroup* group) {
+  ThreadPool& pool = GetThreadPool();
+  pool.enterGroup(&group->pool_group_);
+
+  if (ThreadPool::getTID() == 0) {
+    Request current;
+    bool finished = false;
+    while (NextRequest(finished, &current)) {
+      group->pool_group_.active_threads = group->size();
+      current(*group);
+      ++group->num_requests_;
+      finished = true;
+    }
+    pool.closeGroup();
+  } else {
+    pool.serveGroup();
+  }
+
+  pool.leaveGroup();
+}
+
+bool
+katana::ThreadGroupScheduler::NextRequest(bool finished, Request* current) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (finished) {
+    if (--num_running_ == 0 && requests_.empty()) {
+      cv_.notify_all();
+    }
+  }
+
+  cv_.wait(lock, [this]() { return !requests_.empty() || num_running_ == 0; });
+  if (requests_.empty()) {
+    return false;
+  }
+
+  *current = std::move(requests_.front());
+  requests_.pop_front();
+  ++num_running_;
+  return true;
+}
@@ -130,6 +130,7 @@ void
 ThreadPool::initThread(unsigned tid) {
   signals[tid] = &my_box;
   my_box.topo = getHWTopo().threadTopoInfo[tid];
+  my_box.view = my_box.topo;
   // Initialize
   initPTS(mi.maxThreads);
 
@@ -279,6 +280,151 @@ ThreadPool::runDedicated(std::function<void(void)>& f) {
   work = nullptr;
 }
 
+unsigned
+ThreadPool::getPoolLeaderForSocket(unsigned pid) const {
+  for (unsigned i = 0; i < mi.maxThreads; ++i) {
+    const ThreadTopoInfo& topo = signals[i]->topo;
+    if (topo.socket == pid && topo.socketLeader == i) {
+      return i;
+    }
+  }
+  abort();
+}
+
+ThreadPool::Group::Group(std::vector<unsigned> tids)
+    : pool_tids(std::move(tids)), active_threads(pool_tids.size()) {
+  KATANA_LOG_ASSERT(!pool_tids.empty());
+  ThreadPool& pool = GetThreadPool();
+  unsigned socket = pool.signals[pool_tids[0]]->topo.socket;
+  for (unsigned i = 0; i < pool_tids.size(); ++i) {
+    ThreadTopoInfo topo = pool.signals[pool_tids[i]]->topo;
+    KATANA_LOG_VASSERT(
+        topo.socket == socket, "thread group spans sockets {} and {}", socket,
+        topo.socket);
+    topo.tid = i;
+    topo.socketLeader = 0;
+    topo.socket = 0;
+    topo.numaNode = 0;
+    topo.cumulativeMaxSocket = 0;
+    topo_.emplace_back(topo);
+  }
+  mi_ = MachineTopoInfo{size(), size(), 1, 1};
+}
+
+void
+ThreadPool::enterGroup(Group* group) {
+  auto& me = my_box;
+  KATANA_LOG_DEBUG_ASSERT(!me.group);
+  auto it =
+      std::find(group->pool_tids.begin(), group->pool_tids.end(), me.topo.tid);
+  KATANA_LOG_VASSERT(
+      it != group->pool_tids.end(), "thread {} is not in the group",
+      me.topo.tid);
+  me.view = group->topo_[it - group->pool_tids.begin()];
+  me.group = group;
+}
+
+void
+ThreadPool::leaveGroup() {
+  auto& me = my_box;
+  Group* group = me.group;
+  me.view = me.topo;
+  me.group = nullptr;
+
+  // The last thread to leave makes the group ready to be entered again
+  if (group->num_left_.fetch_add(1) + 1 == group->size()) {
+    group->num_left_ = 0;
+    group->generation_ = 0;
+    group->closed_ = false;
+  }
+}
+
+void
+ThreadPool::runGroup(unsigned num, std::function<void(void)>& work) {
+  Group& group = *my_box.group;
+  KATANA_LOG_VASSERT(
+      !group.running_ && my_box.view.tid == 0,
+      "Recursive thread pool execution not supported");
+  group.running_ = true;
+  num = std::min(std::max(1U, num), group.size());
+
+  {
+    std::lock_guard<std::mutex> lock(group.mutex_);
+    group.work_ = &work;
+    group.num_ = num;
+    group.pending_.store(num - 1, std::memory_order_relaxed);
+    group.generation_.fetch_add(1, std::memory_order_release);
+  }
+  if (num > 1) {
+    group.cv_.notify_all();
+  }
+
+  work();
+  while (group.pending_.load(std::memory_order_acquire) != 0) {
+    asmPause();
+  }
+
+  group.work_ = nullptr;
+  group.running_ = false;
+}
+
+void
+ThreadPool::serveGroup() {
+  // Loops often start right after each other, so spin for a while before
+  // waiting on the condition variable
+  constexpr unsigned kSpins = 1 << 12;
+
+  Group& group = *my_box.group;
+  unsigned tid = my_box.view.tid;
+  uint64_t seen = 0;
+  while (true) {
+    for (unsigned i = 0;
+         i < kSpins &&
+         group.generation_.load(std::memory_order_acquire) == seen;
+         ++i) {
+      asmPause();
+    }
+
+    std::function<void(void)>* work;
+    unsigned num;
+    {
+      std::unique_lock<std::mutex> lock(group.mutex_);
+      group.cv_.wait(lock, [&]() {
+        return group.generation_.load(std::memory_order_relaxed) != seen;
+      });
+      seen = group.generation_.load(std::memory_order_relaxed);
+      if (group.closed_) {
+        return;
+      }
+      work = group.work_;
+      num = group.num_;
+    }
+
+    if (tid < num) {
+      try {
+        (*work)();
+      } catch (const std::exception& exc) {
+        std::cerr << exc.what();
+        abort();
+      } catch (...) {
+        abort();
+      }
+      group.pending_.fetch_sub(1, std::memory_order_release);
+    }
+  }
+}
+
+void
+ThreadPool::closeGroup() {
+  Group& group = *my_box.group;
+  {
+    std::lock_guard<std::mutex> lock(group.mutex_);
+    group.closed_ = true;
+    group.generation_.fetch_add(1, std::memory_order_release);
+  }
+  group.cv_.notify_all();
+}
+
 static katana::ThreadPool* TPOOL = nullptr;
 
 void
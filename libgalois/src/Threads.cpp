@@ -30,11 +30,18 @@ unsigned int
 katana::setActiveThreads(unsigned int num) noexcept {
   num = std::min(num, katana::GetThreadPool().getMaxUsableThreads());
   num = std::max(num, 1U);
-  katana::activeThreads = num;
+  if (ThreadPool::Group* group = ThreadPool::getGroup()) {
+    group->active_threads = num;
+  } else {
+    katana::activeThreads = num;
+  }
   return num;
 }
 
 unsigned int
 katana::getActiveThreads() noexcept {
+  if (ThreadPool::Group* group = ThreadPool::getGroup()) {
+    return group->active_threads;
+  }
   return katana::activeThreads;
 }
@@ -0,0 +1,295 @@
+#include <cmath>
+#include <random>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Properties.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using BiDirView = katana::PropertyGraphViews::BiDirectional;
+
+constexpr static uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+/// The Riondato-Kornaropoulos bound on the number of samples is split into
+/// this many geometrically growing rounds, each ending with a check of the
+/// stopping condition.
+constexpr static uint32_t kNumRounds = 8;
+
+/// The universal constant of the Riondato-Kornaropoulos bound.
+constexpr static double kVCConstant = 0.5;
+
+struct NodeBC : public katana::PODProperty<float> {};
+
+/// Per-thread state to sample a uniformly random shortest path between two
+/// nodes. A forward BFS from the source stops at the level of the target,
+/// and the path is walked back from the target over in-edges, picking each
+/// predecessor with probability proportional to its number of shortest
+/// paths. Only the nodes a search touched are reset afterwards.
+class PathSampler {
+public:
+  PathSampler(const BiDirView& view, uint64_t seed)
+      : view_(view),
+        distance_(view.num_nodes(), kInfinity),
+        num_shortest_paths_(view.num_nodes(), 0),
+        generator_(seed) {}
+
+  /// Returns a uniformly random node.
+  Node RandomNode() {
+    return std::uniform_int_distribution<Node>(0, view_.num_nodes() - 1)(
+        generator_);
+  }
+
+  /// Samples a pair of distinct nodes and a shortest path between them, and
+  /// calls visit for each node strictly inside the path. Does nothing if
+  /// there is no path.
+  template <typename Visit>
+  void SamplePath(const Visit& visit) {
+    Node source = RandomNode();
+    Node target = RandomNode();
+    while (target == source) {
+      target = RandomNode();
+    }
+
+    if (Search(source, target)) {
+      Node current = target;
+      while (current != source) {
+        current = RandomPredecessor(current);
+        if (current != source) {
+          visit(current);
+        }
+      }
+    }
+    Reset();
+  }
+
+  /// Returns the eccentricity of source, following out-edges if forward is
+  /// true and in-edges otherwise.
+  uint32_t Eccentricity(Node source, bool forward) {
+    Visit(source, 0);
+    uint32_t eccentricity = 0;
+    for (size_t i = 0; i < touched_.size(); ++i) {
+      Node n = touched_[i];
+      eccentricity = distance_[n];
+      auto relax = [&](Node dest) {
+        if (distance_[dest] == kInfinity) {
+          Visit(dest, distance_[n] + 1);
+        }
+      };
+      if (forward) {
+        for (auto e : view_.edges(n)) {
+          relax(view_.edge_dest(e));
+        }
+      } else {
+        for (auto e : view_.in_edges(n)) {
+          relax(view_.in_edge_dest(e));
+        }
+      }
+    }
+    Reset();
+    return eccentricity;
+  }
+
+private:
+  void Visit(Node n, uint32_t distance) {
+    distance_[n] = distance;
+    touched_.push_back(n);
+  }
+
+  /// BFS from source that counts shortest paths up to the level of target.
+  /// Returns whether target is reachable.
+  bool Search(Node source, Node target) {
+    Visit(source, 0);
+    num_shortest_paths_[source] = 1;
+    for (size_t i = 0; i < touched_.size(); ++i) {
+      Node n = touched_[i];
+      // Every node before the target's level is finished once the first
+      // node at that level is dequeued.
+      if (distance_[n] >= distance_[target]) {
+        break;
+      }
+      for (auto e : view_.edges(n)) {
+        Node dest = view_.edge_dest(e);
+        if (distance_[dest] == kInfinity) {
+          Visit(dest, distance_[n] + 1);
+        }
+        if (distance_[dest] == distance_[n] + 1) {
+          num_shortest_paths_[dest] += num_shortest_paths_[n];
+        }
+      }
+    }
+    return distance_[target] != kInfinity;
+  }
+
+  Node RandomPredecessor(Node n) {
+    double r = std::uniform_real_distribution<double>(
+        0, num_shortest_paths_[n])(generator_);
+    Node last = n;
+    for (auto e : view_.in_edges(n)) {
+      Node pred = view_.in_edge_dest(e);
+      if (distance_[pred] != kInfinity &&
+          distance_[pred] + 1 == distance_[n]) {
+        last = pred;
+        r -= num_shortest_paths_[pred];
+        if (r < 0) {
+          return pred;
+        }
+      }
+    }
+    // Rounding may leave a tiny remainder after the last predecessor.
+    return last;
+  }
+
+  void Reset() {
+    for (Node n : touched_) {
+      distance_[n] = kInfinity;
+      num_shortest_paths_[n] = 0;
+    }
+    touched_.clear();
+  }
+
+  const BiDirView& view_;
+  std::vector<uint32_t> distance_;
+  std::vector<double> num_shortest_paths_;
+  std::vector<Node> touched_;
+  std::mt19937_64 generator_;
+};
+
+/// Estimates the vertex diameter, the number of nodes on a longest shortest
+/// path, from the eccentricities of the node of highest degree as KADABRA
+/// does. It is exact for undirected connected graphs up to a factor of two,
+/// and a heuristic otherwise.
+uint32_t
+EstimateVertexDiameter(const BiDirView& view, PathSampler* sampler) {
+  Node hub = 0;
+  for (Node n = 1; n < view.num_nodes(); ++n) {
+    if (view.degree(n) + view.in_degree(n) >
+        view.degree(hub) + view.in_degree(hub)) {
+      hub = n;
+    }
+  }
+  return sampler->Eccentricity(hub, true) + sampler->Eccentricity(hub, false) +
+         1;
+}
+
+/// The half-width of a two-sided empirical Bernstein confidence interval
+/// (Maurer and Pontil) for the mean of num_samples values in [0, 1] with
+/// failure probability delta.
+double
+EmpiricalBernsteinBound(uint64_t hits, uint64_t num_samples, double delta) {
+  double n = num_samples;
+  double mean = hits / n;
+  double variance = mean * (1 - mean) * n / (n - 1);
+  double log_term = std::log(4 / delta);
+  return std::sqrt(2 * variance * log_term / n) + 7 * log_term / (3 * (n - 1));
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralityApproximate(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan) {
+  if (!(plan.epsilon() > 0 && plan.epsilon() < 1) ||
+      !(plan.delta() > 0 && plan.delta() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "epsilon and delta must be in (0, 1), got {} and {}", plan.epsilon(),
+        plan.delta());
+  }
+
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<NodeBC>>(
+      pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<NodeBC>, std::tuple<>>::Make(
+          pg, {output_property_name}, {})));
+
+  const uint64_t num_nodes = pg->topology().num_nodes();
+  if (num_nodes < 2) {
+    katana::do_all(
+        katana::iterate(graph), [&](Node n) { graph.GetData<NodeBC>(n) = 0; },
+        katana::no_stats());
+    return katana::ResultSuccess();
+  }
+
+  // The in-edges come from the transposed topology cached on pg.
+  auto view = pg->BuildView<BiDirView>();
+
+  katana::StatTimer exec_time("Approximate", "BetweennessCentrality");
+  exec_time.start();
+
+  katana::PerThreadStorage<std::unique_ptr<PathSampler>> samplers;
+  katana::on_each([&](unsigned tid, unsigned) {
+    *samplers.getLocal() = std::make_unique<PathSampler>(view, tid);
+  });
+
+  // Half of delta goes to the worst case sample size, the other half is
+  // split over the nodes and the checks of the stopping condition.
+  uint32_t vertex_diameter =
+      EstimateVertexDiameter(view, samplers.getLocal()->get());
+  double log_diameter =
+      vertex_diameter > 2 ? std::floor(std::log2(vertex_diameter - 2)) : 0;
+  const uint64_t max_samples = std::ceil(
+      kVCConstant / (plan.epsilon() * plan.epsilon()) *
+      (log_diameter + 1 + std::log(2 / plan.delta())));
+  const double check_delta = plan.delta() / (2 * kNumRounds * num_nodes);
+
+  katana::NUMAArray<std::atomic<uint64_t>> hits;
+  hits.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) { hits[n] = 0; },
+      katana::no_stats());
+
+  uint64_t num_samples = 0;
+  for (uint32_t round = 1; round <= kNumRounds; ++round) {
+    uint64_t round_end =
+        std::max<uint64_t>(2, max_samples >> (kNumRounds - round));
+    katana::do_all(
+        katana::iterate(num_samples, round_end),
+        [&](uint64_t) {
+          (*samplers.getLocal())->SamplePath([&](Node n) {
+            hits[n].fetch_add(1, std::memory_order_relaxed);
+          });
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("SampleShortestPaths"));
+    num_samples = std::max(num_samples, round_end);
+
+    if (round == kNumRounds) {
+      break;
+    }
+    katana::GReduceLogicalOr too_wide;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          if (EmpiricalBernsteinBound(hits[n], num_samples, check_delta) >
+              plan.epsilon()) {
+            too_wide.update(true);
+          }
+        },
+        katana::no_stats(), katana::loopname("CheckStoppingCondition"));
+    if (!too_wide.reduce()) {
+      break;
+    }
+  }
+
+  exec_time.stop();
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "VertexDiameterEstimate", vertex_diameter);
+  katana::ReportStatSingle("BetweennessCentrality", "MaxSamples", max_samples);
+  katana::ReportStatSingle("BetweennessCentrality", "NumSamples", num_samples);
+
+  // Scale to the range of exact centrality, which sums over ordered pairs.
+  const double scale = double(num_nodes) * (num_nodes - 1) / num_samples;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) { graph.GetData<NodeBC>(n) = hits[n] * scale; },
+      katana::no_stats(), katana::loopname("ExtractBC"));
+  return katana::ResultSuccess();
+}
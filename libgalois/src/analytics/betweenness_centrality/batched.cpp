@@ -0,0 +1,270 @@
+#include <numeric>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/NUMAArray.h"
+#include "katana/Properties.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+// type of the num shortest paths variable
+using BatchedShortPathType = double;
+// bit i is set if the i-th source of the batch is involved
+using SourceMask = uint64_t;
+
+constexpr static uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+struct NodeBC : public katana::PODProperty<float> {};
+
+typedef katana::TypedPropertyGraph<std::tuple<>, std::tuple<>> BatchedGraph;
+typedef typename BatchedGraph::Node BatchedGNode;
+
+/// A node together with the sources of the batch for which it is at the
+/// level of the worklist holding it.
+struct LevelEntry {
+  BatchedGNode node;
+  SourceMask sources;
+};
+
+using BatchedWorklistType = katana::InsertBag<LevelEntry, 4096>;
+using NodeWorklistType = katana::InsertBag<BatchedGNode, 4096>;
+
+constexpr static const unsigned kBatchedChunkSize = 64u;
+
+/// Calls fn(i) for every set bit i of mask.
+template <typename Fn>
+void
+ForEachSource(SourceMask mask, const Fn& fn) {
+  while (mask != 0) {
+    fn(static_cast<uint32_t>(__builtin_ctzll(mask)));
+    mask &= mask - 1;
+  }
+}
+
+/// Multi-source Brandes. The forward phase is a multi-source BFS: the
+/// frontier of a level is a set of (node, mask of sources) pairs, so sources
+/// that reach a node at the same depth share the scan of its edges. The
+/// per-source path counts, distances and dependencies are laid out
+/// node-major so that the values for one node are contiguous.
+class BatchedBrandes {
+public:
+  BatchedBrandes(const BatchedGraph& graph, uint32_t batch_size)
+      : graph_(graph), batch_size_(batch_size) {
+    uint64_t num_nodes = graph_.size();
+    seen_.allocateBlocked(num_nodes);
+    next_.allocateBlocked(num_nodes);
+    bc_.allocateBlocked(num_nodes);
+    distance_.allocateBlocked(num_nodes * batch_size_);
+    num_shortest_paths_.allocateBlocked(num_nodes * batch_size_);
+    dependency_.allocateBlocked(num_nodes * batch_size_);
+
+    katana::do_all(
+        katana::iterate(graph_), [&](BatchedGNode n) { bc_[n] = 0; },
+        katana::no_stats(), katana::loopname("InitializeGraph"));
+  }
+
+  /// Add the dependencies of up to batch_size sources to the centralities.
+  void Run(const BatchedGNode* sources, uint32_t num_sources) {
+    KATANA_LOG_DEBUG_ASSERT(num_sources <= batch_size_);
+    InitializeBatch();
+
+    std::vector<BatchedWorklistType> levels(1);
+    for (uint32_t i = 0; i < num_sources; ++i) {
+      BatchedGNode src = sources[i];
+      seen_[src] |= SourceMask{1} << i;
+      distance_[Index(src, i)] = 0;
+      num_shortest_paths_[Index(src, i)] = 1;
+    }
+    for (uint32_t i = 0; i < num_sources; ++i) {
+      // A node listed several times in the batch is one entry of level 0.
+      SourceMask mask = seen_[sources[i]];
+      if (__builtin_ctzll(mask) == i) {
+        levels[0].push(LevelEntry{sources[i], mask});
+      }
+    }
+
+    while (!levels.back().empty()) {
+      levels.emplace_back();
+      Forward(levels.size() - 2, &levels[levels.size() - 2], &levels.back());
+    }
+
+    // The dependencies of the sources themselves at level 0 are not counted.
+    for (uint64_t level = levels.size() - 1; level > 0; --level) {
+      Backward(level, &levels[level]);
+    }
+  }
+
+  float bc(BatchedGNode n) const { return bc_[n]; }
+
+private:
+  uint64_t Index(BatchedGNode n, uint32_t source) const {
+    return uint64_t{n} * batch_size_ + source;
+  }
+
+  void InitializeBatch() {
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](BatchedGNode n) {
+          seen_[n] = 0;
+          next_[n] = 0;
+          for (uint32_t i = 0; i < batch_size_; ++i) {
+            distance_[Index(n, i)] = kInfinity;
+            num_shortest_paths_[Index(n, i)] = 0;
+            dependency_[Index(n, i)] = 0;
+          }
+        },
+        katana::no_stats(), katana::loopname("InitializeBatch"));
+  }
+
+  /// Expands the entries of level into next_level, accumulating the numbers
+  /// of shortest paths of the nodes reached.
+  void Forward(
+      uint32_t level, BatchedWorklistType* current,
+      BatchedWorklistType* next_level) {
+    NodeWorklistType reached;
+
+    katana::do_all(
+        katana::iterate(*current),
+        [&](const LevelEntry& entry) {
+          BatchedGNode n = entry.node;
+          for (auto e : graph_.edges(n)) {
+            BatchedGNode dest = *graph_.GetEdgeDest(e);
+            // seen_ only changes between levels, so every predecessor at this
+            // level contributes its paths for the same sources.
+            SourceMask fresh = entry.sources & ~seen_[dest].load();
+            if (fresh == 0) {
+              continue;
+            }
+            if (next_[dest].fetch_or(fresh) == 0) {
+              reached.push(dest);
+            }
+            ForEachSource(fresh, [&](uint32_t i) {
+              katana::atomicAdd(
+                  num_shortest_paths_[Index(dest, i)],
+                  num_shortest_paths_[Index(n, i)].load());
+            });
+          }
+        },
+        katana::steal(), katana::chunk_size<kBatchedChunkSize>(),
+        katana::no_stats(), katana::loopname("BatchedSSSP"));
+
+    katana::do_all(
+        katana::iterate(reached),
+        [&](BatchedGNode n) {
+          SourceMask mask = next_[n].exchange(0);
+          seen_[n] |= mask;
+          ForEachSource(
+              mask, [&](uint32_t i) { distance_[Index(n, i)] = level + 1; });
+          next_level->push(LevelEntry{n, mask});
+        },
+        katana::no_stats(), katana::loopname("BatchedCommitLevel"));
+  }
+
+  /// Back-propagates the dependencies of the entries of level from the
+  /// successors of their nodes in the shortest path DAGs.
+  void Backward(uint32_t level, BatchedWorklistType* current) {
+    katana::do_all(
+        katana::iterate(*current),
+        [&](const LevelEntry& entry) {
+          BatchedGNode n = entry.node;
+          for (auto e : graph_.edges(n)) {
+            BatchedGNode dest = *graph_.GetEdgeDest(e);
+            SourceMask successor_of = entry.sources & seen_[dest].load();
+            ForEachSource(successor_of, [&](uint32_t i) {
+              if (distance_[Index(dest, i)] == level + 1) {
+                dependency_[Index(n, i)] +=
+                    ((float)1 + dependency_[Index(dest, i)]) /
+                    num_shortest_paths_[Index(dest, i)];
+              }
+            });
+          }
+
+          // A node has at most one entry per level, so only this iteration
+          // writes its centrality.
+          ForEachSource(entry.sources, [&](uint32_t i) {
+            dependency_[Index(n, i)] *= num_shortest_paths_[Index(n, i)];
+            bc_[n] += dependency_[Index(n, i)];
+          });
+        },
+        katana::steal(), katana::chunk_size<kBatchedChunkSize>(),
+        katana::no_stats(), katana::loopname("BatchedBrandes"));
+  }
+
+  const BatchedGraph& graph_;
+  uint32_t batch_size_;
+
+  /// Sources that reached each node at or before the current level.
+  katana::NUMAArray<std::atomic<SourceMask>> seen_;
+  /// Sources that reach each node at the next level.
+  katana::NUMAArray<std::atomic<SourceMask>> next_;
+  katana::NUMAArray<float> bc_;
+  katana::NUMAArray<uint32_t> distance_;
+  katana::NUMAArray<std::atomic<BatchedShortPathType>> num_shortest_paths_;
+  katana::NUMAArray<float> dependency_;
+};
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralityBatched(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan) {
+  if (plan.batch_size() == 0 ||
+      plan.batch_size() > BetweennessCentralityPlan::kMaxBatchSize) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "batch size must be between 1 and {}, got {}",
+        BetweennessCentralityPlan::kMaxBatchSize, plan.batch_size());
+  }
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "BatchSize", plan.batch_size());
+
+  BatchedGraph graph = KATANA_CHECKED(BatchedGraph::Make(pg, {}, {}));
+
+  std::vector<BatchedGNode> source_vector;
+  if (std::holds_alternative<std::vector<uint32_t>>(sources)) {
+    for (uint32_t src : std::get<std::vector<uint32_t>>(sources)) {
+      if (src >= graph.size()) {
+        return KATANA_ERROR(
+            katana::ErrorCode::InvalidArgument, "no such source node {}", src);
+      }
+      source_vector.emplace_back(src);
+    }
+  } else {
+    uint64_t num_sources = graph.size();
+    if (sources != kBetweennessCentralityAllNodes) {
+      num_sources =
+          std::min<uint64_t>(num_sources, std::get<uint32_t>(sources));
+    }
+    source_vector.resize(num_sources);
+    std::iota(source_vector.begin(), source_vector.end(), BatchedGNode{0});
+  }
+
+  BatchedBrandes brandes(graph, plan.batch_size());
+
+  katana::StatTimer exec_time("Batched", "BetweennessCentrality");
+  exec_time.start();
+  for (uint64_t i = 0; i < source_vector.size(); i += plan.batch_size()) {
+    uint32_t num_sources = std::min<uint64_t>(
+        plan.batch_size(), source_vector.size() - i);
+    brandes.Run(&source_vector[i], num_sources);
+  }
+  exec_time.stop();
+
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<NodeBC>>(
+      pg, {output_property_name}));
+  auto output_graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<NodeBC>, std::tuple<>>::Make(
+          pg, {output_property_name}, {})));
+  katana::do_all(
+      katana::iterate(graph),
+      [&](BatchedGNode n) { output_graph.GetData<NodeBC>(n) = brandes.bc(n); },
+      katana::no_stats(), katana::loopname("ExtractBC"));
+  return katana::ResultSuccess();
+}
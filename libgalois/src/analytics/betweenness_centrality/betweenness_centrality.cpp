@@ -41,6 +41,11 @@ katana::analytics::BetweennessCentrality(
     return BetweennessCentralityLevel(pg, sources, output_property_name, plan);
   case BetweennessCentralityPlan::kOuter:
     return BetweennessCentralityOuter(pg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kBatched:
+    return BetweennessCentralityBatched(
+        pg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kApproximate:
+    return BetweennessCentralityApproximate(pg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -16,4 +16,14 @@ katana::Result<void> BetweennessCentralityLevel(
     const std::string& output_property_name,
     katana::analytics::BetweennessCentralityPlan plan);
 
+katana::Result<void> BetweennessCentralityBatched(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
+katana::Result<void> BetweennessCentralityApproximate(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
 #endif
@@ -273,9 +273,9 @@ BetweennessCentralityLevel(
   // preallocate pages in memory so allocation doesn't occur during compute
   katana::StatTimer prealloc_time("PreAllocTime", "BetweennessCentrality");
   prealloc_time.start();
-  katana::EnsurePreallocated(std::max(
+  KATANA_CHECKED(katana::TryEnsurePreallocated(std::max(
       size_t{katana::getActiveThreads()} * (graph.size() / 1350000),
-      std::max(10U, katana::getActiveThreads()) * size_t{10}));
+      std::max(10U, katana::getActiveThreads()) * size_t{10})));
   prealloc_time.stop();
   katana::ReportPageAllocGuard page_alloc;
 
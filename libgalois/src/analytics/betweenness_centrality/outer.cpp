@@ -257,8 +257,8 @@ BetweennessCentralityOuter(
   BCOuter bc_outer(graph);
 
   // preallocate pages for use in algorithm
-  katana::EnsurePreallocated(
-      katana::getActiveThreads() * graph.num_nodes() / 1650);
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      katana::getActiveThreads() * graph.num_nodes() / 1650));
   katana::ReportPageAllocGuard page_alloc;
 
   // vector of sources to process; initialized if doing outSources
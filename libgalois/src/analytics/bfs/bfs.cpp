@@ -22,8 +22,8 @@
 #include <deque>
 #include <type_traits>
 
-#include "katana/DynamicBitset.h"
 #include "katana/ErrorCode.h"
+#include "katana/Frontier.h"
 #include "katana/Result.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -74,18 +74,6 @@ struct EdgeTileMaker {
   }
 };
 
-struct NodePushWrap {
-  template <typename C>
-  void operator()(C& cont, const GNode& n, const char* const /*tag*/) const {
-    (*this)(cont, n);
-  }
-
-  template <typename C>
-  void operator()(C& cont, const GNode& n) const {
-    cont.push(n);
-  }
-};
-
 struct EdgeTilePushWrap {
   Graph* graph;
   BfsImplementation& impl;
@@ -117,28 +105,6 @@ struct OneTilePushWrap {
   }
 };
 
-template <typename WL>
-void
-WlToBitset(const WL& wl, katana::DynamicBitset* bitset) {
-  katana::do_all(
-      katana::iterate(wl), [&](const GNode& src) { bitset->set(src); },
-      katana::chunk_size<kChunkSize>(), katana::loopname("WlToBitset"));
-}
-
-template <typename G, typename WL>
-void
-BitsetToWl(const G& graph, const katana::DynamicBitset& bitset, WL* wl) {
-  wl->clear();
-  katana::do_all(
-      katana::iterate(graph),
-      [&](const GNode& src) {
-        if (bitset.test(src)) {
-          wl->push(src);
-        }
-      },
-      katana::chunk_size<kChunkSize>(), katana::loopname("BitsetToWl"));
-}
-
 template <typename T, typename P, typename R>
 void
 AsynchronousAlgo(
@@ -217,36 +183,29 @@ AsynchronousAlgo(
   }
 }
 
-template <typename P>
 void
 SynchronousDirectOpt(
     const BiDirGraphView& bidir_view, katana::NUMAArray<GNode>* node_data,
-    const GNode source, const P& pushWrap, const uint32_t alpha,
-    const uint32_t beta) {
-  using Cont = katana::InsertBag<GNode>;
+    const GNode source, const uint32_t alpha, const uint32_t beta) {
   using Loop = katana::DoAll;
 
   katana::GAccumulator<uint32_t> work_items;
-  katana::StatTimer bitset_to_wl_timer("Bitset_To_WL_Timer");
-  katana::StatTimer wl_to_bitset_timer("WL_To_Bitset_Timer");
+  katana::StatTimer to_sparse_timer("Frontier_To_Sparse_Timer");
+  katana::StatTimer to_dense_timer("Frontier_To_Dense_Timer");
 
   Loop loop;
 
-  katana::DynamicBitset front_bitset;
-  katana::DynamicBitset next_bitset;
-
   uint32_t num_nodes = bidir_view.num_nodes();
   uint64_t num_edges = bidir_view.num_edges();
 
-  front_bitset.resize(num_nodes);
-  next_bitset.resize(num_nodes);
-
-  auto frontier = std::make_unique<Cont>();
-  auto next_frontier = std::make_unique<Cont>();
+  // The pull steps test membership, so they always use dense frontiers; the
+  // push steps switch to dense ones at the same size as the pull steps stop
+  katana::Frontier frontier(num_nodes, beta);
+  katana::Frontier next_frontier(num_nodes, beta);
 
   (*node_data)[source] = source;
 
-  pushWrap(*next_frontier, source, "parallel");
+  next_frontier.Push(source);
 
   work_items += 1;
 
@@ -257,13 +216,14 @@ SynchronousDirectOpt(
   katana::GAccumulator<uint64_t> writes_pull;
   katana::GAccumulator<uint64_t> writes_push;
 
-  while (!next_frontier->empty()) {
-    std::swap(frontier, next_frontier);
-    next_frontier->clear();
+  while (!next_frontier.empty()) {
+    frontier.swap(next_frontier);
+    next_frontier.Clear();
     if (scout_count > edges_to_check / alpha) {
-      wl_to_bitset_timer.start();
-      WlToBitset(*frontier, &front_bitset);
-      wl_to_bitset_timer.stop();
+      to_dense_timer.start();
+      frontier.ToDense();
+      next_frontier.ToDense();
+      to_dense_timer.stop();
       do {
         old_num_work_items = work_items.reduce();
         work_items.reset();
@@ -276,10 +236,10 @@ SynchronousDirectOpt(
                 for (auto e : bidir_view.in_edges(dst)) {
                   auto src = bidir_view.in_edge_dest(e);
 
-                  if (front_bitset.test(src)) {
+                  if (frontier.Contains(src)) {
                     // assign parents on the bfs path.
                     ddata = src;
-                    next_bitset.set(dst);
+                    next_frontier.Push(dst);
                     work_items += 1;
                     break;
                   }
@@ -288,20 +248,22 @@ SynchronousDirectOpt(
             },
             katana::steal(), katana::chunk_size<kChunkSize>(),
             katana::loopname(std::string("SyncDO-pull").c_str()));
-        std::swap(front_bitset, next_bitset);
-        next_bitset.reset();
+        frontier.swap(next_frontier);
+        next_frontier.Clear();
       } while (work_items.reduce() >= old_num_work_items ||
                (work_items.reduce() > num_nodes / beta));
-      bitset_to_wl_timer.start();
-      BitsetToWl(bidir_view, front_bitset, next_frontier.get());
-      bitset_to_wl_timer.stop();
+      // Hand the last level to the push steps through next_frontier
+      to_sparse_timer.start();
+      frontier.Adapt();
+      next_frontier.Adapt();
+      to_sparse_timer.stop();
+      frontier.swap(next_frontier);
       scout_count = 1;
     } else {
       edges_to_check -= scout_count;
       work_items.reset();
 
-      loop(
-          katana::iterate(*frontier),
+      frontier.ForEach(
           [&](const GNode& src) {
             for (auto e : bidir_view.edges(src)) {
               auto dst = bidir_view.edge_dest(e);
@@ -309,14 +271,14 @@ SynchronousDirectOpt(
               if (ddata == BfsImplementation::kDistanceInfinity) {
                 GNode old_parent = ddata;
                 if (__sync_bool_compare_and_swap(&ddata, old_parent, src)) {
-                  next_frontier->push(dst);
+                  next_frontier.Push(dst);
                   work_items += bidir_view.degree(dst);
                 }
               }
             }
           },
-          katana::steal(), katana::chunk_size<kChunkSize>(),
-          katana::loopname(std::string("SyncDO-push").c_str()));
+          "SyncDO-push");
+      next_frontier.Adapt();
       scout_count = work_items.reduce();
     }
   }
@@ -384,8 +346,7 @@ RunAlgo(
 
     exec_time.start();
     SynchronousDirectOpt(
-        bidir_view, &node_data, source, NodePushWrap(), algo.alpha(),
-        algo.beta());
+        bidir_view, &node_data, source, algo.alpha(), algo.beta());
     exec_time.stop();
 
     UpdateGraphNodeData(graph, node_data);
@@ -438,7 +399,7 @@ BfsImpl(
   GNode source = *it;
 
   size_t approxNodeData = 4 * (graph->num_nodes() + graph->num_edges());
-  katana::EnsurePreallocated(8, approxNodeData);
+  KATANA_CHECKED(katana::TryEnsurePreallocated(8, approxNodeData));
   katana::ReportPageAllocGuard page_alloc;
 
   if (auto res = RunAlgo(algo, graph, bidir_view, source); !res) {
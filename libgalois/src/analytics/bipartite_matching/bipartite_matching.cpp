@@ -0,0 +1,483 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/bipartite_matching/bipartite_matching.h"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+using BiDirView = katana::PropertyGraphViews::BiDirectional;
+
+constexpr Node kUnmatched = BipartiteMatchingPlan::kUnmatched;
+
+struct Partner : public katana::PODProperty<uint32_t> {};
+
+using Graph = katana::TypedPropertyGraph<std::tuple<Partner>, std::tuple<>>;
+
+enum Side : uint8_t { kNeither, kLeft, kRight };
+
+katana::Result<katana::NUMAArray<Side>>
+SidesFromProperty(
+    katana::PropertyGraph* pg, const std::string& left_side_property_name) {
+  auto property =
+      KATANA_CHECKED(pg->GetNodeProperty(left_side_property_name));
+  arrow::Datum cast_res = KATANA_CHECKED(arrow::compute::Cast(
+      property, arrow::compute::CastOptions::Unsafe(arrow::boolean())));
+  std::shared_ptr<arrow::ChunkedArray> values = cast_res.chunked_array();
+
+  katana::NUMAArray<Side> sides;
+  sides.allocateInterleaved(values->length());
+
+  uint64_t offset = 0;
+  for (const auto& chunk : values->chunks()) {
+    auto array = std::static_pointer_cast<arrow::BooleanArray>(chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) {
+          if (array->IsNull(i)) {
+            sides[offset + i] = kNeither;
+          } else {
+            sides[offset + i] = array->Value(i) ? kLeft : kRight;
+          }
+        },
+        katana::no_stats());
+    offset += array->length();
+  }
+  return std::move(sides);
+}
+
+katana::Result<katana::NUMAArray<Side>>
+SidesFromNodeTypes(
+    katana::PropertyGraph* pg, const std::string& left_node_type,
+    const std::string& right_node_type) {
+  for (const auto& name : {left_node_type, right_node_type}) {
+    if (!pg->HasAtomicNodeType(name)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotFound, "node type does not exist: {}", name);
+    }
+  }
+  if (left_node_type == right_node_type) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "left and right node types must differ");
+  }
+  katana::EntityTypeID left = pg->GetNodeEntityTypeID(left_node_type);
+  katana::EntityTypeID right = pg->GetNodeEntityTypeID(right_node_type);
+
+  katana::NUMAArray<Side> sides;
+  sides.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(pg->topology().all_nodes()),
+      [&](Node n) {
+        if (pg->DoesNodeHaveType(n, left)) {
+          sides[n] = kLeft;
+        } else if (pg->DoesNodeHaveType(n, right)) {
+          sides[n] = kRight;
+        } else {
+          sides[n] = kNeither;
+        }
+      },
+      katana::no_stats());
+  return std::move(sides);
+}
+
+/// The neighbors of a node through its out-edges followed by its in-edges,
+/// addressed by position so that a search can resume where it stopped.
+class Neighbors {
+public:
+  Neighbors(const BiDirView& view, Node n)
+      : view_(view),
+        out_begin_(*view.edges(n).begin()),
+        num_out_(view.degree(n)),
+        in_begin_(*view.in_edges(n).begin()),
+        size_(num_out_ + view.in_degree(n)) {}
+
+  uint64_t size() const { return size_; }
+
+  Node operator[](uint64_t i) const {
+    if (i < num_out_) {
+      return view_.edge_dest(out_begin_ + i);
+    }
+    return view_.in_edge_dest(in_begin_ + (i - num_out_));
+  }
+
+private:
+  const BiDirView& view_;
+  Edge out_begin_;
+  uint64_t num_out_;
+  Edge in_begin_;
+  uint64_t size_;
+};
+
+/// Parallel Pothen-Fan maximum matching with lookahead and fairness.
+///
+/// A left node is only ever searched from by one thread per phase: either
+/// it is the unmatched root of that thread's search, or it was reached
+/// through its partner, which that thread claimed in visited_. So the
+/// lookahead pointers and the partners along a path have a single writer,
+/// and the partners of right nodes only need atomic loads to be read by
+/// other searches.
+class PothenFan {
+  struct Frame {
+    Node left;
+    /// The right node through which left was reached, its old partner.
+    Node via;
+    uint64_t num_scanned;
+  };
+
+public:
+  PothenFan(const BiDirView& view, const katana::NUMAArray<Side>& sides)
+      : view_(view), sides_(sides) {
+    mate_.allocateInterleaved(view.num_nodes());
+    lookahead_.allocateInterleaved(view.num_nodes());
+    visited_.resize(view.num_nodes());
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, uint64_t{view.num_nodes()}),
+        [&](uint64_t n) {
+          mate_[n].store(kUnmatched, std::memory_order_relaxed);
+          lookahead_[n] = 0;
+        },
+        katana::no_stats());
+  }
+
+  void Run() {
+    GreedyMatch();
+
+    uint64_t num_phases = 0;
+    katana::InsertBag<Node> roots;
+    katana::GAccumulator<uint64_t> num_augmented;
+
+    for (;; ++num_phases) {
+      roots.clear();
+      katana::do_all(
+          katana::iterate(uint64_t{0}, uint64_t{view_.num_nodes()}),
+          [&](uint64_t n) {
+            if (sides_[n] == kLeft && partner(n) == kUnmatched) {
+              roots.push(n);
+            }
+          },
+          katana::no_stats());
+      if (roots.empty()) {
+        break;
+      }
+
+      visited_.reset();
+      num_augmented.reset();
+      // Alternate the direction in which searches scan neighbors so that
+      // one phase does not keep exploring the same dead ends as the last.
+      bool forward = num_phases % 2 == 0;
+      katana::do_all(
+          katana::iterate(roots),
+          [&](const Node& root) {
+            if (Augment(root, forward, stacks_.getLocal())) {
+              num_augmented += 1;
+            }
+          },
+          katana::steal(), katana::loopname("BipartiteMatching-Phase"));
+
+      if (num_augmented.reduce() == 0) {
+        break;
+      }
+    }
+
+    katana::ReportStatSingle("BipartiteMatching", "Phases", num_phases);
+  }
+
+  Node partner(Node n) const {
+    return mate_[n].load(std::memory_order_relaxed);
+  }
+
+private:
+  /// Match each left node to its first right neighbor that is still free.
+  void GreedyMatch() {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, uint64_t{view_.num_nodes()}),
+        [&](uint64_t u) {
+          if (sides_[u] != kLeft) {
+            return;
+          }
+          Neighbors neighbors(view_, u);
+          uint64_t i = 0;
+          while (i < neighbors.size()) {
+            Node v = neighbors[i++];
+            Node expected = kUnmatched;
+            if (sides_[v] == kRight && mate_[v].compare_exchange_strong(
+                                           expected, u,
+                                           std::memory_order_relaxed)) {
+              mate_[u].store(v, std::memory_order_relaxed);
+              break;
+            }
+          }
+          // Right nodes never become unmatched, so those skipped here
+          // never need to be looked at again.
+          lookahead_[u] = i;
+        },
+        katana::steal(), katana::loopname("BipartiteMatching-Greedy"));
+  }
+
+  /// Search for an augmenting path from root and flip it if one is found.
+  bool Augment(Node root, bool forward, std::vector<Frame>* stack) {
+    stack->clear();
+    stack->push_back({root, kUnmatched, 0});
+
+    while (!stack->empty()) {
+      Node u = stack->back().left;
+      Neighbors neighbors(view_, u);
+
+      // Lookahead: a free right neighbor ends the path right away.
+      uint64_t& next = lookahead_[u];
+      while (next < neighbors.size()) {
+        Node v = neighbors[next++];
+        if (sides_[v] == kRight && partner(v) == kUnmatched &&
+            !visited_.set(v)) {
+          Flip(*stack, v);
+          return true;
+        }
+      }
+
+      bool descended = false;
+      Frame& top = stack->back();
+      while (top.num_scanned < neighbors.size()) {
+        uint64_t i = forward ? top.num_scanned
+                             : neighbors.size() - 1 - top.num_scanned;
+        ++top.num_scanned;
+        Node v = neighbors[i];
+        if (sides_[v] != kRight || visited_.set(v)) {
+          continue;
+        }
+        Node w = partner(v);
+        if (w == kUnmatched) {
+          Flip(*stack, v);
+          return true;
+        }
+        stack->push_back({w, v, 0});
+        descended = true;
+        break;
+      }
+      if (!descended) {
+        stack->pop_back();
+      }
+    }
+    return false;
+  }
+
+  /// Match the last left node on the stack with the free right node v and
+  /// shift the partners of every left node on the path.
+  void Flip(const std::vector<Frame>& path, Node v) {
+    for (size_t i = path.size(); i-- > 0;) {
+      Node u = path[i].left;
+      mate_[u].store(v, std::memory_order_relaxed);
+      mate_[v].store(u, std::memory_order_relaxed);
+      v = path[i].via;
+    }
+  }
+
+  const BiDirView& view_;
+  const katana::NUMAArray<Side>& sides_;
+  katana::NUMAArray<std::atomic<Node>> mate_;
+  /// Position of the next neighbor to try in a lookahead.
+  katana::NUMAArray<uint64_t> lookahead_;
+  katana::DynamicBitset visited_;
+  katana::PerThreadStorage<std::vector<Frame>> stacks_;
+};
+
+katana::Result<void>
+BipartiteMatchingImpl(
+    katana::PropertyGraph* pg, const katana::NUMAArray<Side>& sides,
+    const std::string& output_property_name, BipartiteMatchingPlan plan) {
+  if (plan.algorithm() != BipartiteMatchingPlan::kPothenFan) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "unknown bipartite matching algorithm");
+  }
+
+  KATANA_CHECKED(
+      ConstructNodeProperties<std::tuple<Partner>>(pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  katana::StatTimer exec_time("BipartiteMatching");
+  exec_time.start();
+
+  auto view = pg->BuildView<BiDirView>();
+  PothenFan matcher(view, sides);
+  matcher.Run();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) { graph.GetData<Partner>(n) = matcher.partner(n); },
+      katana::no_stats());
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+BipartiteMatchingValidateImpl(
+    katana::PropertyGraph* pg, const katana::NUMAArray<Side>& sides,
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+  auto view = pg->BuildView<BiDirView>();
+  const uint64_t num_nodes = view.num_nodes();
+
+  auto partner = [&](Node n) -> Node { return graph.GetData<Partner>(n); };
+
+  for (Node n = 0; n < num_nodes; ++n) {
+    Node p = partner(n);
+    if (p == kUnmatched) {
+      continue;
+    }
+    if (p >= num_nodes || partner(p) != n) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "partner of node {} is {} but its partner is not {}", n, p, n);
+    }
+    if (sides[n] == kNeither || sides[p] == kNeither || sides[n] == sides[p]) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "nodes {} and {} are matched but not on opposite sides", n, p);
+    }
+    bool adjacent = false;
+    Neighbors neighbors(view, n);
+    for (uint64_t i = 0; i < neighbors.size() && !adjacent; ++i) {
+      adjacent = neighbors[i] == p;
+    }
+    if (!adjacent) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "nodes {} and {} are matched but not adjacent", n, p);
+    }
+  }
+
+  // By Berge's lemma the matching is maximum if no alternating path from an
+  // unmatched left node reaches an unmatched right node.
+  std::vector<bool> reached(num_nodes, false);
+  std::deque<Node> queue;
+  for (Node n = 0; n < num_nodes; ++n) {
+    if (sides[n] == kLeft && partner(n) == kUnmatched) {
+      reached[n] = true;
+      queue.push_back(n);
+    }
+  }
+  while (!queue.empty()) {
+    Node u = queue.front();
+    queue.pop_front();
+    Neighbors neighbors(view, u);
+    for (uint64_t i = 0; i < neighbors.size(); ++i) {
+      Node v = neighbors[i];
+      if (sides[v] != kRight || reached[v]) {
+        continue;
+      }
+      reached[v] = true;
+      Node w = partner(v);
+      if (w == kUnmatched) {
+        return KATANA_ERROR(
+            katana::ErrorCode::AssertionFailed,
+            "matching is not maximum: an augmenting path ends at node {}", v);
+      }
+      if (!reached[w]) {
+        reached[w] = true;
+        queue.push_back(w);
+      }
+    }
+  }
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::BipartiteMatching(
+    PropertyGraph* pg, const std::string& left_side_property_name,
+    const std::string& output_property_name, BipartiteMatchingPlan plan) {
+  katana::NUMAArray<Side> sides =
+      KATANA_CHECKED(SidesFromProperty(pg, left_side_property_name));
+  return BipartiteMatchingImpl(pg, sides, output_property_name, plan);
+}
+
+katana::Result<void>
+katana::analytics::BipartiteMatchingByNodeTypes(
+    PropertyGraph* pg, const std::string& left_node_type,
+    const std::string& right_node_type, const std::string& output_property_name,
+    BipartiteMatchingPlan plan) {
+  katana::NUMAArray<Side> sides =
+      KATANA_CHECKED(SidesFromNodeTypes(pg, left_node_type, right_node_type));
+  return BipartiteMatchingImpl(pg, sides, output_property_name, plan);
+}
+
+katana::Result<void>
+katana::analytics::BipartiteMatchingAssertValid(
+    PropertyGraph* pg, const std::string& left_side_property_name,
+    const std::string& property_name) {
+  katana::NUMAArray<Side> sides =
+      KATANA_CHECKED(SidesFromProperty(pg, left_side_property_name));
+  return BipartiteMatchingValidateImpl(pg, sides, property_name);
+}
+
+katana::Result<void>
+katana::analytics::BipartiteMatchingByNodeTypesAssertValid(
+    PropertyGraph* pg, const std::string& left_node_type,
+    const std::string& right_node_type, const std::string& property_name) {
+  katana::NUMAArray<Side> sides =
+      KATANA_CHECKED(SidesFromNodeTypes(pg, left_node_type, right_node_type));
+  return BipartiteMatchingValidateImpl(pg, sides, property_name);
+}
+
+katana::Result<BipartiteMatchingStatistics>
+katana::analytics::BipartiteMatchingStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GAccumulator<uint64_t> num_matched_nodes;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        if (graph.GetData<Partner>(n) != kUnmatched) {
+          num_matched_nodes += 1;
+        }
+      },
+      katana::loopname("Compute Statistics"), katana::no_stats());
+
+  uint64_t matched = num_matched_nodes.reduce();
+  return BipartiteMatchingStatistics{matched / 2, graph.num_nodes() - matched};
+}
+
+void
+katana::analytics::BipartiteMatchingStatistics::Print(std::ostream& os) const {
+  os << "Number of matched pairs = " << num_matched_pairs << std::endl;
+  os << "Number of unmatched nodes = " << num_unmatched_nodes << std::endl;
+}
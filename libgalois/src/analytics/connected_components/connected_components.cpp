@@ -20,6 +20,10 @@
 #include "katana/analytics/connected_components/connected_components.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Frontier.h"
+#include "katana/GraphTopology.h"
+#include "katana/ParallelSTL.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -118,30 +122,35 @@ struct ConnectedComponentsLabelPropAlgo {
   void Deallocate(Graph*) {}
 
   void operator()(Graph* graph) {
-    katana::GReduceLogicalOr changed;
-    do {
-      changed.reset();
-      katana::do_all(
-          katana::iterate(*graph),
+    //! Only nodes whose label was lowered in the last round push it again;
+    //! rounds that lower many labels keep the nodes in a bitset.
+    katana::Frontier active(graph->size());
+    katana::Frontier next(graph->size());
+    active.Fill();
+    while (!active.empty()) {
+      active.ForEach(
           [&](const GNode& src) {
             auto& sdata_current_comp = graph->GetData<NodeComponent>(src);
             auto& sdata_old_comp = old_component_[src];
             if (sdata_old_comp > sdata_current_comp) {
               sdata_old_comp = sdata_current_comp;
 
-              changed.update(true);
-
               for (auto e : graph->edges(src)) {
                 auto dest = graph->GetEdgeDest(e);
                 auto& ddata_current_comp = graph->GetData<NodeComponent>(dest);
                 ComponentType label_new = sdata_current_comp;
-                katana::atomicMin(ddata_current_comp, label_new);
+                if (katana::atomicMin(ddata_current_comp, label_new) >
+                    label_new) {
+                  next.Push(*dest);
+                }
               }
             }
           },
-          katana::disable_conflict_detection(), katana::steal(),
-          katana::loopname("ConnectedComponentsLabelPropAlgo"));
-    } while (changed.reduce());
+          "ConnectedComponentsLabelPropAlgo");
+      next.Adapt();
+      active.Clear();
+      active.swap(next);
+    }
   }
 };
 
@@ -488,6 +497,55 @@ struct ConnectedComponentsBlockedAsynchronousAlgo {
   }
 };
 
+/// Edge tiles of tile_size consecutive edges, which may span several nodes.
+/// An EdgeSourceIndex with stride tile_size holds the source of the first
+/// edge of each tile, so tiles need neither a work list nor a pass over the
+/// nodes to build one.
+class EdgeTiles {
+public:
+  EdgeTiles(const katana::GraphTopology& topology, ptrdiff_t tile_size)
+      : topology_(topology),
+        index_(katana::EdgeSourceIndex::Make(topology, TileStride(tile_size))),
+        num_tiles_(
+            (topology.num_edges() + index_->stride() - 1) / index_->stride()) {
+  }
+
+  /// The range of tile IDs to pass to do_all
+  auto iterate() const { return katana::iterate(uint64_t{0}, num_tiles_); }
+
+  /// Call fn(src, begin, end) for the edges [begin, end) of src in tile
+  template <typename Func>
+  void ForEachSource(uint64_t tile, Func&& fn) const {
+    using Edge = katana::GraphTopology::Edge;
+    Edge begin = tile * index_->stride();
+    Edge end = std::min<Edge>(begin + index_->stride(), topology_.num_edges());
+    auto src = index_->edge_source(begin);
+    while (begin < end) {
+      Edge node_end = std::min<Edge>(*topology_.edges(src).end(), end);
+      if (begin < node_end) {
+        fn(src, begin, node_end);
+      }
+      begin = node_end;
+      ++src;
+    }
+  }
+
+  katana::GraphTopology::Node edge_dest(katana::GraphTopology::Edge e) const {
+    return index_->edge_dest(e);
+  }
+
+private:
+  static uint32_t TileStride(ptrdiff_t tile_size) {
+    KATANA_LOG_ASSERT(tile_size > 0);
+    return std::min<ptrdiff_t>(
+        tile_size, std::numeric_limits<uint32_t>::max());
+  }
+
+  const katana::GraphTopology& topology_;
+  std::unique_ptr<katana::EdgeSourceIndex> index_;
+  uint64_t num_tiles_;
+};
+
 struct ConnectedComponentsEdgeTiledAsynchronousAlgo {
   using ComponentType = ConnectedComponentsNode*;
   struct NodeComponent : public katana::PODProperty<uint64_t, ComponentType> {};
@@ -517,60 +575,30 @@ struct ConnectedComponentsEdgeTiledAsynchronousAlgo {
     });
   }
 
-  struct EdgeTile {
-    // ConnectedComponentsNode* sData;
-    GNode src;
-    Graph::edge_iterator beg;
-    Graph::edge_iterator end;
-  };
-
-  /*struct EdgeTileMaker {
-      EdgeTile operator() (ConnectedComponentsNode* sdata, Graph::edge_iterator beg,
-  Graph::edge_iterator end) const{ return EdgeTile{sdata, beg, end};
-      }
-  };*/
-
   void operator()(Graph* graph) {
     katana::GAccumulator<size_t> empty_merges;
 
-    katana::InsertBag<EdgeTile> works;
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const GNode& src) {
-          auto beg = graph->edge_begin(src);
-          const auto& end = graph->edge_end(src);
-
-          KATANA_LOG_DEBUG_ASSERT(beg <= end);
-          if ((end - beg) > plan_.edge_tile_size()) {
-            for (; beg + plan_.edge_tile_size() < end;) {
-              const auto& ne = beg + plan_.edge_tile_size();
-              KATANA_LOG_DEBUG_ASSERT(ne < end);
-              works.push_back(EdgeTile{src, beg, ne});
-              beg = ne;
-            }
-          }
-
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
-        },
-        katana::loopname("CC-EdgeTiledAsynchronousInit"), katana::steal());
+    katana::StatTimer StatTimer_Tiling("CC-EdgeTiledAsynchronousInit");
+    StatTimer_Tiling.start();
+    EdgeTiles tiles(
+        graph->GetPropertyGraph().topology(), plan_.edge_tile_size());
+    StatTimer_Tiling.stop();
 
     katana::do_all(
-        katana::iterate(works),
-        [&](const EdgeTile& tile) {
-          const auto& src = tile.src;
-          auto& sdata = graph->GetData<NodeComponent>(src);
-
-          for (auto ii = tile.beg; ii != tile.end; ++ii) {
-            auto dest = graph->GetEdgeDest(ii);
-            if (src >= *dest)
-              continue;
+        tiles.iterate(),
+        [&](uint64_t tile) {
+          tiles.ForEachSource(tile, [&](GNode src, auto beg, auto end) {
+            auto& sdata = graph->GetData<NodeComponent>(src);
+            for (auto ii = beg; ii != end; ++ii) {
+              auto dest = tiles.edge_dest(ii);
+              if (src >= dest)
+                continue;
 
-            auto& ddata = graph->GetData<NodeComponent>(dest);
-            if (!sdata->merge(ddata))
-              empty_merges += 1;
-          }
+              auto& ddata = graph->GetData<NodeComponent>(dest);
+              if (!sdata->merge(ddata))
+                empty_merges += 1;
+            }
+          });
         },
         katana::loopname("CC-edgetiledAsynchronous"), katana::steal(),
         katana::chunk_size<ConnectedComponentsPlan::kChunkSize>()  // 16 -> 1
@@ -1007,12 +1035,6 @@ struct ConnectedComponentsEdgeTiledAfforestAlgo {
 
   using ComponentType = NodeAfforest::ComponentType;
 
-  struct EdgeTile {
-    GNode src;
-    Graph::edge_iterator beg;
-    Graph::edge_iterator end;
-  };
-
   void operator()(Graph* graph) {
     // (bozhi) should NOT go through single direction in sampling step: nodes
     // with edges less than NEIGHBOR_SAMPLES will fail
@@ -1046,41 +1068,28 @@ struct ConnectedComponentsEdgeTiledAfforestAlgo {
             graph, plan_.component_sample_frequency());
     StatTimer_Sampling.stop();
 
-    katana::InsertBag<EdgeTile> works;
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const GNode& src) {
-          auto& sdata = graph->GetData<NodeComponent>(src);
-          if (sdata->component() == c)
-            return;
-          auto beg = graph->edge_begin(src);
-          const auto end = graph->edge_end(src);
-
-          for (std::advance(beg, plan_.neighbor_sample_size());
-               beg + plan_.edge_tile_size() < end;) {
-            auto ne = beg + plan_.edge_tile_size();
-            KATANA_LOG_DEBUG_ASSERT(ne < end);
-            works.push_back(EdgeTile{src, beg, ne});
-            beg = ne;
-          }
-
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
-        },
-        katana::loopname("EdgetiledAfforest-LCS-Tiling"), katana::steal());
+    katana::StatTimer StatTimer_Tiling("EdgetiledAfforest-LCS-Tiling");
+    StatTimer_Tiling.start();
+    EdgeTiles tiles(
+        graph->GetPropertyGraph().topology(), plan_.edge_tile_size());
+    StatTimer_Tiling.stop();
 
     katana::do_all(
-        katana::iterate(works),
-        [&](const EdgeTile& tile) {
-          auto& sdata = graph->GetData<NodeComponent>(tile.src);
-          if (sdata->component() == c)
-            return;
-          for (auto ii = tile.beg; ii < tile.end; ++ii) {
-            auto dest = graph->GetEdgeDest(ii);
-            auto& ddata = graph->GetData<NodeComponent>(dest);
-            sdata->link(ddata);
-          }
+        tiles.iterate(),
+        [&](uint64_t tile) {
+          tiles.ForEachSource(tile, [&](GNode src, auto beg, auto end) {
+            auto& sdata = graph->GetData<NodeComponent>(src);
+            if (sdata->component() == c)
+              return;
+            // The first neighbors were linked by the sampling step
+            beg = std::max<decltype(beg)>(
+                beg, *graph->edge_begin(src) + plan_.neighbor_sample_size());
+            for (auto ii = beg; ii < end; ++ii) {
+              auto dest = tiles.edge_dest(ii);
+              auto& ddata = graph->GetData<NodeComponent>(dest);
+              sdata->link(ddata);
+            }
+          });
         },
         katana::steal(),
         katana::chunk_size<ConnectedComponentsPlan::kChunkSize>(),
@@ -1103,9 +1112,9 @@ static katana::Result<void>
 ConnectedComponentsWithWrap(
     katana::PropertyGraph* pg, std::string output_property_name,
     ConnectedComponentsPlan plan) {
-  katana::EnsurePreallocated(
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
       2,
-      pg->topology().num_nodes() * sizeof(typename Algorithm::NodeComponent));
+      pg->topology().num_nodes() * sizeof(typename Algorithm::NodeComponent)));
   katana::ReportPageAllocGuard page_alloc;
 
   if (auto r = ConstructNodeProperties<
@@ -1178,6 +1187,240 @@ katana::analytics::ConnectedComponents(
   }
 }
 
+namespace {
+
+using IncrementalComponentType = uint64_t;
+struct IncrementalNodeComponent
+    : public katana::PODProperty<IncrementalComponentType> {};
+using IncrementalGraph = katana::TypedPropertyGraph<
+    std::tuple<IncrementalNodeComponent>, std::tuple<>>;
+using IncrementalGNode = IncrementalGraph::Node;
+
+/// A component touched by a batch of new edges, with one of its nodes.
+using ComponentSeed = std::pair<IncrementalComponentType, IncrementalGNode>;
+
+/// Give the nodes with a null component, which were added after the
+/// components were computed, a component of their own.
+katana::Result<void>
+FillNullComponents(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto column = KATANA_CHECKED(pg->GetNodeProperty(property_name));
+  if (column->null_count() == 0) {
+    return katana::ResultSuccess();
+  }
+  if (!column->type()->Equals(arrow::uint64())) {
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "property {} has type {}, expected {}",
+        property_name, column->type()->ToString(),
+        arrow::uint64()->ToString());
+  }
+
+  std::vector<IncrementalComponentType> components(pg->num_nodes());
+  int64_t offset = 0;
+  for (const auto& chunk : column->chunks()) {
+    auto array = std::static_pointer_cast<arrow::UInt64Array>(chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) {
+          components[offset + i] =
+              array->IsNull(i)
+                  ? std::numeric_limits<IncrementalComponentType>::max() -
+                        (offset + i)
+                  : array->Value(i);
+        },
+        katana::no_stats());
+    offset += array->length();
+  }
+
+  arrow::UInt64Builder builder;
+  KATANA_CHECKED(builder.AppendValues(components));
+  std::shared_ptr<arrow::Array> array = KATANA_CHECKED(builder.Finish());
+  return pg->UpsertNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field(property_name, arrow::uint64())}), {array}));
+}
+
+/// Relabel the components seeds[members[i]].first, which are now connected,
+/// to a single component. The components are traversed in lockstep, one node
+/// of each at a time, until at most one has nodes left to visit. That one is
+/// at least as large as the others, so it keeps its label and the work is
+/// bounded by the sizes of the others. Returns the number of relabeled nodes.
+uint64_t
+MergeComponents(
+    IncrementalGraph* graph, const std::vector<ComponentSeed>& seeds,
+    const std::vector<uint32_t>& members, katana::DynamicBitset* visited) {
+  struct Traversal {
+    IncrementalComponentType component;
+    std::vector<IncrementalGNode> nodes;
+    size_t next;
+
+    bool done() const { return next == nodes.size(); }
+  };
+
+  std::vector<Traversal> traversals;
+  for (uint32_t m : members) {
+    traversals.emplace_back(
+        Traversal{seeds[m].first, {seeds[m].second}, size_t{0}});
+    visited->set(seeds[m].second);
+  }
+
+  size_t num_active = traversals.size();
+  while (num_active > 1) {
+    num_active = 0;
+    for (auto& t : traversals) {
+      if (t.done()) {
+        continue;
+      }
+      IncrementalGNode n = t.nodes[t.next++];
+      for (auto e : graph->edges(n)) {
+        auto dest = *graph->GetEdgeDest(e);
+        // New edges only join components of this set, so following edges
+        // within the component never reaches another set.
+        if (graph->GetData<IncrementalNodeComponent>(dest) == t.component &&
+            !visited->set(dest)) {
+          t.nodes.emplace_back(dest);
+        }
+      }
+      if (!t.done()) {
+        ++num_active;
+      }
+    }
+  }
+
+  auto winner = std::max_element(
+      traversals.begin(), traversals.end(),
+      [](const Traversal& a, const Traversal& b) {
+        return std::make_pair(!a.done(), a.nodes.size()) <
+               std::make_pair(!b.done(), b.nodes.size());
+      });
+
+  uint64_t num_relabeled = 0;
+  for (auto& t : traversals) {
+    if (&t != &*winner) {
+      for (IncrementalGNode n : t.nodes) {
+        graph->GetData<IncrementalNodeComponent>(n) = winner->component;
+      }
+      num_relabeled += t.nodes.size();
+    }
+    for (IncrementalGNode n : t.nodes) {
+      visited->reset(n);
+    }
+  }
+  return num_relabeled;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::ConnectedComponentsIncremental(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests) {
+  if (new_edge_srcs.size() != new_edge_dests.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "got {} sources but {} destinations", new_edge_srcs.size(),
+        new_edge_dests.size());
+  }
+  for (size_t i = 0; i < new_edge_srcs.size(); ++i) {
+    if (new_edge_srcs[i] >= pg->num_nodes() ||
+        new_edge_dests[i] >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge {} -> {} out of range; graph has {} nodes", new_edge_srcs[i],
+          new_edge_dests[i], pg->num_nodes());
+    }
+  }
+
+  KATANA_CHECKED(FillNullComponents(pg, property_name));
+  auto graph = KATANA_CHECKED(IncrementalGraph::Make(pg, {property_name}, {}));
+
+  katana::StatTimer exec_time("ConnectedComponentIncremental");
+  exec_time.start();
+
+  // The components touched by the batch, each with one node to start
+  // traversing it from.
+  const size_t num_new_edges = new_edge_srcs.size();
+  std::vector<ComponentSeed> seeds(2 * num_new_edges);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_new_edges),
+      [&](size_t i) {
+        IncrementalGNode src = new_edge_srcs[i];
+        IncrementalGNode dest = new_edge_dests[i];
+        seeds[2 * i] = {graph.GetData<IncrementalNodeComponent>(src), src};
+        seeds[2 * i + 1] = {
+            graph.GetData<IncrementalNodeComponent>(dest), dest};
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(seeds.begin(), seeds.end());
+  seeds.erase(
+      std::unique(
+          seeds.begin(), seeds.end(),
+          [](const ComponentSeed& a, const ComponentSeed& b) {
+            return a.first == b.first;
+          }),
+      seeds.end());
+  auto index_of = [&](IncrementalComponentType component) -> uint32_t {
+    return std::lower_bound(
+               seeds.begin(), seeds.end(),
+               ComponentSeed{component, IncrementalGNode{0}}) -
+           seeds.begin();
+  };
+
+  // Union the touched components with the hooking of Afforest, whose roots
+  // are the smallest members of their sets.
+  using LabelSet = ConnectedComponentsAfforestAlgo::NodeAfforest;
+  katana::NUMAArray<LabelSet> label_sets;
+  label_sets.allocateBlocked(seeds.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, seeds.size()),
+      [&](size_t i) { new (&label_sets[i]) LabelSet(); }, katana::no_stats());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_new_edges),
+      [&](size_t i) {
+        uint32_t a = index_of(
+            graph.GetData<IncrementalNodeComponent>(new_edge_srcs[i]));
+        uint32_t b = index_of(
+            graph.GetData<IncrementalNodeComponent>(new_edge_dests[i]));
+        if (a != b) {
+          label_sets[a].link(&label_sets[b]);
+        }
+      },
+      katana::steal(), katana::loopname("Incremental-Link"));
+  katana::do_all(
+      katana::iterate(size_t{0}, seeds.size()),
+      [&](size_t i) { label_sets[i].compress(); }, katana::no_stats());
+
+  std::vector<std::vector<uint32_t>> members(seeds.size());
+  for (uint32_t i = 0; i < seeds.size(); ++i) {
+    members[label_sets[i].component() - &label_sets[0]].emplace_back(i);
+  }
+  std::vector<uint32_t> merged;
+  for (uint32_t i = 0; i < seeds.size(); ++i) {
+    if (members[i].size() > 1) {
+      merged.emplace_back(i);
+    }
+  }
+
+  katana::DynamicBitset visited;
+  visited.resize(graph.size());
+  katana::GAccumulator<uint64_t> num_relabeled;
+  katana::do_all(
+      katana::iterate(merged),
+      [&](uint32_t root) {
+        num_relabeled +=
+            MergeComponents(&graph, seeds, members[root], &visited);
+      },
+      katana::steal(), katana::loopname("Incremental-Relabel"));
+
+  exec_time.stop();
+  katana::ReportStatSingle(
+      "ConnectedComponentIncremental", "MergedComponents", merged.size());
+  katana::ReportStatSingle(
+      "ConnectedComponentIncremental", "RelabeledNodes",
+      num_relabeled.reduce());
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 katana::analytics::ConnectedComponentsAssertValid(
     PropertyGraph* pg, const std::string& property_name) {
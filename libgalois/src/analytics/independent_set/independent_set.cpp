@@ -619,9 +619,9 @@ Run(katana::PropertyGraph* pg, const std::string& output_property_name) {
 
   impl.Initialize(&graph);
 
-  katana::EnsurePreallocated(
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
       1, kChunkSize * (sizeof(GNode) + sizeof(typename Algo::NodeFlag)) *
-             graph.size());
+             graph.size()));
 
   katana::ReportPageAllocGuard page_alloc;
   katana::StatTimer exec_time("IndependentSet");
@@ -20,6 +20,7 @@
 #include "katana/analytics/k_core/k_core.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/Frontier.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 
@@ -64,13 +65,14 @@ DegreeCounting(Graph* graph) {
  * Setup initial worklist of dead nodes.
  *
  * @param graph Graph to operate on
- * @param initial_worklist Empty worklist to be filled with dead nodes.
  * @param k_core_number Each node in the core is expected to have degree <= k_core_number.
+ * @param push_dead Called in parallel with each dead node to add it to the
+ * worklist for processing later.
  */
+template <typename PushFn>
 void
 SetupInitialWorklist(
-    const Graph& graph, katana::InsertBag<GNode>& initial_worklist,
-    uint32_t k_core_number) {
+    const Graph& graph, uint32_t k_core_number, const PushFn& push_dead) {
   katana::do_all(
       katana::iterate(graph),
       [&](const GNode& node) {
@@ -78,7 +80,7 @@ SetupInitialWorklist(
             graph.GetData<KCoreNodeCurrentDegree>(node);
         if (node_current_degree < k_core_number) {
           //! Dead node, add to initial_worklist for processing later.
-          initial_worklist.emplace(node);
+          push_dead(node);
         }
       },
       katana::loopname("InitialWorklistSetup"), katana::no_stats());
@@ -94,19 +96,21 @@ SetupInitialWorklist(
  */
 void
 SyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
-  auto current = std::make_unique<katana::InsertBag<GNode>>();
-  auto next = std::make_unique<katana::InsertBag<GNode>>();
+  //! Rounds that kill many nodes keep them in a bitset.
+  katana::Frontier current(graph->num_nodes());
+  katana::Frontier next(graph->num_nodes());
 
   //! Setup worklist.
-  SetupInitialWorklist(*graph, *next, k_core_number);
+  SetupInitialWorklist(
+      *graph, k_core_number, [&](const GNode& node) { next.Push(node); });
+  next.Adapt();
 
-  while (!next->empty()) {
+  while (!next.empty()) {
     //! Make "next" into current.
-    std::swap(current, next);
-    next->clear();
+    current.swap(next);
+    next.Clear();
 
-    katana::do_all(
-        katana::iterate(*current),
+    current.ForEach(
         [&](const GNode& dead_node) {
           //! Decrement degree of all neighbors.
           for (auto e : graph->edges(dead_node)) {
@@ -118,12 +122,12 @@ SyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
             if (old_degree == k_core_number) {
               //! This thread was responsible for putting degree of destination
               //! below threshold; add to worklist.
-              next->emplace(*dest);
+              next.Push(*dest);
             }
           }
         },
-        katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
-        katana::loopname("KCore Synchronous"));
+        "KCore Synchronous");
+    next.Adapt();
   }
 }
 
@@ -139,7 +143,9 @@ void
 AsyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
   katana::InsertBag<GNode> initial_worklist;
   //! Setup worklist.
-  SetupInitialWorklist(*graph, initial_worklist, k_core_number);
+  SetupInitialWorklist(*graph, k_core_number, [&](const GNode& node) {
+    initial_worklist.emplace(node);
+  });
 
   katana::for_each(
       katana::iterate(initial_worklist),
@@ -197,7 +203,7 @@ KCoreImpl(
         std::tuple<KCoreNodeCurrentDegree>, std::tuple<>>* graph,
     KCorePlan algo, uint32_t k_core_number) {
   size_t approxNodeData = 4 * (graph->num_nodes() + graph->num_edges());
-  katana::EnsurePreallocated(8, approxNodeData);
+  KATANA_CHECKED(katana::TryEnsurePreallocated(8, approxNodeData));
   katana::ReportPageAllocGuard page_alloc;
 
   //! Intialization of degrees.
@@ -111,6 +111,9 @@ struct LeidenClusteringImplementation
     }
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeWeightType>>
+        cluster_weights_storage;
+
     while (true) {
       num_iter++;
 
@@ -132,23 +135,20 @@ struct LeidenClusteringImplementation
             uint64_t degree =
                 std::distance(graph.edge_begin(n), graph.edge_end(n));
             uint64_t local_target = Base::UNASSIGNED;
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            // Edge weight to each neighboring cluster
+            auto& cluster_weights = *cluster_weights_storage.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  graph, n, cluster_local_map, counter, self_loop_wt);
+                  graph, n, cluster_weights, self_loop_wt);
               // Find the max gain in modularity
               // local_target = Base::MaxModularityWithoutSwaps(
               //     cluster_local_map, counter, self_loop_wt, c_info,
               //     n_data_degree_wt, n_data_curr_comm_id,
               //     constant_for_second_term);
               local_target = Base::MaxCPMQualityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
+                  cluster_weights, self_loop_wt, c_info,
                   n_data_node_wt, n_data_curr_comm_id, resolution);
 
             } else {
@@ -298,6 +298,9 @@ struct LeidenClusteringImplementation
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeWeightType>>
+        cluster_weights_storage;
+
     while (true) {
       num_iter++;
 
@@ -316,19 +319,16 @@ struct LeidenClusteringImplementation
               uint64_t degree =
                   std::distance(graph.edge_begin(n), graph.edge_end(n));
 
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              // Edge weight to each neighboring cluster
+              auto& cluster_weights = *cluster_weights_storage.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    graph, n, cluster_local_map, counter, self_loop_wt);
+                    graph, n, cluster_weights, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
+                    cluster_weights, self_loop_wt, c_info,
                     n_data_degree_wt, n_data_curr_comm_id,
                     constant_for_second_term);
 
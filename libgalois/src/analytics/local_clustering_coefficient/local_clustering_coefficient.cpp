@@ -20,6 +20,7 @@
 #include "katana/analytics/local_clustering_coefficient/local_clustering_coefficient.h"
 
 #include "katana/AtomicHelpers.h"
+#include "katana/EdgeBalancedRange.h"
 
 using namespace katana::analytics;
 
@@ -43,13 +44,16 @@ struct LocalClusteringCoefficientAtomics {
    *
    * Uses simple 3-level nested algorithm to find
    * triangles. It assumes that edgelist of each node
-   * is sorted.
+   * is sorted. Only the edges of n in edges_n_range are
+   * visited, so the edges of a node can be split among
+   * threads.
    */
-  template <typename CountVec>
+  template <typename CountVec, typename EdgeRange>
   void OrderedCountFunc(
-      const SortedGraphView& graph, Node n, CountVec* count_vec) {
+      const SortedGraphView& graph, Node n, const EdgeRange& edges_n_range,
+      CountVec* count_vec) {
     // TODO(amber): replace with NodeIteratingAlgo for triangle counting
-    for (auto edges_n : graph.edges(n)) {
+    for (auto edges_n : edges_n_range) {
       auto v = graph.edge_dest(edges_n);
       if (v > n) {
         break;
@@ -81,12 +85,13 @@ struct LocalClusteringCoefficientAtomics {
         per_node_triangles.begin(), per_node_triangles.end(), uint32_t{0});
 
     // Count triangles
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const Node& n) {
-          OrderedCountFunc(*graph, n, &per_node_triangles);
+    auto ranges = katana::EdgeBalancedRanges::Make(*graph);
+    ranges.ReportImbalance("LocalClusteringCoefficient");
+    ranges.ForEachEdgeRange(
+        *graph,
+        [&](const Node& n, const auto& edges) {
+          OrderedCountFunc(*graph, n, edges, &per_node_triangles);
         },
-        katana::chunk_size<kChunkSize>(), katana::steal(),
         katana::loopname("TriangleCount_OrderedCountAlgo"));
 
     katana::do_all(
@@ -129,12 +134,16 @@ struct LocalClusteringCoefficientPerThread {
  *
  * Uses simple 3-level nested algorithm to find
  * triangles. It assumes that edgelist of each node
- * is sorted.
+ * is sorted. Only the edges of n in edges_n_range are
+ * visited, so the edges of a node can be split among
+ * threads.
  */
+  template <typename EdgeRange>
   void OrderedCountFunc(
-      const SortedGraphView& graph, Node n, IterPair per_thread_count_range) {
+      const SortedGraphView& graph, Node n, const EdgeRange& edges_n_range,
+      IterPair per_thread_count_range) {
     // TODO(amber): replace with NodeIteratingAlgo for triangle counting
-    for (auto edges_n : graph.edges(n)) {
+    for (auto edges_n : edges_n_range) {
       auto v = graph.edge_dest(edges_n);
       if (v > n) {
         break;
@@ -180,13 +189,14 @@ struct LocalClusteringCoefficientPerThread {
           all_thread_count_vec.begin(), all_thread_count_vec.end(), tid, numT);
     });
 
-    katana::do_all(
-        katana::iterate(graph),
-        [&](const Node& n) {
+    auto ranges = katana::EdgeBalancedRanges::Make(graph, num_threads);
+    ranges.ReportImbalance("LocalClusteringCoefficient");
+    ranges.ForEachEdgeRange(
+        graph,
+        [&](const Node& n, const auto& edges) {
           OrderedCountFunc(
-              graph, n, *per_thread_node_triangle_count.getLocal());
+              graph, n, edges, *per_thread_node_triangle_count.getLocal());
         },
-        katana::chunk_size<kChunkSize>(), katana::steal(),
         katana::loopname("TriangleCount_OrderedCountAlgo"));
 
     katana::do_all(
@@ -309,7 +319,8 @@ katana::analytics::LocalClusteringCoefficient(
 
   timer_graph_read.stop();
 
-  katana::EnsurePreallocated(1, 16 * (pg->num_nodes() + pg->num_edges()));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      1, 16 * (pg->num_nodes() + pg->num_edges())));
 
   switch (plan.algorithm()) {
   case LocalClusteringCoefficientPlan::kOrderedCountAtomics: {
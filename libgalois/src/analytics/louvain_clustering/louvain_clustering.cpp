@@ -89,6 +89,9 @@ struct LouvainClusteringImplementation
 
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeWeightType>>
+        cluster_weights_storage;
+
     while (true) {
       num_iter++;
 
@@ -108,19 +111,16 @@ struct LouvainClusteringImplementation
             uint64_t degree =
                 std::distance(graph.edge_begin(n), graph.edge_end(n));
             uint64_t local_target = Base::UNASSIGNED;
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            // Edge weight to each neighboring cluster
+            auto& cluster_weights = *cluster_weights_storage.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  graph, n, cluster_local_map, counter, self_loop_wt);
+                  graph, n, cluster_weights, self_loop_wt);
               // Find the max gain in modularity
               local_target = Base::MaxModularityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
+                  cluster_weights, self_loop_wt, c_info,
                   n_data_degree_wt, n_data_curr_comm_id,
                   constant_for_second_term);
 
@@ -243,6 +243,9 @@ struct LouvainClusteringImplementation
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
+    katana::PerThreadStorage<ClusterWeightAccumulator<EdgeWeightType>>
+        cluster_weights_storage;
+
     while (true) {
       num_iter++;
 
@@ -260,19 +263,16 @@ struct LouvainClusteringImplementation
               uint64_t degree =
                   std::distance(graph.edge_begin(n), graph.edge_end(n));
 
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              // Edge weight to each neighboring cluster
+              auto& cluster_weights = *cluster_weights_storage.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    graph, n, cluster_local_map, counter, self_loop_wt);
+                    graph, n, cluster_weights, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
+                    cluster_weights, self_loop_wt, c_info,
                     n_data_degree_wt, n_data_curr_comm_id,
                     constant_for_second_term);
 
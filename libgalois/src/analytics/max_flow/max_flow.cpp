@@ -0,0 +1,665 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/max_flow/max_flow.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+using Capacity = int64_t;
+using Distance = uint32_t;
+using BiDirView = katana::PropertyGraphViews::BiDirectional;
+
+struct SourceSide : public katana::PODProperty<uint8_t> {};
+
+using Graph = katana::TypedPropertyGraph<std::tuple<SourceSide>, std::tuple<>>;
+
+/// Cherkassky and Goldberg's weights for the work of a relabeling: a global
+/// relabeling is due after about kAlpha * num_nodes + num_edges work, and each
+/// local relabeling costs its degree plus kBeta.
+constexpr uint64_t kAlpha = 6;
+constexpr uint64_t kBeta = 12;
+
+katana::Result<katana::NUMAArray<Capacity>>
+LoadCapacities(const std::shared_ptr<arrow::ChunkedArray>& property) {
+  arrow::Datum cast_res = KATANA_CHECKED(arrow::compute::Cast(
+      property, arrow::compute::CastOptions::Unsafe(arrow::int64())));
+  std::shared_ptr<arrow::ChunkedArray> values = cast_res.chunked_array();
+
+  katana::NUMAArray<Capacity> capacities;
+  capacities.allocateInterleaved(values->length());
+
+  katana::GReduceLogicalOr has_negative;
+  uint64_t offset = 0;
+  for (const auto& chunk : values->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) {
+          Capacity c = array->IsNull(i) ? 0 : array->Value(i);
+          has_negative.update(c < 0);
+          capacities[offset + i] = c;
+        },
+        katana::no_stats());
+    offset += array->length();
+  }
+
+  if (has_negative.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "capacities must not be negative");
+  }
+  return std::move(capacities);
+}
+
+/// Synchronous parallel push-relabel computing a maximum preflow.
+///
+/// Flow is kept per edge of the property graph: the forward arc of edge e
+/// has residual capacity capacity[e] - flow[e] and its reverse arc, reached
+/// through the in-edges of the head of e, has residual capacity flow[e].
+///
+/// Rounds alternate a push phase and a relabel phase. Distance labels do not
+/// change during the push phase, so the forward and reverse arcs of an edge
+/// cannot both be admissible and every flow value has a single writer; only
+/// excesses are updated atomically. Relabeling reads labels that can only
+/// have grown, which keeps the labeling valid.
+class PushRelabel {
+public:
+  PushRelabel(
+      const BiDirView& view, katana::NUMAArray<Capacity>&& capacity,
+      Node source, Node sink, double global_relabel_frequency)
+      : view_(view),
+        num_nodes_(view.num_nodes()),
+        source_(source),
+        sink_(sink),
+        capacity_(std::move(capacity)) {
+    flow_.allocateInterleaved(capacity_.size());
+    excess_.allocateInterleaved(num_nodes_);
+    distance_.allocateInterleaved(num_nodes_);
+    label_count_.allocateInterleaved(num_nodes_);
+    queued_.resize(num_nodes_);
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, capacity_.size()),
+        [&](uint64_t e) { flow_[e] = 0; }, katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          excess_[n] = 0;
+          label_count_[n] = 0;
+        },
+        katana::no_stats());
+
+    if (global_relabel_frequency > 0) {
+      global_relabel_work_ = static_cast<uint64_t>(
+          (kAlpha * num_nodes_ + view.num_edges()) / global_relabel_frequency);
+    } else {
+      global_relabel_work_ = std::numeric_limits<uint64_t>::max();
+    }
+  }
+
+  /// Run until no node that can still reach the sink has excess and return
+  /// the excess of the sink, which is the value of the maximum flow.
+  uint64_t Run() {
+    auto active = std::make_unique<katana::InsertBag<Node>>();
+    auto queued = std::make_unique<katana::InsertBag<Node>>();
+
+    for (auto e : view_.edges(source_)) {
+      Node dest = view_.edge_dest(e);
+      auto idx = view_.edge_property_index(e);
+      if (dest != source_ && capacity_[idx] > 0) {
+        flow_[idx] = capacity_[idx];
+        Receive(dest, capacity_[idx], queued.get());
+      }
+    }
+
+    GlobalRelabel();
+    Activate(queued.get(), active.get());
+
+    katana::GAccumulator<uint64_t> work;
+    katana::GReduceMin<Distance> gap;
+    uint64_t num_rounds = 0;
+    uint64_t num_global_relabels = 1;
+
+    while (!active->empty()) {
+      ++num_rounds;
+
+      katana::do_all(
+          katana::iterate(*active),
+          [&](const Node& n) { Push(n, queued.get()); }, katana::steal(),
+          katana::loopname("MaxFlow-Push"));
+      active->clear();
+
+      katana::do_all(
+          katana::iterate(*queued),
+          [&](const Node& n) {
+            queued_.reset(n);
+            Relabel(n, &work, &gap);
+            if (distance_[n].load(std::memory_order_relaxed) < num_nodes_) {
+              active->push(n);
+            }
+          },
+          katana::steal(), katana::loopname("MaxFlow-Relabel"));
+      queued->clear();
+
+      if (work.reduce() >= global_relabel_work_) {
+        work.reset();
+        gap.reset();
+        GlobalRelabel();
+        ++num_global_relabels;
+        Activate(active.get(), queued.get());
+        std::swap(active, queued);
+      } else if (Distance g = gap.reduce(); g < num_nodes_) {
+        gap.reset();
+        if (label_count_[g].load() == 0) {
+          LiftAboveGap(g);
+          Activate(active.get(), queued.get());
+          std::swap(active, queued);
+        }
+      }
+    }
+
+    katana::ReportStatSingle("MaxFlow", "Rounds", num_rounds);
+    katana::ReportStatSingle("MaxFlow", "GlobalRelabels", num_global_relabels);
+
+    // Exact labels tell apart the nodes that can still reach the sink.
+    GlobalRelabel();
+
+    return excess_[sink_].load();
+  }
+
+  /// After Run, whether n is on the source side of the minimum cut, i.e.,
+  /// cannot reach the sink in the residual graph.
+  bool IsSourceSide(Node n) const {
+    return distance_[n].load(std::memory_order_relaxed) >= num_nodes_;
+  }
+
+private:
+  void Receive(Node n, Capacity amount, katana::InsertBag<Node>* queued) {
+    excess_[n].fetch_add(amount, std::memory_order_relaxed);
+    if (n != sink_ && n != source_ && !queued_.set(n)) {
+      queued->push(n);
+    }
+  }
+
+  /// Move the nodes of from that may still reach the sink into to.
+  void Activate(katana::InsertBag<Node>* from, katana::InsertBag<Node>* to) {
+    katana::do_all(
+        katana::iterate(*from),
+        [&](const Node& n) {
+          queued_.reset(n);
+          if (distance_[n].load(std::memory_order_relaxed) < num_nodes_) {
+            to->push(n);
+          }
+        },
+        katana::no_stats());
+    from->clear();
+  }
+
+  void Push(Node n, katana::InsertBag<Node>* queued) {
+    Capacity excess = excess_[n].load(std::memory_order_relaxed);
+    Distance d = distance_[n].load(std::memory_order_relaxed);
+    Capacity pushed = 0;
+
+    for (auto e : view_.edges(n)) {
+      if (pushed == excess) {
+        break;
+      }
+      Node dest = view_.edge_dest(e);
+      if (distance_[dest].load(std::memory_order_relaxed) + 1 != d) {
+        continue;
+      }
+      auto idx = view_.edge_property_index(e);
+      Capacity delta = std::min(excess - pushed, capacity_[idx] - flow_[idx]);
+      if (delta > 0) {
+        flow_[idx] += delta;
+        pushed += delta;
+        Receive(dest, delta, queued);
+      }
+    }
+
+    for (auto e : view_.in_edges(n)) {
+      if (pushed == excess) {
+        break;
+      }
+      Node dest = view_.in_edge_dest(e);
+      if (distance_[dest].load(std::memory_order_relaxed) + 1 != d) {
+        continue;
+      }
+      auto idx = view_.in_edge_property_index(e);
+      Capacity delta = std::min(excess - pushed, flow_[idx]);
+      if (delta > 0) {
+        flow_[idx] -= delta;
+        pushed += delta;
+        Receive(dest, delta, queued);
+      }
+    }
+
+    excess_[n].fetch_sub(pushed, std::memory_order_relaxed);
+    if (pushed < excess && !queued_.set(n)) {
+      queued->push(n);
+    }
+  }
+
+  /// Raise the label of n to one more than its lowest residual neighbor.
+  void Relabel(
+      Node n, katana::GAccumulator<uint64_t>* work,
+      katana::GReduceMin<Distance>* gap) {
+    Distance d = distance_[n].load(std::memory_order_relaxed);
+    Distance lowest = num_nodes_;
+
+    for (auto e : view_.edges(n)) {
+      auto idx = view_.edge_property_index(e);
+      if (capacity_[idx] > flow_[idx]) {
+        lowest = std::min(
+            lowest, distance_[view_.edge_dest(e)].load(
+                        std::memory_order_relaxed) +
+                        1);
+      }
+    }
+    for (auto e : view_.in_edges(n)) {
+      if (flow_[view_.in_edge_property_index(e)] > 0) {
+        lowest = std::min(
+            lowest, distance_[view_.in_edge_dest(e)].load(
+                        std::memory_order_relaxed) +
+                        1);
+      }
+    }
+    Distance new_d = std::min<Distance>(lowest, num_nodes_);
+    if (new_d <= d) {
+      return;
+    }
+
+    distance_[n].store(new_d, std::memory_order_relaxed);
+    *work += view_.degree(n) + view_.in_degree(n) + kBeta;
+    if (label_count_[d].fetch_sub(1) == 1) {
+      gap->update(d);
+    }
+    if (new_d < num_nodes_) {
+      label_count_[new_d].fetch_add(1);
+    }
+  }
+
+  /// No node has label g, so nodes above it cannot reach the sink.
+  void LiftAboveGap(Distance g) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          Distance d = distance_[n].load(std::memory_order_relaxed);
+          if (d > g && d < num_nodes_) {
+            distance_[n].store(num_nodes_, std::memory_order_relaxed);
+          }
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{g} + 1, num_nodes_),
+        [&](uint64_t d) { label_count_[d] = 0; }, katana::no_stats());
+  }
+
+  /// Set every label to the exact residual distance to the sink by a
+  /// parallel breadth-first search along reverse residual arcs.
+  void GlobalRelabel() {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          distance_[n].store(num_nodes_, std::memory_order_relaxed);
+          label_count_[n] = 0;
+        },
+        katana::no_stats());
+    distance_[sink_] = 0;
+
+    auto current = std::make_unique<katana::InsertBag<Node>>();
+    auto next = std::make_unique<katana::InsertBag<Node>>();
+    next->push(sink_);
+
+    for (Distance level = 1; !next->empty(); ++level) {
+      std::swap(current, next);
+      next->clear();
+
+      auto visit = [&](Node n) {
+        Distance expected = num_nodes_;
+        if (n != source_ && distance_[n].compare_exchange_strong(
+                                expected, level, std::memory_order_relaxed)) {
+          next->push(n);
+        }
+      };
+
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const Node& n) {
+            // Edge n -> dest has a residual reverse arc dest -> n.
+            for (auto e : view_.edges(n)) {
+              if (flow_[view_.edge_property_index(e)] > 0) {
+                visit(view_.edge_dest(e));
+              }
+            }
+            // Edge src -> n has a residual forward arc.
+            for (auto e : view_.in_edges(n)) {
+              auto idx = view_.in_edge_property_index(e);
+              if (capacity_[idx] > flow_[idx]) {
+                visit(view_.in_edge_dest(e));
+              }
+            }
+          },
+          katana::steal(), katana::loopname("MaxFlow-GlobalRelabel"));
+    }
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          Distance d = distance_[n].load(std::memory_order_relaxed);
+          if (d < num_nodes_) {
+            label_count_[d].fetch_add(1, std::memory_order_relaxed);
+          }
+        },
+        katana::no_stats());
+  }
+
+  const BiDirView& view_;
+  const uint64_t num_nodes_;
+  const Node source_;
+  const Node sink_;
+  uint64_t global_relabel_work_;
+
+  katana::NUMAArray<Capacity> capacity_;
+  katana::NUMAArray<Capacity> flow_;
+  katana::NUMAArray<std::atomic<Capacity>> excess_;
+  katana::NUMAArray<std::atomic<Distance>> distance_;
+  katana::NUMAArray<std::atomic<uint32_t>> label_count_;
+  /// Whether a node is already in the bag of nodes to relabel.
+  katana::DynamicBitset queued_;
+};
+
+/// Compute the total capacity of the edges leaving the source side of the
+/// cut and how many there are.
+std::pair<uint64_t, uint64_t>
+CutCapacity(
+    const katana::GraphTopology& topology, const Graph& graph,
+    const katana::NUMAArray<Capacity>& capacity) {
+  katana::GAccumulator<uint64_t> cut_capacity;
+  katana::GAccumulator<uint64_t> num_cut_edges;
+
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](const Node& src) {
+        if (!graph.GetData<SourceSide>(src)) {
+          return;
+        }
+        for (auto e : topology.edges(src)) {
+          if (!graph.GetData<SourceSide>(topology.edge_dest(e))) {
+            cut_capacity += capacity[topology.edge_property_index(e)];
+            num_cut_edges += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return {cut_capacity.reduce(), num_cut_edges.reduce()};
+}
+
+/// Serial Dinic's algorithm on an explicit residual graph, used to check the
+/// parallel result.
+uint64_t
+SerialMaxFlow(
+    const katana::GraphTopology& topology,
+    const katana::NUMAArray<Capacity>& capacity, Node source, Node sink) {
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t num_arcs = 2 * topology.num_edges();
+  constexpr uint64_t kUnreached = std::numeric_limits<uint64_t>::max();
+
+  // Arc 2e is edge e and arc 2e + 1 is its reverse, so the reverse of arc a
+  // is a ^ 1 and its tail is head[a ^ 1].
+  std::vector<Node> head(num_arcs);
+  std::vector<Capacity> residual(num_arcs);
+  std::vector<uint64_t> offsets(num_nodes + 1, 0);
+  for (Node src : topology.all_nodes()) {
+    for (auto e : topology.edges(src)) {
+      Node dst = topology.edge_dest(e);
+      head[2 * e] = dst;
+      residual[2 * e] = capacity[topology.edge_property_index(e)];
+      head[2 * e + 1] = src;
+      residual[2 * e + 1] = 0;
+      ++offsets[src + 1];
+      ++offsets[dst + 1];
+    }
+  }
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    offsets[n + 1] += offsets[n];
+  }
+  std::vector<uint64_t> arcs(num_arcs);
+  std::vector<uint64_t> next_slot(offsets.begin(), offsets.end() - 1);
+  for (uint64_t a = 0; a < num_arcs; ++a) {
+    arcs[next_slot[head[a ^ 1]]++] = a;
+  }
+
+  std::vector<uint64_t> level(num_nodes);
+  std::vector<uint64_t> current(num_nodes);
+  std::vector<uint64_t> path;
+  std::vector<Node> queue;
+  uint64_t total = 0;
+
+  while (true) {
+    std::fill(level.begin(), level.end(), kUnreached);
+    level[source] = 0;
+    queue.assign(1, source);
+    for (size_t i = 0; i < queue.size(); ++i) {
+      Node n = queue[i];
+      for (uint64_t j = offsets[n]; j < offsets[n + 1]; ++j) {
+        uint64_t a = arcs[j];
+        if (residual[a] > 0 && level[head[a]] == kUnreached) {
+          level[head[a]] = level[n] + 1;
+          queue.push_back(head[a]);
+        }
+      }
+    }
+    if (level[sink] == kUnreached) {
+      return total;
+    }
+
+    std::copy(offsets.begin(), offsets.end() - 1, current.begin());
+    path.clear();
+    Node n = source;
+    while (true) {
+      if (n == sink) {
+        Capacity bottleneck = std::numeric_limits<Capacity>::max();
+        for (uint64_t a : path) {
+          bottleneck = std::min(bottleneck, residual[a]);
+        }
+        for (uint64_t a : path) {
+          residual[a] -= bottleneck;
+          residual[a ^ 1] += bottleneck;
+        }
+        total += bottleneck;
+        // Retreat to the tail of the first saturated arc.
+        size_t k = 0;
+        while (residual[path[k]] > 0) {
+          ++k;
+        }
+        n = head[path[k] ^ 1];
+        path.resize(k);
+        continue;
+      }
+
+      for (; current[n] < offsets[n + 1]; ++current[n]) {
+        uint64_t a = arcs[current[n]];
+        if (residual[a] > 0 && level[head[a]] == level[n] + 1) {
+          break;
+        }
+      }
+      if (current[n] < offsets[n + 1]) {
+        uint64_t a = arcs[current[n]];
+        path.push_back(a);
+        n = head[a];
+      } else if (n == source) {
+        break;
+      } else {
+        // Dead end: prune n from the level graph and back up.
+        level[n] = kUnreached;
+        n = head[path.back() ^ 1];
+        path.pop_back();
+        ++current[n];
+      }
+    }
+  }
+}
+
+katana::Result<void>
+CheckEndpoints(
+    const katana::PropertyGraph& pg, uint32_t source_node, uint32_t sink_node) {
+  if (source_node >= pg.topology().num_nodes() ||
+      sink_node >= pg.topology().num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "source {} or sink {} is not a node of a graph with {} nodes",
+        source_node, sink_node, pg.topology().num_nodes());
+  }
+  if (source_node == sink_node) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "source and sink must differ");
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<uint64_t>
+katana::analytics::MaxFlow(
+    PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+    const std::string& edge_capacity_property_name,
+    const std::string& output_property_name, MaxFlowPlan plan) {
+  KATANA_CHECKED(CheckEndpoints(*pg, source_node, sink_node));
+  if (plan.algorithm() != MaxFlowPlan::kPushRelabel) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "unknown max flow algorithm");
+  }
+
+  katana::NUMAArray<Capacity> capacity = KATANA_CHECKED(LoadCapacities(
+      KATANA_CHECKED(pg->GetEdgeProperty(edge_capacity_property_name))));
+
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<SourceSide>>(
+      pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  katana::StatTimer exec_time("MaxFlow");
+  exec_time.start();
+
+  // The in-edges come from the transposed topology cached on pg, so repeated
+  // queries on the same graph pay for the transpose once.
+  auto view = pg->BuildView<BiDirView>();
+  PushRelabel push_relabel(
+      view, std::move(capacity), source_node, sink_node,
+      plan.global_relabel_frequency());
+  uint64_t flow = push_relabel.Run();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        graph.GetData<SourceSide>(n) = push_relabel.IsSourceSide(n);
+      },
+      katana::no_stats());
+
+  exec_time.stop();
+
+  return flow;
+}
+
+katana::Result<void>
+katana::analytics::MaxFlowAssertValid(
+    PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+    const std::string& edge_capacity_property_name,
+    const std::string& property_name) {
+  KATANA_CHECKED(CheckEndpoints(*pg, source_node, sink_node));
+
+  katana::NUMAArray<Capacity> capacity = KATANA_CHECKED(LoadCapacities(
+      KATANA_CHECKED(pg->GetEdgeProperty(edge_capacity_property_name))));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  if (!graph.GetData<SourceSide>(source_node)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "source {} is not on the source side of the cut", source_node);
+  }
+  if (graph.GetData<SourceSide>(sink_node)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "sink {} is on the source side of the cut", sink_node);
+  }
+
+  uint64_t cut_capacity =
+      CutCapacity(pg->topology(), graph, capacity).first;
+  uint64_t max_flow =
+      SerialMaxFlow(pg->topology(), capacity, source_node, sink_node);
+  if (cut_capacity != max_flow) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "cut capacity {} is not minimal; the maximum flow is {}", cut_capacity,
+        max_flow);
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<MaxFlowStatistics>
+katana::analytics::MaxFlowStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_capacity_property_name,
+    const std::string& property_name) {
+  katana::NUMAArray<Capacity> capacity = KATANA_CHECKED(LoadCapacities(
+      KATANA_CHECKED(pg->GetEdgeProperty(edge_capacity_property_name))));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GAccumulator<uint64_t> num_source_side_nodes;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        if (graph.GetData<SourceSide>(n)) {
+          num_source_side_nodes += 1;
+        }
+      },
+      katana::loopname("Compute Statistics"), katana::no_stats());
+
+  auto [cut_capacity, num_cut_edges] =
+      CutCapacity(pg->topology(), graph, capacity);
+  return MaxFlowStatistics{
+      cut_capacity, num_cut_edges, num_source_side_nodes.reduce()};
+}
+
+void
+katana::analytics::MaxFlowStatistics::Print(std::ostream& os) const {
+  os << "Cut capacity = " << cut_capacity << std::endl;
+  os << "Number of cut edges = " << num_cut_edges << std::endl;
+  os << "Number of source side nodes = " << num_source_side_nodes
+     << std::endl;
+}
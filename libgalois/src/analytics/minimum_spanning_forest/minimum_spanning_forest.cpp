@@ -0,0 +1,522 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/UnionFind.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct ForestEdge : public katana::PODProperty<uint8_t> {};
+
+template <typename Weight>
+struct EdgeWeight : public katana::PODProperty<Weight> {};
+
+template <typename Weight>
+using Graph = katana::TypedPropertyGraph<
+    std::tuple<>, std::tuple<EdgeWeight<Weight>, ForestEdge>>;
+
+template <typename Weight>
+using WeightGraph =
+    katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeWeight<Weight>>>;
+
+struct ForestNode : public katana::UnionFindNode<ForestNode> {
+  ForestNode() : katana::UnionFindNode<ForestNode>(this) {}
+};
+
+/// An edge with its endpoints resolved, so that the inner loops neither
+/// search the CSR for edge sources nor chase the weight property.
+template <typename Weight>
+struct WeightedEdge {
+  Weight weight;
+  Node src;
+  Node dst;
+  Edge id;
+};
+
+/// Strict total order on edges. Breaking ties by edge ID keeps the set of
+/// lightest edges chosen in a Boruvka round free of cycles.
+template <typename Weight>
+bool
+Lighter(const WeightedEdge<Weight>& a, const WeightedEdge<Weight>& b) {
+  return a.weight < b.weight || (a.weight == b.weight && a.id < b.id);
+}
+
+/// Collect all edges that are not self loops, in CSR order.
+template <typename Weight, typename G>
+std::vector<WeightedEdge<Weight>>
+CollectEdges(const G& graph) {
+  katana::NUMAArray<uint64_t> offsets;
+  offsets.allocateInterleaved(graph.num_nodes());
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& src) {
+        uint64_t count = 0;
+        for (auto e : graph.edges(src)) {
+          if (*graph.GetEdgeDest(e) != src) {
+            ++count;
+          }
+        }
+        offsets[src] = count;
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::ParallelSTL::partial_sum(
+      offsets.begin(), offsets.end(), offsets.begin());
+
+  uint64_t num_edges =
+      graph.num_nodes() == 0 ? 0 : offsets[graph.num_nodes() - 1];
+  std::vector<WeightedEdge<Weight>> edges(num_edges);
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& src) {
+        uint64_t offset = src == 0 ? 0 : offsets[src - 1];
+        for (auto e : graph.edges(src)) {
+          Node dst = *graph.GetEdgeDest(e);
+          if (dst != src) {
+            edges[offset++] = WeightedEdge<Weight>{
+                graph.template GetEdgeData<EdgeWeight<Weight>>(e), src, dst,
+                e};
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return edges;
+}
+
+template <typename Weight>
+struct MinimumSpanningForestImpl {
+  using EdgeIterator = typename std::vector<WeightedEdge<Weight>>::iterator;
+
+  Graph<Weight>* graph_;
+  katana::NUMAArray<ForestNode> components_;
+
+  MinimumSpanningForestImpl(Graph<Weight>* graph) : graph_(graph) {
+    components_.allocateInterleaved(graph_->num_nodes());
+    components_.construct();
+  }
+
+  ForestNode* Find(Node n) { return components_[n].findAndCompress(); }
+
+  bool Connected(const WeightedEdge<Weight>& e) {
+    return Find(e.src) == Find(e.dst);
+  }
+
+  /// Add e to the forest if it joins two different trees.
+  void Link(const WeightedEdge<Weight>& e) {
+    if (components_[e.src].merge(&components_[e.dst])) {
+      graph_->template GetEdgeData<ForestEdge>(e.id) = 1;
+    }
+  }
+
+  void Boruvka(std::vector<WeightedEdge<Weight>>* edges) {
+    constexpr uint64_t kNoEdge = std::numeric_limits<uint64_t>::max();
+
+    // Index into the live range of the lightest edge leaving each component,
+    // indexed by the node ID of the component representative.
+    katana::NUMAArray<std::atomic<uint64_t>> lightest;
+    lightest.allocateInterleaved(graph_->num_nodes());
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const Node& n) {
+          lightest[n].store(kNoEdge, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+
+    auto propose = [&](ForestNode* component, uint64_t candidate) {
+      auto& slot = lightest[component - components_.data()];
+      uint64_t current = slot.load(std::memory_order_relaxed);
+      while (current == kNoEdge ||
+             Lighter((*edges)[candidate], (*edges)[current])) {
+        if (slot.compare_exchange_weak(current, candidate)) {
+          return;
+        }
+      }
+    };
+
+    EdgeIterator live_end = edges->end();
+    uint32_t round = 0;
+    while (edges->begin() != live_end) {
+      uint64_t num_live = std::distance(edges->begin(), live_end);
+
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_live),
+          [&](uint64_t i) {
+            const auto& e = (*edges)[i];
+            ForestNode* src_component = Find(e.src);
+            ForestNode* dst_component = Find(e.dst);
+            if (src_component == dst_component) {
+              return;
+            }
+            propose(src_component, i);
+            propose(dst_component, i);
+          },
+          katana::steal(), katana::loopname("MSF-Boruvka-FindLightest"));
+
+      // Two components may pick the same edge; only the first merge
+      // succeeds, so the edge is added once.
+      katana::do_all(
+          katana::iterate(*graph_),
+          [&](const Node& n) {
+            uint64_t i = lightest[n].load(std::memory_order_relaxed);
+            if (i == kNoEdge) {
+              return;
+            }
+            lightest[n].store(kNoEdge, std::memory_order_relaxed);
+            Link((*edges)[i]);
+          },
+          katana::steal(), katana::loopname("MSF-Boruvka-Merge"));
+
+      live_end = katana::ParallelSTL::partition(
+          edges->begin(), live_end,
+          [&](const WeightedEdge<Weight>& e) { return !Connected(e); });
+      ++round;
+    }
+
+    katana::ReportStatSingle("MinimumSpanningForest", "BoruvkaRounds", round);
+  }
+
+  void Kruskal(EdgeIterator begin, EdgeIterator end) {
+    katana::ParallelSTL::sort(begin, end, Lighter<Weight>);
+    for (auto it = begin; it != end; ++it) {
+      Link(*it);
+    }
+  }
+
+  /// Pick a pivot weight as the median of an evenly spaced sample.
+  Weight SamplePivot(EdgeIterator begin, EdgeIterator end) {
+    constexpr uint64_t kSampleSize = 63;
+    uint64_t size = std::distance(begin, end);
+    uint64_t stride = std::max<uint64_t>(1, size / kSampleSize);
+    std::vector<Weight> sample;
+    for (uint64_t i = 0; i < size && sample.size() < kSampleSize;
+         i += stride) {
+      sample.emplace_back(begin[i].weight);
+    }
+    auto median = sample.begin() + sample.size() / 2;
+    std::nth_element(sample.begin(), median, sample.end());
+    return *median;
+  }
+
+  void FilterKruskal(
+      EdgeIterator begin, EdgeIterator end, uint64_t kruskal_threshold) {
+    while (begin != end) {
+      if (static_cast<uint64_t>(std::distance(begin, end)) <=
+          kruskal_threshold) {
+        Kruskal(begin, end);
+        return;
+      }
+
+      Weight pivot = SamplePivot(begin, end);
+      EdgeIterator mid = katana::ParallelSTL::partition(
+          begin, end,
+          [pivot](const WeightedEdge<Weight>& e) { return e.weight <= pivot; });
+      if (mid == end) {
+        // The pivot is the largest sampled weight; split off the edges equal
+        // to it instead.
+        mid = katana::ParallelSTL::partition(
+            begin, end, [pivot](const WeightedEdge<Weight>& e) {
+              return e.weight < pivot;
+            });
+      }
+      if (mid == begin) {
+        // All remaining edges have the same weight.
+        Kruskal(begin, end);
+        return;
+      }
+
+      FilterKruskal(begin, mid, kruskal_threshold);
+
+      // Drop heavy edges whose endpoints the light edges already connected.
+      begin = katana::ParallelSTL::partition(
+          mid, end,
+          [&](const WeightedEdge<Weight>& e) { return Connected(e); });
+    }
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+MinimumSpanningForestWithWrap(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan) {
+  KATANA_CHECKED(ConstructEdgeProperties<std::tuple<ForestEdge>>(
+      pg, {output_property_name}));
+
+  auto graph = KATANA_CHECKED(Graph<Weight>::Make(
+      pg, {}, {edge_weight_property_name, output_property_name}));
+
+  katana::do_all(
+      katana::iterate(graph.all_edges()),
+      [&](const Edge& e) { graph.template GetEdgeData<ForestEdge>(e) = 0; },
+      katana::no_stats());
+
+  katana::StatTimer exec_time("MinimumSpanningForest");
+  exec_time.start();
+
+  MinimumSpanningForestImpl<Weight> impl(&graph);
+  std::vector<WeightedEdge<Weight>> edges = CollectEdges<Weight>(graph);
+
+  switch (plan.algorithm()) {
+  case MinimumSpanningForestPlan::kBoruvka:
+    impl.Boruvka(&edges);
+    break;
+  case MinimumSpanningForestPlan::kFilterKruskal:
+    impl.FilterKruskal(edges.begin(), edges.end(), plan.kruskal_threshold());
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return MinimumSpanningForestWithWrap<uint32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return MinimumSpanningForestWithWrap<int32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return MinimumSpanningForestWithWrap<uint64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return MinimumSpanningForestWithWrap<int64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return MinimumSpanningForestWithWrap<float>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return MinimumSpanningForestWithWrap<double>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+namespace {
+
+template <typename Weight>
+katana::Result<void>
+MinimumSpanningForestValidateImpl(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(
+      Graph<Weight>::Make(pg, {}, {edge_weight_property_name, property_name}));
+
+  katana::NUMAArray<ForestNode> forest;
+  forest.allocateInterleaved(graph.num_nodes());
+  forest.construct();
+
+  uint64_t num_forest_edges = 0;
+  double forest_weight = 0;
+  for (Node src : graph) {
+    for (auto e : graph.edges(src)) {
+      if (!graph.template GetEdgeData<ForestEdge>(e)) {
+        continue;
+      }
+      Node dst = *graph.GetEdgeDest(e);
+      if (!forest[src].merge(&forest[dst])) {
+        return KATANA_ERROR(
+            katana::ErrorCode::AssertionFailed,
+            "forest edge {} ({} -> {}) closes a cycle", e, src, dst);
+      }
+      ++num_forest_edges;
+      forest_weight += graph.template GetEdgeData<EdgeWeight<Weight>>(e);
+    }
+  }
+
+  // Reference forest from a serial Kruskal. Its component count also tells
+  // us how many edges a spanning forest must have.
+  auto reference_graph = KATANA_CHECKED(
+      WeightGraph<Weight>::Make(pg, {}, {edge_weight_property_name}));
+  std::vector<WeightedEdge<Weight>> edges =
+      CollectEdges<Weight>(reference_graph);
+  std::sort(edges.begin(), edges.end(), Lighter<Weight>);
+
+  katana::NUMAArray<ForestNode> reference;
+  reference.allocateInterleaved(graph.num_nodes());
+  reference.construct();
+
+  uint64_t num_reference_edges = 0;
+  double reference_weight = 0;
+  for (const auto& e : edges) {
+    if (reference[e.src].merge(&reference[e.dst])) {
+      ++num_reference_edges;
+      reference_weight += e.weight;
+    }
+  }
+
+  if (num_forest_edges != num_reference_edges) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "forest has {} edges but a spanning forest has {}", num_forest_edges,
+        num_reference_edges);
+  }
+
+  double tolerance =
+      std::is_floating_point_v<Weight>
+          ? 1e-6 * std::max(1.0, std::abs(reference_weight))
+          : 0;
+  if (std::abs(forest_weight - reference_weight) > tolerance) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "forest weight {} is not minimal; expected {}", forest_weight,
+        reference_weight);
+  }
+
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+katana::Result<MinimumSpanningForestStatistics>
+ComputeStatistics(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(
+      Graph<Weight>::Make(pg, {}, {edge_weight_property_name, property_name}));
+
+  katana::GAccumulator<uint64_t> num_forest_edges;
+  katana::GAccumulator<double> total_weight;
+
+  katana::do_all(
+      katana::iterate(graph.all_edges()),
+      [&](const Edge& e) {
+        if (graph.template GetEdgeData<ForestEdge>(e)) {
+          num_forest_edges += 1;
+          total_weight += graph.template GetEdgeData<EdgeWeight<Weight>>(e);
+        }
+      },
+      katana::loopname("Compute Statistics"), katana::no_stats());
+
+  uint64_t forest_edges = num_forest_edges.reduce();
+  return MinimumSpanningForestStatistics{
+      forest_edges, graph.num_nodes() - forest_edges, total_weight.reduce()};
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForestAssertValid(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return MinimumSpanningForestValidateImpl<uint32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return MinimumSpanningForestValidateImpl<int32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return MinimumSpanningForestValidateImpl<uint64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return MinimumSpanningForestValidateImpl<int64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return MinimumSpanningForestValidateImpl<float>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return MinimumSpanningForestValidateImpl<double>(
+        pg, edge_weight_property_name, property_name);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+katana::Result<MinimumSpanningForestStatistics>
+katana::analytics::MinimumSpanningForestStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return ComputeStatistics<uint32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return ComputeStatistics<int32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return ComputeStatistics<uint64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return ComputeStatistics<int64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return ComputeStatistics<float>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return ComputeStatistics<double>(
+        pg, edge_weight_property_name, property_name);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+void
+katana::analytics::MinimumSpanningForestStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of forest edges = " << num_forest_edges << std::endl;
+  os << "Number of trees = " << num_trees << std::endl;
+  os << "Total forest weight = " << total_weight << std::endl;
+}
@@ -45,6 +45,12 @@ katana::Result<void> PagerankPushAsynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan);
 
+katana::Result<void> PagerankPushAsynchronousIncremental(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests,
+    katana::analytics::PagerankPlan plan);
+
 katana::Result<void> PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan);
@@ -19,6 +19,7 @@
 
 #include <arrow/type.h>
 
+#include "katana/EdgeBalancedRange.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
@@ -160,6 +161,9 @@ ComputePRResidual(
     katana::analytics::PagerankPlan plan) {
   unsigned int iterations = 0;
   katana::GAccumulator<unsigned int> accum;
+  // pulling is proportional to in-degree, which is skewed on power-law graphs
+  auto ranges = katana::EdgeBalancedRanges::Make(*graph);
+  ranges.ReportImbalance("PageRank");
 
   while (true) {
     katana::do_all(
@@ -183,7 +187,7 @@ ComputePRResidual(
         katana::loopname("PageRank_delta"));
 
     katana::do_all(
-        katana::iterate(*graph),
+        ranges.iterate(),
         [&](const GNode& src) {
           float sum = 0;
           for (auto nbr : graph->edges(src)) {
@@ -222,11 +226,14 @@ ComputePRTopological(
     katana::NUMAArray<PagerankValueAndOutDegreeTy>* node_data) {
   unsigned int iteration = 0;
   katana::GAccumulator<float> accum;
+  // pulling is proportional to in-degree, which is skewed on power-law graphs
+  auto ranges = katana::EdgeBalancedRanges::Make(graph);
+  ranges.ReportImbalance("PageRank");
 
   float base_score = (1.0f - plan.alpha()) / graph.size();
   while (true) {
     katana::do_all(
-        katana::iterate(graph),
+        ranges.iterate(),
         [&](const GNode& src) {
           float sum = 0.0;
 
@@ -301,7 +308,8 @@ katana::Result<void>
 PagerankPullTopological(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan) {
-  katana::EnsurePreallocated(2, 3 * pg->num_nodes() * sizeof(NodeData));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      2, 3 * pg->num_nodes() * sizeof(NodeData)));
   katana::ReportPageAllocGuard page_alloc;
 
   // NUMA-awere temporary node data
@@ -323,7 +331,8 @@ katana::Result<void>
 PagerankPullResidual(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan) {
-  katana::EnsurePreallocated(2, 3 * pg->num_nodes() * sizeof(NodeData));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      2, 3 * pg->num_nodes() * sizeof(NodeData)));
   katana::ReportPageAllocGuard page_alloc;
 
   if (auto result = katana::analytics::ConstructNodeProperties<NodeData>(
@@ -17,7 +17,12 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <cmath>
+#include <numeric>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/ParallelSTL.h"
 #include "katana/Properties.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -45,13 +50,55 @@ InitializeNodeResidual(Graph& graph, katana::analytics::PagerankPlan plan) {
       katana::no_stats(), katana::loopname("Initialize"));
 }
 
+/// Push residuals asynchronously, starting from the nodes in initial, until
+/// every residual is within the tolerance. Residuals may be negative when a
+/// previous result is corrected, so the tolerance bounds their magnitude.
+template <typename Container>
+void
+PushResidualAsynchronous(
+    Graph* graph, const Container& initial,
+    katana::analytics::PagerankPlan plan) {
+  typedef katana::PerSocketChunkFIFO<
+      katana::analytics::PagerankPlan::kChunkSize>
+      WL;
+  katana::for_each(
+      katana::iterate(initial),
+      [&](const GNode& src, auto& ctx) {
+        auto& src_residual = graph->GetData<NodeResidual>(src);
+        if (std::fabs(src_residual.load()) > plan.tolerance()) {
+          PRTy old_residual = src_residual.exchange(0.0);
+          auto& src_value = graph->GetData<NodeValue>(src);
+          src_value += old_residual;
+          int src_nout = graph->edges(src).size();
+          if (src_nout > 0) {
+            PRTy delta = old_residual * plan.alpha() / src_nout;
+            //! For each out-going neighbors.
+            for (const auto& jj : graph->edges(src)) {
+              auto dest = graph->GetEdgeDest(jj);
+              auto& dest_residual = graph->GetData<NodeResidual>(dest);
+              if (delta != 0) {
+                auto old = atomicAdd(dest_residual, delta);
+                if ((std::fabs(old) < plan.tolerance()) &&
+                    (std::fabs(old + delta) >= plan.tolerance())) {
+                  ctx.push(*dest);
+                }
+              }
+            }
+          }
+        }
+      },
+      katana::loopname("PushResidualAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+}
+
 }  // namespace
 
 katana::Result<void>
 PagerankPushAsynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan) {
-  katana::EnsurePreallocated(5, 5 * pg->num_nodes() * sizeof(NodeData));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      5, 5 * pg->num_nodes() * sizeof(NodeData)));
   katana::ReportPageAllocGuard page_alloc;
 
   katana::analytics::TemporaryPropertyGuard temporary_property{
@@ -72,37 +119,7 @@ PagerankPushAsynchronous(
 
   InitializeNodeResidual(graph, plan);
 
-  typedef katana::PerSocketChunkFIFO<
-      katana::analytics::PagerankPlan::kChunkSize>
-      WL;
-  katana::for_each(
-      katana::iterate(graph),
-      [&](const GNode& src, auto& ctx) {
-        auto& src_residual = graph.GetData<NodeResidual>(src);
-        if (src_residual > plan.tolerance()) {
-          PRTy old_residual = src_residual.exchange(0.0);
-          auto& src_value = graph.GetData<NodeValue>(src);
-          src_value += old_residual;
-          int src_nout = graph.edges(src).size();
-          if (src_nout > 0) {
-            PRTy delta = old_residual * plan.alpha() / src_nout;
-            //! For each out-going neighbors.
-            for (const auto& jj : graph.edges(src)) {
-              auto dest = graph.GetEdgeDest(jj);
-              auto& dest_residual = graph.GetData<NodeResidual>(dest);
-              if (delta > 0) {
-                auto old = atomicAdd(dest_residual, delta);
-                if ((old < plan.tolerance()) &&
-                    (old + delta >= plan.tolerance())) {
-                  ctx.push(*dest);
-                }
-              }
-            }
-          }
-        }
-      },
-      katana::loopname("PushResidualAsynchronous"),
-      katana::disable_conflict_detection(), katana::wl<WL>());
+  PushResidualAsynchronous(&graph, graph, plan);
 
   return katana::ResultSuccess();
 }
@@ -111,7 +128,8 @@ katana::Result<void>
 PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan) {
-  katana::EnsurePreallocated(5, 5 * pg->num_nodes() * sizeof(NodeData));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      5, 5 * pg->num_nodes() * sizeof(NodeData)));
   katana::ReportPageAllocGuard page_alloc;
 
   katana::analytics::TemporaryPropertyGuard temporary_property{
@@ -212,3 +230,119 @@ PagerankPushSynchronous(
   }
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+PagerankPushAsynchronousIncremental(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests,
+    katana::analytics::PagerankPlan plan) {
+  // Nodes added since the ranks were computed start from scratch.
+  std::vector<GNode> new_nodes;
+  auto column = KATANA_CHECKED(pg->GetNodeProperty(property_name));
+  if (column->null_count() > 0) {
+    std::vector<PRTy> values(pg->num_nodes());
+    int64_t offset = 0;
+    for (const auto& chunk : column->chunks()) {
+      auto array = std::static_pointer_cast<arrow::FloatArray>(chunk);
+      for (int64_t i = 0; i < array->length(); ++i) {
+        if (array->IsNull(i)) {
+          new_nodes.emplace_back(offset + i);
+        } else {
+          values[offset + i] = array->Value(i);
+        }
+      }
+      offset += array->length();
+    }
+    arrow::FloatBuilder builder;
+    KATANA_CHECKED(builder.AppendValues(values));
+    std::shared_ptr<arrow::Array> array = KATANA_CHECKED(builder.Finish());
+    KATANA_CHECKED(pg->UpsertNodeProperties(arrow::Table::Make(
+        arrow::schema({arrow::field(property_name, arrow::float32())}),
+        {array})));
+  }
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{
+      pg->NodeMutablePropertyView()};
+  KATANA_CHECKED(
+      katana::analytics::ConstructNodeProperties<std::tuple<NodeResidual>>(
+          pg, {temporary_property.name()}));
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {property_name, temporary_property.name()}, {}));
+
+  katana::StatTimer exec_time("PagerankIncremental");
+  exec_time.start();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeResidual>(n) = 0; },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  katana::InsertBag<GNode> active_nodes;
+  auto add_residual = [&](GNode n, PRTy delta) {
+    auto old = atomicAdd(graph.GetData<NodeResidual>(n), delta);
+    if ((std::fabs(old) < plan.tolerance()) &&
+        (std::fabs(old + delta) >= plan.tolerance())) {
+      active_nodes.push(n);
+    }
+  };
+
+  for (GNode n : new_nodes) {
+    add_residual(n, plan.initial_residual());
+  }
+
+  // Group the new edges by source. A source u with k new edges had k fewer
+  // out-edges when its rank was spread, so each of its old out-neighbors
+  // received alpha * rank(u) / (degree(u) - k) instead of alpha * rank(u) /
+  // degree(u), and its new out-neighbors received nothing.
+  std::vector<uint64_t> order(new_edge_srcs.size());
+  std::iota(order.begin(), order.end(), uint64_t{0});
+  katana::ParallelSTL::sort(
+      order.begin(), order.end(), [&](uint64_t a, uint64_t b) {
+        return new_edge_srcs[a] < new_edge_srcs[b];
+      });
+
+  katana::GReduceLogicalOr missing_edges;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, uint64_t{order.size()}),
+      [&](uint64_t i) {
+        GNode src = new_edge_srcs[order[i]];
+        if (i > 0 && new_edge_srcs[order[i - 1]] == src) {
+          return;
+        }
+        uint64_t end = i;
+        while (end < order.size() && new_edge_srcs[order[end]] == src) {
+          ++end;
+        }
+        uint64_t num_new = end - i;
+        uint64_t new_degree = graph.edges(src).size();
+        if (new_degree < num_new) {
+          missing_edges.update(true);
+          return;
+        }
+        uint64_t old_degree = new_degree - num_new;
+
+        PRTy spread = plan.alpha() * graph.GetData<NodeValue>(src);
+        if (old_degree > 0) {
+          PRTy correction = spread / new_degree - spread / old_degree;
+          for (auto e : graph.edges(src)) {
+            add_residual(*graph.GetEdgeDest(e), correction);
+          }
+        }
+        PRTy share = spread / (old_degree > 0 ? old_degree : new_degree);
+        for (uint64_t j = i; j < end; ++j) {
+          add_residual(new_edge_dests[order[j]], share);
+        }
+      },
+      katana::steal(), katana::loopname("IncrementalResidual"));
+  if (missing_edges.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "the new edges must be added to the graph first");
+  }
+
+  PushResidualAsynchronous(&graph, active_nodes, plan);
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
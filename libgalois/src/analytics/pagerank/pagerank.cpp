@@ -38,6 +38,36 @@ katana::analytics::Pagerank(
   }
 }
 
+katana::Result<void>
+katana::analytics::PagerankIncremental(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& new_edge_srcs,
+    const std::vector<uint32_t>& new_edge_dests,
+    katana::analytics::PagerankPlan plan) {
+  if (plan.algorithm() != PagerankPlan::kPushAsynchronous) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "incremental Page Rank requires the PushAsynchronous algorithm");
+  }
+  if (new_edge_srcs.size() != new_edge_dests.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "got {} sources but {} destinations", new_edge_srcs.size(),
+        new_edge_dests.size());
+  }
+  for (size_t i = 0; i < new_edge_srcs.size(); ++i) {
+    if (new_edge_srcs[i] >= pg->num_nodes() ||
+        new_edge_dests[i] >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge {} -> {} out of range; graph has {} nodes", new_edge_srcs[i],
+          new_edge_dests[i], pg->num_nodes());
+    }
+  }
+  return PagerankPushAsynchronousIncremental(
+      pg, property_name, new_edge_srcs, new_edge_dests, plan);
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::PagerankAssertValid(
@@ -0,0 +1,903 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/partition/partition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+#include <arrow/compute/api.h>
+
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+using Weight = int64_t;
+
+constexpr uint32_t kNoPartition = std::numeric_limits<uint32_t>::max();
+constexpr Node kUnmatched = std::numeric_limits<Node>::max();
+
+/// Rounds of handshaking per coarsening step. Most matchable nodes are
+/// matched in the first two rounds.
+constexpr uint32_t kMatchingRounds = 4;
+/// Stop coarsening when a step removes fewer nodes than this fraction.
+constexpr double kMinCoarseningRatio = 0.95;
+/// Upper bound on the weight of a coarse node, relative to the average
+/// weight of a coarsest-level node. Keeps heavy nodes from making balance
+/// impossible.
+constexpr double kMaxCoarseNodeWeightFactor = 1.5;
+constexpr uint32_t kBalanceRounds = 8;
+
+struct PartitionID : public katana::PODProperty<uint32_t> {};
+
+/// One level of the multilevel hierarchy: a weighted graph in the CSR layout
+/// of GraphTopology. The finest level aliases the topology of the input
+/// graph; coarser levels own their arrays.
+struct LevelGraph {
+  uint64_t num_nodes{0};
+  const Edge* adj_indices{nullptr};
+  const Node* dests{nullptr};
+  /// nullptr means unit weights.
+  const Weight* node_weights{nullptr};
+  const Weight* edge_weights{nullptr};
+  Weight total_node_weight{0};
+
+  katana::NUMAArray<Edge> owned_adj_indices;
+  katana::NUMAArray<Node> owned_dests;
+  katana::NUMAArray<Weight> owned_node_weights;
+  katana::NUMAArray<Weight> owned_edge_weights;
+
+  /// Node of the next coarser level that each node was contracted into.
+  katana::NUMAArray<Node> coarse_map;
+
+  Edge edge_begin(Node n) const { return n == 0 ? 0 : adj_indices[n - 1]; }
+  Edge edge_end(Node n) const { return adj_indices[n]; }
+  Weight node_weight(Node n) const {
+    return node_weights ? node_weights[n] : 1;
+  }
+  Weight edge_weight(Edge e) const {
+    return edge_weights ? edge_weights[e] : 1;
+  }
+};
+
+/// Per-thread sparse map from partition ID to the weight of the edges that
+/// connect the current node to that partition.
+struct Connectivity {
+  std::vector<Weight> weight;
+  std::vector<uint32_t> touched;
+
+  void Compute(
+      const LevelGraph& g, const katana::NUMAArray<uint32_t>& part, Node n,
+      uint32_t num_partitions) {
+    if (weight.size() < num_partitions) {
+      weight.resize(num_partitions, 0);
+    }
+    for (uint32_t p : touched) {
+      weight[p] = 0;
+    }
+    touched.clear();
+    for (Edge e = g.edge_begin(n); e < g.edge_end(n); ++e) {
+      Node dst = g.dests[e];
+      if (dst == n) {
+        continue;
+      }
+      uint32_t p = part[dst];
+      if (weight[p] == 0) {
+        touched.emplace_back(p);
+      }
+      weight[p] += g.edge_weight(e);
+    }
+  }
+};
+
+/// Symmetric hash of an undirected edge, used to break ties between equally
+/// heavy edges. Both endpoints must agree on the winner for handshaking to
+/// make progress on graphs with uniform weights.
+uint64_t
+EdgeHash(Node a, Node b, uint32_t round) {
+  uint64_t x = (uint64_t{std::min(a, b)} << 32 | std::max(a, b)) ^
+               (uint64_t{round} * 0x9e3779b97f4a7c15ULL);
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+katana::Result<katana::NUMAArray<Weight>>
+LoadWeights(const std::shared_ptr<arrow::ChunkedArray>& property) {
+  arrow::Datum cast_res = KATANA_CHECKED(arrow::compute::Cast(
+      property, arrow::compute::CastOptions::Unsafe(arrow::int64())));
+  std::shared_ptr<arrow::ChunkedArray> values = cast_res.chunked_array();
+
+  katana::NUMAArray<Weight> weights;
+  weights.allocateInterleaved(values->length());
+
+  katana::GReduceLogicalOr has_negative;
+  uint64_t offset = 0;
+  for (const auto& chunk : values->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) {
+          Weight w = array->IsNull(i) ? 1 : array->Value(i);
+          has_negative.update(w < 0);
+          weights[offset + i] = w;
+        },
+        katana::no_stats());
+    offset += array->length();
+  }
+
+  if (has_negative.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "weights must not be negative");
+  }
+  return std::move(weights);
+}
+
+Weight
+TotalNodeWeight(const LevelGraph& g) {
+  katana::GAccumulator<Weight> total;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, g.num_nodes),
+      [&](uint64_t n) { total += g.node_weight(n); }, katana::no_stats());
+  return total.reduce();
+}
+
+/// Contract a heavy-edge matching of fine into a new coarser level and
+/// record the mapping in fine.coarse_map.
+std::unique_ptr<LevelGraph>
+Coarsen(LevelGraph* fine, Weight max_coarse_node_weight) {
+  const uint64_t num_nodes = fine->num_nodes;
+
+  katana::NUMAArray<Node> match;
+  match.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::fill(match.begin(), match.end(), kUnmatched);
+  katana::NUMAArray<Node> proposal;
+  proposal.allocateInterleaved(num_nodes);
+
+  for (uint32_t round = 0; round < kMatchingRounds; ++round) {
+    katana::GAccumulator<uint64_t> num_proposals;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          proposal[n] = kUnmatched;
+          if (match[n] != kUnmatched) {
+            return;
+          }
+          Weight best_weight = -1;
+          uint64_t best_hash = 0;
+          for (Edge e = fine->edge_begin(n); e < fine->edge_end(n); ++e) {
+            Node dst = fine->dests[e];
+            if (dst == n || match[dst] != kUnmatched ||
+                fine->node_weight(n) + fine->node_weight(dst) >
+                    max_coarse_node_weight) {
+              continue;
+            }
+            Weight w = fine->edge_weight(e);
+            if (w < best_weight) {
+              continue;
+            }
+            uint64_t h = EdgeHash(n, dst, round);
+            if (w > best_weight || h > best_hash) {
+              best_weight = w;
+              best_hash = h;
+              proposal[n] = dst;
+            }
+          }
+          if (proposal[n] != kUnmatched) {
+            num_proposals += 1;
+          }
+        },
+        katana::steal(), katana::loopname("Partition-Propose"));
+
+    if (num_proposals.reduce() == 0) {
+      break;
+    }
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          Node partner = proposal[n];
+          if (partner != kUnmatched && proposal[partner] == n) {
+            match[n] = partner;
+          }
+        },
+        katana::no_stats());
+  }
+
+  // Number the coarse nodes after the smaller endpoint of each pair.
+  katana::NUMAArray<uint64_t> leader_prefix;
+  leader_prefix.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        if (match[n] == kUnmatched) {
+          match[n] = n;
+        }
+        leader_prefix[n] = match[n] >= n ? 1 : 0;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      leader_prefix.begin(), leader_prefix.end(), leader_prefix.begin());
+
+  const uint64_t num_coarse_nodes = leader_prefix[num_nodes - 1];
+
+  auto coarse = std::make_unique<LevelGraph>();
+  coarse->num_nodes = num_coarse_nodes;
+
+  fine->coarse_map.allocateInterleaved(num_nodes);
+  katana::NUMAArray<Node> leaders;
+  leaders.allocateInterleaved(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Node leader = std::min<Node>(n, match[n]);
+        Node c = leader_prefix[leader] - 1;
+        fine->coarse_map[n] = c;
+        if (leader == n) {
+          leaders[c] = n;
+        }
+      },
+      katana::no_stats());
+
+  coarse->owned_node_weights.allocateInterleaved(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        Node n = leaders[c];
+        Weight w = fine->node_weight(n);
+        if (match[n] != n) {
+          w += fine->node_weight(match[n]);
+        }
+        coarse->owned_node_weights[c] = w;
+      },
+      katana::no_stats());
+
+  // Merge the adjacency of both endpoints, combining parallel edges and
+  // dropping the edge between them. The merge runs twice, first to size
+  // the coarse CSR and then to fill it, so that no per-node lists are held.
+  using Neighbor = std::pair<Node, Weight>;
+  katana::PerThreadStorage<std::vector<Neighbor>> scratch;
+  auto merge_neighbors = [&](Node c) -> std::vector<Neighbor>& {
+    std::vector<Neighbor>& neighbors = *scratch.getLocal();
+    neighbors.clear();
+    Node n = leaders[c];
+    for (Node member : {n, match[n]}) {
+      for (Edge e = fine->edge_begin(member); e < fine->edge_end(member);
+           ++e) {
+        Node dst = fine->coarse_map[fine->dests[e]];
+        if (dst != c) {
+          neighbors.emplace_back(dst, fine->edge_weight(e));
+        }
+      }
+      if (match[n] == n) {
+        break;
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    size_t out = 0;
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+      if (out > 0 && neighbors[out - 1].first == neighbors[i].first) {
+        neighbors[out - 1].second += neighbors[i].second;
+      } else {
+        neighbors[out++] = neighbors[i];
+      }
+    }
+    neighbors.resize(out);
+    return neighbors;
+  };
+
+  coarse->owned_adj_indices.allocateInterleaved(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        coarse->owned_adj_indices[c] = merge_neighbors(c).size();
+      },
+      katana::steal(), katana::loopname("Partition-CoarsenCount"));
+  katana::ParallelSTL::partial_sum(
+      coarse->owned_adj_indices.begin(), coarse->owned_adj_indices.end(),
+      coarse->owned_adj_indices.begin());
+
+  const uint64_t num_coarse_edges =
+      coarse->owned_adj_indices[num_coarse_nodes - 1];
+  coarse->owned_dests.allocateInterleaved(num_coarse_edges);
+  coarse->owned_edge_weights.allocateInterleaved(num_coarse_edges);
+
+  coarse->adj_indices = coarse->owned_adj_indices.data();
+  coarse->dests = coarse->owned_dests.data();
+  coarse->node_weights = coarse->owned_node_weights.data();
+  coarse->edge_weights = coarse->owned_edge_weights.data();
+  coarse->total_node_weight = fine->total_node_weight;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        Edge e = coarse->edge_begin(c);
+        for (const auto& [dst, w] : merge_neighbors(c)) {
+          coarse->owned_dests[e] = dst;
+          coarse->owned_edge_weights[e] = w;
+          ++e;
+        }
+      },
+      katana::steal(), katana::loopname("Partition-CoarsenFill"));
+
+  return coarse;
+}
+
+/// Greedy graph growing: grow each partition breadth first from an
+/// unassigned seed until it reaches its share of the remaining weight.
+/// The coarsest graph is small, so this runs serially.
+void
+InitialPartition(
+    const LevelGraph& g, uint32_t num_partitions,
+    katana::NUMAArray<uint32_t>* part) {
+  std::fill(part->begin(), part->end(), kNoPartition);
+
+  Weight assigned = 0;
+  Node next_seed = 0;
+  std::deque<Node> queue;
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    Weight target = (g.total_node_weight - assigned) / (num_partitions - p);
+    Weight part_weight = 0;
+    queue.clear();
+    while (part_weight < target || p + 1 == num_partitions) {
+      if (queue.empty()) {
+        while (next_seed < g.num_nodes && (*part)[next_seed] != kNoPartition) {
+          ++next_seed;
+        }
+        if (next_seed == g.num_nodes) {
+          break;
+        }
+        queue.push_back(next_seed);
+      }
+      Node n = queue.front();
+      queue.pop_front();
+      if ((*part)[n] != kNoPartition) {
+        continue;
+      }
+      (*part)[n] = p;
+      part_weight += g.node_weight(n);
+      for (Edge e = g.edge_begin(n); e < g.edge_end(n); ++e) {
+        if ((*part)[g.dests[e]] == kNoPartition) {
+          queue.push_back(g.dests[e]);
+        }
+      }
+    }
+    assigned += part_weight;
+  }
+}
+
+class Refiner {
+public:
+  Refiner(uint32_t num_partitions, Weight max_part_weight)
+      : num_partitions_(num_partitions),
+        max_part_weight_(max_part_weight),
+        part_weights_(num_partitions) {}
+
+  /// Size-constrained label propagation. Sweeps are synchronous: moves are
+  /// decided against a snapshot of the assignment and applied afterwards.
+  /// Even sweeps only move nodes to higher partition IDs and odd sweeps to
+  /// lower ones, so two neighbors never trade places in the same sweep.
+  void Refine(
+      const LevelGraph& g, katana::NUMAArray<uint32_t>* part,
+      uint32_t iterations) {
+    ComputePartWeights(g, *part);
+    katana::NUMAArray<uint32_t> next;
+    next.allocateInterleaved(g.num_nodes);
+
+    katana::GAccumulator<uint64_t> num_moved;
+    for (uint32_t sweep = 0; sweep < 2 * iterations; ++sweep) {
+      const bool upward = sweep % 2 == 0;
+      if (upward) {
+        num_moved.reset();
+      }
+      katana::do_all(
+          katana::iterate(uint64_t{0}, g.num_nodes),
+          [&](uint64_t n) {
+            uint32_t from = (*part)[n];
+            next[n] = from;
+
+            Connectivity& conn = *connectivity_.getLocal();
+            conn.Compute(g, *part, n, num_partitions_);
+
+            Weight w = g.node_weight(n);
+            uint32_t best = from;
+            Weight best_gain = 0;
+            for (uint32_t to : conn.touched) {
+              if (to == from || (upward ? to < from : to > from)) {
+                continue;
+              }
+              Weight gain = conn.weight[to] - conn.weight[from];
+              Weight to_weight = part_weights_[to].load();
+              if (to_weight + w > max_part_weight_) {
+                continue;
+              }
+              // Zero-gain moves are taken only if they improve balance.
+              bool better = gain > best_gain ||
+                            (gain == best_gain && best == from && gain == 0 &&
+                             to_weight + w < part_weights_[from].load());
+              if (better) {
+                best = to;
+                best_gain = gain;
+              }
+            }
+
+            if (best != from && Reserve(best, w)) {
+              part_weights_[from].fetch_sub(w);
+              next[n] = best;
+              num_moved += 1;
+            }
+          },
+          katana::steal(), katana::loopname("Partition-Refine"));
+
+      std::swap(*part, next);
+      if (!upward && num_moved.reduce() == 0) {
+        break;
+      }
+    }
+  }
+
+  /// Move nodes out of overweight partitions, preferring the adjacent
+  /// partition they are most connected to. Early rounds only move boundary
+  /// nodes, which keeps the cut low; later rounds move any node.
+  void Balance(const LevelGraph& g, katana::NUMAArray<uint32_t>* part) {
+    ComputePartWeights(g, *part);
+    katana::NUMAArray<uint32_t> next;
+    next.allocateInterleaved(g.num_nodes);
+
+    for (uint32_t round = 0; round < kBalanceRounds; ++round) {
+      if (!IsOverweight()) {
+        return;
+      }
+      const bool boundary_only = round < kBalanceRounds / 2;
+      uint32_t lightest = Lightest();
+
+      katana::do_all(
+          katana::iterate(uint64_t{0}, g.num_nodes),
+          [&](uint64_t n) {
+            uint32_t from = (*part)[n];
+            next[n] = from;
+            if (part_weights_[from].load() <= max_part_weight_) {
+              return;
+            }
+
+            Connectivity& conn = *connectivity_.getLocal();
+            conn.Compute(g, *part, n, num_partitions_);
+
+            Weight w = g.node_weight(n);
+            uint32_t best = kNoPartition;
+            Weight best_conn = -1;
+            for (uint32_t to : conn.touched) {
+              if (to != from && conn.weight[to] > best_conn &&
+                  part_weights_[to].load() + w <= max_part_weight_) {
+                best = to;
+                best_conn = conn.weight[to];
+              }
+            }
+            if (best == kNoPartition) {
+              if (boundary_only || lightest == from) {
+                return;
+              }
+              best = lightest;
+            }
+
+            if (Reserve(best, w)) {
+              part_weights_[from].fetch_sub(w);
+              next[n] = best;
+            }
+          },
+          katana::steal(), katana::loopname("Partition-Balance"));
+
+      std::swap(*part, next);
+    }
+  }
+
+  /// Move nodes out of the partitions that Balance left overweight, one at a
+  /// time into the lightest partition. The lightest partition weighs at most
+  /// the average, and max_part_weight is at least the average plus the
+  /// heaviest node, so every move fits and no partition stays overweight.
+  /// \returns the number of nodes moved
+  uint64_t ForceBalance(
+      const LevelGraph& g, katana::NUMAArray<uint32_t>* part) {
+    ComputePartWeights(g, *part);
+    if (!IsOverweight()) {
+      return 0;
+    }
+
+    uint64_t num_moved = 0;
+    for (uint64_t n = 0; n < g.num_nodes; ++n) {
+      uint32_t from = (*part)[n];
+      if (part_weights_[from].load() <= max_part_weight_) {
+        continue;
+      }
+      uint32_t to = Lightest();
+      Weight w = g.node_weight(n);
+      KATANA_LOG_DEBUG_ASSERT(part_weights_[to].load() + w <= max_part_weight_);
+      part_weights_[from].fetch_sub(w);
+      part_weights_[to].fetch_add(w);
+      (*part)[n] = to;
+      ++num_moved;
+    }
+    KATANA_LOG_DEBUG_ASSERT(!IsOverweight());
+    return num_moved;
+  }
+
+private:
+  uint32_t Lightest() const {
+    uint32_t lightest = 0;
+    for (uint32_t p = 1; p < num_partitions_; ++p) {
+      if (part_weights_[p].load() < part_weights_[lightest].load()) {
+        lightest = p;
+      }
+    }
+    return lightest;
+  }
+
+  void ComputePartWeights(
+      const LevelGraph& g, const katana::NUMAArray<uint32_t>& part) {
+    for (auto& w : part_weights_) {
+      w.store(0);
+    }
+    katana::do_all(
+        katana::iterate(uint64_t{0}, g.num_nodes),
+        [&](uint64_t n) { part_weights_[part[n]].fetch_add(g.node_weight(n)); },
+        katana::no_stats());
+  }
+
+  bool Reserve(uint32_t p, Weight w) {
+    if (part_weights_[p].fetch_add(w) + w > max_part_weight_) {
+      part_weights_[p].fetch_sub(w);
+      return false;
+    }
+    return true;
+  }
+
+  bool IsOverweight() const {
+    for (const auto& w : part_weights_) {
+      if (w.load() > max_part_weight_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uint32_t num_partitions_;
+  Weight max_part_weight_;
+  std::vector<std::atomic<Weight>> part_weights_;
+  katana::PerThreadStorage<Connectivity> connectivity_;
+};
+
+Weight
+MaxNodeWeight(const LevelGraph& g) {
+  katana::GReduceMax<Weight> max_node_weight;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, g.num_nodes),
+      [&](uint64_t n) { max_node_weight.update(g.node_weight(n)); },
+      katana::no_stats());
+  return max_node_weight.reduce();
+}
+
+/// The weight no part may exceed: (1 + imbalance) times the average part
+/// weight, or the average plus the heaviest node if that is more, so that
+/// any node fits into a part of at most average weight
+Weight
+MaxPartWeight(
+    const LevelGraph& g, uint32_t num_partitions, double imbalance,
+    Weight max_node_weight) {
+  const double average_part_weight =
+      static_cast<double>(g.total_node_weight) / num_partitions;
+  return std::max(
+      static_cast<Weight>(std::ceil((1 + imbalance) * average_part_weight)),
+      static_cast<Weight>(std::ceil(average_part_weight)) + max_node_weight);
+}
+
+/// The finest level of the graph, weighted by the node and edge weight
+/// properties of pg if they are named
+katana::Result<std::unique_ptr<LevelGraph>>
+MakeFinestLevel(
+    katana::PropertyGraph* pg, const std::string& node_weight_property_name,
+    const std::string& edge_weight_property_name) {
+  auto finest = std::make_unique<LevelGraph>();
+  finest->num_nodes = pg->topology().num_nodes();
+  finest->adj_indices = pg->topology().adj_data();
+  finest->dests = pg->topology().dest_data();
+
+  if (!node_weight_property_name.empty()) {
+    finest->owned_node_weights = KATANA_CHECKED(LoadWeights(
+        KATANA_CHECKED(pg->GetNodeProperty(node_weight_property_name))));
+    finest->node_weights = finest->owned_node_weights.data();
+  }
+  if (!edge_weight_property_name.empty()) {
+    finest->owned_edge_weights = KATANA_CHECKED(LoadWeights(
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))));
+    finest->edge_weights = finest->owned_edge_weights.data();
+  }
+  finest->total_node_weight = TotalNodeWeight(*finest);
+  return finest;
+}
+
+katana::Result<void>
+MultilevelPartition(
+    katana::PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& node_weight_property_name,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name, const PartitionPlan& plan) {
+  std::unique_ptr<LevelGraph> finest = KATANA_CHECKED(MakeFinestLevel(
+      pg, node_weight_property_name, edge_weight_property_name));
+
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<PartitionID>>(
+      pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<PartitionID>, std::tuple<>>::Make(
+          pg, {output_property_name}, {})));
+
+  if (finest->num_nodes == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::StatTimer exec_time("Partition");
+  exec_time.start();
+
+  const Weight max_node_weight = MaxNodeWeight(*finest);
+  const Weight max_part_weight =
+      MaxPartWeight(*finest, num_partitions, imbalance, max_node_weight);
+
+  // Coarsen
+  katana::StatTimer coarsening_time("Partition-Coarsening");
+  coarsening_time.start();
+
+  const uint64_t coarsen_to = std::max<uint64_t>(
+      uint64_t{plan.coarsening_threshold()} * num_partitions, 1);
+  const Weight max_coarse_node_weight = std::max(
+      static_cast<Weight>(
+          kMaxCoarseNodeWeightFactor * finest->total_node_weight / coarsen_to),
+      max_node_weight);
+
+  std::vector<std::unique_ptr<LevelGraph>> levels;
+  levels.emplace_back(std::move(finest));
+  while (levels.back()->num_nodes > coarsen_to) {
+    LevelGraph* fine = levels.back().get();
+    std::unique_ptr<LevelGraph> coarse = Coarsen(fine, max_coarse_node_weight);
+    if (coarse->num_nodes > kMinCoarseningRatio * fine->num_nodes) {
+      fine->coarse_map = katana::NUMAArray<Node>{};
+      break;
+    }
+    levels.emplace_back(std::move(coarse));
+  }
+
+  coarsening_time.stop();
+  katana::ReportStatSingle("Partition", "Levels", levels.size());
+
+  // Initial partition
+  katana::StatTimer initial_time("Partition-Initial");
+  initial_time.start();
+
+  Refiner refiner(num_partitions, max_part_weight);
+  katana::NUMAArray<uint32_t> part;
+  part.allocateInterleaved(levels.back()->num_nodes);
+  InitialPartition(*levels.back(), num_partitions, &part);
+  refiner.Refine(*levels.back(), &part, plan.refinement_iterations());
+  refiner.Balance(*levels.back(), &part);
+
+  initial_time.stop();
+
+  // Uncoarsen and refine
+  katana::StatTimer refinement_time("Partition-Refinement");
+  refinement_time.start();
+
+  for (size_t level = levels.size() - 1; level-- > 0;) {
+    const LevelGraph& fine = *levels[level];
+    katana::NUMAArray<uint32_t> fine_part;
+    fine_part.allocateInterleaved(fine.num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, fine.num_nodes),
+        [&](uint64_t n) { fine_part[n] = part[fine.coarse_map[n]]; },
+        katana::no_stats());
+    part = std::move(fine_part);
+    levels.pop_back();
+
+    refiner.Refine(fine, &part, plan.refinement_iterations());
+    refiner.Balance(fine, &part);
+  }
+  katana::ReportStatSingle(
+      "Partition", "ForcedMoves", refiner.ForceBalance(*levels.front(), &part));
+
+  refinement_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) { graph.GetData<PartitionID>(n) = part[n]; },
+      katana::no_stats());
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Partition(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& output_property_name, PartitionPlan plan) {
+  return Partition(
+      pg, num_partitions, imbalance, "", "", output_property_name, plan);
+}
+
+katana::Result<void>
+katana::analytics::Partition(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& node_weight_property_name,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name, PartitionPlan plan) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "number of partitions must be positive");
+  }
+  if (!(imbalance >= 0)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "imbalance must be non-negative; got {}", imbalance);
+  }
+
+  switch (plan.algorithm()) {
+  case PartitionPlan::kMultilevel:
+    return MultilevelPartition(
+        pg, num_partitions, imbalance, node_weight_property_name,
+        edge_weight_property_name, output_property_name, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+katana::Result<void>
+katana::analytics::PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<PartitionID>, std::tuple<>>::Make(
+          pg, {property_name}, {})));
+
+  katana::GReduceLogicalOr out_of_range;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        out_of_range.update(graph.GetData<PartitionID>(n) >= num_partitions);
+      },
+      katana::no_stats());
+
+  if (out_of_range.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "partition ID out of range; expected less than {}", num_partitions);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+    const std::string& node_weight_property_name,
+    const std::string& property_name) {
+  KATANA_CHECKED(PartitionAssertValid(pg, num_partitions, property_name));
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<PartitionID>, std::tuple<>>::Make(
+          pg, {property_name}, {})));
+  std::unique_ptr<LevelGraph> finest =
+      KATANA_CHECKED(MakeFinestLevel(pg, node_weight_property_name, ""));
+
+  std::vector<std::atomic<Weight>> part_weights(num_partitions);
+  for (auto& w : part_weights) {
+    w.store(0);
+  }
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        part_weights[graph.GetData<PartitionID>(n)].fetch_add(
+            finest->node_weight(n), std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  const Weight max_part_weight = MaxPartWeight(
+      *finest, num_partitions, imbalance, MaxNodeWeight(*finest));
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    if (part_weights[p].load() > max_part_weight) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "partition {} weighs {}; expected at most {}", p,
+          part_weights[p].load(), max_part_weight);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<PartitionStatistics>
+katana::analytics::PartitionStatistics::Compute(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  KATANA_CHECKED(PartitionAssertValid(pg, num_partitions, property_name));
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<std::tuple<PartitionID>, std::tuple<>>::Make(
+          pg, {property_name}, {})));
+
+  std::vector<std::atomic<uint64_t>> sizes(num_partitions);
+  for (auto& s : sizes) {
+    s.store(0);
+  }
+  katana::GAccumulator<uint64_t> edge_cut;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        uint32_t p = graph.GetData<PartitionID>(n);
+        sizes[p].fetch_add(1, std::memory_order_relaxed);
+        for (auto e : graph.edges(n)) {
+          if (graph.GetData<PartitionID>(graph.GetEdgeDest(e)) != p) {
+            edge_cut += 1;
+          }
+        }
+      },
+      katana::steal(), katana::loopname("Compute Statistics"),
+      katana::no_stats());
+
+  uint32_t num_non_empty = 0;
+  uint64_t max_size = 0;
+  uint64_t min_size = std::numeric_limits<uint64_t>::max();
+  for (const auto& s : sizes) {
+    uint64_t size = s.load();
+    if (size == 0) {
+      continue;
+    }
+    ++num_non_empty;
+    max_size = std::max(max_size, size);
+    min_size = std::min(min_size, size);
+  }
+  if (num_non_empty == 0) {
+    min_size = 0;
+  }
+
+  double average_size = static_cast<double>(graph.num_nodes()) / num_partitions;
+  return PartitionStatistics{
+      num_non_empty, edge_cut.reduce(), max_size, min_size,
+      average_size > 0 ? max_size / average_size : 0};
+}
+
+void
+katana::analytics::PartitionStatistics::Print(std::ostream& os) const {
+  os << "Number of non-empty partitions = " << num_non_empty_partitions
+     << std::endl;
+  os << "Edge cut = " << edge_cut << std::endl;
+  os << "Largest partition size = " << max_partition_size << std::endl;
+  os << "Smallest partition size = " << min_partition_size << std::endl;
+  os << "Imbalance = " << imbalance << std::endl;
+}
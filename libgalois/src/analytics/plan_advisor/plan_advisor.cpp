@@ -0,0 +1,466 @@
+#include "katana/analytics/plan_advisor/plan_advisor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/GraphStatistics.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+#include "katana/analytics/subgraph_extraction/subgraph_extraction.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// Graphs with a diameter estimate above this take many BFS levels, so
+/// barriers between levels dominate and direction optimization rarely
+/// switches to bottom-up
+constexpr uint64_t kHighDiameter = 64;
+/// Graphs with fewer edges per node than this, such as road networks, have
+/// frontiers too thin for bottom-up steps to pay off
+constexpr double kLowAverageDegree = 4.0;
+/// A node with this many times the average degree is a hub worth splitting
+/// across threads
+constexpr double kHubSkew = 1024.0;
+/// The SSSP delta is this many times the average edge weight over the
+/// average degree, so that a bucket holds on the order of one relaxation
+/// per incident edge [Meyer and Sanders, Delta-stepping]
+constexpr double kDeltaScale = 2.0;
+constexpr unsigned kMaxDelta = 30;
+
+katana::Result<std::optional<double>>
+MeanEdgeWeight(katana::PropertyGraph* pg, const std::string& name) {
+  auto weights = KATANA_CHECKED(pg->GetEdgeProperty(name));
+  arrow::Datum mean = KATANA_CHECKED_CONTEXT(
+      arrow::compute::Mean(weights), "averaging edge property {}", name);
+  const auto& scalar = mean.scalar_as<arrow::DoubleScalar>();
+  if (!scalar.is_valid) {
+    return std::optional<double>();
+  }
+  return std::optional<double>(scalar.value);
+}
+
+/// The delta exponent that gives a bucket width of about kDeltaScale times
+/// the mean weight over the average degree
+unsigned
+DeltaExponent(double mean_weight, double average_degree) {
+  double width = kDeltaScale * mean_weight / std::max(average_degree, 1.0);
+  if (width <= 1.0) {
+    return 0;
+  }
+  return std::min<unsigned>(std::lround(std::log2(width)), kMaxDelta);
+}
+
+Node
+FindHub(const katana::GraphTopology& topology, uint64_t max_degree) {
+  katana::GReduceMin<Node> hub;
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        if (topology.degree(n) == max_degree) {
+          hub.update(n);
+        }
+      },
+      katana::no_stats());
+  Node ret = hub.reduce();
+  // Saved statistics may be stale
+  return ret < topology.num_nodes() ? ret : 0;
+}
+
+/// Up to num_nodes nodes in BFS order along out-edges from the hub. When the
+/// BFS runs out of nodes it continues from the first unvisited node, so the
+/// sample keeps the neighborhoods of its nodes rather than scattered nodes.
+std::vector<Node>
+SampleNodes(
+    const katana::GraphTopology& topology, Node hub, uint64_t num_nodes) {
+  num_nodes = std::min<uint64_t>(num_nodes, topology.num_nodes());
+  std::vector<Node> sample;
+  sample.reserve(num_nodes);
+  std::vector<bool> visited(topology.num_nodes());
+  Node next_root = 0;
+  Node root = hub;
+  while (sample.size() < num_nodes) {
+    visited[root] = true;
+    sample.emplace_back(root);
+    for (size_t i = sample.size() - 1;
+         i < sample.size() && sample.size() < num_nodes; ++i) {
+      for (Edge e : topology.edges(sample[i])) {
+        Node dest = topology.edge_dest(e);
+        if (!visited[dest]) {
+          visited[dest] = true;
+          sample.emplace_back(dest);
+          if (sample.size() == num_nodes) {
+            break;
+          }
+        }
+      }
+    }
+    while (next_root < topology.num_nodes() && visited[next_root]) {
+      ++next_root;
+    }
+    root = next_root;
+  }
+  return sample;
+}
+
+template <typename PlanType>
+struct Candidate {
+  std::string name;
+  PlanType plan;
+};
+
+/// The candidate plans for one analytic, always in the same order so that
+/// trials run them in that order, and the one chosen so far
+template <typename PlanType>
+struct Choice {
+  std::vector<Candidate<PlanType>> candidates;
+  size_t chosen{0};
+  std::string rationale;
+
+  void Prefer(const std::string& name) {
+    auto it = std::find_if(
+        candidates.begin(), candidates.end(),
+        [&](const Candidate<PlanType>& c) { return c.name == name; });
+    KATANA_LOG_DEBUG_ASSERT(it != candidates.end());
+    chosen = it - candidates.begin();
+  }
+
+  const PlanType& plan() const { return candidates[chosen].plan; }
+
+  /// Run each candidate once on a sample and choose the fastest. Candidates
+  /// that fail are reported and skipped; the choice stands if they all fail.
+  template <typename RunFn>
+  void RunTrials(uint64_t sample_size, RunFn run) {
+    uint64_t fastest_usec = std::numeric_limits<uint64_t>::max();
+    size_t fastest = chosen;
+    rationale += fmt::format("; trials on {} nodes:", sample_size);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      katana::Timer timer;
+      timer.start();
+      katana::Result<void> res = run(candidates[i].plan);
+      timer.stop();
+      if (!res) {
+        rationale +=
+            fmt::format(" {} failed ({})", candidates[i].name, res.error());
+        continue;
+      }
+      rationale +=
+          fmt::format(" {} {}us", candidates[i].name, timer.get_usec());
+      if (timer.get_usec() < fastest_usec) {
+        fastest = i;
+        fastest_usec = timer.get_usec();
+      }
+    }
+    chosen = fastest;
+    rationale += fmt::format(", taking {}", candidates[chosen].name);
+  }
+};
+
+struct Choices {
+  Choice<BfsPlan> bfs;
+  Choice<SsspPlan> sssp;
+  Choice<ConnectedComponentsPlan> connected_components;
+  Choice<PagerankPlan> pagerank;
+  Choice<TriangleCountPlan> triangle_count;
+};
+
+Choices
+Choose(const GraphFeatures& features, std::optional<double> mean_edge_weight) {
+  Choices ret;
+  bool high_diameter = features.estimated_diameter > kHighDiameter ||
+                       features.average_degree < kLowAverageDegree;
+  bool has_hubs = features.degree_skew > kHubSkew;
+
+  ret.bfs.candidates = {
+      {"SynchronousDirectOpt", BfsPlan::SynchronousDirectOpt()},
+      {"AsynchronousTile", BfsPlan::AsynchronousTile()},
+      {"SynchronousTile", BfsPlan::SynchronousTile()},
+  };
+  if (high_diameter) {
+    ret.bfs.Prefer("AsynchronousTile");
+    ret.bfs.rationale = fmt::format(
+        "bfs: AsynchronousTile because the diameter estimate {} or the "
+        "average degree {:.1f} suggests many thin frontiers",
+        features.estimated_diameter, features.average_degree);
+  } else {
+    ret.bfs.Prefer("SynchronousDirectOpt");
+    ret.bfs.rationale = fmt::format(
+        "bfs: SynchronousDirectOpt because the diameter estimate {} and the "
+        "average degree {:.1f} suggest few wide frontiers",
+        features.estimated_diameter, features.average_degree);
+  }
+
+  unsigned delta = SsspPlan::kDefaultDelta;
+  std::string delta_reason = "the default delta";
+  if (mean_edge_weight) {
+    delta = DeltaExponent(*mean_edge_weight, features.average_degree);
+    delta_reason = fmt::format(
+        "delta 2^{} from the mean weight {:.3g} and average degree {:.1f}",
+        delta, *mean_edge_weight, features.average_degree);
+  }
+  ret.sssp.candidates = {
+      {"DeltaStep", SsspPlan::DeltaStep(delta)},
+      {"DeltaStepBarrier", SsspPlan::DeltaStepBarrier(delta)},
+      {"DeltaTile", SsspPlan::DeltaTile(delta)},
+  };
+  if (features.power_law) {
+    ret.sssp.Prefer("DeltaStep");
+    ret.sssp.rationale = fmt::format(
+        "sssp: DeltaStep with {} because the degrees follow a power law",
+        delta_reason);
+  } else {
+    ret.sssp.Prefer("DeltaStepBarrier");
+    ret.sssp.rationale = fmt::format(
+        "sssp: DeltaStepBarrier with {} because the degrees are not skewed",
+        delta_reason);
+  }
+
+  ret.connected_components.candidates = {
+      {"Afforest", ConnectedComponentsPlan::Afforest()},
+      {"EdgeTiledAfforest", ConnectedComponentsPlan::EdgeTiledAfforest()},
+      {"EdgeTiledAsynchronous",
+       ConnectedComponentsPlan::EdgeTiledAsynchronous()},
+  };
+  if (has_hubs) {
+    ret.connected_components.Prefer("EdgeTiledAfforest");
+    ret.connected_components.rationale = fmt::format(
+        "connected_components: EdgeTiledAfforest because the degree skew "
+        "{:.0f} would leave the edges of hubs to single threads",
+        features.degree_skew);
+  } else {
+    ret.connected_components.Prefer("Afforest");
+    ret.connected_components.rationale = fmt::format(
+        "connected_components: Afforest because the degree skew {:.0f} is "
+        "small enough to sample neighbors node by node",
+        features.degree_skew);
+  }
+
+  ret.pagerank.candidates = {
+      {"PushAsynchronous", PagerankPlan::PushAsynchronous()},
+      {"PullResidual", PagerankPlan::PullResidual()},
+  };
+  if (features.power_law) {
+    ret.pagerank.Prefer("PullResidual");
+    ret.pagerank.rationale =
+        "pagerank: PullResidual because pushing to hubs contends on their "
+        "residuals";
+  } else {
+    ret.pagerank.Prefer("PushAsynchronous");
+    ret.pagerank.rationale =
+        "pagerank: PushAsynchronous because the degrees are not skewed";
+  }
+
+  // Relabeling sorts the nodes of the graph it runs on, so it goes last
+  ret.triangle_count.candidates = {
+      {"OrderedCount",
+       TriangleCountPlan::OrderedCount(
+           TriangleCountPlan::kDefaultEdgeSorted,
+           TriangleCountPlan::kNoRelabel)},
+      {"EdgeIteration",
+       TriangleCountPlan::EdgeIteration(
+           TriangleCountPlan::kDefaultEdgeSorted,
+           TriangleCountPlan::kNoRelabel)},
+      {"OrderedCountRelabel",
+       TriangleCountPlan::OrderedCount(
+           TriangleCountPlan::kDefaultEdgeSorted,
+           TriangleCountPlan::kRelabel)},
+  };
+  if (features.power_law) {
+    ret.triangle_count.Prefer("OrderedCountRelabel");
+    ret.triangle_count.rationale =
+        "triangle_count: OrderedCount with relabeling because ordering by "
+        "degree bounds the work of hubs";
+  } else {
+    ret.triangle_count.Prefer("OrderedCount");
+    ret.triangle_count.rationale =
+        "triangle_count: OrderedCount without relabeling because the degrees "
+        "are not skewed";
+  }
+
+  return ret;
+}
+
+/// Replace the choices with the fastest candidates on a sampled subgraph
+katana::Result<void>
+RunTrials(
+    katana::PropertyGraph* pg, const PlanAdvisorOptions& opts,
+    const GraphFeatures& features, Choices* choices) {
+  const katana::GraphTopology& topology = pg->topology();
+  std::vector<Node> sample = SampleNodes(
+      topology, FindHub(topology, features.max_degree), opts.trial_nodes);
+  std::vector<std::string> edge_properties;
+  if (!opts.edge_weight_property_name.empty()) {
+    edge_properties.emplace_back(opts.edge_weight_property_name);
+  }
+  std::unique_ptr<katana::PropertyGraph> sub = KATANA_CHECKED_CONTEXT(
+      SubGraphExtraction(pg, sample, {}, edge_properties),
+      "sampling {} nodes", sample.size());
+  // The hub is node 0 of the sample
+  constexpr Node kSource = 0;
+
+  choices->bfs.RunTrials(
+      sample.size(), [&](const BfsPlan& plan) -> katana::Result<void> {
+        TemporaryPropertyGuard output(sub->NodeMutablePropertyView());
+        return Bfs(sub.get(), kSource, output.name(), plan);
+      });
+  if (!opts.edge_weight_property_name.empty()) {
+    choices->sssp.RunTrials(
+        sample.size(), [&](const SsspPlan& plan) -> katana::Result<void> {
+          TemporaryPropertyGuard output(sub->NodeMutablePropertyView());
+          return Sssp(
+              sub.get(), kSource, opts.edge_weight_property_name,
+              output.name(), plan);
+        });
+  }
+  // Connected components and triangle counting expect a symmetric graph
+  // without duplicate edges, and on a directed sample they would time
+  // different work than they do on the symmetrized graphs they run on
+  std::unique_ptr<katana::PropertyGraph> undirected = KATANA_CHECKED(
+      katana::PropertyGraph::Make(MakeUndirectedTopology(sub->topology())));
+  choices->connected_components.RunTrials(
+      sample.size(),
+      [&](const ConnectedComponentsPlan& plan) -> katana::Result<void> {
+        TemporaryPropertyGuard output(undirected->NodeMutablePropertyView());
+        return ConnectedComponents(undirected.get(), output.name(), plan);
+      });
+  choices->pagerank.RunTrials(
+      sample.size(), [&](const PagerankPlan& plan) -> katana::Result<void> {
+        TemporaryPropertyGuard output(sub->NodeMutablePropertyView());
+        return Pagerank(sub.get(), output.name(), plan);
+      });
+  choices->triangle_count.RunTrials(
+      sample.size(),
+      [&](const TriangleCountPlan& plan) -> katana::Result<void> {
+        KATANA_CHECKED(TriangleCount(undirected.get(), plan));
+        return katana::ResultSuccess();
+      });
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+void
+katana::analytics::GraphFeatures::Print(std::ostream& os) const {
+  os << "Number of nodes = " << num_nodes << std::endl;
+  os << "Number of edges = " << num_edges << std::endl;
+  os << "Average degree = " << average_degree << std::endl;
+  os << "Maximum degree = " << max_degree << std::endl;
+  os << "Degree skew = " << degree_skew << std::endl;
+  os << "Density = " << density << std::endl;
+  os << "Estimated diameter = " << estimated_diameter << std::endl;
+  os << "Power law = " << power_law << std::endl;
+  os << "From saved statistics = " << from_saved_statistics << std::endl;
+}
+
+katana::Result<GraphFeatures>
+katana::analytics::GraphFeatures::Compute(
+    const PropertyGraph* pg, bool use_saved_statistics,
+    uint32_t num_diameter_sweeps) {
+  const GraphTopology& topology = pg->topology();
+  GraphFeatures features;
+  features.num_nodes = topology.num_nodes();
+  features.num_edges = topology.num_edges();
+  if (features.num_nodes == 0) {
+    return MakeResult(std::move(features));
+  }
+
+  std::optional<GraphStatistics> saved;
+  if (use_saved_statistics) {
+    auto saved_res = LoadGraphStatistics(pg);
+    if (saved_res) {
+      saved = std::move(saved_res.value());
+    } else if (saved_res.error() != ErrorCode::NotFound) {
+      KATANA_LOG_WARN("ignoring saved statistics: {}", saved_res.error());
+    }
+  }
+  // LoadGraphStatistics does not return statistics saved before the graph
+  // changed
+  if (saved) {
+    features.max_degree = saved->out_degrees.max;
+    features.estimated_diameter = saved->estimated_diameter;
+    features.from_saved_statistics = true;
+  } else {
+    katana::GReduceMax<uint64_t> max_degree;
+    katana::do_all(
+        katana::iterate(topology.all_nodes()),
+        [&](Node n) { max_degree.update(topology.degree(n)); },
+        katana::no_stats());
+    features.max_degree = max_degree.reduce();
+    // The same estimate as the saved statistics, so that plans do not
+    // depend on whether they were saved
+    features.estimated_diameter = EstimateDiameter(
+        MakeUndirectedTopology(topology), num_diameter_sweeps);
+  }
+
+  features.average_degree =
+      static_cast<double>(features.num_edges) / features.num_nodes;
+  features.degree_skew =
+      features.average_degree == 0.0
+          ? 0.0
+          : static_cast<double>(features.max_degree) / features.average_degree;
+  features.density = features.average_degree / features.num_nodes;
+  features.power_law = IsApproximateDegreeDistributionPowerLaw(*pg);
+  return MakeResult(std::move(features));
+}
+
+void
+katana::analytics::PlanAdvice::Print(std::ostream& os) const {
+  features.Print(os);
+  for (const auto& line : rationale) {
+    os << line << std::endl;
+  }
+}
+
+katana::Result<PlanAdvice>
+katana::analytics::AdvisePlans(
+    PropertyGraph* pg, const PlanAdvisorOptions& opts) {
+  katana::StatTimer timer("PlanAdvisor", "PlanAdvisor");
+  timer.start();
+
+  PlanAdvice advice;
+  advice.features = KATANA_CHECKED(GraphFeatures::Compute(
+      pg, opts.use_saved_statistics, opts.num_diameter_sweeps));
+
+  std::optional<double> mean_edge_weight;
+  if (!opts.edge_weight_property_name.empty()) {
+    mean_edge_weight =
+        KATANA_CHECKED(MeanEdgeWeight(pg, opts.edge_weight_property_name));
+  }
+
+  Choices choices = Choose(advice.features, mean_edge_weight);
+  if (opts.run_trials && advice.features.num_nodes > 0) {
+    KATANA_CHECKED(RunTrials(pg, opts, advice.features, &choices));
+  }
+
+  advice.bfs = choices.bfs.plan();
+  advice.sssp = choices.sssp.plan();
+  advice.connected_components = choices.connected_components.plan();
+  advice.pagerank = choices.pagerank.plan();
+  advice.triangle_count = choices.triangle_count.plan();
+  advice.rationale = {
+      choices.bfs.rationale,
+      choices.sssp.rationale,
+      choices.connected_components.rationale,
+      choices.pagerank.rationale,
+      choices.triangle_count.rationale,
+  };
+  for (const auto& line : advice.rationale) {
+    KATANA_LOG_VERBOSE("{}", line);
+  }
+
+  timer.stop();
+  return MakeResult(std::move(advice));
+}
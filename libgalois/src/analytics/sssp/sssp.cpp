@@ -70,12 +70,24 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
   using OBIMBarrier = typename katana::OrderedByIntegerMetric<
       UpdateRequestIndexer, PSchunk>::template with_barrier<true>::type;
 
-  template <typename T, typename OBIMTy = OBIM, typename P, typename R>
-  static void DeltaStepAlgo(
+  /// The priority of a request is its distance, unlike OBIM, which buckets
+  /// distances by delta
+  struct UpdateRequestDistance {
+    template <typename R>
+    Dist operator()(const R& req) const {
+      return req.dist;
+    }
+  };
+  using MultiQueueWL = katana::MultiQueue<UpdateRequestDistance>;
+
+  /// Relax edges asynchronously in the order of worklist, the katana::wl
+  /// of an OBIM or a MultiQueue
+  template <typename T, typename P, typename R, typename WL>
+  static void AsyncAlgo(
       katana::NUMAArray<std::atomic<Weight>>* node_data,
       katana::NUMAArray<Weight>* edge_data, Graph* graph,
       const typename Graph::Node& source, const P& pushWrap, const R& edgeRange,
-      unsigned stepShift) {
+      const WL& worklist) {
     //! [reducible for self-defined stats]
     katana::GAccumulator<size_t> BadWork;
     //! [reducible for self-defined stats]
@@ -114,8 +126,8 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
             }
           }
         },
-        katana::wl<OBIMTy>(UpdateRequestIndexer{stepShift}),
-        katana::disable_conflict_detection(), katana::loopname("SSSP"));
+        worklist, katana::disable_conflict_detection(),
+        katana::loopname("SSSP"));
 
     if (kTrackWork) {
       //! [report self-defined stats]
@@ -411,18 +423,18 @@ public:
     typename Graph::Node source = *it;
 
     size_t approxNodeData = graph.size() * 64;
-    katana::EnsurePreallocated(1, approxNodeData);
+    KATANA_CHECKED(katana::TryEnsurePreallocated(1, approxNodeData));
     katana::ReportPageAllocGuard page_alloc;
 
     katana::NUMAArray<std::atomic<Weight>> node_data;
     katana::NUMAArray<Weight> edge_data;
     bool use_block = false;
     if (use_block) {
-      node_data.allocateBlocked(graph.size());
-      edge_data.allocateBlocked(graph.num_edges());
+      KATANA_CHECKED(node_data.tryAllocateBlocked(graph.size()));
+      KATANA_CHECKED(edge_data.tryAllocateBlocked(graph.num_edges()));
     } else {
-      node_data.allocateInterleaved(graph.size());
-      edge_data.allocateInterleaved(graph.num_edges());
+      KATANA_CHECKED(node_data.tryAllocateInterleaved(graph.size()));
+      KATANA_CHECKED(edge_data.tryAllocateInterleaved(graph.num_edges()));
     }
 
     katana::do_all(katana::iterate(graph), [&](const typename Graph::Node& n) {
@@ -445,19 +457,22 @@ public:
 
     switch (plan.algorithm()) {
     case SsspPlan::kDeltaTile:
-      DeltaStepAlgo<SrcEdgeTile>(
+      AsyncAlgo<SrcEdgeTile>(
           &node_data, &edge_data, &graph, source,
-          SrcEdgeTilePushWrap{&graph, *this}, TileRangeFn(), plan.delta());
+          SrcEdgeTilePushWrap{&graph, *this}, TileRangeFn(),
+          katana::wl<OBIM>(UpdateRequestIndexer{plan.delta()}));
       break;
     case SsspPlan::kDeltaStep:
-      DeltaStepAlgo<UpdateRequest>(
+      AsyncAlgo<UpdateRequest>(
           &node_data, &edge_data, &graph, source, ReqPushWrap(),
-          OutEdgeRangeFn{&graph}, plan.delta());
+          OutEdgeRangeFn{&graph},
+          katana::wl<OBIM>(UpdateRequestIndexer{plan.delta()}));
       break;
     case SsspPlan::kDeltaStepBarrier:
-      DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
+      AsyncAlgo<UpdateRequest>(
           &node_data, &edge_data, &graph, source, ReqPushWrap(),
-          OutEdgeRangeFn{&graph}, plan.delta());
+          OutEdgeRangeFn{&graph},
+          katana::wl<OBIMBarrier>(UpdateRequestIndexer{plan.delta()}));
       break;
     case SsspPlan::kDeltaStepFusion:
       DeltaStepFusionAlgo(&node_data, &edge_data, &graph, source, plan.delta());
@@ -485,6 +500,11 @@ public:
     case SsspPlan::kTopologicalTile:
       TopoTileAlgo(&graph, source);
       break;
+    case SsspPlan::kMultiQueue:
+      AsyncAlgo<UpdateRequest>(
+          &node_data, &edge_data, &graph, source, ReqPushWrap(),
+          OutEdgeRangeFn{&graph}, katana::wl<MultiQueueWL>());
+      break;
     default:
       return katana::ErrorCode::InvalidArgument;
     }
@@ -20,7 +20,13 @@
 #include "katana/analytics/subgraph_extraction/subgraph_extraction.h"
 
 #include <iostream>
+#include <limits>
+#include <unordered_set>
 
+#include <arrow/compute/api.h>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
 #include "katana/PropertyGraph.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -28,39 +34,110 @@
 namespace {
 
 using namespace katana::analytics;
-using edge_iterator = boost::counting_iterator<uint64_t>;
 
-using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
-using Node = SortedGraphView::Node;
-using Edge = SortedGraphView::Edge;
+using Node = katana::PropertyGraph::Node;
+using Edge = katana::PropertyGraph::Edge;
+
+constexpr Node kInvalidNode = std::numeric_limits<Node>::max();
+
+/// Gather the rows named by indices from each of the requested columns of a
+/// property view into a new table. Columns are independent, so they are taken
+/// in parallel.
+template <typename IndexType>
+katana::Result<std::shared_ptr<arrow::Table>>
+TakeProperties(
+    const katana::PropertyGraph::MutablePropertyView& view,
+    const std::vector<std::string>& names,
+    const std::vector<IndexType>& indices) {
+  for (const auto& name : names) {
+    KATANA_CHECKED_CONTEXT(
+        view.EnsurePropertyLoaded(name), "loading property {}", name);
+  }
+
+  std::shared_ptr<arrow::Array> index_array =
+      katana::ProjectAsArrowArray(indices.data(), indices.size());
+
+  std::vector<std::shared_ptr<arrow::Field>> fields(names.size());
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(names.size());
+  std::vector<arrow::Status> statuses(names.size());
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    fields[i] = view.loaded_schema()->GetFieldByName(names[i]);
+    if (!fields[i]) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "property does not exist: {}",
+          names[i]);
+    }
+  }
+
+  katana::do_all(
+      katana::iterate(size_t{0}, names.size()),
+      [&](size_t i) {
+        auto column = view.GetProperty(names[i]);
+        if (!column) {
+          statuses[i] = arrow::Status::KeyError(names[i]);
+          return;
+        }
+        auto taken = arrow::compute::Take(column.value(), index_array);
+        if (!taken.ok()) {
+          statuses[i] = taken.status();
+          return;
+        }
+        columns[i] = taken.ValueOrDie().chunked_array();
+      },
+      katana::no_stats(), katana::loopname("TakeProperties"));
 
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (!statuses[i].ok()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "gathering property {}: {}", names[i],
+          statuses[i]);
+    }
+  }
+
+  return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+/// Build the sub-graph induced by node_set, keeping only the edges accepted by
+/// edge_filter. Position i of node_set is the original ID of sub-graph node i;
+/// node_set must not contain duplicates.
+template <typename EdgeFilter>
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
-SubGraphNodeSet(
-    const SortedGraphView& graph, const std::vector<Node>& node_set) {
+BuildSubGraph(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_set,
+    const EdgeFilter& edge_filter,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy) {
+  const katana::GraphTopology& topology = pg->topology();
   uint64_t num_nodes = node_set.size();
+  if (num_nodes == 0) {
+    return std::make_unique<katana::PropertyGraph>();
+  }
+
+  katana::NUMAArray<Node> original_to_sub;
+  original_to_sub.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::fill(
+      original_to_sub.begin(), original_to_sub.end(), kInvalidNode);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { original_to_sub[node_set[n]] = n; },
+      katana::no_stats());
+
   // Subgraph topology : out indices
   katana::NUMAArray<Edge> out_indices;
   out_indices.allocateInterleaved(num_nodes);
 
-  katana::gstl::Vector<katana::gstl::Vector<Node>> subgraph_edges;
-  subgraph_edges.resize(num_nodes);
-
   katana::do_all(
-      katana::iterate(Node(0), Node(num_nodes)),
-      [&](const Node& n) {
-        Node src = node_set[n];
-
-        auto last = graph.edges(src).end();
-        for (Node m = 0; m < num_nodes; ++m) {
-          auto dest = node_set[m];
-          // Binary search on the edges sorted by destination id
-          for (auto edge_it = graph.find_edge(src, dest);
-               edge_it != last && graph.edge_dest(*edge_it) == dest;
-               ++edge_it) {
-            subgraph_edges[n].push_back(m);
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Edge num_kept = 0;
+        for (Edge e : topology.edges(node_set[n])) {
+          if (original_to_sub[topology.edge_dest(e)] != kInvalidNode &&
+              edge_filter(e)) {
+            ++num_kept;
           }
         }
-        out_indices[n] = subgraph_edges[n].size();
+        out_indices[n] = num_kept;
       },
       katana::steal(), katana::loopname("SubgraphExtraction"));
 
@@ -69,58 +146,298 @@ SubGraphNodeSet(
       out_indices.begin(), out_indices.end(), out_indices.begin());
   uint64_t num_edges = out_indices[num_nodes - 1];
 
-  // Subgraph topology : out dests
+  // Subgraph topology : out dests, plus the original id of every edge so that
+  // edge types and properties can be gathered afterwards
   katana::NUMAArray<Node> out_dests;
   out_dests.allocateInterleaved(num_edges);
+  std::vector<Edge> sub_to_original_edges(num_edges);
 
   katana::do_all(
-      katana::iterate(Node(0), Node(num_nodes)),
-      [&](const Node& n) {
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
         uint64_t offset = n == 0 ? 0 : out_indices[n - 1];
-        for (Node dest : subgraph_edges[n]) {
-          out_dests[offset] = dest;
-          offset++;
+        for (Edge e : topology.edges(node_set[n])) {
+          Node dest = original_to_sub[topology.edge_dest(e)];
+          if (dest != kInvalidNode && edge_filter(e)) {
+            out_dests[offset] = dest;
+            sub_to_original_edges[offset] = e;
+            offset++;
+          }
         }
+        KATANA_LOG_DEBUG_ASSERT(offset == out_indices[n]);
       },
       katana::steal(), katana::loopname("ConstructTopology"));
 
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { node_type_ids[n] = pg->GetTypeOfNode(node_set[n]); },
+      katana::no_stats());
+
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        edge_type_ids[e] = pg->GetTypeOfEdge(sub_to_original_edges[e]);
+      },
+      katana::no_stats());
+
   katana::GraphTopology sub_g_topo{
       std::move(out_indices), std::move(out_dests)};
-  auto sub_g_res = katana::PropertyGraph::Make(std::move(sub_g_topo));
+  std::unique_ptr<katana::PropertyGraph> sub_g =
+      KATANA_CHECKED(katana::PropertyGraph::Make(
+          std::move(sub_g_topo), std::move(node_type_ids),
+          std::move(edge_type_ids),
+          katana::EntityTypeManager{pg->GetNodeTypeManager()},
+          katana::EntityTypeManager{pg->GetEdgeTypeManager()}));
+
+  if (!node_properties_to_copy.empty()) {
+    auto node_props = KATANA_CHECKED(TakeProperties(
+        pg->NodeMutablePropertyView(), node_properties_to_copy, node_set));
+    KATANA_CHECKED(sub_g->AddNodeProperties(node_props));
+  }
+  if (!edge_properties_to_copy.empty()) {
+    auto edge_props = KATANA_CHECKED(TakeProperties(
+        pg->EdgeMutablePropertyView(), edge_properties_to_copy,
+        sub_to_original_edges));
+    KATANA_CHECKED(sub_g->AddEdgeProperties(edge_props));
+  }
 
-  return sub_g_res;
+  return std::unique_ptr<katana::PropertyGraph>(std::move(sub_g));
 }
-}  // namespace
 
-katana::Result<std::unique_ptr<katana::PropertyGraph>>
-katana::analytics::SubGraphExtraction(
-    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
-    SubGraphExtractionPlan plan) {
-  // Remove duplicates from the node vector
-  std::unordered_set<uint32_t> set;
-  std::vector<uint32_t> dedup_node_vec;
+/// Remove duplicates from the node vector, keeping first occurrences in order.
+katana::Result<std::vector<Node>>
+DedupNodeSet(
+    const katana::PropertyGraph& pg, const std::vector<Node>& node_vec) {
+  std::unordered_set<Node> set;
+  std::vector<Node> dedup_node_vec;
   for (auto n : node_vec) {
+    if (n >= pg.num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "node {} out of range; graph has {} nodes", n, pg.num_nodes());
+    }
     if (set.insert(n).second) {  // If n wasn't already present.
       dedup_node_vec.push_back(n);
     }
   }
+  return dedup_node_vec;
+}
+
+/// Collect all nodes within num_hops of the seeds, in ascending order.
+template <bool kFollowInEdges, typename Graph>
+std::vector<Node>
+KHopNeighborhood(
+    const Graph& graph, const std::vector<Node>& seed_nodes,
+    uint32_t num_hops) {
+  katana::DynamicBitset visited;
+  visited.resize(graph.num_nodes());
+
+  auto current = std::make_unique<katana::InsertBag<Node>>();
+  auto next = std::make_unique<katana::InsertBag<Node>>();
+
+  for (Node seed : seed_nodes) {
+    if (!visited.set(seed)) {
+      next->emplace(seed);
+    }
+  }
+
+  for (uint32_t hop = 0; hop < num_hops && !next->empty(); ++hop) {
+    std::swap(current, next);
+    next->clear();
+
+    katana::do_all(
+        katana::iterate(*current),
+        [&](const Node& n) {
+          for (auto e : graph.edges(n)) {
+            Node dest = graph.edge_dest(e);
+            if (!visited.set(dest)) {
+              next->emplace(dest);
+            }
+          }
+          if constexpr (kFollowInEdges) {
+            for (auto e : graph.in_edges(n)) {
+              Node src = graph.in_edge_dest(e);
+              if (!visited.set(src)) {
+                next->emplace(src);
+              }
+            }
+          }
+        },
+        katana::steal(), katana::loopname("EgoNetworkHop"));
+  }
+
+  return visited.GetOffsets<Node>();
+}
+
+}  // namespace
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtraction(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
+    SubGraphExtractionPlan plan) {
+  return SubGraphExtraction(pg, node_vec, {}, {}, plan);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtraction(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    SubGraphExtractionPlan plan) {
+  std::vector<Node> dedup_node_vec =
+      KATANA_CHECKED(DedupNodeSet(*pg, node_vec));
 
   if (dedup_node_vec.empty()) {
     return std::make_unique<katana::PropertyGraph>();
   }
 
-  SortedGraphView sg = pg->BuildView<SortedGraphView>();
-
   katana::StatTimer execTime("SubGraph-Extraction");
   switch (plan.algorithm()) {
   case SubGraphExtractionPlan::kNodeSet: {
     execTime.start();
-    auto subgraph = SubGraphNodeSet(sg, dedup_node_vec);
+    auto subgraph = BuildSubGraph(
+        pg, dedup_node_vec, [](Edge) { return true; },
+        node_properties_to_copy, edge_properties_to_copy);
     execTime.stop();
-    KATANA_LOG_DEBUG_ASSERT(subgraph);
-    return std::move(subgraph.value());
+    return subgraph;
   }
   default:
     return katana::ErrorCode::InvalidArgument;
   }
 }
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtractionByEdgePredicate(
+    katana::PropertyGraph* pg,
+    const std::function<bool(katana::PropertyGraph::Edge)>& edge_predicate,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy) {
+  const GraphTopology& topology = pg->topology();
+
+  katana::StatTimer execTime("SubGraph-Extraction-EdgePredicate");
+  execTime.start();
+
+  // The predicate is evaluated exactly once per edge; the result is kept so
+  // that both topology passes see the same selection.
+  katana::DynamicBitset kept_edges;
+  kept_edges.resize(topology.num_edges());
+  katana::DynamicBitset kept_nodes;
+  kept_nodes.resize(topology.num_nodes());
+
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node src) {
+        for (Edge e : topology.edges(src)) {
+          if (edge_predicate(e)) {
+            kept_edges.set(e);
+            kept_nodes.set(src);
+            kept_nodes.set(topology.edge_dest(e));
+          }
+        }
+      },
+      katana::steal(), katana::loopname("SelectEdges"));
+
+  auto subgraph = BuildSubGraph(
+      pg, kept_nodes.GetOffsets<Node>(),
+      [&](Edge e) { return kept_edges.test(e); }, node_properties_to_copy,
+      edge_properties_to_copy);
+  execTime.stop();
+  return subgraph;
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtractionByEntityTypes(
+    katana::PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy) {
+  std::vector<katana::EntityTypeID> node_type_ids;
+  for (const auto& name : node_types) {
+    if (!pg->HasAtomicNodeType(name)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotFound, "node type does not exist: {}", name);
+    }
+    node_type_ids.emplace_back(pg->GetNodeEntityTypeID(name));
+  }
+  std::vector<katana::EntityTypeID> edge_type_ids;
+  for (const auto& name : edge_types) {
+    if (!pg->HasAtomicEdgeType(name)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotFound, "edge type does not exist: {}", name);
+    }
+    edge_type_ids.emplace_back(pg->GetEdgeEntityTypeID(name));
+  }
+
+  katana::StatTimer execTime("SubGraph-Extraction-EntityTypes");
+  execTime.start();
+
+  katana::DynamicBitset kept_nodes;
+  kept_nodes.resize(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(pg->topology().all_nodes()),
+      [&](Node n) {
+        if (node_type_ids.empty()) {
+          kept_nodes.set(n);
+          return;
+        }
+        for (auto type : node_type_ids) {
+          if (pg->DoesNodeHaveType(n, type)) {
+            kept_nodes.set(n);
+            return;
+          }
+        }
+      },
+      katana::no_stats());
+
+  auto edge_filter = [&](Edge e) {
+    if (edge_type_ids.empty()) {
+      return true;
+    }
+    for (auto type : edge_type_ids) {
+      if (pg->DoesEdgeHaveType(e, type)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto subgraph = BuildSubGraph(
+      pg, kept_nodes.GetOffsets<Node>(), edge_filter, node_properties_to_copy,
+      edge_properties_to_copy);
+  execTime.stop();
+  return subgraph;
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::EgoNetworkExtraction(
+    katana::PropertyGraph* pg, const std::vector<Node>& seed_nodes,
+    uint32_t num_hops, bool follow_in_edges,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy) {
+  std::vector<Node> seeds = KATANA_CHECKED(DedupNodeSet(*pg, seed_nodes));
+  if (seeds.empty()) {
+    return std::make_unique<katana::PropertyGraph>();
+  }
+
+  katana::StatTimer execTime("SubGraph-Extraction-EgoNetwork");
+  execTime.start();
+
+  std::vector<Node> node_set;
+  if (follow_in_edges) {
+    auto bidir_view =
+        pg->BuildView<katana::PropertyGraphViews::BiDirectional>();
+    node_set = KHopNeighborhood<true>(bidir_view, seeds, num_hops);
+  } else {
+    node_set = KHopNeighborhood<false>(pg->topology(), seeds, num_hops);
+  }
+
+  auto subgraph = BuildSubGraph(
+      pg, node_set, [](Edge) { return true; }, node_properties_to_copy,
+      edge_properties_to_copy);
+  execTime.stop();
+  return subgraph;
+}
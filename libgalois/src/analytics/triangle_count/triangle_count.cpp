@@ -19,6 +19,7 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include "katana/EdgeBalancedRange.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -113,52 +114,59 @@ struct GreaterThanOrEqual {
  *
  * Thomas Schank. Algorithmic Aspects of Triangle-Based Network Analysis. PhD
  * Thesis. Universitat Karlsruhe. 2007.
+ *
+ * The neighbors b of a node with a very large degree are split among threads.
  */
 size_t
 NodeIteratingAlgo(const SortedGraphView* graph) {
   katana::GAccumulator<size_t> numTriangles;
 
-  katana::do_all(
-      katana::iterate(*graph),
-      [&](const Node& n) {
-        // Partition neighbors
-        // [first, ea) [n] [bb, last)
-        edge_iterator first = graph->edges(n).begin();
-        edge_iterator last = graph->edges(n).end();
-        edge_iterator ea =
-            LowerBound(first, last, LessThan<SortedGraphView>(*graph, n));
-        edge_iterator bb = LowerBound(
-            first, last, GreaterThanOrEqual<SortedGraphView>(*graph, n));
-
-        for (; bb != last; ++bb) {
-          Node B = graph->edge_dest(*bb);
-          for (auto aa = first; aa != ea; ++aa) {
-            Node A = graph->edge_dest(*aa);
-            edge_iterator vv = graph->edges(A).begin();
-            edge_iterator ev = graph->edges(A).end();
-            edge_iterator it =
-                LowerBound(vv, ev, LessThan<SortedGraphView>(*graph, B));
-            if (it != ev && graph->edge_dest(*it) == B) {
-              numTriangles += 1;
-            }
-          }
+  auto ranges = katana::EdgeBalancedRanges::Make(*graph);
+  ranges.ReportImbalance("TriangleCount");
+  auto count = [&](const Node& n, const auto& edges) {
+    // Partition neighbors
+    // [first, ea) [n] [bb, last)
+    edge_iterator first = graph->edges(n).begin();
+    edge_iterator last = graph->edges(n).end();
+    edge_iterator ea =
+        LowerBound(first, last, LessThan<SortedGraphView>(*graph, n));
+    edge_iterator bb = LowerBound(
+        first, last, GreaterThanOrEqual<SortedGraphView>(*graph, n));
+
+    // Only the neighbors b in this part of the edges of n
+    bb = std::max(bb, edges.begin());
+    edge_iterator eb = std::min(last, edges.end());
+
+    for (; bb < eb; ++bb) {
+      Node B = graph->edge_dest(*bb);
+      for (auto aa = first; aa != ea; ++aa) {
+        Node A = graph->edge_dest(*aa);
+        edge_iterator vv = graph->edges(A).begin();
+        edge_iterator ev = graph->edges(A).end();
+        edge_iterator it =
+            LowerBound(vv, ev, LessThan<SortedGraphView>(*graph, B));
+        if (it != ev && graph->edge_dest(*it) == B) {
+          numTriangles += 1;
         }
-      },
-      katana::chunk_size<kChunkSize>(), katana::steal(),
-      katana::loopname("TriangleCount_NodeIteratingAlgo"));
+      }
+    }
+  };
+  ranges.ForEachEdgeRange(
+      *graph, count, katana::loopname("TriangleCount_NodeIteratingAlgo"));
 
   return numTriangles.reduce();
 }
 
 /**
- * Lambda function to count triangles
+ * Lambda function to count triangles over the edges of n in edges_n_range
  */
+template <typename EdgeRange>
 void
 OrderedCountFunc(
-    const SortedGraphView* graph, Node n,
+    const SortedGraphView* graph, Node n, const EdgeRange& edges_n_range,
     katana::GAccumulator<size_t>& numTriangles) {
   size_t numTriangles_local = 0;
-  for (auto edges_n : graph->edges(n)) {
+  for (auto edges_n : edges_n_range) {
     Node v = graph->edge_dest(edges_n);
     if (v > n) {
       break;
@@ -187,10 +195,13 @@ OrderedCountFunc(
 size_t
 OrderedCountAlgo(const SortedGraphView* graph) {
   katana::GAccumulator<size_t> numTriangles;
-  katana::do_all(
-      katana::iterate(*graph),
-      [&](const Node& n) { OrderedCountFunc(graph, n, numTriangles); },
-      katana::chunk_size<kChunkSize>(), katana::steal(),
+  auto ranges = katana::EdgeBalancedRanges::Make(*graph);
+  ranges.ReportImbalance("TriangleCount");
+  ranges.ForEachEdgeRange(
+      *graph,
+      [&](const Node& n, const auto& edges) {
+        OrderedCountFunc(graph, n, edges, numTriangles);
+      },
       katana::loopname("TriangleCount_OrderedCountAlgo"));
 
   return numTriangles.reduce();
@@ -208,48 +219,39 @@ OrderedCountAlgo(const SortedGraphView* graph) {
  *
  * Thomas Schank. Algorithmic Aspects of Triangle-Based Network Analysis. PhD
  * Thesis. Universitat Karlsruhe. 2007.
+ *
+ * Edges are visited directly, finding their sources with an EdgeSourceIndex,
+ * rather than first collecting the (a, b) pairs into a bag.
  */
 size_t
 EdgeIteratingAlgo(const SortedGraphView* graph) {
-  struct WorkItem {
-    Node src;
-    Node dst;
-    WorkItem(const Node& a1, const Node& a2) : src(a1), dst(a2) {}
-  };
-
-  katana::InsertBag<WorkItem> items;
   katana::GAccumulator<size_t> numTriangles;
 
-  katana::do_all(
-      katana::iterate(*graph),
-      [&](Node n) {
-        for (auto edge : graph->edges(n)) {
-          auto dest = graph->edge_dest(edge);
-          if (n < dest) {
-            items.push(WorkItem(n, dest));
-          }
-        }
-      },
-      katana::loopname("TriangleCount_Initialize"));
+  auto index = katana::EdgeSourceIndex::Make(*graph);
 
   katana::do_all(
-      katana::iterate(items),
-      [&](const WorkItem& w) {
-        // Compute intersection of range (w.src, w.dst) in neighbors of
-        // w.src and w.dst
-        edge_iterator abegin = graph->edges(w.src).begin();
-        edge_iterator aend = graph->edges(w.src).end();
-        edge_iterator bbegin = graph->edges(w.dst).begin();
-        edge_iterator bend = graph->edges(w.dst).end();
+      katana::iterate(index->all_edges()),
+      [&](const SortedGraphView::Edge& e) {
+        Node src = index->edge_source(e);
+        Node dst = index->edge_dest(e);
+        if (src >= dst) {
+          return;
+        }
+        // Compute intersection of range (src, dst) in neighbors of src and
+        // dst
+        edge_iterator abegin = graph->edges(src).begin();
+        edge_iterator aend = graph->edges(src).end();
+        edge_iterator bbegin = graph->edges(dst).begin();
+        edge_iterator bend = graph->edges(dst).end();
 
         edge_iterator aa = LowerBound(
-            abegin, aend, GreaterThanOrEqual<SortedGraphView>(*graph, w.src));
+            abegin, aend, GreaterThanOrEqual<SortedGraphView>(*graph, src));
         edge_iterator ea =
-            LowerBound(abegin, aend, LessThan<SortedGraphView>(*graph, w.dst));
+            LowerBound(abegin, aend, LessThan<SortedGraphView>(*graph, dst));
         edge_iterator bb = LowerBound(
-            bbegin, bend, GreaterThanOrEqual<SortedGraphView>(*graph, w.src));
+            bbegin, bend, GreaterThanOrEqual<SortedGraphView>(*graph, src));
         edge_iterator eb =
-            LowerBound(bbegin, bend, LessThan<SortedGraphView>(*graph, w.dst));
+            LowerBound(bbegin, bend, LessThan<SortedGraphView>(*graph, dst));
 
         numTriangles += CountEqual(*graph, aa, ea, bb, eb);
       },
@@ -323,7 +325,8 @@ katana::analytics::TriangleCount(
   timer_graph_read.stop();
 #endif
 
-  katana::EnsurePreallocated(1, 16 * (pg->num_nodes() + pg->num_edges()));
+  KATANA_CHECKED(katana::TryEnsurePreallocated(
+      1, 16 * (pg->num_nodes() + pg->num_edges())));
   katana::ReportPageAllocGuard page_alloc;
 
   KATANA_LOG_VERBOSE("Done relabeling. Starting TriangleCount");
@@ -81,8 +81,8 @@ void
 run_interleaved(size_t seed, size_t mega, bool full) {
   size_t size = mega * 1024 * 1024;
   auto ptr = katana::largeMallocInterleaved(
-      size * sizeof(int),
-      full ? katana::GetThreadPool().getMaxThreads() : katana::activeThreads);
+      size * sizeof(int), full ? katana::GetThreadPool().getMaxThreads()
+                               : katana::getActiveThreads());
   int* block = (int*)ptr.get();
 
   run_interleaved_helper r(block, seed, size);
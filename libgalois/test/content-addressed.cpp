@@ -0,0 +1,180 @@
+#include <set>
+#include <string>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+#include "tsuba/RDGManifest.h"
+#include "tsuba/tsuba.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+constexpr katana::GraphTopology::Node kNumNodes = 10;
+
+std::shared_ptr<arrow::Table>
+MakeProperty(const std::string& name, int64_t offset) {
+  arrow::Int64Builder values;
+  for (int64_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(values.Append(n + offset).ok());
+  }
+  std::shared_ptr<arrow::Array> array = values.Finish().ValueOrDie();
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {array});
+}
+
+/// A cycle through all nodes with node property "value"
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (katana::GraphTopology::Node n = 0; n < kNumNodes; ++n) {
+    builder.AddEdge(n, (n + 1) % kNumNodes);
+  }
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(MakeProperty("value", 0)));
+  return pg;
+}
+
+bool
+IsBlob(const std::string& file) {
+  return file.rfind("blob_", 0) == 0;
+}
+
+/// \returns the names of the content addressed files in rdg_dir, and checks
+/// that data files have no other names
+std::set<std::string>
+ListBlobs(const std::string& rdg_dir) {
+  std::set<std::string> blobs;
+  for (const auto& entry : fs::directory_iterator(rdg_dir)) {
+    std::string file = entry.path().filename().string();
+    if (IsBlob(file)) {
+      blobs.emplace(file);
+      continue;
+    }
+    // Everything else is a manifest or a part header
+    KATANA_LOG_VASSERT(
+        tsuba::RDGManifest::ParseVersionFromName(file) ||
+            file.rfind("part_vers", 0) == 0,
+        "unexpected file {}", file);
+  }
+  return blobs;
+}
+
+std::unique_ptr<katana::PropertyGraph>
+Load(const std::string& rdg_dir) {
+  auto res = katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  if (!res) {
+    KATANA_LOG_FATAL("making result: {}", res.error());
+  }
+  return std::move(res.value());
+}
+
+void
+Commit(katana::PropertyGraph* pg, const std::string& command_line) {
+  if (auto res = pg->Commit(command_line); !res) {
+    KATANA_LOG_FATAL("committing {}: {}", command_line, res.error());
+  }
+}
+
+/// Delete the manifests of all versions but the latest
+void
+DeleteOldManifests(const std::string& rdg_dir) {
+  uint64_t latest = 0;
+  for (const auto& entry : fs::directory_iterator(rdg_dir)) {
+    if (auto version = tsuba::RDGManifest::ParseVersionFromName(
+            entry.path().filename().string());
+        version) {
+      latest = std::max(latest, version.value());
+    }
+  }
+  for (const auto& entry : fs::directory_iterator(rdg_dir)) {
+    if (auto version = tsuba::RDGManifest::ParseVersionFromName(
+            entry.path().filename().string());
+        version && version.value() < latest) {
+      fs::remove(entry.path());
+    }
+  }
+}
+
+/// Versions share the files whose contents did not change, and the files
+/// none of them refers to are collected
+void
+TestVersions(const std::string& rdg_dir) {
+  auto pg = MakeGraph();
+  pg->set_content_addressed(true);
+  if (auto res = pg->Write(rdg_dir, "content-addressed"); !res) {
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  std::set<std::string> first_blobs = ListBlobs(rdg_dir);
+  KATANA_LOG_ASSERT(!first_blobs.empty());
+
+  // Writing the same values again adds no files
+  pg = Load(rdg_dir);
+  KATANA_LOG_ASSERT(pg->content_addressed());
+  KATANA_LOG_ASSERT(pg->UpsertNodeProperties(MakeProperty("value", 0)));
+  Commit(pg.get(), "same values");
+  KATANA_LOG_ASSERT(ListBlobs(rdg_dir) == first_blobs);
+
+  // A new property adds one file
+  pg = Load(rdg_dir);
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(MakeProperty("other", 100)));
+  Commit(pg.get(), "new property");
+  std::set<std::string> second_blobs = ListBlobs(rdg_dir);
+  KATANA_LOG_ASSERT(second_blobs.size() == first_blobs.size() + 1);
+
+  // Nothing is collected while an old version refers to the property
+  pg = Load(rdg_dir);
+  KATANA_LOG_ASSERT(pg->RemoveNodeProperty("other"));
+  Commit(pg.get(), "remove property");
+  KATANA_LOG_ASSERT(tsuba::CollectGarbage(rdg_dir).value() == 0);
+  KATANA_LOG_ASSERT(ListBlobs(rdg_dir) == second_blobs);
+
+  DeleteOldManifests(rdg_dir);
+  KATANA_LOG_ASSERT(tsuba::CollectGarbage(rdg_dir).value() == 1);
+  KATANA_LOG_ASSERT(ListBlobs(rdg_dir) == first_blobs);
+
+  pg = Load(rdg_dir);
+  auto value = pg->GetNodeProperty("value");
+  KATANA_LOG_ASSERT(value);
+  KATANA_LOG_ASSERT(
+      value.value()->Equals(*MakeProperty("value", 0)->column(0)));
+  KATANA_LOG_ASSERT(pg->topology().num_edges() == kNumNodes);
+}
+
+/// Without content addressing, files keep their random names
+void
+TestDisabled(const std::string& rdg_dir) {
+  auto pg = MakeGraph();
+  KATANA_LOG_ASSERT(!pg->content_addressed());
+  if (auto res = pg->Write(rdg_dir, "content-addressed"); !res) {
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  for (const auto& entry : fs::directory_iterator(rdg_dir)) {
+    KATANA_LOG_ASSERT(!IsBlob(entry.path().filename().string()));
+  }
+  KATANA_LOG_ASSERT(tsuba::CollectGarbage(rdg_dir).value() == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  for (auto test : {TestVersions, TestDisabled}) {
+    auto uri_res = katana::Uri::MakeRand("/tmp/content-addressed");
+    KATANA_LOG_ASSERT(uri_res);
+    std::string rdg_dir(uri_res.value().path());  // path() because local
+    test(rdg_dir);
+    fs::remove_all(rdg_dir);
+  }
+
+  return 0;
+}
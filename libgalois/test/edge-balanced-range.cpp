@@ -0,0 +1,118 @@
+#include <atomic>
+
+#include "katana/EdgeBalancedRange.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/NUMAArray.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+
+using Edge = katana::GraphTopology::Edge;
+using Node = katana::GraphTopology::Node;
+
+namespace {
+
+constexpr size_t kNumNodes = 1000;
+
+/// Node 0 is a hub with an edge to every other node, and every other node
+/// has an edge to its successor
+katana::GraphTopology
+MakeSkewedTopology() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (Node n = 1; n < kNumNodes; ++n) {
+    builder.AddEdge(0, n);
+  }
+  for (Node n = 1; n + 1 < kNumNodes; ++n) {
+    builder.AddEdge(n, n + 1);
+  }
+  return builder.ConvertToCSR();
+}
+
+void
+TestNodeRanges(const katana::GraphTopology& topo, uint32_t num_threads) {
+  auto ranges = katana::EdgeBalancedRanges::Make(topo, num_threads);
+  KATANA_LOG_ASSERT(ranges.num_threads() == num_threads);
+
+  // The node ranges are contiguous and cover all nodes
+  Node next = 0;
+  for (uint32_t tid = 0; tid < num_threads; ++tid) {
+    auto [begin, end] = ranges.node_range(tid);
+    KATANA_LOG_ASSERT(begin == next);
+    KATANA_LOG_ASSERT(begin <= end);
+    next = end;
+  }
+  KATANA_LOG_ASSERT(next == topo.num_nodes());
+
+  KATANA_LOG_ASSERT(ranges.imbalance() >= 1.0);
+}
+
+void
+TestIterate(const katana::GraphTopology& topo) {
+  auto ranges = katana::EdgeBalancedRanges::Make(topo);
+
+  katana::NUMAArray<std::atomic<uint32_t>> visits;
+  visits.allocateInterleaved(topo.num_nodes());
+  for (Node n = 0; n < topo.num_nodes(); ++n) {
+    visits.constructAt(n, 0);
+  }
+
+  katana::do_all(
+      ranges.iterate(), [&](Node n) { visits[n].fetch_add(1); },
+      katana::steal());
+  for (Node n = 0; n < topo.num_nodes(); ++n) {
+    KATANA_LOG_ASSERT(visits[n] == 1);
+  }
+}
+
+void
+TestForEachEdgeRange(const katana::GraphTopology& topo) {
+  auto ranges = katana::EdgeBalancedRanges::Make(topo);
+
+  katana::NUMAArray<std::atomic<uint32_t>> visits;
+  visits.allocateInterleaved(topo.num_edges());
+  for (Edge e = 0; e < topo.num_edges(); ++e) {
+    visits.constructAt(e, 0);
+  }
+
+  ranges.ForEachEdgeRange(topo, [&](Node n, const auto& edges) {
+    KATANA_LOG_ASSERT(*edges.begin() >= *topo.edges(n).begin());
+    KATANA_LOG_ASSERT(*edges.end() <= *topo.edges(n).end());
+    for (Edge e : edges) {
+      visits[e].fetch_add(1);
+    }
+  });
+  for (Edge e = 0; e < topo.num_edges(); ++e) {
+    KATANA_LOG_ASSERT(visits[e] == 1);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::setActiveThreads(4);
+
+  katana::GraphTopology skewed = MakeSkewedTopology();
+  katana::GraphTopology uniform =
+      katana::CreateUniformRandomTopology(kNumNodes, 5);
+
+  for (uint32_t num_threads : {1, 3, 8}) {
+    TestNodeRanges(skewed, num_threads);
+    TestNodeRanges(uniform, num_threads);
+  }
+
+  // The hub has half the edges, which no node split can balance
+  auto skewed_ranges = katana::EdgeBalancedRanges::Make(skewed, 8);
+  KATANA_LOG_ASSERT(skewed_ranges.imbalance() > 3.0);
+  KATANA_LOG_ASSERT(
+      skewed_ranges.imbalance() < skewed_ranges.even_split_imbalance());
+
+  TestIterate(skewed);
+  TestIterate(uniform);
+  TestForEachEdgeRange(skewed);
+  TestForEachEdgeRange(uniform);
+
+  return 0;
+}
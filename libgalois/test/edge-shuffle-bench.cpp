@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include "katana/EdgeBalancedRange.h"
+#include "katana/EdgeShuffle.h"
+#include "katana/GraphTopology.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Edge = katana::GraphTopology::Edge;
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kEdgesPerNode = 8;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20, 1 << 23}) {
+    b->Args({num_nodes});
+  }
+}
+
+/// Transpose by writing each edge directly to its place in the output,
+/// claimed with an atomic increment
+katana::ShuffledEdges
+TransposeByScatter(const katana::GraphTopology& topo) {
+  katana::ShuffledEdges ret;
+  ret.adj_indices.allocateInterleaved(topo.num_nodes());
+  ret.dests.allocateInterleaved(topo.num_edges());
+  ret.edge_prop_indices.allocateInterleaved(topo.num_edges());
+  katana::NUMAArray<Edge> offsets;
+  offsets.allocateInterleaved(topo.num_nodes());
+
+  katana::ParallelSTL::fill(
+      ret.adj_indices.begin(), ret.adj_indices.end(), Edge{0});
+  katana::do_all(
+      katana::iterate(topo.all_edges()),
+      [&](Edge e) {
+        __sync_add_and_fetch(&ret.adj_indices[topo.edge_dest(e)], 1);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      ret.adj_indices.begin(), ret.adj_indices.end(), ret.adj_indices.begin());
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](Node n) { offsets[n] = n == 0 ? 0 : ret.adj_indices[n - 1]; },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](Node src) {
+        for (Edge e : topo.edges(src)) {
+          Edge pos = __sync_fetch_and_add(&offsets[topo.edge_dest(e)], 1);
+          ret.dests[pos] = src;
+          ret.edge_prop_indices[pos] = e;
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return ret;
+}
+
+void
+Scatter(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TransposeByScatter(topo));
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+void
+Shuffle(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(katana::TransposeEdges(topo));
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+/// The ranges that every shuffle builds, to compare with the shuffle itself
+void
+BuildRanges(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(katana::EdgeBalancedRanges::Make(topo));
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+BENCHMARK(Scatter)->Apply(MakeArguments);
+BENCHMARK(Shuffle)->Apply(MakeArguments);
+BENCHMARK(BuildRanges)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/EdgeShuffle.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/TopologyGeneration.h"
+
+using Edge = katana::GraphTopology::Edge;
+using Node = katana::GraphTopology::Node;
+
+namespace {
+
+using Adjacency = std::vector<std::vector<std::pair<Node, Edge>>>;
+
+/// Random graph where every fifth edge is a self loop, every seventh repeats
+/// the previous destination and every 97th node is a hub
+katana::GraphTopology
+MakeTopology(uint32_t num_nodes, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<Node> node(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> degree(0, 8);
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+  for (Node src = 0; src < num_nodes; ++src) {
+    uint32_t num_edges = src % 97 == 0 ? 200 : degree(gen);
+    Node prev = src;
+    for (uint32_t i = 0; i < num_edges; ++i) {
+      Node dest = i % 5 == 0 ? src : (i % 7 == 0 ? prev : node(gen));
+      builder.AddEdge(src, dest);
+      prev = dest;
+    }
+  }
+  return builder.ConvertToCSR();
+}
+
+/// The (destination, input edge) pairs of each node, straightforwardly
+Adjacency
+Expected(
+    const katana::GraphTopology& topo, bool symmetric,
+    const katana::EdgeShuffleOptions& opts) {
+  Adjacency ret(topo.num_nodes());
+  for (Node src = 0; src < topo.num_nodes(); ++src) {
+    for (Edge e : topo.edges(src)) {
+      Node dest = topo.edge_dest(e);
+      if (src == dest) {
+        if (!opts.remove_self_loops) {
+          ret[src].emplace_back(dest, e);
+        }
+        continue;
+      }
+      if (symmetric) {
+        ret[src].emplace_back(dest, e);
+      }
+      ret[dest].emplace_back(src, e);
+    }
+  }
+  for (auto& edges : ret) {
+    std::stable_sort(edges.begin(), edges.end(), [](auto a, auto b) {
+      return a.second < b.second;
+    });
+    if (opts.remove_duplicates) {
+      std::sort(edges.begin(), edges.end());
+      auto last = std::unique(edges.begin(), edges.end(), [](auto a, auto b) {
+        return a.first == b.first;
+      });
+      edges.erase(last, edges.end());
+    }
+  }
+  return ret;
+}
+
+void
+CheckEdges(
+    const katana::ShuffledEdges& edges, const katana::GraphTopology& topo,
+    bool symmetric, const katana::EdgeShuffleOptions& opts) {
+  Adjacency expected = Expected(topo, symmetric, opts);
+  KATANA_LOG_ASSERT(edges.adj_indices.size() == topo.num_nodes());
+
+  Edge begin = 0;
+  for (Node n = 0; n < topo.num_nodes(); ++n) {
+    Edge end = edges.adj_indices[n];
+    KATANA_LOG_VASSERT(
+        end - begin == expected[n].size(), "node {} has {} edges, not {}", n,
+        end - begin, expected[n].size());
+    for (Edge e = begin; e < end; ++e) {
+      KATANA_LOG_ASSERT(edges.dests[e] == expected[n][e - begin].first);
+      KATANA_LOG_ASSERT(
+          edges.edge_prop_indices[e] == expected[n][e - begin].second);
+    }
+    begin = end;
+  }
+  KATANA_LOG_ASSERT(edges.dests.size() == begin);
+  KATANA_LOG_ASSERT(edges.edge_prop_indices.size() == begin);
+}
+
+/// The result is the same for any number of threads and any number of
+/// buckets
+void
+TestShuffle() {
+  for (uint32_t num_threads : {1u, 3u, 8u}) {
+    katana::setActiveThreads(num_threads);
+    for (uint32_t num_nodes : {1u, 5u, 1000u, 70000u}) {
+      katana::GraphTopology topo = MakeTopology(num_nodes, num_nodes);
+      for (bool self_loops : {false, true}) {
+        for (bool duplicates : {false, true}) {
+          katana::EdgeShuffleOptions opts{self_loops, duplicates};
+          CheckEdges(katana::TransposeEdges(topo, opts), topo, false, opts);
+          CheckEdges(katana::SymmetrizeEdges(topo, opts), topo, true, opts);
+        }
+      }
+    }
+  }
+}
+
+/// Both edges made from an edge keep its properties
+void
+TestSymmetricGraphProperties() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(3);
+  builder.AddEdge(0, 1);
+  builder.AddEdge(0, 1);
+  builder.AddEdge(1, 1);
+  builder.AddEdge(2, 0);
+
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+  KATANA_LOG_ASSERT(katana::AddNodeProperties(
+      pg.get(), katana::PropertyGenerator("id", [](Node n) {
+        return static_cast<int64_t>(n * 10);
+      })));
+  KATANA_LOG_ASSERT(katana::AddEdgeProperties(
+      pg.get(), katana::PropertyGenerator("weight", [](Edge e) {
+        return static_cast<int64_t>(e * 10);
+      })));
+
+  katana::EdgeShuffleOptions opts;
+  opts.remove_duplicates = true;
+  auto sym = katana::CreateSymmetricGraph(pg.get(), opts).value();
+  const katana::GraphTopology& topo = sym->topology();
+  KATANA_LOG_ASSERT(topo.num_nodes() == 3);
+  // 0 -> 1, 0 -> 2, 1 -> 0, 1 -> 1, 2 -> 0
+  KATANA_LOG_ASSERT(topo.num_edges() == 5);
+
+  auto ids = std::static_pointer_cast<arrow::Int64Array>(
+      sym->GetNodeProperty("id").value()->chunk(0));
+  for (Node n = 0; n < 3; ++n) {
+    KATANA_LOG_ASSERT(ids->Value(n) == n * 10);
+  }
+
+  auto weights = sym->GetEdgeProperty("weight").value();
+  KATANA_LOG_ASSERT(weights->length() == 5);
+  std::vector<int64_t> expected{0, 30, 0, 20, 30};
+  for (Edge e = 0; e < 5; ++e) {
+    auto value = std::static_pointer_cast<arrow::Int64Scalar>(
+        weights->GetScalar(e).ValueOrDie());
+    KATANA_LOG_ASSERT(value->value == expected[e]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestShuffle();
+  TestSymmetricGraphProperties();
+
+  return 0;
+}
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/Bag.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/triangle_count/triangle_count.h"
+
+namespace {
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+constexpr size_t kEdgesPerNode = 8;
+
+void
+MakeNodeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    b->Args({num_nodes});
+  }
+}
+
+void
+MakeStrideArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    for (long stride : {1, 8, 64}) {
+      b->Args({num_nodes, stride});
+    }
+  }
+}
+
+void
+MakeTileArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    for (long tile_size : {64, 512}) {
+      b->Args({num_nodes, tile_size});
+    }
+  }
+}
+
+/// Sum of the sources of all edges, visiting the edges in parallel
+template <typename Topo>
+uint64_t
+SumOfSources(const Topo& topo, uint64_t num_edges) {
+  katana::GAccumulator<uint64_t> sum;
+  katana::do_all(
+      katana::iterate(Edge{0}, Edge{num_edges}),
+      [&](Edge e) { sum += topo.edge_source(e); }, katana::no_stats());
+  return sum.reduce();
+}
+
+void
+EdgeSourceSearch(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfSources(topo, topo.num_edges()));
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+void
+EdgeSourceIndexed(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+  auto index = katana::EdgeSourceIndex::Make(topo, state.range(1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfSources(*index, topo.num_edges()));
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+  state.counters["IndexBytes"] = index->num_bytes();
+}
+
+void
+BuildIndex(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    auto index = katana::EdgeSourceIndex::Make(topo, state.range(1));
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+/// An edge centric kernel: the sum over edges of the product of the degrees
+/// of their endpoints, iterating over nodes
+void
+DegreeProductNodeParallel(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  for (auto _ : state) {
+    katana::GAccumulator<uint64_t> sum;
+    katana::do_all(
+        katana::iterate(topo.all_nodes()),
+        [&](Node n) {
+          for (Edge e : topo.edges(n)) {
+            sum += topo.degree(n) * topo.degree(topo.edge_dest(e));
+          }
+        },
+        katana::steal(), katana::no_stats());
+    benchmark::DoNotOptimize(sum.reduce());
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+/// The same kernel iterating over edges
+void
+DegreeProductEdgeParallel(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+  auto index = katana::EdgeSourceIndex::Make(topo, state.range(1));
+
+  for (auto _ : state) {
+    katana::GAccumulator<uint64_t> sum;
+    katana::do_all(
+        katana::iterate(index->all_edges()),
+        [&](Edge e) {
+          sum += topo.degree(index->edge_source(e)) *
+                 topo.degree(index->edge_dest(e));
+        },
+        katana::no_stats());
+    benchmark::DoNotOptimize(sum.reduce());
+  }
+  state.SetItemsProcessed(state.iterations() * topo.num_edges());
+}
+
+using SortedGraphView =
+    katana::PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID;
+
+/// The number of common neighbors of src and dst that lie between them, i.e.,
+/// the triangles that edge iterating triangle counting finds for src -> dst
+size_t
+CountTriangles(const SortedGraphView& graph, Node src, Node dst) {
+  const Node* dests = graph.dest_data();
+  auto a = graph.edges(src);
+  const Node* aa = std::upper_bound(dests + *a.begin(), dests + *a.end(), src);
+  const Node* ea = std::lower_bound(aa, dests + *a.end(), dst);
+  auto b = graph.edges(dst);
+  const Node* bb = std::upper_bound(dests + *b.begin(), dests + *b.end(), src);
+  const Node* eb = std::lower_bound(bb, dests + *b.end(), dst);
+
+  size_t count = 0;
+  while (aa != ea && bb != eb) {
+    if (*aa < *bb) {
+      ++aa;
+    } else if (*bb < *aa) {
+      ++bb;
+    } else {
+      ++count;
+      ++aa;
+      ++bb;
+    }
+  }
+  return count;
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeTriangleCountGraph(benchmark::State& state) {
+  return katana::PropertyGraph::Make(katana::CreateUniformRandomTopology(
+                                         state.range(0), kEdgesPerNode))
+      .value();
+}
+
+/// Edge iterating triangle counting as it was before EdgeSourceIndex: the
+/// endpoints of every edge are first collected into a bag
+void
+TriangleCountEdgeBag(benchmark::State& state) {
+  auto pg = MakeTriangleCountGraph(state);
+  SortedGraphView graph = pg->BuildView<SortedGraphView>();
+
+  for (auto _ : state) {
+    katana::InsertBag<std::pair<Node, Node>> items;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](Node n) {
+          for (Edge e : graph.edges(n)) {
+            Node dest = graph.edge_dest(e);
+            if (n < dest) {
+              items.push(std::make_pair(n, dest));
+            }
+          }
+        },
+        katana::no_stats());
+
+    katana::GAccumulator<size_t> num_triangles;
+    katana::do_all(
+        katana::iterate(items),
+        [&](const std::pair<Node, Node>& item) {
+          num_triangles += CountTriangles(graph, item.first, item.second);
+        },
+        katana::chunk_size<16>(), katana::steal(), katana::no_stats());
+    benchmark::DoNotOptimize(num_triangles.reduce());
+  }
+  state.SetItemsProcessed(state.iterations() * graph.num_edges());
+}
+
+/// The same kernel visiting the edges directly, including the time to build
+/// the index
+void
+TriangleCountEdgeIndexed(benchmark::State& state) {
+  auto pg = MakeTriangleCountGraph(state);
+  SortedGraphView graph = pg->BuildView<SortedGraphView>();
+
+  for (auto _ : state) {
+    auto index = katana::EdgeSourceIndex::Make(graph);
+    katana::GAccumulator<size_t> num_triangles;
+    katana::do_all(
+        katana::iterate(index->all_edges()),
+        [&](Edge e) {
+          Node src = index->edge_source(e);
+          Node dest = index->edge_dest(e);
+          if (src < dest) {
+            num_triangles += CountTriangles(graph, src, dest);
+          }
+        },
+        katana::chunk_size<16>(), katana::steal(), katana::no_stats());
+    benchmark::DoNotOptimize(num_triangles.reduce());
+  }
+  state.SetItemsProcessed(state.iterations() * graph.num_edges());
+}
+
+/// TriangleCount with the edge iteration plan, which uses the indexed kernel
+void
+TriangleCountEdgeIteration(benchmark::State& state) {
+  auto pg = MakeTriangleCountGraph(state);
+  auto plan = katana::analytics::TriangleCountPlan::EdgeIteration();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        katana::analytics::TriangleCount(pg.get(), plan).value());
+  }
+  state.SetItemsProcessed(state.iterations() * pg->num_edges());
+}
+
+/// Connected components with a plan whose edge tiles are read from an
+/// EdgeSourceIndex, including the time to build the index
+void
+RunConnectedComponents(
+    benchmark::State& state,
+    const katana::analytics::ConnectedComponentsPlan& plan) {
+  auto pg = katana::PropertyGraph::Make(katana::CreateUniformRandomTopology(
+                                            state.range(0), kEdgesPerNode))
+                .value();
+
+  for (auto _ : state) {
+    KATANA_LOG_ASSERT(
+        katana::analytics::ConnectedComponents(pg.get(), "component", plan));
+    state.PauseTiming();
+    KATANA_LOG_ASSERT(pg->RemoveNodeProperty("component"));
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * pg->num_edges());
+}
+
+void
+ConnectedComponentsEdgeTiledAsynchronous(benchmark::State& state) {
+  RunConnectedComponents(
+      state, katana::analytics::ConnectedComponentsPlan::EdgeTiledAsynchronous(
+                 state.range(1)));
+}
+
+void
+ConnectedComponentsEdgeTiledAfforest(benchmark::State& state) {
+  RunConnectedComponents(
+      state, katana::analytics::ConnectedComponentsPlan::EdgeTiledAfforest(
+                 state.range(1)));
+}
+
+BENCHMARK(EdgeSourceSearch)->Apply(MakeNodeArguments);
+BENCHMARK(EdgeSourceIndexed)->Apply(MakeStrideArguments);
+BENCHMARK(BuildIndex)->Apply(MakeStrideArguments);
+BENCHMARK(DegreeProductNodeParallel)->Apply(MakeNodeArguments);
+BENCHMARK(DegreeProductEdgeParallel)->Apply(MakeStrideArguments);
+BENCHMARK(TriangleCountEdgeBag)->Apply(MakeNodeArguments);
+BENCHMARK(TriangleCountEdgeIndexed)->Apply(MakeNodeArguments);
+BENCHMARK(TriangleCountEdgeIteration)->Apply(MakeNodeArguments);
+BENCHMARK(ConnectedComponentsEdgeTiledAsynchronous)
+    ->Apply(MakeTileArguments);
+BENCHMARK(ConnectedComponentsEdgeTiledAfforest)->Apply(MakeTileArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,190 @@
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/Bag.h"
+#include "katana/BitsetKernels.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Frontier.h"
+#include "katana/Loops.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Node = katana::Frontier::Node;
+
+/// Benchmarks of the kernels take the SimdLevel as their last argument. The
+/// Frontier benchmarks use GetSimdLevel(), so compare them across levels by
+/// setting KATANA_SIMD_LEVEL.
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 20, 1 << 24}) {
+    // One in active_divisor nodes is active
+    for (long active_divisor : {2, 32, 1024}) {
+      b->Args({num_nodes, active_divisor});
+    }
+  }
+}
+
+void
+MakeKernelArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 20, 1 << 24}) {
+    for (long active_divisor : {2, 32, 1024}) {
+      for (auto level :
+           {katana::SimdLevel::kScalar, katana::SimdLevel::kAVX2,
+            katana::SimdLevel::kAVX512}) {
+        b->Args({num_nodes, active_divisor, static_cast<long>(level)});
+      }
+    }
+  }
+}
+
+katana::DynamicBitset
+MakeBitset(const benchmark::State& state) {
+  katana::DynamicBitset bitset;
+  bitset.resize(state.range(0));
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<Node> dist(0, state.range(1) - 1);
+  for (Node n = 0; n < bitset.size(); ++n) {
+    if (dist(gen) == 0) {
+      bitset.set(n);
+    }
+  }
+  return bitset;
+}
+
+/// \returns the level to benchmark, or nothing if this CPU does not have it
+std::optional<katana::SimdLevel>
+GetLevel(benchmark::State& state) {
+  auto level = static_cast<katana::SimdLevel>(state.range(2));
+  if (level > katana::GetSimdLevel()) {
+    state.SkipWithError("level not supported");
+    return std::nullopt;
+  }
+  state.SetLabel(katana::SimdLevelName(level));
+  return level;
+}
+
+void
+CountSetBits(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  auto level = GetLevel(state);
+  if (!level) {
+    return;
+  }
+  size_t num_words = bitset.get_vec().size();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        katana::CountSetBits(bitset.words(), num_words, *level));
+  }
+  state.SetBytesProcessed(state.iterations() * num_words * sizeof(uint64_t));
+}
+
+void
+ExpandSetBits(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  auto level = GetLevel(state);
+  if (!level) {
+    return;
+  }
+  size_t num_words = bitset.get_vec().size();
+  std::vector<uint32_t> indexes(bitset.count());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(katana::ExpandSetBits(
+        bitset.words(), num_words, 0, indexes.data(), *level));
+  }
+  state.SetItemsProcessed(state.iterations() * indexes.size());
+}
+
+/// Convert the way algorithms did before Frontier: test every node to fill a
+/// bag and set a bit for every item of the bag
+void
+ScanRoundTrip(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  size_t num_active = bitset.count();
+  katana::InsertBag<Node> bag;
+
+  for (auto _ : state) {
+    bag.clear();
+    katana::do_all(
+        katana::iterate(Node{0}, static_cast<Node>(bitset.size())),
+        [&](Node n) {
+          if (bitset.test(n)) {
+            bag.push(n);
+          }
+        },
+        katana::no_stats());
+    bitset.reset();
+    katana::do_all(
+        katana::iterate(bag), [&](Node n) { bitset.set(n); },
+        katana::no_stats());
+  }
+  state.SetItemsProcessed(state.iterations() * num_active);
+}
+
+void
+FrontierRoundTrip(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  katana::Frontier frontier(bitset.size());
+  frontier.ToDense();
+  bitset.ForEachSetBit([&](Node n) { frontier.Push(n); });
+
+  for (auto _ : state) {
+    frontier.ToSparse();
+    frontier.ToDense();
+  }
+  state.SetItemsProcessed(state.iterations() * frontier.size());
+}
+
+/// Visit every active node with the frontier kept dense or sparse
+template <bool Dense>
+void
+FrontierForEach(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  katana::Frontier frontier(bitset.size());
+  if (Dense) {
+    frontier.ToDense();
+  }
+  bitset.ForEachSetBit([&](Node n) { frontier.Push(n); });
+
+  katana::GAccumulator<uint64_t> sum;
+  for (auto _ : state) {
+    frontier.ForEach([&](Node n) { sum += n; });
+  }
+  benchmark::DoNotOptimize(sum.reduce());
+  state.SetItemsProcessed(state.iterations() * frontier.size());
+}
+
+void
+FrontierCompact(benchmark::State& state) {
+  katana::DynamicBitset bitset = MakeBitset(state);
+  katana::Frontier frontier(bitset.size());
+  frontier.ToDense();
+  bitset.ForEachSetBit([&](Node n) { frontier.Push(n); });
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(frontier.Compact());
+  }
+  state.SetItemsProcessed(state.iterations() * frontier.size());
+}
+
+BENCHMARK(CountSetBits)->Apply(MakeKernelArguments);
+BENCHMARK(ExpandSetBits)->Apply(MakeKernelArguments);
+BENCHMARK(ScanRoundTrip)->Apply(MakeArguments);
+BENCHMARK(FrontierRoundTrip)->Apply(MakeArguments);
+BENCHMARK_TEMPLATE(FrontierForEach, true)->Apply(MakeArguments);
+BENCHMARK_TEMPLATE(FrontierForEach, false)->Apply(MakeArguments);
+BENCHMARK(FrontierCompact)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
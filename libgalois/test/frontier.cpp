@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include "katana/BitsetKernels.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Frontier.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+
+namespace {
+
+/// Words with a mix of empty, full, sparse and random bits
+std::vector<uint64_t>
+MakeWords(size_t num_words, uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<uint64_t> words(num_words);
+  for (uint64_t& w : words) {
+    switch (gen() % 4) {
+    case 0:
+      w = 0;
+      break;
+    case 1:
+      w = ~uint64_t{0};
+      break;
+    case 2:
+      w = gen() & gen() & gen();
+      break;
+    default:
+      w = gen();
+    }
+  }
+  return words;
+}
+
+/// Every level this CPU supports gives the same answer as the scalar one
+void
+TestKernels() {
+  std::vector<katana::SimdLevel> levels;
+  for (katana::SimdLevel level :
+       {katana::SimdLevel::kScalar, katana::SimdLevel::kAVX2,
+        katana::SimdLevel::kAVX512}) {
+    if (level <= katana::GetSimdLevel()) {
+      levels.emplace_back(level);
+    }
+  }
+
+  for (size_t num_words = 0; num_words < 70; ++num_words) {
+    std::vector<uint64_t> words = MakeWords(num_words, num_words);
+    uint32_t first_index = num_words * 1000;
+
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < num_words * 64; ++i) {
+      if (words[i / 64] & (uint64_t{1} << (i % 64))) {
+        expected.emplace_back(first_index + i);
+      }
+    }
+
+    for (katana::SimdLevel level : levels) {
+      uint64_t count = katana::CountSetBits(words.data(), num_words, level);
+      KATANA_LOG_VASSERT(
+          count == expected.size(), "{}: {} != {}",
+          katana::SimdLevelName(level), count, expected.size());
+
+      // One sentinel past the end checks that nothing is written there
+      constexpr uint32_t kSentinel = 0xdeadbeef;
+      std::vector<uint32_t> indexes(expected.size() + 1, kSentinel);
+      size_t num_indexes = katana::ExpandSetBits(
+          words.data(), num_words, first_index, indexes.data(), level);
+      KATANA_LOG_ASSERT(num_indexes == expected.size());
+      KATANA_LOG_ASSERT(indexes.back() == kSentinel);
+      indexes.pop_back();
+      KATANA_LOG_VASSERT(
+          indexes == expected, "{}", katana::SimdLevelName(level));
+    }
+  }
+}
+
+/// Bits past the size of the bitset, as left by bitwise_not, are ignored
+void
+TestDynamicBitset() {
+  constexpr size_t kNumBits = 100003;
+  katana::DynamicBitset bitset;
+  bitset.resize(kNumBits);
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < kNumBits; i += 7) {
+    bitset.set(i);
+    expected.emplace_back(i);
+  }
+
+  KATANA_LOG_ASSERT(bitset.count() == expected.size());
+  KATANA_LOG_ASSERT(bitset.GetOffsets<uint32_t>() == expected);
+  std::vector<uint64_t> wide = bitset.GetOffsets<uint64_t>();
+  KATANA_LOG_ASSERT(std::equal(
+      wide.begin(), wide.end(), expected.begin(), expected.end()));
+
+  std::vector<uint64_t> appended{42};
+  bitset.AppendOffsets(&appended);
+  KATANA_LOG_ASSERT(appended.size() == expected.size() + 1);
+  KATANA_LOG_ASSERT(appended.front() == 42);
+  KATANA_LOG_ASSERT(appended.back() == expected.back());
+
+  std::vector<uint32_t> visited(kNumBits);
+  bitset.ForEachSetBit([&](uint32_t i) { visited[i] += 1; });
+  for (uint32_t i = 0; i < kNumBits; ++i) {
+    KATANA_LOG_ASSERT(visited[i] == (i % 7 == 0 ? 1 : 0));
+  }
+
+  bitset.bitwise_not();
+  size_t num_unset = kNumBits - expected.size();
+  KATANA_LOG_ASSERT(bitset.count() == num_unset);
+  KATANA_LOG_ASSERT(bitset.GetOffsets<uint32_t>().size() == num_unset);
+  std::atomic<size_t> num_visited{0};
+  bitset.ForEachSetBit([&](uint32_t) { num_visited += 1; });
+  KATANA_LOG_ASSERT(num_visited == num_unset);
+}
+
+std::vector<uint32_t>
+Sorted(std::vector<uint32_t> nodes) {
+  std::sort(nodes.begin(), nodes.end());
+  return nodes;
+}
+
+/// The frontier holds the same nodes whatever its representation
+void
+TestFrontier() {
+  constexpr size_t kNumNodes = 10000;
+  katana::Frontier frontier(kNumNodes);
+  KATANA_LOG_ASSERT(frontier.empty() && !frontier.is_dense());
+
+  std::vector<uint32_t> expected;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, uint32_t{100}),
+      [&](uint32_t i) { frontier.Push(i * 3); });
+  for (uint32_t i = 0; i < 100; ++i) {
+    expected.emplace_back(i * 3);
+  }
+  KATANA_LOG_ASSERT(frontier.size() == 100);
+  frontier.Adapt();
+  KATANA_LOG_ASSERT(!frontier.is_dense());
+  KATANA_LOG_ASSERT(Sorted(frontier.Compact()) == expected);
+
+  // Duplicates are dropped on the way to dense
+  frontier.Push(3);
+  KATANA_LOG_ASSERT(frontier.size() == 101);
+  frontier.ToDense();
+  KATANA_LOG_ASSERT(frontier.is_dense() && frontier.size() == 100);
+  KATANA_LOG_ASSERT(frontier.Contains(3) && !frontier.Contains(4));
+  frontier.Push(3);
+  KATANA_LOG_ASSERT(frontier.size() == 100);
+  KATANA_LOG_ASSERT(frontier.Compact() == expected);
+
+  frontier.ToSparse();
+  KATANA_LOG_ASSERT(!frontier.is_dense() && frontier.size() == 100);
+  KATANA_LOG_ASSERT(Sorted(frontier.Compact()) == expected);
+
+  // Large frontiers become dense
+  katana::do_all(
+      katana::iterate(uint32_t{0}, uint32_t{kNumNodes}),
+      [&](uint32_t i) { frontier.Push(i); });
+  frontier.Adapt();
+  KATANA_LOG_ASSERT(frontier.is_dense() && frontier.size() == kNumNodes);
+
+  frontier.Clear();
+  KATANA_LOG_ASSERT(frontier.empty() && frontier.is_dense());
+  KATANA_LOG_ASSERT(frontier.Compact().empty());
+
+  frontier.Fill();
+  KATANA_LOG_ASSERT(frontier.size() == kNumNodes);
+  std::vector<uint32_t> visited(kNumNodes);
+  frontier.ForEach([&](uint32_t n) { visited[n] += 1; });
+  KATANA_LOG_ASSERT(std::all_of(
+      visited.begin(), visited.end(), [](uint32_t v) { return v == 1; }));
+
+  katana::Frontier other(kNumNodes);
+  other.Push(7);
+  frontier.swap(other);
+  KATANA_LOG_ASSERT(!frontier.is_dense() && frontier.size() == 1);
+  KATANA_LOG_ASSERT(other.is_dense() && other.size() == kNumNodes);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::setActiveThreads(4);
+
+  TestKernels();
+  TestDynamicBitset();
+  TestFrontier();
+
+  return 0;
+}
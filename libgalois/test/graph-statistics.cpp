@@ -0,0 +1,202 @@
+#include <cmath>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/GraphStatistics.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+using Edge = katana::GraphTopology::Edge;
+using Node = katana::GraphTopology::Node;
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+constexpr Node kNumNodes = 11;
+
+/// A path 0 -> 1 -> 2 -> 3 -> 4, a triangle 5 -> 6 -> 7 -> 5, a self loop on
+/// 8 and a pair 9 <-> 10, with node property "value" equal to the node
+/// modulo 3, except for nulls on 4 and 8
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  builder.AddEdge(0, 1);
+  builder.AddEdge(1, 2);
+  builder.AddEdge(2, 3);
+  builder.AddEdge(3, 4);
+  builder.AddEdge(5, 6);
+  builder.AddEdge(6, 7);
+  builder.AddEdge(7, 5);
+  builder.AddEdge(8, 8);
+  builder.AddEdge(9, 10);
+  builder.AddEdge(10, 9);
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+
+  arrow::Int64Builder values;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    if (n == 4 || n == 8) {
+      KATANA_LOG_ASSERT(values.AppendNull().ok());
+    } else {
+      KATANA_LOG_ASSERT(values.Append(n % 3).ok());
+    }
+  }
+  std::shared_ptr<arrow::Array> array = values.Finish().ValueOrDie();
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::int64())}), {array});
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(table));
+  return pg;
+}
+
+void
+CheckStatistics(const katana::GraphStatistics& stats) {
+  KATANA_LOG_ASSERT(stats.num_nodes == kNumNodes);
+  KATANA_LOG_ASSERT(stats.num_edges == 10);
+  KATANA_LOG_ASSERT(stats.num_self_loops == 1);
+
+  KATANA_LOG_ASSERT(stats.out_degrees.num_nodes == kNumNodes);
+  KATANA_LOG_ASSERT(stats.out_degrees.max == 1);
+  KATANA_LOG_ASSERT(
+      (stats.out_degrees.log2_histogram == std::vector<uint64_t>{1, 10}));
+  KATANA_LOG_ASSERT(
+      (stats.in_degrees.log2_histogram == std::vector<uint64_t>{1, 10}));
+
+  KATANA_LOG_ASSERT(stats.node_types.size() == 1);
+  KATANA_LOG_ASSERT(stats.node_types[0].count == kNumNodes);
+  KATANA_LOG_ASSERT(stats.edge_types.size() == 1);
+  KATANA_LOG_ASSERT(stats.edge_types[0].count == 10);
+
+  KATANA_LOG_ASSERT(stats.node_properties.size() == 1);
+  const katana::PropertyStatistics& value = stats.node_properties[0];
+  KATANA_LOG_ASSERT(value.name == "value");
+  KATANA_LOG_ASSERT(value.length == kNumNodes);
+  KATANA_LOG_ASSERT(value.null_count == 2);
+  KATANA_LOG_ASSERT(value.distinct_count == 3);
+
+  // The path is the longest shortest path
+  KATANA_LOG_ASSERT(stats.estimated_diameter == 4);
+  // Only the nodes of the triangle have a coefficient, of 1
+  KATANA_LOG_ASSERT(stats.clustering_samples == kNumNodes);
+  KATANA_LOG_ASSERT(
+      std::abs(stats.clustering_coefficient - 3.0 / kNumNodes) < 1e-9);
+
+  KATANA_LOG_ASSERT(stats.components.num_components == 4);
+  KATANA_LOG_ASSERT(
+      (stats.components.largest == std::vector<uint64_t>{5, 3, 2, 1}));
+  KATANA_LOG_ASSERT(
+      (stats.components.log2_histogram == std::vector<uint64_t>{0, 1, 2, 1}));
+}
+
+void
+TestCompute() {
+  auto pg = MakeGraph();
+  auto stats = katana::ComputeGraphStatistics(pg.get()).value();
+  CheckStatistics(stats);
+
+  // Samples are repeatable
+  katana::GraphStatisticsOptions opts;
+  opts.num_clustering_samples = 4;
+  opts.seed = 7;
+  auto first = katana::ComputeGraphStatistics(pg.get(), opts).value();
+  auto second = katana::ComputeGraphStatistics(pg.get(), opts).value();
+  KATANA_LOG_ASSERT(first.clustering_samples == 4);
+  KATANA_LOG_ASSERT(
+      first.clustering_coefficient == second.clustering_coefficient);
+}
+
+/// Statistics are written with the graph and read back without computing
+/// them again
+void
+TestPersist() {
+  auto pg = MakeGraph();
+  KATANA_LOG_ASSERT(
+      katana::LoadGraphStatistics(pg.get()).error() ==
+      katana::ErrorCode::NotFound);
+  auto stats = katana::ComputeGraphStatistics(pg.get()).value();
+  katana::StoreGraphStatistics(pg.get(), stats);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/graphstatistics");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+  auto write_result = pg->Write(rdg_dir, "graph-statistics");
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto make_result =
+      katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+
+  auto loaded = katana::LoadGraphStatistics(make_result.value().get());
+  KATANA_LOG_ASSERT(loaded);
+  CheckStatistics(loaded.value());
+  KATANA_LOG_ASSERT(nlohmann::json(loaded.value()) == nlohmann::json(stats));
+}
+
+/// Saved statistics are not returned once the graph has changed
+void
+TestInvalidate() {
+  auto pg = MakeGraph();
+  auto stats = katana::ComputeGraphStatistics(pg.get()).value();
+  katana::StoreGraphStatistics(pg.get(), stats);
+  KATANA_LOG_ASSERT(katana::LoadGraphStatistics(pg.get()));
+
+  // Removing a property
+  KATANA_LOG_ASSERT(pg->RemoveNodeProperty("value"));
+  KATANA_LOG_ASSERT(
+      katana::LoadGraphStatistics(pg.get()).error() ==
+      katana::ErrorCode::NotFound);
+
+  // Adding a property
+  katana::StoreGraphStatistics(pg.get(), stats);
+  KATANA_LOG_ASSERT(katana::LoadGraphStatistics(pg.get()));
+  arrow::Int64Builder values;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(values.Append(n).ok());
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("other", arrow::int64())}),
+      {values.Finish().ValueOrDie()});
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(table));
+  KATANA_LOG_ASSERT(
+      katana::LoadGraphStatistics(pg.get()).error() ==
+      katana::ErrorCode::NotFound);
+
+  // Moving an edge to another destination keeps all counts the same
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  builder.AddEdge(0, 1);
+  auto first = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+  katana::AsymmetricGraphTopologyBuilder moved;
+  moved.AddNodes(kNumNodes);
+  moved.AddEdge(0, 2);
+  auto second = katana::PropertyGraph::Make(moved.ConvertToCSR()).value();
+  KATANA_LOG_ASSERT(
+      katana::ComputeGraphFingerprint(first.get()) !=
+      katana::ComputeGraphFingerprint(second.get()));
+  KATANA_LOG_ASSERT(
+      katana::ComputeGraphFingerprint(first.get()) ==
+      katana::ComputeGraphFingerprint(first.get()));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestCompute();
+  TestPersist();
+  TestInvalidate();
+
+  return 0;
+}
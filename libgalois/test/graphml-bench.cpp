@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <libxml/xmlreader.h>
+
+#include "katana/GraphML.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/URI.h"
+
+namespace {
+
+constexpr size_t kNumNodes = 1 << 17;
+constexpr size_t kEdgesPerNode = 4;
+
+/// The file written by main; every benchmark converts it
+std::string graphml_file;
+size_t graphml_bytes;
+
+/// Write a GraphML file, as exported by neo4j, with a few typed properties
+/// on every node and edge
+void
+WriteGraphML(const std::string& filename) {
+  std::ofstream out(filename);
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+      << "<key id=\"name\" for=\"node\" attr.name=\"name\"/>\n"
+      << "<key id=\"born\" for=\"node\" attr.name=\"born\" "
+      << "attr.type=\"long\"/>\n"
+      << "<key id=\"weight\" for=\"edge\" attr.name=\"weight\" "
+      << "attr.type=\"double\"/>\n"
+      << "<graph id=\"G\" edgedefault=\"directed\">\n";
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    out << "<node id=\"n" << n << "\" labels=\":Person\">"
+        << "<data key=\"labels\">:Person</data>"
+        << "<data key=\"name\">person " << n << "</data>"
+        << "<data key=\"born\">" << 1900 + n % 100 << "</data></node>\n";
+  }
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    for (size_t i = 1; i <= kEdgesPerNode; ++i) {
+      out << "<edge source=\"n" << n << "\" target=\"n"
+          << (n * 7 + i * 13) % kNumNodes << "\" label=\"KNOWS\">"
+          << "<data key=\"label\">KNOWS</data>"
+          << "<data key=\"weight\">" << i * 0.25 << "</data></edge>\n";
+    }
+  }
+  out << "</graph>\n</graphml>\n";
+}
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_threads : {1, 2, 4, 8, 16, 32}) {
+    b->Args({num_threads});
+  }
+}
+
+/// Convert in pieces parsed in parallel by the given number of threads, or
+/// as many as this machine has. The pieces are merged into the Arrow tables
+/// serially, so MB/s levels off once the parsing is no longer the bulk of
+/// the time.
+void
+ConvertParallel(benchmark::State& state) {
+  state.counters["Threads"] = katana::setActiveThreads(state.range(0));
+  for (auto _ : state) {
+    auto res = katana::ConvertGraphML(graphml_file);
+    KATANA_LOG_ASSERT(res);
+    benchmark::DoNotOptimize(res.value());
+  }
+  state.SetBytesProcessed(state.iterations() * graphml_bytes);
+}
+
+/// Convert the whole document with one xml text reader, as before parallel
+/// parsing
+void
+ConvertSerial(benchmark::State& state) {
+  for (auto _ : state) {
+    xmlTextReaderPtr reader = xmlNewTextReaderFilename(graphml_file.c_str());
+    KATANA_LOG_ASSERT(reader != NULL);
+    auto res = katana::ConvertGraphML(reader);
+    xmlFreeTextReader(reader);
+    KATANA_LOG_ASSERT(res);
+    benchmark::DoNotOptimize(res.value());
+  }
+  state.SetBytesProcessed(state.iterations() * graphml_bytes);
+}
+
+BENCHMARK(ConvertSerial)->Unit(benchmark::kMillisecond);
+BENCHMARK(ConvertParallel)
+    ->Apply(MakeArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/graphml-bench");
+  KATANA_LOG_ASSERT(uri_res);
+  graphml_file = uri_res.value().path() + ".graphml";  // path() because local
+  WriteGraphML(graphml_file);
+  graphml_bytes = std::ifstream(graphml_file, std::ios::ate).tellg();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  std::remove(graphml_file.c_str());
+}
@@ -0,0 +1,88 @@
+#include <cstring>
+
+#include <arrow/buffer.h>
+
+#include "katana/HugePageMemoryPool.h"
+#include "katana/Logging.h"
+#include "katana/MemoryAccounting.h"
+#include "katana/NUMAArray.h"
+#include "katana/PageAlloc.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+/// Buffers keep their contents when they move between the default pool and
+/// the page allocator
+void
+TestReallocate() {
+  auto* pool = katana::HugePageMemoryPool::Get();
+  int64_t large = katana::allocSize();
+  int64_t large_before = pool->large_bytes_allocated();
+
+  auto buffer = arrow::AllocateResizableBuffer(100, pool).ValueOrDie();
+  std::memset(buffer->mutable_data(), 7, 100);
+  KATANA_LOG_ASSERT(pool->large_bytes_allocated() == large_before);
+
+  KATANA_LOG_ASSERT(buffer->Resize(3 * large).ok());
+  KATANA_LOG_ASSERT(pool->large_bytes_allocated() >= large_before + large);
+  for (int i = 0; i < 100; ++i) {
+    KATANA_LOG_ASSERT(buffer->data()[i] == 7);
+  }
+  std::memset(buffer->mutable_data(), 9, 3 * large);
+
+  KATANA_LOG_ASSERT(buffer->Resize(100, true).ok());
+  KATANA_LOG_ASSERT(pool->large_bytes_allocated() == large_before);
+  for (int i = 0; i < 100; ++i) {
+    KATANA_LOG_ASSERT(buffer->data()[i] == 9);
+  }
+}
+
+/// SharedMemSys backs the tagged pools with huge pages
+void
+TestTaggedPool() {
+  auto category = katana::MemoryCategory::kProperties;
+  auto* huge_pages = katana::HugePageMemoryPool::Get();
+  arrow::MemoryPool* pool = katana::GetArrowMemoryPool(category);
+  KATANA_LOG_ASSERT(pool->backend_name() == huge_pages->backend_name());
+
+  uint64_t used = katana::GetMemoryUsed(category);
+  int64_t large_before = huge_pages->large_bytes_allocated();
+  {
+    auto buffer =
+        arrow::AllocateBuffer(2 * katana::allocSize(), pool).ValueOrDie();
+    KATANA_LOG_ASSERT(
+        katana::GetMemoryUsed(category) >= used + 2 * katana::allocSize());
+    KATANA_LOG_ASSERT(huge_pages->large_bytes_allocated() > large_before);
+  }
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used);
+}
+
+/// NUMAArrays count against the category of the scope they are allocated in
+void
+TestNUMAArray() {
+  auto category = katana::MemoryCategory::kTopology;
+  uint64_t used = katana::GetMemoryUsed(category);
+  {
+    katana::NUMAArray<uint64_t> array;
+    {
+      katana::MemoryCategoryScope scope(category);
+      array.allocateInterleaved(1 << 20);
+    }
+    KATANA_LOG_ASSERT(
+        katana::GetMemoryUsed(category) >= used + (1 << 20) * sizeof(uint64_t));
+  }
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestReallocate();
+  TestTaggedPool();
+  TestNUMAArray();
+
+  return 0;
+}
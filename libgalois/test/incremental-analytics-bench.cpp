@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyGraphDelta.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+namespace {
+
+using Node = katana::PropertyGraph::Node;
+
+using UpdateFn = std::function<void(
+    katana::PropertyGraph*, const std::vector<Node>&,
+    const std::vector<Node>&)>;
+using InitFn = std::function<void(katana::PropertyGraph*)>;
+
+constexpr uint64_t kEdgesPerNode = 8;
+/// The part of the stream, in percent, that is in the graph before replay.
+constexpr uint64_t kBasePercent = 90;
+
+const std::string kOutputProperty = "output";
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 14, 1 << 18}) {
+    for (long batch_size : {16, 1024}) {
+      b->Args({num_nodes, batch_size});
+    }
+  }
+}
+
+struct TimestampedEdge {
+  uint64_t timestamp;
+  Node src;
+  Node dest;
+};
+
+/// A synthetic stream of edges between random nodes, ordered by time.
+std::vector<TimestampedEdge>
+MakeEdgeStream(uint64_t num_nodes, uint64_t num_edges) {
+  std::mt19937_64 generator(0);
+  std::uniform_int_distribution<Node> node(0, num_nodes - 1);
+  std::uniform_int_distribution<uint64_t> timestamp;
+  std::vector<TimestampedEdge> stream(num_edges);
+  for (auto& edge : stream) {
+    edge = TimestampedEdge{
+        timestamp(generator), node(generator), node(generator)};
+  }
+  std::sort(
+      stream.begin(), stream.end(),
+      [](const TimestampedEdge& a, const TimestampedEdge& b) {
+        return a.timestamp < b.timestamp;
+      });
+  return stream;
+}
+
+void
+AppendEdges(
+    std::vector<TimestampedEdge>::const_iterator begin,
+    std::vector<TimestampedEdge>::const_iterator end, bool symmetric,
+    std::vector<Node>* srcs, std::vector<Node>* dests) {
+  srcs->clear();
+  dests->clear();
+  for (auto it = begin; it != end; ++it) {
+    srcs->emplace_back(it->src);
+    dests->emplace_back(it->dest);
+    if (symmetric) {
+      srcs->emplace_back(it->dest);
+      dests->emplace_back(it->src);
+    }
+  }
+}
+
+/// Return the graph with the edges of pg plus srcs[i] -> dests[i], keeping
+/// the properties of pg.
+std::unique_ptr<katana::PropertyGraph>
+AddEdges(
+    katana::PropertyGraph* pg, const std::vector<Node>& srcs,
+    const std::vector<Node>& dests) {
+  katana::PropertyGraphDelta delta(pg);
+  KATANA_LOG_ASSERT(delta.AddEdges(srcs, dests));
+  return delta.Compact().value();
+}
+
+/// Build a graph from the first kBasePercent of a stream, then replay the
+/// rest in batches of state.range(1) edges. Only update, which is called
+/// after each batch is added to the graph, is timed.
+void
+ReplayStream(
+    benchmark::State& state, bool symmetric, const InitFn& init,
+    const UpdateFn& update) {
+  uint64_t num_nodes = state.range(0);
+  uint64_t batch_size = state.range(1);
+  auto stream = MakeEdgeStream(num_nodes, num_nodes * kEdgesPerNode);
+  auto base_end = stream.cbegin() + stream.size() * kBasePercent / 100;
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+  auto empty = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+
+  std::vector<Node> srcs;
+  std::vector<Node> dests;
+  for (auto _ : state) {
+    state.PauseTiming();
+    AppendEdges(stream.cbegin(), base_end, symmetric, &srcs, &dests);
+    auto pg = AddEdges(empty.get(), srcs, dests);
+    init(pg.get());
+
+    for (auto begin = base_end; begin != stream.cend();) {
+      auto end = begin + std::min<uint64_t>(batch_size, stream.cend() - begin);
+      AppendEdges(begin, end, symmetric, &srcs, &dests);
+      pg = AddEdges(pg.get(), srcs, dests);
+      begin = end;
+
+      state.ResumeTiming();
+      update(pg.get(), srcs, dests);
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * (stream.cend() - base_end));
+}
+
+void
+ComputeComponents(katana::PropertyGraph* pg) {
+  KATANA_LOG_ASSERT(
+      katana::analytics::ConnectedComponents(pg, kOutputProperty));
+}
+
+void
+ComputePagerank(katana::PropertyGraph* pg) {
+  KATANA_LOG_ASSERT(katana::analytics::Pagerank(pg, kOutputProperty));
+}
+
+void
+ConnectedComponentsIncremental(benchmark::State& state) {
+  ReplayStream(
+      state, true, ComputeComponents,
+      [](katana::PropertyGraph* pg, const std::vector<Node>& srcs,
+         const std::vector<Node>& dests) {
+        KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsIncremental(
+            pg, kOutputProperty, srcs, dests));
+        KATANA_LOG_DEBUG_ASSERT(
+            katana::analytics::ConnectedComponentsAssertValid(
+                pg, kOutputProperty));
+      });
+}
+
+void
+ConnectedComponentsRecompute(benchmark::State& state) {
+  ReplayStream(
+      state, true, ComputeComponents,
+      [](katana::PropertyGraph* pg, const std::vector<Node>&,
+         const std::vector<Node>&) {
+        KATANA_LOG_ASSERT(pg->RemoveNodeProperty(kOutputProperty));
+        ComputeComponents(pg);
+      });
+}
+
+void
+PagerankIncremental(benchmark::State& state) {
+  ReplayStream(
+      state, false, ComputePagerank,
+      [](katana::PropertyGraph* pg, const std::vector<Node>& srcs,
+         const std::vector<Node>& dests) {
+        KATANA_LOG_ASSERT(katana::analytics::PagerankIncremental(
+            pg, kOutputProperty, srcs, dests));
+      });
+}
+
+void
+PagerankRecompute(benchmark::State& state) {
+  ReplayStream(
+      state, false, ComputePagerank,
+      [](katana::PropertyGraph* pg, const std::vector<Node>&,
+         const std::vector<Node>&) {
+        KATANA_LOG_ASSERT(pg->RemoveNodeProperty(kOutputProperty));
+        ComputePagerank(pg);
+      });
+}
+
+BENCHMARK(ConnectedComponentsIncremental)->Apply(MakeArguments);
+BENCHMARK(ConnectedComponentsRecompute)->Apply(MakeArguments);
+BENCHMARK(PagerankIncremental)->Apply(MakeArguments);
+BENCHMARK(PagerankRecompute)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
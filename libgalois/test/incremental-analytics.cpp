@@ -0,0 +1,223 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyGraphDelta.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+namespace {
+
+using Node = katana::PropertyGraph::Node;
+
+constexpr Node kNumNodes = 64;
+constexpr size_t kNumRandomBatches = 8;
+constexpr size_t kRandomBatchSize = 16;
+constexpr float kTolerance = 1.0e-5;
+
+const std::string kComponents = "components";
+const std::string kRanks = "ranks";
+const std::string kExpected = "expected";
+
+/// A batch of undirected edges and the number of nodes added before them
+struct Batch {
+  uint64_t num_new_nodes;
+  std::vector<std::pair<Node, Node>> edges;
+};
+
+template <typename ArrayType>
+std::vector<typename ArrayType::value_type>
+Values(katana::PropertyGraph* pg, const std::string& name) {
+  auto column = pg->GetNodeProperty(name).value();
+  KATANA_LOG_ASSERT(column->null_count() == 0);
+  std::vector<typename ArrayType::value_type> values;
+  for (const auto& chunk : column->chunks()) {
+    auto array = std::static_pointer_cast<ArrayType>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i) {
+      values.emplace_back(array->Value(i));
+    }
+  }
+  return values;
+}
+
+/// Nodes 0-7 are a path, 8-15 a ring, 16-23 a star around 16 and 24-31 a
+/// path; the other nodes have no edges
+std::unique_ptr<katana::PropertyGraph>
+MakeBaseGraph() {
+  katana::SymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (Node n = 0; n < 7; ++n) {
+    builder.AddEdge(n, n + 1);
+    builder.AddEdge(24 + n, 24 + n + 1);
+  }
+  for (Node n = 0; n < 8; ++n) {
+    builder.AddEdge(8 + n, 8 + (n + 1) % 8);
+  }
+  for (Node n = 17; n < 24; ++n) {
+    builder.AddEdge(16, n);
+  }
+  return katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+}
+
+/// Add the edges of batch in both directions, returning them in
+/// srcs[i] -> dests[i]
+std::unique_ptr<katana::PropertyGraph>
+AddBatch(
+    katana::PropertyGraph* pg, const Batch& batch, std::vector<Node>* srcs,
+    std::vector<Node>* dests) {
+  srcs->clear();
+  dests->clear();
+  for (const auto& [a, b] : batch.edges) {
+    srcs->emplace_back(a);
+    dests->emplace_back(b);
+    srcs->emplace_back(b);
+    dests->emplace_back(a);
+  }
+
+  katana::PropertyGraphDelta delta(pg);
+  if (batch.num_new_nodes > 0) {
+    KATANA_LOG_ASSERT(delta.AddNodes(batch.num_new_nodes));
+  }
+  KATANA_LOG_ASSERT(delta.AddEdges(*srcs, *dests));
+  return delta.Compact().value();
+}
+
+/// The components must be the same partition of the nodes as the ones of a
+/// fresh computation; only the labels may differ
+void
+CheckComponents(katana::PropertyGraph* pg) {
+  KATANA_LOG_ASSERT(
+      katana::analytics::ConnectedComponentsAssertValid(pg, kComponents));
+
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponents(pg, kExpected));
+  auto actual = Values<arrow::UInt64Array>(pg, kComponents);
+  auto expected = Values<arrow::UInt64Array>(pg, kExpected);
+  KATANA_LOG_ASSERT(pg->RemoveNodeProperty(kExpected));
+
+  std::unordered_map<uint64_t, uint64_t> expected_of_actual;
+  std::unordered_map<uint64_t, uint64_t> actual_of_expected;
+  for (Node n = 0; n < pg->num_nodes(); ++n) {
+    auto a = expected_of_actual.emplace(actual[n], expected[n]).first;
+    auto e = actual_of_expected.emplace(expected[n], actual[n]).first;
+    KATANA_LOG_VASSERT(
+        a->second == expected[n] && e->second == actual[n],
+        "node {} is in component {}, expected {}", n, actual[n], expected[n]);
+  }
+}
+
+/// The ranks must be those of a fresh computation up to the error allowed
+/// by the tolerance. Every residual left below the tolerance moves at most
+/// tolerance / (1 - alpha) of rank in total, and each incremental update
+/// may leave one more such residual per node, so the sum of the absolute
+/// differences is bounded by (num_updates + 2) * num_nodes of those.
+void
+CheckRanks(
+    katana::PropertyGraph* pg, katana::analytics::PagerankPlan plan,
+    size_t num_updates) {
+  KATANA_LOG_ASSERT(katana::analytics::Pagerank(pg, kExpected, plan));
+  auto actual = Values<arrow::FloatArray>(pg, kRanks);
+  auto expected = Values<arrow::FloatArray>(pg, kExpected);
+  KATANA_LOG_ASSERT(pg->RemoveNodeProperty(kExpected));
+
+  double error = 0;
+  for (Node n = 0; n < pg->num_nodes(); ++n) {
+    error += std::fabs(actual[n] - expected[n]);
+  }
+  double bound = (num_updates + 2) * pg->num_nodes() * plan.tolerance() /
+                 (1 - plan.alpha());
+  KATANA_LOG_VASSERT(
+      error <= bound, "ranks differ by {} in total, more than {}", error,
+      bound);
+}
+
+std::vector<Batch>
+MakeBatches() {
+  std::vector<Batch> batches{
+      // Edges inside components, from a node without edges, and between
+      // two nodes without edges
+      {0, {{0, 2}, {8, 12}, {40, 3}, {41, 42}}},
+      // Merge the path and the ring, and the star with the other path
+      // through a node without edges
+      {0, {{7, 8}, {23, 43}, {43, 24}}},
+      // Node 16 gains edges, which lowers the rank its old neighbor 17 gets
+      // from it, while 17 also gains an edge from 44, which raises it. The
+      // negative residual is the larger one, so the residual of 17 crosses
+      // zero when the positive one arrives first, and ends far below minus
+      // the tolerance either way: it must be pushed for its magnitude.
+      {0, {{16, 45}, {16, 46}, {16, 47}, {44, 17}, {44, 45}}},
+      // New nodes: one joins a component, two join each other and the last
+      // one has no edges
+      {4, {{kNumNodes, 5}, {kNumNodes + 1, kNumNodes + 2}}},
+  };
+
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<Node> node(0, kNumNodes - 1);
+  for (size_t i = 0; i < kNumRandomBatches; ++i) {
+    Batch& batch = batches.emplace_back();
+    batch.num_new_nodes = 0;
+    while (batch.edges.size() < kRandomBatchSize) {
+      Node a = node(generator);
+      Node b = node(generator);
+      if (a != b) {
+        batch.edges.emplace_back(a, b);
+      }
+    }
+  }
+  return batches;
+}
+
+void
+TestIncremental() {
+  auto plan = katana::analytics::PagerankPlan::PushAsynchronous(kTolerance);
+
+  auto pg = MakeBaseGraph();
+  KATANA_LOG_ASSERT(
+      katana::analytics::ConnectedComponents(pg.get(), kComponents));
+  KATANA_LOG_ASSERT(katana::analytics::Pagerank(pg.get(), kRanks, plan));
+
+  std::vector<Node> srcs;
+  std::vector<Node> dests;
+  size_t num_updates = 0;
+  for (const Batch& batch : MakeBatches()) {
+    pg = AddBatch(pg.get(), batch, &srcs, &dests);
+
+    KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsIncremental(
+        pg.get(), kComponents, srcs, dests));
+    CheckComponents(pg.get());
+
+    KATANA_LOG_ASSERT(katana::analytics::PagerankIncremental(
+        pg.get(), kRanks, srcs, dests, plan));
+    CheckRanks(pg.get(), plan, ++num_updates);
+  }
+}
+
+/// Edges that are not in the graph are rejected
+void
+TestMissingEdges() {
+  auto pg = MakeBaseGraph();
+  KATANA_LOG_ASSERT(katana::analytics::Pagerank(pg.get(), kRanks));
+  KATANA_LOG_ASSERT(
+      !katana::analytics::PagerankIncremental(pg.get(), kRanks, {40}, {41}));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestIncremental();
+  TestMissingEdges();
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+constexpr size_t kEdgesPerNode = 8;
+
+const std::vector<std::string> kSelected{"selected"};
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    // Percentage of the nodes in the projection
+    for (long percent_selected : {10, 50, 90, 100}) {
+      b->Args({num_nodes, percent_selected});
+    }
+  }
+}
+
+/// A random graph where percent_selected percent of the nodes have type
+/// "selected" and the others type "other"
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(benchmark::State& state) {
+  katana::GraphTopology topology =
+      katana::CreateUniformRandomTopology(state.range(0), kEdgesPerNode);
+
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID selected =
+      node_types.AddAtomicEntityType("selected").value();
+  katana::EntityTypeID other = node_types.AddAtomicEntityType("other").value();
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(topology.num_nodes());
+  Node percent_selected = state.range(1);
+  katana::do_all(
+      katana::iterate(topology.all_nodes()),
+      [&](Node n) {
+        node_type_ids[n] = n % 100 < percent_selected ? selected : other;
+      },
+      katana::no_stats());
+
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(topology.num_edges());
+  katana::ParallelSTL::fill(
+      edge_type_ids.begin(), edge_type_ids.end(), katana::kUnknownEntityType);
+
+  return katana::PropertyGraph::Make(
+             std::move(topology), std::move(node_type_ids),
+             std::move(edge_type_ids), std::move(node_types),
+             katana::EntityTypeManager{})
+      .value();
+}
+
+template <typename Topo>
+uint64_t
+SumOfDests(const Topo& topo) {
+  katana::GAccumulator<uint64_t> sum;
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](Node n) {
+        for (Edge e : topo.edges(n)) {
+          sum += topo.edge_dest(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return sum.reduce();
+}
+
+void
+BuildMaterialized(benchmark::State& state) {
+  auto pg = MakeGraph(state);
+
+  for (auto _ : state) {
+    auto topo = katana::ProjectedTopology::MakeTypeProjectedTopology(
+        pg.get(), kSelected, {});
+    benchmark::DoNotOptimize(topo);
+  }
+  state.SetItemsProcessed(state.iterations() * pg->num_edges());
+}
+
+void
+BuildLazy(benchmark::State& state) {
+  auto pg = MakeGraph(state);
+
+  for (auto _ : state) {
+    auto topo = katana::LazyProjectedTopology::MakeTypeProjectedTopology(
+        pg.get(), kSelected, {});
+    benchmark::DoNotOptimize(topo);
+  }
+  state.SetItemsProcessed(state.iterations() * pg->num_edges());
+}
+
+void
+TraverseMaterialized(benchmark::State& state) {
+  auto pg = MakeGraph(state);
+  auto topo = katana::ProjectedTopology::MakeTypeProjectedTopology(
+      pg.get(), kSelected, {});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfDests(*topo));
+  }
+  state.SetItemsProcessed(state.iterations() * topo->num_edges());
+}
+
+void
+TraverseLazy(benchmark::State& state) {
+  auto pg = MakeGraph(state);
+  auto topo = katana::LazyProjectedTopology::MakeTypeProjectedTopology(
+      pg.get(), kSelected, {});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfDests(*topo));
+  }
+  state.SetItemsProcessed(state.iterations() * topo->num_projected_edges());
+}
+
+BENCHMARK(BuildMaterialized)->Apply(MakeArguments);
+BENCHMARK(BuildLazy)->Apply(MakeArguments);
+BENCHMARK(TraverseMaterialized)->Apply(MakeArguments);
+BENCHMARK(TraverseLazy)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,149 @@
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+namespace {
+
+using LazyView = katana::PropertyGraphViews::LazyProjectedGraph;
+using ProjectedView = katana::PropertyGraphViews::ProjectedGraph;
+
+constexpr size_t kNumNodes = 1000;
+constexpr size_t kEdgesPerNode = 5;
+
+/// A random graph where one in ten nodes has type "A" and the others type
+/// "B", and even edges have type "x" and odd edges type "y".
+std::unique_ptr<katana::PropertyGraph>
+MakeTypedGraph() {
+  katana::GraphTopology topology =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID a = node_types.AddAtomicEntityType("A").value();
+  katana::EntityTypeID b = node_types.AddAtomicEntityType("B").value();
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(topology.num_nodes());
+  for (Node n = 0; n < topology.num_nodes(); ++n) {
+    node_type_ids[n] = n % 10 == 0 ? a : b;
+  }
+
+  katana::EntityTypeManager edge_types;
+  katana::EntityTypeID x = edge_types.AddAtomicEntityType("x").value();
+  katana::EntityTypeID y = edge_types.AddAtomicEntityType("y").value();
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(topology.num_edges());
+  for (Edge e = 0; e < topology.num_edges(); ++e) {
+    edge_type_ids[e] = e % 2 == 0 ? x : y;
+  }
+
+  return katana::PropertyGraph::Make(
+             std::move(topology), std::move(node_type_ids),
+             std::move(edge_type_ids), std::move(node_types),
+             std::move(edge_types))
+      .value();
+}
+
+/// The original IDs of the projected edges of the original node n
+std::set<Edge>
+ProjectedEdges(const LazyView& view, Node n) {
+  std::set<Edge> edges;
+  for (Edge e : view.edges(n)) {
+    KATANA_LOG_ASSERT(view.original_to_projected_edge_id(e) == e);
+    edges.insert(view.projected_to_original_edge_id(e));
+  }
+  return edges;
+}
+
+std::set<Edge>
+ProjectedEdges(const ProjectedView& view, Node n) {
+  std::set<Edge> edges;
+  Node projected = view.original_to_projected_node_id(n);
+  if (projected == view.property_graph().num_nodes()) {
+    return edges;
+  }
+  for (Edge e : view.edges(projected)) {
+    edges.insert(view.projected_to_original_edge_id(e));
+  }
+  return edges;
+}
+
+/// Check that the lazy projection has the same nodes and edges as the
+/// materialized one
+void
+TestMatchesMaterialized(
+    katana::PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types) {
+  auto lazy = pg->BuildView<LazyView>(node_types, edge_types);
+  auto projected = pg->BuildView<ProjectedView>(node_types, edge_types);
+
+  KATANA_LOG_ASSERT(lazy.num_nodes() == pg->num_nodes());
+  KATANA_LOG_ASSERT(lazy.num_edges() == pg->num_edges());
+  KATANA_LOG_ASSERT(lazy.num_projected_nodes() == projected.num_nodes());
+  KATANA_LOG_ASSERT(lazy.num_projected_edges() == projected.num_edges());
+
+  for (Node n = 0; n < pg->num_nodes(); ++n) {
+    auto edges = ProjectedEdges(lazy, n);
+    KATANA_LOG_ASSERT(edges == ProjectedEdges(projected, n));
+    KATANA_LOG_ASSERT(lazy.degree(n) == edges.size());
+    for (Edge e : edges) {
+      Node dest = lazy.edge_dest(e);
+      KATANA_LOG_ASSERT(lazy.original_to_projected_node_id(dest) == dest);
+    }
+  }
+}
+
+void
+TestWithProjectedView() {
+  auto pg = MakeTypedGraph();
+
+  // Most of the graph
+  bool lazy = pg->WithProjectedView({"A", "B"}, {}, [](const auto& view) {
+    return std::is_same_v<std::decay_t<decltype(view)>, LazyView>;
+  });
+  KATANA_LOG_ASSERT(lazy);
+
+  // A tenth of the nodes
+  lazy = pg->WithProjectedView({"A"}, {"x"}, [](const auto& view) {
+    return std::is_same_v<std::decay_t<decltype(view)>, LazyView>;
+  });
+  KATANA_LOG_ASSERT(!lazy);
+}
+
+void
+TestWithoutDegreeCache() {
+  auto pg = MakeTypedGraph();
+  auto cached = katana::LazyProjectedTopology::MakeTypeProjectedTopology(
+      pg.get(), {"B"}, {"y"}, true);
+  auto uncached = katana::LazyProjectedTopology::MakeTypeProjectedTopology(
+      pg.get(), {"B"}, {"y"}, false);
+
+  KATANA_LOG_ASSERT(uncached->num_bytes() < cached->num_bytes());
+  for (Node n = 0; n < pg->num_nodes(); ++n) {
+    KATANA_LOG_ASSERT(cached->degree(n) == uncached->degree(n));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  auto pg = MakeTypedGraph();
+  TestMatchesMaterialized(pg.get(), {}, {});
+  TestMatchesMaterialized(pg.get(), {"B"}, {});
+  TestMatchesMaterialized(pg.get(), {"A"}, {"x"});
+  TestMatchesMaterialized(pg.get(), {"A", "B"}, {"y"});
+  TestWithProjectedView();
+  TestWithoutDegreeCache();
+
+  return 0;
+}
@@ -19,7 +19,10 @@
 
 #include "katana/Mem.h"
 
+#include "katana/ErrorCode.h"
 #include "katana/Galois.h"
+#include "katana/MemoryAccounting.h"
+#include "katana/NUMAArray.h"
 #include "katana/gIO.h"
 
 using namespace katana;
@@ -31,6 +34,48 @@ struct element {
   element(int i) : val(i), next(0) {}
 };
 
+// The try allocations fail on the limits and allocate nothing; the others
+// are counted but go over them
+void
+testLimits() {
+  auto category = MemoryCategory::kOther;
+  uint64_t used = GetMemoryUsed(category);
+  SetMemoryLimit(category, used + allocSize());
+
+  NUMAArray<char> array;
+  auto res = array.tryAllocateInterleaved(2 * allocSize());
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == ErrorCode::OutOfMemory);
+  KATANA_LOG_ASSERT(array.size() == 0);
+  KATANA_LOG_ASSERT(GetMemoryUsed(category) == used);
+
+  KATANA_LOG_ASSERT(array.tryAllocateBlocked(allocSize()));
+  KATANA_LOG_ASSERT(array.size() == allocSize());
+  KATANA_LOG_ASSERT(GetMemoryUsed(category) == used + allocSize());
+  array.destroy();
+  array.deallocate();
+  KATANA_LOG_ASSERT(GetMemoryUsed(category) == used);
+
+  array.allocateInterleaved(2 * allocSize());
+  KATANA_LOG_ASSERT(GetMemoryUsed(category) == used + 2 * allocSize());
+  array.destroy();
+  array.deallocate();
+  SetMemoryLimit(category, kNoMemoryLimit);
+
+  auto worklists = MemoryCategory::kWorklists;
+  uint64_t pages = GetMemoryUsed(worklists);
+  SetMemoryLimit(worklists, pages);
+  // Enough pages that some are missing whatever the pool already holds
+  res = TryEnsurePreallocated(getActiveThreads() * 1024);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == ErrorCode::OutOfMemory);
+  KATANA_LOG_ASSERT(GetMemoryUsed(worklists) == pages);
+  // Pages the pool already holds do not count again
+  KATANA_LOG_ASSERT(TryEnsurePreallocated(0));
+  SetMemoryLimit(worklists, kNoMemoryLimit);
+  KATANA_LOG_ASSERT(TryEnsurePreallocated(getActiveThreads()));
+}
+
 int
 main() {
   katana::SharedMemSys Katana_runtime;
@@ -70,5 +115,7 @@ main() {
     KATANA_LOG_ASSERT(allocated);
   }
 
+  testLimits();
+
   return 0;
 }
@@ -0,0 +1,133 @@
+#include <atomic>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/GraphTopology.h"
+#include "katana/Loops.h"
+#include "katana/SharedMemSys.h"
+#include "katana/WorkList.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kEdgesPerNode = 8;
+constexpr float kMaxWeight = 1000;
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+struct Request {
+  Node node;
+  float dist;
+};
+
+struct RequestDistance {
+  float operator()(const Request& r) const { return r.dist; }
+};
+
+/// OBIM needs integer buckets of 2^shift distance units
+struct RequestBucket {
+  unsigned shift;
+  uint32_t operator()(const Request& r) const {
+    return static_cast<uint32_t>(r.dist) >> shift;
+  }
+};
+
+struct Graph {
+  katana::GraphTopology topo;
+  std::vector<float> weights;
+
+  explicit Graph(size_t num_nodes)
+      : topo(katana::CreateUniformRandomTopology(num_nodes, kEdgesPerNode)),
+        weights(topo.num_edges()) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> weight(0, kMaxWeight);
+    for (float& w : weights) {
+      w = weight(gen);
+    }
+  }
+};
+
+template <typename WL>
+void
+Sssp(const Graph& g, std::vector<std::atomic<float>>* dist, const WL& wl) {
+  for (auto& d : *dist) {
+    d.store(kInfinity, std::memory_order_relaxed);
+  }
+  (*dist)[0] = 0;
+
+  std::vector<Request> init{{0, 0}};
+  katana::for_each(
+      katana::iterate(init),
+      [&](const Request& r, auto& ctx) {
+        if ((*dist)[r.node] < r.dist) {
+          return;
+        }
+        for (auto e : g.topo.edges(r.node)) {
+          Node dest = g.topo.edge_dest(e);
+          float new_dist = r.dist + g.weights[e];
+          if (new_dist < katana::atomicMin((*dist)[dest], new_dist)) {
+            ctx.push(Request{dest, new_dist});
+          }
+        }
+      },
+      wl, katana::disable_conflict_detection(), katana::no_stats());
+}
+
+void
+MakeNodeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    b->Args({num_nodes});
+  }
+}
+
+void
+MakeDeltaArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 16, 1 << 20}) {
+    for (long shift : {0, 2, 4, 6, 8, 10}) {
+      b->Args({num_nodes, shift});
+    }
+  }
+}
+
+void
+MultiQueueSssp(benchmark::State& state) {
+  Graph g(state.range(0));
+  std::vector<std::atomic<float>> dist(g.topo.num_nodes());
+
+  for (auto _ : state) {
+    Sssp(g, &dist, katana::wl<katana::MultiQueue<RequestDistance>>());
+  }
+  state.SetItemsProcessed(state.iterations() * g.topo.num_edges());
+}
+
+void
+ObimSssp(benchmark::State& state) {
+  Graph g(state.range(0));
+  std::vector<std::atomic<float>> dist(g.topo.num_nodes());
+  using OBIM = katana::OrderedByIntegerMetric<
+      RequestBucket, katana::PerSocketChunkFIFO<64>>;
+
+  for (auto _ : state) {
+    Sssp(
+        g, &dist,
+        katana::wl<OBIM>(
+            RequestBucket{static_cast<unsigned>(state.range(1))}));
+  }
+  state.SetItemsProcessed(state.iterations() * g.topo.num_edges());
+}
+
+BENCHMARK(MultiQueueSssp)->Apply(MakeNodeArguments)->UseRealTime();
+BENCHMARK(ObimSssp)->Apply(MakeDeltaArguments)->UseRealTime();
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
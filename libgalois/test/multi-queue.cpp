@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/WorkList.h"
+
+namespace {
+
+constexpr uint32_t kNumNodes = 10000;
+constexpr uint32_t kEdgesPerNode = 8;
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+struct Identity {
+  double operator()(double d) const { return d; }
+};
+
+/// A single heap pops in exact priority order
+template <bool UseDescending>
+void
+TestSerialOrder() {
+  using WL = typename katana::MultiQueue<Identity>::template with_descending<
+      UseDescending>::type::template retype<double>::template rethread<false>;
+  WL wl;
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-100, 100);
+  std::vector<double> values(1000);
+  for (double& v : values) {
+    v = dist(gen);
+    wl.push(v);
+  }
+
+  std::sort(values.begin(), values.end());
+  if (UseDescending) {
+    std::reverse(values.begin(), values.end());
+  }
+  for (double v : values) {
+    std::optional<double> popped = wl.pop();
+    KATANA_LOG_ASSERT(popped && *popped == v);
+  }
+  KATANA_LOG_ASSERT(!wl.pop());
+}
+
+/// A random graph with real edge weights in CSR form
+struct Graph {
+  std::vector<uint32_t> edge_begins;
+  std::vector<uint32_t> dests;
+  std::vector<double> weights;
+
+  Graph() : edge_begins(kNumNodes + 1) {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> node(0, kNumNodes - 1);
+    std::uniform_real_distribution<double> weight(0, 1);
+    for (uint32_t n = 0; n < kNumNodes; ++n) {
+      edge_begins[n] = dests.size();
+      for (uint32_t k = 0; k < kEdgesPerNode; ++k) {
+        dests.emplace_back(node(gen));
+        weights.emplace_back(weight(gen));
+      }
+    }
+    edge_begins[kNumNodes] = dests.size();
+  }
+};
+
+std::vector<double>
+Dijkstra(const Graph& g, uint32_t source) {
+  std::vector<double> dist(kNumNodes, kInfinity);
+  using Item = std::pair<double, uint32_t>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  dist[source] = 0;
+  queue.emplace(0, source);
+  while (!queue.empty()) {
+    auto [d, n] = queue.top();
+    queue.pop();
+    if (d > dist[n]) {
+      continue;
+    }
+    for (uint32_t e = g.edge_begins[n]; e < g.edge_begins[n + 1]; ++e) {
+      if (d + g.weights[e] < dist[g.dests[e]]) {
+        dist[g.dests[e]] = d + g.weights[e];
+        queue.emplace(dist[g.dests[e]], g.dests[e]);
+      }
+    }
+  }
+  return dist;
+}
+
+struct Request {
+  uint32_t node;
+  double dist;
+};
+
+struct RequestDistance {
+  double operator()(const Request& r) const { return r.dist; }
+};
+
+/// SSSP with real weights gives the same distances as Dijkstra
+void
+TestSssp() {
+  Graph g;
+  std::vector<std::atomic<double>> dist(kNumNodes);
+  for (auto& d : dist) {
+    d = kInfinity;
+  }
+  dist[0] = 0;
+
+  std::vector<Request> init{{0, 0}};
+  katana::for_each(
+      katana::iterate(init),
+      [&](const Request& r, auto& ctx) {
+        if (dist[r.node] < r.dist) {
+          return;
+        }
+        for (uint32_t e = g.edge_begins[r.node]; e < g.edge_begins[r.node + 1];
+             ++e) {
+          double new_dist = r.dist + g.weights[e];
+          if (new_dist < katana::atomicMin(dist[g.dests[e]], new_dist)) {
+            ctx.push(Request{g.dests[e], new_dist});
+          }
+        }
+      },
+      katana::wl<katana::MultiQueue<RequestDistance>>(),
+      katana::disable_conflict_detection(), katana::no_stats());
+
+  std::vector<double> expected = Dijkstra(g, 0);
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(dist[n] == expected[n]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::setActiveThreads(4);
+
+  TestSerialOrder<false>();
+  TestSerialOrder<true>();
+  TestSssp();
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include <memory>
+#include <string>
+
+#include <arrow/api.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/partition/partition.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr Node kSide = 24;
+constexpr Node kNumNodes = kSide * kSide;
+constexpr int64_t kHeavyWeight = 50;
+
+const std::string kPartition = "partition";
+const std::string kWeight = "weight";
+
+/// A kSide x kSide grid with node property "weight": 1 for most nodes and
+/// kHeavyWeight for the nodes of the first row
+std::unique_ptr<katana::PropertyGraph>
+MakeGrid() {
+  katana::SymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (Node row = 0; row < kSide; ++row) {
+    for (Node col = 0; col < kSide; ++col) {
+      Node n = row * kSide + col;
+      if (col + 1 < kSide) {
+        builder.AddEdge(n, n + 1);
+      }
+      if (row + 1 < kSide) {
+        builder.AddEdge(n, n + kSide);
+      }
+    }
+  }
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+
+  arrow::Int64Builder weights;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(weights.Append(n < kSide ? kHeavyWeight : 1).ok());
+  }
+  std::shared_ptr<arrow::Array> array = weights.Finish().ValueOrDie();
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field(kWeight, arrow::int64())}), {array})));
+  return pg;
+}
+
+/// Every partitioning stays within the bound of its imbalance
+void
+TestBalance(const std::string& node_weight_property_name) {
+  auto pg = MakeGrid();
+  for (uint32_t num_partitions : {2U, 5U, 8U}) {
+    for (double imbalance : {0.0, 0.03, 0.3}) {
+      KATANA_LOG_ASSERT(katana::analytics::Partition(
+          pg.get(), num_partitions, imbalance, node_weight_property_name, "",
+          kPartition));
+      auto res = katana::analytics::PartitionAssertValid(
+          pg.get(), num_partitions, imbalance, node_weight_property_name,
+          kPartition);
+      KATANA_LOG_VASSERT(
+          res, "{} partitions, imbalance {}: {}", num_partitions, imbalance,
+          res.error());
+      KATANA_LOG_ASSERT(pg->RemoveNodeProperty(kPartition));
+    }
+  }
+}
+
+/// All nodes in one of four partitions have valid IDs but break the bound
+void
+TestOverweight() {
+  auto pg = MakeGrid();
+  arrow::UInt32Builder ids;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(ids.Append(0).ok());
+  }
+  std::shared_ptr<arrow::Array> array = ids.Finish().ValueOrDie();
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field(kPartition, arrow::uint32())}), {array})));
+
+  KATANA_LOG_ASSERT(
+      katana::analytics::PartitionAssertValid(pg.get(), 4, kPartition));
+  auto res = katana::analytics::PartitionAssertValid(
+      pg.get(), 4, 0.5, "", kPartition);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == katana::ErrorCode::AssertionFailed);
+
+  // A single partition holds everything within any bound
+  KATANA_LOG_ASSERT(katana::analytics::PartitionAssertValid(
+      pg.get(), 1, 0, kWeight, kPartition));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestBalance("");
+  TestBalance(kWeight);
+  TestOverweight();
+
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include <limits>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+namespace {
+
+using SortedView = katana::PropertyGraphViews::EdgesSortedByDestID;
+using BiDirView = katana::PropertyGraphViews::BiDirectional;
+using ProjectedView = katana::PropertyGraphViews::ProjectedGraph;
+
+constexpr size_t kNumNodes = 100;
+constexpr size_t kEdgesPerNode = 4;
+
+/// A random graph where even nodes have type "A" and odd nodes type "B",
+/// and even edges have type "x" and odd edges type "y".
+std::unique_ptr<katana::PropertyGraph>
+MakeTypedGraph() {
+  katana::GraphTopology topology =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID a = node_types.AddAtomicEntityType("A").value();
+  katana::EntityTypeID b = node_types.AddAtomicEntityType("B").value();
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(topology.num_nodes());
+  for (Node n = 0; n < topology.num_nodes(); ++n) {
+    node_type_ids[n] = n % 2 == 0 ? a : b;
+  }
+
+  katana::EntityTypeManager edge_types;
+  katana::EntityTypeID x = edge_types.AddAtomicEntityType("x").value();
+  katana::EntityTypeID y = edge_types.AddAtomicEntityType("y").value();
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(topology.num_edges());
+  for (Edge e = 0; e < topology.num_edges(); ++e) {
+    edge_type_ids[e] = e % 2 == 0 ? x : y;
+  }
+
+  return katana::PropertyGraph::Make(
+             std::move(topology), std::move(node_type_ids),
+             std::move(edge_type_ids), std::move(node_types),
+             std::move(edge_types))
+      .value();
+}
+
+void
+TestHitsAndMisses() {
+  auto pg = MakeTypedGraph();
+  katana::PGViewCache& cache = pg->view_cache();
+
+  pg->BuildView<SortedView>();
+  KATANA_LOG_ASSERT(cache.stats().misses == 1);
+  KATANA_LOG_ASSERT(cache.stats().hits == 0);
+  KATANA_LOG_ASSERT(cache.size() == 1);
+  KATANA_LOG_ASSERT(cache.num_bytes() > 0);
+
+  pg->BuildView<SortedView>();
+  KATANA_LOG_ASSERT(cache.stats().hits == 1);
+  KATANA_LOG_ASSERT(cache.size() == 1);
+
+  // The transposed topology is a different entry
+  pg->BuildView<BiDirView>();
+  KATANA_LOG_ASSERT(cache.stats().misses == 2);
+  KATANA_LOG_ASSERT(cache.size() == 2);
+
+  cache.Clear();
+  KATANA_LOG_ASSERT(cache.size() == 0);
+  KATANA_LOG_ASSERT(cache.num_bytes() == 0);
+}
+
+void
+TestProjectionKeys() {
+  auto pg = MakeTypedGraph();
+  katana::PGViewCache& cache = pg->view_cache();
+
+  auto a_view = pg->BuildView<ProjectedView>({"A"}, {});
+  KATANA_LOG_ASSERT(a_view.num_nodes() == kNumNodes / 2);
+
+  // Different types must not be served by the cached projection
+  auto b_x_view = pg->BuildView<ProjectedView>({"B"}, {"x"});
+  KATANA_LOG_ASSERT(b_x_view.num_nodes() == kNumNodes / 2);
+  for (Edge e : b_x_view.all_edges()) {
+    KATANA_LOG_ASSERT(b_x_view.edge_property_index(e) % 2 == 0);
+  }
+  KATANA_LOG_ASSERT(cache.stats().misses == 2);
+
+  // Order and duplicates do not matter
+  auto all_view = pg->BuildView<ProjectedView>({"A", "B"}, {});
+  auto all_view_again = pg->BuildView<ProjectedView>({"B", "A", "B"}, {});
+  KATANA_LOG_ASSERT(cache.stats().misses == 3);
+  KATANA_LOG_ASSERT(cache.stats().hits == 1);
+  KATANA_LOG_ASSERT(all_view.num_nodes() == kNumNodes);
+  KATANA_LOG_ASSERT(all_view_again.num_nodes() == kNumNodes);
+}
+
+void
+TestEviction() {
+  auto pg = MakeTypedGraph();
+  katana::PGViewCache& cache = pg->view_cache();
+
+  auto sorted_view = pg->BuildView<SortedView>();
+  size_t sorted_bytes = cache.num_bytes();
+
+  // Room for one topology only
+  cache.set_memory_budget(sorted_bytes);
+  auto bidir_view = pg->BuildView<BiDirView>();
+  KATANA_LOG_ASSERT(cache.size() == 1);
+  KATANA_LOG_ASSERT(cache.stats().evictions == 1);
+  KATANA_LOG_ASSERT(cache.num_bytes() <= cache.memory_budget());
+
+  // Evicted topologies stay valid while a view uses them
+  for (Node n = 0; n < kNumNodes; ++n) {
+    Node prev = 0;
+    for (Edge e : sorted_view.edges(n)) {
+      KATANA_LOG_ASSERT(sorted_view.edge_dest(e) >= prev);
+      prev = sorted_view.edge_dest(e);
+    }
+  }
+
+  // The evicted topology is built again
+  pg->BuildView<SortedView>();
+  KATANA_LOG_ASSERT(cache.stats().misses == 3);
+  KATANA_LOG_ASSERT(cache.stats().evictions == 2);
+
+  cache.set_memory_budget(0);
+  KATANA_LOG_ASSERT(cache.size() == 1);
+}
+
+void
+TestPersistThreshold() {
+  auto pg = MakeTypedGraph();
+  katana::PGViewCache& cache = pg->view_cache();
+
+  pg->BuildView<SortedView>();
+  pg->BuildView<ProjectedView>({"A"}, {"x"});
+  KATANA_LOG_ASSERT(cache.ToRDGTopology().value().size() == 1);
+
+  cache.set_persist_threshold_usec(std::numeric_limits<uint64_t>::max());
+  KATANA_LOG_ASSERT(cache.ToRDGTopology().value().empty());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestHitsAndMisses();
+  TestProjectionKeys();
+  TestEviction();
+  TestPersistThreshold();
+
+  return 0;
+}
@@ -0,0 +1,175 @@
+#include <arrow/api.h>
+
+#include "katana/GraphStatistics.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/plan_advisor/plan_advisor.h"
+
+namespace {
+
+using katana::analytics::AdvisePlans;
+using katana::analytics::BfsPlan;
+using katana::analytics::ConnectedComponentsPlan;
+using katana::analytics::GraphFeatures;
+using katana::analytics::PagerankPlan;
+using katana::analytics::PlanAdvice;
+using katana::analytics::PlanAdvisorOptions;
+using katana::analytics::SsspPlan;
+using katana::analytics::TriangleCountPlan;
+
+/// A long grid has a large diameter and no hubs
+void
+TestGrid() {
+  auto pg = katana::MakeGrid(100, 100, false);
+  PlanAdvice advice = AdvisePlans(pg.get()).value();
+
+  KATANA_LOG_ASSERT(advice.features.num_nodes == 10000);
+  KATANA_LOG_ASSERT(advice.features.max_degree == 4);
+  KATANA_LOG_ASSERT(advice.features.estimated_diameter >= 99);
+  KATANA_LOG_ASSERT(!advice.features.power_law);
+  KATANA_LOG_ASSERT(!advice.features.from_saved_statistics);
+
+  KATANA_LOG_ASSERT(advice.bfs.algorithm() == BfsPlan::kAsynchronousTile);
+  KATANA_LOG_ASSERT(
+      advice.connected_components.algorithm() ==
+      ConnectedComponentsPlan::kAfforest);
+  KATANA_LOG_ASSERT(
+      advice.pagerank.algorithm() == PagerankPlan::kPushAsynchronous);
+  KATANA_LOG_ASSERT(
+      advice.triangle_count.relabeling() == TriangleCountPlan::kNoRelabel);
+  KATANA_LOG_ASSERT(advice.rationale.size() == 5);
+}
+
+/// A clique has a diameter of 1 and weights choose the delta
+void
+TestClique() {
+  auto pg = katana::MakeClique(64);
+  arrow::UInt32Builder weights;
+  for (uint64_t e = 0; e < pg->num_edges(); ++e) {
+    KATANA_LOG_ASSERT(weights.Append(1024).ok());
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::uint32())}),
+      {weights.Finish().ValueOrDie()});
+  KATANA_LOG_ASSERT(pg->AddEdgeProperties(table));
+
+  PlanAdvisorOptions opts;
+  opts.edge_weight_property_name = "weight";
+  PlanAdvice advice = AdvisePlans(pg.get(), opts).value();
+
+  KATANA_LOG_ASSERT(advice.features.estimated_diameter == 1);
+  KATANA_LOG_ASSERT(advice.bfs.algorithm() == BfsPlan::kSynchronousDirectOpt);
+  KATANA_LOG_ASSERT(
+      advice.sssp.algorithm() == SsspPlan::kDeltaStepBarrier);
+  // 2 * 1024 / 63 is about 2^5
+  KATANA_LOG_VASSERT(
+      advice.sssp.delta() == 5, "delta is {}", advice.sssp.delta());
+
+  // Saved statistics take the place of the sweeps
+  katana::GraphStatistics stats;
+  stats.num_nodes = pg->num_nodes();
+  stats.num_edges = pg->num_edges();
+  stats.out_degrees.max = 63;
+  stats.estimated_diameter = 1000;
+  katana::StoreGraphStatistics(pg.get(), stats);
+  advice = AdvisePlans(pg.get()).value();
+  KATANA_LOG_ASSERT(advice.features.from_saved_statistics);
+  KATANA_LOG_ASSERT(advice.features.estimated_diameter == 1000);
+  KATANA_LOG_ASSERT(advice.bfs.algorithm() == BfsPlan::kAsynchronousTile);
+
+  PlanAdvisorOptions ignore_saved;
+  ignore_saved.use_saved_statistics = false;
+  advice = AdvisePlans(pg.get(), ignore_saved).value();
+  KATANA_LOG_ASSERT(!advice.features.from_saved_statistics);
+  KATANA_LOG_ASSERT(advice.features.estimated_diameter == 1);
+}
+
+/// On a path with edges pointing back to node 0, sweeps along out-edges
+/// stop at node 0 right away. The diameter is estimated over undirected
+/// edges whether or not statistics were saved.
+void
+TestDirectedDiameter() {
+  constexpr uint32_t kLength = 100;
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kLength);
+  for (uint32_t n = 1; n < kLength; ++n) {
+    builder.AddEdge(n, n - 1);
+  }
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+
+  auto computed = GraphFeatures::Compute(pg.get()).value();
+  KATANA_LOG_ASSERT(!computed.from_saved_statistics);
+  KATANA_LOG_VASSERT(
+      computed.estimated_diameter == kLength - 1, "diameter is {}",
+      computed.estimated_diameter);
+
+  katana::GraphStatisticsOptions opts;
+  opts.num_diameter_sweeps = 2;
+  katana::StoreGraphStatistics(
+      pg.get(), katana::ComputeGraphStatistics(pg.get(), opts).value());
+  auto saved = GraphFeatures::Compute(pg.get()).value();
+  KATANA_LOG_ASSERT(saved.from_saved_statistics);
+  KATANA_LOG_ASSERT(saved.estimated_diameter == computed.estimated_diameter);
+}
+
+/// The hub of a Ferris wheel is split across threads
+void
+TestHub() {
+  auto pg = katana::MakeFerrisWheel(5000);
+  PlanAdvice advice = AdvisePlans(pg.get()).value();
+  KATANA_LOG_ASSERT(advice.features.max_degree == 4999);
+  KATANA_LOG_ASSERT(
+      advice.connected_components.algorithm() ==
+      ConnectedComponentsPlan::kEdgeAfforest);
+  KATANA_LOG_ASSERT(advice.connected_components.edge_tile_size() > 0);
+}
+
+/// Trials run on a sample and leave the graph as it was
+void
+TestTrials() {
+  auto pg = katana::MakeGrid(40, 40, true);
+  std::vector<katana::GraphTopology::Node> first_dests;
+  for (auto e : pg->topology().edges(0)) {
+    first_dests.emplace_back(pg->topology().edge_dest(e));
+  }
+
+  PlanAdvisorOptions opts;
+  opts.run_trials = true;
+  opts.trial_nodes = 500;
+  PlanAdvice advice = AdvisePlans(pg.get(), opts).value();
+
+  KATANA_LOG_ASSERT(pg->GetNumNodeProperties() == 0);
+  std::vector<katana::GraphTopology::Node> dests;
+  for (auto e : pg->topology().edges(0)) {
+    dests.emplace_back(pg->topology().edge_dest(e));
+  }
+  KATANA_LOG_ASSERT(dests == first_dests);
+
+  for (const auto& line : advice.rationale) {
+    if (line.rfind("sssp", 0) == 0) {
+      // No weights to try SSSP with
+      KATANA_LOG_ASSERT(line.find("trials") == std::string::npos);
+    } else {
+      KATANA_LOG_VASSERT(
+          line.find("trials on 500 nodes") != std::string::npos, "{}", line);
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestGrid();
+  TestClique();
+  TestDirectedDiameter();
+  TestHub();
+  TestTrials();
+
+  return 0;
+}
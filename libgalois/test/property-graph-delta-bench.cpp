@@ -0,0 +1,162 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/Loops.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyGraphDelta.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+constexpr size_t kEdgesPerNode = 8;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 14, 1 << 20}) {
+    // Percentage of the edges of the base graph that are updated.
+    for (long percent_updated : {1, 10}) {
+      b->Args({num_nodes, percent_updated});
+    }
+  }
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeBaseGraph(benchmark::State& state) {
+  return katana::PropertyGraph::Make(katana::CreateUniformRandomTopology(
+                                         state.range(0), kEdgesPerNode))
+      .value();
+}
+
+void
+RandomEdges(
+    uint64_t num_nodes, uint64_t count, std::vector<Node>* srcs,
+    std::vector<Node>* dests) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<Node> node(0, num_nodes - 1);
+  srcs->resize(count);
+  dests->resize(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    (*srcs)[i] = node(generator);
+    (*dests)[i] = node(generator);
+  }
+}
+
+/// Apply an update to delta of percent_updated percent of the edges of the
+/// base graph, half insertions and half deletions.
+void
+ApplyUpdates(
+    katana::PropertyGraphDelta* delta, const katana::PropertyGraph& pg,
+    long percent_updated) {
+  uint64_t count = pg.num_edges() * percent_updated / 100 / 2;
+  std::vector<Node> srcs;
+  std::vector<Node> dests;
+  RandomEdges(pg.num_nodes(), count, &srcs, &dests);
+  KATANA_LOG_ASSERT(delta->AddEdges(srcs, dests));
+
+  std::vector<Edge> removed;
+  uint64_t stride = pg.num_edges() / std::max<uint64_t>(count, 1);
+  for (Edge e = 0; e < pg.num_edges() && removed.size() < count; e += stride) {
+    removed.emplace_back(e);
+  }
+  KATANA_LOG_ASSERT(delta->RemoveEdges(removed));
+}
+
+template <typename Graph>
+uint64_t
+SumOfDests(const Graph& graph) {
+  katana::GAccumulator<uint64_t> sum;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, uint64_t{graph.num_nodes()}),
+      [&](uint64_t n) {
+        for (Edge e : graph.edges(n)) {
+          sum += graph.edge_dest(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return sum.reduce();
+}
+
+void
+InsertEdges(benchmark::State& state) {
+  auto pg = MakeBaseGraph(state);
+  uint64_t count = pg->num_edges() * state.range(1) / 100;
+  std::vector<Node> srcs;
+  std::vector<Node> dests;
+  RandomEdges(pg->num_nodes(), count, &srcs, &dests);
+
+  for (auto _ : state) {
+    katana::PropertyGraphDelta delta(pg.get());
+    KATANA_LOG_ASSERT(delta.AddEdges(srcs, dests));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+void
+RemoveEdges(benchmark::State& state) {
+  auto pg = MakeBaseGraph(state);
+  std::vector<Edge> removed;
+  for (Edge e = 0; e < pg->num_edges(); e += 100 / state.range(1)) {
+    removed.emplace_back(e);
+  }
+
+  for (auto _ : state) {
+    katana::PropertyGraphDelta delta(pg.get());
+    KATANA_LOG_ASSERT(delta.RemoveEdges(removed));
+  }
+  state.SetItemsProcessed(state.iterations() * removed.size());
+}
+
+void
+TraverseBaseline(benchmark::State& state) {
+  auto pg = MakeBaseGraph(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfDests(pg->topology()));
+  }
+  state.SetItemsProcessed(state.iterations() * pg->num_edges());
+}
+
+void
+TraverseDelta(benchmark::State& state) {
+  auto pg = MakeBaseGraph(state);
+  katana::PropertyGraphDelta delta(pg.get());
+  ApplyUpdates(&delta, *pg, state.range(1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SumOfDests(delta));
+  }
+  state.SetItemsProcessed(state.iterations() * delta.num_edges());
+}
+
+void
+Compact(benchmark::State& state) {
+  auto pg = MakeBaseGraph(state);
+  katana::PropertyGraphDelta delta(pg.get());
+  ApplyUpdates(&delta, *pg, state.range(1));
+
+  for (auto _ : state) {
+    auto compacted = delta.Compact();
+    KATANA_LOG_ASSERT(compacted);
+  }
+  state.SetItemsProcessed(state.iterations() * delta.num_edges());
+}
+
+BENCHMARK(InsertEdges)->Apply(MakeArguments);
+BENCHMARK(RemoveEdges)->Apply(MakeArguments);
+BENCHMARK(TraverseBaseline)->Apply(MakeArguments);
+BENCHMARK(TraverseDelta)->Apply(MakeArguments);
+BENCHMARK(Compact)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,241 @@
+#include <arrow/api.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyGraphDelta.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+namespace {
+
+std::shared_ptr<arrow::Table>
+MakeInt64Table(const std::string& name, const std::vector<int64_t>& values) {
+  arrow::Int64Builder builder;
+  KATANA_LOG_ASSERT(builder.AppendValues(values).ok());
+  std::shared_ptr<arrow::Array> array = builder.Finish().ValueOrDie();
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {array});
+}
+
+std::vector<Node>
+Dests(const katana::PropertyGraphDelta& delta, Node n) {
+  std::vector<Node> dests;
+  for (Edge e : delta.edges(n)) {
+    dests.emplace_back(delta.edge_dest(e));
+  }
+  return dests;
+}
+
+std::vector<Node>
+Dests(const katana::GraphTopology& topology, Node n) {
+  std::vector<Node> dests;
+  for (Edge e : topology.edges(n)) {
+    dests.emplace_back(topology.edge_dest(e));
+  }
+  return dests;
+}
+
+/// 0 -> 1, 0 -> 2, 1 -> 2, 2 -> 3, 3 -> 0, with node property "id" equal to
+/// ten times the node and edge property "weight" equal to ten times the edge.
+std::unique_ptr<katana::PropertyGraph>
+MakeBaseGraph() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(4);
+  builder.AddEdge(0, 1);
+  builder.AddEdge(0, 2);
+  builder.AddEdge(1, 2);
+  builder.AddEdge(2, 3);
+  builder.AddEdge(3, 0);
+
+  auto pg = katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+  KATANA_LOG_ASSERT(katana::AddNodeProperties(
+      pg.get(), katana::PropertyGenerator("id", [](Node n) {
+        return static_cast<int64_t>(n * 10);
+      })));
+  KATANA_LOG_ASSERT(katana::AddEdgeProperties(
+      pg.get(), katana::PropertyGenerator("weight", [](Edge e) {
+        return static_cast<int64_t>(e * 10);
+      })));
+  return pg;
+}
+
+void
+TestUpdates() {
+  auto pg = MakeBaseGraph();
+  katana::PropertyGraphDelta delta(pg.get());
+  KATANA_LOG_ASSERT(delta.empty());
+
+  Node added = delta.AddNodes(1, MakeInt64Table("id", {40})).value();
+  KATANA_LOG_ASSERT(added == 4);
+  KATANA_LOG_ASSERT(delta.num_nodes() == 5);
+
+  auto weights_table = MakeInt64Table("weight", {50, 60, 70});
+  Edge first = delta.AddEdges({3, 4, 0}, {4, 1, 3}, weights_table).value();
+  KATANA_LOG_ASSERT(first == 5);
+  KATANA_LOG_ASSERT(delta.num_edges() == 8);
+  KATANA_LOG_ASSERT((Dests(delta, 0) == std::vector<Node>{1, 2, 3}));
+  KATANA_LOG_ASSERT((Dests(delta, 4) == std::vector<Node>{1}));
+
+  KATANA_LOG_ASSERT(delta.RemoveEdges({1}));
+  // Removing twice has no further effect.
+  KATANA_LOG_ASSERT(delta.RemoveEdges({1}));
+  KATANA_LOG_ASSERT(delta.num_edges() == 7);
+  KATANA_LOG_ASSERT((Dests(delta, 0) == std::vector<Node>{1, 3}));
+
+  KATANA_LOG_ASSERT(delta.RemoveNodes({2}));
+  KATANA_LOG_ASSERT(delta.num_live_nodes() == 4);
+  KATANA_LOG_ASSERT(delta.num_edges() == 5);
+  KATANA_LOG_ASSERT(delta.degree(1) == 0);
+  KATANA_LOG_ASSERT(delta.degree(2) == 0);
+
+  // Invalid updates leave the delta unchanged.
+  KATANA_LOG_ASSERT(!delta.AddEdges({0}, {2}));
+  KATANA_LOG_ASSERT(!delta.AddEdges({0}, {5}));
+  KATANA_LOG_ASSERT(!delta.AddEdges({0}, {1}, MakeInt64Table("missing", {0})));
+  KATANA_LOG_ASSERT(!delta.RemoveEdges({8}));
+  KATANA_LOG_ASSERT(delta.num_edges() == 5);
+
+  // The base graph is untouched until compaction.
+  KATANA_LOG_ASSERT(pg->num_nodes() == 4);
+  KATANA_LOG_ASSERT(pg->num_edges() == 5);
+
+  // Old 0, 1, 3, 4 become 0, 1, 2, 3.
+  auto compacted = delta.Compact().value();
+  const katana::GraphTopology& topology = compacted->topology();
+  KATANA_LOG_ASSERT(topology.num_nodes() == 4);
+  KATANA_LOG_ASSERT(topology.num_edges() == 5);
+  KATANA_LOG_ASSERT((Dests(topology, 0) == std::vector<Node>{1, 2}));
+  KATANA_LOG_ASSERT((Dests(topology, 1) == std::vector<Node>{}));
+  KATANA_LOG_ASSERT((Dests(topology, 2) == std::vector<Node>{0, 3}));
+  KATANA_LOG_ASSERT((Dests(topology, 3) == std::vector<Node>{1}));
+
+  auto ids = std::static_pointer_cast<arrow::Int64Array>(
+      compacted->GetNodeProperty("id").value()->chunk(0));
+  std::vector<int64_t> expected_ids{0, 10, 30, 40};
+  for (Node n = 0; n < 4; ++n) {
+    KATANA_LOG_ASSERT(ids->Value(n) == expected_ids[n]);
+  }
+
+  auto weights = std::static_pointer_cast<arrow::Int64Array>(
+      compacted->GetEdgeProperty("weight").value()->chunk(0));
+  std::vector<int64_t> expected_weights{0, 70, 40, 50, 60};
+  for (Edge e = 0; e < 5; ++e) {
+    KATANA_LOG_ASSERT(weights->Value(e) == expected_weights[e]);
+  }
+}
+
+void
+TestMissingProperties() {
+  auto pg = MakeBaseGraph();
+  katana::PropertyGraphDelta delta(pg.get());
+
+  KATANA_LOG_ASSERT(delta.AddNodes(2));
+  KATANA_LOG_ASSERT(delta.AddEdges({4}, {5}));
+
+  auto compacted = delta.Compact().value();
+  KATANA_LOG_ASSERT(compacted->num_nodes() == 6);
+  KATANA_LOG_ASSERT(compacted->num_edges() == 6);
+
+  auto ids = compacted->GetNodeProperty("id").value()->chunk(0);
+  KATANA_LOG_ASSERT(ids->null_count() == 2);
+  KATANA_LOG_ASSERT(ids->IsNull(4) && ids->IsNull(5));
+  auto weights = compacted->GetEdgeProperty("weight").value()->chunk(0);
+  KATANA_LOG_ASSERT(weights->null_count() == 1);
+  KATANA_LOG_ASSERT(weights->IsNull(5));
+}
+
+/// Removing every node keeps the types and the property columns
+void
+TestRemoveAll() {
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID person =
+      node_types.AddAtomicEntityType("person").value();
+  katana::EntityTypeManager edge_types;
+  katana::EntityTypeID knows = edge_types.AddAtomicEntityType("knows").value();
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(2);
+  builder.AddEdge(0, 1);
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(2);
+  node_type_ids[0] = person;
+  node_type_ids[1] = person;
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(1);
+  edge_type_ids[0] = knows;
+  auto pg = katana::PropertyGraph::Make(
+                builder.ConvertToCSR(), std::move(node_type_ids),
+                std::move(edge_type_ids), std::move(node_types),
+                std::move(edge_types))
+                .value();
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(MakeInt64Table("id", {0, 10})));
+  KATANA_LOG_ASSERT(pg->AddEdgeProperties(MakeInt64Table("weight", {0})));
+
+  katana::PropertyGraphDelta delta(pg.get());
+  KATANA_LOG_ASSERT(delta.RemoveNodes({0, 1}));
+  KATANA_LOG_ASSERT(delta.num_live_nodes() == 0);
+
+  auto compacted = delta.Compact().value();
+  KATANA_LOG_ASSERT(compacted->num_nodes() == 0);
+  KATANA_LOG_ASSERT(compacted->num_edges() == 0);
+  KATANA_LOG_ASSERT(
+      compacted->GetNodeTypeManager().Equals(pg->GetNodeTypeManager()));
+  KATANA_LOG_ASSERT(
+      compacted->GetEdgeTypeManager().Equals(pg->GetEdgeTypeManager()));
+
+  auto ids = compacted->GetNodeProperty("id").value();
+  KATANA_LOG_ASSERT(ids->length() == 0);
+  KATANA_LOG_ASSERT(ids->type()->Equals(arrow::int64()));
+  auto weights = compacted->GetEdgeProperty("weight").value();
+  KATANA_LOG_ASSERT(weights->length() == 0);
+  KATANA_LOG_ASSERT(weights->type()->Equals(arrow::int64()));
+}
+
+void
+TestRandomBatches() {
+  constexpr size_t kNumNodes = 1000;
+  constexpr size_t kEdgesPerNode = 5;
+
+  auto pg = katana::PropertyGraph::Make(katana::CreateUniformRandomTopology(
+                                            kNumNodes, kEdgesPerNode))
+                .value();
+  katana::PropertyGraphDelta delta(pg.get());
+
+  std::vector<Node> srcs;
+  std::vector<Node> dests;
+  for (Node i = 0; i < kNumNodes; ++i) {
+    srcs.emplace_back((i * 7) % kNumNodes);
+    dests.emplace_back((i * 13) % kNumNodes);
+  }
+  KATANA_LOG_ASSERT(delta.AddEdges(srcs, dests));
+
+  std::vector<Edge> removed;
+  for (Edge e = 0; e < pg->num_edges(); e += 3) {
+    removed.emplace_back(e);
+  }
+  KATANA_LOG_ASSERT(delta.RemoveEdges(removed));
+
+  auto compacted = delta.Compact().value();
+  KATANA_LOG_ASSERT(compacted->num_edges() == delta.num_edges());
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(Dests(compacted->topology(), n) == Dests(delta, n));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestUpdates();
+  TestMissingProperties();
+  TestRemoveAll();
+  TestRandomBatches();
+
+  return 0;
+}
@@ -12,6 +12,40 @@ TestEdgeSource(const katana::GraphTopology& topo) noexcept {
   }
 }
 
+void
+TestEdgeSourceIndex(const katana::GraphTopology& topo) noexcept {
+  for (uint32_t stride : {1, 3, 8, 64}) {
+    auto index = katana::EdgeSourceIndex::Make(topo, stride);
+    KATANA_LOG_ASSERT(index->stride() == stride);
+    for (auto node : topo.all_nodes()) {
+      for (auto e : topo.edges(node)) {
+        KATANA_LOG_ASSERT(index->edge_source(e) == node);
+      }
+    }
+
+    KATANA_LOG_ASSERT(index->all_edges().size() == topo.num_edges());
+    for (auto e : index->all_edges()) {
+      KATANA_LOG_ASSERT(index->edge_dest(e) == topo.edge_dest(e));
+    }
+  }
+}
+
+/// A topology with runs of nodes without edges, which a strided index has
+/// to skip over
+katana::GraphTopology
+MakeSparseTopology() {
+  constexpr size_t kNumNodes = 500;
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (size_t n = 0; n < kNumNodes; n += 37) {
+    for (size_t i = 0; i < n % 11; ++i) {
+      builder.AddEdge(n, (n + i) % kNumNodes);
+    }
+  }
+  return builder.ConvertToCSR();
+}
+
 int
 main() {
   katana::SharedMemSys S;
@@ -23,6 +57,8 @@ main() {
       katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
 
   TestEdgeSource(topo);
+  TestEdgeSourceIndex(topo);
+  TestEdgeSourceIndex(MakeSparseTopology());
 
   return 0;
 }
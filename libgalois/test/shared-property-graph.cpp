@@ -0,0 +1,194 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <arrow/array.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/SharedPropertyGraph.h"
+#include "katana/TopologyGeneration.h"
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+namespace {
+
+constexpr size_t kNumNodes = 1000;
+constexpr size_t kEdgesPerNode = 5;
+constexpr size_t kStride = 7;
+constexpr int kNumChildren = 3;
+
+/// Node n has edges to n + k * kStride for k in [1, kEdgesPerNode]; one in
+/// ten nodes has type "A" and the others type "B"; nodes have an "id" and
+/// edges a "weight" property.
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    for (size_t k = 1; k <= kEdgesPerNode; ++k) {
+      builder.AddEdge(n, (n + k * kStride) % kNumNodes);
+    }
+  }
+  katana::GraphTopology topology = builder.ConvertToCSR();
+
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID a = node_types.AddAtomicEntityType("A").value();
+  katana::EntityTypeID b = node_types.AddAtomicEntityType("B").value();
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(topology.num_nodes());
+  for (Node n = 0; n < topology.num_nodes(); ++n) {
+    node_type_ids[n] = n % 10 == 0 ? a : b;
+  }
+
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(topology.num_edges());
+  for (Edge e = 0; e < topology.num_edges(); ++e) {
+    edge_type_ids[e] = katana::kUnknownEntityType;
+  }
+
+  auto pg = katana::PropertyGraph::Make(
+                std::move(topology), std::move(node_type_ids),
+                std::move(edge_type_ids), std::move(node_types),
+                katana::EntityTypeManager{})
+                .value();
+
+  KATANA_LOG_ASSERT(katana::AddNodeProperties(
+      pg.get(), katana::PropertyGenerator(
+                    "id", [](Node n) { return static_cast<int64_t>(n); })));
+  KATANA_LOG_ASSERT(katana::AddEdgeProperties(
+      pg.get(),
+      katana::PropertyGenerator("weight", [](Edge e) { return 0.5 * e; })));
+  return pg;
+}
+
+/// Check that pg is the graph MakeGraph makes
+void
+CheckGraph(const katana::PropertyGraph& pg) {
+  KATANA_LOG_ASSERT(pg.num_nodes() == kNumNodes);
+  KATANA_LOG_ASSERT(pg.num_edges() == kNumNodes * kEdgesPerNode);
+
+  katana::EntityTypeID a = pg.GetNodeEntityTypeID("A");
+  katana::EntityTypeID b = pg.GetNodeEntityTypeID("B");
+  KATANA_LOG_ASSERT(a != b);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(pg.GetTypeOfNode(n) == (n % 10 == 0 ? a : b));
+    KATANA_LOG_ASSERT(pg.edges(n).size() == kEdgesPerNode);
+    for (Edge e : pg.edges(n)) {
+      Node dest = pg.topology().edge_dest(e);
+      Node offset = (dest + kNumNodes - n) % kNumNodes;
+      KATANA_LOG_ASSERT(offset % kStride == 0);
+      KATANA_LOG_ASSERT(offset / kStride >= 1);
+      KATANA_LOG_ASSERT(offset / kStride <= kEdgesPerNode);
+    }
+  }
+
+  auto ids = std::static_pointer_cast<arrow::Int64Array>(
+      pg.GetNodeProperty("id").value()->chunk(0));
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(ids->Value(n) == static_cast<int64_t>(n));
+  }
+  auto weights = std::static_pointer_cast<arrow::DoubleArray>(
+      pg.GetEdgeProperty("weight").value()->chunk(0));
+  for (Edge e = 0; e < pg.num_edges(); ++e) {
+    KATANA_LOG_ASSERT(weights->Value(e) == 0.5 * e);
+  }
+}
+
+/// Attach, tell the parent, and hold the graph until the parent closes
+/// release_fd; returns the exit status of the child
+int
+RunChild(const std::string& name, int attached_fd, int release_fd) {
+  katana::SharedMemSys S;
+
+  auto shared = katana::SharedPropertyGraph::Attach(name);
+  if (!shared) {
+    KATANA_LOG_ERROR("Attach: {}", shared.error());
+    return 1;
+  }
+  KATANA_LOG_ASSERT(!shared.value()->is_publisher());
+  CheckGraph(*shared.value()->graph());
+
+  // Properties taken from the graph outlive it
+  auto ids = shared.value()->graph()->GetNodeProperty("id").value();
+
+  char c = 0;
+  KATANA_LOG_ASSERT(write(attached_fd, &c, 1) == 1);
+  KATANA_LOG_ASSERT(read(release_fd, &c, 1) == 0);
+
+  shared.value().reset();
+  KATANA_LOG_ASSERT(ids->length() == static_cast<int64_t>(kNumNodes));
+  return 0;
+}
+
+}  // namespace
+
+int
+main() {
+  std::string name =
+      "/katana-shared-property-graph-" + std::to_string(getpid());
+
+  // The parent writes a byte per child to ready_pipe once the graph is
+  // published, each child writes a byte to attached_pipe once attached, and
+  // closing release_pipe lets the children detach
+  int ready_pipe[2];
+  int attached_pipe[2];
+  int release_pipe[2];
+  KATANA_LOG_ASSERT(pipe(ready_pipe) == 0);
+  KATANA_LOG_ASSERT(pipe(attached_pipe) == 0);
+  KATANA_LOG_ASSERT(pipe(release_pipe) == 0);
+
+  // Fork before starting the thread pool, which does not survive fork
+  pid_t children[kNumChildren];
+  for (pid_t& child : children) {
+    child = fork();
+    KATANA_LOG_ASSERT(child >= 0);
+    if (child == 0) {
+      close(ready_pipe[1]);
+      close(attached_pipe[0]);
+      close(release_pipe[1]);
+      char c = 0;
+      KATANA_LOG_ASSERT(read(ready_pipe[0], &c, 1) == 1);
+      _exit(RunChild(name, attached_pipe[1], release_pipe[0]));
+    }
+  }
+  close(ready_pipe[0]);
+  close(attached_pipe[1]);
+  close(release_pipe[0]);
+
+  katana::SharedMemSys S;
+
+  auto pg = MakeGraph();
+  auto shared = katana::SharedPropertyGraph::Publish(*pg, name).value();
+  KATANA_LOG_ASSERT(shared->is_publisher());
+  KATANA_LOG_ASSERT(shared->num_attached() == 1);
+  CheckGraph(*shared->graph());
+
+  // The same name cannot be published twice
+  KATANA_LOG_ASSERT(!katana::SharedPropertyGraph::Publish(*pg, name));
+
+  char c[kNumChildren] = {};
+  KATANA_LOG_ASSERT(write(ready_pipe[1], c, kNumChildren) == kNumChildren);
+  for (int i = 0; i < kNumChildren; ++i) {
+    KATANA_LOG_ASSERT(read(attached_pipe[0], c, 1) == 1);
+  }
+  KATANA_LOG_ASSERT(shared->num_attached() == kNumChildren + 1);
+
+  close(release_pipe[1]);
+  for (pid_t child : children) {
+    int status = 0;
+    KATANA_LOG_ASSERT(waitpid(child, &status, 0) == child);
+    KATANA_LOG_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  KATANA_LOG_ASSERT(shared->num_attached() == 1);
+
+  // Once the publisher is gone, nothing can attach
+  shared.reset();
+  KATANA_LOG_ASSERT(!katana::SharedPropertyGraph::Attach(name));
+
+  return 0;
+}
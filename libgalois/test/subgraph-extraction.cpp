@@ -0,0 +1,236 @@
+#include <functional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/subgraph_extraction/subgraph_extraction.h"
+
+namespace {
+
+using Edge = katana::PropertyGraph::Edge;
+using Node = katana::PropertyGraph::Node;
+
+using katana::analytics::SubGraphExtraction;
+using katana::analytics::SubGraphExtractionByEdgePredicate;
+using katana::analytics::SubGraphExtractionByEntityTypes;
+
+std::shared_ptr<arrow::Table>
+MakeInt64Table(const std::string& name, const std::vector<int64_t>& values) {
+  arrow::Int64Builder builder;
+  KATANA_LOG_ASSERT(builder.AppendValues(values).ok());
+  std::shared_ptr<arrow::Array> array = builder.Finish().ValueOrDie();
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {array});
+}
+
+std::shared_ptr<arrow::Int64Array>
+Int64Values(const katana::Result<std::shared_ptr<arrow::ChunkedArray>>& res) {
+  KATANA_LOG_ASSERT(res);
+  KATANA_LOG_ASSERT(res.value()->num_chunks() == 1);
+  return std::static_pointer_cast<arrow::Int64Array>(res.value()->chunk(0));
+}
+
+/// People 0, 1 and 3 and cities 2 and 4. People know people and live in
+/// cities, and a road joins the cities. Node property "id" is 100 plus the
+/// node and edge property "weight" is 10 plus the edge.
+std::unique_ptr<katana::PropertyGraph>
+MakeTypedGraph() {
+  katana::EntityTypeManager node_types;
+  katana::EntityTypeID person =
+      node_types.AddAtomicEntityType("person").value();
+  katana::EntityTypeID city = node_types.AddAtomicEntityType("city").value();
+  // A type without nodes
+  KATANA_LOG_ASSERT(node_types.AddAtomicEntityType("country"));
+  katana::EntityTypeManager edge_types;
+  katana::EntityTypeID knows = edge_types.AddAtomicEntityType("knows").value();
+  katana::EntityTypeID lives = edge_types.AddAtomicEntityType("lives").value();
+  katana::EntityTypeID road = edge_types.AddAtomicEntityType("road").value();
+
+  const std::vector<katana::EntityTypeID> node_type_list{
+      person, person, city, person, city};
+  // Edges in CSR order
+  const std::vector<std::tuple<Node, Node, katana::EntityTypeID>> edge_list{
+      {0, 1, knows}, {0, 2, lives}, {1, 3, knows}, {1, 4, lives},
+      {2, 4, road},  {3, 0, knows}, {3, 4, lives}};
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(node_type_list.size());
+  for (const auto& [src, dest, type] : edge_list) {
+    builder.AddEdge(src, dest);
+  }
+
+  katana::PropertyGraph::EntityTypeIDArray node_type_ids;
+  node_type_ids.allocateInterleaved(node_type_list.size());
+  std::vector<int64_t> ids;
+  for (Node n = 0; n < node_type_list.size(); ++n) {
+    node_type_ids[n] = node_type_list[n];
+    ids.emplace_back(100 + n);
+  }
+  katana::PropertyGraph::EntityTypeIDArray edge_type_ids;
+  edge_type_ids.allocateInterleaved(edge_list.size());
+  std::vector<int64_t> weights;
+  for (Edge e = 0; e < edge_list.size(); ++e) {
+    edge_type_ids[e] = std::get<2>(edge_list[e]);
+    weights.emplace_back(10 + e);
+  }
+
+  auto pg = katana::PropertyGraph::Make(
+                builder.ConvertToCSR(), std::move(node_type_ids),
+                std::move(edge_type_ids), std::move(node_types),
+                std::move(edge_types))
+                .value();
+  KATANA_LOG_ASSERT(pg->AddNodeProperties(MakeInt64Table("id", ids)));
+  KATANA_LOG_ASSERT(pg->AddEdgeProperties(MakeInt64Table("weight", weights)));
+  return pg;
+}
+
+/// Check that sub is the sub-graph of pg on sub_to_original, node i of sub
+/// being node sub_to_original[i] of pg, with the edges accepted by keep_edge
+/// in their original order, and that types and properties were copied
+void
+CheckSubGraph(
+    const katana::PropertyGraph& pg, const katana::PropertyGraph& sub,
+    const std::vector<Node>& sub_to_original,
+    const std::function<bool(Edge)>& keep_edge) {
+  KATANA_LOG_ASSERT(sub.num_nodes() == sub_to_original.size());
+  KATANA_LOG_ASSERT(sub.GetNodeTypeManager().Equals(pg.GetNodeTypeManager()));
+  KATANA_LOG_ASSERT(sub.GetEdgeTypeManager().Equals(pg.GetEdgeTypeManager()));
+
+  std::unordered_map<Node, Node> original_to_sub;
+  for (Node n = 0; n < sub_to_original.size(); ++n) {
+    original_to_sub.emplace(sub_to_original[n], n);
+  }
+
+  auto ids = Int64Values(pg.GetNodeProperty("id"));
+  auto sub_ids = Int64Values(sub.GetNodeProperty("id"));
+  auto weights = Int64Values(pg.GetEdgeProperty("weight"));
+  auto sub_weights = Int64Values(sub.GetEdgeProperty("weight"));
+
+  uint64_t num_edges = 0;
+  for (Node n = 0; n < sub.num_nodes(); ++n) {
+    Node original = sub_to_original[n];
+    KATANA_LOG_VASSERT(
+        sub.GetTypeOfNode(n) == pg.GetTypeOfNode(original),
+        "type of node {}", n);
+    KATANA_LOG_VASSERT(
+        sub_ids->Value(n) == ids->Value(original), "id of node {}", n);
+
+    std::vector<Edge> expected;
+    for (Edge e : pg.topology().edges(original)) {
+      if (original_to_sub.count(pg.topology().edge_dest(e)) && keep_edge(e)) {
+        expected.emplace_back(e);
+      }
+    }
+    KATANA_LOG_VASSERT(
+        sub.topology().degree(n) == expected.size(), "degree of node {}", n);
+    size_t i = 0;
+    for (Edge e : sub.topology().edges(n)) {
+      Edge original_edge = expected[i++];
+      KATANA_LOG_ASSERT(
+          sub.topology().edge_dest(e) ==
+          original_to_sub.at(pg.topology().edge_dest(original_edge)));
+      KATANA_LOG_VASSERT(
+          sub.GetTypeOfEdge(e) == pg.GetTypeOfEdge(original_edge),
+          "type of edge {}", e);
+      KATANA_LOG_VASSERT(
+          sub_weights->Value(e) == weights->Value(original_edge),
+          "weight of edge {}", e);
+    }
+    num_edges += expected.size();
+  }
+  KATANA_LOG_ASSERT(sub.num_edges() == num_edges);
+}
+
+void
+CheckEmpty(const katana::Result<std::unique_ptr<katana::PropertyGraph>>& res) {
+  KATANA_LOG_ASSERT(res);
+  KATANA_LOG_ASSERT(res.value()->num_nodes() == 0);
+  KATANA_LOG_ASSERT(res.value()->num_edges() == 0);
+}
+
+void
+TestNodeSet() {
+  auto pg = MakeTypedGraph();
+
+  // Node order follows the first occurrence of each node
+  auto sub = SubGraphExtraction(pg.get(), {3, 0, 3, 1}, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {3, 0, 1}, [](Edge) { return true; });
+
+  CheckEmpty(SubGraphExtraction(pg.get(), {}, {"id"}, {"weight"}));
+}
+
+void
+TestEdgePredicate() {
+  auto pg = MakeTypedGraph();
+  katana::EntityTypeID knows = pg->GetEdgeEntityTypeID("knows");
+  auto is_knows = [&](Edge e) { return pg->DoesEdgeHaveType(e, knows); };
+
+  auto sub = SubGraphExtractionByEdgePredicate(
+      pg.get(), is_knows, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {0, 1, 3}, is_knows);
+
+  // The endpoints of the selected edges are kept, but the edge 3 -> 0
+  // between them is not
+  auto path = [](Edge e) { return e == 0 || e == 2; };
+  sub = SubGraphExtractionByEdgePredicate(pg.get(), path, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {0, 1, 3}, path);
+  KATANA_LOG_ASSERT(sub.value()->num_edges() == 2);
+
+  CheckEmpty(SubGraphExtractionByEdgePredicate(
+      pg.get(), [](Edge) { return false; }, {"id"}, {"weight"}));
+}
+
+void
+TestEntityTypes() {
+  auto pg = MakeTypedGraph();
+  katana::EntityTypeID road = pg->GetEdgeEntityTypeID("road");
+  katana::EntityTypeID knows = pg->GetEdgeEntityTypeID("knows");
+
+  auto sub = SubGraphExtractionByEntityTypes(
+      pg.get(), {"city"}, {"road"}, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {2, 4}, [&](Edge e) {
+    return pg->DoesEdgeHaveType(e, road);
+  });
+
+  // No edge types selects every edge between the selected nodes
+  sub = SubGraphExtractionByEntityTypes(
+      pg.get(), {"person"}, {}, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {0, 1, 3}, [](Edge) { return true; });
+
+  // No node types selects every node
+  sub = SubGraphExtractionByEntityTypes(
+      pg.get(), {}, {"knows", "road"}, {"id"}, {"weight"});
+  KATANA_LOG_ASSERT(sub);
+  CheckSubGraph(*pg, *sub.value(), {0, 1, 2, 3, 4}, [&](Edge e) {
+    return pg->DoesEdgeHaveType(e, knows) || pg->DoesEdgeHaveType(e, road);
+  });
+
+  CheckEmpty(SubGraphExtractionByEntityTypes(
+      pg.get(), {"country"}, {}, {"id"}, {"weight"}));
+  KATANA_LOG_ASSERT(!SubGraphExtractionByEntityTypes(pg.get(), {"planet"}, {}));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestNodeSet();
+  TestEdgePredicate();
+  TestEntityTypes();
+
+  return 0;
+}
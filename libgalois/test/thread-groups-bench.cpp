@@ -0,0 +1,135 @@
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/Loops.h"
+#include "katana/SharedMemSys.h"
+#include "katana/ThreadGroups.h"
+#include "katana/Threads.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 1 << 14;
+constexpr size_t kEdgesPerNode = 4;
+constexpr size_t kNumQueries = 64;
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+/// The state of one level synchronous BFS, shared by the threads that run it
+struct Bfs {
+  std::vector<std::atomic<uint32_t>> dist;
+  std::vector<Node> frontier;
+  std::vector<Node> next;
+  uint64_t frontier_size{0};
+  std::atomic<uint64_t> next_size{0};
+
+  Bfs(const katana::GraphTopology& topo, Node source)
+      : dist(topo.num_nodes()),
+        frontier(topo.num_nodes()),
+        next(topo.num_nodes()) {
+    for (auto& d : dist) {
+      d.store(kInfinity, std::memory_order_relaxed);
+    }
+    dist[source] = 0;
+    frontier[0] = source;
+    frontier_size = 1;
+  }
+
+  void Visit(const katana::GraphTopology& topo, Node n) {
+    uint32_t level = dist[n].load(std::memory_order_relaxed) + 1;
+    for (auto e : topo.edges(n)) {
+      Node dest = topo.edge_dest(e);
+      uint32_t old = kInfinity;
+      if (dist[dest].load(std::memory_order_relaxed) == kInfinity &&
+          dist[dest].compare_exchange_strong(old, level)) {
+        next[next_size.fetch_add(1)] = dest;
+      }
+    }
+  }
+
+  void NextLevel() {
+    std::swap(frontier, next);
+    frontier_size = next_size.exchange(0);
+  }
+};
+
+/// A BFS on the active threads, of the whole pool or of a thread group
+void
+BfsDoAll(const katana::GraphTopology& topo, Bfs* bfs) {
+  while (bfs->frontier_size > 0) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, bfs->frontier_size),
+        [&](uint64_t i) { bfs->Visit(topo, bfs->frontier[i]); },
+        katana::steal(), katana::no_stats());
+    bfs->NextLevel();
+  }
+}
+
+std::vector<std::unique_ptr<Bfs>>
+MakeQueries(const katana::GraphTopology& topo) {
+  std::vector<std::unique_ptr<Bfs>> queries;
+  for (size_t i = 0; i < kNumQueries; ++i) {
+    queries.emplace_back(
+        std::make_unique<Bfs>(topo, i * (kNumNodes / kNumQueries)));
+  }
+  return queries;
+}
+
+/// The queries one after the other, each on all threads
+void
+SerializedBfs(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto queries = MakeQueries(topo);
+    state.ResumeTiming();
+
+    for (auto& bfs : queries) {
+      BfsDoAll(topo, bfs.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+
+/// The queries side by side on groups of state.range(0) threads
+void
+ConcurrentBfs(benchmark::State& state) {
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+  auto scheduler = katana::ThreadGroupScheduler::Make(state.range(0)).value();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto queries = MakeQueries(topo);
+    state.ResumeTiming();
+
+    for (auto& bfs : queries) {
+      scheduler->Submit([&topo, bfs = bfs.get()](katana::ThreadGroup&) {
+        BfsDoAll(topo, bfs);
+      });
+    }
+    scheduler->Run();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+  state.counters["Groups"] = scheduler->groups().size();
+}
+
+BENCHMARK(SerializedBfs);
+BENCHMARK(ConcurrentBfs)->Arg(1)->Arg(2)->Arg(4);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  katana::setActiveThreads(katana::GetThreadPool().getMaxThreads());
+  ::benchmark::RunSpecifiedBenchmarks();
+}
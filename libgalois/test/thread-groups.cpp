@@ -0,0 +1,268 @@
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/Galois.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+#include "katana/ThreadGroups.h"
+#include "katana/Threads.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/connected_components/connected_components.h"
+
+namespace {
+
+constexpr uint64_t kNumRequests = 100;
+constexpr uint64_t kRange = 10000;
+constexpr unsigned kTreeDepth = 10;
+constexpr size_t kNumGraphs = 4;
+constexpr size_t kNumComponents = 8;
+constexpr size_t kComponentSize = 512;
+
+void
+TestPartition(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+
+  std::vector<bool> seen(katana::getActiveThreads());
+  for (const auto& group : scheduler->groups()) {
+    KATANA_LOG_ASSERT(group->size() > 0);
+    KATANA_LOG_ASSERT(group->size() <= group_size);
+    for (unsigned tid : group->threads()) {
+      KATANA_LOG_ASSERT(!seen[tid]);
+      seen[tid] = true;
+      KATANA_LOG_ASSERT(
+          katana::GetThreadPool().getSocket(tid) == group->socket());
+    }
+  }
+  for (bool s : seen) {
+    KATANA_LOG_ASSERT(s);
+  }
+}
+
+/// Inside a request the thread pool is the group: loops run on its threads
+/// with group ids, and PerThreadStorage is indexed by them
+void
+TestGroupView(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+  unsigned active_threads = katana::getActiveThreads();
+
+  std::atomic<uint64_t> errors{0};
+  for (uint64_t r = 0; r < kNumRequests; ++r) {
+    scheduler->Submit([&](katana::ThreadGroup& group) {
+      if (katana::getActiveThreads() != group.size() ||
+          katana::GetThreadPool().getMaxThreads() != group.size() ||
+          katana::ThreadPool::getTID() != 0) {
+        ++errors;
+      }
+
+      katana::PerThreadStorage<unsigned> pool_tids;
+      katana::on_each([&](unsigned tid, unsigned num_threads) {
+        if (tid >= group.size() || num_threads != group.size() ||
+            tid != katana::ThreadPool::getTID()) {
+          ++errors;
+        }
+        *pool_tids.getLocal() = katana::ThreadPool::getPoolTID();
+      });
+      for (unsigned i = 0; i < group.size(); ++i) {
+        if (*pool_tids.getRemote(i) != group.threads()[i]) {
+          ++errors;
+        }
+      }
+
+      // The active threads of a group can be lowered for a request
+      katana::setActiveThreads(1);
+      katana::on_each([&](unsigned, unsigned num_threads) {
+        if (num_threads != 1) {
+          ++errors;
+        }
+      });
+    });
+  }
+  scheduler->Run();
+
+  KATANA_LOG_ASSERT(errors == 0);
+  // The active threads outside of groups are untouched
+  KATANA_LOG_ASSERT(katana::getActiveThreads() == active_threads);
+}
+
+/// Every request sums a range into its own accumulator with do_all
+void
+TestDoAll(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+
+  std::vector<katana::GAccumulator<uint64_t>> sums(kNumRequests);
+  for (uint64_t r = 0; r < kNumRequests; ++r) {
+    scheduler->Submit([&, r](katana::ThreadGroup&) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, kRange + r),
+          [&](uint64_t i) { sums[r] += i; }, katana::steal(),
+          katana::loopname("ThreadGroupsDoAll"));
+    });
+  }
+  scheduler->Run();
+
+  for (uint64_t r = 0; r < kNumRequests; ++r) {
+    uint64_t n = kRange + r;
+    KATANA_LOG_ASSERT(sums[r].reduce() == n * (n - 1) / 2);
+  }
+  uint64_t num_requests = 0;
+  for (const auto& group : scheduler->groups()) {
+    num_requests += group->num_requests();
+  }
+  KATANA_LOG_ASSERT(num_requests == kNumRequests);
+}
+
+/// Every request expands a binary tree with for_each, which needs the
+/// termination detection and barrier of the group
+void
+TestForEach(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+
+  std::vector<katana::GAccumulator<uint64_t>> counts(kNumRequests);
+  for (uint64_t r = 0; r < kNumRequests; ++r) {
+    scheduler->Submit([&, r](katana::ThreadGroup&) {
+      katana::for_each(
+          katana::iterate({kTreeDepth}),
+          [&](unsigned depth, auto& ctx) {
+            counts[r] += 1;
+            if (depth > 0) {
+              ctx.push(depth - 1);
+              ctx.push(depth - 1);
+            }
+          },
+          katana::loopname("ThreadGroupsForEach"));
+    });
+  }
+  scheduler->Run();
+
+  for (auto& count : counts) {
+    KATANA_LOG_ASSERT(count.reduce() == (uint64_t{2} << kTreeDepth) - 1);
+  }
+}
+
+/// Requests submitted by requests run before Run returns
+void
+TestSubmitFromRequest(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+
+  std::atomic<uint64_t> num_run{0};
+  std::function<void(katana::ThreadGroup&)> chain =
+      [&](katana::ThreadGroup&) {
+        if (++num_run < kNumRequests) {
+          scheduler->Submit(chain);
+        }
+      };
+  scheduler->Submit(chain);
+  scheduler->Run();
+
+  KATANA_LOG_ASSERT(num_run == kNumRequests);
+
+  // Nothing left to run
+  scheduler->Run();
+  KATANA_LOG_ASSERT(num_run == kNumRequests);
+}
+
+/// kNumComponents rings of kComponentSize nodes
+std::unique_ptr<katana::PropertyGraph>
+MakeRings() {
+  katana::SymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumComponents * kComponentSize);
+  for (size_t c = 0; c < kNumComponents; ++c) {
+    size_t first = c * kComponentSize;
+    for (size_t i = 0; i < kComponentSize; ++i) {
+      builder.AddEdge(first + i, first + (i + 1) % kComponentSize);
+    }
+  }
+  return katana::PropertyGraph::Make(builder.ConvertToCSR()).value();
+}
+
+void
+RunAnalytic(size_t i, katana::PropertyGraph* pg, const std::string& name) {
+  if (i % 2 == 0) {
+    KATANA_LOG_ASSERT(katana::analytics::Bfs(pg, 0, name));
+  } else {
+    KATANA_LOG_ASSERT(katana::analytics::ConnectedComponents(pg, name));
+  }
+}
+
+/// BFS and connected components run at the same time in different groups
+/// and give the results they give on the whole thread pool
+void
+TestAnalytics(unsigned group_size) {
+  auto scheduler = katana::ThreadGroupScheduler::Make(group_size).value();
+
+  std::vector<std::unique_ptr<katana::PropertyGraph>> graphs;
+  for (size_t i = 0; i < kNumGraphs; ++i) {
+    graphs.emplace_back(MakeRings());
+    RunAnalytic(i, graphs[i].get(), "expected");
+  }
+
+  for (size_t i = 0; i < kNumGraphs; ++i) {
+    scheduler->Submit([&, i](katana::ThreadGroup&) {
+      RunAnalytic(i, graphs[i].get(), "actual");
+    });
+  }
+  scheduler->Run();
+
+  for (size_t i = 0; i < kNumGraphs; ++i) {
+    katana::PropertyGraph* pg = graphs[i].get();
+    if (i % 2 == 0) {
+      KATANA_LOG_ASSERT(katana::analytics::BfsAssertValid(pg, 0, "actual"));
+      auto stats =
+          katana::analytics::BfsStatistics::Compute(pg, "actual").value();
+      KATANA_LOG_ASSERT(stats.n_reached_nodes == kComponentSize);
+      // BFS levels do not depend on the schedule
+      KATANA_LOG_ASSERT(pg->GetNodeProperty("actual").value()->Equals(
+          *pg->GetNodeProperty("expected").value()));
+    } else {
+      KATANA_LOG_ASSERT(
+          katana::analytics::ConnectedComponentsAssertValid(pg, "actual"));
+      auto stats = katana::analytics::ConnectedComponentsStatistics::Compute(
+                       pg, "actual")
+                       .value();
+      auto expected =
+          katana::analytics::ConnectedComponentsStatistics::Compute(
+              pg, "expected")
+              .value();
+      KATANA_LOG_ASSERT(stats.total_components == kNumComponents);
+      KATANA_LOG_ASSERT(
+          stats.largest_component_size == expected.largest_component_size);
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::setActiveThreads(katana::GetThreadPool().getMaxThreads());
+
+  KATANA_LOG_ASSERT(!katana::ThreadGroupScheduler::Make(0));
+
+  for (unsigned group_size : {1U, 2U, 3U, katana::getActiveThreads()}) {
+    TestPartition(group_size);
+    TestGroupView(group_size);
+    TestDoAll(group_size);
+    TestForEach(group_size);
+    TestSubmitFromRequest(group_size);
+    TestAnalytics(group_size);
+  }
+
+  // Groups larger than sockets are cut at socket boundaries
+  auto per_socket = katana::ThreadGroupScheduler::MakePerSocket().value();
+  std::set<unsigned> sockets;
+  for (const auto& group : per_socket->groups()) {
+    KATANA_LOG_ASSERT(sockets.emplace(group->socket()).second);
+  }
+
+  return 0;
+}
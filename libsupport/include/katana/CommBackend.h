@@ -2,8 +2,13 @@
 #define KATANA_LIBSUPPORT_KATANA_COMMBACKEND_H_
 
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <type_traits>
+#include <vector>
 
+#include "katana/ErrorCode.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "katana/config.h"
@@ -29,6 +34,106 @@ public:
   /// Notify other tasks that there was a failure; e.g., with MPI_Abort
   virtual void NotifyFailure() = 0;
 
+  // Collectives over contiguous buffers. Every task must call the same
+  // collectives in the same order. The default implementations return
+  // ErrorCode::NotImplemented; use the typed versions below.
+
+  /// Every task sends size bytes from send; recv gets Num * size bytes, the
+  /// bytes of task i at offset i * size
+  virtual Result<void> AllGatherBytes(
+      const void* send, uint64_t size, void* recv);
+  /// Task i sends send_sizes[j] bytes from send[j] to task j and receives
+  /// recv_sizes[j] bytes from task j into recv[j]; recv_sizes[j] must equal
+  /// the send size of task j for task i
+  virtual Result<void> AllToAllVBytes(
+      const void* const* send, const uint64_t* send_sizes, void* const* recv,
+      const uint64_t* recv_sizes);
+
+  /// Every task sends count values from send; recv gets Num * count values,
+  /// the values of task i at offset i * count
+  template <typename T>
+  Result<void> AllGather(const T* send, uint64_t count, T* recv) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return AllGatherBytes(send, count * sizeof(T), recv);
+  }
+
+  /// \returns the value of every task, indexed by task
+  template <typename T>
+  Result<std::vector<T>> AllGather(const T& value) {
+    std::vector<T> values(Num);
+    KATANA_CHECKED(AllGather(&value, 1, values.data()));
+    return values;
+  }
+
+  /// Replace values with the elementwise reduction of the values of all
+  /// tasks. Values are combined in task order, so every task gets the same
+  /// result even for operations like floating point addition that are not
+  /// associative.
+  template <typename T, typename Op = std::plus<T>>
+  Result<void> AllReduce(T* values, uint64_t count, Op op = Op()) {
+    std::vector<T> all(Num * count);
+    KATANA_CHECKED(AllGather(values, count, all.data()));
+    for (uint64_t i = 0; i < count; ++i) {
+      T acc = all[i];
+      for (uint32_t task = 1; task < Num; ++task) {
+        acc = op(acc, all[task * count + i]);
+      }
+      values[i] = acc;
+    }
+    return ResultSuccess();
+  }
+
+  template <typename T, typename Op = std::plus<T>>
+  Result<T> AllReduce(T value, Op op = Op()) {
+    KATANA_CHECKED(AllReduce(&value, 1, op));
+    return value;
+  }
+
+  /// Send send[j] to task j
+  ///
+  /// \returns the values sent to this task, indexed by sending task
+  template <typename T>
+  Result<std::vector<std::vector<T>>> AllToAllV(
+      const std::vector<std::vector<T>>& send) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (send.size() != Num) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "expected {} send buffers found {}",
+          Num, send.size());
+    }
+
+    std::vector<const void*> send_ptrs(Num);
+    std::vector<uint64_t> send_sizes(Num);
+    for (uint32_t task = 0; task < Num; ++task) {
+      send_ptrs[task] = send[task].data();
+      send_sizes[task] = send[task].size() * sizeof(T);
+    }
+
+    // Exchange the sizes first so that receivers can allocate
+    std::vector<const void*> size_ptrs(Num);
+    std::vector<void*> recv_size_ptrs(Num);
+    std::vector<uint64_t> recv_sizes(Num);
+    std::vector<uint64_t> fixed_sizes(Num, sizeof(uint64_t));
+    for (uint32_t task = 0; task < Num; ++task) {
+      size_ptrs[task] = &send_sizes[task];
+      recv_size_ptrs[task] = &recv_sizes[task];
+    }
+    KATANA_CHECKED(AllToAllVBytes(
+        size_ptrs.data(), fixed_sizes.data(), recv_size_ptrs.data(),
+        fixed_sizes.data()));
+
+    std::vector<std::vector<T>> recv(Num);
+    std::vector<void*> recv_ptrs(Num);
+    for (uint32_t task = 0; task < Num; ++task) {
+      recv[task].resize(recv_sizes[task] / sizeof(T));
+      recv_ptrs[task] = recv[task].data();
+    }
+    KATANA_CHECKED(AllToAllVBytes(
+        send_ptrs.data(), send_sizes.data(), recv_ptrs.data(),
+        recv_sizes.data()));
+    return recv;
+  }
+
   // TODO(thunt): Num and ID were chosen because of NetworkInterface. Changing
   // them is very disruptive so I'll defer for a time in the future where we're
   // not worried about upstream and can global replace.
@@ -53,6 +158,16 @@ public:
       uint64_t max_size) override {
     return val.substr(0, max_size);
   }
+  Result<void> AllGatherBytes(
+      const void* send, uint64_t size, void* recv) override {
+    if (size > 0) {
+      std::memcpy(recv, send, size);
+    }
+    return ResultSuccess();
+  }
+  Result<void> AllToAllVBytes(
+      const void* const* send, const uint64_t* send_sizes, void* const* recv,
+      const uint64_t* recv_sizes) override;
 };
 
 }  // namespace katana
@@ -66,6 +66,7 @@ enum class ErrorCode {
   AssertionFailed = 12,
   GraphUpdateFailed = 13,
   FeatureNotEnabled = 14,
+  OutOfMemory = 15,
 };
 
 }  // namespace katana
@@ -108,6 +109,8 @@ public:
       return "graph update failed";
     case ErrorCode::FeatureNotEnabled:
       return "not built with this feature";
+    case ErrorCode::OutOfMemory:
+      return "out of memory";
     default:
       return "unknown error";
     }
@@ -134,6 +137,8 @@ public:
       return make_error_condition(std::errc::no_such_file_or_directory);
     case ErrorCode::HTTPError:
       return make_error_condition(std::errc::io_error);
+    case ErrorCode::OutOfMemory:
+      return make_error_condition(std::errc::not_enough_memory);
     default:
       return std::error_condition(c, *this);
     }
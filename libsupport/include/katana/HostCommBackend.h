@@ -0,0 +1,100 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_HOSTCOMMBACKEND_H_
+#define KATANA_LIBSUPPORT_KATANA_HOSTCOMMBACKEND_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "katana/CommBackend.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A CommBackend for Num processes on one host that communicate through
+/// POSIX shared memory, so that partitioned workloads can run, and be
+/// tested, without MPI.
+///
+/// Every process calls Make with the same name and Num and its own Rank.
+/// Rank 0 creates a control segment with the barrier, and every task
+/// creates a staging segment for the data it sends. In each collective,
+/// tasks copy their payload into their staging segment, wait at a barrier,
+/// copy what they receive straight out of the staging segments of the
+/// senders, and wait at a second barrier before the staging segments are
+/// reused. Payloads are copied once on each side regardless of their size,
+/// and staging segments grow to the largest payload a task sends.
+///
+/// Names are unlinked as soon as all tasks have mapped the segments, so
+/// nothing is left behind in /dev/shm when processes exit or crash.
+class KATANA_EXPORT HostCommBackend : public CommBackend {
+public:
+  ~HostCommBackend() override;
+
+  /// \param name identifies the group; "/" followed by characters other
+  ///     than "/", unique among groups running at the same time
+  /// \param num the number of tasks in the group
+  /// \param rank the rank of this task in [0, num)
+  /// \param timeout how long to wait for the other tasks to start
+  static Result<std::unique_ptr<HostCommBackend>> Make(
+      const std::string& name, uint32_t num, uint32_t rank,
+      std::chrono::milliseconds timeout = std::chrono::seconds(60));
+
+  void Barrier() override;
+  bool Broadcast(uint32_t root, bool val) override;
+  std::string Broadcast(
+      uint32_t root, const std::string& val, uint64_t max_size) override;
+  /// Make other tasks fail at their next barrier
+  void NotifyFailure() override;
+
+  Result<void> AllGatherBytes(
+      const void* send, uint64_t size, void* recv) override;
+  Result<void> AllToAllVBytes(
+      const void* const* send, const uint64_t* send_sizes, void* const* recv,
+      const uint64_t* recv_sizes) override;
+
+private:
+  struct Control;
+
+  struct Mapping {
+    int fd{-1};
+    uint8_t* data{nullptr};
+    uint64_t size{0};
+  };
+
+  HostCommBackend() = default;
+
+  Control* control() const;
+
+  void Unmap(Mapping* mapping);
+
+  /// Barrier that gives up at deadline or when another task failed
+  Result<void> BarrierUntil(std::chrono::steady_clock::time_point deadline);
+
+  /// Make the staging segment of this task at least size bytes
+  Result<void> ReserveStaging(uint64_t size);
+
+  /// The staging segment of task, mapped at its current size
+  Result<const uint8_t*> Staging(uint32_t task);
+
+  /// Fill the staging segment of this task with size bytes using fill
+  /// (tasks that send nothing pass size 0 and no fill), then call read for
+  /// every task with its staging segment
+  Result<void> Exchange(
+      uint64_t size, const std::function<void(uint8_t*)>& fill,
+      const std::function<Result<void>(uint32_t, const uint8_t*)>& read);
+
+  std::string name_;
+  /// Whether the names of the segments are gone, which happens once every
+  /// task opened every segment
+  bool names_unlinked_{false};
+  Mapping control_;
+  /// staging_[Rank] is ours, the others are those of the other tasks
+  std::vector<Mapping> staging_;
+};
+
+}  // namespace katana
+
+#endif
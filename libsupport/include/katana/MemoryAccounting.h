@@ -0,0 +1,92 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_MEMORYACCOUNTING_H_
+#define KATANA_LIBSUPPORT_KATANA_MEMORYACCOUNTING_H_
+
+#include <cstdint>
+#include <limits>
+
+#include <arrow/memory_pool.h>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// The parts of the system whose memory use is accounted separately
+enum class MemoryCategory : uint8_t {
+  kTopology = 0,
+  kProperties,
+  kViews,
+  kIndexes,
+  kWorklists,
+  kOther,
+};
+
+constexpr size_t kNumMemoryCategories = 6;
+
+/// The limit of a category without one
+constexpr uint64_t kNoMemoryLimit = std::numeric_limits<uint64_t>::max();
+
+KATANA_EXPORT const char* MemoryCategoryName(MemoryCategory category);
+
+/// Count bytes against a category, failing with ErrorCode::OutOfMemory when
+/// that would exceed the limit of the category or the total limit. Callers
+/// that get an error should not allocate.
+KATANA_EXPORT Result<void> ReserveMemory(
+    MemoryCategory category, uint64_t bytes);
+
+/// Count bytes against a category regardless of limits, for allocators that
+/// have no way to report failure
+KATANA_EXPORT void ChargeMemory(MemoryCategory category, uint64_t bytes);
+
+/// Stop counting bytes previously reserved or charged
+KATANA_EXPORT void ReleaseMemory(MemoryCategory category, uint64_t bytes);
+
+KATANA_EXPORT uint64_t GetMemoryUsed(MemoryCategory category);
+/// The largest value GetMemoryUsed(category) has had
+KATANA_EXPORT uint64_t GetPeakMemoryUsed(MemoryCategory category);
+KATANA_EXPORT uint64_t GetTotalMemoryUsed();
+
+/// Limits are enforced only by ReserveMemory: arrow pools from
+/// GetArrowMemoryPool, the try* allocations of NUMAArray and NumaMem, and the
+/// checked page preallocation TryEnsurePreallocated that analytics run on
+/// entry. Plain NUMAArray allocations and page pool pages taken while loops
+/// run use ChargeMemory, so they are counted but can go over a limit.
+KATANA_EXPORT void SetMemoryLimit(MemoryCategory category, uint64_t bytes);
+KATANA_EXPORT uint64_t GetMemoryLimit(MemoryCategory category);
+KATANA_EXPORT void SetTotalMemoryLimit(uint64_t bytes);
+KATANA_EXPORT uint64_t GetTotalMemoryLimit();
+
+/// The category that allocators which are not told a category count memory
+/// against; kOther unless set by a MemoryCategoryScope on this thread
+KATANA_EXPORT MemoryCategory CurrentMemoryCategory();
+
+/// Sets the current memory category of this thread for the lifetime of the
+/// scope
+class KATANA_EXPORT MemoryCategoryScope {
+public:
+  explicit MemoryCategoryScope(MemoryCategory category);
+  ~MemoryCategoryScope();
+
+  MemoryCategoryScope(const MemoryCategoryScope&) = delete;
+  MemoryCategoryScope& operator=(const MemoryCategoryScope&) = delete;
+
+private:
+  MemoryCategory prev_;
+};
+
+/// Return a pool for arrow buffers that counts them against category. The
+/// pool allocates from the backing pool set by SetArrowBackingMemoryPool, or
+/// the arrow default pool before one is set. Pools stay valid for the
+/// lifetime of the process.
+KATANA_EXPORT arrow::MemoryPool* GetArrowMemoryPool(
+    MemoryCategory category = CurrentMemoryCategory());
+
+/// Set the pool that pools returned by later calls to GetArrowMemoryPool
+/// allocate from; nullptr restores the arrow default pool. Buffers allocated
+/// before the change are still freed to the pool they came from. The backing
+/// pool must outlive all buffers allocated from it.
+KATANA_EXPORT void SetArrowBackingMemoryPool(arrow::MemoryPool* pool);
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_SHA256_H_
+#define KATANA_LIBSUPPORT_KATANA_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// Sha256 computes the SHA-256 digest (FIPS 180-4) of a sequence of bytes
+/// given in one or more calls to Update. It is used to name files by their
+/// contents, so it favors simplicity over speed.
+class KATANA_EXPORT Sha256 {
+public:
+  static constexpr size_t kDigestSize = 32;
+  using Digest = std::array<uint8_t, kDigestSize>;
+
+  Sha256();
+
+  void Update(const void* data, size_t size);
+
+  void Update(std::string_view data) { Update(data.data(), data.size()); }
+
+  /// Finish the digest; the object must not be updated afterwards
+  Digest Finish();
+
+  /// \returns the digest of data as lower case hex
+  static std::string HexDigest(const void* data, size_t size);
+
+  static std::string HexDigest(std::string_view data) {
+    return HexDigest(data.data(), data.size());
+  }
+
+private:
+  static constexpr size_t kBlockSize = 64;
+
+  void Compress(const uint8_t* block);
+
+  std::array<uint32_t, 8> state_;
+  std::array<uint8_t, kBlockSize> buffer_;
+  size_t buffer_size_{0};
+  uint64_t total_size_{0};
+};
+
+}  // namespace katana
+
+#endif
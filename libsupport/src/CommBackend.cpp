@@ -1,8 +1,38 @@
 #include "katana/CommBackend.h"
 
+#include <cstring>
+
 // Anchor vtables
 
 katana::CommBackend::~CommBackend() = default;
 
 void
 katana::NullCommBackend::NotifyFailure() {}
+
+katana::Result<void>
+katana::CommBackend::AllGatherBytes(const void*, uint64_t, void*) {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "AllGatherBytes is not implemented");
+}
+
+katana::Result<void>
+katana::CommBackend::AllToAllVBytes(
+    const void* const*, const uint64_t*, void* const*, const uint64_t*) {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "AllToAllVBytes is not implemented");
+}
+
+katana::Result<void>
+katana::NullCommBackend::AllToAllVBytes(
+    const void* const* send, const uint64_t* send_sizes, void* const* recv,
+    const uint64_t* recv_sizes) {
+  if (send_sizes[0] != recv_sizes[0]) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "sending {} bytes but receiving {}",
+        send_sizes[0], recv_sizes[0]);
+  }
+  if (send_sizes[0] > 0) {
+    std::memcpy(recv[0], send[0], send_sizes[0]);
+  }
+  return ResultSuccess();
+}
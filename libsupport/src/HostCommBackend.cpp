@@ -0,0 +1,408 @@
+#include "katana/HostCommBackend.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+
+namespace {
+
+// "KATCOMM1"
+constexpr uint64_t kControlMagic = 0x4b4154434f4d4d31ULL;
+/// Spins in a barrier before yielding the processor
+constexpr uint64_t kBarrierSpins = 1 << 10;
+constexpr uint64_t kMinStagingSize = 1 << 16;
+
+using Clock = std::chrono::steady_clock;
+
+std::string
+StagingName(const std::string& name, uint32_t rank) {
+  return fmt::format("{}.{}", name, rank);
+}
+
+uint64_t
+AlignUp(uint64_t size) {
+  return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+katana::Result<uint8_t*>
+Map(int fd, uint64_t size, int prot) {
+  void* ptr = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    return KATANA_ERROR(katana::ResultErrno(), "mapping {} bytes", size);
+  }
+  return static_cast<uint8_t*>(ptr);
+}
+
+}  // namespace
+
+/// The segment of rank 0, followed by the current size of the staging
+/// segment of each task
+struct katana::HostCommBackend::Control {
+  std::atomic<uint64_t> magic;
+  uint32_t num;
+  std::atomic<uint32_t> failed;
+  std::atomic<uint32_t> barrier_count;
+  std::atomic<uint32_t> barrier_generation;
+
+  std::atomic<uint64_t>* staging_sizes() {
+    return reinterpret_cast<std::atomic<uint64_t>*>(this + 1);  // NOLINT
+  }
+
+  static uint64_t SizeFor(uint32_t num) {
+    return sizeof(Control) + num * sizeof(std::atomic<uint64_t>);
+  }
+};
+
+katana::HostCommBackend::Control*
+katana::HostCommBackend::control() const {
+  return reinterpret_cast<Control*>(control_.data);  // NOLINT
+}
+
+katana::HostCommBackend::~HostCommBackend() {
+  if (!names_unlinked_) {
+    // Make failed before every task opened every segment
+    if (!staging_.empty() && staging_[Rank].fd >= 0) {
+      shm_unlink(StagingName(name_, Rank).c_str());
+    }
+    if (Rank == 0 && control_.fd >= 0) {
+      shm_unlink(name_.c_str());
+    }
+  }
+  for (Mapping& staging : staging_) {
+    Unmap(&staging);
+  }
+  Unmap(&control_);
+}
+
+void
+katana::HostCommBackend::Unmap(Mapping* mapping) {
+  if (mapping->data && munmap(mapping->data, mapping->size)) {
+    KATANA_LOG_ERROR("unmapping segment of {}", name_);
+  }
+  if (mapping->fd >= 0) {
+    close(mapping->fd);
+  }
+  *mapping = Mapping{};
+}
+
+katana::Result<std::unique_ptr<katana::HostCommBackend>>
+katana::HostCommBackend::Make(
+    const std::string& name, uint32_t num, uint32_t rank,
+    std::chrono::milliseconds timeout) {
+  if (num == 0 || rank >= num) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "rank {} out of range for {} tasks", rank,
+        num);
+  }
+  if (name.size() < 2 || name[0] != '/' ||
+      name.find('/', 1) != std::string::npos) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "name must be / followed by characters other than /: {}", name);
+  }
+  Clock::time_point deadline = Clock::now() + timeout;
+
+  std::unique_ptr<HostCommBackend> comm(new HostCommBackend());
+  comm->Num = num;
+  comm->Rank = rank;
+  comm->LocalRank = rank;
+  comm->name_ = name;
+  comm->staging_.resize(num);
+
+  uint64_t control_size = Control::SizeFor(num);
+  Mapping& control = comm->control_;
+  if (rank == 0) {
+    control.fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (control.fd < 0) {
+      return KATANA_ERROR(ResultErrno(), "creating {}", name);
+    }
+    if (ftruncate(control.fd, control_size)) {
+      return KATANA_ERROR(ResultErrno(), "sizing {}", name);
+    }
+    control.data = KATANA_CHECKED_CONTEXT(
+        Map(control.fd, control_size, PROT_READ | PROT_WRITE), "{}", name);
+    control.size = control_size;
+    comm->control()->num = num;
+    comm->control()->magic.store(kControlMagic, std::memory_order_release);
+  } else {
+    // Wait for rank 0 to create and initialize the control segment
+    while (true) {
+      if (control.fd < 0) {
+        control.fd = shm_open(name.c_str(), O_RDWR, 0);
+      }
+      struct stat st;
+      if (control.fd >= 0 && !control.data && !fstat(control.fd, &st) &&
+          static_cast<uint64_t>(st.st_size) >= control_size) {
+        control.data = KATANA_CHECKED_CONTEXT(
+            Map(control.fd, control_size, PROT_READ | PROT_WRITE), "{}", name);
+        control.size = control_size;
+      }
+      if (control.data &&
+          comm->control()->magic.load(std::memory_order_acquire) ==
+              kControlMagic) {
+        break;
+      }
+      if (Clock::now() > deadline) {
+        return KATANA_ERROR(
+            ErrorCode::NotFound, "timed out waiting for rank 0 to create {}",
+            name);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (comm->control()->num != num) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "{} has {} tasks, expected {}", name,
+          comm->control()->num, num);
+    }
+  }
+
+  std::string staging_name = StagingName(name, rank);
+  Mapping& staging = comm->staging_[rank];
+  staging.fd =
+      shm_open(staging_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (staging.fd < 0) {
+    return KATANA_ERROR(ResultErrno(), "creating {}", staging_name);
+  }
+
+  // Open the staging segments of the other tasks once they all exist, and
+  // remove the names once every task has opened everything
+  KATANA_CHECKED_CONTEXT(comm->BarrierUntil(deadline), "creating {}", name);
+  for (uint32_t task = 0; task < num; ++task) {
+    if (task == rank) {
+      continue;
+    }
+    std::string peer_name = StagingName(name, task);
+    comm->staging_[task].fd = shm_open(peer_name.c_str(), O_RDONLY, 0);
+    if (comm->staging_[task].fd < 0) {
+      return KATANA_ERROR(ResultErrno(), "opening {}", peer_name);
+    }
+  }
+  KATANA_CHECKED_CONTEXT(comm->BarrierUntil(deadline), "opening {}", name);
+
+  comm->names_unlinked_ = true;
+  if (shm_unlink(staging_name.c_str())) {
+    KATANA_LOG_WARN("unlinking {}", staging_name);
+  }
+  if (rank == 0 && shm_unlink(name.c_str())) {
+    KATANA_LOG_WARN("unlinking {}", name);
+  }
+
+  return std::unique_ptr<HostCommBackend>(std::move(comm));
+}
+
+katana::Result<void>
+katana::HostCommBackend::BarrierUntil(Clock::time_point deadline) {
+  Control* c = control();
+  uint32_t generation = c->barrier_generation.load(std::memory_order_acquire);
+  if (c->barrier_count.fetch_add(1, std::memory_order_acq_rel) + 1 == Num) {
+    c->barrier_count.store(0, std::memory_order_relaxed);
+    c->barrier_generation.fetch_add(1, std::memory_order_release);
+    return ResultSuccess();
+  }
+  for (uint64_t spins = 0;
+       c->barrier_generation.load(std::memory_order_acquire) == generation;
+       ++spins) {
+    if (c->failed.load(std::memory_order_relaxed)) {
+      return KATANA_ERROR(ErrorCode::AssertionFailed, "another task failed");
+    }
+    if (spins >= kBarrierSpins) {
+      if (Clock::now() > deadline) {
+        return KATANA_ERROR(
+            ErrorCode::AssertionFailed, "timed out waiting for other tasks");
+      }
+      std::this_thread::yield();
+    }
+  }
+  return ResultSuccess();
+}
+
+void
+katana::HostCommBackend::Barrier() {
+  if (auto res = BarrierUntil(Clock::time_point::max()); !res) {
+    KATANA_LOG_FATAL("Barrier: {}", res.error());
+  }
+}
+
+void
+katana::HostCommBackend::NotifyFailure() {
+  control()->failed.store(1, std::memory_order_relaxed);
+}
+
+katana::Result<void>
+katana::HostCommBackend::ReserveStaging(uint64_t size) {
+  Mapping& staging = staging_[Rank];
+  if (size <= staging.size) {
+    return ResultSuccess();
+  }
+  uint64_t new_size = std::max({size, 2 * staging.size, kMinStagingSize});
+  if (ftruncate(staging.fd, new_size)) {
+    return KATANA_ERROR(ResultErrno(), "growing staging to {}", new_size);
+  }
+  uint8_t* data =
+      KATANA_CHECKED(Map(staging.fd, new_size, PROT_READ | PROT_WRITE));
+  if (staging.data && munmap(staging.data, staging.size)) {
+    KATANA_LOG_ERROR("unmapping staging of {}", name_);
+  }
+  staging.data = data;
+  staging.size = new_size;
+  control()->staging_sizes()[Rank].store(new_size, std::memory_order_release);
+  return ResultSuccess();
+}
+
+katana::Result<const uint8_t*>
+katana::HostCommBackend::Staging(uint32_t task) {
+  Mapping& staging = staging_[task];
+  uint64_t size =
+      control()->staging_sizes()[task].load(std::memory_order_acquire);
+  if (size > staging.size) {
+    // The task grew its staging segment since we last mapped it
+    uint8_t* data = KATANA_CHECKED(Map(staging.fd, size, PROT_READ));
+    if (staging.data && munmap(staging.data, staging.size)) {
+      KATANA_LOG_ERROR("unmapping staging of {}", name_);
+    }
+    staging.data = data;
+    staging.size = size;
+  }
+  return staging.data;
+}
+
+katana::Result<void>
+katana::HostCommBackend::Exchange(
+    uint64_t size, const std::function<void(uint8_t*)>& fill,
+    const std::function<Result<void>(uint32_t, const uint8_t*)>& read) {
+  if (size > 0) {
+    if (auto res = ReserveStaging(size); !res) {
+      // The other tasks cannot tell that our staging is stale
+      NotifyFailure();
+      return res.error();
+    }
+    fill(staging_[Rank].data);
+  }
+  Barrier();
+
+  // Keep going on errors so that all tasks reach the second barrier
+  Result<void> result = ResultSuccess();
+  for (uint32_t task = 0; task < Num; ++task) {
+    auto staging = Staging(task);
+    if (!staging) {
+      result = staging.error();
+      continue;
+    }
+    if (auto res = read(task, staging.value()); !res && result) {
+      result = res.error();
+    }
+  }
+  Barrier();
+  return result;
+}
+
+bool
+katana::HostCommBackend::Broadcast(uint32_t root, bool val) {
+  bool ret = val;
+  auto res = Exchange(
+      Rank == root ? 1 : 0, [&](uint8_t* staging) { staging[0] = val; },
+      [&](uint32_t task, const uint8_t* staging) -> Result<void> {
+        if (task == root) {
+          ret = staging[0];
+        }
+        return ResultSuccess();
+      });
+  if (!res) {
+    KATANA_LOG_FATAL("Broadcast: {}", res.error());
+  }
+  return ret;
+}
+
+std::string
+katana::HostCommBackend::Broadcast(
+    uint32_t root, const std::string& val, uint64_t max_size) {
+  uint64_t len = std::min<uint64_t>(val.size(), max_size);
+  std::string ret;
+  auto res = Exchange(
+      Rank == root ? sizeof(len) + len : 0,
+      [&](uint8_t* staging) {
+        std::memcpy(staging, &len, sizeof(len));
+        std::memcpy(staging + sizeof(len), val.data(), len);
+      },
+      [&](uint32_t task, const uint8_t* staging) -> Result<void> {
+        if (task == root) {
+          uint64_t root_len = 0;
+          std::memcpy(&root_len, staging, sizeof(root_len));
+          ret.assign(
+              reinterpret_cast<const char*>(staging + sizeof(root_len)),
+              root_len);
+        }
+        return ResultSuccess();
+      });
+  if (!res) {
+    KATANA_LOG_FATAL("Broadcast: {}", res.error());
+  }
+  return ret;
+}
+
+katana::Result<void>
+katana::HostCommBackend::AllGatherBytes(
+    const void* send, uint64_t size, void* recv) {
+  return Exchange(
+      size, [&](uint8_t* staging) { std::memcpy(staging, send, size); },
+      [&](uint32_t task, const uint8_t* staging) -> Result<void> {
+        if (size > 0) {
+          std::memcpy(static_cast<uint8_t*>(recv) + task * size, staging, size);
+        }
+        return ResultSuccess();
+      });
+}
+
+katana::Result<void>
+katana::HostCommBackend::AllToAllVBytes(
+    const void* const* send, const uint64_t* send_sizes, void* const* recv,
+    const uint64_t* recv_sizes) {
+  // The staging segment holds the offset and the size of the payload for
+  // each task followed by the payloads
+  uint64_t header_size = 2 * Num * sizeof(uint64_t);
+  uint64_t size = header_size;
+  for (uint32_t task = 0; task < Num; ++task) {
+    size += AlignUp(send_sizes[task]);
+  }
+
+  auto fill = [&](uint8_t* staging) {
+    auto* offsets = reinterpret_cast<uint64_t*>(staging);  // NOLINT
+    uint64_t* sizes = offsets + Num;
+    uint64_t offset = header_size;
+    for (uint32_t task = 0; task < Num; ++task) {
+      offsets[task] = offset;
+      sizes[task] = send_sizes[task];
+      if (send_sizes[task] > 0) {
+        std::memcpy(staging + offset, send[task], send_sizes[task]);
+      }
+      offset += AlignUp(send_sizes[task]);
+    }
+  };
+
+  auto read = [&](uint32_t task, const uint8_t* staging) -> Result<void> {
+    const auto* offsets =
+        reinterpret_cast<const uint64_t*>(staging);  // NOLINT
+    const uint64_t* sizes = offsets + Num;
+    if (sizes[Rank] != recv_sizes[task]) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "task {} sends {} bytes but {} bytes were expected", task,
+          sizes[Rank], recv_sizes[task]);
+    }
+    if (sizes[Rank] > 0) {
+      std::memcpy(recv[task], staging + offsets[Rank], sizes[Rank]);
+    }
+    return ResultSuccess();
+  };
+
+  return Exchange(size, fill, read);
+}
@@ -0,0 +1,276 @@
+#include "katana/MemoryAccounting.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+
+namespace {
+
+struct CategoryState {
+  std::atomic<uint64_t> used{0};
+  std::atomic<uint64_t> peak{0};
+  std::atomic<uint64_t> limit{katana::kNoMemoryLimit};
+};
+
+std::array<CategoryState, katana::kNumMemoryCategories> categories;
+std::atomic<uint64_t> total_used{0};
+std::atomic<uint64_t> total_limit{katana::kNoMemoryLimit};
+
+thread_local katana::MemoryCategory current_category =
+    katana::MemoryCategory::kOther;
+
+CategoryState&
+GetState(katana::MemoryCategory category) {
+  auto idx = static_cast<size_t>(category);
+  KATANA_LOG_DEBUG_ASSERT(idx < katana::kNumMemoryCategories);
+  return categories[idx];
+}
+
+void
+UpdatePeak(std::atomic<uint64_t>* peak, uint64_t used) {
+  uint64_t prev = peak->load(std::memory_order_relaxed);
+  while (prev < used &&
+         !peak->compare_exchange_weak(prev, used, std::memory_order_relaxed)) {
+  }
+}
+
+/// Counts the buffers of one category and forwards them to a backing pool
+class AccountingPool final : public arrow::MemoryPool {
+public:
+  AccountingPool(arrow::MemoryPool* backing, katana::MemoryCategory category)
+      : backing_(backing), category_(category) {}
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override {
+    if (auto res = katana::ReserveMemory(category_, size); !res) {
+      return arrow::Status::OutOfMemory(fmt::format("{}", res.error()));
+    }
+    if (auto status = backing_->Allocate(size, out); !status.ok()) {
+      katana::ReleaseMemory(category_, size);
+      return status;
+    }
+    Add(size);
+    return arrow::Status::OK();
+  }
+
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override {
+    if (new_size > old_size) {
+      if (auto res = katana::ReserveMemory(category_, new_size - old_size);
+          !res) {
+        return arrow::Status::OutOfMemory(fmt::format("{}", res.error()));
+      }
+    }
+    if (auto status = backing_->Reallocate(old_size, new_size, ptr);
+        !status.ok()) {
+      if (new_size > old_size) {
+        katana::ReleaseMemory(category_, new_size - old_size);
+      }
+      return status;
+    }
+    if (new_size < old_size) {
+      katana::ReleaseMemory(category_, old_size - new_size);
+    }
+    Add(new_size - old_size);
+    return arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) override {
+    backing_->Free(buffer, size);
+    katana::ReleaseMemory(category_, size);
+    Add(-size);
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytes_allocated_.load(std::memory_order_relaxed);
+  }
+
+  int64_t max_memory() const override {
+    return max_memory_.load(std::memory_order_relaxed);
+  }
+
+  std::string backend_name() const override {
+    return backing_->backend_name();
+  }
+
+private:
+  void Add(int64_t delta) {
+    int64_t now = bytes_allocated_.fetch_add(delta) + delta;
+    int64_t prev = max_memory_.load(std::memory_order_relaxed);
+    while (prev < now && !max_memory_.compare_exchange_weak(
+                             prev, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  arrow::MemoryPool* backing_;
+  katana::MemoryCategory category_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+};
+
+struct PoolSet {
+  arrow::MemoryPool* backing;
+  std::array<std::unique_ptr<AccountingPool>, katana::kNumMemoryCategories>
+      pools;
+};
+
+std::mutex pools_mutex;
+std::atomic<PoolSet*> current_pools{nullptr};
+
+/// Pool sets are never destroyed because buffers may be freed to them until
+/// the process exits
+PoolSet*
+FindOrMakePoolSet(arrow::MemoryPool* backing) {
+  static auto* pool_sets = new std::vector<std::unique_ptr<PoolSet>>();
+
+  for (const auto& set : *pool_sets) {
+    if (set->backing == backing) {
+      return set.get();
+    }
+  }
+  auto set = std::make_unique<PoolSet>();
+  set->backing = backing;
+  for (size_t i = 0; i < katana::kNumMemoryCategories; ++i) {
+    set->pools[i] = std::make_unique<AccountingPool>(
+        backing, static_cast<katana::MemoryCategory>(i));
+  }
+  pool_sets->emplace_back(std::move(set));
+  return pool_sets->back().get();
+}
+
+}  // namespace
+
+const char*
+katana::MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+  case MemoryCategory::kTopology:
+    return "Topology";
+  case MemoryCategory::kProperties:
+    return "Properties";
+  case MemoryCategory::kViews:
+    return "Views";
+  case MemoryCategory::kIndexes:
+    return "Indexes";
+  case MemoryCategory::kWorklists:
+    return "Worklists";
+  case MemoryCategory::kOther:
+    return "Other";
+  }
+  return "Unknown";
+}
+
+katana::Result<void>
+katana::ReserveMemory(MemoryCategory category, uint64_t bytes) {
+  CategoryState& state = GetState(category);
+  uint64_t used = state.used.fetch_add(bytes) + bytes;
+  uint64_t total = total_used.fetch_add(bytes) + bytes;
+
+  uint64_t limit = state.limit.load(std::memory_order_relaxed);
+  uint64_t total_lim = total_limit.load(std::memory_order_relaxed);
+  if (used > limit || total > total_lim) {
+    state.used.fetch_sub(bytes);
+    total_used.fetch_sub(bytes);
+    if (used > limit) {
+      return KATANA_ERROR(
+          ErrorCode::OutOfMemory,
+          "{} memory limit is {} bytes, {} in use, {} more requested",
+          MemoryCategoryName(category), limit, used - bytes, bytes);
+    }
+    return KATANA_ERROR(
+        ErrorCode::OutOfMemory,
+        "total memory limit is {} bytes, {} in use, {} more requested for {}",
+        total_lim, total - bytes, bytes, MemoryCategoryName(category));
+  }
+
+  UpdatePeak(&state.peak, used);
+  return ResultSuccess();
+}
+
+void
+katana::ChargeMemory(MemoryCategory category, uint64_t bytes) {
+  CategoryState& state = GetState(category);
+  uint64_t used = state.used.fetch_add(bytes) + bytes;
+  total_used.fetch_add(bytes);
+  UpdatePeak(&state.peak, used);
+}
+
+void
+katana::ReleaseMemory(MemoryCategory category, uint64_t bytes) {
+  GetState(category).used.fetch_sub(bytes);
+  total_used.fetch_sub(bytes);
+}
+
+uint64_t
+katana::GetMemoryUsed(MemoryCategory category) {
+  return GetState(category).used.load(std::memory_order_relaxed);
+}
+
+uint64_t
+katana::GetPeakMemoryUsed(MemoryCategory category) {
+  return GetState(category).peak.load(std::memory_order_relaxed);
+}
+
+uint64_t
+katana::GetTotalMemoryUsed() {
+  return total_used.load(std::memory_order_relaxed);
+}
+
+void
+katana::SetMemoryLimit(MemoryCategory category, uint64_t bytes) {
+  GetState(category).limit.store(bytes, std::memory_order_relaxed);
+}
+
+uint64_t
+katana::GetMemoryLimit(MemoryCategory category) {
+  return GetState(category).limit.load(std::memory_order_relaxed);
+}
+
+void
+katana::SetTotalMemoryLimit(uint64_t bytes) {
+  total_limit.store(bytes, std::memory_order_relaxed);
+}
+
+uint64_t
+katana::GetTotalMemoryLimit() {
+  return total_limit.load(std::memory_order_relaxed);
+}
+
+katana::MemoryCategory
+katana::CurrentMemoryCategory() {
+  return current_category;
+}
+
+katana::MemoryCategoryScope::MemoryCategoryScope(MemoryCategory category)
+    : prev_(current_category) {
+  current_category = category;
+}
+
+katana::MemoryCategoryScope::~MemoryCategoryScope() {
+  current_category = prev_;
+}
+
+arrow::MemoryPool*
+katana::GetArrowMemoryPool(MemoryCategory category) {
+  PoolSet* set = current_pools.load(std::memory_order_acquire);
+  if (!set) {
+    std::lock_guard<std::mutex> lock(pools_mutex);
+    set = current_pools.load(std::memory_order_relaxed);
+    if (!set) {
+      set = FindOrMakePoolSet(arrow::default_memory_pool());
+      current_pools.store(set, std::memory_order_release);
+    }
+  }
+  return set->pools[static_cast<size_t>(category)].get();
+}
+
+void
+katana::SetArrowBackingMemoryPool(arrow::MemoryPool* pool) {
+  std::lock_guard<std::mutex> lock(pools_mutex);
+  current_pools.store(
+      FindOrMakePoolSet(pool ? pool : arrow::default_memory_pool()),
+      std::memory_order_release);
+}
@@ -0,0 +1,119 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "katana/HostCommBackend.h"
+#include "katana/Logging.h"
+
+namespace {
+
+constexpr uint32_t kNumTasks = 4;
+
+void
+TestBroadcast(katana::CommBackend* comm) {
+  KATANA_LOG_ASSERT(comm->Broadcast(1, comm->Rank == 1));
+  KATANA_LOG_ASSERT(!comm->Broadcast(2, comm->Rank != 2));
+
+  std::string hello =
+      comm->Broadcast(3, fmt::format("hello {}", comm->Rank), 7);
+  KATANA_LOG_ASSERT(hello == "hello 3");
+}
+
+void
+TestAllGather(katana::CommBackend* comm) {
+  std::vector<uint32_t> ranks = comm->AllGather(comm->Rank).value();
+  KATANA_LOG_ASSERT(ranks.size() == comm->Num);
+  for (uint32_t task = 0; task < comm->Num; ++task) {
+    KATANA_LOG_ASSERT(ranks[task] == task);
+  }
+}
+
+void
+TestAllReduce(katana::CommBackend* comm) {
+  uint64_t sum = comm->AllReduce<uint64_t>(comm->Rank + 1).value();
+  KATANA_LOG_ASSERT(sum == comm->Num * (comm->Num + 1) / 2);
+
+  std::vector<double> values{1.0 * comm->Rank, -1.0 * comm->Rank};
+  auto max = [](double a, double b) { return std::max(a, b); };
+  KATANA_LOG_ASSERT(comm->AllReduce(values.data(), values.size(), max));
+  KATANA_LOG_ASSERT(values[0] == comm->Num - 1);
+  KATANA_LOG_ASSERT(values[1] == 0);
+}
+
+/// Task i sends (i + 1) * size values to task j, all equal to i * Num + j
+void
+TestAllToAllV(katana::CommBackend* comm, size_t size) {
+  std::vector<std::vector<uint64_t>> send(comm->Num);
+  for (uint32_t task = 0; task < comm->Num; ++task) {
+    send[task].assign((comm->Rank + 1) * size, comm->Rank * comm->Num + task);
+  }
+  auto recv = comm->AllToAllV(send).value();
+  KATANA_LOG_ASSERT(recv.size() == comm->Num);
+  for (uint32_t task = 0; task < comm->Num; ++task) {
+    KATANA_LOG_ASSERT(recv[task].size() == (task + 1) * size);
+    for (uint64_t value : recv[task]) {
+      KATANA_LOG_ASSERT(value == task * comm->Num + comm->Rank);
+    }
+  }
+}
+
+void
+RunTask(const std::string& name, uint32_t rank) {
+  auto comm = katana::HostCommBackend::Make(name, kNumTasks, rank).value();
+  KATANA_LOG_ASSERT(comm->Num == kNumTasks);
+  KATANA_LOG_ASSERT(comm->Rank == rank);
+
+  comm->Barrier();
+  TestBroadcast(comm.get());
+  TestAllGather(comm.get());
+  TestAllReduce(comm.get());
+  TestAllToAllV(comm.get(), 0);
+  TestAllToAllV(comm.get(), 3);
+  // Larger than the initial staging segments
+  TestAllToAllV(comm.get(), 1 << 16);
+  TestAllToAllV(comm.get(), 5);
+  comm->Barrier();
+}
+
+}  // namespace
+
+int
+main() {
+  std::string name = fmt::format("/katana-host-comm-backend-{}", getpid());
+
+  std::vector<pid_t> children;
+  for (uint32_t rank = 1; rank < kNumTasks; ++rank) {
+    pid_t child = fork();
+    KATANA_LOG_ASSERT(child >= 0);
+    if (child == 0) {
+      RunTask(name, rank);
+      _exit(0);
+    }
+    children.emplace_back(child);
+  }
+  RunTask(name, 0);
+
+  for (pid_t child : children) {
+    int status = 0;
+    KATANA_LOG_ASSERT(waitpid(child, &status, 0) == child);
+    KATANA_LOG_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  // The names are gone once all tasks started
+  KATANA_LOG_ASSERT(access(("/dev/shm" + name).c_str(), F_OK) != 0);
+
+  // A lone task gives up waiting for the others
+  auto lonely = katana::HostCommBackend::Make(
+      name, 2, 1, std::chrono::milliseconds(10));
+  KATANA_LOG_ASSERT(!lonely);
+
+  katana::NullCommBackend null_comm;
+  TestAllGather(&null_comm);
+  TestAllReduce(&null_comm);
+  TestAllToAllV(&null_comm, 3);
+
+  return 0;
+}
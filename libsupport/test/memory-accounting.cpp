@@ -0,0 +1,103 @@
+#include "katana/MemoryAccounting.h"
+
+#include <arrow/buffer.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+
+namespace {
+
+constexpr uint64_t kLimit = 1 << 20;
+
+void
+TestLimits() {
+  auto category = katana::MemoryCategory::kIndexes;
+  uint64_t used = katana::GetMemoryUsed(category);
+
+  katana::SetMemoryLimit(category, used + kLimit);
+  KATANA_LOG_ASSERT(katana::ReserveMemory(category, kLimit));
+  auto res = katana::ReserveMemory(category, 1);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == katana::ErrorCode::OutOfMemory);
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used + kLimit);
+  KATANA_LOG_ASSERT(katana::GetPeakMemoryUsed(category) >= used + kLimit);
+
+  // Charges ignore limits
+  katana::ChargeMemory(category, 1);
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used + kLimit + 1);
+
+  katana::ReleaseMemory(category, kLimit + 1);
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used);
+  katana::SetMemoryLimit(category, katana::kNoMemoryLimit);
+
+  uint64_t total = katana::GetTotalMemoryUsed();
+  katana::SetTotalMemoryLimit(total + kLimit);
+  KATANA_LOG_ASSERT(!katana::ReserveMemory(category, kLimit + 1));
+  KATANA_LOG_ASSERT(katana::GetTotalMemoryUsed() == total);
+  katana::SetTotalMemoryLimit(katana::kNoMemoryLimit);
+}
+
+void
+TestScope() {
+  KATANA_LOG_ASSERT(
+      katana::CurrentMemoryCategory() == katana::MemoryCategory::kOther);
+  {
+    katana::MemoryCategoryScope outer(katana::MemoryCategory::kViews);
+    {
+      katana::MemoryCategoryScope inner(katana::MemoryCategory::kTopology);
+      KATANA_LOG_ASSERT(
+          katana::CurrentMemoryCategory() == katana::MemoryCategory::kTopology);
+    }
+    KATANA_LOG_ASSERT(
+        katana::CurrentMemoryCategory() == katana::MemoryCategory::kViews);
+  }
+  KATANA_LOG_ASSERT(
+      katana::CurrentMemoryCategory() == katana::MemoryCategory::kOther);
+}
+
+void
+TestArrowPool() {
+  auto category = katana::MemoryCategory::kProperties;
+  arrow::MemoryPool* pool = katana::GetArrowMemoryPool(category);
+  uint64_t used = katana::GetMemoryUsed(category);
+
+  {
+    auto buffer = arrow::AllocateResizableBuffer(kLimit, pool).ValueOrDie();
+    KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) >= used + kLimit);
+    KATANA_LOG_ASSERT(pool->bytes_allocated() >= int64_t{kLimit});
+
+    KATANA_LOG_ASSERT(buffer->Resize(2 * kLimit).ok());
+    KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) >= used + 2 * kLimit);
+
+    // Limits turn into arrow out of memory errors
+    katana::SetMemoryLimit(category, katana::GetMemoryUsed(category));
+    auto status = buffer->Resize(4 * kLimit);
+    KATANA_LOG_ASSERT(status.IsOutOfMemory());
+    KATANA_LOG_ASSERT(arrow::AllocateBuffer(1, pool).status().IsOutOfMemory());
+    katana::SetMemoryLimit(category, katana::kNoMemoryLimit);
+  }
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used);
+  KATANA_LOG_ASSERT(pool->bytes_allocated() == 0);
+
+  // Buffers are returned to the pool they came from after the backing pool
+  // changes
+  auto buffer = arrow::AllocateBuffer(kLimit, pool).ValueOrDie();
+  katana::SetArrowBackingMemoryPool(arrow::system_memory_pool());
+  KATANA_LOG_ASSERT(katana::GetArrowMemoryPool(category) != pool);
+  buffer.reset();
+  KATANA_LOG_ASSERT(katana::GetMemoryUsed(category) == used);
+
+  katana::SetArrowBackingMemoryPool(nullptr);
+  KATANA_LOG_ASSERT(katana::GetArrowMemoryPool(category) == pool);
+}
+
+}  // namespace
+
+int
+main() {
+  TestLimits();
+  TestScope();
+  TestArrowPool();
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include "katana/Sha256.h"
+
+#include <string>
+
+#include "katana/Logging.h"
+
+namespace {
+
+void
+TestVectors() {
+  // Examples from FIPS 180-4 and NIST
+  KATANA_LOG_ASSERT(
+      katana::Sha256::HexDigest("") ==
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  KATANA_LOG_ASSERT(
+      katana::Sha256::HexDigest("abc") ==
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  KATANA_LOG_ASSERT(
+      katana::Sha256::HexDigest(
+          "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+  std::string million_a(1000000, 'a');
+  KATANA_LOG_ASSERT(
+      katana::Sha256::HexDigest(million_a) ==
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+/// Splitting the input across calls to Update does not change the digest
+void
+TestIncremental() {
+  std::string data;
+  for (size_t i = 0; i < 1000; ++i) {
+    data.push_back(static_cast<char>(i * 31));
+  }
+  std::string expected = katana::Sha256::HexDigest(data);
+
+  for (size_t split : {1, 55, 56, 63, 64, 65, 128, 999}) {
+    katana::Sha256 sha;
+    sha.Update(std::string_view(data).substr(0, split));
+    sha.Update(std::string_view(data).substr(split));
+    katana::Sha256::Digest digest = sha.Finish();
+
+    katana::Sha256 whole;
+    whole.Update(data);
+    KATANA_LOG_VASSERT(
+        digest == whole.Finish(), "digest changed by split at {}", split);
+  }
+  KATANA_LOG_ASSERT(expected.size() == 2 * katana::Sha256::kDigestSize);
+}
+
+}  // namespace
+
+int
+main() {
+  TestVectors();
+  TestIncremental();
+  return 0;
+}
@@ -9,6 +9,7 @@
 
 #include "katana/Result.h"
 #include "katana/URI.h"
+#include "tsuba/FileFrame.h"
 #include "tsuba/WriteGroup.h"
 
 namespace tsuba {
@@ -57,6 +58,12 @@ public:
   katana::Result<void> WriteToUri(
       const katana::Uri& uri, WriteGroup* group = nullptr);
 
+  /// encode the table into an unbound file frame instead of storing it, so
+  /// that the caller can choose where to store it, e.g., by its contents
+  /// \returns NotImplemented if the table is too large for one file or the
+  /// writer was made with write_blocked
+  katana::Result<std::shared_ptr<FileFrame>> WriteToFrame();
+
 private:
   ParquetWriter(
       std::vector<std::shared_ptr<arrow::Table>> tables, WriteOpts opts)
@@ -241,6 +241,10 @@ public:
   /// Remove all edge properties
   void DropEdgeProperties();
 
+  /// Replace all node and edge properties with those of other, which is left
+  /// without any. The properties are stored anew by the next Store.
+  void TakeProperties(RDG* other);
+
   /// Remove topology data
   katana::Result<void> DropAllTopologies();
 
@@ -272,6 +276,18 @@ public:
   const PartitionMetadata& part_metadata() const;
   void set_part_metadata(const PartitionMetadata& metadata);
 
+  /// Statistics about the graph saved with it, null if there are none. They
+  /// are written with the rest of the part metadata by Store.
+  const nlohmann::json& graph_statistics() const;
+  void set_graph_statistics(nlohmann::json graph_statistics);
+
+  /// Whether Store names the files it writes by their contents, so that
+  /// versions and views of the graph in one directory share the files whose
+  /// contents did not change. The setting is saved with the graph; see
+  /// CollectGarbage for deleting the files no version refers to anymore.
+  bool content_addressed() const;
+  void set_content_addressed(bool content_addressed);
+
   const FileView& topology_file_storage() const;
 
   const FileView& node_entity_type_id_array_file_storage() const;
@@ -207,8 +207,11 @@ public:
   katana::Result<void> MapMetadataExtract(
       uint64_t num_nodes, uint64_t num_edges, bool storage_valid = false);
 
+  /// Store the topology if it changed or the graph is being stored in a new
+  /// location; with content_addressed, the file is named by its contents
   katana::Result<void> DoStore(
-      RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group);
+      RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group,
+      bool content_addressed);
 
   bool Equals(const RDGTopology& other) const;
 
@@ -0,0 +1,97 @@
+#ifndef KATANA_LIBTSUBA_TSUBA_SHAREDMEMORY_H_
+#define KATANA_LIBTSUBA_TSUBA_SHAREDMEMORY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace tsuba {
+
+/// A named POSIX shared memory segment that one process fills and other
+/// processes on the same machine map read only.
+///
+/// Unlike FileView and FileFrame, which copy file contents into private
+/// anonymous memory, the pages of a segment are mapped MAP_SHARED, so every
+/// process that opens the segment uses the same physical memory.
+///
+/// The creating process writes the contents through data() and then calls
+/// Seal(), after which the contents are read only in every process. Open()
+/// fails on segments that are not sealed yet. Each SharedMemory object is
+/// counted in num_attached() until it is destroyed. The count is not
+/// decremented for processes that exit without running destructors.
+///
+/// The name of a segment stays in the system until Unlink() is called, even
+/// after every process detaches. Unlinking only removes the name; processes
+/// that have the segment mapped keep using it.
+class KATANA_EXPORT SharedMemory {
+public:
+  SharedMemory(const SharedMemory&) = delete;
+  SharedMemory& operator=(const SharedMemory&) = delete;
+  SharedMemory(SharedMemory&&) = delete;
+  SharedMemory& operator=(SharedMemory&&) = delete;
+
+  ~SharedMemory();
+
+  /// Create a new segment with size bytes of writable contents.
+  ///
+  /// \param name the name of the segment, "/" followed by up to 254
+  ///     characters other than "/"; fails if the name already exists
+  static katana::Result<std::unique_ptr<SharedMemory>> Create(
+      const std::string& name, uint64_t size);
+
+  /// Map a sealed segment created by another process read only
+  static katana::Result<std::unique_ptr<SharedMemory>> Open(
+      const std::string& name);
+
+  /// Remove the name of a segment
+  static katana::Result<void> Unlink(const std::string& name);
+
+  /// Make the contents read only and allow other processes to Open() the
+  /// segment. Only the creator can seal a segment.
+  katana::Result<void> Seal();
+
+  const std::string& name() const { return name_; }
+
+  /// The size of the contents in bytes
+  uint64_t size() const { return size_; }
+
+  /// The contents, page aligned; writable only in the creator before Seal()
+  uint8_t* data() { return map_start_ + header_size_; }
+  const uint8_t* data() const { return map_start_ + header_size_; }
+
+  bool sealed() const;
+
+  /// The number of SharedMemory objects, in all processes, that have the
+  /// segment mapped
+  uint64_t num_attached() const;
+
+private:
+  struct Header;
+
+  SharedMemory(
+      std::string name, uint8_t* map_start, uint64_t map_size,
+      uint64_t header_size, uint64_t size, bool creator)
+      : name_(std::move(name)),
+        map_start_(map_start),
+        map_size_(map_size),
+        header_size_(header_size),
+        size_(size),
+        creator_(creator) {}
+
+  Header* header() const;
+
+  std::string name_;
+  uint8_t* map_start_;
+  uint64_t map_size_;
+  uint64_t header_size_;
+  uint64_t size_;
+  bool creator_;
+};
+
+}  // namespace tsuba
+
+#endif
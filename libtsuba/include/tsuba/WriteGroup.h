@@ -48,6 +48,12 @@ public:
     AddOp(FileStoreAsync(file, buf, size), file);
   }
 
+  /// Start async copy of the first size bytes of source_file into dest_file,
+  /// without a round trip through memory if the storage allows it
+  void StartCopy(
+      const std::string& source_file, const std::string& dest_file,
+      uint64_t size);
+
   void AddToOutstanding(uint64_t size) { outstanding_size_ += size; }
 
   /// Add future to the list of futures this descriptor will wait for, note
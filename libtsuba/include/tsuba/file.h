@@ -59,9 +59,10 @@ FileStore(const std::string& uri, const ContigContainer& container) {
 /// Copy a slice of a file from source_uri into dest_uri
 /// using a remote operation (avoiding a roundt rip through memory) if possible.
 /// The slice starts at \param begin and extends \param size bytes.
-/// The caller is responsible for ensuring that the slice is valid. This
-/// operation is only well defined if source_uri and dest_uri
-/// map to the (i.e., one of: s3, gs, azure blob store, or local file system)
+/// The caller is responsible for ensuring that the slice is valid. When
+/// source_uri and dest_uri map to the same back-end (i.e., one of: s3, gs,
+/// azure blob store, or local file system) the back-end copies the slice
+/// itself; otherwise it is read into memory and stored at dest_uri.
 ///
 /// \param source_uri source URI
 /// \param dest_uri destination URI
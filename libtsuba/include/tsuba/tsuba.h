@@ -126,6 +126,18 @@ CreateSrcDestFromViewsForCopy(
 KATANA_EXPORT katana::Result<void> CopyRDG(
     std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files);
 
+/// CollectGarbage deletes the content addressed files in an RDG directory
+/// that no manifest there refers to, e.g., after the manifests of old
+/// versions were deleted. See RDG::set_content_addressed.
+///
+/// It must be called by one host, and not while the RDG is being stored:
+/// a store does not write a file whose contents are already in the
+/// directory, but the file is not referred to until the store commits.
+/// \param rdg_dir is the RDG's URI prefix
+/// \returns the number of files deleted
+KATANA_EXPORT katana::Result<uint64_t> CollectGarbage(
+    const std::string& rdg_dir);
+
 // Setup and tear down
 KATANA_EXPORT katana::Result<void> Init(katana::CommBackend* comm);
 KATANA_EXPORT katana::Result<void> Init();
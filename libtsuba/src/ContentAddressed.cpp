@@ -0,0 +1,92 @@
+#include "ContentAddressed.h"
+
+#include <regex>
+
+#include "katana/Logging.h"
+#include "katana/Sha256.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FaultTest.h"
+#include "tsuba/file.h"
+
+namespace {
+
+const std::regex kContentAddressedFile("blob_[0-9a-f]{64}");
+
+/// \returns true if there is a file of the given size at uri. A file of the
+/// right name but another size was left by a store that did not finish, and
+/// is overwritten.
+bool
+IsStored(const katana::Uri& uri, uint64_t size) {
+  tsuba::StatBuf stat_buf;
+  if (auto res = tsuba::FileStat(uri.string(), &stat_buf); !res) {
+    return false;
+  }
+  return stat_buf.size == size;
+}
+
+}  // namespace
+
+std::string
+tsuba::ContentAddressedName(const void* data, uint64_t size) {
+  return "blob_" + katana::Sha256::HexDigest(data, size);
+}
+
+katana::Result<std::string>
+tsuba::ContentAddressedName(const FileFrame& ff) {
+  auto size = ff.Tell();
+  if (!size.ok()) {
+    return KATANA_ERROR(
+        ArrowToTsuba(size.status().code()), "arrow error: {}", size.status());
+  }
+  return ContentAddressedName(KATANA_CHECKED(ff.ptr<uint8_t>()), *size);
+}
+
+bool
+tsuba::IsContentAddressedName(const std::string& name) {
+  return std::regex_match(name, kContentAddressedFile);
+}
+
+bool
+tsuba::IsContentAddressedFile(const std::string& file) {
+  return IsContentAddressedName(file.substr(file.find_last_of('/') + 1));
+}
+
+katana::Result<void>
+tsuba::StoreContentAddressed(
+    std::shared_ptr<FileFrame> ff, const std::string& name,
+    const katana::Uri& dir, WriteGroup* desc) {
+  katana::Uri path = dir.Join(name);
+  auto size = ff->Tell();
+  if (size.ok() && IsStored(path, *size)) {
+    KATANA_LOG_DEBUG("{} is already stored", path);
+    return katana::ResultSuccess();
+  }
+
+  ff->Bind(path.string());
+  TSUBA_PTP(internal::FaultSensitivity::Normal);
+  desc->StartStore(std::move(ff));
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::string>
+tsuba::StoreContentAddressed(
+    std::shared_ptr<FileFrame> ff, const katana::Uri& dir, WriteGroup* desc) {
+  std::string name = KATANA_CHECKED(ContentAddressedName(*ff));
+  KATANA_CHECKED(StoreContentAddressed(std::move(ff), name, dir, desc));
+  return name;
+}
+
+katana::Result<std::string>
+tsuba::CopyContentAddressed(
+    const std::string& source_file, uint64_t size, const katana::Uri& dir,
+    WriteGroup* desc) {
+  KATANA_LOG_DEBUG_ASSERT(IsContentAddressedFile(source_file));
+  std::string name = source_file.substr(source_file.find_last_of('/') + 1);
+
+  katana::Uri path = dir.Join(name);
+  if (!IsStored(path, size)) {
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    desc->StartCopy(source_file, path.string(), size);
+  }
+  return name;
+}
@@ -0,0 +1,54 @@
+#ifndef KATANA_LIBTSUBA_CONTENTADDRESSED_H_
+#define KATANA_LIBTSUBA_CONTENTADDRESSED_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "tsuba/FileFrame.h"
+#include "tsuba/WriteGroup.h"
+
+namespace tsuba {
+
+/// Content addressed files are named by the SHA-256 of their contents, so
+/// the files of an RDG that do not change between versions, or are the same
+/// in several views, are stored once in the RDG directory and shared by all
+/// the part headers that refer to them. They are never modified once
+/// written; CollectGarbage deletes the ones no manifest refers to anymore.
+
+/// \returns the name of a content addressed file holding the first size
+/// bytes of data
+std::string ContentAddressedName(const void* data, uint64_t size);
+
+/// \returns the name of a content addressed file holding what was written
+/// to ff
+katana::Result<std::string> ContentAddressedName(const FileFrame& ff);
+
+bool IsContentAddressedName(const std::string& name);
+
+/// \returns true if file, a path or URI, is a content addressed file
+bool IsContentAddressedFile(const std::string& file);
+
+/// Start storing ff as the file name in dir unless a file of that name and
+/// size is already there, in which case ff is dropped
+katana::Result<void> StoreContentAddressed(
+    std::shared_ptr<FileFrame> ff, const std::string& name,
+    const katana::Uri& dir, WriteGroup* desc);
+
+/// Hash ff and start storing it in dir as with StoreContentAddressed
+/// \returns the name it is stored under
+katana::Result<std::string> StoreContentAddressed(
+    std::shared_ptr<FileFrame> ff, const katana::Uri& dir, WriteGroup* desc);
+
+/// Start copying source_file, a content addressed file of the given size,
+/// into dir under the same name unless it is already there
+/// \returns the name it is stored under
+katana::Result<std::string> CopyContentAddressed(
+    const std::string& source_file, uint64_t size, const katana::Uri& dir,
+    WriteGroup* desc);
+
+}  // namespace tsuba
+
+#endif
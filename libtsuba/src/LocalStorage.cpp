@@ -2,19 +2,25 @@
 
 #include <dirent.h>
 #include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/system/error_code.hpp>
 
 #include "GlobalState.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "katana/URI.h"
@@ -41,6 +47,155 @@ EnsureDirectories(const std::string& uri) {
   return katana::ResultSuccess();
 }
 
+/// When the kernel cannot copy a file itself, larger files are split into
+/// chunks of this size that are copied by several threads
+constexpr uint64_t kParallelCopyChunkSize = 64ULL << 20;
+constexpr uint64_t kCopyBufferSize = 1ULL << 20;
+
+/// Closes a file descriptor when it goes out of scope
+class FileDescriptor {
+public:
+  explicit FileDescriptor(int fd) : fd_(fd) {}
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  int get() const { return fd_; }
+
+  void Reset(int fd) {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+    fd_ = fd;
+  }
+
+private:
+  int fd_;
+};
+
+/// Files written through LocalStorage are never modified in place (see
+/// WriteFile), so whole file copies may share the source's inode when
+/// KATANA_LOCAL_STORAGE_HARDLINKS is set and reflinks are not supported
+bool
+UseHardLinks() {
+  bool use = false;
+  return katana::GetEnv("KATANA_LOCAL_STORAGE_HARDLINKS", &use) && use;
+}
+
+/// Share the blocks of in with out on file systems that support copy on
+/// write (btrfs, XFS with reflink, ...)
+///
+/// \returns false if the file system does not support it
+bool
+TryReflink([[maybe_unused]] int in, [[maybe_unused]] int out) {
+#ifdef FICLONE
+  return ioctl(out, FICLONE, in) == 0;
+#else
+  return false;
+#endif
+}
+
+/// Copy with copy_file_range, which stays in the kernel and may itself
+/// share blocks or copy on the server for network file systems
+///
+/// \returns false, having copied nothing, if the kernel cannot copy between
+/// these files
+katana::Result<bool>
+TryCopyFileRange(int in, int out, uint64_t begin, uint64_t size) {
+  loff_t in_off = begin;
+  loff_t out_off = 0;
+  while (size > 0) {
+    ssize_t copied = copy_file_range(in, &in_off, out, &out_off, size, 0);
+    if (copied < 0) {
+      if (out_off == 0 && (errno == ENOSYS || errno == EXDEV ||
+                           errno == EINVAL || errno == EOPNOTSUPP)) {
+        return false;
+      }
+      return KATANA_ERROR(katana::ResultErrno(), "copy_file_range");
+    }
+    if (copied == 0) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::LocalStorageError, "source file ended early");
+    }
+    size -= copied;
+  }
+  return true;
+}
+
+/// Copy [begin, end) of in to the same range of out, less out_shift
+katana::Result<void>
+CopyBytes(int in, int out, uint64_t begin, uint64_t end, uint64_t out_shift) {
+  std::vector<char> buf(std::min(kCopyBufferSize, end - begin));
+  while (begin < end) {
+    uint64_t num_bytes = std::min<uint64_t>(buf.size(), end - begin);
+    ssize_t num_read = pread(in, buf.data(), num_bytes, begin);
+    if (num_read < 0) {
+      return KATANA_ERROR(katana::ResultErrno(), "reading source file");
+    }
+    if (num_read == 0) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::LocalStorageError, "source file ended early");
+    }
+    for (ssize_t written = 0; written < num_read;) {
+      ssize_t ret = pwrite(
+          out, buf.data() + written, num_read - written,
+          begin + written - out_shift);
+      if (ret < 0) {
+        return KATANA_ERROR(katana::ResultErrno(), "writing dest file");
+      }
+      written += ret;
+    }
+    begin += num_read;
+  }
+  return katana::ResultSuccess();
+}
+
+/// Copy through user space, splitting large files into chunks that are
+/// copied by several threads
+katana::Result<void>
+CopyInParallel(int in, int out, uint64_t begin, uint64_t size) {
+  uint64_t num_chunks =
+      (size + kParallelCopyChunkSize - 1) / kParallelCopyChunkSize;
+  uint64_t num_tasks = std::min<uint64_t>(
+      num_chunks, std::max(1U, std::thread::hardware_concurrency()));
+  if (num_tasks <= 1) {
+    return CopyBytes(in, out, begin, begin + size, begin);
+  }
+
+  // Task t copies chunks t, t + num_tasks, ...
+  std::vector<std::future<katana::CopyableResult<void>>> tasks;
+  for (uint64_t t = 0; t < num_tasks; ++t) {
+    tasks.emplace_back(std::async(
+        std::launch::async, [=]() -> katana::CopyableResult<void> {
+          for (uint64_t c = t; c < num_chunks; c += num_tasks) {
+            uint64_t chunk_begin = begin + c * kParallelCopyChunkSize;
+            uint64_t chunk_end =
+                std::min(chunk_begin + kParallelCopyChunkSize, begin + size);
+            if (auto res = CopyBytes(in, out, chunk_begin, chunk_end, begin);
+                !res) {
+              return katana::CopyableErrorInfo{res.error()};
+            }
+          }
+          return katana::CopyableResultSuccess();
+        }));
+  }
+
+  katana::CopyableResult<void> result = katana::CopyableResultSuccess();
+  for (auto& task : tasks) {
+    if (auto res = task.get(); !res && result) {
+      result = res;
+    }
+  }
+  if (!result) {
+    return result.error();
+  }
+  return katana::ResultSuccess();
+}
+
 }  // namespace
 
 void
@@ -57,6 +212,13 @@ tsuba::LocalStorage::WriteFile(
   CleanUri(&uri);
   KATANA_CHECKED(EnsureDirectories(uri));
 
+  // Replace rather than truncate the file, which may share its inode with
+  // another version (see RemoteCopyFile)
+  if (unlink(uri.c_str()) != 0 && errno != ENOENT) {
+    return KATANA_ERROR(
+        ErrorCode::LocalStorageError, "removing old file: {}",
+        strerror(errno));
+  }
   std::ofstream ofile(uri);
   if (!ofile.good()) {
     return KATANA_ERROR(
@@ -78,23 +240,62 @@ tsuba::LocalStorage::RemoteCopyFile(
 
   KATANA_CHECKED(EnsureDirectories(dest_uri));
 
-  std::ifstream ifile(source_uri, std::ios_base::binary);
-  if (!ifile) {
+  FileDescriptor in(open(source_uri.c_str(), O_RDONLY | O_CLOEXEC));
+  if (in.get() < 0) {
     return KATANA_ERROR(
-        ErrorCode::LocalStorageError, "failed to open source file");
+        ErrorCode::LocalStorageError, "failed to open source file: {}",
+        strerror(errno));
   }
-  ifile.seekg(begin, std::ios_base::beg);
-
-  std::ofstream ofile(dest_uri, std::ios_base::binary | std::ios_base::trunc);
-  if (!ofile) {
+  struct stat in_stat;
+  if (fstat(in.get(), &in_stat) != 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "stat of source file");
+  }
+  uint64_t file_size = in_stat.st_size;
+  if (begin > file_size || size > file_size - begin) {
     return KATANA_ERROR(
-        ErrorCode::LocalStorageError, "failed to open dest file");
+        ErrorCode::InvalidArgument,
+        "copying [{}, {}) of a file of {} bytes", begin, begin + size,
+        file_size);
   }
+  bool whole_file = begin == 0 && size == file_size;
+
+  // The destination is replaced, never overwritten in place, in case it
+  // shares its inode with another file
+  auto replace_dest = [&dest_uri]() -> katana::Result<int> {
+    if (unlink(dest_uri.c_str()) != 0 && errno != ENOENT) {
+      return KATANA_ERROR(
+          ErrorCode::LocalStorageError, "removing old dest file: {}",
+          strerror(errno));
+    }
+    int fd =
+        open(dest_uri.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      return KATANA_ERROR(
+          ErrorCode::LocalStorageError, "failed to open dest file: {}",
+          strerror(errno));
+    }
+    return fd;
+  };
+  FileDescriptor out(KATANA_CHECKED(replace_dest()));
 
-  std::copy_n(
-      std::istreambuf_iterator<char>(ifile), size,
-      std::ostreambuf_iterator<char>(ofile));
-  return katana::ResultSuccess();
+  if (whole_file) {
+    if (TryReflink(in.get(), out.get())) {
+      return katana::ResultSuccess();
+    }
+    if (UseHardLinks()) {
+      out.Reset(-1);
+      if (unlink(dest_uri.c_str()) == 0 &&
+          link(source_uri.c_str(), dest_uri.c_str()) == 0) {
+        return katana::ResultSuccess();
+      }
+      out.Reset(KATANA_CHECKED(replace_dest()));
+    }
+  }
+
+  if (KATANA_CHECKED(TryCopyFileRange(in.get(), out.get(), begin, size))) {
+    return katana::ResultSuccess();
+  }
+  return CopyInParallel(in.get(), out.get(), begin, size);
 }
 
 katana::Result<void>
@@ -21,6 +21,8 @@ class LocalStorage : public FileStorage {
       std::string, const uint8_t* data, uint64_t size);
   katana::Result<void> ReadFile(
       std::string uri, uint64_t start, uint64_t size, uint8_t* data);
+  /// Copy with a reflink, a hard link (if enabled), copy_file_range or
+  /// parallel reads and writes, the first that works
   katana::Result<void> RemoteCopyFile(
       std::string source_uri, std::string dest_uri, uint64_t begin,
       uint64_t size);
@@ -12,6 +12,7 @@
 #include <parquet/arrow/schema.h>
 
 #include "katana/JSON.h"
+#include "katana/MemoryAccounting.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
 
@@ -68,8 +69,9 @@ BuildReader(
   *fv = fv_tmp;
 
   std::unique_ptr<parquet::arrow::FileReader> reader;
-  KATANA_CHECKED(
-      parquet::arrow::OpenFile(fv_tmp, arrow::default_memory_pool(), &reader));
+  KATANA_CHECKED(parquet::arrow::OpenFile(
+      fv_tmp, katana::GetArrowMemoryPool(katana::MemoryCategory::kProperties),
+      &reader));
 
   return std::unique_ptr<parquet::arrow::FileReader>(std::move(reader));
 }
@@ -465,7 +467,8 @@ tsuba::ParquetReader::FixTable(std::shared_ptr<arrow::Table>&& _table) {
   // combined into a single chunk due to the fact the offset type for these
   // columns is int32_t and thus the maximum size of an arrow::Array for these
   // types is 2^31.
-  table = KATANA_CHECKED(table->CombineChunks(arrow::default_memory_pool()));
+  table = KATANA_CHECKED(table->CombineChunks(
+      katana::GetArrowMemoryPool(katana::MemoryCategory::kProperties)));
 
   // lots of the code base assumes chunks will exist, but arrow allows zero length
   // chunked arrays to have zero chunks. Let's be helpful.
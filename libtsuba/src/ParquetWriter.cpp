@@ -137,6 +137,32 @@ tsuba::ParquetWriter::WriteToUri(const katana::Uri& uri, WriteGroup* group) {
   }
 }
 
+katana::Result<std::shared_ptr<tsuba::FileFrame>>
+tsuba::ParquetWriter::WriteToFrame() {
+  if (tables_.size() != 1 || tables_[0]->num_rows() > kMaxRowsPerFile) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::NotImplemented,
+        "table must be stored in more than one file");
+  }
+
+  auto ff = std::make_shared<tsuba::FileFrame>();
+  KATANA_CHECKED(ff->Init());
+  try {
+    auto write_result = parquet::arrow::WriteTable(
+        *tables_[0], arrow::default_memory_pool(), ff,
+        std::numeric_limits<int64_t>::max(), StandardWriterProperties(),
+        StandardArrowProperties());
+    if (!write_result.ok()) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::ArrowError, "arrow error: {}", write_result);
+    }
+  } catch (const std::exception& exp) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::ArrowError, "arrow exception: {}", exp.what());
+  }
+  return ff;
+}
+
 std::shared_ptr<parquet::WriterProperties>
 tsuba::ParquetWriter::StandardWriterProperties() {
   return parquet::WriterProperties::Builder()
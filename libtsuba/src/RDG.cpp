@@ -1,12 +1,16 @@
 #include "tsuba/RDG.h"
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <regex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -23,6 +27,7 @@
 #include <parquet/properties.h>
 
 #include "AddProperties.h"
+#include "ContentAddressed.h"
 #include "GlobalState.h"
 #include "RDGCore.h"
 #include "RDGHandleImpl.h"
@@ -63,24 +68,99 @@ StoreArrowArrayAtName(
   return new_path.BaseName();
 }
 
+/// A property encoded for content addressed storage; ff is null if the
+/// property has to be stored in more than one file
+struct EncodedProperty {
+  std::shared_ptr<tsuba::FileFrame> ff;
+  std::string name;
+};
+
+katana::Result<EncodedProperty>
+EncodeProperty(
+    const std::shared_ptr<arrow::ChunkedArray>& array,
+    const std::string& name) {
+  auto writer = KATANA_CHECKED(tsuba::ParquetWriter::Make(array, name));
+  auto ff_res = writer->WriteToFrame();
+  if (!ff_res) {
+    if (ff_res.error() == tsuba::ErrorCode::NotImplemented) {
+      return EncodedProperty{};
+    }
+    return ff_res.error().WithContext("encoding {}", name);
+  }
+  std::shared_ptr<tsuba::FileFrame> ff = std::move(ff_res.value());
+  std::string blob_name = KATANA_CHECKED(tsuba::ContentAddressedName(*ff));
+  return EncodedProperty{std::move(ff), std::move(blob_name)};
+}
+
+/// Properties are encoded by at most this many tasks at a time, so that at
+/// most this many encoded frames wait to be handed to the WriteGroup
+size_t
+MaxConcurrentEncodings() {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// A property whose encoding has been started
+struct PendingEncoding {
+  size_t index;
+  std::string name;
+  std::future<katana::Result<EncodedProperty>> encoded;
+};
+
+/// Write the dirty properties. With content_addressed, properties are
+/// encoded and hashed by a bounded number of tasks, each one is stored as soon
+/// as it is hashed, and only the ones whose contents are not already in dir
+/// are stored.
 katana::Result<void>
 WriteProperties(
     const arrow::Table& props, std::vector<tsuba::PropStorageInfo*> prop_info,
-    const katana::Uri& dir, tsuba::WriteGroup* desc) {
+    const katana::Uri& dir, tsuba::WriteGroup* desc, bool content_addressed) {
   const auto& schema = props.schema();
 
-  std::vector<std::string> next_paths;
+  // The WriteGroup is not thread safe, so encodings are stored from here,
+  // oldest first
+  std::deque<PendingEncoding> pending;
+  auto store_oldest = [&]() -> katana::Result<void> {
+    PendingEncoding oldest = std::move(pending.front());
+    pending.pop_front();
+    EncodedProperty encoded = KATANA_CHECKED(oldest.encoded.get());
+    std::string path;
+    if (encoded.ff) {
+      KATANA_CHECKED(tsuba::StoreContentAddressed(
+          std::move(encoded.ff), encoded.name, dir, desc));
+      path = encoded.name;
+    } else {
+      path = KATANA_CHECKED(StoreArrowArrayAtName(
+          props.column(oldest.index), dir, oldest.name, desc));
+    }
+    prop_info[oldest.index]->WasWritten(path);
+    return katana::ResultSuccess();
+  };
+
+  size_t max_pending = MaxConcurrentEncodings();
   for (size_t i = 0, n = prop_info.size(); i < n; ++i) {
     if (!prop_info[i]->IsDirty()) {
       continue;
     }
     std::string name = prop_info[i]->name().empty() ? schema->field(i)->name()
                                                     : prop_info[i]->name();
+    if (content_addressed) {
+      if (pending.size() == max_pending) {
+        KATANA_CHECKED(store_oldest());
+      }
+      auto encoded = std::async(
+          std::launch::async, EncodeProperty, props.column(i), name);
+      pending.emplace_back(PendingEncoding{i, name, std::move(encoded)});
+      continue;
+    }
     std::string path =
         KATANA_CHECKED(StoreArrowArrayAtName(props.column(i), dir, name, desc));
 
     prop_info[i]->WasWritten(path);
   }
+
+  while (!pending.empty()) {
+    KATANA_CHECKED(store_oldest());
+  }
   TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
 
   return katana::ResultSuccess();
@@ -230,7 +310,13 @@ tsuba::RDG::DoStoreNodeEntityTypeIDArray(
         "node_entity_type_id_array_file_storage is invalid");
   }
 
-  if (node_entity_type_id_array_ff) {
+  if (node_entity_type_id_array_ff && content_addressed()) {
+    // we have an update, store it unless the same contents are stored
+    std::string path = KATANA_CHECKED(StoreContentAddressed(
+        std::move(node_entity_type_id_array_ff),
+        handle.impl_->rdg_manifest().dir(), write_group.get()));
+    core_->part_header().set_node_entity_type_id_array_path(path);
+  } else if (node_entity_type_id_array_ff) {
     // we have an update, store the passed in memory state
     katana::Uri path_uri = MakeNodeEntityTypeIDArrayFileName(handle);
     node_entity_type_id_array_ff->Bind(path_uri.string());
@@ -242,15 +328,20 @@ tsuba::RDG::DoStoreNodeEntityTypeIDArray(
   } else if (handle.impl_->rdg_manifest().dir() != rdg_dir()) {
     KATANA_LOG_DEBUG("persisting node_entity_type_id_array in new location");
     // we don't have an update, but we are persisting in a new location
-    // store our in memory state
+    // copy the file we were loaded from
+    const FileView& storage = core_->node_entity_type_id_array_file_storage();
+    if (content_addressed() && IsContentAddressedFile(storage.filename())) {
+      std::string path = KATANA_CHECKED(CopyContentAddressed(
+          storage.filename(), storage.size(),
+          handle.impl_->rdg_manifest().dir(), write_group.get()));
+      core_->part_header().set_node_entity_type_id_array_path(path);
+      return katana::ResultSuccess();
+    }
     katana::Uri path_uri = MakeNodeEntityTypeIDArrayFileName(handle);
 
     TSUBA_PTP(internal::FaultSensitivity::Normal);
-    // depends on `node_entity_type_id_array_` outliving writes
-    write_group->StartStore(
-        path_uri.string(),
-        core_->node_entity_type_id_array_file_storage().ptr<uint8_t>(),
-        core_->node_entity_type_id_array_file_storage().size());
+    write_group->StartCopy(
+        storage.filename(), path_uri.string(), storage.size());
     TSUBA_PTP(internal::FaultSensitivity::Normal);
     core_->part_header().set_node_entity_type_id_array_path(
         path_uri.BaseName());
@@ -278,7 +369,13 @@ tsuba::RDG::DoStoreEdgeEntityTypeIDArray(
         "edge_entity_type_id_array_file_storage is invalid");
   }
 
-  if (edge_entity_type_id_array_ff) {
+  if (edge_entity_type_id_array_ff && content_addressed()) {
+    // we have an update, store it unless the same contents are stored
+    std::string path = KATANA_CHECKED(StoreContentAddressed(
+        std::move(edge_entity_type_id_array_ff),
+        handle.impl_->rdg_manifest().dir(), write_group.get()));
+    core_->part_header().set_edge_entity_type_id_array_path(path);
+  } else if (edge_entity_type_id_array_ff) {
     // we have an update, store the passed in memory state
     katana::Uri path_uri = MakeEdgeEntityTypeIDArrayFileName(handle);
     edge_entity_type_id_array_ff->Bind(path_uri.string());
@@ -290,15 +387,20 @@ tsuba::RDG::DoStoreEdgeEntityTypeIDArray(
   } else if (handle.impl_->rdg_manifest().dir() != rdg_dir()) {
     KATANA_LOG_DEBUG("persisting edge_entity_type_id_array in new location");
     // we don't have an update, but we are persisting in a new location
-    // store our in memory state
+    // copy the file we were loaded from
+    const FileView& storage = core_->edge_entity_type_id_array_file_storage();
+    if (content_addressed() && IsContentAddressedFile(storage.filename())) {
+      std::string path = KATANA_CHECKED(CopyContentAddressed(
+          storage.filename(), storage.size(),
+          handle.impl_->rdg_manifest().dir(), write_group.get()));
+      core_->part_header().set_edge_entity_type_id_array_path(path);
+      return katana::ResultSuccess();
+    }
     katana::Uri path_uri = MakeEdgeEntityTypeIDArrayFileName(handle);
 
     TSUBA_PTP(internal::FaultSensitivity::Normal);
-    // depends on `edge_entity_type_id_array_` outliving writes
-    write_group->StartStore(
-        path_uri.string(),
-        core_->edge_entity_type_id_array_file_storage().ptr<uint8_t>(),
-        core_->edge_entity_type_id_array_file_storage().size());
+    write_group->StartCopy(
+        storage.filename(), path_uri.string(), storage.size());
     TSUBA_PTP(internal::FaultSensitivity::Normal);
     core_->part_header().set_edge_entity_type_id_array_path(
         path_uri.BaseName());
@@ -331,7 +433,8 @@ tsuba::RDG::DoStore(
   KATANA_CHECKED_CONTEXT(
       WriteProperties(
           *core_->node_properties(), node_props_to_store,
-          handle.impl_->rdg_manifest().dir(), write_group.get()),
+          handle.impl_->rdg_manifest().dir(), write_group.get(),
+          content_addressed()),
       "writing node properties");
 
   std::vector<std::string> edge_prop_names;
@@ -345,7 +448,8 @@ tsuba::RDG::DoStore(
   KATANA_CHECKED_CONTEXT(
       WriteProperties(
           *core_->edge_properties(), edge_props_to_store,
-          handle.impl_->rdg_manifest().dir(), write_group.get()),
+          handle.impl_->rdg_manifest().dir(), write_group.get(),
+          content_addressed()),
       "writing edge properties");
 
   core_->part_header().set_part_properties(KATANA_CHECKED_CONTEXT(
@@ -620,7 +724,8 @@ tsuba::RDG::Store(
   // All write buffers must outlive desc
   std::unique_ptr<WriteGroup> desc = std::move(desc_res.value());
 
-  auto res = core_->topology_manager().DoStore(handle, desc);
+  auto res =
+      core_->topology_manager().DoStore(handle, desc, content_addressed());
   if (!res) {
     return res.error();
   }
@@ -862,6 +967,26 @@ tsuba::RDG::set_part_metadata(const tsuba::PartitionMetadata& metadata) {
   core_->part_header().set_metadata(metadata);
 }
 
+const nlohmann::json&
+tsuba::RDG::graph_statistics() const {
+  return core_->part_header().graph_statistics();
+}
+
+void
+tsuba::RDG::set_graph_statistics(nlohmann::json graph_statistics) {
+  core_->part_header().set_graph_statistics(std::move(graph_statistics));
+}
+
+bool
+tsuba::RDG::content_addressed() const {
+  return core_->part_header().content_addressed();
+}
+
+void
+tsuba::RDG::set_content_addressed(bool content_addressed) {
+  core_->part_header().set_content_addressed(content_addressed);
+}
+
 const katana::Uri&
 tsuba::RDG::rdg_dir() const {
   return core_->rdg_dir();
@@ -896,6 +1021,11 @@ tsuba::RDG::DropEdgeProperties() {
   core_->drop_edge_properties();
 }
 
+void
+tsuba::RDG::TakeProperties(RDG* other) {
+  core_->TakeProperties(other->core_.get());
+}
+
 katana::Result<void>
 tsuba::RDG::DropAllTopologies() {
   return core_->UnbindAllTopologyFile();
@@ -108,6 +108,17 @@ public:
     part_header_.set_edge_prop_info_list({});
   }
 
+  void TakeProperties(RDGCore* other) {
+    node_properties_ = std::move(other->node_properties_);
+    edge_properties_ = std::move(other->edge_properties_);
+    part_header_.set_node_prop_info_list(
+        std::move(other->part_header_.node_prop_info_list()));
+    part_header_.set_edge_prop_info_list(
+        std::move(other->part_header_.edge_prop_info_list()));
+    other->drop_node_properties();
+    other->drop_edge_properties();
+  }
+
   void AddMirrorNodes(std::shared_ptr<arrow::ChunkedArray>&& a) {
     mirror_nodes_.emplace_back(std::move(a));
   }
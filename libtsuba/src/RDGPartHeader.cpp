@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "Constants.h"
+#include "ContentAddressed.h"
 #include "GlobalState.h"
 #include "PartitionTopologyMetadata.h"
 #include "RDGHandleImpl.h"
@@ -12,6 +13,7 @@
 #include "tsuba/FaultTest.h"
 #include "tsuba/FileView.h"
 #include "tsuba/RDGTopology.h"
+#include "tsuba/file.h"
 
 using json = nlohmann::json;
 
@@ -44,6 +46,10 @@ const char* kPartitionTopologyMetadataEntriesKey =
     "kg.v1.partition_topology_metadata_entries";
 const char* kPartitionTopologyMetadataEntriesSizeKey =
     "kg.v1.partition_topology_metadata_entries_size";
+// Graph statistics object, optional
+const char* kGraphStatisticsKey = "kg.v1.graph_statistics";
+// Whether files are named by their contents, optional
+const char* kContentAddressedKey = "kg.v1.content_addressed";
 
 //
 //constexpr std::string_view  mirror_nodes_prop_name = "mirror_nodes";
@@ -58,10 +64,19 @@ CopyProperty(
     const katana::Uri& new_location) {
   katana::Uri old_path = old_location.Join(prop->path());
   katana::Uri new_path = new_location.Join(prop->path());
-  tsuba::FileView fv;
-
-  KATANA_CHECKED(fv.Bind(old_path.string(), true));
-  return tsuba::FileStore(new_path.string(), fv.ptr<uint8_t>(), fv.size());
+  tsuba::StatBuf stat_buf;
+
+  KATANA_CHECKED(tsuba::FileStat(old_path.string(), &stat_buf));
+  if (prop->IsContentAddressed()) {
+    // Another version or view in new_location may already have it
+    tsuba::StatBuf new_stat_buf;
+    if (auto res = tsuba::FileStat(new_path.string(), &new_stat_buf);
+        res && new_stat_buf.size == stat_buf.size) {
+      return katana::ResultSuccess();
+    }
+  }
+  return tsuba::FileRemoteCopy(
+      old_path.string(), new_path.string(), 0, stat_buf.size);
 }
 
 }  // namespace
@@ -298,6 +313,12 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
       {kNodeEntityTypeIDNameKey, header.node_entity_type_id_name_},
       {kEdgeEntityTypeIDNameKey, header.edge_entity_type_id_name_},
       {kPartitionTopologyMetadataKey, header.topology_metadata_}};
+  if (!header.graph_statistics_.is_null()) {
+    j[kGraphStatisticsKey] = header.graph_statistics_;
+  }
+  if (header.content_addressed_) {
+    j[kContentAddressedKey] = true;
+  }
 }
 
 void
@@ -307,6 +328,15 @@ tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
   j.at(kPartPropertyMetaKey).get_to(header.metadata_);
 
+  // Statistics and content addressing may be added to any version of the
+  // format
+  if (auto it = j.find(kGraphStatisticsKey); it != j.end()) {
+    header.graph_statistics_ = *it;
+  }
+  if (auto it = j.find(kContentAddressedKey); it != j.end()) {
+    it->get_to(header.content_addressed_);
+  }
+
   if (auto it = j.find(kStorageFormatVersionKey); it != j.end()) {
     it->get_to(header.storage_format_version_);
   } else {
@@ -394,6 +424,11 @@ tsuba::from_json(const json& j, tsuba::PartitionMetadata& pmd) {
   }
 }
 
+bool
+tsuba::PropStorageInfo::IsContentAddressed() const {
+  return IsContentAddressedName(path_);
+}
+
 void
 tsuba::from_json(const nlohmann::json& j, tsuba::PropStorageInfo& propmd) {
   j.at(0).get_to(propmd.name_);
@@ -104,6 +104,10 @@ public:
   const std::string& path() const { return path_; }
   const std::shared_ptr<arrow::DataType>& type() const { return type_; }
 
+  /// Whether the property is stored in a content addressed file, whose name
+  /// records the hash of its contents
+  bool IsContentAddressed() const;
+
   // since we don't have type info in the header don't know the
   // type when this would have been constructed. Allow others to
   // fix up the type in this case, required until we can get the type
@@ -314,6 +318,16 @@ public:
   const PartitionMetadata& metadata() const { return metadata_; }
   void set_metadata(const PartitionMetadata& metadata) { metadata_ = metadata; }
 
+  const nlohmann::json& graph_statistics() const { return graph_statistics_; }
+  void set_graph_statistics(nlohmann::json graph_statistics) {
+    graph_statistics_ = std::move(graph_statistics);
+  }
+
+  bool content_addressed() const { return content_addressed_; }
+  void set_content_addressed(bool content_addressed) {
+    content_addressed_ = content_addressed;
+  }
+
   uint32_t storage_format_version() const { return storage_format_version_; }
   void update_storage_format_version() {
     storage_format_version_ = latest_storage_format_version_;
@@ -622,6 +636,15 @@ private:
   /// Metadata filled in by CuSP, or from storage (meta partition file)
   PartitionMetadata metadata_;
 
+  /// Statistics computed by a profiler over the whole graph, null if there
+  /// are none; they are stored as is and are not interpreted here
+  nlohmann::json graph_statistics_;
+
+  /// Whether files written for this partition are named by their contents,
+  /// so that versions and views share the files that did not change; see
+  /// ContentAddressed.h
+  bool content_addressed_{false};
+
   /// tracks changes to json on disk structure of the PartitionHeader
   /// current one is defined by latest_storage_format_version_
   /// When a graph is loaded from file, this is overwritten with the loaded value
@@ -8,6 +8,7 @@
 #include <boost/outcome/detail/value_storage.hpp>
 #include <unicode/utypes.h>
 
+#include "ContentAddressed.h"
 #include "PartitionTopologyMetadata.h"
 #include "RDGPartHeader.h"
 #include "katana/EntityTypeManager.h"
@@ -299,7 +300,8 @@ RDGTopology::MapMetadataExtract(
 
 katana::Result<void>
 tsuba::RDGTopology::DoStore(
-    RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group) {
+    RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group,
+    bool content_addressed) {
   KATANA_LOG_VASSERT(!invalid_, "tried to store an invalid RDGTopology");
 
   if (!storage_valid_) {
@@ -452,11 +454,18 @@ tsuba::RDGTopology::DoStore(
 
     //TODO: emcginnis need different naming schemes for the optional topologies?
     // add "epi_npi_eti_nti" to name?
-    katana::Uri path_uri = MakeTopologyFileName(handle);
-    ff->Bind(path_uri.string());
-    TSUBA_PTP(internal::FaultSensitivity::Normal);
-    write_group->StartStore(std::move(ff));
-    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    std::string path;
+    if (content_addressed) {
+      path = KATANA_CHECKED(StoreContentAddressed(
+          std::move(ff), GetRDGDir(handle), write_group.get()));
+    } else {
+      katana::Uri path_uri = MakeTopologyFileName(handle);
+      ff->Bind(path_uri.string());
+      TSUBA_PTP(internal::FaultSensitivity::Normal);
+      write_group->StartStore(std::move(ff));
+      TSUBA_PTP(internal::FaultSensitivity::Normal);
+      path = path_uri.BaseName();
+    }
 
     // update the metadata entry
 
@@ -466,7 +475,7 @@ tsuba::RDGTopology::DoStore(
     KATANA_LOG_ASSERT(node_sort_state_ != NodeSortKind::kInvalid);
 
     metadata_entry_->Update(
-        path_uri.BaseName(), num_edges_, num_nodes_,
+        path, num_edges_, num_nodes_,
         (edge_index_to_property_index_map_ != nullptr),
         (node_index_to_property_index_map_ != nullptr),
         edge_condensed_type_id_map_size_,
@@ -478,7 +487,7 @@ tsuba::RDGTopology::DoStore(
 
   else if (path().empty()) {
     // we don't have an update, but we are persisting in a new location
-    // store our in memory state
+    // copy the file we were loaded from
 
     KATANA_LOG_DEBUG(
         "Storing RDGTopology to file in new location. TopologyKind={}, "
@@ -486,13 +495,19 @@ tsuba::RDGTopology::DoStore(
         "EdgeSortKind={}, NodeSortKind={}",
         topology_state_, transpose_state_, edge_sort_state_, node_sort_state_);
 
+    if (content_addressed && IsContentAddressedFile(file_storage_.filename())) {
+      metadata_entry_->path_ = KATANA_CHECKED(CopyContentAddressed(
+          file_storage_.filename(), file_storage_.size(), GetRDGDir(handle),
+          write_group.get()));
+      return katana::ResultSuccess();
+    }
+
     //TODO: emcginnis need different naming schemes for the optional topologies
     katana::Uri path_uri = MakeTopologyFileName(handle);
 
     TSUBA_PTP(internal::FaultSensitivity::Normal);
-    // depends on `topology_file_storage_` outliving writes
-    write_group->StartStore(
-        path_uri.string(), file_storage_.ptr<uint8_t>(), file_storage_.size());
+    write_group->StartCopy(
+        file_storage_.filename(), path_uri.string(), file_storage_.size());
     TSUBA_PTP(internal::FaultSensitivity::Normal);
 
     // since nothing has changed besides the storage location, just have to update path
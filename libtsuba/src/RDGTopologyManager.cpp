@@ -56,7 +56,8 @@ RDGTopologyManager::Make(PartitionTopologyMetadata* topology_metadata) {
 
 katana::Result<void>
 RDGTopologyManager::DoStore(
-    RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group) {
+    RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group,
+    bool content_addressed) {
   KATANA_LOG_VASSERT(num_topologies_ >= 1, "must have at least 1 topology");
   for (size_t i = 0; i < num_topologies_; i++) {
     // don't store invalid RDGTopology instances, they have been superseded
@@ -68,7 +69,8 @@ RDGTopologyManager::DoStore(
         topology_set_.at(i).metadata_entry_valid(),
         "topology at index {} must have valid metadata before calling DoStore",
         i);
-    KATANA_CHECKED(topology_set_.at(i).DoStore(handle, write_group));
+    KATANA_CHECKED(
+        topology_set_.at(i).DoStore(handle, write_group, content_addressed));
   }
   return katana::ResultSuccess();
 }
@@ -53,7 +53,8 @@ public:
   }
 
   katana::Result<void> DoStore(
-      RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group);
+      RDGHandle handle, std::unique_ptr<tsuba::WriteGroup>& write_group,
+      bool content_addressed);
 
   /// Extract metadata from an previous storage format topology
   /// Only should be used when transitioning from a previous storage format topology
@@ -0,0 +1,187 @@
+#include "tsuba/SharedMemory.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+
+namespace {
+
+// "KATSHM01"
+constexpr uint64_t kSealedMagic = 0x4b415453484d3031ULL;
+
+katana::Result<void>
+CheckName(const std::string& name) {
+  if (name.size() < 2 || name.size() > 255 || name[0] != '/' ||
+      name.find('/', 1) != std::string::npos) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "shared memory name must be / followed by up to 254 characters "
+        "other than /: {}",
+        name);
+  }
+  return katana::ResultSuccess();
+}
+
+uint64_t
+HeaderSize() {
+  return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+}  // namespace
+
+namespace tsuba {
+
+/// The first page of the segment, which stays writable in every process
+struct SharedMemory::Header {
+  std::atomic<uint64_t> magic;
+  std::atomic<uint64_t> num_attached;
+  uint64_t size;
+};
+
+SharedMemory::Header*
+SharedMemory::header() const {
+  return reinterpret_cast<Header*>(map_start_);  // NOLINT
+}
+
+SharedMemory::~SharedMemory() {
+  header()->num_attached.fetch_sub(1, std::memory_order_acq_rel);
+  if (munmap(map_start_, map_size_)) {
+    KATANA_LOG_ERROR("unmapping shared memory {}", name_);
+  }
+}
+
+katana::Result<std::unique_ptr<SharedMemory>>
+SharedMemory::Create(const std::string& name, uint64_t size) {
+  KATANA_CHECKED(CheckName(name));
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "creating shared memory {}", name);
+  }
+
+  uint64_t header_size = HeaderSize();
+  uint64_t map_size = header_size + size;
+  if (ftruncate(fd, map_size)) {
+    auto err = katana::ResultErrno();
+    close(fd);
+    shm_unlink(name.c_str());
+    return KATANA_ERROR(err, "sizing shared memory {} to {}", name, map_size);
+  }
+
+  void* ptr =
+      mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  auto err = katana::ResultErrno();
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return KATANA_ERROR(err, "mapping shared memory {}", name);
+  }
+
+  auto* header = static_cast<Header*>(ptr);
+  header->size = size;
+  header->num_attached.store(1, std::memory_order_relaxed);
+
+  return std::unique_ptr<SharedMemory>(new SharedMemory(
+      name, static_cast<uint8_t*>(ptr), map_size, header_size, size, true));
+}
+
+katana::Result<std::unique_ptr<SharedMemory>>
+SharedMemory::Open(const std::string& name) {
+  KATANA_CHECKED(CheckName(name));
+
+  // O_RDWR because the header page is mapped writable
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "opening shared memory {}", name);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st)) {
+    auto err = katana::ResultErrno();
+    close(fd);
+    return KATANA_ERROR(err, "reading size of shared memory {}", name);
+  }
+  uint64_t header_size = HeaderSize();
+  uint64_t map_size = st.st_size;
+  if (map_size < header_size) {
+    close(fd);
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "shared memory {} is not sealed",
+        name);
+  }
+
+  void* ptr = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd, 0);
+  auto err = katana::ResultErrno();
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return KATANA_ERROR(err, "mapping shared memory {}", name);
+  }
+
+  auto* header = static_cast<Header*>(ptr);
+  if (mprotect(ptr, header_size, PROT_READ | PROT_WRITE)) {
+    err = katana::ResultErrno();
+    munmap(ptr, map_size);
+    return KATANA_ERROR(
+        err, "making header of shared memory {} writable", name);
+  }
+  if (header->magic.load(std::memory_order_acquire) != kSealedMagic) {
+    munmap(ptr, map_size);
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "shared memory {} is not sealed",
+        name);
+  }
+  header->num_attached.fetch_add(1, std::memory_order_acq_rel);
+
+  return std::unique_ptr<SharedMemory>(new SharedMemory(
+      name, static_cast<uint8_t*>(ptr), map_size, header_size, header->size,
+      false));
+}
+
+katana::Result<void>
+SharedMemory::Unlink(const std::string& name) {
+  KATANA_CHECKED(CheckName(name));
+  if (shm_unlink(name.c_str())) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "unlinking shared memory {}", name);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+SharedMemory::Seal() {
+  if (!creator_) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "only the creator can seal shared memory {}", name_);
+  }
+  if (sealed()) {
+    return katana::ResultSuccess();
+  }
+  if (size_ > 0 && mprotect(data(), size_, PROT_READ)) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "making shared memory {} read only", name_);
+  }
+  header()->magic.store(kSealedMagic, std::memory_order_release);
+  return katana::ResultSuccess();
+}
+
+bool
+SharedMemory::sealed() const {
+  return header()->magic.load(std::memory_order_acquire) == kSealedMagic;
+}
+
+uint64_t
+SharedMemory::num_attached() const {
+  return header()->num_attached.load(std::memory_order_acquire);
+}
+
+}  // namespace tsuba
@@ -69,4 +69,19 @@ WriteGroup::StartStore(std::shared_ptr<FileFrame> ff) {
   AddOp(std::move(future), file, size);
 }
 
+void
+WriteGroup::StartCopy(
+    const std::string& source_file, const std::string& dest_file,
+    uint64_t size) {
+  auto future = std::async(
+      std::launch::async,
+      [source_file, dest_file, size]() -> katana::CopyableResult<void> {
+        if (auto res = FileRemoteCopy(source_file, dest_file, 0, size); !res) {
+          return katana::CopyableErrorInfo{res.error()};
+        }
+        return katana::CopyableResultSuccess();
+      });
+  AddOp(std::move(future), dest_file);
+}
+
 }  // namespace tsuba
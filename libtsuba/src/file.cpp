@@ -19,6 +19,7 @@
 #include "katana/Platform.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
+#include "tsuba/FileView.h"
 
 katana::Result<void>
 tsuba::FileStore(const std::string& uri, const void* data, uint64_t size) {
@@ -53,12 +54,26 @@ tsuba::FileRemoteCopy(
   auto source_fs = FS(source_uri);
   auto dest_fs = FS(dest_uri);
 
-  if (source_fs != dest_fs) {
-    KATANA_LOG_ERROR("cannot copy between different back-ends");
-    return ErrorCode::NotImplemented;
+  if (source_fs == dest_fs) {
+    return dest_fs->RemoteCopy(source_uri, dest_uri, begin, size);
   }
 
-  return dest_fs->RemoteCopy(source_uri, dest_uri, begin, size);
+  // Different back-ends cannot copy between each other, so the slice makes a
+  // round trip through memory
+  FileView fv;
+  KATANA_CHECKED_CONTEXT(
+      fv.Bind(source_uri, begin, begin + size, true), "reading {}",
+      source_uri);
+  if (fv.size() < begin + size) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "slice [{}, {}) is past the end of {} (size {})", begin, begin + size,
+        source_uri, fv.size());
+  }
+  KATANA_CHECKED_CONTEXT(
+      FileStore(dest_uri, fv.ptr<uint8_t>(begin), size), "writing {}",
+      dest_uri);
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
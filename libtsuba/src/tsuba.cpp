@@ -1,5 +1,8 @@
 #include "tsuba/tsuba.h"
 
+#include <unordered_set>
+
+#include "ContentAddressed.h"
 #include "GlobalState.h"
 #include "RDGHandleImpl.h"
 #include "RDGPartHeader.h"
@@ -291,10 +294,10 @@ tsuba::CopyRDG(std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files) {
       manifest_uri_idxs.push_back(i);
       continue;
     }
-    tsuba::FileView fv;
-    KATANA_CHECKED(fv.Bind(src_file_uri.string(), true));
-    KATANA_CHECKED(
-        tsuba::FileStore(dst_file_uri.string(), fv.ptr<char>(), fv.size()));
+    tsuba::StatBuf stat_buf;
+    KATANA_CHECKED(tsuba::FileStat(src_file_uri.string(), &stat_buf));
+    KATANA_CHECKED(tsuba::FileRemoteCopy(
+        src_file_uri.string(), dst_file_uri.string(), 0, stat_buf.size));
   }
 
   // Process all the manifest files, write them out.
@@ -317,6 +320,74 @@ tsuba::CopyRDG(std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files) {
   return katana::ResultSuccess();
 }
 
+namespace {
+
+/// Add the content addressed files that header refers to
+void
+AddContentAddressedFiles(
+    const tsuba::RDGPartHeader& header,
+    std::unordered_set<std::string>* files) {
+  auto add = [&](const std::string& file) {
+    if (tsuba::IsContentAddressedName(file)) {
+      files->emplace(file);
+    }
+  };
+  for (const auto& prop : header.node_prop_info_list()) {
+    add(prop.path());
+  }
+  for (const auto& prop : header.edge_prop_info_list()) {
+    add(prop.path());
+  }
+  for (const auto& prop : header.part_prop_info_list()) {
+    add(prop.path());
+  }
+  add(header.node_entity_type_id_array_path());
+  add(header.edge_entity_type_id_array_path());
+  for (size_t i = 0; i < header.topology_metadata()->num_entries(); ++i) {
+    add(header.topology_metadata()->Entries().at(i).path_);
+  }
+}
+
+}  // namespace
+
+katana::Result<uint64_t>
+tsuba::CollectGarbage(const std::string& rdg_dir) {
+  auto rdg_uri = KATANA_CHECKED(katana::Uri::Make(rdg_dir));
+  std::vector<std::string> files = KATANA_CHECKED(FileList(rdg_uri.string()));
+
+  // Unlike RDGManifest::FileNames, give up if a part header cannot be read,
+  // since the files it refers to would be deleted
+  std::unordered_set<std::string> referenced;
+  for (const std::string& file : files) {
+    katana::Uri manifest_uri = rdg_uri.Join(file);
+    if (!RDGManifest::IsManifestUri(manifest_uri)) {
+      continue;
+    }
+    RDGManifest manifest = KATANA_CHECKED_CONTEXT(
+        RDGManifest::Make(manifest_uri), "reading manifest {}", file);
+    for (uint32_t host = 0; host < manifest.num_hosts(); ++host) {
+      katana::Uri header_uri = manifest.PartitionFileName(host);
+      RDGPartHeader header = KATANA_CHECKED_CONTEXT(
+          RDGPartHeader::Make(header_uri), "reading part header {}",
+          header_uri);
+      AddContentAddressedFiles(header, &referenced);
+    }
+  }
+
+  std::unordered_set<std::string> garbage;
+  for (const std::string& file : files) {
+    if (IsContentAddressedName(file) && referenced.count(file) == 0) {
+      garbage.emplace(file);
+    }
+  }
+  if (!garbage.empty()) {
+    KATANA_CHECKED(FileDelete(rdg_uri.string(), garbage));
+  }
+  KATANA_LOG_DEBUG(
+      "deleted {} of {} files in {}", garbage.size(), files.size(), rdg_uri);
+  return garbage.size();
+}
+
 /// Create a file name for the default CSR topology
 katana::Uri
 tsuba::MakeTopologyFileName(tsuba::RDGHandle handle) {
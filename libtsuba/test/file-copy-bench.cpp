@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Random.h"
+#include "katana/URI.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/// The number of files in the synthetic version; a property graph has a few
+/// topology and entity type files and one file per property
+constexpr size_t kNumFiles = 8;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long file_size : {1 << 20, 1 << 24, 1 << 27}) {
+    b->Args({file_size});
+  }
+}
+
+/// A directory with the files of a version and one to copy it to
+class Version {
+public:
+  explicit Version(size_t file_size) {
+    auto uri_res = katana::Uri::MakeRand("/tmp/file-copy-bench");
+    KATANA_LOG_ASSERT(uri_res);
+    dir_ = uri_res.value();
+
+    std::string data = katana::RandomAlphanumericString(file_size);
+    for (size_t i = 0; i < kNumFiles; ++i) {
+      std::string name = "file" + std::to_string(i);
+      katana::Uri src = dir_.Join("src").Join(name);
+      KATANA_LOG_ASSERT(tsuba::FileStore(src.string(), data));
+      src_dst_files_.emplace_back(src, dir_.Join("dst").Join(name));
+    }
+  }
+
+  Version(const Version&) = delete;
+  Version& operator=(const Version&) = delete;
+
+  ~Version() { fs::remove_all(dir_.path()); }
+
+  const std::vector<std::pair<katana::Uri, katana::Uri>>& src_dst_files()
+      const {
+    return src_dst_files_;
+  }
+
+private:
+  katana::Uri dir_;
+  std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files_;
+};
+
+/// Copy through streams, as the local storage did before it used the
+/// copy support of the file system
+void
+StreamCopy(benchmark::State& state) {
+  Version version(state.range(0));
+  for (auto _ : state) {
+    for (const auto& [src, dst] : version.src_dst_files()) {
+      std::ifstream ifile(src.path(), std::ios_base::binary);
+      std::ofstream ofile(
+          dst.path(), std::ios_base::binary | std::ios_base::trunc);
+      std::copy_n(
+          std::istreambuf_iterator<char>(ifile), state.range(0),
+          std::ostreambuf_iterator<char>(ofile));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kNumFiles * state.range(0));
+}
+
+/// Create a version with CopyRDG, which uses FileRemoteCopy, optionally
+/// allowing hard links
+template <bool HardLinks>
+void
+CopyVersion(benchmark::State& state) {
+  if (HardLinks) {
+    katana::SetEnv("KATANA_LOCAL_STORAGE_HARDLINKS", "1", true);
+  }
+  Version version(state.range(0));
+  for (auto _ : state) {
+    KATANA_LOG_ASSERT(tsuba::CopyRDG(version.src_dst_files()));
+  }
+  state.SetBytesProcessed(state.iterations() * kNumFiles * state.range(0));
+  if (HardLinks) {
+    katana::UnsetEnv("KATANA_LOCAL_STORAGE_HARDLINKS");
+  }
+}
+
+BENCHMARK(StreamCopy)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK_TEMPLATE(CopyVersion, false)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK_TEMPLATE(CopyVersion, true)->Apply(MakeArguments)->UseRealTime();
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (auto init_good = tsuba::Init(); !init_good) {
+    KATANA_LOG_FATAL("tsuba::Init: {}", init_good.error());
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  if (auto fini_good = tsuba::Fini(); !fini_good) {
+    KATANA_LOG_FATAL("tsuba::Fini: {}", fini_good.error());
+  }
+}
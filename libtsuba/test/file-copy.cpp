@@ -0,0 +1,272 @@
+#include <cstring>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FileStorage.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/// A back-end that keeps its files in memory, so copies to and from it cross
+/// back-ends
+class MemoryStorage : public tsuba::FileStorage {
+public:
+  static constexpr std::string_view kScheme = "mem://";
+
+  MemoryStorage() : tsuba::FileStorage(kScheme) {}
+
+  katana::Result<void> Init() override { return katana::ResultSuccess(); }
+  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+
+  katana::Result<void> Stat(
+      const std::string& uri, tsuba::StatBuf* s_buf) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(uri);
+    if (it == files_.end()) {
+      return KATANA_ERROR(tsuba::ErrorCode::NotFound, "no file {}", uri);
+    }
+    s_buf->size = it->second.size();
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(uri);
+    if (it == files_.end() || start + size > it->second.size()) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::InvalidArgument, "cannot read {}", uri);
+    }
+    std::memcpy(result_buf, it->second.data() + start, size);
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_[uri].assign(data, data + size);
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> RemoteCopy(
+      const std::string& source_uri, const std::string& dest_uri,
+      uint64_t begin, uint64_t size) override {
+    std::vector<uint8_t> slice(size);
+    KATANA_CHECKED(GetMultiSync(source_uri, begin, size, slice.data()));
+    return PutMultiSync(dest_uri, slice.data(), slice.size());
+  }
+
+  std::future<katana::CopyableResult<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    return std::async(
+        std::launch::deferred, [=]() -> katana::CopyableResult<void> {
+          if (auto res = PutMultiSync(uri, data, size); !res) {
+            return katana::CopyableErrorInfo{res.error()};
+          }
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  std::future<katana::CopyableResult<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    return std::async(
+        std::launch::deferred, [=]() -> katana::CopyableResult<void> {
+          if (auto res = GetMultiSync(uri, start, size, result_buf); !res) {
+            return katana::CopyableErrorInfo{res.error()};
+          }
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  std::future<katana::CopyableResult<void>> ListAsync(
+      const std::string&, std::vector<std::string>*,
+      std::vector<uint64_t>*) override {
+    return std::async(
+        std::launch::deferred, []() -> katana::CopyableResult<void> {
+          return KATANA_ERROR(
+              tsuba::ErrorCode::NotImplemented, "listing memory storage");
+        });
+  }
+
+  katana::Result<void> Delete(
+      const std::string&, const std::unordered_set<std::string>&) override {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::NotImplemented, "deleting from memory storage");
+  }
+
+private:
+  std::mutex mutex_;
+  std::map<std::string, std::vector<uint8_t>> files_;
+};
+
+std::vector<uint8_t>
+MakeData(size_t size, uint8_t seed) {
+  std::vector<uint8_t> data(size);
+  std::iota(data.begin(), data.end(), seed);
+  return data;
+}
+
+katana::Result<std::vector<uint8_t>>
+ReadAll(const katana::Uri& uri) {
+  tsuba::FileView fv;
+  KATANA_CHECKED(fv.Bind(uri.string(), true));
+  return std::vector<uint8_t>(fv.ptr<uint8_t>(), fv.ptr<uint8_t>() + fv.size());
+}
+
+/// Whole files and slices are copied exactly, whatever the local storage
+/// uses to copy them
+katana::Result<void>
+TestCopy(const katana::Uri& dir) {
+  auto source = dir.Join("source");
+  std::vector<uint8_t> data = MakeData(3 << 20, 7);
+  KATANA_CHECKED(tsuba::FileStore(source.string(), data.data(), data.size()));
+
+  auto whole = dir.Join("whole");
+  KATANA_CHECKED(
+      tsuba::FileRemoteCopy(source.string(), whole.string(), 0, data.size()));
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(whole)) == data);
+
+  // Copying over an existing file replaces it
+  auto slice = dir.Join("nested").Join("slice");
+  KATANA_CHECKED(tsuba::FileStore(slice.string(), data.data(), data.size()));
+  constexpr uint64_t kBegin = 12345;
+  constexpr uint64_t kSize = 1 << 20;
+  KATANA_CHECKED(
+      tsuba::FileRemoteCopy(source.string(), slice.string(), kBegin, kSize));
+  std::vector<uint8_t> expected(
+      data.begin() + kBegin, data.begin() + kBegin + kSize);
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(slice)) == expected);
+
+  auto empty = dir.Join("empty");
+  KATANA_CHECKED(tsuba::FileRemoteCopy(source.string(), empty.string(), 0, 0));
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(empty)).empty());
+
+  auto past_end = tsuba::FileRemoteCopy(
+      source.string(), dir.Join("past_end").string(), 1, data.size());
+  KATANA_LOG_ASSERT(!past_end);
+
+  return katana::ResultSuccess();
+}
+
+/// A copy that shares its inode with the source is not changed when the
+/// source is stored again
+katana::Result<void>
+TestHardLinks(const katana::Uri& dir) {
+  KATANA_LOG_ASSERT(
+      katana::SetEnv("KATANA_LOCAL_STORAGE_HARDLINKS", "1", true));
+
+  auto source = dir.Join("linked_source");
+  std::vector<uint8_t> data = MakeData(4096, 1);
+  KATANA_CHECKED(tsuba::FileStore(source.string(), data.data(), data.size()));
+  auto copy = dir.Join("linked_copy");
+  KATANA_CHECKED(
+      tsuba::FileRemoteCopy(source.string(), copy.string(), 0, data.size()));
+
+  std::vector<uint8_t> new_data = MakeData(100, 2);
+  KATANA_CHECKED(
+      tsuba::FileStore(source.string(), new_data.data(), new_data.size()));
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(copy)) == data);
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(source)) == new_data);
+
+  KATANA_LOG_ASSERT(katana::UnsetEnv("KATANA_LOCAL_STORAGE_HARDLINKS"));
+  return katana::ResultSuccess();
+}
+
+/// Files and slices are copied exactly between two different back-ends,
+/// both ways
+katana::Result<void>
+TestCrossBackendCopy(const katana::Uri& dir) {
+  auto source = dir.Join("cross_source");
+  std::vector<uint8_t> data = MakeData(3 << 20, 5);
+  KATANA_CHECKED(tsuba::FileStore(source.string(), data.data(), data.size()));
+
+  std::string mem_whole = std::string(MemoryStorage::kScheme) + "whole";
+  KATANA_CHECKED(
+      tsuba::FileRemoteCopy(source.string(), mem_whole, 0, data.size()));
+  auto mem_data = KATANA_CHECKED(katana::Uri::Make(mem_whole));
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(mem_data)) == data);
+
+  constexpr uint64_t kBegin = 4321;
+  constexpr uint64_t kSize = (1 << 20) + 17;
+  auto back = dir.Join("cross_back");
+  KATANA_CHECKED(
+      tsuba::FileRemoteCopy(mem_whole, back.string(), kBegin, kSize));
+  std::vector<uint8_t> expected(
+      data.begin() + kBegin, data.begin() + kBegin + kSize);
+  KATANA_LOG_ASSERT(KATANA_CHECKED(ReadAll(back)) == expected);
+
+  std::string mem_empty = std::string(MemoryStorage::kScheme) + "empty";
+  KATANA_CHECKED(tsuba::FileRemoteCopy(source.string(), mem_empty, 0, 0));
+  tsuba::StatBuf stat_buf;
+  KATANA_CHECKED(tsuba::FileStat(mem_empty, &stat_buf));
+  KATANA_LOG_ASSERT(stat_buf.size == 0);
+
+  auto past_end = tsuba::FileRemoteCopy(
+      mem_whole, dir.Join("cross_past_end").string(), 1, data.size());
+  KATANA_LOG_ASSERT(!past_end);
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestAll(const std::string& path) {
+  if (boost::system::error_code err; !fs::create_directories(path, err)) {
+    if (err) {
+      return KATANA_ERROR(
+          std::error_code(err.value(), err.category()),
+          "creating directories: {}", err.message());
+    }
+  }
+  auto dir = KATANA_CHECKED(katana::Uri::MakeFromFile(path));
+
+  KATANA_CHECKED_CONTEXT(TestCopy(dir), "TestCopy");
+  KATANA_CHECKED_CONTEXT(TestHardLinks(dir), "TestHardLinks");
+  KATANA_CHECKED_CONTEXT(TestCrossBackendCopy(dir), "TestCrossBackendCopy");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+  MemoryStorage memory_storage;
+  tsuba::RegisterFileStorage(&memory_storage);
+
+  if (auto init_good = tsuba::Init(); !init_good) {
+    KATANA_LOG_FATAL("tsuba::Init: {}", init_good.error());
+  }
+
+  if (argc <= 1) {
+    KATANA_LOG_FATAL("{} <empty dir>", argv[0]);
+  }
+
+  auto res = TestAll(argv[1]);
+  if (!res) {
+    KATANA_LOG_FATAL("test failed: {}", res.error());
+  }
+
+  if (auto fini_good = tsuba::Fini(); !fini_good) {
+    KATANA_LOG_FATAL("tsuba::Fini: {}", fini_good.error());
+  }
+
+  return 0;
+}
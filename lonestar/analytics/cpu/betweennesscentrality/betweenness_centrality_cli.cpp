@@ -64,11 +64,34 @@ static cll::opt<BetweennessCentralityPlan::Algorithm> algo(
         // clEnumValN(BetweennessCentralityPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(
             BetweennessCentralityPlan::kOuter, "Outer",
-            "Outer parallel algorithm")
+            "Outer parallel algorithm"),
+        clEnumValN(
+            BetweennessCentralityPlan::kBatched, "Batched",
+            "Level parallel algorithm on a batch of sources at once"),
+        clEnumValN(
+            BetweennessCentralityPlan::kApproximate, "Approximate",
+            "Adaptive sampling of shortest paths; ignores the source "
+            "options")
         // clEnumValN(BetweennessCentralityPlan::kAutoAlgo, "Auto", "Auto: choose among the algorithms automatically")
         ),
     cll::init(BetweennessCentralityPlan::kLevel));
 
+static cll::opt<uint32_t> batchSize(
+    "batchSize",
+    cll::desc("Number of sources processed together by Batched (default "
+              "value 32, at most 64)"),
+    cll::init(BetweennessCentralityPlan::kDefaultBatchSize));
+static cll::opt<double> epsilon(
+    "epsilon",
+    cll::desc("Maximum error of Approximate on the centrality divided by "
+              "n * (n - 1) (default value 0.01)"),
+    cll::init(BetweennessCentralityPlan::kDefaultEpsilon));
+static cll::opt<double> delta(
+    "delta",
+    cll::desc("Probability with which Approximate may exceed the error "
+              "(default value 0.1)"),
+    cll::init(BetweennessCentralityPlan::kDefaultDelta));
+
 static cll::opt<bool> thread_spin(
     "threadSpin",
     cll::desc("If enabled, threads busy-wait for work rather than use "
@@ -102,6 +125,11 @@ main(int argc, char** argv) {
 
   BetweennessCentralityPlan plan =
       BetweennessCentralityPlan::FromAlgorithm(algo);
+  if (algo == BetweennessCentralityPlan::kBatched) {
+    plan = BetweennessCentralityPlan::Batched(batchSize);
+  } else if (algo == BetweennessCentralityPlan::kApproximate) {
+    plan = BetweennessCentralityPlan::Approximate(epsilon, delta);
+  }
 
   BetweennessCentralitySources sources = kBetweennessCentralityAllNodes;
   uint32_t num_sources = pg->num_nodes();
@@ -0,0 +1,125 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/partition/partition.h"
+
+using namespace katana::analytics;
+
+namespace cll = llvm::cl;
+
+static const char* name = "Multilevel Graph Partitioning";
+static const char* desc =
+    "Partitions the nodes of a property graph into k balanced parts with a "
+    "small edge cut";
+static const char* url = "gmetis";
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<uint32_t> numPartitions(
+    "numPartitions", cll::desc("Number of partitions (default value 4)"),
+    cll::init(4));
+
+static cll::opt<double> imbalance(
+    "imbalance",
+    cll::desc("Allowed fraction by which a partition may exceed the average "
+              "partition weight (default value 0.03)"),
+    cll::init(0.03));
+
+static cll::opt<std::string> nodeWeightPropertyName(
+    "nodeWeightPropertyName",
+    cll::desc("Node property holding node weights (default: unit weights)"),
+    cll::init(""));
+
+static cll::opt<uint32_t> refinementIterations(
+    "refinementIterations",
+    cll::desc("Maximum number of refinement sweeps per level (default value "
+              "8)"),
+    cll::init(PartitionPlan::kDefaultRefinementIterations));
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  if (!symmetricGraph) {
+    KATANA_LOG_FATAL(
+        "This application requires a symmetric graph input;"
+        " please use the -symmetricGraph flag "
+        " to indicate the input is a symmetric graph.");
+  }
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  std::cout << "Read " << pg->topology().num_nodes() << " nodes, "
+            << pg->topology().num_edges() << " edges\n";
+
+  PartitionPlan plan = PartitionPlan::Multilevel(refinementIterations);
+
+  if (auto r = Partition(
+          pg.get(), numPartitions, imbalance, nodeWeightPropertyName,
+          edge_property_name, "partition", plan);
+      !r) {
+    KATANA_LOG_FATAL("Failed to compute partitions: {}", r.error());
+  }
+
+  auto stats_result =
+      PartitionStatistics::Compute(pg.get(), numPartitions, "partition");
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute partition statistics: {}", stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    if (auto r = PartitionAssertValid(
+            pg.get(), numPartitions, imbalance, nodeWeightPropertyName,
+            "partition");
+        r) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed: {}", r.error());
+    }
+  }
+
+  if (output) {
+    auto r = pg->GetNodePropertyTyped<uint32_t>("partition");
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) == pg->topology().num_nodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/bipartite_matching/bipartite_matching.h"
+
+using namespace katana::analytics;
+
+namespace cll = llvm::cl;
+
+static const char* name = "Bipartite Matching";
+static const char* desc =
+    "Computes a maximum cardinality matching between the two sides of a "
+    "bipartite property graph";
+static const char* url = "bipartite_matching";
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<std::string> leftSidePropertyName(
+    "leftSidePropertyName",
+    cll::desc("Boolean node property that is true for nodes on the left side "
+              "and false for nodes on the right side"),
+    cll::init(""));
+
+static cll::opt<std::string> leftNodeType(
+    "leftNodeType",
+    cll::desc("Node type of the left side; used with -rightNodeType instead "
+              "of -leftSidePropertyName"),
+    cll::init(""));
+
+static cll::opt<std::string> rightNodeType(
+    "rightNodeType", cll::desc("Node type of the right side"), cll::init(""));
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  bool by_node_types = !leftNodeType.empty() || !rightNodeType.empty();
+  if (by_node_types == !leftSidePropertyName.empty()) {
+    KATANA_LOG_FATAL(
+        "specify either -leftSidePropertyName or both -leftNodeType and "
+        "-rightNodeType");
+  }
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  std::cout << "Read " << pg->topology().num_nodes() << " nodes, "
+            << pg->topology().num_edges() << " edges\n";
+
+  BipartiteMatchingPlan plan = BipartiteMatchingPlan::PothenFan();
+
+  katana::Result<void> r = katana::ResultSuccess();
+  if (by_node_types) {
+    r = BipartiteMatchingByNodeTypes(
+        pg.get(), leftNodeType, rightNodeType, "partner", plan);
+  } else {
+    r = BipartiteMatching(pg.get(), leftSidePropertyName, "partner", plan);
+  }
+  if (!r) {
+    KATANA_LOG_FATAL("Failed to compute matching: {}", r.error());
+  }
+
+  auto stats_result = BipartiteMatchingStatistics::Compute(pg.get(), "partner");
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute matching statistics: {}", stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    katana::Result<void> valid = katana::ResultSuccess();
+    if (by_node_types) {
+      valid = BipartiteMatchingByNodeTypesAssertValid(
+          pg.get(), leftNodeType, rightNodeType, "partner");
+    } else {
+      valid = BipartiteMatchingAssertValid(
+          pg.get(), leftSidePropertyName, "partner");
+    }
+    if (valid) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed: {}", valid.error());
+    }
+  }
+
+  if (output) {
+    auto partners = pg->GetNodePropertyTyped<uint32_t>("partner");
+    if (!partners) {
+      KATANA_LOG_FATAL("Failed to get node property {}", partners.error());
+    }
+    auto results = partners.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) == pg->topology().num_nodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}
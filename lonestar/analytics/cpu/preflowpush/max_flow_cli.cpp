@@ -0,0 +1,108 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/max_flow/max_flow.h"
+
+using namespace katana::analytics;
+
+namespace cll = llvm::cl;
+
+static const char* name = "Max Flow";
+static const char* desc =
+    "Computes the maximum flow and a minimum cut between two nodes of a "
+    "property graph using an edge capacity property";
+static const char* url = "preflow_push";
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<uint32_t> sourceNode(
+    "sourceNode", cll::desc("Source node"), cll::Required);
+
+static cll::opt<uint32_t> sinkNode(
+    "sinkNode", cll::desc("Sink node"), cll::Required);
+
+static cll::opt<double> globalRelabelFrequency(
+    "globalRelabelFrequency",
+    cll::desc("Relative frequency of global relabeling; 0 disables it "
+              "(default value 1)"),
+    cll::init(MaxFlowPlan::kDefaultGlobalRelabelFrequency));
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  std::cout << "Read " << pg->topology().num_nodes() << " nodes, "
+            << pg->topology().num_edges() << " edges\n";
+
+  MaxFlowPlan plan = MaxFlowPlan::PushRelabel(globalRelabelFrequency);
+
+  auto flow_result = MaxFlow(
+      pg.get(), sourceNode, sinkNode, edge_property_name, "source-side", plan);
+  if (!flow_result) {
+    KATANA_LOG_FATAL("Failed to compute max flow: {}", flow_result.error());
+  }
+  std::cout << "Max flow = " << flow_result.value() << "\n";
+
+  auto stats_result = MaxFlowStatistics::Compute(
+      pg.get(), edge_property_name, "source-side");
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute max flow statistics: {}", stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    if (auto r = MaxFlowAssertValid(
+            pg.get(), sourceNode, sinkNode, edge_property_name, "source-side");
+        r) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed: {}", r.error());
+    }
+  }
+
+  if (output) {
+    auto r = pg->GetNodePropertyTyped<uint8_t>("source-side");
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) == pg->topology().num_nodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}
@@ -83,6 +83,9 @@ static cll::opt<SsspPlan::Algorithm> algo(
         clEnumValN(SsspPlan::kDijkstra, "Dijkstra", "Dijkstra's algorithm"),
         clEnumValN(SsspPlan::kTopological, "Topo", "Topological"),
         clEnumValN(SsspPlan::kTopologicalTile, "TopoTile", "Topological tiled"),
+        clEnumValN(
+            SsspPlan::kMultiQueue, "MultiQueue",
+            "Asynchronous with a relaxed priority queue (no delta)"),
         clEnumValN(
             SsspPlan::kAutomatic, "Automatic",
             "Automatic: choose among the algorithms automatically")),
@@ -121,6 +124,8 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "Topological";
   case SsspPlan::kTopologicalTile:
     return "TopologicalTile";
+  case SsspPlan::kMultiQueue:
+    return "MultiQueue";
   case SsspPlan::kAutomatic:
     return "Automatic";
   default:
@@ -231,6 +236,9 @@ main(int argc, char** argv) {
   case SsspPlan::kTopologicalTile:
     plan = SsspPlan::TopologicalTile();
     break;
+  case SsspPlan::kMultiQueue:
+    plan = SsspPlan::MultiQueue();
+    break;
   case SsspPlan::kAutomatic:
     plan = SsspPlan();
     break;
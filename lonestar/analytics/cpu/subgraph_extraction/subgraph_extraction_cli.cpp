@@ -49,6 +49,18 @@ static cll::opt<SubGraphExtractionPlan::Algorithm> algo(
         SubGraphExtractionPlan::kNodeSet, "nodeSet",
         "Extract subgraph topology from node set")),
     cll::init(SubGraphExtractionPlan::kNodeSet));
+static cll::opt<uint32_t> egoHops(
+    "egoHops",
+    cll::desc("If non-zero, extract the neighborhood of this many hops around "
+              "the given nodes instead of the subgraph induced by them "
+              "(default value 0)"),
+    cll::init(0));
+static cll::list<std::string> nodeProperties(
+    "nodeProperties", cll::desc("Node properties to copy into the subgraph"),
+    cll::CommaSeparated);
+static cll::list<std::string> edgeProperties(
+    "edgeProperties", cll::desc("Edge properties to copy into the subgraph"),
+    cll::CommaSeparated);
 
 int
 main(int argc, char** argv) {
@@ -85,7 +97,18 @@ main(int argc, char** argv) {
   std::cout << "INFO: This is extracting the topology containing nodes from "
                "the user defined node set.\n";
 
-  auto subgraph_result = SubGraphExtraction(pg.get(), node_vec, plan);
+  std::vector<std::string> node_properties(
+      nodeProperties.begin(), nodeProperties.end());
+  std::vector<std::string> edge_properties(
+      edgeProperties.begin(), edgeProperties.end());
+
+  katana::Result<std::unique_ptr<katana::PropertyGraph>> subgraph_result =
+      egoHops > 0
+          ? EgoNetworkExtraction(
+                pg.get(), node_vec, egoHops, /* follow_in_edges */ false,
+                node_properties, edge_properties)
+          : SubGraphExtraction(
+                pg.get(), node_vec, node_properties, edge_properties, plan);
   if (!subgraph_result) {
     KATANA_LOG_FATAL("Failed to run algorithm: {}", subgraph_result.error());
   }
@@ -26,6 +26,8 @@ Algorithms
 
 .. automodule:: katana.local.analytics._bfs
 
+.. automodule:: katana.local.analytics._bipartite_matching
+
 .. automodule:: katana.local.analytics._connected_components
 
 .. automodule:: katana.local.analytics._independent_set
@@ -42,8 +44,16 @@ Algorithms
 
 .. automodule:: katana.local.analytics._k_truss
 
+.. automodule:: katana.local.analytics._max_flow
+
+.. automodule:: katana.local.analytics._minimum_spanning_forest
+
 .. automodule:: katana.local.analytics._pagerank
 
+.. automodule:: katana.local.analytics._partition
+
+.. automodule:: katana.local.analytics._plan_advisor
+
 .. automodule:: katana.local.analytics._sssp
 
 .. automodule:: katana.local.analytics._triangle_count
@@ -60,6 +70,14 @@ from katana.local.analytics._betweenness_centrality import (
     betweenness_centrality,
 )
 from katana.local.analytics._bfs import BfsPlan, BfsStatistics, bfs, bfs_assert_valid
+from katana.local.analytics._bipartite_matching import (
+    BipartiteMatchingPlan,
+    BipartiteMatchingStatistics,
+    bipartite_matching,
+    bipartite_matching_assert_valid,
+    bipartite_matching_by_node_types,
+    bipartite_matching_by_node_types_assert_valid,
+)
 from katana.local.analytics._connected_components import (
     ConnectedComponentsPlan,
     ConnectedComponentsStatistics,
@@ -91,9 +109,27 @@ from katana.local.analytics._louvain_clustering import (
     louvain_clustering,
     louvain_clustering_assert_valid,
 )
+from katana.local.analytics._max_flow import MaxFlowPlan, MaxFlowStatistics, max_flow, max_flow_assert_valid
+from katana.local.analytics._minimum_spanning_forest import (
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+)
 from katana.local.analytics._pagerank import PagerankPlan, PagerankStatistics, pagerank, pagerank_assert_valid
+from katana.local.analytics._partition import (
+    PartitionPlan,
+    PartitionStatistics,
+    partition,
+    partition_assert_valid,
+)
+from katana.local.analytics._plan_advisor import GraphFeatures, PlanAdvice, advise_plans
 from katana.local.analytics._sssp import SsspPlan, SsspStatistics, sssp, sssp_assert_valid
-from katana.local.analytics._subgraph_extraction import SubGraphExtractionPlan, subgraph_extraction
+from katana.local.analytics._subgraph_extraction import (
+    SubGraphExtractionPlan,
+    ego_network_extraction,
+    subgraph_extraction,
+)
 from katana.local.analytics._triangle_count import TriangleCountPlan, triangle_count
 from katana.local.analytics._wrappers import find_edge_sorted_by_dest, sort_all_edges_by_dest, sort_nodes_by_degree
 from katana.local.analytics.plan import Architecture, Plan, Statistics
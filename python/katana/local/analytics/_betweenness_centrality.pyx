@@ -39,8 +39,13 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kBatched "katana::analytics::BetweennessCentralityPlan::kBatched"
+            kApproximate "katana::analytics::BetweennessCentralityPlan::kApproximate"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        uint32_t batch_size() const
+        double epsilon() const
+        double delta() const
 
         BetweennessCentralityPlan()
 
@@ -49,10 +54,18 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan Batched(uint32_t batch_size)
+        @staticmethod
+        _BetweennessCentralityPlan Approximate(double epsilon, double delta)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
 
+    uint32_t kDefaultBatchSize "katana::analytics::BetweennessCentralityPlan::kDefaultBatchSize"
+    double kDefaultEpsilon "katana::analytics::BetweennessCentralityPlan::kDefaultEpsilon"
+    double kDefaultDelta "katana::analytics::BetweennessCentralityPlan::kDefaultDelta"
+
     Result[void] BetweennessCentrality(_PropertyGraph* pg, string output_property_name, const BetweennessCentralitySources& sources, _BetweennessCentralityPlan plan)
 
     # std_result[void] BetweennessCentralityAssertValid(Graph* pg, string output_property_name)
@@ -87,6 +100,8 @@ class _BetweennessCentralityAlgorithm(Enum):
     """
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    Batched = _BetweennessCentralityPlan.Algorithm.kBatched
+    Approximate = _BetweennessCentralityPlan.Algorithm.kApproximate
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -113,6 +128,27 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityAlgorithm:
         return _BetweennessCentralityAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def batch_size(self) -> int:
+        """
+        The number of sources processed together by the batched algorithm.
+        """
+        return self.underlying_.batch_size()
+
+    @property
+    def epsilon(self) -> float:
+        """
+        The maximum error of the approximate algorithm on the centrality divided by n * (n - 1).
+        """
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        """
+        The probability with which the approximate algorithm may exceed epsilon.
+        """
+        return self.underlying_.delta()
+
     @staticmethod
     def outer():
         """
@@ -127,6 +163,21 @@ cdef class BetweennessCentralityPlan(Plan):
         """
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def batched(uint32_t batch_size = kDefaultBatchSize):
+        """
+        Process levels in parallel for a batch of up to 64 sources at once.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Batched(batch_size))
+
+    @staticmethod
+    def approximate(double epsilon = kDefaultEpsilon, double delta = kDefaultDelta):
+        """
+        Sample random shortest paths until every centrality divided by n * (n - 1) is within epsilon with probability
+        1 - delta. The sources argument is ignored.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Approximate(epsilon, delta))
+
 
 def betweenness_centrality(Graph pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan()):
@@ -0,0 +1,231 @@
+"""
+Bipartite Matching
+------------------
+
+.. autoclass:: katana.local.analytics.BipartiteMatchingPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.local.analytics._bipartite_matching._BipartiteMatchingPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.bipartite_matching
+
+.. autofunction:: katana.local.analytics.bipartite_matching_by_node_types
+
+.. autoclass:: katana.local.analytics.BipartiteMatchingStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.bipartite_matching_assert_valid
+
+.. autofunction:: katana.local.analytics.bipartite_matching_by_node_types_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, handle_result_void, raise_error_code
+from katana.local._graph cimport Graph
+from katana.local.analytics.plan cimport Plan, _Plan
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/bipartite_matching/bipartite_matching.h" namespace "katana::analytics" nogil:
+    cppclass _BipartiteMatchingPlan "katana::analytics::BipartiteMatchingPlan" (_Plan):
+        enum Algorithm:
+            kPothenFan "katana::analytics::BipartiteMatchingPlan::kPothenFan"
+
+        _BipartiteMatchingPlan.Algorithm algorithm() const
+
+        BipartiteMatchingPlan()
+
+        @staticmethod
+        _BipartiteMatchingPlan PothenFan()
+
+    uint32_t kUnmatched "katana::analytics::BipartiteMatchingPlan::kUnmatched"
+
+    Result[void] BipartiteMatching(_PropertyGraph* pg, string left_side_property_name, string output_property_name,
+        _BipartiteMatchingPlan plan)
+
+    Result[void] BipartiteMatchingByNodeTypes(_PropertyGraph* pg, string left_node_type, string right_node_type,
+        string output_property_name, _BipartiteMatchingPlan plan)
+
+    Result[void] BipartiteMatchingAssertValid(_PropertyGraph* pg, string left_side_property_name,
+        string property_name)
+
+    Result[void] BipartiteMatchingByNodeTypesAssertValid(_PropertyGraph* pg, string left_node_type,
+        string right_node_type, string property_name)
+
+    cppclass _BipartiteMatchingStatistics "katana::analytics::BipartiteMatchingStatistics":
+        uint64_t num_matched_pairs
+        uint64_t num_unmatched_nodes
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_BipartiteMatchingStatistics] Compute(_PropertyGraph* pg, string property_name)
+
+
+class _BipartiteMatchingPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.local.analytics.BipartiteMatchingPlan` constructors for algorithm documentation.
+    """
+    PothenFan = _BipartiteMatchingPlan.Algorithm.kPothenFan
+
+
+cdef class BipartiteMatchingPlan(Plan):
+    """
+    A computational :ref:`Plan` for Bipartite Matching.
+
+    Static methods construct BipartiteMatchingPlans.
+    """
+    cdef:
+        _BipartiteMatchingPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _BipartiteMatchingPlanAlgorithm
+
+    UNMATCHED = kUnmatched
+    """
+    The partner of a node that is not matched.
+    """
+
+    @staticmethod
+    cdef BipartiteMatchingPlan make(_BipartiteMatchingPlan u):
+        f = <BipartiteMatchingPlan>BipartiteMatchingPlan.__new__(BipartiteMatchingPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _BipartiteMatchingPlanAlgorithm:
+        return _BipartiteMatchingPlanAlgorithm(self.underlying_.algorithm())
+
+    @staticmethod
+    def pothen_fan() -> BipartiteMatchingPlan:
+        """
+        Parallel Pothen-Fan with lookahead and fairness
+        """
+        return BipartiteMatchingPlan.make(_BipartiteMatchingPlan.PothenFan())
+
+
+def bipartite_matching(Graph pg, str left_side_property_name, str output_property_name,
+                       BipartiteMatchingPlan plan = BipartiteMatchingPlan()):
+    """
+    Compute a maximum cardinality matching between the two sides of `pg`. Edges are followed in both directions and
+    edges between nodes on the same side are ignored.
+
+    :type pg: katana.local.Graph
+    :param pg: The graph to analyze.
+    :type left_side_property_name: str
+    :param left_side_property_name: The node property which is true for nodes on the left side and false for nodes on
+        the right side. Nodes for which it is null are not matched.
+    :type output_property_name: str
+    :param output_property_name: The output node property holding the partner of each node, or
+        ``BipartiteMatchingPlan.UNMATCHED``. This property must not already exist.
+    :type plan: BipartiteMatchingPlan
+    :param plan: The execution plan to use.
+    """
+    cdef string left_side_property_name_str = left_side_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(BipartiteMatching(pg.underlying_property_graph(), left_side_property_name_str,
+                                             output_property_name_str, plan.underlying_))
+
+
+def bipartite_matching_by_node_types(Graph pg, str left_node_type, str right_node_type, str output_property_name,
+                                     BipartiteMatchingPlan plan = BipartiteMatchingPlan()):
+    """
+    Like :py:func:`bipartite_matching`, with the sides given by node types. Nodes of neither type are not matched.
+
+    .. code-block:: python
+
+        import katana.local
+        from katana.example_data import get_input
+        from katana.local import Graph
+        katana.local.initialize()
+
+        graph = Graph(get_input("propertygraphs/ldbc_003"))
+        from katana.analytics import bipartite_matching_by_node_types, BipartiteMatchingStatistics
+        bipartite_matching_by_node_types(graph, "Person", "Company", "output")
+
+        stats = BipartiteMatchingStatistics(graph, "output")
+        print("Matching size:", stats.num_matched_pairs)
+
+    """
+    cdef string left_node_type_str = left_node_type.encode("utf-8")
+    cdef string right_node_type_str = right_node_type.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(BipartiteMatchingByNodeTypes(pg.underlying_property_graph(), left_node_type_str,
+                                                        right_node_type_str, output_property_name_str,
+                                                        plan.underlying_))
+
+
+def bipartite_matching_assert_valid(Graph pg, str left_side_property_name, str property_name):
+    """
+    Raise an exception if `property_name` is not a maximum matching between the sides of `pg`.
+
+    :raises: AssertionError
+    """
+    cdef string left_side_property_name_str = left_side_property_name.encode("utf-8")
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(BipartiteMatchingAssertValid(pg.underlying_property_graph(),
+                                                          left_side_property_name_str, property_name_str))
+
+
+def bipartite_matching_by_node_types_assert_valid(Graph pg, str left_node_type, str right_node_type,
+                                                  str property_name):
+    """
+    Raise an exception if `property_name` is not a maximum matching between the nodes of the two types.
+
+    :raises: AssertionError
+    """
+    cdef string left_node_type_str = left_node_type.encode("utf-8")
+    cdef string right_node_type_str = right_node_type.encode("utf-8")
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(BipartiteMatchingByNodeTypesAssertValid(pg.underlying_property_graph(),
+                                                                     left_node_type_str, right_node_type_str,
+                                                                     property_name_str))
+
+
+cdef _BipartiteMatchingStatistics handle_result_BipartiteMatchingStatistics(
+        Result[_BipartiteMatchingStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class BipartiteMatchingStatistics:
+    """
+    Compute the :ref:`statistics` of a Bipartite Matching result.
+    """
+    cdef _BipartiteMatchingStatistics underlying
+
+    def __init__(self, Graph pg, str property_name):
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_BipartiteMatchingStatistics(_BipartiteMatchingStatistics.Compute(
+                pg.underlying_property_graph(), property_name_str))
+
+    @property
+    def num_matched_pairs(self) -> int:
+        return self.underlying.num_matched_pairs
+
+    @property
+    def num_unmatched_nodes(self) -> int:
+        return self.underlying.num_unmatched_nodes
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,213 @@
+"""
+Max Flow
+--------
+
+.. autoclass:: katana.local.analytics.MaxFlowPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.local.analytics._max_flow._MaxFlowPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.max_flow
+
+.. autoclass:: katana.local.analytics.MaxFlowStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.max_flow_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, raise_error_code
+from katana.local._graph cimport Graph
+from katana.local.analytics.plan cimport Plan, _Plan
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/max_flow/max_flow.h" namespace "katana::analytics" nogil:
+    cppclass _MaxFlowPlan "katana::analytics::MaxFlowPlan" (_Plan):
+        enum Algorithm:
+            kPushRelabel "katana::analytics::MaxFlowPlan::kPushRelabel"
+
+        _MaxFlowPlan.Algorithm algorithm() const
+        double global_relabel_frequency() const
+
+        MaxFlowPlan()
+
+        @staticmethod
+        _MaxFlowPlan PushRelabel(double global_relabel_frequency)
+
+    double kDefaultGlobalRelabelFrequency "katana::analytics::MaxFlowPlan::kDefaultGlobalRelabelFrequency"
+
+    Result[uint64_t] MaxFlow(_PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+        string edge_capacity_property_name, string output_property_name, _MaxFlowPlan plan)
+
+    Result[void] MaxFlowAssertValid(_PropertyGraph* pg, uint32_t source_node, uint32_t sink_node,
+        string edge_capacity_property_name, string property_name)
+
+    cppclass _MaxFlowStatistics "katana::analytics::MaxFlowStatistics":
+        uint64_t cut_capacity
+        uint64_t num_cut_edges
+        uint64_t num_source_side_nodes
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_MaxFlowStatistics] Compute(_PropertyGraph* pg, string edge_capacity_property_name,
+            string property_name)
+
+
+class _MaxFlowPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.local.analytics.MaxFlowPlan` constructors for algorithm documentation.
+    """
+    PushRelabel = _MaxFlowPlan.Algorithm.kPushRelabel
+
+
+cdef class MaxFlowPlan(Plan):
+    """
+    A computational :ref:`Plan` for Max Flow.
+
+    Static methods construct MaxFlowPlans.
+    """
+    cdef:
+        _MaxFlowPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MaxFlowPlanAlgorithm
+
+    @staticmethod
+    cdef MaxFlowPlan make(_MaxFlowPlan u):
+        f = <MaxFlowPlan>MaxFlowPlan.__new__(MaxFlowPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MaxFlowPlanAlgorithm:
+        return _MaxFlowPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def global_relabel_frequency(self) -> float:
+        """
+        The relative frequency of global relabeling; 0 disables it.
+        """
+        return self.underlying_.global_relabel_frequency()
+
+    @staticmethod
+    def push_relabel(double global_relabel_frequency = kDefaultGlobalRelabelFrequency) -> MaxFlowPlan:
+        """
+        Synchronous parallel push-relabel with global relabeling and the gap heuristic
+        """
+        return MaxFlowPlan.make(_MaxFlowPlan.PushRelabel(global_relabel_frequency))
+
+
+cdef uint64_t handle_result_flow(Result[uint64_t] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def max_flow(Graph pg, uint32_t source_node, uint32_t sink_node, str edge_capacity_property_name,
+             str output_property_name, MaxFlowPlan plan = MaxFlowPlan()) -> int:
+    """
+    Compute the maximum flow from `source_node` to `sink_node` and a minimum cut.
+
+    :type pg: katana.local.Graph
+    :param pg: The graph to analyze.
+    :type source_node: Node ID
+    :param source_node: The source node.
+    :type sink_node: Node ID
+    :param sink_node: The sink node.
+    :type edge_capacity_property_name: str
+    :param edge_capacity_property_name: The input property containing edge capacities. Any numeric type is accepted.
+    :type output_property_name: str
+    :param output_property_name: The output node property holding 1 for nodes on the source side of the minimum cut,
+        0 otherwise. This property must not already exist.
+    :type plan: MaxFlowPlan
+    :param plan: The execution plan to use.
+    :return: The value of the maximum flow.
+
+    .. code-block:: python
+
+        import katana.local
+        from katana.example_data import get_input
+        from katana.local import Graph
+        katana.local.initialize()
+
+        graph = Graph(get_input("propertygraphs/ldbc_003"))
+        from katana.analytics import max_flow, MaxFlowStatistics
+        flow = max_flow(graph, 0, 10, "workFrom", "output")
+        print("Max flow:", flow)
+
+        stats = MaxFlowStatistics(graph, "workFrom", "output")
+        print("Cut edges:", stats.num_cut_edges)
+
+    """
+    cdef string edge_capacity_property_name_str = edge_capacity_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_flow(MaxFlow(pg.underlying_property_graph(), source_node, sink_node,
+                                       edge_capacity_property_name_str, output_property_name_str, plan.underlying_))
+    return v
+
+
+def max_flow_assert_valid(Graph pg, uint32_t source_node, uint32_t sink_node, str edge_capacity_property_name,
+                          str property_name):
+    """
+    Raise an exception if `property_name` does not hold a minimum cut between `source_node` and `sink_node`.
+
+    :raises: AssertionError
+    """
+    cdef string edge_capacity_property_name_str = edge_capacity_property_name.encode("utf-8")
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(MaxFlowAssertValid(pg.underlying_property_graph(), source_node, sink_node,
+                                                edge_capacity_property_name_str, property_name_str))
+
+
+cdef _MaxFlowStatistics handle_result_MaxFlowStatistics(Result[_MaxFlowStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MaxFlowStatistics:
+    """
+    Compute the :ref:`statistics` of a Max Flow result.
+    """
+    cdef _MaxFlowStatistics underlying
+
+    def __init__(self, Graph pg, str edge_capacity_property_name, str property_name):
+        cdef string edge_capacity_property_name_str = edge_capacity_property_name.encode("utf-8")
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_MaxFlowStatistics(_MaxFlowStatistics.Compute(
+                pg.underlying_property_graph(), edge_capacity_property_name_str, property_name_str))
+
+    @property
+    def cut_capacity(self) -> int:
+        return self.underlying.cut_capacity
+
+    @property
+    def num_cut_edges(self) -> int:
+        return self.underlying.num_cut_edges
+
+    @property
+    def num_source_side_nodes(self) -> int:
+        return self.underlying.num_source_side_nodes
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,224 @@
+"""
+Partition
+---------
+
+.. autoclass:: katana.local.analytics.PartitionPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.local.analytics._partition._PartitionPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.partition
+
+.. autoclass:: katana.local.analytics.PartitionStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.local.analytics.partition_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, handle_result_void, raise_error_code
+from katana.local._graph cimport Graph
+from katana.local.analytics.plan cimport Plan, _Plan
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/partition/partition.h" namespace "katana::analytics" nogil:
+    cppclass _PartitionPlan "katana::analytics::PartitionPlan" (_Plan):
+        enum Algorithm:
+            kMultilevel "katana::analytics::PartitionPlan::kMultilevel"
+
+        _PartitionPlan.Algorithm algorithm() const
+        uint32_t refinement_iterations() const
+        uint32_t coarsening_threshold() const
+
+        PartitionPlan()
+
+        @staticmethod
+        _PartitionPlan Multilevel(uint32_t refinement_iterations, uint32_t coarsening_threshold)
+
+    uint32_t kDefaultRefinementIterations "katana::analytics::PartitionPlan::kDefaultRefinementIterations"
+    uint32_t kDefaultCoarseningThreshold "katana::analytics::PartitionPlan::kDefaultCoarseningThreshold"
+
+    Result[void] Partition(_PropertyGraph* pg, uint32_t num_partitions, double imbalance,
+        string node_weight_property_name, string edge_weight_property_name, string output_property_name,
+        _PartitionPlan plan)
+
+    Result[void] PartitionAssertValid(_PropertyGraph* pg, uint32_t num_partitions, string property_name)
+
+    cppclass _PartitionStatistics "katana::analytics::PartitionStatistics":
+        uint32_t num_non_empty_partitions
+        uint64_t edge_cut
+        uint64_t max_partition_size
+        uint64_t min_partition_size
+        double imbalance
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_PartitionStatistics] Compute(_PropertyGraph* pg, uint32_t num_partitions, string property_name)
+
+
+class _PartitionPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.local.analytics.PartitionPlan` constructors for algorithm documentation.
+    """
+    Multilevel = _PartitionPlan.Algorithm.kMultilevel
+
+
+cdef class PartitionPlan(Plan):
+    """
+    A computational :ref:`Plan` for graph partitioning.
+
+    Static methods construct PartitionPlans.
+    """
+    cdef:
+        _PartitionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _PartitionPlanAlgorithm
+
+    @staticmethod
+    cdef PartitionPlan make(_PartitionPlan u):
+        f = <PartitionPlan>PartitionPlan.__new__(PartitionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _PartitionPlanAlgorithm:
+        return _PartitionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def refinement_iterations(self) -> int:
+        """
+        The maximum number of refinement sweeps at each level.
+        """
+        return self.underlying_.refinement_iterations()
+
+    @property
+    def coarsening_threshold(self) -> int:
+        """
+        Coarsening stops once the graph has fewer than this many nodes per partition.
+        """
+        return self.underlying_.coarsening_threshold()
+
+    @staticmethod
+    def multilevel(uint32_t refinement_iterations = kDefaultRefinementIterations,
+                   uint32_t coarsening_threshold = kDefaultCoarseningThreshold) -> PartitionPlan:
+        """
+        Parallel multilevel k-way partitioning: heavy-edge matching, greedy growing and label propagation refinement
+        """
+        return PartitionPlan.make(_PartitionPlan.Multilevel(refinement_iterations, coarsening_threshold))
+
+
+def partition(Graph pg, uint32_t num_partitions, str output_property_name, double imbalance = 0.03,
+              str node_weight_property_name = "", str edge_weight_property_name = "",
+              PartitionPlan plan = PartitionPlan()):
+    """
+    Partition the nodes of `pg` into `num_partitions` parts of roughly equal weight while minimizing the weight of
+    the edges between parts. The graph is expected to be symmetric.
+
+    :type pg: katana.local.Graph
+    :param pg: The graph to analyze.
+    :type num_partitions: int
+    :param num_partitions: The number of partitions.
+    :type output_property_name: str
+    :param output_property_name: The output node property holding the partition ID of each node. This property must
+        not already exist.
+    :type imbalance: float
+    :param imbalance: The fraction by which a partition may exceed the average partition weight.
+    :type node_weight_property_name: str
+    :param node_weight_property_name: The node property holding node weights, or empty for unit weights.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The edge property holding edge weights, or empty for unit weights.
+    :type plan: PartitionPlan
+    :param plan: The execution plan to use.
+
+    .. code-block:: python
+
+        import katana.local
+        from katana.example_data import get_input
+        from katana.local import Graph
+        katana.local.initialize()
+
+        graph = Graph(get_input("propertygraphs/ldbc_003"))
+        from katana.analytics import partition, PartitionStatistics
+        partition(graph, 4, "output")
+
+        stats = PartitionStatistics(graph, 4, "output")
+        print("Edge cut:", stats.edge_cut)
+
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    cdef string node_weight_property_name_str = node_weight_property_name.encode("utf-8")
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(Partition(pg.underlying_property_graph(), num_partitions, imbalance,
+                                     node_weight_property_name_str, edge_weight_property_name_str,
+                                     output_property_name_str, plan.underlying_))
+
+
+def partition_assert_valid(Graph pg, uint32_t num_partitions, str property_name):
+    """
+    Raise an exception if some node of `pg` has a partition ID out of range.
+
+    :raises: AssertionError
+    """
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(PartitionAssertValid(pg.underlying_property_graph(), num_partitions, property_name_str))
+
+
+cdef _PartitionStatistics handle_result_PartitionStatistics(Result[_PartitionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class PartitionStatistics:
+    """
+    Compute the :ref:`statistics` of a partitioning result.
+    """
+    cdef _PartitionStatistics underlying
+
+    def __init__(self, Graph pg, uint32_t num_partitions, str property_name):
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_PartitionStatistics(_PartitionStatistics.Compute(
+                pg.underlying_property_graph(), num_partitions, property_name_str))
+
+    @property
+    def num_non_empty_partitions(self) -> int:
+        return self.underlying.num_non_empty_partitions
+
+    @property
+    def edge_cut(self) -> int:
+        return self.underlying.edge_cut
+
+    @property
+    def max_partition_size(self) -> int:
+        return self.underlying.max_partition_size
+
+    @property
+    def min_partition_size(self) -> int:
+        return self.underlying.min_partition_size
+
+    @property
+    def imbalance(self) -> float:
+        return self.underlying.imbalance
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
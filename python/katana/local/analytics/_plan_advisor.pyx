@@ -0,0 +1,322 @@
+"""
+Plan Advisor
+------------
+
+.. autofunction:: katana.local.analytics.advise_plans
+
+.. autoclass:: katana.local.analytics.PlanAdvice
+    :members:
+    :undoc-members:
+
+.. autoclass:: katana.local.analytics.GraphFeatures
+    :members:
+    :undoc-members:
+"""
+from libc.stddef cimport ptrdiff_t
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, raise_error_code
+from katana.local._graph cimport Graph
+
+from katana.local.analytics._bfs import BfsPlan
+from katana.local.analytics._connected_components import ConnectedComponentsPlan
+from katana.local.analytics._pagerank import PagerankPlan
+from katana.local.analytics._sssp import SsspPlan
+from katana.local.analytics._triangle_count import TriangleCountPlan
+
+
+cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
+    cppclass _BfsPlan "katana::analytics::BfsPlan":
+        enum Algorithm:
+            kAsynchronousTile "katana::analytics::BfsPlan::kAsynchronousTile"
+            kSynchronousTile "katana::analytics::BfsPlan::kSynchronousTile"
+            kSynchronousDirectOpt "katana::analytics::BfsPlan::kSynchronousDirectOpt"
+
+        _BfsPlan.Algorithm algorithm() const
+        ptrdiff_t edge_tile_size() const
+        uint32_t alpha() const
+        uint32_t beta() const
+
+    cppclass _SsspPlan "katana::analytics::SsspPlan":
+        enum Algorithm:
+            kDeltaTile "katana::analytics::SsspPlan::kDeltaTile"
+            kDeltaStep "katana::analytics::SsspPlan::kDeltaStep"
+            kDeltaStepBarrier "katana::analytics::SsspPlan::kDeltaStepBarrier"
+
+        _SsspPlan.Algorithm algorithm() const
+        unsigned delta() const
+        ptrdiff_t edge_tile_size() const
+
+    cppclass _ConnectedComponentsPlan "katana::analytics::ConnectedComponentsPlan":
+        enum Algorithm:
+            kEdgeTiledAsynchronous "katana::analytics::ConnectedComponentsPlan::kEdgeTiledAsynchronous"
+            kAfforest "katana::analytics::ConnectedComponentsPlan::kAfforest"
+            kEdgeAfforest "katana::analytics::ConnectedComponentsPlan::kEdgeAfforest"
+
+        _ConnectedComponentsPlan.Algorithm algorithm() const
+        ptrdiff_t edge_tile_size() const
+        uint32_t neighbor_sample_size() const
+        uint32_t component_sample_frequency() const
+
+    cppclass _PagerankPlan "katana::analytics::PagerankPlan":
+        enum Algorithm:
+            kPullResidual "katana::analytics::PagerankPlan::kPullResidual"
+            kPushAsynchronous "katana::analytics::PagerankPlan::kPushAsynchronous"
+
+        _PagerankPlan.Algorithm algorithm() const
+        float tolerance() const
+        unsigned int max_iterations() const
+        float alpha() const
+
+    cppclass _TriangleCountPlan "katana::analytics::TriangleCountPlan":
+        enum Algorithm:
+            kEdgeIteration "katana::analytics::TriangleCountPlan::kEdgeIteration"
+            kOrderedCount "katana::analytics::TriangleCountPlan::kOrderedCount"
+
+        enum Relabeling:
+            kRelabel "katana::analytics::TriangleCountPlan::kRelabel"
+
+        _TriangleCountPlan.Algorithm algorithm() const
+        _TriangleCountPlan.Relabeling relabeling() const
+        bool edges_sorted() const
+
+    cppclass _GraphFeatures "katana::analytics::GraphFeatures":
+        uint64_t num_nodes
+        uint64_t num_edges
+        double average_degree
+        uint64_t max_degree
+        double degree_skew
+        double density
+        uint64_t estimated_diameter
+        bool power_law
+        bool from_saved_statistics
+
+    cppclass _PlanAdvisorOptions "katana::analytics::PlanAdvisorOptions":
+        bool use_saved_statistics
+        uint32_t num_diameter_sweeps
+        string edge_weight_property_name
+        bool run_trials
+        uint64_t trial_nodes
+
+    cppclass _PlanAdvice "katana::analytics::PlanAdvice":
+        _GraphFeatures features
+        _BfsPlan bfs
+        _SsspPlan sssp
+        _ConnectedComponentsPlan connected_components
+        _PagerankPlan pagerank
+        _TriangleCountPlan triangle_count
+        vector[string] rationale
+
+        void Print(ostream os)
+
+    Result[_PlanAdvice] AdvisePlans(_PropertyGraph* pg, const _PlanAdvisorOptions& opts)
+
+
+# The advisor only returns the plans below; they are rebuilt through the public constructors of the plan classes.
+
+cdef _bfs_plan(const _BfsPlan& p):
+    if p.algorithm() == _BfsPlan.Algorithm.kAsynchronousTile:
+        return BfsPlan.asynchronous_tile(p.edge_tile_size())
+    elif p.algorithm() == _BfsPlan.Algorithm.kSynchronousTile:
+        return BfsPlan.synchronous_tile(p.edge_tile_size())
+    return BfsPlan.synchronous_direction_opt(p.alpha(), p.beta())
+
+
+cdef _sssp_plan(const _SsspPlan& p):
+    if p.algorithm() == _SsspPlan.Algorithm.kDeltaTile:
+        return SsspPlan.delta_tile(p.delta(), p.edge_tile_size())
+    elif p.algorithm() == _SsspPlan.Algorithm.kDeltaStep:
+        return SsspPlan.delta_step(p.delta())
+    return SsspPlan.delta_step_barrier(p.delta())
+
+
+cdef _connected_components_plan(const _ConnectedComponentsPlan& p):
+    if p.algorithm() == _ConnectedComponentsPlan.Algorithm.kEdgeTiledAsynchronous:
+        return ConnectedComponentsPlan.edge_tiled_asynchronous(p.edge_tile_size())
+    elif p.algorithm() == _ConnectedComponentsPlan.Algorithm.kEdgeAfforest:
+        return ConnectedComponentsPlan.edge_tiled_afforest(
+            p.edge_tile_size(), p.neighbor_sample_size(), p.component_sample_frequency())
+    return ConnectedComponentsPlan.afforest(p.neighbor_sample_size(), p.component_sample_frequency())
+
+
+cdef _pagerank_plan(const _PagerankPlan& p):
+    if p.algorithm() == _PagerankPlan.Algorithm.kPullResidual:
+        return PagerankPlan.pull_residual(p.tolerance(), p.max_iterations(), p.alpha())
+    return PagerankPlan.push_asynchronous(p.tolerance(), p.alpha())
+
+
+cdef _triangle_count_plan(const _TriangleCountPlan& p):
+    relabeling = p.relabeling() == _TriangleCountPlan.Relabeling.kRelabel
+    if p.algorithm() == _TriangleCountPlan.Algorithm.kEdgeIteration:
+        return TriangleCountPlan.edge_iteration(p.edges_sorted(), relabeling)
+    return TriangleCountPlan.ordered_count(p.edges_sorted(), relabeling)
+
+
+cdef class GraphFeatures:
+    """
+    The shape of a graph, as far as choosing plans is concerned.
+    """
+    cdef _GraphFeatures underlying
+
+    @staticmethod
+    cdef GraphFeatures make(_GraphFeatures u):
+        f = <GraphFeatures>GraphFeatures.__new__(GraphFeatures)
+        f.underlying = u
+        return f
+
+    @property
+    def num_nodes(self) -> int:
+        return self.underlying.num_nodes
+
+    @property
+    def num_edges(self) -> int:
+        return self.underlying.num_edges
+
+    @property
+    def average_degree(self) -> float:
+        return self.underlying.average_degree
+
+    @property
+    def max_degree(self) -> int:
+        return self.underlying.max_degree
+
+    @property
+    def degree_skew(self) -> float:
+        """
+        The highest out-degree over the average out-degree.
+        """
+        return self.underlying.degree_skew
+
+    @property
+    def density(self) -> float:
+        return self.underlying.density
+
+    @property
+    def estimated_diameter(self) -> int:
+        """
+        A lower bound on the diameter.
+        """
+        return self.underlying.estimated_diameter
+
+    @property
+    def power_law(self) -> bool:
+        return self.underlying.power_law
+
+    @property
+    def from_saved_statistics(self) -> bool:
+        """
+        Were the degrees and diameter read from statistics saved with the graph?
+        """
+        return self.underlying.from_saved_statistics
+
+
+cdef _PlanAdvice handle_result_PlanAdvice(Result[_PlanAdvice] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class PlanAdvice:
+    """
+    Plans for the main analytics, each tuned to one graph. Build it with
+    :py:func:`~katana.local.analytics.advise_plans`.
+    """
+    cdef _PlanAdvice underlying
+
+    @staticmethod
+    cdef PlanAdvice make(_PlanAdvice u):
+        f = <PlanAdvice>PlanAdvice.__new__(PlanAdvice)
+        f.underlying = u
+        return f
+
+    @property
+    def features(self) -> GraphFeatures:
+        return GraphFeatures.make(self.underlying.features)
+
+    @property
+    def bfs(self) -> BfsPlan:
+        return _bfs_plan(self.underlying.bfs)
+
+    @property
+    def sssp(self) -> SsspPlan:
+        return _sssp_plan(self.underlying.sssp)
+
+    @property
+    def connected_components(self) -> ConnectedComponentsPlan:
+        return _connected_components_plan(self.underlying.connected_components)
+
+    @property
+    def pagerank(self) -> PagerankPlan:
+        return _pagerank_plan(self.underlying.pagerank)
+
+    @property
+    def triangle_count(self) -> TriangleCountPlan:
+        return _triangle_count_plan(self.underlying.triangle_count)
+
+    @property
+    def rationale(self) -> list:
+        """
+        Why each plan was chosen, one line per analytic.
+        """
+        return [str(line, "utf-8") for line in self.underlying.rationale]
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
+
+
+def advise_plans(Graph pg, str edge_weight_property_name = None, bool run_trials = False,
+                 uint64_t trial_nodes = 1 << 16, bool use_saved_statistics = True,
+                 uint32_t num_diameter_sweeps = 2) -> PlanAdvice:
+    """
+    Choose plans for BFS, SSSP, connected components, PageRank and triangle counting on `pg`.
+
+    The choice follows the degree skew, density and estimated diameter of `pg`, which are read from the statistics saved
+    with it when there are any. With `run_trials`, the candidate plans are also timed on a subgraph of about
+    `trial_nodes` nodes and the fastest ones are taken. `pg` is not modified.
+
+    :type pg: katana.local.Graph
+    :param pg: The graph to analyze.
+    :type edge_weight_property_name: Optional[str]
+    :param edge_weight_property_name: The edge weights SSSP will run with, used to pick its delta.
+    :type run_trials: bool
+    :param run_trials: Time the candidate plans on a sampled subgraph.
+    :type trial_nodes: int
+    :param trial_nodes: The number of nodes of the sampled subgraph.
+    :type use_saved_statistics: bool
+    :param use_saved_statistics: Read degrees and the diameter from statistics saved with the graph.
+    :type num_diameter_sweeps: int
+    :param num_diameter_sweeps: The number of BFS sweeps for the diameter when it is not saved.
+    :return: The plans and the rationale for each.
+
+    .. code-block:: python
+
+        import katana.local
+        from katana.example_data import get_input
+        from katana.local import Graph
+        katana.local.initialize()
+
+        graph = Graph(get_input("propertygraphs/ldbc_003"))
+        from katana.analytics import advise_plans, bfs
+        advice = advise_plans(graph)
+        print(advice)
+        bfs(graph, 0, "output", advice.bfs)
+    """
+    cdef _PlanAdvisorOptions opts
+    cdef _PlanAdvice advice
+    opts.use_saved_statistics = use_saved_statistics
+    opts.num_diameter_sweeps = num_diameter_sweeps
+    if edge_weight_property_name is not None:
+        opts.edge_weight_property_name = edge_weight_property_name.encode("utf-8")
+    opts.run_trials = run_trials
+    opts.trial_nodes = trial_nodes
+    with nogil:
+        advice = handle_result_PlanAdvice(AdvisePlans(pg.underlying_property_graph(), opts))
+    return PlanAdvice.make(advice)
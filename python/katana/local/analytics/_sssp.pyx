@@ -45,6 +45,7 @@ cdef extern from "katana/analytics/sssp/sssp.h" namespace "katana::analytics" no
             kDijkstra "katana::analytics::SsspPlan::kDijkstra"
             kTopological "katana::analytics::SsspPlan::kTopological"
             kTopologicalTile "katana::analytics::SsspPlan::kTopologicalTile"
+            kMultiQueue "katana::analytics::SsspPlan::kMultiQueue"
             kAutomatic "katana::analytics::SsspPlan::kAutomatic"
 
         _SsspPlan()
@@ -74,6 +75,8 @@ cdef extern from "katana/analytics/sssp/sssp.h" namespace "katana::analytics" no
         _SsspPlan Topological()
         @staticmethod
         _SsspPlan TopologicalTile(ptrdiff_t edge_tile_size)
+        @staticmethod
+        _SsspPlan MultiQueue()
 
     unsigned kDefaultDelta "katana::analytics::SsspPlan::kDefaultDelta"
     ptrdiff_t kDefaultEdgeTileSize "katana::analytics::SsspPlan::kDefaultEdgeTileSize"
@@ -111,6 +114,7 @@ class _SsspAlgorithm(Enum):
     Dijkstra = _SsspPlan.Algorithm.kDijkstra
     Topological = _SsspPlan.Algorithm.kTopological
     TopologicalTile = _SsspPlan.Algorithm.kTopologicalTile
+    MultiQueue = _SsspPlan.Algorithm.kMultiQueue
     Automatic = _SsspPlan.Algorithm.kAutomatic
 
 
@@ -242,6 +246,13 @@ cdef class SsspPlan(Plan):
         """
         return SsspPlan.make(_SsspPlan.TopologicalTile(edge_tile_size))
 
+    @staticmethod
+    def multi_queue() -> SsspPlan:
+        """
+        Asynchronous relaxation in approximate distance order, which needs no delta
+        """
+        return SsspPlan.make(_SsspPlan.MultiQueue())
+
 
 def sssp(Graph pg, size_t start_node, str edge_weight_property_name, str output_property_name,
          SsspPlan plan = SsspPlan()):
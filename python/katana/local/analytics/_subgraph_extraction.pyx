@@ -8,9 +8,13 @@ Subgraph Extraction
     :undoc-members:
 
 .. autofunction:: katana.local.analytics.subgraph_extraction
+
+.. autofunction:: katana.local.analytics.ego_network_extraction
 """
 from libc.stdint cimport uint32_t
+from libcpp cimport bool
 from libcpp.memory cimport shared_ptr, unique_ptr
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 from pyarrow.lib cimport to_shared
 
@@ -35,7 +39,9 @@ cdef extern from "katana/analytics/subgraph_extraction/subgraph_extraction.h" na
         _SubGraphExtractionPlan NodeSet(
             )
 
-    Result[unique_ptr[_PropertyGraph]] SubGraphExtraction(_PropertyGraph* pfg, const vector[uint32_t]& node_vec, _SubGraphExtractionPlan plan)
+    Result[unique_ptr[_PropertyGraph]] SubGraphExtraction(_PropertyGraph* pfg, const vector[uint32_t]& node_vec, const vector[string]& node_properties_to_copy, const vector[string]& edge_properties_to_copy, _SubGraphExtractionPlan plan)
+
+    Result[unique_ptr[_PropertyGraph]] EgoNetworkExtraction(_PropertyGraph* pfg, const vector[uint32_t]& seed_nodes, uint32_t num_hops, bool follow_in_edges, const vector[string]& node_properties_to_copy, const vector[string]& edge_properties_to_copy)
 
 
 class _SubGraphExtractionPlanAlgorithm(Enum):
@@ -81,12 +87,28 @@ cdef shared_ptr[_PropertyGraph] handle_result_property_graph(Result[unique_ptr[_
     return to_shared(res.value())
 
 
-def subgraph_extraction(Graph pg, node_vec, SubGraphExtractionPlan plan = SubGraphExtractionPlan()) -> Graph:
+def subgraph_extraction(Graph pg, node_vec, SubGraphExtractionPlan plan = SubGraphExtractionPlan(), *, node_properties=(), edge_properties=()) -> Graph:
     """
     Given a set of node ids, this algorithm constructs a new sub-graph which contains all nodes in the set and edges
-    between them.
+    between them. Node and edge types are carried over, along with the named node and edge properties.
     """
     cdef vector[uint32_t] vec = [<uint32_t>n for n in node_vec]
+    cdef vector[string] node_props = [bytes(p, "utf-8") for p in node_properties]
+    cdef vector[string] edge_props = [bytes(p, "utf-8") for p in edge_properties]
+    with nogil:
+        v = handle_result_property_graph(SubGraphExtraction(pg.underlying_property_graph(), vec, node_props, edge_props, plan.underlying_))
+    return Graph.make(v)
+
+
+def ego_network_extraction(Graph pg, seed_nodes, uint32_t num_hops, bool follow_in_edges = False, *, node_properties=(), edge_properties=()) -> Graph:
+    """
+    Construct the sub-graph induced by all nodes within `num_hops` edges of some node in `seed_nodes`. Outgoing edges
+    are followed, and incoming edges too if `follow_in_edges` is set. Node and edge types are carried over, along with
+    the named node and edge properties.
+    """
+    cdef vector[uint32_t] vec = [<uint32_t>n for n in seed_nodes]
+    cdef vector[string] node_props = [bytes(p, "utf-8") for p in node_properties]
+    cdef vector[string] edge_props = [bytes(p, "utf-8") for p in edge_properties]
     with nogil:
-        v = handle_result_property_graph(SubGraphExtraction(pg.underlying_property_graph(), vec, plan.underlying_))
+        v = handle_result_property_graph(EgoNetworkExtraction(pg.underlying_property_graph(), vec, num_hops, follow_in_edges, node_props, edge_props))
     return Graph.make(v)
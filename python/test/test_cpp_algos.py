@@ -12,6 +12,8 @@ from katana.local.analytics import (
     BetweennessCentralityPlan,
     BetweennessCentralityStatistics,
     BfsStatistics,
+    BipartiteMatchingPlan,
+    BipartiteMatchingStatistics,
     ConnectedComponentsStatistics,
     IndependentSetPlan,
     IndependentSetStatistics,
@@ -21,14 +23,24 @@ from katana.local.analytics import (
     KTrussStatistics,
     LeidenClusteringStatistics,
     LouvainClusteringStatistics,
+    MaxFlowPlan,
+    MaxFlowStatistics,
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
     PagerankStatistics,
+    PartitionPlan,
+    PartitionStatistics,
     SsspStatistics,
     TriangleCountPlan,
+    advise_plans,
     betweenness_centrality,
     bfs,
     bfs_assert_valid,
+    bipartite_matching_by_node_types,
+    bipartite_matching_by_node_types_assert_valid,
     connected_components,
     connected_components_assert_valid,
+    ego_network_extraction,
     find_edge_sorted_by_dest,
     independent_set,
     independent_set_assert_valid,
@@ -43,8 +55,14 @@ from katana.local.analytics import (
     local_clustering_coefficient,
     louvain_clustering,
     louvain_clustering_assert_valid,
+    max_flow,
+    max_flow_assert_valid,
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
     pagerank,
     pagerank_assert_valid,
+    partition,
+    partition_assert_valid,
     sort_all_edges_by_dest,
     sort_nodes_by_degree,
     sssp,
@@ -245,6 +263,36 @@ def test_betweenness_centrality_level(graph: Graph):
     assert stats.average_centrality == approx(0.000534295046236366)
 
 
+def test_betweenness_centrality_batched(graph: Graph):
+    # Batched sums the float dependencies of the sources in a different order
+    # than Level, so the centralities only agree up to rounding.
+    tolerance = 1e-4
+
+    betweenness_centrality(graph, "Level", 16, BetweennessCentralityPlan.level())
+    betweenness_centrality(graph, "Batched", 16, BetweennessCentralityPlan.batched(8))
+
+    expected = graph.get_node_property("Level").to_numpy()
+    actual = graph.get_node_property("Batched").to_numpy()
+    assert actual == approx(expected, rel=tolerance, abs=tolerance)
+
+    stats = BetweennessCentralityStatistics(graph, "Batched")
+
+    assert stats.min_centrality == 0
+    assert stats.max_centrality == approx(7.0, rel=tolerance)
+    assert stats.average_centrality == approx(0.000534295046236366, rel=tolerance)
+
+
+def test_betweenness_centrality_approximate(graph: Graph):
+    property_name = "NewProp"
+
+    betweenness_centrality(graph, property_name, None, BetweennessCentralityPlan.approximate(0.05, 0.1))
+
+    stats = BetweennessCentralityStatistics(graph, property_name)
+
+    assert stats.min_centrality >= 0
+    assert stats.max_centrality >= stats.average_centrality
+
+
 def test_triangle_count():
     graph = Graph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
     original_first_edge_list = [graph.get_edge_dest(e) for e in graph.edges(0)]
@@ -272,6 +320,36 @@ def test_triangle_count_presorted():
     assert n == 282617
 
 
+def test_advise_plans():
+    graph = Graph(get_input("propertygraphs/rmat10_symmetric"))
+    num_properties = len(graph.loaded_node_schema())
+
+    advice = advise_plans(graph, run_trials=True, trial_nodes=256)
+
+    assert advice.features.num_nodes == len(graph)
+    assert advice.features.max_degree > advice.features.average_degree
+    assert len(advice.rationale) == 5
+    assert all("trials on 256 nodes" in line for line in advice.rationale if not line.startswith("sssp"))
+    # Trials run on a copy
+    assert len(graph.loaded_node_schema()) == num_properties
+
+    bfs(graph, 0, "bfs", advice.bfs)
+    bfs_assert_valid(graph, 0, "bfs")
+
+    connected_components(graph, "components", advice.connected_components)
+    assert ConnectedComponentsStatistics(graph, "components").total_components == 69
+
+    pagerank(graph, "rank", advice.pagerank)
+    pagerank_assert_valid(graph, "rank")
+
+
+def test_advise_plans_weights(graph: Graph):
+    advice = advise_plans(graph, edge_weight_property_name="workFrom")
+
+    sssp(graph, 0, "workFrom", "output", advice.sssp)
+    sssp_assert_valid(graph, 0, "workFrom", "output")
+
+
 def test_independent_set():
     graph = Graph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -315,6 +393,68 @@ def test_k_core():
     k_core_assert_valid(graph, 10, "output")
 
 
+def test_minimum_spanning_forest(graph: Graph):
+    weight_name = "workFrom"
+
+    minimum_spanning_forest(graph, weight_name, "boruvka", MinimumSpanningForestPlan.boruvka())
+    minimum_spanning_forest(graph, weight_name, "filter_kruskal", MinimumSpanningForestPlan.filter_kruskal(1024))
+
+    minimum_spanning_forest_assert_valid(graph, weight_name, "boruvka")
+    minimum_spanning_forest_assert_valid(graph, weight_name, "filter_kruskal")
+
+    boruvka_stats = MinimumSpanningForestStatistics(graph, weight_name, "boruvka")
+    filter_kruskal_stats = MinimumSpanningForestStatistics(graph, weight_name, "filter_kruskal")
+
+    assert boruvka_stats.num_forest_edges + boruvka_stats.num_trees == len(graph)
+    assert boruvka_stats.num_forest_edges == filter_kruskal_stats.num_forest_edges
+    assert boruvka_stats.total_weight == approx(filter_kruskal_stats.total_weight)
+
+
+def test_max_flow(graph: Graph):
+    capacity_name = "workFrom"
+
+    flow = max_flow(graph, 0, 10, capacity_name, "output", MaxFlowPlan.push_relabel())
+    no_global_relabel_flow = max_flow(graph, 0, 10, capacity_name, "output2", MaxFlowPlan.push_relabel(0))
+
+    max_flow_assert_valid(graph, 0, 10, capacity_name, "output")
+    max_flow_assert_valid(graph, 0, 10, capacity_name, "output2")
+
+    stats = MaxFlowStatistics(graph, capacity_name, "output")
+
+    assert flow == no_global_relabel_flow
+    assert stats.cut_capacity == flow
+    assert 1 <= stats.num_source_side_nodes < len(graph)
+
+
+def test_bipartite_matching(graph: Graph):
+    bipartite_matching_by_node_types(graph, "Person", "Company", "output", BipartiteMatchingPlan.pothen_fan())
+
+    bipartite_matching_by_node_types_assert_valid(graph, "Person", "Company", "output")
+
+    stats = BipartiteMatchingStatistics(graph, "output")
+
+    assert stats.num_matched_pairs > 0
+    assert 2 * stats.num_matched_pairs + stats.num_unmatched_nodes == len(graph)
+
+    partners = graph.get_node_property("output").to_numpy()
+    matched = partners != BipartiteMatchingPlan.UNMATCHED
+    assert np.all(partners[partners[matched]] == np.flatnonzero(matched))
+
+
+def test_partition():
+    graph = Graph(get_input("propertygraphs/rmat10_symmetric"))
+
+    partition(graph, 8, "output", plan=PartitionPlan.multilevel())
+
+    partition_assert_valid(graph, 8, "output")
+
+    stats = PartitionStatistics(graph, 8, "output")
+
+    assert stats.num_non_empty_partitions == 8
+    assert stats.max_partition_size <= 1.03 * len(graph) / 8 + 1
+    assert stats.edge_cut < graph.num_edges()
+
+
 def test_k_truss():
     graph = Graph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -398,6 +538,25 @@ def test_subgraph_extraction():
         assert [pg.get_edge_dest(e) for e in pg.edges(i)] == expected_edges[i]
 
 
+def test_ego_network_extraction():
+    graph = Graph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    seed = 1
+
+    neighborhood = {seed} | {graph.get_edge_dest(e) for e in graph.edges(seed)}
+    nodes = sorted(neighborhood)
+    expected_num_edges = sum(1 for n in nodes for e in graph.edges(n) if graph.get_edge_dest(e) in neighborhood)
+
+    pg = ego_network_extraction(graph, [seed], 1)
+
+    assert isinstance(pg, Graph)
+    assert len(pg) == len(nodes)
+    assert pg.num_edges() == expected_num_edges
+    for i, n in enumerate(nodes):
+        assert [nodes[pg.get_edge_dest(e)] for e in pg.edges(i)] == [
+            graph.get_edge_dest(e) for e in graph.edges(n) if graph.get_edge_dest(e) in neighborhood
+        ]
+
+
 def test_busy_wait(graph: Graph):
     set_busy_wait()
     property_name = "NewProp"
@@ -3,6 +3,7 @@
 
 #include <llvm/Support/CommandLine.h>
 
+#include "katana/ErrorCode.h"
 #include "katana/Galois.h"
 #include "katana/GraphML.h"
 #include "katana/Logging.h"
@@ -43,6 +44,14 @@ static cll::opt<ConvertTest> test_type(
 static cll::opt<int> chunk_size(
     "chunkSize", cll::desc("Chunk size for in memory arrow representation"),
     cll::init(25000));
+static cll::opt<size_t> parse_chunk_bytes(
+    "parseChunkBytes",
+    cll::desc("Size of the pieces a GraphML file is parsed in parallel in"),
+    cll::init(katana::kGraphMLParseChunkBytes));
+static cll::opt<bool> serial_reader(
+    "serialReader",
+    cll::desc("Parse the GraphML file serially with an xml text reader"),
+    cll::init(false));
 
 namespace {
 
@@ -1261,6 +1270,22 @@ VerifyMongodbSet(const katana::GraphComponents& graph) {
 }
 #endif
 
+katana::Result<katana::GraphComponents>
+ConvertNeo4j() {
+  if (!serial_reader) {
+    return katana::ConvertGraphML(
+        input_filename, chunk_size, true, parse_chunk_bytes);
+  }
+  xmlTextReaderPtr reader = xmlNewTextReaderFilename(input_filename.c_str());
+  if (reader == NULL) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotFound, "Unable to open {}", input_filename);
+  }
+  auto res = katana::ConvertGraphML(reader, chunk_size, true);
+  xmlFreeTextReader(reader);
+  return res;
+}
+
 }  // namespace
 
 int
@@ -1272,7 +1297,7 @@ main(int argc, char** argv) {
 
   switch (fileType) {
   case katana::SourceDatabase::kNeo4j:
-    if (auto r = katana::ConvertGraphML(input_filename, chunk_size, true); !r) {
+    if (auto r = ConvertNeo4j(); !r) {
       KATANA_LOG_FATAL(": {}", r.error());
     } else {
       graph = std::move(r.value());
@@ -0,0 +1,115 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "katana/GraphStatistics.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/Timer.h"
+#include "llvm/Support/CommandLine.h"
+
+namespace cll = llvm::cl;
+
+namespace {
+
+cll::opt<std::string> input_rdg(
+    cll::Positional, cll::desc("<input rdg>"), cll::Required);
+cll::opt<std::string> output_file(
+    "output", cll::desc("Write the statistics as JSON to this file instead of "
+                        "standard output"));
+cll::opt<bool> persist(
+    "persist",
+    cll::desc("Save the statistics in the part metadata of the input graph"),
+    cll::init(false));
+cll::opt<bool> cached(
+    "cached",
+    cll::desc("Print the statistics saved with the graph, if any, instead of "
+              "computing them"),
+    cll::init(false));
+cll::opt<int> num_threads(
+    "t", cll::desc("Number of threads (default value 1)"), cll::init(1));
+cll::opt<uint32_t> num_sweeps(
+    "sweeps", cll::desc("Number of BFS sweeps for the diameter (default 4)"),
+    cll::init(4));
+cll::opt<uint64_t> num_samples(
+    "samples",
+    cll::desc("Number of nodes sampled for the clustering coefficient"),
+    cll::init(1 << 14));
+cll::opt<bool> skip_distinct(
+    "skipDistinct", cll::desc("Do not count distinct property values"),
+    cll::init(false));
+cll::opt<uint64_t> seed(
+    "seed", cll::desc("Seed of the node samples"), cll::init(0));
+
+std::string
+CommandLine(int argc, char** argv) {
+  std::string command_line = argv[0];
+  for (int i = 1; i < argc; ++i) {
+    command_line += " ";
+    command_line += argv[i];
+  }
+  return command_line;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys sys;
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+  katana::setActiveThreads(num_threads);
+
+  auto pg_res = katana::PropertyGraph::Make(input_rdg, tsuba::RDGLoadOptions());
+  if (!pg_res) {
+    KATANA_LOG_FATAL("failed to load {}: {}", input_rdg, pg_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  katana::GraphStatistics stats;
+  if (cached) {
+    auto stats_res = katana::LoadGraphStatistics(pg.get());
+    if (!stats_res) {
+      KATANA_LOG_FATAL(
+          "no statistics saved with {}: {}", input_rdg, stats_res.error());
+    }
+    stats = std::move(stats_res.value());
+  } else {
+    katana::GraphStatisticsOptions opts;
+    opts.num_diameter_sweeps = num_sweeps;
+    opts.num_clustering_samples = num_samples;
+    opts.count_distinct_values = !skip_distinct;
+    opts.seed = seed;
+
+    katana::StatTimer timer("Profile", "GraphProfile");
+    timer.start();
+    auto stats_res = katana::ComputeGraphStatistics(pg.get(), opts);
+    timer.stop();
+    if (!stats_res) {
+      KATANA_LOG_FATAL(
+          "failed to profile {}: {}", input_rdg, stats_res.error());
+    }
+    stats = std::move(stats_res.value());
+  }
+
+  std::string json = nlohmann::json(stats).dump(2);
+  if (output_file.empty()) {
+    std::cout << json << "\n";
+  } else {
+    std::ofstream out(output_file);
+    out << json << "\n";
+    if (!out) {
+      KATANA_LOG_FATAL("failed to write {}", output_file);
+    }
+  }
+
+  if (persist && !cached) {
+    katana::StoreGraphStatistics(pg.get(), stats);
+    if (auto res = pg->Commit(CommandLine(argc, argv)); !res) {
+      KATANA_LOG_FATAL("failed to save statistics: {}", res.error());
+    }
+  }
+
+  return 0;
+}